@@ -0,0 +1,97 @@
+// TU header --------------------------------------------
+#include "adapter/adapter_selection.h"
+
+// c++ headers ------------------------------------------
+#include <algorithm>
+
+// public project headers -------------------------------
+#include "mbase/public/log.h"
+
+namespace mnexus_backend::adapter {
+
+namespace {
+
+// Score layout, most significant criterion first:
+//   [56, 64) kind rank, 1-based so that any usable candidate scores above 0
+//   [48, 56) optional feature count
+//   [46, 48) queue family layout: dedicated compute, dedicated transfer
+//   [ 0, 46) device-local heap size in MiB
+constexpr uint32_t kKindShift = 56;
+constexpr uint32_t kOptionalFeatureShift = 48;
+constexpr uint32_t kQueueLayoutShift = 46;
+constexpr uint64_t kHeapSizeMask = (uint64_t(1) << kQueueLayoutShift) - 1;
+
+bool IsUsable(AdapterCandidate const& candidate) {
+  return candidate.required_features_supported && candidate.has_universal_queue;
+}
+
+bool MatchesIds(AdapterCandidate const& candidate, mnexus::AdapterOverride const& adapter_override) {
+  return (adapter_override.vendor_id == 0 || candidate.vendor_id == adapter_override.vendor_id) &&
+         (adapter_override.device_id == 0 || candidate.device_id == adapter_override.device_id);
+}
+
+} // namespace
+
+uint64_t ScoreAdapter(AdapterCandidate const& candidate) {
+  if (!IsUsable(candidate)) {
+    return 0;
+  }
+
+  uint64_t const kind_rank = static_cast<uint64_t>(candidate.kind) + 1;
+  uint64_t const optional_features = std::min<uint64_t>(candidate.optional_feature_count, 0xFF);
+  uint64_t const queue_layout =
+    (candidate.has_dedicated_compute_queue ? 2 : 0) | (candidate.has_dedicated_transfer_queue ? 1 : 0);
+  uint64_t const heap_size_in_mib = std::min(candidate.device_local_heap_size_in_bytes >> 20, kHeapSizeMask);
+
+  return (kind_rank << kKindShift) |
+         (optional_features << kOptionalFeatureShift) |
+         (queue_layout << kQueueLayoutShift) |
+         heap_size_in_mib;
+}
+
+std::optional<uint32_t> SelectAdapter(
+  std::span<AdapterCandidate const> candidates,
+  mnexus::AdapterOverride const& adapter_override
+) {
+  // Explicit index.
+  if (adapter_override.index != mnexus::AdapterOverride::kAnyIndex) {
+    if (adapter_override.index < candidates.size() && IsUsable(candidates[adapter_override.index])) {
+      return adapter_override.index;
+    }
+    MBASE_LOG_WARN("Adapter override: index {} does not name a usable adapter; selecting by score",
+      adapter_override.index);
+  }
+
+  bool const match_ids =
+    adapter_override.index == mnexus::AdapterOverride::kAnyIndex &&
+    (adapter_override.vendor_id != 0 || adapter_override.device_id != 0);
+
+  std::optional<uint32_t> best;
+  uint64_t best_score = 0;
+  std::optional<uint32_t> best_matching;
+  uint64_t best_matching_score = 0;
+
+  for (uint32_t i = 0; i < candidates.size(); ++i) {
+    uint64_t const score = ScoreAdapter(candidates[i]);
+    if (score > best_score) {
+      best = i;
+      best_score = score;
+    }
+    if (match_ids && MatchesIds(candidates[i], adapter_override) && score > best_matching_score) {
+      best_matching = i;
+      best_matching_score = score;
+    }
+  }
+
+  if (match_ids) {
+    if (best_matching.has_value()) {
+      return best_matching;
+    }
+    MBASE_LOG_WARN("Adapter override: no usable adapter with vendor ID {:#06x} and device ID {:#06x}; selecting by score",
+      adapter_override.vendor_id, adapter_override.device_id);
+  }
+
+  return best;
+}
+
+} // namespace mnexus_backend::adapter
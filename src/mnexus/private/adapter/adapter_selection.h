@@ -0,0 +1,60 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <optional>
+#include <span>
+#include <string_view>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+namespace mnexus_backend::adapter {
+
+// ----------------------------------------------------------------------------------------------------
+// Adapter selection
+//
+// Backend-neutral scoring of the adapters a backend enumerates. Backends describe each adapter with an
+// `AdapterCandidate` and let `SelectAdapter` pick one, so the policy can be tested without a GPU.
+//
+
+enum class AdapterKind : uint32_t {
+  kOther,
+  kCpu,
+  kVirtualGpu,
+  kIntegratedGpu,
+  kDiscreteGpu,
+};
+
+struct AdapterCandidate final {
+  std::string_view name;
+  uint32_t vendor_id = 0;
+  uint32_t device_id = 0;
+  AdapterKind kind = AdapterKind::kOther;
+  /// Every extension and feature the backend cannot work without. Candidates without it are never selected.
+  bool required_features_supported = false;
+  /// How many of the optional features the backend asked for are supported.
+  uint32_t optional_feature_count = 0;
+  /// A queue family supports both graphics and compute. Candidates without one are never selected.
+  bool has_universal_queue = false;
+  /// A queue family supports compute but not graphics.
+  bool has_dedicated_compute_queue = false;
+  /// A queue family supports transfer but neither graphics nor compute.
+  bool has_dedicated_transfer_queue = false;
+  /// Size of the largest device-local memory heap.
+  uint64_t device_local_heap_size_in_bytes = 0;
+};
+
+/// 0 if the candidate is unusable. Otherwise ranks by kind, then optional feature count, then queue family layout,
+/// then device-local heap size, each criterion only breaking ties of the previous ones.
+[[nodiscard]] uint64_t ScoreAdapter(AdapterCandidate const& candidate);
+
+/// Index of the candidate to use: the one `adapter_override` names if it is usable, otherwise the highest scoring
+/// one, the earliest on ties. `std::nullopt` if no candidate is usable.
+[[nodiscard]] std::optional<uint32_t> SelectAdapter(
+  std::span<AdapterCandidate const> candidates,
+  mnexus::AdapterOverride const& adapter_override
+);
+
+} // namespace mnexus_backend::adapter
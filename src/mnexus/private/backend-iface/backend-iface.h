@@ -24,6 +24,8 @@ public:
 
   virtual void OnPresentPrologue() = 0;
   virtual void OnPresentEpilogue() = 0;
+  /// Presented images still queued for display; 0 when the backend cannot tell.
+  virtual uint32_t GetPresentQueueDepth() = 0;
 
   // ----------------------------------------------------------------------------------------------
   // Device.
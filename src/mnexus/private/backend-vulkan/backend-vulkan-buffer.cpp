@@ -2,18 +2,22 @@
 #include "backend-vulkan/backend-vulkan-buffer.h"
 
 // c++ headers ------------------------------------------
+#include <cstddef>
+
 #include <optional>
 
 // public project headers -------------------------------
 #include "mbase/public/log.h"
 
 // project headers --------------------------------------
+#include "backend-vulkan/resource/placed_buffer_allocator.h"
 #include "backend-vulkan/resource/types_bridge.h"
 
 namespace mnexus_backend::vulkan {
 
 struct CreateVulkanBufferResult {
   VulkanBuffer vk_buffer;
+  VkDeviceSize base_offset = 0;
   void* mapped_data = nullptr;
   VmaAllocation vma_allocation = VK_NULL_HANDLE;
 };
@@ -36,6 +40,9 @@ std::optional<CreateVulkanBufferResult> CreateVulkanBuffer(
     .queueFamilyIndexCount = 0,
     .pQueueFamilyIndices = nullptr,
   };
+  SetQueueFamilySharing(
+    vk_device, create_info, buffer_desc.usage.HasAnyOf(mnexus::BufferUsageFlagBits::kConcurrentQueueFamilies)
+  );
 
   VmaAllocator const vma_allocator = vk_device.vma_allocator();
 
@@ -65,12 +72,9 @@ std::optional<CreateVulkanBufferResult> CreateVulkanBuffer(
     return std::nullopt;
   }
 
-  VkDevice vk_device_handle = vk_device.handle();
   VulkanBuffer vk_buffer(
     vk_buffer_handle,
-    [vk_device_handle, vk_buffer_handle, allocation, vma_allocator] {
-      vmaDestroyBuffer(vma_allocator, vk_buffer_handle, allocation);
-    },
+    VulkanObjectDestroyInfo { .type = VulkanObjectType::kVmaBuffer, .context = allocation },
     vk_device.GetDeferredDestroyer()
   );
 
@@ -81,12 +85,53 @@ std::optional<CreateVulkanBufferResult> CreateVulkanBuffer(
   };
 }
 
+std::optional<CreateVulkanBufferResult> CreatePlacedVulkanBuffer(
+  IVulkanDevice const& vk_device,
+  PlacedBufferAllocator& placed_buffer_allocator,
+  mnexus::BufferDesc const& buffer_desc
+) {
+  std::optional<PlacedBufferRange> opt_range = placed_buffer_allocator.Allocate(buffer_desc);
+  if (!opt_range.has_value()) {
+    return std::nullopt;
+  }
+
+  PlacedBufferRange& range = *opt_range;
+  PlacedBufferBlock* block = range.block.get();
+
+  void* mapped_data = block->mapped_data() != nullptr
+    ? static_cast<std::byte*>(block->mapped_data()) + range.offset
+    : nullptr;
+
+  // The destroy info keeps the block alive until the range is returned, which the deferred destroyer does only once
+  // the GPU is done with it.
+  VulkanBuffer vk_buffer(
+    block->vk_buffer(),
+    VulkanObjectDestroyInfo {
+      .type = VulkanObjectType::kPlacedBufferRange,
+      .aux = VulkanHandleToU64(range.allocation),
+      .keep_alive = std::move(range.block),
+    },
+    vk_device.GetDeferredDestroyer()
+  );
+
+  return CreateVulkanBufferResult {
+    .vk_buffer = std::move(vk_buffer),
+    .base_offset = range.offset,
+    .mapped_data = mapped_data,
+    .vma_allocation = block->vma_allocation(),
+  };
+}
+
 resource_pool::ResourceHandle EmplaceBufferResourcePool(
   BufferResourcePool& out_pool,
   IVulkanDevice const& vk_device,
+  PlacedBufferAllocator* placed_buffer_allocator,
   mnexus::BufferDesc const& buffer_desc
 ) {
-  std::optional<CreateVulkanBufferResult> opt_result = CreateVulkanBuffer(vk_device, buffer_desc);
+  std::optional<CreateVulkanBufferResult> opt_result =
+    placed_buffer_allocator != nullptr && placed_buffer_allocator->ShouldPlace(buffer_desc)
+      ? CreatePlacedVulkanBuffer(vk_device, *placed_buffer_allocator, buffer_desc)
+      : CreateVulkanBuffer(vk_device, buffer_desc);
   if (!opt_result.has_value()) {
     return resource_pool::ResourceHandle::Null();
   }
@@ -95,6 +140,7 @@ resource_pool::ResourceHandle EmplaceBufferResourcePool(
 
   BufferHot hot {
     .vk_buffer = std::move(result.vk_buffer),
+    .base_offset = result.base_offset,
     .mapped_data = result.mapped_data,
     .vma_allocation = result.vma_allocation,
     .vma_allocator = vk_device.vma_allocator(),
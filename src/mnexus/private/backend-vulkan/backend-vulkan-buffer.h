@@ -12,9 +12,12 @@
 
 namespace mnexus_backend::vulkan {
 
+class PlacedBufferAllocator;
+
 struct BufferHot final {
-  VulkanBuffer vk_buffer;
-  void* mapped_data = nullptr;                     // Non-null if mappable.
+  VulkanBuffer vk_buffer;                          // Shared block buffer if placed.
+  VkDeviceSize base_offset = 0;                    // Offset of this buffer within `vk_buffer`; non-zero only if placed.
+  void* mapped_data = nullptr;                     // Non-null if mappable. Already includes `base_offset`.
   VmaAllocation vma_allocation = VK_NULL_HANDLE;   // For flush.
   VmaAllocator vma_allocator = VK_NULL_HANDLE;     // For flush.
 
@@ -32,6 +35,7 @@ using BufferResourcePool = resource_pool::TResourceGenerationalPool<BufferHot, B
 resource_pool::ResourceHandle EmplaceBufferResourcePool(
   BufferResourcePool& out_pool,
   IVulkanDevice const& vk_device,
+  PlacedBufferAllocator* placed_buffer_allocator, // Optional; small buffers are placed if non-null.
   mnexus::BufferDesc const& buffer_desc
 );
 
@@ -1,6 +1,14 @@
 // TU header --------------------------------------------
 #include "backend-vulkan/backend-vulkan-command_list.h"
 
+// c++ headers ------------------------------------------
+#include <algorithm>
+#include <string>
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+#include "mbase/public/log.h"
+
 // project headers --------------------------------------
 #include "impl/impl_macros.h"
 
@@ -11,11 +19,25 @@ namespace mnexus_backend::vulkan {
 
 MnexusCommandListVulkan::MnexusCommandListVulkan(
   CommandEncoder encoder,
-  ResourceStorage* resource_storage
+  ThreadCommandBuffer thread_command_buffer,
+  VkQueueFlags queue_flags,
+  ResourceStorage* resource_storage,
+  std::unique_ptr<profiling::GpuTimingRecorder> gpu_timing_recorder,
+  VkQueryPool gpu_timing_query_pool
 ) :
   encoder_(std::move(encoder)),
-  resource_storage_(resource_storage)
+  thread_command_buffer_(thread_command_buffer),
+  resource_storage_(resource_storage),
+  pending_pipeline_barrier_(queue_flags),
+  gpu_timing_recorder_(std::move(gpu_timing_recorder)),
+  gpu_timing_query_pool_(gpu_timing_query_pool)
 {
+  encoder_.set_perf_counters(&perf_counters_);
+
+  if (gpu_timing_recorder_ != nullptr) {
+    MBASE_ASSERT(gpu_timing_query_pool_ != VK_NULL_HANDLE);
+    vkCmdResetQueryPool(encoder_.command_buffer(), gpu_timing_query_pool_, 0, gpu_timing_recorder_->GetQueryCapacity());
+  }
 }
 
 // --------------------------------------------------------------------------------------------------
@@ -23,10 +45,15 @@ MnexusCommandListVulkan::MnexusCommandListVulkan(
 //
 
 MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::End() {
+  MBASE_ASSERT_MSG(gpu_timing_recorder_ == nullptr || gpu_timing_recorder_->GetOpenScopeCount() == 0,
+    "Every PushDebugGroup must be matched by a PopDebugGroup before calling End");
+
   // Transition all tracked images back to their default layouts before finalizing.
   image_layout_tracker_.TransitionAllToDefaults();
   image_layout_tracker_.FlushPendingTransitions(pending_pipeline_barrier_);
-  pending_pipeline_barrier_.FlushAndClear(encoder_.command_buffer());
+  perf_counters_.Add(
+    profiling::PerfCounter::kBarriersEmitted, pending_pipeline_barrier_.FlushAndClear(encoder_.command_buffer())
+  );
 
   encoder_.End();
 }
@@ -39,18 +66,69 @@ MNEXUS_NO_THROW mnexus::RenderStateEventLog& MNEXUS_CALL MnexusCommandListVulkan
   return render_state_event_log_;
 }
 
+MNEXUS_NO_THROW mnexus::PerfCountersSnapshot MNEXUS_CALL MnexusCommandListVulkan::GetPerfCountersSnapshot() {
+  return perf_counters_.Snapshot();
+}
+
 //
 // Debug Markers
 //
 
 MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::PushDebugGroup(
-  mnexus::container::ArrayProxy<char const> /*name*/, float const* /*color*/
+  mnexus::container::ArrayProxy<char const> name, float const* color
 ) {
-  STUB_NOT_IMPLEMENTED();
+  // Build a null-terminated label from the ArrayProxy.
+  std::string label(name.data(), name.size());
+
+  // Loaded by volk only when `VK_EXT_debug_utils` is enabled on the instance.
+  if (vkCmdBeginDebugUtilsLabelEXT != nullptr) {
+    VkDebugUtilsLabelEXT label_info {
+      .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT,
+      .pNext = nullptr,
+      .pLabelName = label.c_str(),
+      .color = {},
+    };
+    if (color != nullptr) {
+      std::copy_n(color, 4, label_info.color);
+    }
+    vkCmdBeginDebugUtilsLabelEXT(encoder_.command_buffer(), &label_info);
+  }
+
+  if (gpu_timing_recorder_ == nullptr) {
+    return;
+  }
+
+  uint32_t const scope_index = gpu_timing_recorder_->PushScope(
+    label,
+    mnexus::GpuTimingScopeKind::kDebugGroup,
+    /*timestamped=*/true
+  );
+
+  profiling::GpuTimingRecorder::Scope const& scope = gpu_timing_recorder_->GetScope(scope_index);
+  if (scope.begin_query != profiling::GpuTimingRecorder::kNoQuery) {
+    vkCmdWriteTimestamp2KHR(
+      encoder_.command_buffer(), VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR, gpu_timing_query_pool_, scope.begin_query
+    );
+  }
 }
 
 MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::PopDebugGroup() {
-  STUB_NOT_IMPLEMENTED();
+  if (vkCmdEndDebugUtilsLabelEXT != nullptr) {
+    vkCmdEndDebugUtilsLabelEXT(encoder_.command_buffer());
+  }
+
+  if (gpu_timing_recorder_ == nullptr) {
+    return;
+  }
+
+  uint32_t const scope_index = gpu_timing_recorder_->PopScope();
+
+  profiling::GpuTimingRecorder::Scope const& scope = gpu_timing_recorder_->GetScope(scope_index);
+  if (scope.end_query != profiling::GpuTimingRecorder::kNoQuery) {
+    vkCmdWriteTimestamp2KHR(
+      encoder_.command_buffer(), VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR, gpu_timing_query_pool_, scope.end_query
+    );
+  }
 }
 
 //
@@ -91,7 +169,9 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::ClearTexture(
   }
 
   image_layout_tracker_.FlushPendingTransitions(pending_pipeline_barrier_);
-  pending_pipeline_barrier_.FlushAndClear(encoder_.command_buffer());
+  perf_counters_.Add(
+    profiling::PerfCounter::kBarriersEmitted, pending_pipeline_barrier_.FlushAndClear(encoder_.command_buffer())
+  );
 
   VkImageSubresourceRange const vk_range = ToVkImageSubresourceRange(subresource_range);
 
@@ -165,11 +245,13 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::CopyBufferToTexture(
 
   // Flush the layout transition barrier before the copy.
   image_layout_tracker_.FlushPendingTransitions(pending_pipeline_barrier_);
-  pending_pipeline_barrier_.FlushAndClear(encoder_.command_buffer());
+  perf_counters_.Add(
+    profiling::PerfCounter::kBarriersEmitted, pending_pipeline_barrier_.FlushAndClear(encoder_.command_buffer())
+  );
 
   // Build copy region. Vulkan supports tightly packed source data natively (bufferRowLength = 0).
   VkBufferImageCopy const region {
-    .bufferOffset = src_buffer_offset,
+    .bufferOffset = src_hot.base_offset + src_buffer_offset,
     .bufferRowLength = 0,
     .bufferImageHeight = 0,
     .imageSubresource = ToVkImageSubresourceLayers(dst_subresource_range),
@@ -215,6 +297,209 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::BlitTexture(
   STUB_NOT_IMPLEMENTED();
 }
 
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::GenerateMipmaps(
+  mnexus::TextureHandle texture_handle,
+  mnexus::TextureSubresourceRange const& subresource_range
+) {
+  if (subresource_range.mip_level_count < 2) {
+    return;
+  }
+
+  auto const pool_handle = resource_pool::ResourceHandle::FromU64(texture_handle.Get());
+  auto [hot, cold, lock] = resource_storage_->textures.GetConstRefWithSharedLockGuard(pool_handle);
+
+  VkImage const vk_image = hot.GetVkImage().handle();
+  mnexus::TextureDesc const& desc = cold.GetTextureDesc();
+  VkFormat const vk_format = ToVkFormat(desc.format);
+
+  MBASE_ASSERT(subresource_range.base_mip_level + subresource_range.mip_level_count <= desc.mip_level_count);
+
+  // A linear `vkCmdBlitImage` is only valid if the format supports linear filtering as well as blitting; a nearest
+  // blit would not be the documented box filter, so such formats are rejected.
+  constexpr VkFormatFeatureFlags kRequiredFormatFeatures =
+    VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+  if ((cold.GetFormatFeatures() & kRequiredFormatFeatures) != kRequiredFormatFeatures) {
+    MBASE_LOG_ERROR("GenerateMipmaps: format {} does not support linear blits", static_cast<int32_t>(vk_format));
+    return;
+  }
+
+  image_layout_tracker_.RegisterImage(
+    vk_image,
+    ToVkImageUsageFlags(desc.usage, vk_format),
+    vk_format,
+    desc.mip_level_count,
+    desc.array_layer_count
+  );
+
+  uint32_t const layer_begin = subresource_range.base_array_layer;
+  uint32_t const layer_end = layer_begin + subresource_range.array_layer_count;
+  uint32_t const level_end = subresource_range.base_mip_level + subresource_range.mip_level_count;
+
+  // Each level is blitted from the previous one, so level N - 1 must be fully written (and transitioned to transfer
+  // src) before level N is read.
+  for (uint32_t level = subresource_range.base_mip_level + 1; level < level_end; ++level) {
+    for (uint32_t layer = layer_begin; layer < layer_end; ++layer) {
+      image_layout_tracker_.TransitionToTransferSrc(vk_image, { .mip_level = level - 1, .array_layer = layer });
+      image_layout_tracker_.TransitionToTransferDst(vk_image, { .mip_level = level, .array_layer = layer });
+    }
+
+    image_layout_tracker_.FlushPendingTransitions(pending_pipeline_barrier_);
+    perf_counters_.Add(
+      profiling::PerfCounter::kBarriersEmitted, pending_pipeline_barrier_.FlushAndClear(encoder_.command_buffer())
+    );
+
+    // Blitting the source's even-sized prefix makes the scale exactly 2:1, so every linear sample lands on the
+    // corner shared by a 2x2 footprint and yields the documented box filter. A trailing odd row or column is left
+    // out, as the clamped footprint never reaches it; a 1-texel axis is copied as is.
+    uint32_t const src_width = std::max(1u, desc.width >> (level - 1));
+    uint32_t const src_height = std::max(1u, desc.height >> (level - 1));
+    uint32_t const dst_width = std::max(1u, desc.width >> level);
+    uint32_t const dst_height = std::max(1u, desc.height >> level);
+
+    VkImageBlit const region {
+      .srcSubresource = {
+        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .mipLevel = level - 1,
+        .baseArrayLayer = layer_begin,
+        .layerCount = subresource_range.array_layer_count,
+      },
+      .srcOffsets = {
+        { 0, 0, 0 },
+        {
+          static_cast<int32_t>(std::min(src_width, dst_width * 2)),
+          static_cast<int32_t>(std::min(src_height, dst_height * 2)),
+          1,
+        },
+      },
+      .dstSubresource = {
+        .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+        .mipLevel = level,
+        .baseArrayLayer = layer_begin,
+        .layerCount = subresource_range.array_layer_count,
+      },
+      .dstOffsets = {
+        { 0, 0, 0 },
+        {
+          static_cast<int32_t>(dst_width),
+          static_cast<int32_t>(dst_height),
+          1,
+        },
+      },
+    };
+
+    vkCmdBlitImage(
+      encoder_.command_buffer(),
+      vk_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      vk_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      1, &region,
+      VK_FILTER_LINEAR
+    );
+  }
+
+  // Track referenced resources for submit-time stamping.
+  referenced_resources_.push_back(pool_handle);
+}
+
+//
+// Synchronization
+//
+
+namespace {
+
+struct TextureAccessState final {
+  SyncScope scope;
+  VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+};
+
+/// Must match the scopes the commands request from `ImageLayoutTracker`, or their own barriers are not elided.
+TextureAccessState GetTextureAccessState(mnexus::TextureAccess access, VkFormat vk_format) {
+  switch (access) {
+  case mnexus::TextureAccess::kSampled:
+    return {
+      { VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR, VK_ACCESS_2_SHADER_READ_BIT_KHR },
+      VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR,
+    };
+  case mnexus::TextureAccess::kUnorderedAccess:
+    return {
+      {
+        VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR,
+        VK_ACCESS_2_SHADER_STORAGE_READ_BIT_KHR | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT_KHR
+      },
+      VK_IMAGE_LAYOUT_GENERAL,
+    };
+  case mnexus::TextureAccess::kAttachment:
+    return {
+      ImageLayoutTracker::GetDefaultSyncScope(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, vk_format),
+      VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR,
+    };
+  case mnexus::TextureAccess::kTransferSrc:
+    return {
+      { VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_READ_BIT_KHR },
+      VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+    };
+  case mnexus::TextureAccess::kTransferDst:
+    return {
+      { VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR },
+      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+    };
+  case mnexus::TextureAccess::kDiscarded:
+    break;
+  }
+  MBASE_ASSERT_MSG(false, "GetTextureAccessState: no layout for kDiscarded");
+  return {};
+}
+
+} // namespace
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::TransitionTextures(
+  mnexus::container::ArrayProxy<mnexus::TextureTransitionDesc const> transitions
+) {
+  for (mnexus::TextureTransitionDesc const& transition : transitions) {
+    auto const pool_handle = resource_pool::ResourceHandle::FromU64(transition.texture.Get());
+    auto [hot, cold, lock] = resource_storage_->textures.GetConstRefWithSharedLockGuard(pool_handle);
+
+    VkImage const vk_image = hot.GetVkImage().handle();
+
+    if (transition.access == mnexus::TextureAccess::kDiscarded) {
+      image_layout_tracker_.Release(vk_image);
+      continue;
+    }
+
+    mnexus::TextureDesc const& desc = cold.GetTextureDesc();
+    VkFormat const vk_format = ToVkFormat(desc.format);
+
+    image_layout_tracker_.RegisterImage(
+      vk_image,
+      ToVkImageUsageFlags(desc.usage, vk_format),
+      vk_format,
+      desc.mip_level_count,
+      desc.array_layer_count
+    );
+
+    TextureAccessState const state = GetTextureAccessState(transition.access, vk_format);
+    mnexus::TextureSubresourceRange const& range = transition.subresource_range;
+
+    for (uint32_t mip = range.base_mip_level; mip < range.base_mip_level + range.mip_level_count; ++mip) {
+      for (uint32_t layer = range.base_array_layer; layer < range.base_array_layer + range.array_layer_count; ++layer) {
+        ImageLayoutTracker::Subresource const subresource { .mip_level = mip, .array_layer = layer };
+        if (transition.discard_contents) {
+          image_layout_tracker_.Discard(vk_image, subresource);
+        }
+        image_layout_tracker_.Prepare(
+          vk_image, subresource, state.scope.stage_mask, state.scope.access_mask, state.layout
+        );
+      }
+    }
+
+    referenced_resources_.push_back(pool_handle);
+  }
+
+  image_layout_tracker_.FlushPendingTransitions(pending_pipeline_barrier_);
+  perf_counters_.Add(
+    profiling::PerfCounter::kBarriersEmitted, pending_pipeline_barrier_.FlushAndClear(encoder_.command_buffer())
+  );
+}
+
 //
 // Compute
 //
@@ -231,12 +516,16 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::BindExplicitComputePip
     hot.vk_compute_pipeline().handle(),
     pipeline_layout_ref->handle(),
     pipeline_layout_ref->descriptor_set_layouts.data(),
-    static_cast<uint32_t>(pipeline_layout_ref->descriptor_set_layouts.size())
+    static_cast<uint32_t>(pipeline_layout_ref->descriptor_set_layouts.size()),
+    pipeline_layout_ref->push_constant_range
   );
+  perf_counters_.Add(profiling::PerfCounter::kPipelineSwitches);
 
   // Track referenced resources for submit-time stamping.
   referenced_resources_.push_back(pool_handle);
-  referenced_resources_.push_back(resource_pool::ResourceHandle::FromU64(cold.program_handle().Get()));
+  auto const program_pool_handle = resource_pool::ResourceHandle::FromU64(cold.program_handle().Get());
+  referenced_resources_.push_back(program_pool_handle);
+  resource_storage_->AddListReference(program_pool_handle);
   referenced_resources_.push_back(resource_pool::ResourceHandle::FromU64(cold.shader_module_handle().Get()));
 }
 
@@ -246,6 +535,7 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::DispatchCompute(
   uint32_t workgroup_count_z
 ) {
   encoder_.DispatchCompute(workgroup_count_x, workgroup_count_y, workgroup_count_z);
+  perf_counters_.Add(profiling::PerfCounter::kDispatches);
 }
 
 //
@@ -263,7 +553,7 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::BindUniformBuffer(
   encoder_.BindBuffer(
     id.group, id.binding, id.array_element,
     VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-    buffer_handle.Get(), hot.vk_buffer.handle(), offset, size
+    buffer_handle.Get(), hot.vk_buffer.handle(), hot.base_offset + offset, size
   );
   referenced_resources_.push_back(pool_handle);
 }
@@ -279,7 +569,7 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::BindStorageBuffer(
   encoder_.BindBuffer(
     id.group, id.binding, id.array_element,
     VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-    buffer_handle.Get(), hot.vk_buffer.handle(), offset, size
+    buffer_handle.Get(), hot.vk_buffer.handle(), hot.base_offset + offset, size
   );
   referenced_resources_.push_back(pool_handle);
 }
@@ -299,6 +589,19 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::BindSampler(
   STUB_NOT_IMPLEMENTED();
 }
 
+//
+// Push Constants
+//
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::SetPushConstants(
+  mnexus::ShaderStageFlags stages,
+  uint32_t offset,
+  void const* data,
+  uint32_t size_in_bytes
+) {
+  encoder_.SetPushConstants(ToVkShaderStageFlags(stages), offset, data, size_in_bytes);
+}
+
 //
 // Explicit Pipeline Binding
 //
@@ -473,4 +776,14 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::SetScissor(
   STUB_NOT_IMPLEMENTED();
 }
 
+//
+// Render Bundle
+//
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListVulkan::ExecuteBundles(
+  mnexus::container::ArrayProxy<mnexus::RenderBundleHandle const> /*render_bundles*/
+) {
+  STUB_NOT_IMPLEMENTED();
+}
+
 } // namespace mnexus_backend::vulkan
@@ -1,6 +1,7 @@
 #pragma once
 
 // c++ headers ------------------------------------------
+#include <memory>
 #include <vector>
 
 // public project headers -------------------------------
@@ -14,6 +15,10 @@
 
 #include "backend-vulkan/command/command_encoder.h"
 #include "backend-vulkan/command/image_layout_tracker.h"
+#include "backend-vulkan/device/thread_command_pool.h"
+
+#include "profiling/gpu_timing.h"
+#include "profiling/perf_counters.h"
 
 namespace mnexus_backend::vulkan {
 
@@ -21,12 +26,29 @@ struct ResourceStorage;
 
 class MnexusCommandListVulkan : public mnexus::ICommandList {
 public:
-  MnexusCommandListVulkan(CommandEncoder encoder, ResourceStorage* resource_storage);
+  /// `thread_command_buffer` is the buffer `encoder` records into; it is returned to its pool on submit or discard.
+  /// `queue_flags` are the capabilities of the queue family the buffer was allocated for.
+  /// `gpu_timing_recorder` and `gpu_timing_query_pool` are null unless GPU timing was enabled when the command list
+  /// was created. The query pool is owned by the device.
+  MnexusCommandListVulkan(
+    CommandEncoder encoder,
+    ThreadCommandBuffer thread_command_buffer,
+    VkQueueFlags queue_flags,
+    ResourceStorage* resource_storage,
+    std::unique_ptr<profiling::GpuTimingRecorder> gpu_timing_recorder = nullptr,
+    VkQueryPool gpu_timing_query_pool = VK_NULL_HANDLE
+  );
   ~MnexusCommandListVulkan() override = default;
 
   [[nodiscard]] CommandEncoder& encoder() { return encoder_; }
+  [[nodiscard]] ThreadCommandBuffer const& thread_command_buffer() const { return thread_command_buffer_; }
   [[nodiscard]] mbase::ArrayProxy<resource_pool::ResourceHandle const> GetReferencedResources() const { return referenced_resources_; }
 
+  [[nodiscard]] VkQueryPool gpu_timing_query_pool() const { return gpu_timing_query_pool_; }
+  [[nodiscard]] std::unique_ptr<profiling::GpuTimingRecorder> TakeGpuTimingRecorder() { return std::move(gpu_timing_recorder_); }
+
+  [[nodiscard]] profiling::CommandListPerfCounters const& perf_counters() const { return perf_counters_; }
+
   // --------------------------------------------------------------------------------------------------
   // mnexus::ICommandList implementation
   //
@@ -38,6 +60,7 @@ public:
   //
 
   MNEXUS_NO_THROW mnexus::RenderStateEventLog& MNEXUS_CALL GetStateEventLog() override;
+  MNEXUS_NO_THROW mnexus::PerfCountersSnapshot MNEXUS_CALL GetPerfCountersSnapshot() override;
 
   //
   // Debug Markers
@@ -86,6 +109,19 @@ public:
     mnexus::Filter filter
   ) override;
 
+  MNEXUS_NO_THROW void MNEXUS_CALL GenerateMipmaps(
+    mnexus::TextureHandle texture_handle,
+    mnexus::TextureSubresourceRange const& subresource_range
+  ) override;
+
+  //
+  // Synchronization
+  //
+
+  MNEXUS_NO_THROW void MNEXUS_CALL TransitionTextures(
+    mnexus::container::ArrayProxy<mnexus::TextureTransitionDesc const> transitions
+  ) override;
+
   //
   // Compute
   //
@@ -129,6 +165,17 @@ public:
     mnexus::SamplerHandle sampler_handle
   ) override;
 
+  //
+  // Push Constants
+  //
+
+  MNEXUS_NO_THROW void MNEXUS_CALL SetPushConstants(
+    mnexus::ShaderStageFlags stages,
+    uint32_t offset,
+    void const* data,
+    uint32_t size_in_bytes
+  ) override;
+
   //
   // Explicit Pipeline Binding
   //
@@ -228,13 +275,26 @@ public:
     int32_t x, int32_t y, uint32_t width, uint32_t height
   ) override;
 
+  //
+  // Render Bundle
+  //
+
+  MNEXUS_NO_THROW void MNEXUS_CALL ExecuteBundles(
+    mnexus::container::ArrayProxy<mnexus::RenderBundleHandle const> render_bundles
+  ) override;
+
 private:
   CommandEncoder encoder_;
+  ThreadCommandBuffer thread_command_buffer_;
   ResourceStorage* resource_storage_ = nullptr;
   std::vector<resource_pool::ResourceHandle> referenced_resources_;
   ImageLayoutTracker image_layout_tracker_;
   PendingPipelineBarrier pending_pipeline_barrier_;
   mnexus::RenderStateEventLog render_state_event_log_;
+  profiling::CommandListPerfCounters perf_counters_;
+
+  std::unique_ptr<profiling::GpuTimingRecorder> gpu_timing_recorder_;
+  VkQueryPool gpu_timing_query_pool_ = VK_NULL_HANDLE;
 };
 
 } // namespace mnexus_backend::vulkan
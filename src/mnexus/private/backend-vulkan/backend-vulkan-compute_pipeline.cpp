@@ -51,10 +51,9 @@ bool CreateVulkanComputePipeline(
     return false;
   }
 
-  VkDevice vk_device_handle = vk_device.handle();
   out_vk_compute_pipeline = VulkanComputePipeline(
     vk_pipeline_handle,
-    [vk_device_handle, vk_pipeline_handle] { vkDestroyPipeline(vk_device_handle, vk_pipeline_handle, nullptr); },
+    VulkanObjectDestroyInfo { .type = VulkanObjectType::kPipeline },
     vk_device.GetDeferredDestroyer()
   );
   return true;
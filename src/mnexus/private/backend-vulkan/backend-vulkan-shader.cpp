@@ -5,6 +5,7 @@
 #include <vector>
 
 // project headers --------------------------------------
+#include "backend-vulkan/descriptor/bindless_table.h"
 #include "backend-vulkan/resource/shader_module.h"
 #include "backend-vulkan/resource/types_bridge.h"
 
@@ -46,11 +47,10 @@ resource_pool::ResourceHandle EmplaceShaderModuleResourcePool(
     return resource_pool::ResourceHandle::Null();
   }
 
-  VkDevice vk_device = device.handle();
   ShaderModuleHot hot {
     .vk_shader_module = VulkanShaderModule(
       vk_shader_module_handle,
-      [vk_device, vk_shader_module_handle] { vkDestroyShaderModule(vk_device, vk_shader_module_handle, nullptr); },
+      VulkanObjectDestroyInfo { .type = VulkanObjectType::kShaderModule },
       device.GetDeferredDestroyer()
     ),
   };
@@ -69,7 +69,8 @@ resource_pool::ResourceHandle EmplaceProgramResourcePool(
   IVulkanDevice const& device,
   mnexus::ProgramDesc const& program_desc,
   ShaderModuleResourcePool const& shader_module_pool,
-  pipeline::TPipelineLayoutCache<VulkanPipelineLayoutPtr>& pipeline_layout_cache
+  pipeline::TPipelineLayoutCache<VulkanPipelineLayoutPtr>& pipeline_layout_cache,
+  BindlessTable const* bindless_table
 ) {
   // Phase 1: Merge bind group layouts from all shader modules.
   shader::MergedPipelineLayout merged_pipeline_layout;
@@ -90,9 +91,33 @@ resource_pool::ResourceHandle EmplaceProgramResourcePool(
   }
 
   mbase::ArrayProxy<shader::BindGroupLayout const> merged_layouts = merged_pipeline_layout.GetBindGroupLayouts();
+  shader::PushConstantRange const& merged_push_constant_range = merged_pipeline_layout.GetPushConstantRange();
+
+  if (merged_push_constant_range.end() > mnexus::kMaxPushConstantSizeInBytes) {
+    MBASE_LOG_ERROR("Push constant block ends at byte {}, exceeding the {} byte limit",
+      merged_push_constant_range.end(), mnexus::kMaxPushConstantSizeInBytes);
+    return resource_pool::ResourceHandle::Null();
+  }
+
+  // With the bindless table, `kBindlessBindGroup` **MUST** only declare the table's bindings; the set is replaced
+  // by the table's own layout.
+  bool const use_bindless_set = bindless_table != nullptr && mnexus::kBindlessBindGroup < merged_layouts.size();
+  if (use_bindless_set) {
+    for (shader::BindGroupLayoutEntry const& entry : merged_layouts[mnexus::kBindlessBindGroup].entries) {
+      bool const matches =
+        (entry.binding == mnexus::kBindlessSampledTextureBinding && entry.type == mnexus::BindGroupLayoutEntryType::kSampledTexture) ||
+        (entry.binding == mnexus::kBindlessStorageBufferBinding && entry.type == mnexus::BindGroupLayoutEntryType::kStorageBuffer) ||
+        (entry.binding == mnexus::kBindlessSamplerBinding && entry.type == mnexus::BindGroupLayoutEntryType::kSampler);
+      if (!matches) {
+        MBASE_LOG_ERROR("Binding {} of the bindless bind group ({}) does not match the bindless table layout",
+          entry.binding, mnexus::kBindlessBindGroup);
+        return resource_pool::ResourceHandle::Null();
+      }
+    }
+  }
 
   // Phase 2: Look up or create the pipeline layout via cache.
-  pipeline::PipelineLayoutCacheKey layout_key = pipeline::BuildPipelineLayoutCacheKey(merged_layouts);
+  pipeline::PipelineLayoutCacheKey layout_key = pipeline::BuildPipelineLayoutCacheKey(merged_layouts, merged_push_constant_range);
 
   VulkanPipelineLayoutPtr pipeline_layout_ptr = pipeline_layout_cache.FindOrInsert(
     layout_key,
@@ -103,6 +128,14 @@ resource_pool::ResourceHandle EmplaceProgramResourcePool(
       raw_dsls.reserve(merged_layouts.size());
 
       for (uint32_t set_index = 0; set_index < merged_layouts.size(); ++set_index) {
+        if (use_bindless_set && set_index == mnexus::kBindlessBindGroup) {
+          // Non-owning: the table outlives every pipeline layout.
+          dsls.emplace_back(VulkanDescriptorSetLayout(bindless_table->descriptor_set_layout(), {}, nullptr, {}));
+          dsls.back().bindless = true;
+          raw_dsls.push_back(bindless_table->descriptor_set_layout());
+          continue;
+        }
+
         shader::BindGroupLayout const& merged_bgl = merged_layouts[set_index];
 
         mbase::SmallVector<VkDescriptorSetLayoutBinding, 4> vk_bindings;
@@ -134,11 +167,10 @@ resource_pool::ResourceHandle EmplaceProgramResourcePool(
           return nullptr;
         }
 
-        VkDevice dev = device.handle();
         dsls.emplace_back(
           VulkanDescriptorSetLayout(
             vk_dsl,
-            [dev, vk_dsl] { vkDestroyDescriptorSetLayout(dev, vk_dsl, nullptr); },
+            VulkanObjectDestroyInfo { .type = VulkanObjectType::kDescriptorSetLayout },
             device.GetDeferredDestroyer(),
             vk_bindings
           )
@@ -146,13 +178,21 @@ resource_pool::ResourceHandle EmplaceProgramResourcePool(
         raw_dsls.push_back(vk_dsl);
       }
 
+      // A single range covering every stage's block; `vkCmdPushConstants` then always uses its stage flags.
+      VkPushConstantRange vk_push_constant_range {};
+      if (!merged_push_constant_range.IsEmpty()) {
+        vk_push_constant_range.stageFlags = ToVkShaderStageFlags(merged_push_constant_range.stages);
+        vk_push_constant_range.offset = merged_push_constant_range.offset;
+        vk_push_constant_range.size = merged_push_constant_range.size;
+      }
+
       // Create VkPipelineLayout from descriptor set layouts.
       VkPipelineLayoutCreateInfo pl_create_info {};
       pl_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
       pl_create_info.setLayoutCount = static_cast<uint32_t>(raw_dsls.size());
       pl_create_info.pSetLayouts = raw_dsls.data();
-      pl_create_info.pushConstantRangeCount = 0;
-      pl_create_info.pPushConstantRanges = nullptr;
+      pl_create_info.pushConstantRangeCount = vk_push_constant_range.size > 0 ? 1 : 0;
+      pl_create_info.pPushConstantRanges = vk_push_constant_range.size > 0 ? &vk_push_constant_range : nullptr;
 
       VkPipelineLayout vk_pl = VK_NULL_HANDLE;
       VkResult result = vkCreatePipelineLayout(device.handle(), &pl_create_info, nullptr, &vk_pl);
@@ -161,14 +201,14 @@ resource_pool::ResourceHandle EmplaceProgramResourcePool(
         return nullptr;
       }
 
-      // Construct VulkanPipelineLayout with handle + destroy callback, then attach DSLs.
-      VkDevice dev = device.handle();
+      // Construct VulkanPipelineLayout with handle + destroy info, then attach DSLs.
       auto layout = std::make_shared<VulkanPipelineLayout>(
         vk_pl,
-        [dev, vk_pl] { vkDestroyPipelineLayout(dev, vk_pl, nullptr); },
+        VulkanObjectDestroyInfo { .type = VulkanObjectType::kPipelineLayout },
         device.GetDeferredDestroyer()
       );
       layout->descriptor_set_layouts = std::move(dsls);
+      layout->push_constant_range = vk_push_constant_range;
       return layout;
     }
   );
@@ -6,6 +6,7 @@
 // project headers --------------------------------------
 #include "resource_pool/resource_generational_pool.h"
 #include "shader/reflection.h"
+#include "sync/resource_sync.h"
 
 #include "pipeline/pipeline_layout_cache.h"
 
@@ -15,6 +16,8 @@
 
 namespace mnexus_backend::vulkan {
 
+class BindlessTable;
+
 //
 // ShaderModule
 //
@@ -46,8 +49,11 @@ resource_pool::ResourceHandle EmplaceShaderModuleResourcePool(
 struct ProgramHot final {
   VkPipelineLayout vk_pipeline_layout = VK_NULL_HANDLE; // Non-owning; kept alive by the cache.
   VulkanPipelineLayoutPtr pipeline_layout_ref;           // Shared ownership with the cache.
+  /// Uses of this program alone; the pipeline layout's stamp is shared by every program with the same layout.
+  ResourceSyncStamp sync_stamp;
 
   void Stamp(uint32_t queue_compact_index, uint64_t serial) {
+    this->sync_stamp.Stamp(queue_compact_index, serial);
     this->pipeline_layout_ref->sync_stamp().Stamp(queue_compact_index, serial);
   }
 };
@@ -63,7 +69,8 @@ resource_pool::ResourceHandle EmplaceProgramResourcePool(
   IVulkanDevice const& device,
   mnexus::ProgramDesc const& program_desc,
   ShaderModuleResourcePool const& shader_module_pool,
-  pipeline::TPipelineLayoutCache<VulkanPipelineLayoutPtr>& pipeline_layout_cache
+  pipeline::TPipelineLayoutCache<VulkanPipelineLayoutPtr>& pipeline_layout_cache,
+  BindlessTable const* bindless_table
 );
 
 } // namespace mnexus_backend::vulkan
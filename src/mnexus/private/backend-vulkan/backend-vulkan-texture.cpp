@@ -2,7 +2,10 @@
 #include "backend-vulkan/backend-vulkan-texture.h"
 
 // c++ headers ------------------------------------------
+#include <algorithm>
+#include <memory>
 #include <optional>
+#include <vector>
 
 // public project headers -------------------------------
 #include "mbase/public/log.h"
@@ -10,9 +13,12 @@
 // project headers --------------------------------------
 #include "backend-vulkan/command/image_layout_tracker.h"
 #include "backend-vulkan/resource/types_bridge.h"
+#include "backend-vulkan/device/vk-physical_device.h"
 #include "backend-vulkan/device/vk-staging.h"
 #include "backend-vulkan/wsi/vk-wsi_surface.h"
 
+#include "profiling/memory_tracker.h"
+
 namespace mnexus_backend::vulkan {
 
 // ====================================================================================================
@@ -76,6 +82,20 @@ mnexus::TextureDesc const& TextureCold::GetTextureDesc() const {
   );
 }
 
+uint64_t TextureCold::GetTrackedSizeInBytes() const {
+  if (auto const* regular = std::get_if<TextureColdRegular>(&content_)) {
+    return regular->tracked_size_in_bytes;
+  }
+  return 0;
+}
+
+VkFormatFeatureFlags TextureCold::GetFormatFeatures() const {
+  if (auto const* regular = std::get_if<TextureColdRegular>(&content_)) {
+    return regular->format_features;
+  }
+  return 0;
+}
+
 void TextureCold::GetDefaultState(VkImageLayout& out_layout) const {
   struct Visitor {
     VkImageLayout* out_layout;
@@ -95,15 +115,13 @@ void TextureCold::GetDefaultState(VkImageLayout& out_layout) const {
 
 namespace {
 
-struct CreateVulkanImageResult {
-  VulkanImage vk_image;
-  VmaAllocation vma_allocation = VK_NULL_HANDLE;
-};
+VkFormatFeatureFlags QueryOptimalTilingFeatures(IVulkanDevice const& vk_device, mnexus::Format format) {
+  VkFormatProperties format_properties {};
+  vkGetPhysicalDeviceFormatProperties(vk_device.physical_device_desc().handle(), ToVkFormat(format), &format_properties);
+  return format_properties.optimalTilingFeatures;
+}
 
-std::optional<CreateVulkanImageResult> CreateVulkanImage(
-  IVulkanDevice& vk_device,
-  mnexus::TextureDesc const& texture_desc
-) {
+VkImageCreateInfo MakeVkImageCreateInfo(IVulkanDevice const& vk_device, mnexus::TextureDesc const& texture_desc) {
   VkFormat const vk_format = ToVkFormat(texture_desc.format);
 
   VkImageType const vk_image_type = ToVkImageType(texture_desc.dimension);
@@ -134,6 +152,77 @@ std::optional<CreateVulkanImageResult> CreateVulkanImage(
     .pQueueFamilyIndices = nullptr,
     .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
   };
+  SetQueueFamilySharing(
+    vk_device, create_info, texture_desc.usage.HasAnyOf(mnexus::TextureUsageFlagBits::kConcurrentQueueFamilies)
+  );
+  return create_info;
+}
+
+/// Barrier from UNDEFINED to the default layout for the image's usage.
+VkImageMemoryBarrier2KHR MakeInitialLayoutBarrier(VkImage vk_image_handle, VkImageCreateInfo const& create_info) {
+  VkImageLayout const default_layout = ImageLayoutTracker::GetDefaultLayout(create_info.usage, create_info.format);
+  SyncScope const default_scope = ImageLayoutTracker::GetDefaultSyncScope(create_info.usage, create_info.format);
+  VkImageAspectFlags const aspect_mask = ImageLayoutTracker::GetAspectMaskFromFormat(create_info.format);
+
+  return VkImageMemoryBarrier2KHR {
+    .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR,
+    .pNext = nullptr,
+    .srcStageMask = VK_PIPELINE_STAGE_2_NONE_KHR,
+    .srcAccessMask = VK_ACCESS_2_NONE_KHR,
+    .dstStageMask = default_scope.stage_mask,
+    .dstAccessMask = default_scope.access_mask,
+    .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    .newLayout = default_layout,
+    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    .image = vk_image_handle,
+    .subresourceRange = {
+      .aspectMask = aspect_mask,
+      .baseMipLevel = 0,
+      .levelCount = create_info.mipLevels,
+      .baseArrayLayer = 0,
+      .layerCount = create_info.arrayLayers,
+    },
+  };
+}
+
+// Transitions new images to their default layouts.
+// This must happen before any command list uses the images, because the
+// ImageLayoutTracker assumes images start in their default layout.
+void SubmitInitialLayoutBarriers(IVulkanDevice& vk_device, std::span<VkImageMemoryBarrier2KHR const> barriers) {
+  mnexus::QueueId const queue_id = vk_device.queue_selection().present_capable;
+  VkCommandBuffer cb = vk_device.transient_command_pool(queue_id).Acquire();
+
+  VkDependencyInfoKHR dep {
+    .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR,
+    .pNext = nullptr,
+    .dependencyFlags = 0,
+    .memoryBarrierCount = 0,
+    .pMemoryBarriers = nullptr,
+    .bufferMemoryBarrierCount = 0,
+    .pBufferMemoryBarriers = nullptr,
+    .imageMemoryBarrierCount = static_cast<uint32_t>(barriers.size()),
+    .pImageMemoryBarriers = barriers.data(),
+  };
+
+  vkCmdPipelineBarrier2KHR(cb, &dep);
+  vkEndCommandBuffer(cb);
+
+  uint64_t const serial = vk_device.QueueSubmitSingle(queue_id, cb);
+  vk_device.transient_command_pool(queue_id).Release(cb, queue_id, serial);
+
+  // FIXME: Blocking wait. Replace with cross-queue timeline semaphore waits
+  // (SubmitWaitAnotherQueueSubmissionId) to avoid stalling the CPU.
+  vk_device.QueueWaitSubmitSerial(queue_id, serial);
+}
+
+} // namespace
+
+std::optional<VulkanImage> CreateVulkanImage(
+  IVulkanDevice& vk_device,
+  mnexus::TextureDesc const& texture_desc
+) {
+  VkImageCreateInfo const create_info = MakeVkImageCreateInfo(vk_device, texture_desc);
 
   VmaAllocator const vma_allocator = vk_device.vma_allocator();
 
@@ -161,78 +250,38 @@ std::optional<CreateVulkanImageResult> CreateVulkanImage(
     return std::nullopt;
   }
 
-  VkDevice vk_device_handle = vk_device.handle();
   VulkanImage vk_image(
     vk_image_handle,
-    [vk_device_handle, vk_image_handle, allocation, vma_allocator] {
-      vmaDestroyImage(vma_allocator, vk_image_handle, allocation);
-    },
+    VulkanObjectDestroyInfo { .type = VulkanObjectType::kVmaImage, .context = allocation },
     vk_device.GetDeferredDestroyer(),
     create_info.usage,
     create_info.format
   );
 
-  // Transition from UNDEFINED to the default layout for this image's usage.
-  // This must happen before any command list uses the image, because the
-  // ImageLayoutTracker assumes images start in their default layout.
-  {
-    VkImageLayout const default_layout = ImageLayoutTracker::GetDefaultLayout(create_info.usage, vk_format);
-    SyncScope const default_scope = ImageLayoutTracker::GetDefaultSyncScope(create_info.usage, vk_format);
-    VkImageAspectFlags const aspect_mask = ImageLayoutTracker::GetAspectMaskFromFormat(vk_format);
-
-    VkCommandBuffer cb = vk_device.transient_command_pool().Acquire();
-
-    VkImageMemoryBarrier2KHR barrier {
-      .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR,
-      .pNext = nullptr,
-      .srcStageMask = VK_PIPELINE_STAGE_2_NONE_KHR,
-      .srcAccessMask = VK_ACCESS_2_NONE_KHR,
-      .dstStageMask = default_scope.stage_mask,
-      .dstAccessMask = default_scope.access_mask,
-      .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-      .newLayout = default_layout,
-      .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-      .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-      .image = vk_image_handle,
-      .subresourceRange = {
-        .aspectMask = aspect_mask,
-        .baseMipLevel = 0,
-        .levelCount = texture_desc.mip_level_count,
-        .baseArrayLayer = 0,
-        .layerCount = texture_desc.array_layer_count,
-      },
-    };
-
-    VkDependencyInfoKHR dep {
-      .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR,
-      .pNext = nullptr,
-      .dependencyFlags = 0,
-      .memoryBarrierCount = 0,
-      .pMemoryBarriers = nullptr,
-      .bufferMemoryBarrierCount = 0,
-      .pBufferMemoryBarriers = nullptr,
-      .imageMemoryBarrierCount = 1,
-      .pImageMemoryBarriers = &barrier,
-    };
-
-    vkCmdPipelineBarrier2KHR(cb, &dep);
-    vkEndCommandBuffer(cb);
-
-    mnexus::QueueId const queue_id = vk_device.queue_selection().present_capable;
-    uint64_t const serial = vk_device.QueueSubmitSingle(queue_id, cb);
-    vk_device.transient_command_pool().Release(cb, queue_id, serial);
-
-    // FIXME: Blocking wait. Replace with cross-queue timeline semaphore waits
-    // (SubmitWaitAnotherQueueSubmissionId) to avoid stalling the CPU.
-    vk_device.QueueWaitSubmitSerial(queue_id, serial);
-  }
+  VkImageMemoryBarrier2KHR const barrier = MakeInitialLayoutBarrier(vk_image_handle, create_info);
+  SubmitInitialLayoutBarriers(vk_device, std::span(&barrier, 1));
 
-  return CreateVulkanImageResult {
-    .vk_image = std::move(vk_image),
-    .vma_allocation = allocation,
-  };
+  return vk_image;
 }
 
+namespace {
+
+// Memory shared by the images of one `EmplaceAliasedTextureResourcePool` call. Each image holds a reference through
+// its destroy info, so the memory is freed after the last image has been destroyed.
+struct AliasedImageMemory final {
+  VmaAllocator vma_allocator = VK_NULL_HANDLE;
+  VmaAllocation vma_allocation = VK_NULL_HANDLE;
+
+  AliasedImageMemory(VmaAllocator allocator, VmaAllocation allocation) :
+    vma_allocator(allocator),
+    vma_allocation(allocation)
+  {}
+  ~AliasedImageMemory() {
+    vmaFreeMemory(vma_allocator, vma_allocation);
+  }
+  MBASE_DISALLOW_COPY_MOVE(AliasedImageMemory);
+};
+
 } // namespace
 
 resource_pool::ResourceHandle EmplaceTextureResourcePool(
@@ -240,22 +289,17 @@ resource_pool::ResourceHandle EmplaceTextureResourcePool(
   IVulkanDevice& vk_device,
   mnexus::TextureDesc const& texture_desc
 ) {
-  std::optional<CreateVulkanImageResult> opt_result = CreateVulkanImage(vk_device, texture_desc);
-  if (!opt_result.has_value()) {
+  std::optional<VulkanImage> opt_vk_image = CreateVulkanImage(vk_device, texture_desc);
+  if (!opt_vk_image.has_value()) {
     return resource_pool::ResourceHandle::Null();
   }
 
-  CreateVulkanImageResult result = std::move(opt_result.value());
-
-  VkImageUsageFlags const vk_usage_flags = result.vk_image.vk_usage_flags();
-  VkFormat const vk_format = result.vk_image.vk_format();
-
-  VkImageLayout const default_layout = ImageLayoutTracker::GetDefaultLayout(vk_usage_flags, vk_format);
-  SyncScope const default_scope = ImageLayoutTracker::GetDefaultSyncScope(vk_usage_flags, vk_format);
-  VkImageAspectFlags const aspect_mask = ImageLayoutTracker::GetAspectMaskFromFormat(vk_format);
-
-  TextureHot hot(TextureHotRegular{ .vk_image = std::move(result.vk_image) });
-  TextureCold cold(TextureColdRegular{ .desc = texture_desc });
+  TextureHot hot(TextureHotRegular{ .vk_image = std::move(opt_vk_image.value()) });
+  TextureCold cold(TextureColdRegular{
+    .desc = texture_desc,
+    .tracked_size_in_bytes = profiling::EstimateTextureSizeInBytes(texture_desc),
+    .format_features = QueryOptimalTilingFeatures(vk_device, texture_desc.format),
+  });
 
   return out_pool.Emplace(
     std::forward_as_tuple(std::move(hot)),
@@ -263,6 +307,126 @@ resource_pool::ResourceHandle EmplaceTextureResourcePool(
   );
 }
 
+bool EmplaceAliasedTextureResourcePool(
+  TextureResourcePool& out_pool,
+  IVulkanDevice& vk_device,
+  std::span<mnexus::TextureDesc const> texture_descs,
+  std::span<resource_pool::ResourceHandle> out_handles
+) {
+  MBASE_ASSERT(texture_descs.size() == out_handles.size());
+  if (texture_descs.empty()) {
+    return true;
+  }
+
+  VkDevice const vk_device_handle = vk_device.handle();
+  VmaAllocator const vma_allocator = vk_device.vma_allocator();
+
+  std::vector<VkImageCreateInfo> create_infos;
+  std::vector<VkImage> vk_image_handles;
+  create_infos.reserve(texture_descs.size());
+  vk_image_handles.reserve(texture_descs.size());
+
+  auto destroy_images = [&] {
+    for (VkImage vk_image_handle : vk_image_handles) {
+      vkDestroyImage(vk_device_handle, vk_image_handle, nullptr);
+    }
+  };
+
+  // The shared allocation must satisfy every image: the largest size and alignment, and a memory type all accept.
+  VkMemoryRequirements combined_requirements {
+    .size = 0,
+    .alignment = 1,
+    .memoryTypeBits = ~0u,
+  };
+  uint64_t estimated_size_in_bytes = 0;
+
+  for (mnexus::TextureDesc const& texture_desc : texture_descs) {
+    VkImageCreateInfo const& create_info = create_infos.emplace_back(MakeVkImageCreateInfo(vk_device, texture_desc));
+
+    VkImage vk_image_handle = VK_NULL_HANDLE;
+    VkResult const result = vkCreateImage(vk_device_handle, &create_info, nullptr, &vk_image_handle);
+    if (result != VK_SUCCESS) {
+      MBASE_LOG_ERROR("vkCreateImage failed: {}", string_VkResult(result));
+      destroy_images();
+      return false;
+    }
+    vk_image_handles.push_back(vk_image_handle);
+
+    VkMemoryRequirements requirements {};
+    vkGetImageMemoryRequirements(vk_device_handle, vk_image_handle, &requirements);
+    combined_requirements.size = std::max(combined_requirements.size, requirements.size);
+    combined_requirements.alignment = std::max(combined_requirements.alignment, requirements.alignment);
+    combined_requirements.memoryTypeBits &= requirements.memoryTypeBits;
+
+    estimated_size_in_bytes = std::max(estimated_size_in_bytes, profiling::EstimateTextureSizeInBytes(texture_desc));
+  }
+
+  if (combined_requirements.memoryTypeBits == 0) {
+    destroy_images();
+    return false;
+  }
+
+  VmaAllocationCreateInfo const alloc_info {
+    .flags = 0,
+    .usage = VMA_MEMORY_USAGE_UNKNOWN,
+    .requiredFlags = 0,
+    .preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    .memoryTypeBits = combined_requirements.memoryTypeBits,
+    .pool = VK_NULL_HANDLE,
+    .pUserData = nullptr,
+    .priority = 0.0f,
+  };
+
+  VmaAllocation allocation = VK_NULL_HANDLE;
+  VkResult const alloc_result = vmaAllocateMemory(vma_allocator, &combined_requirements, &alloc_info, &allocation, nullptr);
+  if (alloc_result != VK_SUCCESS) {
+    MBASE_LOG_ERROR("vmaAllocateMemory failed: {}", string_VkResult(alloc_result));
+    destroy_images();
+    return false;
+  }
+  auto const memory = std::make_shared<AliasedImageMemory>(vma_allocator, allocation);
+
+  std::vector<VkImageMemoryBarrier2KHR> barriers;
+  barriers.reserve(vk_image_handles.size());
+
+  for (size_t i = 0; i < vk_image_handles.size(); ++i) {
+    VkResult const bind_result = vmaBindImageMemory(vma_allocator, allocation, vk_image_handles[i]);
+    if (bind_result != VK_SUCCESS) {
+      MBASE_LOG_ERROR("vmaBindImageMemory failed: {}", string_VkResult(bind_result));
+      destroy_images();
+      return false;
+    }
+    barriers.push_back(MakeInitialLayoutBarrier(vk_image_handles[i], create_infos[i]));
+  }
+
+  SubmitInitialLayoutBarriers(vk_device, barriers);
+
+  for (size_t i = 0; i < vk_image_handles.size(); ++i) {
+    VulkanImage vk_image(
+      vk_image_handles[i],
+      VulkanObjectDestroyInfo { .type = VulkanObjectType::kAliasedImage, .keep_alive = memory },
+      vk_device.GetDeferredDestroyer(),
+      create_infos[i].usage,
+      create_infos[i].format
+    );
+
+    TextureHot hot(TextureHotRegular{ .vk_image = std::move(vk_image) });
+    TextureCold cold(TextureColdRegular{
+      .desc = texture_descs[i],
+      // The group is charged once, to its first texture.
+      .tracked_size_in_bytes = i == 0 ? estimated_size_in_bytes : 0,
+      .format_features = QueryOptimalTilingFeatures(vk_device, texture_descs[i].format),
+    });
+
+    out_handles[i] = out_pool.Emplace(
+      std::forward_as_tuple(std::move(hot)),
+      std::forward_as_tuple(std::move(cold))
+    );
+  }
+
+  return true;
+}
+
 resource_pool::ResourceHandle EmplaceTextureResourcePoolSwapchain(
   TextureResourcePool& out_pool,
   WsiSwapchain const* swapchain
@@ -313,12 +477,9 @@ resource_pool::ResourceHandle EmplaceSamplerResourcePool(
     return resource_pool::ResourceHandle::Null();
   }
 
-  VkDevice vk_device_handle = vk_device.handle();
   VulkanSampler vk_sampler(
     vk_sampler_handle,
-    [vk_device_handle, vk_sampler_handle] {
-      vkDestroySampler(vk_device_handle, vk_sampler_handle, nullptr);
-    },
+    VulkanObjectDestroyInfo { .type = VulkanObjectType::kSampler },
     vk_device.GetDeferredDestroyer()
   );
 
@@ -1,6 +1,8 @@
 #pragma once
 
 // c++ headers ------------------------------------------
+#include <optional>
+#include <span>
 #include <variant>
 
 // public project headers -------------------------------
@@ -49,6 +51,11 @@ private:
 
 struct TextureColdRegular final {
   mnexus::TextureDesc desc;
+  /// What the texture adds to `profiling::MemoryTracker`. Textures sharing memory through
+  /// `EmplaceAliasedTextureResourcePool` charge the whole allocation to the first of them.
+  uint64_t tracked_size_in_bytes = 0;
+  /// Optimal-tiling features of the texture's format on the physical device.
+  VkFormatFeatureFlags format_features = 0;
 };
 
 struct TextureColdSwapchain final {
@@ -65,6 +72,10 @@ public:
   MBASE_DISALLOW_COPY_DEFAULT_MOVE(TextureCold);
 
   mnexus::TextureDesc const& GetTextureDesc() const;
+  /// 0 for swapchain textures.
+  uint64_t GetTrackedSizeInBytes() const;
+  /// 0 for swapchain textures.
+  VkFormatFeatureFlags GetFormatFeatures() const;
 
   void GetDefaultState(VkImageLayout&out_layout) const;
 
@@ -74,12 +85,27 @@ private:
 
 using TextureResourcePool = resource_pool::TResourceGenerationalPool<TextureHot, TextureCold, mnexus::kResourceTypeTexture>;
 
+/// Creates an image for `texture_desc` in its own allocation and transitions it to the default layout.
+std::optional<VulkanImage> CreateVulkanImage(
+  IVulkanDevice& vk_device,
+  mnexus::TextureDesc const& texture_desc
+);
+
 resource_pool::ResourceHandle EmplaceTextureResourcePool(
   TextureResourcePool& out_pool,
   IVulkanDevice& vk_device,
   mnexus::TextureDesc const& texture_desc
 );
 
+/// Creates one texture per entry of `texture_descs`, all bound to a single allocation.
+/// Returns false, creating nothing, if the images have no memory type in common or an allocation fails.
+bool EmplaceAliasedTextureResourcePool(
+  TextureResourcePool& out_pool,
+  IVulkanDevice& vk_device,
+  std::span<mnexus::TextureDesc const> texture_descs,
+  std::span<resource_pool::ResourceHandle> out_handles
+);
+
 resource_pool::ResourceHandle EmplaceTextureResourcePoolSwapchain(
   TextureResourcePool& out_pool,
   WsiSwapchain const* swapchain
@@ -2,12 +2,20 @@
 #include "backend-vulkan/backend-vulkan.h"
 
 // c++ headers ------------------------------------------
+#include <atomic>
 #include <cstring>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <numeric>
 #include <vector>
 #include <optional>
+#include <span>
 
 // public project headers -------------------------------
+#include "mbase/public/assert.h"
 #include "mbase/public/log.h"
 #include "mbase/public/trap.h"
 #include "mbase/public/tsa.h"
@@ -21,6 +29,9 @@
 #include "backend-vulkan/backend-vulkan-shader.h"
 #include "backend-vulkan/backend-vulkan-texture.h"
 #include "backend-vulkan/backend-vulkan-compute_pipeline.h"
+#include "backend-vulkan/command/image_layout_tracker.h"
+#include "backend-vulkan/command/pending_pipeline_barrier.h"
+#include "backend-vulkan/descriptor/bindless_table.h"
 #include "backend-vulkan/descriptor/descriptor_set_allocator.h"
 
 #include "backend-vulkan/device/vk-device.h"
@@ -31,15 +42,88 @@
 #include "backend-vulkan/device/thread_command_pool.h"
 #include "backend-vulkan/depend/vulkan_vma.h"
 #include "backend-vulkan/resource/resource_storage.h"
+#include "backend-vulkan/resource/types_bridge.h"
+
+#include "profiling/gpu_timing.h"
+#include "profiling/memory_tracker.h"
+#include "profiling/perf_counters.h"
+
+#include "sync/queue_completion.h"
+#include "sync/resource_sync.h"
 
 namespace mnexus_backend::vulkan {
 
+namespace {
+
+/// Timestamp query slots per instrumented command list (two per timed debug group).
+constexpr uint32_t kGpuTimingQueryCapacity = 256;
+
+/// Block layout of a `TextureWriteRegion`: the source pitches with the tightly packed defaults resolved, and the
+/// tightly packed size it occupies in staging memory.
+struct TextureWriteLayout final {
+  uint32_t row_size;
+  uint32_t block_rows;
+  uint32_t image_count;
+  uint32_t src_row_pitch;
+  uint32_t src_rows_per_image;
+
+  [[nodiscard]] uint64_t GetPackedSize() const {
+    return uint64_t { row_size } * block_rows * image_count;
+  }
+};
+
+TextureWriteLayout ComputeTextureWriteLayout(mnexus::Format format, mnexus::TextureWriteRegion const& region) {
+  uint32_t const format_size = MnGetFormatSizeInBytes(static_cast<MnFormat>(format));
+  MnExtent3d const block_extent = MnGetFormatTexelBlockExtent(static_cast<MnFormat>(format));
+
+  TextureWriteLayout layout {
+    .row_size = (region.extent.width + block_extent.width - 1) / block_extent.width * format_size,
+    .block_rows = (region.extent.height + block_extent.height - 1) / block_extent.height,
+    .image_count = region.extent.depth * region.subresource_range.array_layer_count,
+    .src_row_pitch = 0,
+    .src_rows_per_image = 0,
+  };
+  layout.src_row_pitch = region.row_pitch != 0 ? region.row_pitch : layout.row_size;
+  layout.src_rows_per_image = region.rows_per_image != 0 ? region.rows_per_image : layout.block_rows;
+
+  MBASE_ASSERT_MSG(layout.src_row_pitch >= layout.row_size, "row_pitch is smaller than a row of the region");
+  MBASE_ASSERT_MSG(layout.src_rows_per_image >= layout.block_rows, "rows_per_image is smaller than the region's height");
+  return layout;
+}
+
+VkQueueFlags GetQueueFamilyFlags(IVulkanDevice const& vk_device, uint32_t queue_family_index) {
+  return vk_device.physical_device_desc().queue_families()[queue_family_index].properties.queueFlags;
+}
+
+mnexus::QueueFamilyCapabilityFlags ToQueueFamilyCapabilities(VkQueueFlags queue_flags) {
+  mnexus::QueueFamilyCapabilityFlags capabilities = mnexus::QueueFamilyCapabilityFlagBits::kNone;
+  if ((queue_flags & VK_QUEUE_GRAPHICS_BIT) != 0) {
+    capabilities |= mnexus::QueueFamilyCapabilityFlagBits::kGraphics;
+  }
+  if ((queue_flags & VK_QUEUE_COMPUTE_BIT) != 0) {
+    capabilities |= mnexus::QueueFamilyCapabilityFlagBits::kCompute;
+  }
+  // Graphics and compute queues support transfer commands whether or not they report VK_QUEUE_TRANSFER_BIT.
+  if ((queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT)) != 0) {
+    capabilities |= mnexus::QueueFamilyCapabilityFlagBits::kTransfer;
+  }
+  if ((queue_flags & VK_QUEUE_VIDEO_DECODE_BIT_KHR) != 0) {
+    capabilities |= mnexus::QueueFamilyCapabilityFlagBits::kVideoDecode;
+  }
+  if ((queue_flags & VK_QUEUE_VIDEO_ENCODE_BIT_KHR) != 0) {
+    capabilities |= mnexus::QueueFamilyCapabilityFlagBits::kVideoEncode;
+  }
+  return capabilities;
+}
+
+} // namespace
+
 
 // ==================================================================================================
 // MnexusDeviceVulkan
 //
 
-class MnexusDeviceVulkan final : public mnexus::IDevice {
+class MnexusDeviceVulkan final : public mnexus::IDevice, private IQueueCompletionSource {
 public:
   explicit MnexusDeviceVulkan(IVulkanDevice* vk_device, ResourceStorage* resource_storage) :
     vk_device_(vk_device),
@@ -49,12 +133,30 @@ public:
     resource_storage_->swapchain_texture_handle = EmplaceTextureResourcePoolSwapchain(resource_storage_->textures, &wsi_swapchain_);
 
     descriptor_set_allocator_ = IDescriptorSetAllocator::Create(vk_device);
+    if (vk_device_->IsExtensionEnabled(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+      bindless_table_ = BindlessTable::Create(*vk_device_);
+    }
+
+    vk_device_->completion_notifier().Initialize(this, vk_device_->queue_index_map().Count());
   }
   ~MnexusDeviceVulkan() override {
+    // Normally already done by `IVulkanDevice::Shutdown`; the completion thread calls into this object.
+    vk_device_->completion_notifier().Shutdown();
+
+    {
+      mbase::LockGuard lock(pending_gpu_timings_mutex_);
+      for (PendingGpuTiming const& pending : pending_gpu_timings_) {
+        vkDestroyQueryPool(vk_device_->handle(), pending.query_pool, nullptr);
+      }
+      pending_gpu_timings_.clear();
+      pending_gpu_timing_count_.store(0, std::memory_order_relaxed);
+    }
+
     if (descriptor_set_allocator_ != nullptr) {
       descriptor_set_allocator_->Shutdown(); // Shutdown does delete this.
       descriptor_set_allocator_ = nullptr;
     }
+    bindless_table_.reset();
   }
 
   // ----------------------------------------------------------------------------------------------
@@ -62,16 +164,31 @@ public:
   //
 
   IMPL_VAPI(uint32_t, QueueGetFamilyCount) {
-    STUB_NOT_IMPLEMENTED();
-    return 1;
+    return static_cast<uint32_t>(vk_device_->physical_device_desc().queue_families().size());
   }
 
   IMPL_VAPI(MnBool32, QueueGetFamilyDesc,
-    uint32_t /*queue_family_index*/,
-    mnexus::QueueFamilyDesc& /*out_desc*/
+    uint32_t queue_family_index,
+    mnexus::QueueFamilyDesc& out_desc
   ) {
-    STUB_NOT_IMPLEMENTED();
-    return MnBoolFalse;
+    if (queue_family_index >= vk_device_->physical_device_desc().queue_families().size()) {
+      return MnBoolFalse;
+    }
+
+    // Only the queues the device created are usable, so report those rather than the family's full count.
+    QueueIndexMap const& queue_index_map = vk_device_->queue_index_map();
+    uint32_t queue_count = 0;
+    for (uint32_t i = 0; i < queue_index_map.Count(); ++i) {
+      if (queue_index_map.GetQueueId(i).queue_family_index == queue_family_index) {
+        ++queue_count;
+      }
+    }
+
+    out_desc = mnexus::QueueFamilyDesc {
+      .queue_count = queue_count,
+      .capabilities = ToQueueFamilyCapabilities(GetQueueFamilyFlags(*vk_device_, queue_family_index)),
+    };
+    return MnBoolTrue;
   }
 
   IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueSubmitCommandList,
@@ -79,17 +196,40 @@ public:
     mnexus::ICommandList* command_list
   ) {
     auto* cmd_list_vk = static_cast<MnexusCommandListVulkan*>(command_list);
-    VkCommandBuffer vk_cb_handle = cmd_list_vk->encoder().command_buffer();
+    ThreadCommandBuffer const& command_buffer = cmd_list_vk->thread_command_buffer();
+    MBASE_ASSERT_MSG(queue_id.queue_family_index == command_buffer.queue_family_index,
+      "Command list was created for queue family {} but submitted to queue family {}",
+      command_buffer.queue_family_index, queue_id.queue_family_index);
 
-    uint64_t const serial = vk_device_->QueueSubmitSingle(queue_id, vk_cb_handle);
-    vk_device_->thread_command_pool_registry().FreeCommandBuffer(vk_cb_handle, queue_id, serial);
+    uint64_t const serial = vk_device_->QueueSubmitSingle(queue_id, command_buffer.vk_command_buffer);
+    vk_device_->thread_command_pool_registry().FreeCommandBuffer(command_buffer, queue_id, serial);
+    perf_counters_.Add(profiling::PerfCounter::kSubmits);
+    perf_counters_.Accumulate(cmd_list_vk->perf_counters());
 
     uint32_t const queue_compact_index = *vk_device_->queue_index_map().Find(queue_id);
 
     mbase::ArrayProxy<resource_pool::ResourceHandle const> referenced = cmd_list_vk->GetReferencedResources();
     for (resource_pool::ResourceHandle const& handle : referenced) {
       resource_storage_->StampResourceUse(handle, queue_compact_index, serial);
+      resource_storage_->ReleaseListReference(handle);
     }
+    this->ProcessRetiringPrograms();
+
+    if (cmd_list_vk->gpu_timing_query_pool() != VK_NULL_HANDLE) {
+      // The query pool is referenced by the submission; it is destroyed once the results have been read back.
+      mbase::LockGuard lock(pending_gpu_timings_mutex_);
+      pending_gpu_timings_.emplace_back(
+        PendingGpuTiming {
+          .queue_id = queue_id,
+          .serial = serial,
+          .recorder = cmd_list_vk->TakeGpuTimingRecorder(),
+          .query_pool = cmd_list_vk->gpu_timing_query_pool(),
+        }
+      );
+      pending_gpu_timing_count_.fetch_add(1, std::memory_order_release);
+    }
+    // Resolve earlier submissions here too, so that their query pools are released even if no report is requested.
+    this->ProcessPendingGpuTimings();
 
     delete cmd_list_vk;
     return mnexus::IntraQueueSubmissionId { serial };
@@ -108,7 +248,8 @@ public:
     if (hot.mapped_data != nullptr) {
       // Mappable buffer: direct memcpy + flush.
       std::memcpy(static_cast<uint8_t*>(hot.mapped_data) + buffer_offset, data, data_size_in_bytes);
-      vmaFlushAllocation(hot.vma_allocator, hot.vma_allocation, buffer_offset, data_size_in_bytes);
+      vmaFlushAllocation(hot.vma_allocator, hot.vma_allocation, hot.base_offset + buffer_offset, data_size_in_bytes);
+      perf_counters_.Add(profiling::PerfCounter::kStagingBytesUploaded, data_size_in_bytes);
 
       // No actual queue submit needed; data is visible after flush.
       // Advance timeline to satisfy the API contract.
@@ -125,11 +266,12 @@ public:
 
     std::memcpy(staging->mapped_data, data, data_size_in_bytes);
     vmaFlushAllocation(vk_device_->vma_allocator(), staging->allocation, 0, data_size_in_bytes);
+    perf_counters_.Add(profiling::PerfCounter::kStagingBytesUploaded, data_size_in_bytes);
 
-    VkCommandBuffer vk_cb_handle = vk_device_->transient_command_pool().Acquire();
+    VkCommandBuffer vk_cb_handle = vk_device_->transient_command_pool(queue_id).Acquire();
     VkBufferCopy region {
       .srcOffset = 0,
-      .dstOffset = buffer_offset,
+      .dstOffset = hot.base_offset + buffer_offset,
       .size = data_size_in_bytes,
     };
     vkCmdCopyBuffer(vk_cb_handle, staging->vk_buffer, hot.vk_buffer.handle(), 1, &region);
@@ -140,7 +282,140 @@ public:
     uint32_t const queue_compact_index = *vk_device_->queue_index_map().Find(queue_id);
     hot.vk_buffer.sync_stamp().Stamp(queue_compact_index, serial);
 
-    vk_device_->transient_command_pool().Release(vk_cb_handle, queue_id, serial);
+    vk_device_->transient_command_pool(queue_id).Release(vk_cb_handle, queue_id, serial);
+    vk_device_->staging_buffer_pool().Release(staging, queue_id, serial);
+
+    return mnexus::IntraQueueSubmissionId { serial };
+  }
+
+  IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueWriteTexture,
+    mnexus::QueueId const& queue_id,
+    mnexus::TextureHandle texture_handle,
+    mnexus::container::ArrayProxy<mnexus::TextureWriteRegion const> regions
+  ) {
+    MBASE_ASSERT_MSG(!regions.empty(), "QueueWriteTexture requires at least one region");
+
+    auto const pool_handle = resource_pool::ResourceHandle::FromU64(texture_handle.Get());
+    auto [hot, cold, lock] = resource_storage_->textures.GetRefWithSharedLockGuard(pool_handle);
+
+    mnexus::TextureDesc const& desc = cold.GetTextureDesc();
+    uint32_t const format_size = MnGetFormatSizeInBytes(static_cast<MnFormat>(desc.format));
+
+    // All regions share one staging buffer. `bufferOffset` must be a multiple of the texel block size and of 4.
+    uint64_t const offset_alignment = std::lcm(uint64_t { format_size }, uint64_t { 4 });
+    std::vector<TextureWriteLayout> layouts;
+    std::vector<uint64_t> staging_offsets;
+    layouts.reserve(regions.size());
+    staging_offsets.reserve(regions.size());
+
+    uint64_t staging_size = 0;
+    for (mnexus::TextureWriteRegion const& region : regions) {
+      MBASE_ASSERT_MSG(region.subresource_range.mip_level_count == 1, "A TextureWriteRegion covers a single mip level");
+
+      layouts.push_back(ComputeTextureWriteLayout(desc.format, region));
+      staging_size = (staging_size + offset_alignment - 1) / offset_alignment * offset_alignment;
+      staging_offsets.push_back(staging_size);
+      staging_size += layouts.back().GetPackedSize();
+    }
+
+    StagingBuffer* staging = vk_device_->staging_buffer_pool().Acquire(staging_size);
+    if (staging == nullptr) {
+      MBASE_LOG_ERROR("Failed to acquire staging buffer for QueueWriteTexture");
+      return mnexus::IntraQueueSubmissionId { 0 };
+    }
+
+    // The only CPU copy: source rows are packed tightly, so the copies below need no row length.
+    for (uint32_t i = 0; i < regions.size(); ++i) {
+      TextureWriteLayout const& layout = layouts[i];
+      auto const* src = static_cast<uint8_t const*>(regions[i].data);
+      auto* dst = static_cast<uint8_t*>(staging->mapped_data) + staging_offsets[i];
+
+      if (layout.src_row_pitch == layout.row_size && layout.src_rows_per_image == layout.block_rows) {
+        std::memcpy(dst, src, layout.GetPackedSize());
+        continue;
+      }
+      for (uint32_t image = 0; image < layout.image_count; ++image) {
+        uint8_t const* src_row = src + uint64_t { image } * layout.src_rows_per_image * layout.src_row_pitch;
+        for (uint32_t row = 0; row < layout.block_rows; ++row) {
+          std::memcpy(dst, src_row, layout.row_size);
+          src_row += layout.src_row_pitch;
+          dst += layout.row_size;
+        }
+      }
+    }
+    vmaFlushAllocation(vk_device_->vma_allocator(), staging->allocation, 0, staging_size);
+    perf_counters_.Add(profiling::PerfCounter::kStagingBytesUploaded, staging_size);
+
+    VkImage const vk_image = hot.GetVkImage().handle();
+    VkFormat const vk_format = ToVkFormat(desc.format);
+
+    // Same local layout tracking as `QueueReadTexture`.
+    ImageLayoutTracker image_layout_tracker;
+    PendingPipelineBarrier pending_pipeline_barrier(GetQueueFamilyFlags(*vk_device_, queue_id.queue_family_index));
+    image_layout_tracker.RegisterImage(
+      vk_image,
+      ToVkImageUsageFlags(desc.usage, vk_format),
+      vk_format,
+      desc.mip_level_count,
+      desc.array_layer_count
+    );
+
+    std::vector<VkBufferImageCopy> copy_regions;
+    copy_regions.reserve(regions.size());
+    for (uint32_t i = 0; i < regions.size(); ++i) {
+      mnexus::TextureWriteRegion const& region = regions[i];
+      for (uint32_t layer = region.subresource_range.base_array_layer;
+           layer < region.subresource_range.base_array_layer + region.subresource_range.array_layer_count;
+           ++layer) {
+        image_layout_tracker.TransitionToTransferDst(
+          vk_image,
+          { .mip_level = region.subresource_range.base_mip_level, .array_layer = layer }
+        );
+      }
+
+      copy_regions.push_back(
+        VkBufferImageCopy {
+          .bufferOffset = staging_offsets[i],
+          .bufferRowLength = 0,
+          .bufferImageHeight = 0,
+          .imageSubresource = ToVkImageSubresourceLayers(region.subresource_range),
+          .imageOffset = {
+            static_cast<int32_t>(region.origin.x),
+            static_cast<int32_t>(region.origin.y),
+            static_cast<int32_t>(region.origin.z),
+          },
+          .imageExtent = VkExtent3D { region.extent.width, region.extent.height, region.extent.depth },
+        }
+      );
+    }
+
+    VkCommandBuffer vk_cb_handle = vk_device_->transient_command_pool(queue_id).Acquire();
+
+    image_layout_tracker.FlushPendingTransitions(pending_pipeline_barrier);
+    uint32_t barrier_count = pending_pipeline_barrier.FlushAndClear(vk_cb_handle);
+
+    vkCmdCopyBufferToImage(
+      vk_cb_handle,
+      staging->vk_buffer,
+      vk_image,
+      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      static_cast<uint32_t>(copy_regions.size()),
+      copy_regions.data()
+    );
+
+    image_layout_tracker.TransitionAllToDefaults();
+    image_layout_tracker.FlushPendingTransitions(pending_pipeline_barrier);
+    barrier_count += pending_pipeline_barrier.FlushAndClear(vk_cb_handle);
+    perf_counters_.Add(profiling::PerfCounter::kBarriersEmitted, barrier_count);
+
+    vkEndCommandBuffer(vk_cb_handle);
+
+    uint64_t const serial = vk_device_->QueueSubmitSingle(queue_id, vk_cb_handle);
+
+    uint32_t const queue_compact_index = *vk_device_->queue_index_map().Find(queue_id);
+    hot.Stamp(queue_compact_index, serial);
+
+    vk_device_->transient_command_pool(queue_id).Release(vk_cb_handle, queue_id, serial);
     vk_device_->staging_buffer_pool().Release(staging, queue_id, serial);
 
     return mnexus::IntraQueueSubmissionId { serial };
@@ -158,7 +433,7 @@ public:
 
     if (hot.mapped_data != nullptr) {
       // Mappable buffer: direct read after invalidate.
-      vmaInvalidateAllocation(hot.vma_allocator, hot.vma_allocation, buffer_offset, size_in_bytes);
+      vmaInvalidateAllocation(hot.vma_allocator, hot.vma_allocation, hot.base_offset + buffer_offset, size_in_bytes);
       std::memcpy(dst, static_cast<uint8_t const*>(hot.mapped_data) + buffer_offset, size_in_bytes);
       uint64_t const serial = vk_device_->QueueAdvanceTimeline(queue_id);
       return mnexus::IntraQueueSubmissionId { serial };
@@ -171,9 +446,9 @@ public:
       return mnexus::IntraQueueSubmissionId { 0 };
     }
 
-    VkCommandBuffer vk_cb_handle = vk_device_->transient_command_pool().Acquire();
+    VkCommandBuffer vk_cb_handle = vk_device_->transient_command_pool(queue_id).Acquire();
     VkBufferCopy region {
-      .srcOffset = buffer_offset,
+      .srcOffset = hot.base_offset + buffer_offset,
       .dstOffset = 0,
       .size = size_in_bytes,
     };
@@ -182,7 +457,113 @@ public:
 
     uint64_t const serial = vk_device_->QueueSubmitSingle(queue_id, vk_cb_handle);
 
-    vk_device_->transient_command_pool().Release(vk_cb_handle, queue_id, serial);
+    vk_device_->transient_command_pool(queue_id).Release(vk_cb_handle, queue_id, serial);
+
+    {
+      mbase::LockGuard mtx_lock(pending_readbacks_mutex_);
+
+      pending_readbacks_.emplace_back(
+        PendingReadback {
+          .dst = dst,
+          .size_in_bytes = size_in_bytes,
+          .staging = staging,
+          .queue_id = queue_id,
+          .serial = serial,
+        }
+      );
+    }
+
+    return mnexus::IntraQueueSubmissionId { serial };
+  }
+
+  IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueReadTexture,
+    mnexus::QueueId const& queue_id,
+    mnexus::TextureHandle texture_handle,
+    mnexus::TextureSubresourceRange const& subresource_range,
+    mnexus::Extent3d const& copy_extent,
+    void* dst,
+    uint64_t dst_size_in_bytes
+  ) {
+    auto const pool_handle = resource_pool::ResourceHandle::FromU64(texture_handle.Get());
+    auto [hot, cold, lock] = resource_storage_->textures.GetRefWithSharedLockGuard(pool_handle);
+
+    mnexus::TextureDesc const& desc = cold.GetTextureDesc();
+
+    uint32_t const format_size = MnGetFormatSizeInBytes(static_cast<MnFormat>(desc.format));
+    MnExtent3d const block_extent = MnGetFormatTexelBlockExtent(static_cast<MnFormat>(desc.format));
+    uint32_t const blocks_per_row = (copy_extent.width + block_extent.width - 1) / block_extent.width;
+    uint32_t const block_rows = (copy_extent.height + block_extent.height - 1) / block_extent.height;
+    // Depth slices of a 3D texture or array layers; the other factor is 1.
+    uint32_t const image_count = copy_extent.depth * subresource_range.array_layer_count;
+    uint64_t const size_in_bytes = uint64_t { blocks_per_row } * format_size * block_rows * image_count;
+
+    MBASE_ASSERT_MSG(dst_size_in_bytes >= size_in_bytes, "dst_size_in_bytes is too small for the tightly packed copy");
+
+    StagingBuffer* staging = vk_device_->staging_buffer_pool().Acquire(size_in_bytes);
+    if (staging == nullptr) {
+      MBASE_LOG_ERROR("Failed to acquire staging buffer for QueueReadTexture");
+      return mnexus::IntraQueueSubmissionId { 0 };
+    }
+
+    VkImage const vk_image = hot.GetVkImage().handle();
+    VkFormat const vk_format = ToVkFormat(desc.format);
+
+    // Queue operations record outside any command list, so track layouts locally: the image is in its default
+    // layout between command lists and is returned to it after the copy.
+    ImageLayoutTracker image_layout_tracker;
+    PendingPipelineBarrier pending_pipeline_barrier(GetQueueFamilyFlags(*vk_device_, queue_id.queue_family_index));
+    image_layout_tracker.RegisterImage(
+      vk_image,
+      ToVkImageUsageFlags(desc.usage, vk_format),
+      vk_format,
+      desc.mip_level_count,
+      desc.array_layer_count
+    );
+    for (uint32_t layer = subresource_range.base_array_layer;
+         layer < subresource_range.base_array_layer + subresource_range.array_layer_count;
+         ++layer) {
+      image_layout_tracker.TransitionToTransferSrc(
+        vk_image,
+        { .mip_level = subresource_range.base_mip_level, .array_layer = layer }
+      );
+    }
+
+    VkCommandBuffer vk_cb_handle = vk_device_->transient_command_pool(queue_id).Acquire();
+
+    image_layout_tracker.FlushPendingTransitions(pending_pipeline_barrier);
+    uint32_t barrier_count = pending_pipeline_barrier.FlushAndClear(vk_cb_handle);
+
+    // bufferRowLength = 0 makes the copy write tightly packed rows, so no de-padding is needed.
+    VkBufferImageCopy const region {
+      .bufferOffset = 0,
+      .bufferRowLength = 0,
+      .bufferImageHeight = 0,
+      .imageSubresource = ToVkImageSubresourceLayers(subresource_range),
+      .imageOffset = { 0, 0, 0 },
+      .imageExtent = VkExtent3D { copy_extent.width, copy_extent.height, copy_extent.depth },
+    };
+    vkCmdCopyImageToBuffer(
+      vk_cb_handle,
+      vk_image,
+      VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      staging->vk_buffer,
+      1,
+      &region
+    );
+
+    image_layout_tracker.TransitionAllToDefaults();
+    image_layout_tracker.FlushPendingTransitions(pending_pipeline_barrier);
+    barrier_count += pending_pipeline_barrier.FlushAndClear(vk_cb_handle);
+    perf_counters_.Add(profiling::PerfCounter::kBarriersEmitted, barrier_count);
+
+    vkEndCommandBuffer(vk_cb_handle);
+
+    uint64_t const serial = vk_device_->QueueSubmitSingle(queue_id, vk_cb_handle);
+
+    uint32_t const queue_compact_index = *vk_device_->queue_index_map().Find(queue_id);
+    hot.Stamp(queue_compact_index, serial);
+
+    vk_device_->transient_command_pool(queue_id).Release(vk_cb_handle, queue_id, serial);
 
     {
       mbase::LockGuard mtx_lock(pending_readbacks_mutex_);
@@ -204,7 +585,9 @@ public:
   IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueGetCompletedValue,
     mnexus::QueueId const& queue_id
   ) {
-    return mnexus::IntraQueueSubmissionId { vk_device_->QueueGetCompletedValue(queue_id) };
+    uint64_t const completed = vk_device_->QueueGetCompletedValue(queue_id);
+    this->ProcessPendingGpuTimings();
+    return mnexus::IntraQueueSubmissionId { completed };
   }
 
   IMPL_VAPI(void, QueueWaitIdle,
@@ -213,6 +596,27 @@ public:
   ) {
     vk_device_->QueueWaitSubmitSerial(queue_id, value.Get());
     this->ProcessPendingReadbacks();
+    this->ProcessPendingGpuTimings();
+    this->ProcessRetiringPrograms();
+  }
+
+  IMPL_VAPI(void, QueueOnCompleted,
+    mnexus::QueueId const& queue_id,
+    mnexus::IntraQueueSubmissionId value,
+    MnQueueCompletedCallback callback,
+    void* user_data
+  ) {
+    std::optional<uint32_t> const queue_index = vk_device_->queue_index_map().Find(queue_id);
+    MBASE_ASSERT_MSG(queue_index.has_value(), "Unknown QueueId ({}, {})", queue_id.queue_family_index, queue_id.queue_index);
+    vk_device_->completion_notifier().AddCallback(*queue_index, value.Get(), callback, user_data);
+  }
+
+  IMPL_VAPI(intptr_t, QueueGetCompletionEvent,
+    mnexus::QueueId const& queue_id
+  ) {
+    std::optional<uint32_t> const queue_index = vk_device_->queue_index_map().Find(queue_id);
+    MBASE_ASSERT_MSG(queue_index.has_value(), "Unknown QueueId ({}, {})", queue_id.queue_family_index, queue_id.queue_index);
+    return vk_device_->completion_notifier().GetEvent(*queue_index);
   }
 
   // ----------------------------------------------------------------------------------------------
@@ -220,12 +624,41 @@ public:
   //
 
   IMPL_VAPI(mnexus::ICommandList*, CreateCommandList,
-    mnexus::CommandListDesc const& /*desc*/
+    mnexus::CommandListDesc const& desc
   ) {
-    VkCommandBuffer vk_cb_handle = vk_device_->thread_command_pool_registry().AllocateCommandBuffer();
+    ThreadCommandBuffer const command_buffer =
+      vk_device_->thread_command_pool_registry().AllocateCommandBuffer(desc.queue_family_index);
+
+    std::unique_ptr<profiling::GpuTimingRecorder> gpu_timing_recorder;
+    VkQueryPool gpu_timing_query_pool = VK_NULL_HANDLE;
+    if (gpu_timing_enabled_.load(std::memory_order_relaxed)) {
+      VkQueryPoolCreateInfo const query_pool_info {
+        .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .queryType = VK_QUERY_TYPE_TIMESTAMP,
+        .queryCount = kGpuTimingQueryCapacity,
+        .pipelineStatistics = 0,
+      };
+      VkResult const result = vkCreateQueryPool(vk_device_->handle(), &query_pool_info, nullptr, &gpu_timing_query_pool);
+      if (result == VK_SUCCESS) {
+        gpu_timing_recorder = std::make_unique<profiling::GpuTimingRecorder>(kGpuTimingQueryCapacity);
+      } else {
+        MBASE_LOG_ERROR("Failed to create GPU timing query pool: {}", string_VkResult(result));
+        gpu_timing_query_pool = VK_NULL_HANDLE;
+      }
+    }
+
     return new MnexusCommandListVulkan(
-      CommandEncoder(vk_cb_handle, vk_device_->handle(), descriptor_set_allocator_, resource_storage_),
-      resource_storage_
+      CommandEncoder(
+        command_buffer.vk_command_buffer, vk_device_->handle(), descriptor_set_allocator_, resource_storage_,
+        bindless_table_ != nullptr ? bindless_table_->descriptor_set() : VK_NULL_HANDLE
+      ),
+      command_buffer,
+      GetQueueFamilyFlags(*vk_device_, desc.queue_family_index),
+      resource_storage_,
+      std::move(gpu_timing_recorder),
+      gpu_timing_query_pool
     );
   }
 
@@ -233,8 +666,16 @@ public:
     mnexus::ICommandList* command_list
   ) {
     auto* cmd_list_vk = static_cast<MnexusCommandListVulkan*>(command_list);
-    VkCommandBuffer vk_cb_handle = cmd_list_vk->encoder().command_buffer();
-    vk_device_->thread_command_pool_registry().FreeCommandBuffer(vk_cb_handle, {}, 0);
+    vk_device_->thread_command_pool_registry().FreeCommandBuffer(cmd_list_vk->thread_command_buffer(), {}, 0);
+    perf_counters_.Accumulate(cmd_list_vk->perf_counters());
+    for (resource_pool::ResourceHandle const& handle : cmd_list_vk->GetReferencedResources()) {
+      resource_storage_->ReleaseListReference(handle);
+    }
+    this->ProcessRetiringPrograms();
+    if (cmd_list_vk->gpu_timing_query_pool() != VK_NULL_HANDLE) {
+      // Never submitted; no GPU work references the pool.
+      vkDestroyQueryPool(vk_device_->handle(), cmd_list_vk->gpu_timing_query_pool(), nullptr);
+    }
     delete cmd_list_vk;
   }
 
@@ -248,11 +689,13 @@ public:
     resource_pool::ResourceHandle const pool_handle = EmplaceBufferResourcePool(
       resource_storage_->buffers,
       *vk_device_,
+      resource_storage_->placed_buffer_allocator.get(),
       desc
     );
     if (pool_handle.IsNull()) {
       return mnexus::BufferHandle::Invalid();
     }
+    memory_tracker_.OnCreated(profiling::MemoryResourceType::kBuffer, desc.size_in_bytes);
 
     return mnexus::BufferHandle { pool_handle.AsU64() };
   }
@@ -262,7 +705,15 @@ public:
   ) {
     // FIXME: Should defer destruction until the GPU is done using this buffer.
     auto const pool_handle = resource_pool::ResourceHandle::FromU64(buffer_handle.Get());
+
+    uint64_t size_in_bytes = 0;
+    {
+      auto [cold, lock] = resource_storage_->buffers.GetColdConstRefWithSharedLockGuard(pool_handle);
+      size_in_bytes = cold.desc.size_in_bytes;
+    }
+
     resource_storage_->buffers.Erase(pool_handle);
+    memory_tracker_.OnDestroyed(profiling::MemoryResourceType::kBuffer, size_in_bytes);
   }
 
   IMPL_VAPI(void, GetBufferDesc,
@@ -274,6 +725,49 @@ public:
     out_desc = cold.desc;
   }
 
+  IMPL_VAPI(void*, MapBuffer,
+    mnexus::BufferHandle buffer_handle
+  ) {
+    auto const pool_handle = resource_pool::ResourceHandle::FromU64(buffer_handle.Get());
+    auto [hot, lock] = resource_storage_->buffers.GetHotConstRefWithSharedLockGuard(pool_handle);
+
+    // `kMappable` buffers are persistently mapped at creation.
+    if (hot.mapped_data == nullptr) {
+      MBASE_LOG_ERROR("MapBuffer: buffer was not created with kMappable usage");
+    }
+    return hot.mapped_data;
+  }
+
+  IMPL_VAPI(void, UnmapBuffer,
+    mnexus::BufferHandle /*buffer_handle*/
+  ) {
+    // Nothing to do; the mapping lives as long as the buffer.
+  }
+
+  IMPL_VAPI(void, FlushMappedBufferRange,
+    mnexus::BufferHandle buffer_handle,
+    uint32_t offset,
+    uint32_t size_in_bytes
+  ) {
+    auto const pool_handle = resource_pool::ResourceHandle::FromU64(buffer_handle.Get());
+    auto [hot, lock] = resource_storage_->buffers.GetHotConstRefWithSharedLockGuard(pool_handle);
+    MBASE_ASSERT_MSG(hot.mapped_data != nullptr, "FlushMappedBufferRange requires a kMappable buffer");
+
+    vmaFlushAllocation(hot.vma_allocator, hot.vma_allocation, hot.base_offset + offset, size_in_bytes);
+  }
+
+  IMPL_VAPI(void, InvalidateMappedBufferRange,
+    mnexus::BufferHandle buffer_handle,
+    uint32_t offset,
+    uint32_t size_in_bytes
+  ) {
+    auto const pool_handle = resource_pool::ResourceHandle::FromU64(buffer_handle.Get());
+    auto [hot, lock] = resource_storage_->buffers.GetHotConstRefWithSharedLockGuard(pool_handle);
+    MBASE_ASSERT_MSG(hot.mapped_data != nullptr, "InvalidateMappedBufferRange requires a kMappable buffer");
+
+    vmaInvalidateAllocation(hot.vma_allocator, hot.vma_allocation, hot.base_offset + offset, size_in_bytes);
+  }
+
   // ----------------------------------------------------------------------------------------------
   // Texture
   //
@@ -293,16 +787,49 @@ public:
     if (pool_handle.IsNull()) {
       return mnexus::TextureHandle::Invalid();
     }
+    memory_tracker_.OnCreated(profiling::MemoryResourceType::kTexture, profiling::EstimateTextureSizeInBytes(desc));
 
     return mnexus::TextureHandle { pool_handle.AsU64() };
   }
 
+  IMPL_VAPI(MnBool32, CreateAliasedTextures,
+    mnexus::container::ArrayProxy<mnexus::TextureDesc const> descs,
+    mnexus::TextureHandle* out_textures
+  ) {
+
+    std::vector<resource_pool::ResourceHandle> pool_handles(descs.size(), resource_pool::ResourceHandle::Null());
+    bool const created = EmplaceAliasedTextureResourcePool(
+      resource_storage_->textures,
+      *vk_device_,
+      std::span(descs.data(), descs.size()),
+      pool_handles
+    );
+    if (!created) {
+      return MnBoolFalse;
+    }
+
+    for (uint32_t i = 0; i < descs.size(); ++i) {
+      auto [cold, lock] = resource_storage_->textures.GetColdConstRefWithSharedLockGuard(pool_handles[i]);
+      memory_tracker_.OnCreated(profiling::MemoryResourceType::kTexture, cold.GetTrackedSizeInBytes());
+      out_textures[i] = mnexus::TextureHandle { pool_handles[i].AsU64() };
+    }
+    return MnBoolTrue;
+  }
+
   IMPL_VAPI(void, DestroyTexture,
     mnexus::TextureHandle texture_handle
   ) {
     // FIXME: Should defer destruction until the GPU is done using this texture.
     auto const pool_handle = resource_pool::ResourceHandle::FromU64(texture_handle.Get());
+
+    uint64_t size_in_bytes = 0;
+    {
+      auto [cold, lock] = resource_storage_->textures.GetColdConstRefWithSharedLockGuard(pool_handle);
+      size_in_bytes = cold.GetTrackedSizeInBytes();
+    }
+
     resource_storage_->textures.Erase(pool_handle);
+    memory_tracker_.OnDestroyed(profiling::MemoryResourceType::kTexture, size_in_bytes);
   }
 
   IMPL_VAPI(void, GetTextureDesc,
@@ -321,11 +848,13 @@ public:
   IMPL_VAPI(mnexus::SamplerHandle, CreateSampler,
     mnexus::SamplerDesc const& desc
   ) {
-    resource_pool::ResourceHandle const pool_handle = EmplaceSamplerResourcePool(
-      resource_storage_->samplers,
-      *vk_device_,
-      desc
-    );
+    resource_pool::ResourceHandle const pool_handle = resource_storage_->sampler_cache.Acquire(desc, [&] {
+      return EmplaceSamplerResourcePool(
+        resource_storage_->samplers,
+        *vk_device_,
+        desc
+      );
+    });
 
     if (pool_handle.IsNull()) {
       return mnexus::SamplerHandle::Invalid();
@@ -338,7 +867,109 @@ public:
     mnexus::SamplerHandle sampler_handle
   ) {
     auto const pool_handle = resource_pool::ResourceHandle::FromU64(sampler_handle.Get());
-    resource_storage_->samplers.Erase(pool_handle);
+
+    mnexus::SamplerDesc desc;
+    {
+      auto [cold, lock] = resource_storage_->samplers.GetColdConstRefWithSharedLockGuard(pool_handle);
+      desc = cold.desc;
+    }
+
+    // Identical descriptors share one sampler; only the last reference destroys it.
+    if (resource_storage_->sampler_cache.Release(desc)) {
+      resource_storage_->samplers.Erase(pool_handle);
+    }
+  }
+
+  // ----------------------------------------------------------------------------------------------
+  // Bindless Resources
+  //
+
+  IMPL_VAPI(uint32_t, RegisterBindlessSampledTexture,
+    mnexus::TextureHandle texture_handle,
+    mnexus::TextureSubresourceRange const& subresource_range
+  ) {
+    if (bindless_table_ == nullptr) {
+      MBASE_LOG_ERROR("RegisterBindlessSampledTexture: bindless resources are not enabled");
+      return mnexus::kInvalidBindlessIndex;
+    }
+
+    auto const pool_handle = resource_pool::ResourceHandle::FromU64(texture_handle.Get());
+    auto [hot, cold, lock] = resource_storage_->textures.GetConstRefWithSharedLockGuard(pool_handle);
+    VulkanImage const& vk_image = hot.GetVkImage();
+
+    VkImageViewCreateInfo const view_info {
+      .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .image = vk_image.handle(),
+      .viewType = subresource_range.array_layer_count > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D,
+      .format = vk_image.vk_format(),
+      .components = {},
+      .subresourceRange = ToVkImageSubresourceRange(subresource_range),
+    };
+
+    VkImageView vk_image_view = VK_NULL_HANDLE;
+    VkResult const result = vkCreateImageView(vk_device_->handle(), &view_info, nullptr, &vk_image_view);
+    if (result != VK_SUCCESS) {
+      MBASE_LOG_ERROR("vkCreateImageView failed: {}", string_VkResult(result));
+      return mnexus::kInvalidBindlessIndex;
+    }
+
+    // Registered textures are read in their default layout, which command lists restore at `End`.
+    return bindless_table_->RegisterSampledImage(
+      VulkanImageView(
+        vk_image_view,
+        VulkanObjectDestroyInfo { .type = VulkanObjectType::kImageView },
+        vk_device_->GetDeferredDestroyer()
+      ),
+      ImageLayoutTracker::GetDefaultLayout(vk_image.vk_usage_flags(), vk_image.vk_format())
+    );
+  }
+
+  IMPL_VAPI(uint32_t, RegisterBindlessStorageBuffer,
+    mnexus::BufferHandle buffer_handle,
+    uint64_t offset,
+    uint64_t size
+  ) {
+    if (bindless_table_ == nullptr) {
+      MBASE_LOG_ERROR("RegisterBindlessStorageBuffer: bindless resources are not enabled");
+      return mnexus::kInvalidBindlessIndex;
+    }
+
+    auto const pool_handle = resource_pool::ResourceHandle::FromU64(buffer_handle.Get());
+    auto [hot, cold, lock] = resource_storage_->buffers.GetConstRefWithSharedLockGuard(pool_handle);
+    return bindless_table_->RegisterStorageBuffer(hot.vk_buffer.handle(), hot.base_offset + offset, size);
+  }
+
+  IMPL_VAPI(uint32_t, RegisterBindlessSampler,
+    mnexus::SamplerHandle sampler_handle
+  ) {
+    if (bindless_table_ == nullptr) {
+      MBASE_LOG_ERROR("RegisterBindlessSampler: bindless resources are not enabled");
+      return mnexus::kInvalidBindlessIndex;
+    }
+
+    auto const pool_handle = resource_pool::ResourceHandle::FromU64(sampler_handle.Get());
+    auto [hot, cold, lock] = resource_storage_->samplers.GetConstRefWithSharedLockGuard(pool_handle);
+    return bindless_table_->RegisterSampler(hot.vk_sampler.handle());
+  }
+
+  IMPL_VAPI(void, UnregisterBindlessSampledTexture, uint32_t index) {
+    if (bindless_table_ != nullptr) {
+      bindless_table_->UnregisterSampledImage(index);
+    }
+  }
+
+  IMPL_VAPI(void, UnregisterBindlessStorageBuffer, uint32_t index) {
+    if (bindless_table_ != nullptr) {
+      bindless_table_->UnregisterStorageBuffer(index);
+    }
+  }
+
+  IMPL_VAPI(void, UnregisterBindlessSampler, uint32_t index) {
+    if (bindless_table_ != nullptr) {
+      bindless_table_->UnregisterSampler(index);
+    }
   }
 
   // ----------------------------------------------------------------------------------------------
@@ -380,7 +1011,8 @@ public:
       *vk_device_,
       desc,
       resource_storage_->shader_modules,
-      resource_storage_->pipeline_layout_cache
+      resource_storage_->pipeline_layout_cache,
+      bindless_table_.get()
     );
 
     if (pool_handle.IsNull()) {
@@ -393,9 +1025,14 @@ public:
   IMPL_VAPI(void, DestroyProgram,
     mnexus::ProgramHandle program_handle
   ) {
-    // FIXME: Should defer destruction until the GPU is done using this program.
-    auto pool_handle = resource_pool::ResourceHandle::FromU64(program_handle.Get());
-    resource_storage_->programs.Erase(pool_handle);
+    // The pool entry stays until no unsubmitted command list references the program and every submission that used
+    // it has completed, so lists recorded before the destroy can still stamp it at submit.
+    auto const pool_handle = resource_pool::ResourceHandle::FromU64(program_handle.Get());
+    {
+      mbase::LockGuard lock(retiring_programs_mutex_);
+      retiring_programs_.push_back(pool_handle);
+    }
+    this->ProcessRetiringPrograms();
   }
 
   // ----------------------------------------------------------------------------------------------
@@ -439,6 +1076,36 @@ public:
     return mnexus::RenderPipelineHandle::Invalid();
   }
 
+  // ----------------------------------------------------------------------------------------------
+  // RenderBundle
+  //
+
+  IMPL_VAPI(mnexus::IRenderBundleEncoder*, CreateRenderBundleEncoder,
+    mnexus::RenderBundleDesc const& /*desc*/
+  ) {
+    STUB_NOT_IMPLEMENTED();
+    return nullptr;
+  }
+
+  IMPL_VAPI(mnexus::RenderBundleHandle, FinishRenderBundleEncoder,
+    mnexus::IRenderBundleEncoder* /*encoder*/
+  ) {
+    STUB_NOT_IMPLEMENTED();
+    return mnexus::RenderBundleHandle::Invalid();
+  }
+
+  IMPL_VAPI(void, DiscardRenderBundleEncoder,
+    mnexus::IRenderBundleEncoder* /*encoder*/
+  ) {
+    STUB_NOT_IMPLEMENTED();
+  }
+
+  IMPL_VAPI(void, DestroyRenderBundle,
+    mnexus::RenderBundleHandle /*render_bundle_handle*/
+  ) {
+    STUB_NOT_IMPLEMENTED();
+  }
+
   // ----------------------------------------------------------------------------------------------
   // Device Capability
   //
@@ -449,6 +1116,9 @@ public:
       .polygon_mode_line = MnBoolTrue,
       .polygon_mode_point = MnBoolTrue,
       .buffer_mappable = MnBoolTrue,
+      .timestamp_query = this->SupportsTimestampQuery() ? MnBoolTrue : MnBoolFalse,
+      .bindless_resources = bindless_table_ != nullptr ? MnBoolTrue : MnBoolFalse,
+      .texture_memory_aliasing = MnBoolTrue,
     };
   }
 
@@ -473,6 +1143,72 @@ public:
     return {};
   }
 
+  IMPL_VAPI(mnexus::SamplerCacheSnapshot, GetSamplerCacheSnapshot) {
+    return resource_storage_->sampler_cache.GetSnapshot();
+  }
+
+  IMPL_VAPI(mnexus::PerfCountersSnapshot, GetPerfCountersSnapshot) {
+    profiling::PerfCounterValues values = perf_counters_.Load();
+    values[static_cast<uint32_t>(profiling::PerfCounter::kResourcePoolLookups)] += resource_storage_->GetPoolLookupCount();
+    return profiling::MakePerfCountersSnapshot(values);
+  }
+
+  IMPL_VAPI(void, ResetPerfCounters) {
+    perf_counters_.Reset();
+    resource_storage_->ResetPoolLookupCounts();
+  }
+
+  IMPL_VAPI(mnexus::MemoryStats, GetMemoryStats) {
+    mnexus::MemoryStats stats;
+    memory_tracker_.FillResourceStats(stats);
+
+    // Without VK_EXT_memory_budget, VMA estimates usage from its own allocations and the budget from the heap size.
+    VkPhysicalDeviceMemoryProperties const& memory_properties = vk_device_->physical_device_desc().memory_properties();
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets {};
+    vmaGetHeapBudgets(vk_device_->vma_allocator(), budgets.data());
+
+    stats.heaps.reserve(memory_properties.memoryHeapCount);
+    for (uint32_t heap_index = 0; heap_index < memory_properties.memoryHeapCount; ++heap_index) {
+      VkMemoryHeap const& heap = memory_properties.memoryHeaps[heap_index];
+      stats.heaps.emplace_back(
+        mnexus::MemoryHeapStats {
+          .device_local = (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0,
+          .size_in_bytes = heap.size,
+          .allocated_in_bytes = budgets[heap_index].statistics.blockBytes,
+          .usage_in_bytes = budgets[heap_index].usage,
+          .budget_in_bytes = budgets[heap_index].budget,
+        }
+      );
+    }
+    return stats;
+  }
+
+  IMPL_VAPI(void, SetMemoryThresholdCallback,
+    uint64_t threshold_in_bytes,
+    MnMemoryThresholdCallback callback,
+    void* user_data
+  ) {
+    memory_tracker_.SetThresholdCallback(threshold_in_bytes, callback, user_data);
+  }
+
+  IMPL_VAPI(void, SetGpuTimingEnabled, bool enabled) {
+    gpu_timing_enabled_.store(enabled && this->SupportsTimestampQuery(), std::memory_order_relaxed);
+  }
+
+  IMPL_VAPI(MnBool32, GetGpuTimingReport,
+    mnexus::QueueId const& queue_id,
+    mnexus::IntraQueueSubmissionId submission_id,
+    mnexus::GpuTimingReport& out_report
+  ) {
+    if (vk_device_->QueueGetCompletedValue(queue_id) < submission_id.Get()) {
+      return MnBoolFalse;
+    }
+
+    this->ProcessPendingGpuTimings();
+
+    return gpu_timing_report_cache_.Find(queue_id, submission_id, out_report) ? MnBoolTrue : MnBoolFalse;
+  }
+
   // ----------------------------------------------------------------------------------------------
   // Local
 
@@ -508,6 +1244,12 @@ public:
     }
     auto [image_index, vk_image] = opt_last_acquired.value();
     
+    if (wsi_swapchain_.IsOffscreen()) {
+      // Nothing to display; the image stays queued until `wait_serial` completes and the present latency elapses.
+      wsi_swapchain_.PresentOffscreenImage(wait_serial);
+      return true;
+    }
+
     uint64_t const serial = vk_device_->QueuePresentSwapchainImage(queue_id, wait_serial, wsi_swapchain_.GetVkSwapchainHandle(), image_index);
     (void)serial;
     wsi_swapchain_.ReturnImage(image_index);
@@ -515,10 +1257,84 @@ public:
     return true;
   }
 
+  bool ConfigureOffscreenSwapchain(mnexus::OffscreenSwapchainDesc const& desc) {
+    mnexus::TextureDesc const texture_desc {
+      .usage = mnexus::TextureUsageFlagBits::kAttachment |
+        mnexus::TextureUsageFlagBits::kTransferSrc |
+        mnexus::TextureUsageFlagBits::kTransferDst,
+      .format = desc.format,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = std::max(desc.width, 1u),
+      .height = std::max(desc.height, 1u),
+      .depth = 1,
+      .mip_level_count = 1,
+      .array_layer_count = 1,
+    };
+
+    std::vector<VulkanImage> images;
+    images.reserve(desc.image_count);
+    for (uint32_t i = 0; i < desc.image_count; ++i) {
+      std::optional<VulkanImage> opt_vk_image = CreateVulkanImage(*vk_device_, texture_desc);
+      if (!opt_vk_image.has_value()) {
+        MBASE_LOG_ERROR("Failed to create offscreen swapchain image {} of {}", i, desc.image_count);
+        return false;
+      }
+      images.emplace_back(std::move(opt_vk_image.value()));
+    }
+
+    wsi_swapchain_.OnOffscreenCreated(
+      std::move(images),
+      texture_desc,
+      std::chrono::nanoseconds(desc.present_latency_ns)
+    );
+    return true;
+  }
+
+  bool IsOffscreenSwapchain() const {
+    return wsi_swapchain_.IsOffscreen();
+  }
+
+  void AcquireNextOffscreenSwapchainTexture() {
+    mnexus::QueueId const queue_id = vk_device_->queue_selection().present_capable;
+    wsi_swapchain_.AcquireNextOffscreenImage(
+      [this, &queue_id](uint64_t serial) { vk_device_->QueueWaitSubmitSerial(queue_id, serial); }
+    );
+  }
+
+  uint32_t GetPresentQueueDepth() {
+    if (!wsi_swapchain_.IsOffscreen()) {
+      return 0;
+    }
+    uint64_t const completed = vk_device_->QueueGetCompletedValue(vk_device_->queue_selection().present_capable);
+    return wsi_swapchain_.GetOffscreenQueueDepth(completed);
+  }
+
+  VkImageLayout GetSwapchainPresentVkImageLayout() const {
+    return wsi_swapchain_.GetPresentVkImageLayout();
+  }
+
 private:
+  // ----------------------------------------------------------------------------------------------
+  // IQueueCompletionSource (called from the completion thread)
+
+  uint64_t PollQueueCompletedValue(uint32_t queue_index) override {
+    uint64_t const completed = vk_device_->QueueGetCompletedValue(vk_device_->queue_index_map().GetQueueId(queue_index));
+    // Readback destinations are written by the CPU; do it before callbacks that consume them run.
+    this->ProcessPendingReadbacks();
+    this->ProcessPendingGpuTimings();
+    return completed;
+  }
+
+  void WaitAnyQueueValue(uint64_t const (&target_values)[kMaxQueues], uint64_t timeout_ns) override {
+    vk_device_->QueueWaitAnySerial(
+      mbase::ArrayProxy<uint64_t const>(target_values, vk_device_->queue_index_map().Count()),
+      timeout_ns
+    );
+  }
+
   struct PendingReadback {
     void* dst;
-    uint32_t size_in_bytes;
+    uint64_t size_in_bytes;
     StagingBuffer* staging;
     mnexus::QueueId queue_id;
     uint64_t serial;
@@ -541,12 +1357,123 @@ private:
     }
   }
 
+  /// Returns true if every submission recorded in `snapshot` has completed.
+  [[nodiscard]] bool IsRetired(ResourceSyncStamp::Snapshot const& snapshot) {
+    QueueIndexMap const& queue_index_map = vk_device_->queue_index_map();
+    for (uint32_t i = 0; i < queue_index_map.Count(); ++i) {
+      if ((snapshot.used_mask & (1u << i)) != 0 &&
+          vk_device_->QueueGetCompletedValue(queue_index_map.GetQueueId(i)) < snapshot.last_used[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Erases destroyed programs whose submissions have all completed.
+  void ProcessRetiringPrograms() {
+    mbase::LockGuard lock(retiring_programs_mutex_);
+
+    for (uint32_t i = 0; i < retiring_programs_.size();) {
+      resource_pool::ResourceHandle const handle = retiring_programs_[i];
+
+      // Snapshot now rather than at destroy time: lists recorded before the destroy may have been submitted since.
+      // Open references are checked first, so that the stamps of the submits that dropped them are in the snapshot.
+      bool has_open_list_references = false;
+      ResourceSyncStamp::Snapshot snapshot;
+      {
+        auto [hot, hot_lock] = resource_storage_->programs.GetHotConstRefWithSharedLockGuard(handle);
+        has_open_list_references = hot.sync_stamp.HasOpenListReferences();
+        snapshot = hot.sync_stamp.TakeSnapshot();
+      }
+
+      if (!has_open_list_references && this->IsRetired(snapshot)) {
+        resource_storage_->programs.Erase(handle);
+        retiring_programs_[i] = retiring_programs_.back();
+        retiring_programs_.pop_back();
+      } else {
+        ++i;
+      }
+    }
+  }
+
+  struct PendingGpuTiming {
+    mnexus::QueueId queue_id;
+    uint64_t serial;
+    std::unique_ptr<profiling::GpuTimingRecorder> recorder;
+    VkQueryPool query_pool;
+  };
+
+  [[nodiscard]] bool SupportsTimestampQuery() const {
+    VkPhysicalDeviceLimits const& limits = vk_device_->physical_device_desc().properties().limits;
+    return limits.timestampComputeAndGraphics == VK_TRUE && limits.timestampPeriod > 0.0f;
+  }
+
+  void ProcessPendingGpuTimings() {
+    // Called on every submit and poll; skip the lock unless a timed submission is outstanding.
+    if (pending_gpu_timing_count_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+
+    mbase::LockGuard lock(pending_gpu_timings_mutex_);
+
+    double const nanoseconds_per_tick = vk_device_->physical_device_desc().properties().limits.timestampPeriod;
+
+    std::vector<uint64_t> timestamps;
+    for (uint32_t i = 0; i < pending_gpu_timings_.size();) {
+      PendingGpuTiming& pending = pending_gpu_timings_[i];
+      if (vk_device_->QueueGetCompletedValue(pending.queue_id) < pending.serial) {
+        ++i;
+        continue;
+      }
+
+      uint32_t const query_count = pending.recorder->GetQueryCount();
+      timestamps.assign(query_count, 0);
+
+      if (query_count > 0) {
+        VkResult const result = vkGetQueryPoolResults(
+          vk_device_->handle(), pending.query_pool,
+          0, query_count,
+          timestamps.size() * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t),
+          VK_QUERY_RESULT_64_BIT
+        );
+        if (result != VK_SUCCESS) {
+          MBASE_LOG_ERROR("vkGetQueryPoolResults failed for GPU timing: {}", string_VkResult(result));
+          timestamps.assign(query_count, 0);
+        }
+      }
+
+      gpu_timing_report_cache_.Insert(
+        pending.queue_id,
+        pending.recorder->BuildReport(mnexus::IntraQueueSubmissionId { pending.serial }, timestamps, nanoseconds_per_tick)
+      );
+
+      vkDestroyQueryPool(vk_device_->handle(), pending.query_pool, nullptr);
+      pending_gpu_timings_.erase(pending_gpu_timings_.begin() + static_cast<ptrdiff_t>(i));
+      pending_gpu_timing_count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
   IVulkanDevice* vk_device_ = nullptr;
   WsiSwapchain wsi_swapchain_;
   ResourceStorage* resource_storage_ = nullptr;
   IDescriptorSetAllocator* descriptor_set_allocator_ = nullptr;
+  std::unique_ptr<BindlessTable> bindless_table_;
   std::vector<PendingReadback> pending_readbacks_;
   mbase::Lockable<std::mutex> pending_readbacks_mutex_;
+
+  /// Destroyed programs waiting for their submissions to complete.
+  std::vector<resource_pool::ResourceHandle> retiring_programs_ MBASE_GUARDED_BY(retiring_programs_mutex_);
+  mbase::Lockable<std::mutex> retiring_programs_mutex_;
+
+  std::atomic<bool> gpu_timing_enabled_ = false;
+  std::vector<PendingGpuTiming> pending_gpu_timings_ MBASE_GUARDED_BY(pending_gpu_timings_mutex_);
+  mbase::Lockable<std::mutex> pending_gpu_timings_mutex_;
+  /// Size of `pending_gpu_timings_`, readable without the lock.
+  std::atomic<uint32_t> pending_gpu_timing_count_ = 0;
+  profiling::GpuTimingReportCache gpu_timing_report_cache_;
+
+  profiling::DevicePerfCounters perf_counters_;
+  profiling::MemoryTracker memory_tracker_;
 };
 
 // ==================================================================================================
@@ -555,11 +1482,13 @@ private:
 
 class BackendVulkan final : public IBackendVulkan {
 public:
-  explicit BackendVulkan(std::unique_ptr<IVulkanDevice> vk_device) :
+  explicit BackendVulkan(std::unique_ptr<IVulkanDevice> vk_device, bool placed_buffers) :
     vk_device_(std::move(vk_device)),
     device_(vk_device_.get(), &resource_storage_)
   {
-    
+    if (placed_buffers) {
+      resource_storage_.placed_buffer_allocator = std::make_unique<PlacedBufferAllocator>(*vk_device_);
+    }
   }
   ~BackendVulkan() override = default;
   MBASE_DISALLOW_COPY_MOVE(BackendVulkan);
@@ -584,20 +1513,22 @@ public:
 
   void OnPresentPrologue() override {
     VkFence signal_fence = VK_NULL_HANDLE;
-    {
+    if (device_.IsOffscreenSwapchain()) {
+      device_.AcquireNextOffscreenSwapchainTexture();
+    } else {
       VkFenceCreateInfo fence_info {
         .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
         .pNext = nullptr,
         .flags = 0,
       };
       vkCreateFence(vk_device_->handle(), &fence_info, nullptr, &signal_fence);
-    }
 
-    std::optional<uint32_t> opt_acquired_index = device_.AcquireNextSwapchainTexture(signal_fence);
-    if (!opt_acquired_index.has_value()) {
-      MBASE_LOG_ERROR("Failed to acquire next swapchain image for presentation.");
-      vkDestroyFence(vk_device_->handle(), signal_fence, nullptr);
-      return;
+      std::optional<uint32_t> opt_acquired_index = device_.AcquireNextSwapchainTexture(signal_fence);
+      if (!opt_acquired_index.has_value()) {
+        MBASE_LOG_ERROR("Failed to acquire next swapchain image for presentation.");
+        vkDestroyFence(vk_device_->handle(), signal_fence, nullptr);
+        return;
+      }
     }
 
     mnexus::QueueId const queue_id = vk_device_->queue_selection().present_capable;
@@ -647,17 +1578,19 @@ public:
         .pImageMemoryBarriers = &barrier,
       };
 
-      VkCommandBuffer vk_cb_handle = vk_device_->transient_command_pool().Acquire();
+      VkCommandBuffer vk_cb_handle = vk_device_->transient_command_pool(queue_id).Acquire();
       vkCmdPipelineBarrier2KHR(vk_cb_handle, &dependency_info);
       vkEndCommandBuffer(vk_cb_handle);
 
       uint64_t const serial = vk_device_->QueueSubmitSingle(queue_id, vk_cb_handle);
-      vk_device_->transient_command_pool().Release(vk_cb_handle, queue_id, serial);
+      vk_device_->transient_command_pool(queue_id).Release(vk_cb_handle, queue_id, serial);
     }
 
     // Wait for the swapchain image acquire to complete.
-    vkWaitForFences(vk_device_->handle(), 1, &signal_fence, VK_TRUE, UINT64_MAX);
-    vkDestroyFence(vk_device_->handle(), signal_fence, nullptr);
+    if (signal_fence != VK_NULL_HANDLE) {
+      vkWaitForFences(vk_device_->handle(), 1, &signal_fence, VK_TRUE, UINT64_MAX);
+      vkDestroyFence(vk_device_->handle(), signal_fence, nullptr);
+    }
   }
 
   void OnPresentEpilogue() override {
@@ -682,7 +1615,7 @@ public:
         .dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR,
         .dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT_KHR | VK_ACCESS_2_MEMORY_WRITE_BIT_KHR,
         .oldLayout = default_layout,
-        .newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+        .newLayout = device_.GetSwapchainPresentVkImageLayout(),
         .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
         .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
         .image = hot.GetVkImage().handle(),
@@ -707,15 +1640,22 @@ public:
         .pImageMemoryBarriers = &barrier,
       };
 
-      VkCommandBuffer vk_cb_handle = vk_device_->transient_command_pool().Acquire();
+      VkCommandBuffer vk_cb_handle = vk_device_->transient_command_pool(queue_id).Acquire();
       vkCmdPipelineBarrier2KHR(vk_cb_handle, &dependency_info);
       vkEndCommandBuffer(vk_cb_handle);
 
       serial = vk_device_->QueueSubmitSingle(queue_id, vk_cb_handle);
-      vk_device_->transient_command_pool().Release(vk_cb_handle, queue_id, serial);
+      vk_device_->transient_command_pool(queue_id).Release(vk_cb_handle, queue_id, serial);
     }
 
     device_.QueueSwapchainTexturePresent(queue_id, serial);
+
+    // Recording threads move on to a fresh command pool; this frame's pools are reset once its submissions retire.
+    vk_device_->thread_command_pool_registry().AdvanceFrame();
+  }
+
+  uint32_t GetPresentQueueDepth() override {
+    return device_.GetPresentQueueDepth();
   }
 
   // ----------------------------------------------------------------------------------------------
@@ -728,6 +1668,10 @@ public:
   // ----------------------------------------------------------------------------------------------
   // Local.
 
+  bool ConfigureOffscreenSwapchain(mnexus::OffscreenSwapchainDesc const& desc) {
+    return device_.ConfigureOffscreenSwapchain(desc);
+  }
+
   void Shutdown() {
     vk_device_->Shutdown();
   }
@@ -799,10 +1743,17 @@ std::unique_ptr<IBackendVulkan> IBackendVulkan::Create(BackendVulkanCreateDesc c
     mandatory_device_extensions.emplace_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
   }
 
+  // Opt-in features count towards the device score.
+  std::vector<char const*> optional_device_extensions;
+  if (desc.bindless_resources) {
+    optional_device_extensions.emplace_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+  }
+
   std::optional<PhysicalDeviceDesc> opt_physical_device_desc = SelectPhysicalDevice(
     instance,
     mandatory_device_extensions,
-    mbase::ArrayProxy<char const* const>{}
+    optional_device_extensions,
+    desc.adapter_override
   );
   if (!opt_physical_device_desc.has_value()) {
     MBASE_LOG_ERROR("Failed to select a physical device for Vulkan backend.");
@@ -838,7 +1789,11 @@ std::unique_ptr<IBackendVulkan> IBackendVulkan::Create(BackendVulkanCreateDesc c
   VulkanDeviceDesc device_desc {
     .physical_device_desc = &physical_device_desc,
     .headless = desc.headless,
+    .descriptor_indexing = desc.bindless_resources && BindlessTable::IsSupported(physical_device_desc),
   };
+  if (desc.bindless_resources && !device_desc.descriptor_indexing) {
+    MBASE_LOG_WARN("Bindless resources requested, but the device lacks the required descriptor indexing support");
+  }
 
   std::unique_ptr<IVulkanDevice> vk_device = IVulkanDevice::Create(
     std::move(instance),
@@ -849,7 +1804,14 @@ std::unique_ptr<IBackendVulkan> IBackendVulkan::Create(BackendVulkanCreateDesc c
     return nullptr;
   }
 
-  return std::make_unique<BackendVulkan>(std::move(vk_device));
+  auto backend = std::make_unique<BackendVulkan>(std::move(vk_device), desc.placed_buffers);
+  if (desc.headless && desc.offscreen_swapchain.image_count != 0) {
+    if (!backend->ConfigureOffscreenSwapchain(desc.offscreen_swapchain)) {
+      MBASE_LOG_ERROR("Failed to create the offscreen swapchain.");
+      return nullptr;
+    }
+  }
+  return backend;
 }
 
 } // namespace mnexus_backend::vulkan
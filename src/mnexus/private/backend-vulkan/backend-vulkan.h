@@ -11,6 +11,10 @@ namespace mnexus_backend::vulkan {
 struct BackendVulkanCreateDesc {
   bool headless = false;
   char const* app_name = "app";
+  bool placed_buffers = false;
+  bool bindless_resources = false;
+  mnexus::AdapterOverride adapter_override;
+  mnexus::OffscreenSwapchainDesc offscreen_swapchain;
 };
 
 class IBackendVulkan : public IBackend {
@@ -1,6 +1,9 @@
 // TU header --------------------------------------------
 #include "backend-vulkan/command/command_encoder.h"
 
+// c++ headers ------------------------------------------
+#include <cstring>
+
 // public project headers -------------------------------
 #include "mbase/public/assert.h"
 
@@ -10,13 +13,15 @@ CommandEncoder::CommandEncoder(
   VkCommandBuffer command_buffer,
   VkDevice device,
   IDescriptorSetAllocator* ds_allocator,
-  ResourceStorage* resource_storage
+  ResourceStorage* resource_storage,
+  VkDescriptorSet bindless_descriptor_set
 ) :
   command_buffer_(command_buffer),
   vk_device_(device),
   ds_allocator_(ds_allocator),
   resource_storage_(resource_storage)
 {
+  descriptor_set_binder_.SetBindlessDescriptorSet(bindless_descriptor_set);
 }
 
 void CommandEncoder::End() {
@@ -27,19 +32,37 @@ void CommandEncoder::BindComputePipeline(
   VkPipeline pipeline,
   VkPipelineLayout layout,
   VulkanDescriptorSetLayout const* descriptor_set_layouts,
-  uint32_t descriptor_set_count
+  uint32_t descriptor_set_count,
+  VkPushConstantRange const& push_constant_range
 ) {
   current_compute_pipeline_ = pipeline;
+  if (layout != current_pipeline_layout_) {
+    // Push constant contents do not survive a switch to a layout with a different range; re-push them.
+    push_constants_dirty_ = true;
+  }
   current_pipeline_layout_ = layout;
+  current_push_constant_range_ = push_constant_range;
   vkCmdBindPipeline(command_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
   descriptor_set_binder_.AssumePipelineLayout(layout, descriptor_set_layouts, descriptor_set_count);
 }
 
 void CommandEncoder::DispatchCompute(uint32_t x, uint32_t y, uint32_t z) {
   this->ResolveDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE);
+  this->FlushPushConstants();
   vkCmdDispatch(command_buffer_, x, y, z);
 }
 
+void CommandEncoder::SetPushConstants(
+  VkShaderStageFlags stages, uint32_t offset, void const* data, uint32_t size_in_bytes
+) {
+  MBASE_ASSERT_MSG(offset % 4 == 0 && size_in_bytes % 4 == 0, "Push constant offset and size must be multiples of 4");
+  MBASE_ASSERT_MSG(offset + size_in_bytes <= push_constant_data_.size(), "Push constant update exceeds kMaxPushConstantSizeInBytes");
+
+  std::memcpy(push_constant_data_.data() + offset, data, size_in_bytes);
+  push_constant_stages_written_ |= stages;
+  push_constants_dirty_ = true;
+}
+
 void CommandEncoder::BindBuffer(
   uint32_t set, uint32_t binding, uint32_t array_element,
   VkDescriptorType descriptor_type, uint64_t handle_id,
@@ -48,9 +71,35 @@ void CommandEncoder::BindBuffer(
   descriptor_set_binder_.SetBuffer(set, binding, array_element, descriptor_type, handle_id, buffer, offset, range);
 }
 
+void CommandEncoder::FlushPushConstants() {
+  if (!push_constants_dirty_ || current_push_constant_range_.size == 0) {
+    return;
+  }
+  MBASE_ASSERT_MSG(
+    (push_constant_stages_written_ & ~current_push_constant_range_.stageFlags) == 0,
+    "SetPushConstants names a stage that does not declare the push constant block"
+  );
+
+  // The whole range is pushed with the layout's stage flags, as Vulkan requires for a range shared by several stages.
+  vkCmdPushConstants(
+    command_buffer_,
+    current_pipeline_layout_,
+    current_push_constant_range_.stageFlags,
+    current_push_constant_range_.offset,
+    current_push_constant_range_.size,
+    push_constant_data_.data() + current_push_constant_range_.offset
+  );
+  push_constant_stages_written_ = 0;
+  push_constants_dirty_ = false;
+}
+
 void CommandEncoder::ResolveDescriptorSets(VkPipelineBindPoint bind_point) {
   MBASE_ASSERT(ds_allocator_ != nullptr);
-  descriptor_set_binder_.CmdBindDescriptorSets(command_buffer_, bind_point, vk_device_, ds_allocator_);
+  uint32_t const allocated_set_count =
+    descriptor_set_binder_.CmdBindDescriptorSets(command_buffer_, bind_point, vk_device_, ds_allocator_);
+  if (perf_counters_ != nullptr) {
+    perf_counters_->Add(profiling::PerfCounter::kDescriptorSetAllocations, allocated_set_count);
+  }
 }
 
 } // namespace mnexus_backend::vulkan
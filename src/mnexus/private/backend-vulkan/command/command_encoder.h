@@ -1,5 +1,10 @@
 #pragma once
 
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <array>
+
 // public project headers -------------------------------
 #include "mnexus/public/types.h"
 
@@ -7,6 +12,8 @@
 #include "backend-vulkan/depend/vulkan.h"
 #include "backend-vulkan/descriptor/descriptor_set_binder.h"
 
+#include "profiling/perf_counters.h"
+
 namespace mnexus_backend::vulkan {
 
 class IDescriptorSetAllocator;
@@ -26,18 +33,27 @@ public:
     VkCommandBuffer command_buffer,
     VkDevice device,
     IDescriptorSetAllocator* ds_allocator,
-    ResourceStorage* resource_storage
+    ResourceStorage* resource_storage,
+    VkDescriptorSet bindless_descriptor_set
   );
 
   [[nodiscard]] VkCommandBuffer command_buffer() const { return command_buffer_; }
 
+  /// Counters receiving the encoder's descriptor set allocations. May be null.
+  void set_perf_counters(profiling::CommandListPerfCounters* perf_counters) { perf_counters_ = perf_counters; }
+
   void End();
 
   // Compute
   void BindComputePipeline(VkPipeline pipeline, VkPipelineLayout layout,
-                           VulkanDescriptorSetLayout const* descriptor_set_layouts, uint32_t descriptor_set_count);
+                           VulkanDescriptorSetLayout const* descriptor_set_layouts, uint32_t descriptor_set_count,
+                           VkPushConstantRange const& push_constant_range);
   void DispatchCompute(uint32_t x, uint32_t y, uint32_t z);
 
+  // Push constants
+  /// Updates the shadow copy; the layout's range is pushed at the next dispatch.
+  void SetPushConstants(VkShaderStageFlags stages, uint32_t offset, void const* data, uint32_t size_in_bytes);
+
   // Binding
   void BindBuffer(uint32_t set, uint32_t binding, uint32_t array_element,
                   VkDescriptorType descriptor_type, uint64_t handle_id,
@@ -45,16 +61,25 @@ public:
 
 private:
   void ResolveDescriptorSets(VkPipelineBindPoint bind_point);
+  void FlushPushConstants();
 
   VkCommandBuffer command_buffer_ = VK_NULL_HANDLE;
   VkDevice vk_device_ = VK_NULL_HANDLE;
   IDescriptorSetAllocator* ds_allocator_ = nullptr;
   ResourceStorage* resource_storage_ = nullptr;
+  profiling::CommandListPerfCounters* perf_counters_ = nullptr;
 
   VkPipeline current_compute_pipeline_ = VK_NULL_HANDLE;
   VkPipelineLayout current_pipeline_layout_ = VK_NULL_HANDLE;
 
   DescriptorSetBinder descriptor_set_binder_;
+
+  // Push constants: recorded contents are kept across pipeline changes and re-pushed whenever the layout changes.
+  std::array<uint8_t, mnexus::kMaxPushConstantSizeInBytes> push_constant_data_ {};
+  VkPushConstantRange current_push_constant_range_ {};
+  /// Stages named by `SetPushConstants` since the last flush.
+  VkShaderStageFlags push_constant_stages_written_ = 0;
+  bool push_constants_dirty_ = false;
 };
 
 } // namespace mnexus_backend::vulkan
@@ -153,11 +153,54 @@ void ImageLayoutTracker::Transition(
 ) {
   Entry& entry = this->FindOrAddDefault(vk_image, subresource);
 
+  bool const covered_by_prepare =
+    entry.prepared && !entry.pending &&
+    entry.old_layout == new_layout &&
+    entry.src_scope.stage_mask == dst_stage_mask &&
+    entry.src_scope.access_mask == dst_access_mask;
+  entry.prepared = false;
+  if (covered_by_prepare) {
+    return;
+  }
+
   entry.new_layout = new_layout;
   entry.dst_scope = { dst_stage_mask, dst_access_mask };
   entry.pending = true;
 }
 
+void ImageLayoutTracker::Prepare(
+  VkImage vk_image,
+  Subresource const& subresource,
+  VkPipelineStageFlags2KHR dst_stage_mask,
+  VkAccessFlags2KHR dst_access_mask,
+  VkImageLayout new_layout
+) {
+  this->Transition(vk_image, subresource, dst_stage_mask, dst_access_mask, new_layout);
+  this->FindOrAddDefault(vk_image, subresource).prepared = true;
+}
+
+void ImageLayoutTracker::Discard(VkImage vk_image, Subresource const& subresource) {
+  Entry& entry = this->FindOrAddDefault(vk_image, subresource);
+  MBASE_ASSERT_MSG(!entry.pending, "ImageLayoutTracker: cannot discard a subresource with a pending transition");
+
+  entry.old_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+  entry.src_scope = { VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR, VK_ACCESS_2_MEMORY_WRITE_BIT_KHR };
+  entry.prepared = false;
+}
+
+void ImageLayoutTracker::Release(VkImage vk_image) {
+  auto it = tracked_images_.find(vk_image);
+  if (it == tracked_images_.end()) {
+    return;
+  }
+
+  for (std::optional<Entry> const& entry : it->second.entries) {
+    MBASE_ASSERT_MSG(!entry.has_value() || !entry->pending,
+      "ImageLayoutTracker: cannot release an image with a pending transition");
+  }
+  tracked_images_.erase(it);
+}
+
 void ImageLayoutTracker::TransitionToTransferDst(VkImage vk_image, Subresource const& subresource) {
   this->Transition(
     vk_image, subresource,
@@ -53,6 +53,24 @@ public:
   /// Convenience: transition to TRANSFER_SRC_OPTIMAL.
   void TransitionToTransferSrc(VkImage vk_image, Subresource const& subresource);
 
+  /// Like `Transition`, but a later `Transition` to the same layout and sync scope is skipped once, since this barrier
+  /// already covers it. Used by `ICommandList::TransitionTextures`.
+  void Prepare(
+    VkImage vk_image,
+    Subresource const& subresource,
+    VkPipelineStageFlags2KHR dst_stage_mask,
+    VkAccessFlags2KHR dst_access_mask,
+    VkImageLayout new_layout
+  );
+
+  /// Drops the contents of a subresource: its next transition starts from UNDEFINED and waits for all prior memory
+  /// writes, since another image aliasing the same memory may have written it.
+  void Discard(VkImage vk_image, Subresource const& subresource);
+
+  /// Stops tracking an image, so `TransitionAllToDefaults` leaves it in its current layout. A later use re-registers
+  /// it and **MUST** `Discard` it first.
+  void Release(VkImage vk_image);
+
   /// Transition all tracked subresources back to their default state (derived from usage).
   void TransitionAllToDefaults();
 
@@ -81,6 +99,8 @@ private:
     SyncScope dst_scope;
 
     bool pending = false;
+    /// Set by `Prepare`; the next matching `Transition` is elided.
+    bool prepared = false;
   };
 
   static constexpr uint32_t kExpectedSubresourceCount = 4;
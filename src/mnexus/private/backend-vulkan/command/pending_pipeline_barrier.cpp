@@ -3,6 +3,66 @@
 
 namespace mnexus_backend::vulkan {
 
+namespace {
+
+constexpr VkPipelineStageFlags2KHR kGraphicsStages =
+  VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT_KHR |
+  VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT_KHR |
+  VK_PIPELINE_STAGE_2_TESSELLATION_CONTROL_SHADER_BIT_KHR |
+  VK_PIPELINE_STAGE_2_TESSELLATION_EVALUATION_SHADER_BIT_KHR |
+  VK_PIPELINE_STAGE_2_GEOMETRY_SHADER_BIT_KHR |
+  VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT_KHR |
+  VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT_KHR |
+  VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT_KHR |
+  VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR |
+  VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT_KHR |
+  VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT_KHR |
+  VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT_KHR |
+  VK_PIPELINE_STAGE_2_PRE_RASTERIZATION_SHADERS_BIT_KHR;
+
+constexpr VkPipelineStageFlags2KHR kComputeStages =
+  VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT_KHR |
+  VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR;
+
+constexpr VkAccessFlags2KHR kGraphicsAccesses =
+  VK_ACCESS_2_INDEX_READ_BIT_KHR |
+  VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT_KHR |
+  VK_ACCESS_2_INPUT_ATTACHMENT_READ_BIT_KHR |
+  VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT_KHR |
+  VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR |
+  VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT_KHR |
+  VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT_KHR;
+
+constexpr VkAccessFlags2KHR kShaderAccesses =
+  VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT_KHR |
+  VK_ACCESS_2_UNIFORM_READ_BIT_KHR |
+  VK_ACCESS_2_SHADER_READ_BIT_KHR |
+  VK_ACCESS_2_SHADER_WRITE_BIT_KHR |
+  VK_ACCESS_2_SHADER_SAMPLED_READ_BIT_KHR |
+  VK_ACCESS_2_SHADER_STORAGE_READ_BIT_KHR |
+  VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT_KHR;
+
+} // namespace
+
+SyncScope PendingPipelineBarrier::RestrictToQueue(SyncScope scope) const {
+  VkPipelineStageFlags2KHR unsupported_stages = 0;
+  VkAccessFlags2KHR unsupported_accesses = 0;
+  if ((queue_flags_ & VK_QUEUE_GRAPHICS_BIT) == 0) {
+    unsupported_stages |= kGraphicsStages;
+    unsupported_accesses |= kGraphicsAccesses;
+    if ((queue_flags_ & VK_QUEUE_COMPUTE_BIT) == 0) {
+      unsupported_stages |= kComputeStages;
+      unsupported_accesses |= kShaderAccesses;
+    }
+  }
+
+  if ((scope.stage_mask & unsupported_stages) != 0) {
+    scope.stage_mask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR;
+  }
+  scope.access_mask &= ~unsupported_accesses;
+  return scope;
+}
+
 void PendingPipelineBarrier::AddImageMemoryBarrier(
   VkImage vk_image,
   VkImageSubresourceRange const& subresource_range,
@@ -40,9 +100,9 @@ void PendingPipelineBarrier::AddGlobalMemoryBarrier(
   global_barrier_->dst_access_mask |= dst_access_mask;
 }
 
-void PendingPipelineBarrier::FlushAndClear(VkCommandBuffer command_buffer) {
+uint32_t PendingPipelineBarrier::FlushAndClear(VkCommandBuffer command_buffer) {
   if (this->IsEmpty()) {
-    return;
+    return 0;
   }
 
   // Build VkImageMemoryBarrier2KHR array.
@@ -50,13 +110,15 @@ void PendingPipelineBarrier::FlushAndClear(VkCommandBuffer command_buffer) {
   vk_image_barriers.reserve(image_barriers_.size());
 
   for (auto const& b : image_barriers_) {
+    SyncScope const src = this->RestrictToQueue({ b.src_stage_mask, b.src_access_mask });
+    SyncScope const dst = this->RestrictToQueue({ b.dst_stage_mask, b.dst_access_mask });
     vk_image_barriers.emplace_back(VkImageMemoryBarrier2KHR {
       .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR,
       .pNext = nullptr,
-      .srcStageMask = b.src_stage_mask,
-      .srcAccessMask = b.src_access_mask,
-      .dstStageMask = b.dst_stage_mask,
-      .dstAccessMask = b.dst_access_mask,
+      .srcStageMask = src.stage_mask,
+      .srcAccessMask = src.access_mask,
+      .dstStageMask = dst.stage_mask,
+      .dstAccessMask = dst.access_mask,
       .oldLayout = b.old_layout,
       .newLayout = b.new_layout,
       .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
@@ -69,13 +131,15 @@ void PendingPipelineBarrier::FlushAndClear(VkCommandBuffer command_buffer) {
   // Build optional VkMemoryBarrier2KHR.
   VkMemoryBarrier2KHR vk_global_barrier {};
   if (global_barrier_.has_value()) {
+    SyncScope const src = this->RestrictToQueue({ global_barrier_->src_stage_mask, global_barrier_->src_access_mask });
+    SyncScope const dst = this->RestrictToQueue({ global_barrier_->dst_stage_mask, global_barrier_->dst_access_mask });
     vk_global_barrier = VkMemoryBarrier2KHR {
       .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2_KHR,
       .pNext = nullptr,
-      .srcStageMask = global_barrier_->src_stage_mask,
-      .srcAccessMask = global_barrier_->src_access_mask,
-      .dstStageMask = global_barrier_->dst_stage_mask,
-      .dstAccessMask = global_barrier_->dst_access_mask,
+      .srcStageMask = src.stage_mask,
+      .srcAccessMask = src.access_mask,
+      .dstStageMask = dst.stage_mask,
+      .dstAccessMask = dst.access_mask,
     };
   }
 
@@ -93,9 +157,13 @@ void PendingPipelineBarrier::FlushAndClear(VkCommandBuffer command_buffer) {
 
   vkCmdPipelineBarrier2KHR(command_buffer, &dependency_info);
 
+  uint32_t const barrier_count = dependency_info.memoryBarrierCount + dependency_info.imageMemoryBarrierCount;
+
   // Clear.
   image_barriers_.clear();
   global_barrier_.reset();
+
+  return barrier_count;
 }
 
 bool PendingPipelineBarrier::IsEmpty() const {
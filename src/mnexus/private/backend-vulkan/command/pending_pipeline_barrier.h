@@ -29,10 +29,16 @@ struct SyncScope final {
 // Accumulates image memory barriers and an optional global memory barrier,
 // then flushes them all via a single vkCmdPipelineBarrier2KHR call.
 //
+// Barriers are recorded against the capabilities of the target queue family: stages the family does not support are
+// widened to ALL_COMMANDS, and accesses only those stages perform are dropped. This lets the same layout tracking
+// drive command buffers for compute-only and transfer-only queues.
+//
 
 class PendingPipelineBarrier final {
 public:
-  PendingPipelineBarrier() = default;
+  static constexpr VkQueueFlags kUniversalQueueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+
+  explicit PendingPipelineBarrier(VkQueueFlags queue_flags = kUniversalQueueFlags) : queue_flags_(queue_flags) {}
   ~PendingPipelineBarrier() = default;
   MBASE_DISALLOW_COPY_MOVE(PendingPipelineBarrier);
 
@@ -73,12 +79,16 @@ public:
   );
 
   /// Emits vkCmdPipelineBarrier2KHR and clears accumulated barriers.
-  /// No-op if no barriers are pending.
-  void FlushAndClear(VkCommandBuffer command_buffer);
+  /// No-op if no barriers are pending. Returns the number of barriers emitted.
+  uint32_t FlushAndClear(VkCommandBuffer command_buffer);
 
   [[nodiscard]] bool IsEmpty() const;
 
 private:
+  /// `scope` restricted to what a queue with `queue_flags_` supports.
+  [[nodiscard]] SyncScope RestrictToQueue(SyncScope scope) const;
+
+  VkQueueFlags queue_flags_ = kUniversalQueueFlags;
   mbase::SmallVector<ImageBarrier, 4> image_barriers_;
   std::optional<GlobalBarrier> global_barrier_;
 };
@@ -0,0 +1,386 @@
+// TU header --------------------------------------------
+#include "backend-vulkan/descriptor/bindless_table.h"
+
+// c++ headers ------------------------------------------
+#include <array>
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+#include "mbase/public/log.h"
+
+#include "mnexus/public/types.h"
+
+// project headers --------------------------------------
+#include "backend-vulkan/device/vk-device.h"
+#include "backend-vulkan/device/vk-physical_device.h"
+
+namespace mnexus_backend::vulkan {
+
+namespace {
+
+constexpr VkDescriptorBindingFlagsEXT kBindingFlags =
+  VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+  VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+  VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+} // namespace
+
+// ----------------------------------------------------------------------------------------------------
+// BindlessTable::SlotAllocator
+//
+
+uint32_t BindlessTable::SlotAllocator::Allocate() {
+  uint32_t index = mnexus::kInvalidBindlessIndex;
+  if (!free_indices.empty()) {
+    index = free_indices.back();
+    free_indices.pop_back();
+  } else if (next < capacity) {
+    index = next++;
+    occupied.push_back(false);
+  } else {
+    return mnexus::kInvalidBindlessIndex;
+  }
+  occupied[index] = true;
+  return index;
+}
+
+bool BindlessTable::SlotAllocator::Retire(uint32_t index, RetirePoint const& retire_point) {
+  if (index >= next || !occupied[index]) {
+    return false;
+  }
+  occupied[index] = false;
+  retired.push_back(RetiredSlot { .index = index, .retire_point = retire_point });
+  return true;
+}
+
+void BindlessTable::SlotAllocator::Reclaim(RetirePoint const& completed) {
+  while (!retired.empty()) {
+    RetirePoint const& retire_point = retired.front().retire_point;
+    for (uint32_t i = 0; i < kMaxQueues; ++i) {
+      if (completed.serials[i] < retire_point.serials[i]) {
+        return;
+      }
+    }
+    free_indices.push_back(retired.front().index);
+    retired.pop_front();
+  }
+}
+
+// ----------------------------------------------------------------------------------------------------
+// BindlessTable
+//
+
+bool BindlessTable::IsSupported(PhysicalDeviceDesc const& physical_device_desc) {
+  if (!physical_device_desc.descriptor_indexing_desc().has_value()) {
+    return false;
+  }
+
+  VkPhysicalDeviceDescriptorIndexingFeaturesEXT const& features =
+    physical_device_desc.descriptor_indexing_desc()->features;
+  VkPhysicalDeviceDescriptorIndexingPropertiesEXT const& properties =
+    physical_device_desc.descriptor_indexing_desc()->properties;
+
+  // Samplers are covered by the sampled image update-after-bind feature.
+  bool const has_features =
+    features.runtimeDescriptorArray &&
+    features.descriptorBindingPartiallyBound &&
+    features.descriptorBindingUpdateUnusedWhilePending &&
+    features.descriptorBindingSampledImageUpdateAfterBind &&
+    features.descriptorBindingStorageBufferUpdateAfterBind;
+
+  // The layout is visible to all stages, so the per-stage limits apply to the full table.
+  bool const has_limits =
+    properties.maxPerStageDescriptorUpdateAfterBindSampledImages >= mnexus::kMaxBindlessSampledTextures &&
+    properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers >= mnexus::kMaxBindlessStorageBuffers &&
+    properties.maxPerStageDescriptorUpdateAfterBindSamplers >= mnexus::kMaxBindlessSamplers &&
+    properties.maxDescriptorSetUpdateAfterBindSampledImages >= mnexus::kMaxBindlessSampledTextures &&
+    properties.maxDescriptorSetUpdateAfterBindStorageBuffers >= mnexus::kMaxBindlessStorageBuffers &&
+    properties.maxDescriptorSetUpdateAfterBindSamplers >= mnexus::kMaxBindlessSamplers &&
+    properties.maxUpdateAfterBindDescriptorsInAllPools >=
+      mnexus::kMaxBindlessSampledTextures + mnexus::kMaxBindlessStorageBuffers + mnexus::kMaxBindlessSamplers;
+
+  return has_features && has_limits;
+}
+
+std::unique_ptr<BindlessTable> BindlessTable::Create(IVulkanDevice& device) {
+  MBASE_ASSERT(device.IsExtensionEnabled(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME));
+
+  VkDevice const vk_device = device.handle();
+
+  std::array<VkDescriptorSetLayoutBinding, 3> const bindings {
+    VkDescriptorSetLayoutBinding {
+      .binding = mnexus::kBindlessSampledTextureBinding,
+      .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+      .descriptorCount = mnexus::kMaxBindlessSampledTextures,
+      .stageFlags = VK_SHADER_STAGE_ALL,
+      .pImmutableSamplers = nullptr,
+    },
+    VkDescriptorSetLayoutBinding {
+      .binding = mnexus::kBindlessStorageBufferBinding,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .descriptorCount = mnexus::kMaxBindlessStorageBuffers,
+      .stageFlags = VK_SHADER_STAGE_ALL,
+      .pImmutableSamplers = nullptr,
+    },
+    VkDescriptorSetLayoutBinding {
+      .binding = mnexus::kBindlessSamplerBinding,
+      .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+      .descriptorCount = mnexus::kMaxBindlessSamplers,
+      .stageFlags = VK_SHADER_STAGE_ALL,
+      .pImmutableSamplers = nullptr,
+    },
+  };
+  std::array<VkDescriptorBindingFlagsEXT, 3> const binding_flags { kBindingFlags, kBindingFlags, kBindingFlags };
+
+  VkDescriptorSetLayoutBindingFlagsCreateInfoEXT const binding_flags_info {
+    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT,
+    .pNext = nullptr,
+    .bindingCount = static_cast<uint32_t>(binding_flags.size()),
+    .pBindingFlags = binding_flags.data(),
+  };
+  VkDescriptorSetLayoutCreateInfo const layout_info {
+    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+    .pNext = &binding_flags_info,
+    .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT,
+    .bindingCount = static_cast<uint32_t>(bindings.size()),
+    .pBindings = bindings.data(),
+  };
+
+  VkDescriptorSetLayout vk_layout = VK_NULL_HANDLE;
+  VkResult result = vkCreateDescriptorSetLayout(vk_device, &layout_info, nullptr, &vk_layout);
+  if (result != VK_SUCCESS) {
+    MBASE_LOG_ERROR("vkCreateDescriptorSetLayout failed for the bindless table: {}", string_VkResult(result));
+    return nullptr;
+  }
+
+  std::array<VkDescriptorPoolSize, 3> const pool_sizes {
+    VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, mnexus::kMaxBindlessSampledTextures },
+    VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mnexus::kMaxBindlessStorageBuffers },
+    VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLER, mnexus::kMaxBindlessSamplers },
+  };
+  VkDescriptorPoolCreateInfo const pool_info {
+    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+    .pNext = nullptr,
+    .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT,
+    .maxSets = 1,
+    .poolSizeCount = static_cast<uint32_t>(pool_sizes.size()),
+    .pPoolSizes = pool_sizes.data(),
+  };
+
+  VkDescriptorPool vk_pool = VK_NULL_HANDLE;
+  result = vkCreateDescriptorPool(vk_device, &pool_info, nullptr, &vk_pool);
+  if (result != VK_SUCCESS) {
+    MBASE_LOG_ERROR("vkCreateDescriptorPool failed for the bindless table: {}", string_VkResult(result));
+    vkDestroyDescriptorSetLayout(vk_device, vk_layout, nullptr);
+    return nullptr;
+  }
+
+  VkDescriptorSetAllocateInfo const alloc_info {
+    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+    .pNext = nullptr,
+    .descriptorPool = vk_pool,
+    .descriptorSetCount = 1,
+    .pSetLayouts = &vk_layout,
+  };
+
+  VkDescriptorSet vk_set = VK_NULL_HANDLE;
+  result = vkAllocateDescriptorSets(vk_device, &alloc_info, &vk_set);
+  if (result != VK_SUCCESS) {
+    MBASE_LOG_ERROR("vkAllocateDescriptorSets failed for the bindless table: {}", string_VkResult(result));
+    vkDestroyDescriptorPool(vk_device, vk_pool, nullptr);
+    vkDestroyDescriptorSetLayout(vk_device, vk_layout, nullptr);
+    return nullptr;
+  }
+
+  return std::unique_ptr<BindlessTable>(new BindlessTable(device, vk_layout, vk_pool, vk_set));
+}
+
+BindlessTable::BindlessTable(
+  IVulkanDevice& device,
+  VkDescriptorSetLayout vk_descriptor_set_layout,
+  VkDescriptorPool vk_descriptor_pool,
+  VkDescriptorSet vk_descriptor_set
+) :
+  device_(device),
+  vk_descriptor_set_layout_(vk_descriptor_set_layout),
+  vk_descriptor_pool_(vk_descriptor_pool),
+  vk_descriptor_set_(vk_descriptor_set)
+{
+  sampled_images_.capacity = mnexus::kMaxBindlessSampledTextures;
+  storage_buffers_.capacity = mnexus::kMaxBindlessStorageBuffers;
+  samplers_.capacity = mnexus::kMaxBindlessSamplers;
+}
+
+BindlessTable::~BindlessTable() {
+  // Image views go through the deferred destroyer, which the device drains on shutdown.
+  image_views_.clear();
+
+  // The set is freed with its pool.
+  VkDevice const vk_device = device_.handle();
+  vkDestroyDescriptorPool(vk_device, vk_descriptor_pool_, nullptr);
+  vkDestroyDescriptorSetLayout(vk_device, vk_descriptor_set_layout_, nullptr);
+}
+
+uint32_t BindlessTable::RegisterSampledImage(VulkanImageView image_view, VkImageLayout image_layout) {
+  mbase::LockGuard lock(mutex_);
+
+  uint32_t const index = this->AllocateSlot(sampled_images_);
+  if (index == mnexus::kInvalidBindlessIndex) {
+    MBASE_LOG_ERROR("Bindless table is full: {} sampled textures", mnexus::kMaxBindlessSampledTextures);
+    return mnexus::kInvalidBindlessIndex;
+  }
+
+  VkDescriptorImageInfo const image_info {
+    .sampler = VK_NULL_HANDLE,
+    .imageView = image_view.handle(),
+    .imageLayout = image_layout,
+  };
+  this->WriteDescriptor(
+    VkWriteDescriptorSet {
+      .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+      .pNext = nullptr,
+      .dstSet = vk_descriptor_set_,
+      .dstBinding = mnexus::kBindlessSampledTextureBinding,
+      .dstArrayElement = index,
+      .descriptorCount = 1,
+      .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+      .pImageInfo = &image_info,
+      .pBufferInfo = nullptr,
+      .pTexelBufferView = nullptr,
+    }
+  );
+
+  if (image_views_.size() <= index) {
+    image_views_.resize(index + 1);
+  }
+  image_views_[index] = std::move(image_view);
+  return index;
+}
+
+uint32_t BindlessTable::RegisterStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+  mbase::LockGuard lock(mutex_);
+
+  uint32_t const index = this->AllocateSlot(storage_buffers_);
+  if (index == mnexus::kInvalidBindlessIndex) {
+    MBASE_LOG_ERROR("Bindless table is full: {} storage buffers", mnexus::kMaxBindlessStorageBuffers);
+    return mnexus::kInvalidBindlessIndex;
+  }
+
+  VkDescriptorBufferInfo const buffer_info {
+    .buffer = buffer,
+    .offset = offset,
+    .range = range,
+  };
+  this->WriteDescriptor(
+    VkWriteDescriptorSet {
+      .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+      .pNext = nullptr,
+      .dstSet = vk_descriptor_set_,
+      .dstBinding = mnexus::kBindlessStorageBufferBinding,
+      .dstArrayElement = index,
+      .descriptorCount = 1,
+      .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+      .pImageInfo = nullptr,
+      .pBufferInfo = &buffer_info,
+      .pTexelBufferView = nullptr,
+    }
+  );
+  return index;
+}
+
+uint32_t BindlessTable::RegisterSampler(VkSampler sampler) {
+  mbase::LockGuard lock(mutex_);
+
+  uint32_t const index = this->AllocateSlot(samplers_);
+  if (index == mnexus::kInvalidBindlessIndex) {
+    MBASE_LOG_ERROR("Bindless table is full: {} samplers", mnexus::kMaxBindlessSamplers);
+    return mnexus::kInvalidBindlessIndex;
+  }
+
+  VkDescriptorImageInfo const image_info {
+    .sampler = sampler,
+    .imageView = VK_NULL_HANDLE,
+    .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+  };
+  this->WriteDescriptor(
+    VkWriteDescriptorSet {
+      .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+      .pNext = nullptr,
+      .dstSet = vk_descriptor_set_,
+      .dstBinding = mnexus::kBindlessSamplerBinding,
+      .dstArrayElement = index,
+      .descriptorCount = 1,
+      .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+      .pImageInfo = &image_info,
+      .pBufferInfo = nullptr,
+      .pTexelBufferView = nullptr,
+    }
+  );
+  return index;
+}
+
+// Unregistering leaves the stale descriptor in place: the bindings are `PARTIALLY_BOUND`, so a slot is only
+// validated when a shader actually reads it, and the next registration overwrites it once the slot has retired.
+
+void BindlessTable::UnregisterSampledImage(uint32_t index) {
+  mbase::LockGuard lock(mutex_);
+  RetirePoint const retire_point = this->CaptureRetirePoint();
+  if (!sampled_images_.Retire(index, retire_point)) {
+    MBASE_LOG_ERROR("UnregisterBindlessSampledTexture: index {} is not registered", index);
+    return;
+  }
+
+  // The view's own stamp is never set by command recording, since shaders reach it through the table.
+  ResourceSyncStamp& sync_stamp = image_views_[index].sync_stamp();
+  for (uint32_t i = 0; i < kMaxQueues; ++i) {
+    if (retire_point.serials[i] != 0) {
+      sync_stamp.Stamp(i, retire_point.serials[i]);
+    }
+  }
+  image_views_[index] = VulkanImageView {};
+}
+
+void BindlessTable::UnregisterStorageBuffer(uint32_t index) {
+  mbase::LockGuard lock(mutex_);
+  RetirePoint const retire_point = this->CaptureRetirePoint();
+  if (!storage_buffers_.Retire(index, retire_point)) {
+    MBASE_LOG_ERROR("UnregisterBindlessStorageBuffer: index {} is not registered", index);
+  }
+}
+
+void BindlessTable::UnregisterSampler(uint32_t index) {
+  mbase::LockGuard lock(mutex_);
+  RetirePoint const retire_point = this->CaptureRetirePoint();
+  if (!samplers_.Retire(index, retire_point)) {
+    MBASE_LOG_ERROR("UnregisterBindlessSampler: index {} is not registered", index);
+  }
+}
+
+void BindlessTable::WriteDescriptor(VkWriteDescriptorSet const& write) {
+  vkUpdateDescriptorSets(device_.handle(), 1, &write, 0, nullptr);
+}
+
+BindlessTable::RetirePoint BindlessTable::CaptureRetirePoint() const {
+  QueueIndexMap const& queue_index_map = device_.queue_index_map();
+
+  RetirePoint retire_point;
+  for (uint32_t i = 0; i < queue_index_map.Count(); ++i) {
+    retire_point.serials[i] = device_.QueueGetLastSubmittedValue(queue_index_map.GetQueueId(i));
+  }
+  return retire_point;
+}
+
+uint32_t BindlessTable::AllocateSlot(SlotAllocator& allocator) {
+  if (allocator.free_indices.empty() && !allocator.retired.empty()) {
+    QueueIndexMap const& queue_index_map = device_.queue_index_map();
+
+    RetirePoint completed;
+    for (uint32_t i = 0; i < queue_index_map.Count(); ++i) {
+      completed.serials[i] = device_.QueueGetCompletedValue(queue_index_map.GetQueueId(i));
+    }
+    allocator.Reclaim(completed);
+  }
+  return allocator.Allocate();
+}
+
+} // namespace mnexus_backend::vulkan
@@ -0,0 +1,121 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/tsa.h"
+
+// project headers --------------------------------------
+#include "backend-vulkan/depend/vulkan.h"
+#include "backend-vulkan/object/vk-object-image_view.h"
+
+#include "sync/resource_sync.h"
+
+namespace mnexus_backend::vulkan {
+
+class IVulkanDevice;
+class PhysicalDeviceDesc;
+
+// ----------------------------------------------------------------------------------------------------
+// BindlessTable
+//
+// A single, device-wide descriptor set holding large arrays of sampled images, storage buffers and samplers
+// (`mnexus::kBindless*Binding`). Resources are registered once and addressed by index from shaders, so programs
+// that declare set `mnexus::kBindlessBindGroup` skip per-draw descriptor allocation and writes for it.
+//
+// The set is created with `UPDATE_AFTER_BIND` and `PARTIALLY_BOUND`: slots can be written while command buffers that
+// bind the set are pending, as long as those command buffers do not access the slot being written.
+//
+// Shaders index the set dynamically, so the table cannot tell which submissions read a slot. An unregistered slot is
+// therefore retired against the last serial submitted to every queue, and only reused once all of them have completed.
+// Owned image views are handed to the deferred destroyer with the same retire point.
+//
+
+class BindlessTable final {
+public:
+  /// Whether the physical device exposes the descriptor indexing features and limits the table needs.
+  [[nodiscard]] static bool IsSupported(PhysicalDeviceDesc const& physical_device_desc);
+
+  /// Returns null on failure. `VK_EXT_descriptor_indexing` **MUST** be enabled on `device`.
+  [[nodiscard]] static std::unique_ptr<BindlessTable> Create(IVulkanDevice& device);
+
+  ~BindlessTable();
+  MBASE_DISALLOW_COPY_MOVE(BindlessTable);
+
+  [[nodiscard]] VkDescriptorSetLayout descriptor_set_layout() const { return vk_descriptor_set_layout_; }
+  [[nodiscard]] VkDescriptorSet descriptor_set() const { return vk_descriptor_set_; }
+
+  /// Takes ownership of `image_view`; it is released when the slot is unregistered or the table is destroyed.
+  /// Returns `mnexus::kInvalidBindlessIndex` if the table is full.
+  uint32_t RegisterSampledImage(VulkanImageView image_view, VkImageLayout image_layout);
+  uint32_t RegisterStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+  uint32_t RegisterSampler(VkSampler sampler);
+
+  /// The index is reused once every queue has completed the work submitted before the call.
+  void UnregisterSampledImage(uint32_t index);
+  void UnregisterStorageBuffer(uint32_t index);
+  void UnregisterSampler(uint32_t index);
+
+private:
+  /// A serial per queue, by compact index: the last submitted ones when a slot is retired, the completed ones when
+  /// reclaiming.
+  struct RetirePoint final {
+    uint64_t serials[kMaxQueues] {};
+  };
+
+  struct SlotAllocator final {
+    struct RetiredSlot final {
+      uint32_t index = 0;
+      RetirePoint retire_point;
+    };
+
+    uint32_t capacity = 0;
+    uint32_t next = 0;
+    std::vector<uint32_t> free_indices;
+    std::vector<bool> occupied;
+    /// Unregistered slots not yet reusable, oldest first; retire points are non-decreasing along it.
+    std::deque<RetiredSlot> retired;
+
+    uint32_t Allocate();
+    bool Retire(uint32_t index, RetirePoint const& retire_point);
+    /// Moves the retired slots whose retire point `completed` has reached to `free_indices`.
+    void Reclaim(RetirePoint const& completed);
+  };
+
+  BindlessTable(
+    IVulkanDevice& device,
+    VkDescriptorSetLayout vk_descriptor_set_layout,
+    VkDescriptorPool vk_descriptor_pool,
+    VkDescriptorSet vk_descriptor_set
+  );
+
+  /// Caller **MUST** hold `mutex_`.
+  void WriteDescriptor(VkWriteDescriptorSet const& write);
+
+  /// Caller **MUST** hold `mutex_`, which keeps retire points in `SlotAllocator::retired` in order.
+  [[nodiscard]] RetirePoint CaptureRetirePoint() const;
+  /// Allocates from `allocator`, first reclaiming its retired slots if it has no free one left.
+  /// Caller **MUST** hold `mutex_`.
+  uint32_t AllocateSlot(SlotAllocator& allocator);
+
+  IVulkanDevice& device_;
+  VkDescriptorSetLayout vk_descriptor_set_layout_ = VK_NULL_HANDLE;
+  VkDescriptorPool vk_descriptor_pool_ = VK_NULL_HANDLE;
+  VkDescriptorSet vk_descriptor_set_ = VK_NULL_HANDLE;
+
+  // `vkUpdateDescriptorSets` requires the set to be externally synchronized, so writes share the allocator lock.
+  mbase::Lockable<std::mutex> mutex_;
+  SlotAllocator sampled_images_ MBASE_GUARDED_BY(mutex_);
+  SlotAllocator storage_buffers_ MBASE_GUARDED_BY(mutex_);
+  SlotAllocator samplers_ MBASE_GUARDED_BY(mutex_);
+  std::vector<VulkanImageView> image_views_ MBASE_GUARDED_BY(mutex_);
+};
+
+} // namespace mnexus_backend::vulkan
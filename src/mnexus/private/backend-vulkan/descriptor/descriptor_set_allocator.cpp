@@ -114,11 +114,14 @@ public:
       nullptr
     );
 
-    // Wrap in VulkanDescriptorSet with destroy_func that calls Free.
-    VkDescriptorSetLayout vk_layout = layout.handle();
+    // Wrap in VulkanDescriptorSet; the deferred destroyer returns it through Free.
     auto result = std::make_shared<VulkanDescriptorSet>(
       vk_set,
-      [this, vk_layout, vk_set] { this->FreeImpl(vk_layout, vk_set); },
+      VulkanObjectDestroyInfo {
+        .type = VulkanObjectType::kDescriptorSet,
+        .context = static_cast<IDescriptorSetAllocator*>(this),
+        .aux = VulkanHandleToU64(layout.handle()),
+      },
       device_->GetDeferredDestroyer()
     );
 
@@ -132,10 +135,10 @@ public:
   }
 
   void Free(
-    VulkanDescriptorSetLayout const& layout,
+    VkDescriptorSetLayout layout_handle,
     VkDescriptorSet set
   ) override {
-    this->FreeImpl(layout.handle(), set);
+    this->FreeImpl(layout_handle, set);
   }
 
 private:
@@ -39,10 +39,10 @@ public:
   ) = 0;
 
   /// Return a VkDescriptorSet to the free pool for reuse with new values.
-  /// Called by VulkanDescriptorSet's destroy_func via deferred destruction
+  /// Called when the deferred destroyer retires a VulkanDescriptorSet
   /// (GPU has already completed by the time this is called).
   virtual void Free(
-    VulkanDescriptorSetLayout const& layout,
+    VkDescriptorSetLayout layout_handle,
     VkDescriptorSet set
   ) = 0;
 };
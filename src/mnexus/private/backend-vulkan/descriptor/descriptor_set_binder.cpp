@@ -94,6 +94,14 @@ void DescriptorSetBinder::SetBuffer(
     return;
   }
 
+  if (set < current_descriptor_set_count_ && current_descriptor_set_layouts_[set].bindless) {
+    MBASE_LOG_ERROR(
+      "DescriptorSetBinder: set {} is the bindless table; register the buffer instead. SetBuffer(({}, {}, {}), {})",
+      set, set, binding, array_element, handle_id
+    );
+    return;
+  }
+
   set_explicit_flag_[set] = false;
 
   DescriptorSetWriteDesc::ReallocationNeeded const reallocation_needed =
@@ -101,16 +109,17 @@ void DescriptorSetBinder::SetBuffer(
   set_reallocation_needed_[set] = set_reallocation_needed_[set] || reallocation_needed.value;
 }
 
-void DescriptorSetBinder::CmdBindDescriptorSets(
+uint32_t DescriptorSetBinder::CmdBindDescriptorSets(
   VkCommandBuffer command_buffer,
   VkPipelineBindPoint bind_point,
   VkDevice device,
   IDescriptorSetAllocator* ds_allocator
 ) {
   if (set_reallocation_needed_.none() && set_rebinding_needed_.none()) {
-    return;
+    return 0;
   }
 
+  uint32_t allocated_set_count = 0;
   uint32_t first_set_to_rebind = std::numeric_limits<uint32_t>::max();
   uint32_t inclusive_last_set_to_rebind = 0;
   uint32_t sets_to_rebind_count = 0;
@@ -121,6 +130,21 @@ void DescriptorSetBinder::CmdBindDescriptorSets(
   for (uint32_t set_index = 0; set_index < current_descriptor_set_count_; ++set_index) {
     DescriptorSetWriteDesc& set_write_desc = set_write_descs_[set_index];
 
+    if (current_descriptor_set_layouts_[set_index].bindless) {
+      // The table's set never changes; only a layout change requires binding it again.
+      if (set_reallocation_needed_[set_index] || set_rebinding_needed_[set_index]) {
+        first_set_to_rebind = std::min(first_set_to_rebind, set_index);
+        inclusive_last_set_to_rebind = std::max(inclusive_last_set_to_rebind, set_index);
+        ++sets_to_rebind_count;
+
+        vk_descriptor_sets[set_index] = bindless_descriptor_set_;
+      }
+
+      set_reallocation_needed_[set_index] = false;
+      set_rebinding_needed_[set_index] = false;
+      continue;
+    }
+
     if (set_write_desc.GetDescriptorCount() == 0) {
       // Mark for non-use.
       vk_descriptor_sets[set_index] = VK_NULL_HANDLE;
@@ -132,6 +156,7 @@ void DescriptorSetBinder::CmdBindDescriptorSets(
 
       VulkanDescriptorSetLayout const& dsl = current_descriptor_set_layouts_[set_index];
       VulkanDescriptorSetPtr new_set = ds_allocator->Allocate(device, dsl, set_write_desc);
+      ++allocated_set_count;
 
       if (new_set) {
         bound_descriptor_sets_[set_index] = std::move(new_set);
@@ -163,7 +188,7 @@ void DescriptorSetBinder::CmdBindDescriptorSets(
   }
 
   if (sets_to_rebind_count == 0) {
-    return;
+    return allocated_set_count;
   }
 
   if (inclusive_last_set_to_rebind - first_set_to_rebind == sets_to_rebind_count - 1) {
@@ -200,6 +225,8 @@ void DescriptorSetBinder::CmdBindDescriptorSets(
       first_dynamic_offset_index += dynamic_descriptor_count;
     }
   }
+
+  return allocated_set_count;
 }
 
 } // namespace mnexus_backend::vulkan
@@ -24,6 +24,7 @@ class VulkanDescriptorSetLayout;
 //
 // Tracks per-set descriptor binding state with dirty flags.
 // On dispatch/draw, resolves dirty sets via IDescriptorSetAllocator hash-and-cache.
+// Sets whose layout is marked `bindless` are not resolved: the bindless table's set is bound as is.
 //
 
 class DescriptorSetBinder final {
@@ -39,6 +40,11 @@ public:
     uint32_t descriptor_set_count
   );
 
+  /// Set the descriptor set bound at every set whose layout is marked `bindless`.
+  void SetBindlessDescriptorSet(VkDescriptorSet bindless_descriptor_set) {
+    bindless_descriptor_set_ = bindless_descriptor_set;
+  }
+
   /// Set a buffer binding (uniform or storage).
   void SetBuffer(
     uint32_t set, uint32_t binding, uint32_t array_element,
@@ -48,7 +54,8 @@ public:
   );
 
   /// Resolve dirty sets and emit vkCmdBindDescriptorSets.
-  void CmdBindDescriptorSets(
+  /// Returns the number of sets resolved through `ds_allocator`.
+  uint32_t CmdBindDescriptorSets(
     VkCommandBuffer command_buffer,
     VkPipelineBindPoint bind_point,
     VkDevice device,
@@ -67,6 +74,7 @@ private:
   std::bitset<kMaxSets> set_reallocation_needed_; // Content changed -> need new descriptor set.
   std::bitset<kMaxSets> set_rebinding_needed_;    // Layout changed -> need vkCmdBindDescriptorSets.
   std::array<VulkanDescriptorSetPtr, kMaxSets> bound_descriptor_sets_;
+  VkDescriptorSet bindless_descriptor_set_ = VK_NULL_HANDLE;
 };
 
 } // namespace mnexus_backend::vulkan
@@ -1,6 +1,11 @@
 // TU header --------------------------------------------
 #include "backend-vulkan/device/thread_command_pool.h"
 
+// c++ headers ------------------------------------------
+#include <algorithm>
+#include <optional>
+#include <span>
+
 // public project headers -------------------------------
 #include "mbase/public/assert.h"
 #include "mbase/public/log.h"
@@ -10,13 +15,73 @@
 
 namespace mnexus_backend::vulkan {
 
+// ----------------------------------------------------------------------------------------------------
+// ThreadCommandPool
+//
+// One VkCommandPool owned by a single thread. Only `outstanding` and `retire_serials` are written by other threads
+// (from `FreeCommandBuffer`).
+//
+
+struct ThreadCommandPool final {
+  VkCommandPool vk_command_pool = VK_NULL_HANDLE;
+  /// Every buffer allocated from the pool; the first `used_count` have been handed out since the last reset.
+  std::vector<VkCommandBuffer> command_buffers;
+  uint32_t used_count = 0;
+
+  /// Buffers handed out and not yet returned.
+  std::atomic<uint32_t> outstanding = 0;
+  /// Highest serial a buffer of this pool was submitted with, per compact queue index.
+  std::atomic<uint64_t> retire_serials[kMaxQueues] {};
+};
+
+/// The pools of one thread for one queue family.
+struct ThreadCommandPoolRegistry::FamilyPools final {
+  std::vector<std::unique_ptr<ThreadCommandPool>> pools;
+
+  ThreadCommandPool* current = nullptr;
+  uint64_t current_epoch = 0;
+  /// Sealed pools waiting for their buffers to be returned and retired.
+  std::vector<ThreadCommandPool*> sealed;
+  /// Reset pools ready to become `current`.
+  std::vector<ThreadCommandPool*> available;
+};
+
+struct ThreadCommandPoolRegistry::ThreadState final {
+  /// Indexed like `ThreadCommandPoolRegistry::queue_family_indices_`.
+  std::vector<FamilyPools> families;
+};
+
+namespace {
+
+std::atomic<uint64_t> g_next_registry_id = 1;
+
+struct ThreadStateCache {
+  ThreadCommandPoolRegistry const* registry = nullptr;
+  uint64_t registry_id = 0;
+  void* state = nullptr;
+};
+
+thread_local ThreadStateCache t_thread_state_cache;
+
+void StoreMax(std::atomic<uint64_t>& target, uint64_t value) {
+  uint64_t current = target.load(std::memory_order_relaxed);
+  while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+} // namespace
+
 ThreadCommandPoolRegistry::~ThreadCommandPoolRegistry() {
   this->Shutdown();
 }
 
-void ThreadCommandPoolRegistry::Initialize(IVulkanDevice* device, uint32_t queue_family_index) {
+void ThreadCommandPoolRegistry::Initialize(IVulkanDevice* device) {
+  MBASE_ASSERT(device->queue_index_map().Count() <= kMaxQueues);
+
   device_ = device;
-  queue_family_index_ = queue_family_index;
+  std::span<uint32_t const> const queue_family_indices = device->queue_family_indices();
+  queue_family_indices_.assign(queue_family_indices.begin(), queue_family_indices.end());
+  registry_id_ = g_next_registry_id.fetch_add(1, std::memory_order_relaxed);
 }
 
 void ThreadCommandPoolRegistry::Shutdown() {
@@ -24,31 +89,95 @@ void ThreadCommandPoolRegistry::Shutdown() {
     return;
   }
 
-  for (auto& [thread_id, pool] : pools_) {
-    if (pool.vk_command_pool != VK_NULL_HANDLE) {
-      vkDestroyCommandPool(device_->handle(), pool.vk_command_pool, nullptr);
+  mbase::LockGuard lock(mutex_);
+  for (auto const& [thread_id, state] : thread_states_) {
+    for (FamilyPools const& family_pools : state->families) {
+      for (std::unique_ptr<ThreadCommandPool> const& pool : family_pools.pools) {
+        if (pool->outstanding.load(std::memory_order_acquire) != 0) {
+          MBASE_LOG_WARN("Destroying a command pool with {} command buffer(s) still in use", pool->outstanding.load());
+        }
+        // Destroying the pool frees its command buffers.
+        vkDestroyCommandPool(device_->handle(), pool->vk_command_pool, nullptr);
+      }
     }
   }
-  pools_.clear();
+  thread_states_.clear();
+  queue_family_indices_.clear();
+  registry_id_ = 0;
   device_ = nullptr;
 }
 
-ThreadCommandPoolRegistry::PerThreadPool& ThreadCommandPoolRegistry::GetOrCreatePool() {
-  std::thread::id const tid = std::this_thread::get_id();
+ThreadCommandPoolRegistry::ThreadState& ThreadCommandPoolRegistry::GetThreadState() {
+  ThreadStateCache& cache = t_thread_state_cache;
+  if (cache.registry == this && cache.registry_id == registry_id_) {
+    return *static_cast<ThreadState*>(cache.state);
+  }
 
-  mbase::LockGuard lock(mutex_);
+  // First allocation of this thread on this registry, or the cache was last filled for another registry.
+  ThreadState* state = nullptr;
+  {
+    mbase::LockGuard lock(mutex_);
+    std::unique_ptr<ThreadState>& entry = thread_states_[std::this_thread::get_id()];
+    if (entry == nullptr) {
+      entry = std::make_unique<ThreadState>();
+      entry->families.resize(queue_family_indices_.size());
+    }
+    state = entry.get();
+  }
 
-  auto it = pools_.find(tid);
-  if (it != pools_.end()) {
-    return it->second;
+  cache = ThreadStateCache {
+    .registry = this,
+    .registry_id = registry_id_,
+    .state = state,
+  };
+  return *state;
+}
+
+bool ThreadCommandPoolRegistry::IsPoolRetired(ThreadCommandPool const& pool) const {
+  // acquire: pairs with the release decrement in FreeCommandBuffer(), making the serials stored before it visible.
+  if (pool.outstanding.load(std::memory_order_acquire) != 0) {
+    return false;
+  }
+
+  QueueIndexMap const& queue_index_map = device_->queue_index_map();
+  for (uint32_t i = 0; i < queue_index_map.Count(); ++i) {
+    uint64_t const serial = pool.retire_serials[i].load(std::memory_order_relaxed);
+    if (serial != 0 && device_->QueueGetCompletedValue(queue_index_map.GetQueueId(i)) < serial) {
+      return false;
+    }
+  }
+  return true;
+}
+
+ThreadCommandPool* ThreadCommandPoolRegistry::AcquirePool(FamilyPools& family_pools, uint32_t queue_family_index) {
+  // Reset every sealed pool whose buffers have all retired.
+  auto const retired_begin = std::partition(
+    family_pools.sealed.begin(), family_pools.sealed.end(),
+    [this](ThreadCommandPool const* pool) { return !this->IsPoolRetired(*pool); }
+  );
+  for (auto it = retired_begin; it != family_pools.sealed.end(); ++it) {
+    ThreadCommandPool* pool = *it;
+    vkResetCommandPool(device_->handle(), pool->vk_command_pool, 0);
+    pool->used_count = 0;
+    for (std::atomic<uint64_t>& serial : pool->retire_serials) {
+      serial.store(0, std::memory_order_relaxed);
+    }
+    family_pools.available.push_back(pool);
+  }
+  family_pools.sealed.erase(retired_begin, family_pools.sealed.end());
+
+  if (!family_pools.available.empty()) {
+    ThreadCommandPool* pool = family_pools.available.back();
+    family_pools.available.pop_back();
+    return pool;
   }
 
-  // Create a new command pool for this thread.
-  VkCommandPoolCreateInfo pool_info {
+  // Buffers are only ever reset together with their pool.
+  VkCommandPoolCreateInfo const pool_info {
     .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
     .pNext = nullptr,
-    .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
-    .queueFamilyIndex = queue_family_index_,
+    .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+    .queueFamilyIndex = queue_family_index,
   };
 
   VkCommandPool vk_pool = VK_NULL_HANDLE;
@@ -57,31 +186,37 @@ ThreadCommandPoolRegistry::PerThreadPool& ThreadCommandPoolRegistry::GetOrCreate
     MBASE_LOG_ERROR("vkCreateCommandPool failed: {}", string_VkResult(result));
   }
 
-  auto [inserted_it, _] = pools_.emplace(tid, PerThreadPool { .vk_command_pool = vk_pool });
-  return inserted_it->second;
+  ThreadCommandPool* pool = family_pools.pools.emplace_back(std::make_unique<ThreadCommandPool>()).get();
+  pool->vk_command_pool = vk_pool;
+  return pool;
 }
 
-VkCommandBuffer ThreadCommandPoolRegistry::AllocateCommandBuffer() {
-  PerThreadPool& pool = this->GetOrCreatePool();
+ThreadCommandBuffer ThreadCommandPoolRegistry::AllocateCommandBuffer(uint32_t queue_family_index) {
+  auto const family_it = std::ranges::find(queue_family_indices_, queue_family_index);
+  MBASE_ASSERT_MSG(family_it != queue_family_indices_.end(), "No queue was created in queue family {}", queue_family_index);
 
-  VkCommandBuffer cmd = VK_NULL_HANDLE;
+  ThreadState& state = this->GetThreadState();
+  FamilyPools& family_pools = state.families[static_cast<size_t>(family_it - queue_family_indices_.begin())];
 
-  // Try to reclaim a completed pending command buffer.
-  for (size_t i = 0; i < pool.pending.size(); ++i) {
-    PendingEntry& entry = pool.pending[i];
-    // serial == 0 means immediately reusable (discarded, never submitted).
-    bool const reusable = (entry.serial == 0)
-      || (device_->QueueGetCompletedValue(entry.queue_id) >= entry.serial);
-    if (reusable) {
-      cmd = entry.command_buffer;
-      pool.pending.erase(pool.pending.begin() + static_cast<ptrdiff_t>(i));
-      vkResetCommandBuffer(cmd, 0);
-      break;
-    }
+  uint64_t const epoch = frame_epoch_.load(std::memory_order_relaxed);
+  if (family_pools.current != nullptr &&
+    (family_pools.current_epoch != epoch || family_pools.current->used_count == kCommandBuffersPerPool)) {
+    family_pools.sealed.push_back(family_pools.current);
+    family_pools.current = nullptr;
+  }
+  if (family_pools.current == nullptr) {
+    family_pools.current = this->AcquirePool(family_pools, queue_family_index);
+    family_pools.current_epoch = epoch;
   }
 
-  if (cmd == VK_NULL_HANDLE) {
-    VkCommandBufferAllocateInfo alloc_info {
+  ThreadCommandPool& pool = *family_pools.current;
+
+  VkCommandBuffer cmd = VK_NULL_HANDLE;
+  if (pool.used_count < pool.command_buffers.size()) {
+    // Reset together with the pool.
+    cmd = pool.command_buffers[pool.used_count];
+  } else {
+    VkCommandBufferAllocateInfo const alloc_info {
       .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
       .pNext = nullptr,
       .commandPool = pool.vk_command_pool,
@@ -89,7 +224,10 @@ VkCommandBuffer ThreadCommandPoolRegistry::AllocateCommandBuffer() {
       .commandBufferCount = 1,
     };
     vkAllocateCommandBuffers(device_->handle(), &alloc_info, &cmd);
+    pool.command_buffers.push_back(cmd);
   }
+  ++pool.used_count;
+  pool.outstanding.fetch_add(1, std::memory_order_relaxed);
 
   VkCommandBufferBeginInfo begin_info {
     .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
@@ -99,22 +237,31 @@ VkCommandBuffer ThreadCommandPoolRegistry::AllocateCommandBuffer() {
   };
   vkBeginCommandBuffer(cmd, &begin_info);
 
-  return cmd;
+  return ThreadCommandBuffer {
+    .vk_command_buffer = cmd,
+    .pool = &pool,
+    .queue_family_index = queue_family_index,
+  };
 }
 
 void ThreadCommandPoolRegistry::FreeCommandBuffer(
-  VkCommandBuffer cmd,
+  ThreadCommandBuffer const& command_buffer,
   mnexus::QueueId const& queue_id,
   uint64_t serial
 ) {
-  PerThreadPool& pool = this->GetOrCreatePool();
-  pool.pending.emplace_back(
-    PendingEntry {
-      .command_buffer = cmd,
-      .queue_id = queue_id,
-      .serial = serial,
-    }
-  );
+  ThreadCommandPool* pool = command_buffer.pool;
+  MBASE_ASSERT(pool != nullptr);
+
+  // serial == 0: discarded, never submitted.
+  if (serial != 0) {
+    std::optional<uint32_t> const queue_index = device_->queue_index_map().Find(queue_id);
+    MBASE_ASSERT_MSG(queue_index.has_value(), "Unknown QueueId ({}, {})", queue_id.queue_family_index, queue_id.queue_index);
+    StoreMax(pool->retire_serials[*queue_index], serial);
+  }
+
+  // release: publishes the serial above to the owning thread's IsPoolRetired().
+  [[maybe_unused]] uint32_t const previous = pool->outstanding.fetch_sub(1, std::memory_order_release);
+  MBASE_ASSERT(previous != 0);
 }
 
 } // namespace mnexus_backend::vulkan
@@ -1,6 +1,8 @@
 #pragma once
 
 // c++ headers ------------------------------------------
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
@@ -14,9 +16,26 @@
 // project headers --------------------------------------
 #include "backend-vulkan/depend/vulkan.h"
 
+#include "sync/resource_sync.h"
+
 namespace mnexus_backend::vulkan {
 
 class IVulkanDevice;
+struct ThreadCommandPool;
+
+// ----------------------------------------------------------------------------------------------------
+// ThreadCommandBuffer
+//
+// A command buffer handed out by `ThreadCommandPoolRegistry`, tagged with the pool that owns it so it can be
+// returned from any thread.
+//
+
+struct ThreadCommandBuffer final {
+  VkCommandBuffer vk_command_buffer = VK_NULL_HANDLE;
+  ThreadCommandPool* pool = nullptr;
+  /// The queue family the buffer was allocated for. It **MUST** only be submitted to queues of this family.
+  uint32_t queue_family_index = 0;
+};
 
 // ----------------------------------------------------------------------------------------------------
 // ThreadCommandPoolRegistry
@@ -25,41 +44,59 @@ class IVulkanDevice;
 // Ensures that command buffers from the same VkCommandPool are only used
 // by the thread that created them (Vulkan external synchronization requirement).
 //
+// Pools are kept per queue family, since a command buffer may only be submitted to queues of its pool's family.
+// Each thread allocates from its current pool of a family until the frame advances (`AdvanceFrame`) or the pool has
+// handed out `kCommandBuffersPerPool` buffers. The pool is then sealed, and reset as a whole with `vkResetCommandPool`
+// once every buffer has been returned and the GPU has completed the serials they were submitted with. The calling
+// thread's pools are found through a single-entry thread-local cache, so allocation takes no lock while a thread keeps
+// using the same registry; a thread that alternates between registries looks its state up under the lock.
+//
+// Thread states are keyed by `std::thread::id` and are not reclaimed when their thread exits; they are destroyed in
+// `Shutdown`. A later thread that is given the id of an exited one adopts its pools, which is safe since the exited
+// thread no longer records into them.
+//
 
 class ThreadCommandPoolRegistry final {
 public:
+  static constexpr uint32_t kCommandBuffersPerPool = 32;
+
   ThreadCommandPoolRegistry() = default;
   ~ThreadCommandPoolRegistry();
   MBASE_DISALLOW_COPY_MOVE(ThreadCommandPoolRegistry);
 
-  void Initialize(IVulkanDevice* device, uint32_t queue_family_index);
+  /// Creates pools for every queue family the device created queues in.
+  void Initialize(IVulkanDevice* device);
   void Shutdown();
 
   /// Allocate and begin a VkCommandBuffer for the calling thread.
-  VkCommandBuffer AllocateCommandBuffer();
+  ///
+  /// - `queue_family_index`: **MUST** be one of `IVulkanDevice::queue_family_indices()`.
+  ThreadCommandBuffer AllocateCommandBuffer(uint32_t queue_family_index);
 
-  /// Free a command buffer after submission (with queue_id + serial for deferred reuse)
-  /// or after discard (serial = 0 for immediate reuse).
-  void FreeCommandBuffer(VkCommandBuffer cmd, mnexus::QueueId const& queue_id, uint64_t serial);
+  /// Return a command buffer after submission (with queue_id + serial for deferred reuse)
+  /// or after discard (serial = 0). May be called from any thread.
+  void FreeCommandBuffer(ThreadCommandBuffer const& command_buffer, mnexus::QueueId const& queue_id, uint64_t serial);
 
-private:
-  struct PendingEntry {
-    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
-    mnexus::QueueId queue_id;
-    uint64_t serial = 0;
-  };
+  /// Seals every thread's current pool at its next allocation. Called once per presented frame.
+  void AdvanceFrame() { frame_epoch_.fetch_add(1, std::memory_order_relaxed); }
 
-  struct PerThreadPool {
-    VkCommandPool vk_command_pool = VK_NULL_HANDLE;
-    std::vector<PendingEntry> pending;
-  };
+private:
+  struct FamilyPools;
+  struct ThreadState;
 
-  PerThreadPool& GetOrCreatePool();
+  ThreadState& GetThreadState();
+  ThreadCommandPool* AcquirePool(FamilyPools& family_pools, uint32_t queue_family_index);
+  [[nodiscard]] bool IsPoolRetired(ThreadCommandPool const& pool) const;
 
   IVulkanDevice* device_ = nullptr;
-  uint32_t queue_family_index_ = 0;
+  /// Queue families with pools, ascending. `ThreadState::families` is indexed alike.
+  std::vector<uint32_t> queue_family_indices_;
+  /// Distinguishes this registry from a previous one at the same address in the thread-local cache.
+  uint64_t registry_id_ = 0;
+  std::atomic<uint64_t> frame_epoch_ = 0;
+
   mbase::Lockable<std::mutex> mutex_;
-  std::unordered_map<std::thread::id, PerThreadPool> pools_ MBASE_GUARDED_BY(mutex_);
+  std::unordered_map<std::thread::id, std::unique_ptr<ThreadState>> thread_states_ MBASE_GUARDED_BY(mutex_);
 };
 
 } // namespace mnexus_backend::vulkan
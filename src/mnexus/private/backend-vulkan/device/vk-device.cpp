@@ -4,9 +4,11 @@
 // c++ headers ------------------------------------------
 #include <algorithm>
 #include <atomic>
-#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <string_view>
 #include <vector>
 
 // public project headers -------------------------------
@@ -14,10 +16,13 @@
 #include "mbase/public/log.h"
 
 // project headers --------------------------------------
+#include "sync/queue_completion.h"
 #include "sync/resource_sync.h"
 
 #include "backend-vulkan/depend/vulkan_vma.h"
+#include "backend-vulkan/descriptor/descriptor_set_allocator.h"
 #include "backend-vulkan/object/vk-deferred_destroyer.h"
+#include "backend-vulkan/resource/placed_buffer_allocator.h"
 #include "backend-vulkan/device/vk-physical_device.h"
 #include "backend-vulkan/device/vk-staging.h"
 #include "backend-vulkan/device/thread_command_pool.h"
@@ -46,16 +51,19 @@ public:
   PhysicalDeviceDesc const& physical_device_desc() const override { return *physical_device_desc_; }
   VkDevice handle() const override { return handle_; }
   mnexus::QueueSelection const& queue_selection() const override { return queue_selection_; }
+  std::span<uint32_t const> queue_family_indices() const override { return queue_family_indices_; }
   VmaAllocator vma_allocator() const override { return vma_allocator_; }
 
   bool IsExtensionEnabled(char const* extension_name) const override {
-    return false;
+    return std::ranges::find(enabled_extensions_, std::string_view(extension_name)) != enabled_extensions_.end();
   }
 
   IVulkanDeferredDestroyer* GetDeferredDestroyer() const override { return &deferred_destroyer_; }
 
   uint64_t QueueGetCompletedValue(mnexus::QueueId const& queue_id) override;
+  uint64_t QueueGetLastSubmittedValue(mnexus::QueueId const& queue_id) override;
   void QueueWaitSubmitSerial(mnexus::QueueId const& queue_id, uint64_t value) override;
+  bool QueueWaitAnySerial(mbase::ArrayProxy<uint64_t const> serials, uint64_t timeout_ns) override;
   uint64_t QueueWaitIdle(mnexus::QueueId const& queue_id) override;
   uint64_t QueueAdvanceTimeline(mnexus::QueueId const& queue_id) override;
   uint64_t QueueSubmitSingle(mnexus::QueueId const& queue_id, VkCommandBuffer command_buffer) override;
@@ -75,9 +83,10 @@ public:
   ) override;
 
   StagingBufferPool& staging_buffer_pool() override { return staging_buffer_pool_; }
-  TransientCommandPool& transient_command_pool() override { return transient_command_pool_; }
+  TransientCommandPool& transient_command_pool(mnexus::QueueId const& queue_id) override;
   ThreadCommandPoolRegistry& thread_command_pool_registry() override { return thread_command_pool_registry_; }
   QueueIndexMap const& queue_index_map() const override { return queue_index_map_; }
+  QueueCompletionNotifier& completion_notifier() override { return completion_notifier_; }
 
 private:
   friend class IVulkanDevice; // For Create() to construct.
@@ -109,38 +118,46 @@ private:
   std::unique_ptr<PhysicalDeviceDesc> physical_device_desc_;
   VkDevice handle_ = VK_NULL_HANDLE;
   mnexus::QueueSelection queue_selection_;
+  std::vector<uint32_t> queue_family_indices_;
   QueueIndexMap queue_index_map_;
   VulkanQueueState queue_states_[kMaxQueues] {};
   VmaAllocator vma_allocator_ = VK_NULL_HANDLE;
+  std::vector<std::string> enabled_extensions_;
 
   StagingBufferPool staging_buffer_pool_;
-  TransientCommandPool transient_command_pool_;
+  /// Indexed by compact queue index.
+  TransientCommandPool transient_command_pools_[kMaxQueues];
   ThreadCommandPoolRegistry thread_command_pool_registry_;
+  QueueCompletionNotifier completion_notifier_;
 
   // --- Deferred destruction (composition, not inheritance) ---
 
   class DeferredDestroyer final : public IVulkanDeferredDestroyer {
   public:
     explicit DeferredDestroyer(VulkanDevice& owner) : owner_(owner) {}
-    void EnqueueDestroy(
-      std::function<void()> destroy_func,
-      ResourceSyncStamp::Snapshot snapshot
-    ) override;
+    VulkanObjectRecord* AcquireRecord() override;
+    void EnqueueDestroy(VulkanObjectRecord* record) override;
   private:
     VulkanDevice& owner_;
   };
   mutable DeferredDestroyer deferred_destroyer_{*this};
 
   struct PendingDestroy {
-    std::function<void()> destroy_func;
+    VulkanObjectRecord* record = nullptr;
     ResourceSyncStamp::Snapshot snapshot;
   };
 
-  void EnqueuePendingDestroy(std::function<void()> destroy_func, ResourceSyncStamp::Snapshot snapshot);
+  void EnqueuePendingDestroy(VulkanObjectRecord* record, ResourceSyncStamp::Snapshot snapshot);
   void ProcessPendingDestroys();
+  /// Destroys the record's object by its type, then recycles the record.
+  void DestroyObject(VulkanObjectRecord* record);
 
   mbase::Lockable<std::mutex> pending_destroys_mutex_;
   std::vector<PendingDestroy> pending_destroys_ MBASE_GUARDED_BY(pending_destroys_mutex_);
+
+  // Object records; grown a chunk at a time and never shrunk. Every object creation and destruction goes through
+  // it, from any thread, so its free list is lock-free.
+  ConcurrentSlab<VulkanObjectRecord> object_records_;
 };
 
 #define RESOLVE_QUEUE_INDEX(var_name, queue_id) \
@@ -410,8 +427,34 @@ std::vector<QueueFamilyRequest> BuildQueueCreateInfos(
   return result;
 }
 
+// ----------------------------------------------------------------------------------------------------
+// Resource sharing
+//
+
+template <typename TCreateInfo>
+void SetQueueFamilySharingImpl(IVulkanDevice const& vk_device, TCreateInfo& create_info, bool concurrent) {
+  std::span<uint32_t const> const queue_family_indices = vk_device.queue_family_indices();
+  if (concurrent && queue_family_indices.size() > 1) {
+    create_info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+    create_info.queueFamilyIndexCount = static_cast<uint32_t>(queue_family_indices.size());
+    create_info.pQueueFamilyIndices = queue_family_indices.data();
+  } else {
+    create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    create_info.queueFamilyIndexCount = 0;
+    create_info.pQueueFamilyIndices = nullptr;
+  }
+}
+
 } // namespace
 
+void SetQueueFamilySharing(IVulkanDevice const& vk_device, VkBufferCreateInfo& create_info, bool concurrent) {
+  SetQueueFamilySharingImpl(vk_device, create_info, concurrent);
+}
+
+void SetQueueFamilySharing(IVulkanDevice const& vk_device, VkImageCreateInfo& create_info, bool concurrent) {
+  SetQueueFamilySharingImpl(vk_device, create_info, concurrent);
+}
+
 // ----------------------------------------------------------------------------------------------------
 // VulkanDevice::Create
 //
@@ -456,6 +499,11 @@ std::unique_ptr<IVulkanDevice> IVulkanDevice::Create(
   }
   device_extensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
 
+  // VK_EXT_descriptor_indexing is opt-in, for the bindless table. The caller has checked the features it needs.
+  if (desc.descriptor_indexing) {
+    device_extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+  }
+
   // Features.
   VkPhysicalDeviceFeatures device_features {};
 
@@ -468,9 +516,25 @@ std::unique_ptr<IVulkanDevice> IVulkanDevice::Create(
   sync2_features.pNext = &timeline_semaphore_features;
   sync2_features.synchronization2 = VK_TRUE;
 
+  VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_features {};
+  descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+  descriptor_indexing_features.pNext = &sync2_features;
+  if (desc.descriptor_indexing) {
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT const& supported =
+      desc.physical_device_desc->descriptor_indexing_desc()->features;
+    descriptor_indexing_features.runtimeDescriptorArray = VK_TRUE;
+    descriptor_indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
+    descriptor_indexing_features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+    descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    descriptor_indexing_features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+    // Optional: lets shaders index with values that differ across a draw or dispatch.
+    descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing = supported.shaderSampledImageArrayNonUniformIndexing;
+    descriptor_indexing_features.shaderStorageBufferArrayNonUniformIndexing = supported.shaderStorageBufferArrayNonUniformIndexing;
+  }
+
   VkPhysicalDeviceVulkan11Features device_features_11 {};
   device_features_11.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
-  device_features_11.pNext = &sync2_features;
+  device_features_11.pNext = desc.descriptor_indexing ? static_cast<void*>(&descriptor_indexing_features) : &sync2_features;
 
   VkDeviceCreateInfo info {};
   info.sType                = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -602,26 +666,44 @@ std::unique_ptr<IVulkanDevice> IVulkanDevice::Create(
     vma_allocator
   ));
 
+  device->enabled_extensions_.assign(device_extensions.begin(), device_extensions.end());
+
+  for (QueueFamilyRequest const& req : queue_requests) {
+    // `queue_requests` is ordered by family index.
+    device->queue_family_indices_.push_back(req.family_index);
+  }
+
   // Initialize staging infrastructure.
   device->staging_buffer_pool_.Initialize(device.get());
-  device->transient_command_pool_.Initialize(device.get(), selection.present_capable.queue_family_index);
-  device->thread_command_pool_registry_.Initialize(device.get(), selection.present_capable.queue_family_index);
+  for (uint32_t i = 0; i < queue_index_map.Count(); ++i) {
+    device->transient_command_pools_[i].Initialize(device.get(), queue_index_map.GetQueueId(i).queue_family_index);
+  }
+  device->thread_command_pool_registry_.Initialize(device.get());
 
   return device;
 }
 
+// ----------------------------------------------------------------------------------------------------
+// VulkanDevice::DeferredDestroyer::AcquireRecord
+//
+
+VulkanObjectRecord* VulkanDevice::DeferredDestroyer::AcquireRecord() {
+  VulkanObjectRecord* record = owner_.object_records_.Acquire();
+  record->destroyer = this;
+  return record;
+}
+
 // ----------------------------------------------------------------------------------------------------
 // VulkanDevice::DeferredDestroyer::EnqueueDestroy
 //
 
-void VulkanDevice::DeferredDestroyer::EnqueueDestroy(
-  std::function<void()> destroy_func,
-  ResourceSyncStamp::Snapshot snapshot
-) {
+void VulkanDevice::DeferredDestroyer::EnqueueDestroy(VulkanObjectRecord* record) {
   auto& device = owner_;
 
+  ResourceSyncStamp::Snapshot const snapshot = record->sync_stamp.TakeSnapshot();
+
   if (snapshot.used_mask == 0) {
-    destroy_func();
+    device.DestroyObject(record);
     return;
   }
 
@@ -641,9 +723,9 @@ void VulkanDevice::DeferredDestroyer::EnqueueDestroy(
   }
 
   if (completed) {
-    destroy_func();
+    device.DestroyObject(record);
   } else {
-    device.EnqueuePendingDestroy(std::move(destroy_func), snapshot);
+    device.EnqueuePendingDestroy(record, snapshot);
   }
 }
 
@@ -652,18 +734,73 @@ void VulkanDevice::DeferredDestroyer::EnqueueDestroy(
 //
 
 void VulkanDevice::EnqueuePendingDestroy(
-  std::function<void()> destroy_func,
+  VulkanObjectRecord* record,
   ResourceSyncStamp::Snapshot snapshot
 ) {
   mbase::LockGuard lock(pending_destroys_mutex_);
   pending_destroys_.emplace_back(
     PendingDestroy {
-      .destroy_func = std::move(destroy_func),
+      .record = record,
       .snapshot = snapshot,
     }
   );
 }
 
+// ----------------------------------------------------------------------------------------------------
+// VulkanDevice::DestroyObject (private)
+//
+
+void VulkanDevice::DestroyObject(VulkanObjectRecord* record) {
+  VulkanObjectDestroyInfo& info = record->destroy_info;
+
+  switch (info.type) {
+  case VulkanObjectType::kNone:
+    break;
+  case VulkanObjectType::kVmaBuffer:
+    vmaDestroyBuffer(vma_allocator_, VulkanHandleFromU64<VkBuffer>(info.handle), static_cast<VmaAllocation>(info.context));
+    break;
+  case VulkanObjectType::kPlacedBufferRange:
+    static_cast<PlacedBufferBlock*>(info.keep_alive.get())->Free(VulkanHandleFromU64<VmaVirtualAllocation>(info.aux));
+    break;
+  case VulkanObjectType::kVmaImage:
+    vmaDestroyImage(vma_allocator_, VulkanHandleFromU64<VkImage>(info.handle), static_cast<VmaAllocation>(info.context));
+    break;
+  case VulkanObjectType::kAliasedImage:
+    vkDestroyImage(handle_, VulkanHandleFromU64<VkImage>(info.handle), nullptr);
+    break;
+  case VulkanObjectType::kImageView:
+    vkDestroyImageView(handle_, VulkanHandleFromU64<VkImageView>(info.handle), nullptr);
+    break;
+  case VulkanObjectType::kSampler:
+    vkDestroySampler(handle_, VulkanHandleFromU64<VkSampler>(info.handle), nullptr);
+    break;
+  case VulkanObjectType::kShaderModule:
+    vkDestroyShaderModule(handle_, VulkanHandleFromU64<VkShaderModule>(info.handle), nullptr);
+    break;
+  case VulkanObjectType::kPipeline:
+    vkDestroyPipeline(handle_, VulkanHandleFromU64<VkPipeline>(info.handle), nullptr);
+    break;
+  case VulkanObjectType::kPipelineLayout:
+    vkDestroyPipelineLayout(handle_, VulkanHandleFromU64<VkPipelineLayout>(info.handle), nullptr);
+    break;
+  case VulkanObjectType::kDescriptorSetLayout:
+    vkDestroyDescriptorSetLayout(handle_, VulkanHandleFromU64<VkDescriptorSetLayout>(info.handle), nullptr);
+    break;
+  case VulkanObjectType::kDescriptorSet:
+    static_cast<IDescriptorSetAllocator*>(info.context)->Free(
+      VulkanHandleFromU64<VkDescriptorSetLayout>(info.aux),
+      VulkanHandleFromU64<VkDescriptorSet>(info.handle)
+    );
+    break;
+  }
+
+  record->sync_stamp.Reset();
+  record->destroy_info = VulkanObjectDestroyInfo {};
+  record->destroyer = nullptr;
+
+  object_records_.Release(record);
+}
+
 void VulkanDevice::ProcessPendingDestroys() {
   mbase::LockGuard lock(pending_destroys_mutex_);
 
@@ -683,7 +820,7 @@ void VulkanDevice::ProcessPendingDestroys() {
     }
 
     if (completed) {
-      entry.destroy_func();
+      this->DestroyObject(entry.record);
       // Swap with last and pop (order doesn't matter).
       entry = std::move(pending_destroys_.back());
       pending_destroys_.pop_back();
@@ -693,6 +830,15 @@ void VulkanDevice::ProcessPendingDestroys() {
   }
 }
 
+// ----------------------------------------------------------------------------------------------------
+// VulkanDevice::transient_command_pool
+//
+
+TransientCommandPool& VulkanDevice::transient_command_pool(mnexus::QueueId const& queue_id) {
+  RESOLVE_QUEUE_INDEX(index, queue_id);
+  return transient_command_pools_[index];
+}
+
 // ----------------------------------------------------------------------------------------------------
 // VulkanDevice::QueueGetCompletedValue
 //
@@ -705,6 +851,16 @@ uint64_t VulkanDevice::QueueGetCompletedValue(mnexus::QueueId const& queue_id) {
   return completed_value;
 }
 
+// ----------------------------------------------------------------------------------------------------
+// VulkanDevice::QueueGetLastSubmittedValue
+//
+
+uint64_t VulkanDevice::QueueGetLastSubmittedValue(mnexus::QueueId const& queue_id) {
+  RESOLVE_QUEUE_INDEX(index, queue_id);
+
+  return queue_states_[index].next_submit_serial.load(std::memory_order_acquire) - 1;
+}
+
 // ----------------------------------------------------------------------------------------------------
 // VulkanDevice::QueueWaitSubmitSerial
 //
@@ -730,6 +886,42 @@ void VulkanDevice::QueueWaitSubmitSerial(mnexus::QueueId const& queue_id, uint64
   this->ProcessPendingDestroys();
 }
 
+// ----------------------------------------------------------------------------------------------------
+// VulkanDevice::QueueWaitAnySerial
+//
+
+bool VulkanDevice::QueueWaitAnySerial(mbase::ArrayProxy<uint64_t const> serials, uint64_t timeout_ns) {
+  MBASE_ASSERT(serials.size() <= queue_index_map_.Count());
+
+  VkSemaphore semaphores[kMaxQueues] {};
+  uint64_t values[kMaxQueues] {};
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < serials.size(); ++i) {
+    if (serials[i] != 0) {
+      semaphores[count] = queue_states_[i].timeline_semaphore;
+      values[count] = serials[i];
+      ++count;
+    }
+  }
+  if (count == 0) {
+    return true;
+  }
+
+  VkSemaphoreWaitInfoKHR wait_info {
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR,
+    .pNext = nullptr,
+    .flags = VK_SEMAPHORE_WAIT_ANY_BIT_KHR,
+    .semaphoreCount = count,
+    .pSemaphores = semaphores,
+    .pValues = values,
+  };
+  VkResult const result = vkWaitSemaphoresKHR(handle_, &wait_info, timeout_ns);
+  if (result != VK_SUCCESS && result != VK_TIMEOUT) {
+    MBASE_LOG_ERROR("vkWaitSemaphoresKHR failed: {}", string_VkResult(result));
+  }
+  return result == VK_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------------------------------
 // VulkanDevice::QueueWaitIdle
 //
@@ -748,7 +940,38 @@ uint64_t VulkanDevice::QueueWaitIdle(mnexus::QueueId const& queue_id) {
 
 uint64_t VulkanDevice::QueueAdvanceTimeline(mnexus::QueueId const& queue_id) {
   RESOLVE_QUEUE_INDEX(index, queue_id);
-  uint64_t const serial = queue_states_[index].next_submit_serial.fetch_add(1, std::memory_order_acq_rel);
+
+  VulkanQueueState& qs = queue_states_[index];
+  uint64_t const serial = qs.next_submit_serial.fetch_add(1, std::memory_order_acq_rel);
+
+  // The serial still has to be signaled, or waits on it would never return. A host-side vkSignalSemaphore could
+  // overtake GPU signals of lower serials that are still pending, so signal it in queue order with an empty submit.
+  VkSemaphoreSubmitInfoKHR signal_info {
+    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO_KHR,
+    .pNext = nullptr,
+    .semaphore = qs.timeline_semaphore,
+    .value = serial,
+    .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR,
+    .deviceIndex = 0,
+  };
+
+  VkSubmitInfo2KHR submit_info {
+    .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2_KHR,
+    .pNext = nullptr,
+    .flags = 0,
+    .waitSemaphoreInfoCount = 0,
+    .pWaitSemaphoreInfos = nullptr,
+    .commandBufferInfoCount = 0,
+    .pCommandBufferInfos = nullptr,
+    .signalSemaphoreInfoCount = 1,
+    .pSignalSemaphoreInfos = &signal_info,
+  };
+
+  VkResult const result = vkQueueSubmit2KHR(qs.vk_queue, 1, &submit_info, VK_NULL_HANDLE);
+  if (result != VK_SUCCESS) {
+    MBASE_LOG_ERROR("vkQueueSubmit2KHR failed: {}", string_VkResult(result));
+  }
+  completion_notifier_.NotifySubmitted(index, serial);
 
   this->ProcessPendingDestroys();
 
@@ -797,6 +1020,7 @@ uint64_t VulkanDevice::QueueSubmitSingle(mnexus::QueueId const& queue_id, VkComm
   if (result != VK_SUCCESS) {
     MBASE_LOG_ERROR("vkQueueSubmit2KHR failed: {}", string_VkResult(result));
   }
+  completion_notifier_.NotifySubmitted(index, serial);
 
   this->ProcessPendingDestroys();
 
@@ -875,6 +1099,7 @@ uint64_t VulkanDevice::QueuePresentSwapchainImage(
     MBASE_LOG_ERROR("vkQueueSubmit2KHR (pre-present) failed: {}", string_VkResult(result));
     return 0;
   }
+  completion_notifier_.NotifySubmitted(index, serial);
 
   // Present, waiting on the binary semaphore.
   VkPresentInfoKHR present_info {
@@ -921,11 +1146,16 @@ void VulkanDevice::Shutdown() {
     vkDeviceWaitIdle(handle_);
   }
 
+  // Delivers the callbacks of the work completed above while the backend can still be polled.
+  completion_notifier_.Shutdown();
+
   this->ProcessPendingDestroys();
   MBASE_ASSERT_MSG(pending_destroys_.empty(), "Pending destroys remain after device idle (count: {})", pending_destroys_.size());
 
   thread_command_pool_registry_.Shutdown();
-  transient_command_pool_.Shutdown();
+  for (TransientCommandPool& pool : transient_command_pools_) {
+    pool.Shutdown();
+  }
   staging_buffer_pool_.Shutdown();
 
   if (vma_allocator_ != VK_NULL_HANDLE) {
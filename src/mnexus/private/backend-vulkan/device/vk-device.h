@@ -4,6 +4,7 @@
 #include <cstdint>
 
 #include <memory>
+#include <span>
 
 // public project headers -------------------------------
 #include "mbase/public/array_proxy.h"
@@ -14,10 +15,14 @@
 #include "backend-vulkan/depend/vulkan_fwd.h"
 
 // Forward declarations ---------------------------------
+struct VkBufferCreateInfo;
+struct VkImageCreateInfo;
+
 struct VmaAllocator_T;
 typedef VmaAllocator_T* VmaAllocator;
 
 namespace mnexus_backend {
+class QueueCompletionNotifier;
 class QueueIndexMap;
 }
 
@@ -33,6 +38,8 @@ class PhysicalDeviceDesc;
 struct VulkanDeviceDesc final {
   PhysicalDeviceDesc const* physical_device_desc = nullptr;
   bool headless = false;
+  /// Enable `VK_EXT_descriptor_indexing` with the features `BindlessTable` needs.
+  bool descriptor_indexing = false;
 };
 
 // ----------------------------------------------------------------------------------------------------
@@ -59,6 +66,8 @@ public:
   [[nodiscard]] virtual PhysicalDeviceDesc const& physical_device_desc() const = 0;
   [[nodiscard]] virtual VkDevice handle() const = 0;
   [[nodiscard]] virtual mnexus::QueueSelection const& queue_selection() const = 0;
+  /// Distinct queue families of the queues in `queue_selection()`, ascending.
+  [[nodiscard]] virtual std::span<uint32_t const> queue_family_indices() const = 0;
   [[nodiscard]] virtual VmaAllocator vma_allocator() const = 0;
 
   [[nodiscard]] virtual bool IsExtensionEnabled(char const* extension_name) const = 0;
@@ -72,14 +81,21 @@ public:
   /// Returns the highest completed serial on the given queue.
   [[nodiscard]] virtual uint64_t QueueGetCompletedValue(mnexus::QueueId const& queue_id) = 0;
 
+  /// Returns the highest serial allocated on the given queue (0 if nothing has been submitted).
+  [[nodiscard]] virtual uint64_t QueueGetLastSubmittedValue(mnexus::QueueId const& queue_id) = 0;
+
   /// Blocks until the given serial has completed on the given queue.
   virtual void QueueWaitSubmitSerial(mnexus::QueueId const& queue_id, uint64_t value) = 0;
 
+  /// Blocks until any queue reaches its serial, or `timeout_ns` elapses. `serials` is indexed by compact queue index;
+  /// a serial of 0 skips the queue. Returns false on timeout.
+  virtual bool QueueWaitAnySerial(mbase::ArrayProxy<uint64_t const> serials, uint64_t timeout_ns) = 0;
+
   /// Blocks until all submitted work on the given queue has completed.
   /// Returns the last submitted serial (0 if nothing has been submitted).
   [[nodiscard]] virtual uint64_t QueueWaitIdle(mnexus::QueueId const& queue_id) = 0;
 
-  /// Advances the queue timeline without an actual GPU submit.
+  /// Advances the queue timeline with a command-less submit.
   /// Returns the new serial. Used for mappable buffer writes where
   /// the data is visible immediately after a host flush.
   [[nodiscard]] virtual uint64_t QueueAdvanceTimeline(mnexus::QueueId const& queue_id) = 0;
@@ -108,12 +124,21 @@ public:
   // Sub-system accessors.
 
   [[nodiscard]] virtual StagingBufferPool& staging_buffer_pool() = 0;
-  [[nodiscard]] virtual TransientCommandPool& transient_command_pool() = 0;
+  /// The pool for one-shot command buffers submitted to `queue_id`.
+  [[nodiscard]] virtual TransientCommandPool& transient_command_pool(mnexus::QueueId const& queue_id) = 0;
   [[nodiscard]] virtual ThreadCommandPoolRegistry& thread_command_pool_registry() = 0;
   [[nodiscard]] virtual QueueIndexMap const& queue_index_map() const = 0;
+  /// Notified of every serial allocated on a queue; drives `QueueOnCompleted` and the completion events.
+  [[nodiscard]] virtual QueueCompletionNotifier& completion_notifier() = 0;
 
 protected:
   IVulkanDevice() = default;
 };
 
+/// Sets the sharing mode of `create_info`: concurrent between the queue families of `vk_device` if `concurrent` is set
+/// and it has several, so that any of its queues may use the resource without ownership transfers; exclusive
+/// otherwise. Concurrent sharing can disable optimizations such as image compression, so it is opt-in.
+void SetQueueFamilySharing(IVulkanDevice const& vk_device, VkBufferCreateInfo& create_info, bool concurrent);
+void SetQueueFamilySharing(IVulkanDevice const& vk_device, VkImageCreateInfo& create_info, bool concurrent);
+
 } // namespace mnexus_backend::vulkan
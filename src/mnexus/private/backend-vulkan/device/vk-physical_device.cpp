@@ -1,13 +1,87 @@
 // TU header --------------------------------------------
 #include "backend-vulkan/device/vk-physical_device.h"
 
+// c++ headers ------------------------------------------
+#include <algorithm>
+
 // public project headers -------------------------------
 #include "mbase/public/log.h"
 
 // project headers --------------------------------------
+#include "adapter/adapter_selection.h"
 
 namespace mnexus_backend::vulkan {
 
+namespace {
+
+adapter::AdapterKind ToAdapterKind(VkPhysicalDeviceType device_type) {
+  switch (device_type) {
+  case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+    return adapter::AdapterKind::kDiscreteGpu;
+  case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+    return adapter::AdapterKind::kIntegratedGpu;
+  case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+    return adapter::AdapterKind::kVirtualGpu;
+  case VK_PHYSICAL_DEVICE_TYPE_CPU:
+    return adapter::AdapterKind::kCpu;
+  default:
+    return adapter::AdapterKind::kOther;
+  }
+}
+
+adapter::AdapterCandidate MakeAdapterCandidate(
+  PhysicalDeviceDesc const& physical_device_desc,
+  mbase::ArrayProxy<std::string const> extensions,
+  mbase::ArrayProxy<char const* const> non_mandatory_extensions
+) {
+  auto const& properties = physical_device_desc.properties();
+
+  adapter::AdapterCandidate candidate {
+    .name = properties.deviceName,
+    .vendor_id = properties.vendorID,
+    .device_id = properties.deviceID,
+    .kind = ToAdapterKind(properties.deviceType),
+  };
+
+  // The caller's mandatory extensions, plus those `VulkanDevice::Create` cannot do without.
+  candidate.required_features_supported =
+    std::all_of(
+      std::begin(extensions), std::end(extensions),
+      [&](std::string const& name) { return physical_device_desc.QueryExtensionSupport(name) != nullptr; }
+    ) &&
+    physical_device_desc.QueryExtensionSupport(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) != nullptr &&
+    physical_device_desc.QueryExtensionSupport(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME) != nullptr;
+
+  for (char const* name : non_mandatory_extensions) {
+    if (physical_device_desc.QueryExtensionSupport(name) != nullptr) {
+      ++candidate.optional_feature_count;
+    }
+  }
+
+  for (auto const& queue_family : physical_device_desc.queue_families()) {
+    VkQueueFlags const flags = queue_family.properties.queueFlags;
+    bool const graphics = (flags & VK_QUEUE_GRAPHICS_BIT) != 0;
+    bool const compute = (flags & VK_QUEUE_COMPUTE_BIT) != 0;
+    bool const transfer = (flags & VK_QUEUE_TRANSFER_BIT) != 0;
+
+    candidate.has_universal_queue |= graphics && compute;
+    candidate.has_dedicated_compute_queue |= compute && !graphics;
+    candidate.has_dedicated_transfer_queue |= transfer && !graphics && !compute;
+  }
+
+  auto const& memory_properties = physical_device_desc.memory_properties();
+  for (uint32_t i = 0; i < memory_properties.memoryHeapCount; ++i) {
+    VkMemoryHeap const& heap = memory_properties.memoryHeaps[i];
+    if ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0) {
+      candidate.device_local_heap_size_in_bytes = std::max(candidate.device_local_heap_size_in_bytes, heap.size);
+    }
+  }
+
+  return candidate;
+}
+
+} // namespace
+
 PhysicalDeviceDesc PhysicalDeviceDesc::Query(VulkanInstance const& instance, VkPhysicalDevice vk_physical_device) {
   PhysicalDeviceDesc result;
 
@@ -235,7 +309,8 @@ VkExtensionProperties const* PhysicalDeviceDesc::QueryExtensionSupport(std::stri
 std::optional<PhysicalDeviceDesc> SelectPhysicalDevice(
   VulkanInstance const& instance,
   mbase::ArrayProxy<std::string const> extensions,
-  mbase::ArrayProxy<char const* const> non_mandatory_extensions
+  mbase::ArrayProxy<char const* const> non_mandatory_extensions,
+  mnexus::AdapterOverride const& adapter_override
 ) {
   std::vector<VkPhysicalDevice> physical_devices;
   {
@@ -292,35 +367,36 @@ std::optional<PhysicalDeviceDesc> SelectPhysicalDevice(
     }
   }
 
-  // TODO: perform proper selection.
-  PhysicalDeviceDesc const& selected = physical_device_descs.front();
-
-  // Check if the physical device supports all the extensions necessary.
-  uint32_t unsupported_extensions = 0;
-  for (const auto& desired : extensions) {
-    if (std::all_of(
-        std::begin(selected.extensions()), std::end(selected.extensions()),
-        [&](VkExtensionProperties const& props) {
-          return std::string(props.extensionName) != desired;
-        })) {
-      MBASE_LOG_ERROR("Mandatory device extension {} not supported!", desired);
-      ++unsupported_extensions;
-    }
+  // Describe every physical device for scoring.
+  std::vector<adapter::AdapterCandidate> candidates;
+  candidates.reserve(physical_device_descs.size());
+  for (auto const& physical_device_desc : physical_device_descs) {
+    candidates.emplace_back(MakeAdapterCandidate(physical_device_desc, extensions, non_mandatory_extensions));
   }
 
-  // Error out if any of the necessary extensions is not available.
-  if (unsupported_extensions > 0) {
+  std::optional<uint32_t> const opt_selected_index = adapter::SelectAdapter(candidates, adapter_override);
+  if (!opt_selected_index.has_value()) {
+    // Report what each device lacks.
+    for (auto const& physical_device_desc : physical_device_descs) {
+      for (const auto& desired : extensions) {
+        if (physical_device_desc.QueryExtensionSupport(desired) == nullptr) {
+          MBASE_LOG_ERROR("{}: mandatory device extension {} not supported!",
+            physical_device_desc.properties().deviceName, desired);
+        }
+      }
+    }
+    MBASE_LOG_ERROR("No physical device supports the mandatory extensions, features and queues.");
     return std::nullopt;
   }
 
+  PhysicalDeviceDesc const& selected = physical_device_descs[opt_selected_index.value()];
+  MBASE_LOG_INFO("Selected physical device {}: {} (score {:#018x})",
+    opt_selected_index.value(), selected.properties().deviceName, adapter::ScoreAdapter(candidates[opt_selected_index.value()]));
+
 #if 1
   // Check and log if the physical device supports any of the non-mandatory extensions.
   for (const auto& desired : non_mandatory_extensions) {
-    if (std::all_of(
-        std::begin(selected.extensions()), std::end(selected.extensions()),
-        [&](VkExtensionProperties const& props) {
-          return std::string(props.extensionName) != desired;
-        })) {
+    if (selected.QueryExtensionSupport(desired) == nullptr) {
       MBASE_LOG_WARN("Non-mandarory device extension {} not supported!", desired);
     }
   }
@@ -9,6 +9,8 @@
 #include "mbase/public/accessor.h"
 #include "mbase/public/array_proxy.h"
 
+#include "mnexus/public/mnexus.h"
+
 // project headers --------------------------------------
 #include "backend-vulkan/depend/vulkan.h"
 #include "backend-vulkan/device/vk-instance.h"
@@ -119,7 +121,8 @@ private:
 std::optional<PhysicalDeviceDesc> SelectPhysicalDevice(
   VulkanInstance const& instance,
   mbase::ArrayProxy<std::string const> extensions,
-  mbase::ArrayProxy<char const* const> non_mandatory_extensions
+  mbase::ArrayProxy<char const* const> non_mandatory_extensions,
+  mnexus::AdapterOverride const& adapter_override
 );
 
 } // namespace mnexus_backend::vulkan
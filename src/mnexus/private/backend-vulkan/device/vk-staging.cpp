@@ -79,6 +79,9 @@ StagingBuffer* StagingBufferPool::CreateStagingBuffer(VkDeviceSize size) {
     .queueFamilyIndexCount = 0,
     .pQueueFamilyIndices = nullptr,
   };
+  // Pooled staging buffers are reused by uploads on any queue; they are transfer-only, so concurrent sharing costs
+  // nothing.
+  SetQueueFamilySharing(*device_, buffer_info, true);
 
   VmaAllocationCreateInfo alloc_info {
     .flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
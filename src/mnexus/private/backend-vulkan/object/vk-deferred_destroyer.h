@@ -1,18 +1,95 @@
 #pragma once
 
 // c++ headers ------------------------------------------
-#include <functional>
+#include <cstdint>
+
+#include <memory>
+#include <type_traits>
 
 // project headers --------------------------------------
+#include "sync/concurrent_slab.h"
 #include "sync/resource_sync.h"
 
 namespace mnexus_backend::vulkan {
 
+class IVulkanDeferredDestroyer;
+
+// ----------------------------------------------------------------------------------------------------
+// VulkanObjectType
+//
+// Selects how the deferred destroyer releases an object. The meaning of `VulkanObjectDestroyInfo::context` and
+// `aux` depends on the type.
+//
+
+enum class VulkanObjectType : uint8_t {
+  kNone = 0,
+  kVmaBuffer,           // vmaDestroyBuffer. context: VmaAllocation.
+  kPlacedBufferRange,   // PlacedBufferBlock::Free. aux: VmaVirtualAllocation, keep_alive: the block.
+  kVmaImage,            // vmaDestroyImage. context: VmaAllocation.
+  kAliasedImage,        // vkDestroyImage. keep_alive: the memory shared with other images.
+  kImageView,
+  kSampler,
+  kShaderModule,
+  kPipeline,
+  kPipelineLayout,
+  kDescriptorSetLayout,
+  kDescriptorSet,       // IDescriptorSetAllocator::Free. context: the allocator, aux: VkDescriptorSetLayout.
+};
+
+// ----------------------------------------------------------------------------------------------------
+// VulkanObjectDestroyInfo
+//
+// Everything needed to destroy an object, without a type-erased callback.
+//
+
+struct VulkanObjectDestroyInfo final {
+  VulkanObjectType type = VulkanObjectType::kNone;
+  /// The object's own handle. Filled in by `TVulkanObjectBase`.
+  uint64_t handle = 0;
+  void* context = nullptr;
+  uint64_t aux = 0;
+  /// Shared owner kept alive until the object is destroyed.
+  std::shared_ptr<void> keep_alive;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// VulkanObjectRecord
+//
+// Out-of-line state of a `TVulkanObjectBase`: the sync stamp and the destroy info. Records are handed out by the
+// deferred destroyer from a `ConcurrentSlab` and recycled once the object has been destroyed.
+//
+
+struct VulkanObjectRecord final {
+  ResourceSyncStamp sync_stamp;
+  VulkanObjectDestroyInfo destroy_info;
+  IVulkanDeferredDestroyer* destroyer = nullptr;
+  ConcurrentSlabHook slab_hook;
+};
+
+// Vulkan handles are pointers on 64-bit targets and `uint64_t` on 32-bit ones.
+template<class T>
+uint64_t VulkanHandleToU64(T handle) {
+  if constexpr (std::is_pointer_v<T>) {
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+  } else {
+    return static_cast<uint64_t>(handle);
+  }
+}
+
+template<class T>
+T VulkanHandleFromU64(uint64_t value) {
+  if constexpr (std::is_pointer_v<T>) {
+    return reinterpret_cast<T>(static_cast<uintptr_t>(value));
+  } else {
+    return static_cast<T>(value);
+  }
+}
+
 // ----------------------------------------------------------------------------------------------------
 // IVulkanDeferredDestroyer
 //
 // Interface for enqueuing Vulkan objects for deferred destruction.
-// The destroy callback will be invoked once all queues in the snapshot
+// An object is destroyed once all queues in its record's sync stamp
 // have completed past their respective retire serials.
 //
 
@@ -20,10 +97,11 @@ class IVulkanDeferredDestroyer {
 public:
   virtual ~IVulkanDeferredDestroyer() = default;
 
-  virtual void EnqueueDestroy(
-    std::function<void()> destroy_func,
-    ResourceSyncStamp::Snapshot snapshot
-  ) = 0;
+  /// Returns a reset record whose `destroyer` is this destroyer.
+  [[nodiscard]] virtual VulkanObjectRecord* AcquireRecord() = 0;
+
+  /// Takes ownership of `record`: destroys its object once retired, then recycles the record.
+  virtual void EnqueueDestroy(VulkanObjectRecord* record) = 0;
 };
 
 } // namespace mnexus_backend::vulkan
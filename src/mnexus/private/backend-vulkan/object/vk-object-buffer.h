@@ -8,10 +8,11 @@ namespace mnexus_backend::vulkan {
 class VulkanBuffer final : public TVulkanObjectBase<VkBuffer> {
 public:
   VulkanBuffer() = default;
-  VulkanBuffer(VkBuffer handle, std::function<void()> destroy_func, IVulkanDeferredDestroyer* deferred_destroyer) :
-    TVulkanObjectBase(handle, std::move(destroy_func), deferred_destroyer)
+  VulkanBuffer(VkBuffer handle, VulkanObjectDestroyInfo destroy_info, IVulkanDeferredDestroyer* deferred_destroyer) :
+    TVulkanObjectBase(handle, std::move(destroy_info), deferred_destroyer)
   {
   }
 };
+static_assert(sizeof(VulkanBuffer) <= 16);
 
 } // namespace mnexus_backend::vulkan
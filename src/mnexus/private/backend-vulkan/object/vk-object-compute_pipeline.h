@@ -8,10 +8,11 @@ namespace mnexus_backend::vulkan {
 class VulkanComputePipeline final : public TVulkanObjectBase<VkPipeline> {
 public:
   VulkanComputePipeline() = default;
-  VulkanComputePipeline(VkPipeline handle, std::function<void()> destroy_func, IVulkanDeferredDestroyer* deferred_destroyer) :
-    TVulkanObjectBase(handle, std::move(destroy_func), deferred_destroyer)
+  VulkanComputePipeline(VkPipeline handle, VulkanObjectDestroyInfo destroy_info, IVulkanDeferredDestroyer* deferred_destroyer) :
+    TVulkanObjectBase(handle, std::move(destroy_info), deferred_destroyer)
   {
   }
 };
+static_assert(sizeof(VulkanComputePipeline) <= 16);
 
 } // namespace mnexus_backend::vulkan
@@ -11,11 +11,12 @@ namespace mnexus_backend::vulkan {
 class VulkanDescriptorSet final : public TVulkanObjectBase<VkDescriptorSet> {
 public:
   VulkanDescriptorSet() = default;
-  VulkanDescriptorSet(VkDescriptorSet handle, std::function<void()> destroy_func, IVulkanDeferredDestroyer* deferred_destroyer) :
-    TVulkanObjectBase(handle, std::move(destroy_func), deferred_destroyer)
+  VulkanDescriptorSet(VkDescriptorSet handle, VulkanObjectDestroyInfo destroy_info, IVulkanDeferredDestroyer* deferred_destroyer) :
+    TVulkanObjectBase(handle, std::move(destroy_info), deferred_destroyer)
   {
   }
 };
+static_assert(sizeof(VulkanDescriptorSet) <= 16);
 
 using VulkanDescriptorSetPtr = std::shared_ptr<VulkanDescriptorSet>;
 
@@ -14,22 +14,26 @@ namespace mnexus_backend::vulkan {
 // Wraps VkDescriptorSetLayout + stores its binding composition.
 // Needed by DescriptorSetAllocator to compute VkDescriptorPoolSize for pool creation.
 //
+// A layout referring to the bindless table (see `BindlessTable`) is non-owning, has no bindings and is marked
+// `bindless`; its single descriptor set is bound as is instead of being allocated per write.
+//
 
 class VulkanDescriptorSetLayout final : public TVulkanObjectBase<VkDescriptorSetLayout> {
 public:
   VulkanDescriptorSetLayout() = default;
   VulkanDescriptorSetLayout(
     VkDescriptorSetLayout handle,
-    std::function<void()> destroy_func,
+    VulkanObjectDestroyInfo destroy_info,
     IVulkanDeferredDestroyer* deferred_destroyer,
     mbase::SmallVector<VkDescriptorSetLayoutBinding, 4> bindings
   ) :
-    TVulkanObjectBase(handle, std::move(destroy_func), deferred_destroyer),
+    TVulkanObjectBase(handle, std::move(destroy_info), deferred_destroyer),
     bindings(std::move(bindings))
   {
   }
 
   mbase::SmallVector<VkDescriptorSetLayoutBinding, 4> bindings;
+  bool bindless = false;
 };
 
 } // namespace mnexus_backend::vulkan
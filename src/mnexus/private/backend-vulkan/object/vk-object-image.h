@@ -11,8 +11,8 @@ namespace mnexus_backend::vulkan {
 class VulkanImage final : public TVulkanObjectBase<VkImage> {
 public:
   VulkanImage() = default;
-  VulkanImage(VkImage handle, std::function<void()> destroy_func, IVulkanDeferredDestroyer* deferred_destroyer, VkImageUsageFlags vk_usage_flags, VkFormat vk_format) :
-    TVulkanObjectBase(handle, std::move(destroy_func), deferred_destroyer),
+  VulkanImage(VkImage handle, VulkanObjectDestroyInfo destroy_info, IVulkanDeferredDestroyer* deferred_destroyer, VkImageUsageFlags vk_usage_flags, VkFormat vk_format) :
+    TVulkanObjectBase(handle, std::move(destroy_info), deferred_destroyer),
     vk_usage_flags_(vk_usage_flags),
     vk_format_(vk_format)
   {
@@ -25,5 +25,6 @@ private:
   VkImageUsageFlags vk_usage_flags_ = 0;
   VkFormat vk_format_ = VK_FORMAT_UNDEFINED;
 };
+static_assert(sizeof(VulkanImage) <= 24);
 
 } // namespace mnexus_backend::vulkan
@@ -0,0 +1,18 @@
+#pragma once
+
+// project headers --------------------------------------
+#include "backend-vulkan/object/vk-object.h"
+
+namespace mnexus_backend::vulkan {
+
+class VulkanImageView final : public TVulkanObjectBase<VkImageView> {
+public:
+  VulkanImageView() = default;
+  VulkanImageView(VkImageView handle, VulkanObjectDestroyInfo destroy_info, IVulkanDeferredDestroyer* deferred_destroyer) :
+    TVulkanObjectBase(handle, std::move(destroy_info), deferred_destroyer)
+  {
+  }
+};
+static_assert(sizeof(VulkanImageView) <= 16);
+
+} // namespace mnexus_backend::vulkan
@@ -11,18 +11,20 @@ namespace mnexus_backend::vulkan {
 //
 // VulkanPipelineLayout
 //
-// Bundles a VkPipelineLayout and its VkDescriptorSetLayouts.
+// Bundles a VkPipelineLayout, its VkDescriptorSetLayouts and its push constant range.
 //
 
 class VulkanPipelineLayout final : public TVulkanObjectBase<VkPipelineLayout> {
 public:
   VulkanPipelineLayout() = default;
-  VulkanPipelineLayout(VkPipelineLayout handle, std::function<void()> destroy_func, IVulkanDeferredDestroyer* deferred_destroyer) :
-    TVulkanObjectBase(handle, std::move(destroy_func), deferred_destroyer)
+  VulkanPipelineLayout(VkPipelineLayout handle, VulkanObjectDestroyInfo destroy_info, IVulkanDeferredDestroyer* deferred_destroyer) :
+    TVulkanObjectBase(handle, std::move(destroy_info), deferred_destroyer)
   {
   }
 
   mbase::SmallVector<VulkanDescriptorSetLayout, 4> descriptor_set_layouts;
+  /// The single push constant range of the layout; `size == 0` if it has none.
+  VkPushConstantRange push_constant_range {};
 };
 
 using VulkanPipelineLayoutPtr = std::shared_ptr<VulkanPipelineLayout>;
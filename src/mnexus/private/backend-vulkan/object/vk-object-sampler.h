@@ -8,10 +8,11 @@ namespace mnexus_backend::vulkan {
 class VulkanSampler final : public TVulkanObjectBase<VkSampler> {
 public:
   VulkanSampler() = default;
-  VulkanSampler(VkSampler handle, std::function<void()> destroy_func, IVulkanDeferredDestroyer* deferred_destroyer) :
-    TVulkanObjectBase(handle, std::move(destroy_func), deferred_destroyer)
+  VulkanSampler(VkSampler handle, VulkanObjectDestroyInfo destroy_info, IVulkanDeferredDestroyer* deferred_destroyer) :
+    TVulkanObjectBase(handle, std::move(destroy_info), deferred_destroyer)
   {
   }
 };
+static_assert(sizeof(VulkanSampler) <= 16);
 
 } // namespace mnexus_backend::vulkan
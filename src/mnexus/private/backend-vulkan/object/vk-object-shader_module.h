@@ -8,10 +8,11 @@ namespace mnexus_backend::vulkan {
 class VulkanShaderModule final : public TVulkanObjectBase<VkShaderModule> {
 public:
   VulkanShaderModule() = default;
-  VulkanShaderModule(VkShaderModule handle, std::function<void()> destroy_func, IVulkanDeferredDestroyer* deferred_destroyer) :
-    TVulkanObjectBase(handle, std::move(destroy_func), deferred_destroyer)
+  VulkanShaderModule(VkShaderModule handle, VulkanObjectDestroyInfo destroy_info, IVulkanDeferredDestroyer* deferred_destroyer) :
+    TVulkanObjectBase(handle, std::move(destroy_info), deferred_destroyer)
   {
   }
 };
+static_assert(sizeof(VulkanShaderModule) <= 16);
 
 } // namespace mnexus_backend::vulkan
@@ -0,0 +1,177 @@
+// TU header --------------------------------------------
+#include "backend-vulkan/resource/placed_buffer_allocator.h"
+
+// c++ headers ------------------------------------------
+#include <algorithm>
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+#include "mbase/public/log.h"
+
+// project headers --------------------------------------
+#include "backend-vulkan/device/vk-device.h"
+#include "backend-vulkan/device/vk-physical_device.h"
+
+namespace mnexus_backend::vulkan {
+
+// ----------------------------------------------------------------------------------------------------
+// PlacedBufferBlock
+//
+
+std::shared_ptr<PlacedBufferBlock> PlacedBufferBlock::Create(
+  IVulkanDevice const& vk_device,
+  VkDeviceSize size,
+  bool mappable
+) {
+  // The block is shared by buffers of any usage, so it must carry every usage a placed buffer may request.
+  VkBufferCreateInfo create_info {
+    .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+    .pNext = nullptr,
+    .flags = 0,
+    .size = size,
+    .usage =
+      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+      VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+      VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+    .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+    .queueFamilyIndexCount = 0,
+    .pQueueFamilyIndices = nullptr,
+  };
+  // Exclusive: buffers with `kConcurrentQueueFamilies` usage are not placed.
+  SetQueueFamilySharing(vk_device, create_info, false);
+
+  VmaAllocationCreateInfo const alloc_info {
+    .flags = mappable
+      ? (VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
+      : static_cast<VmaAllocationCreateFlags>(0),
+    .usage = VMA_MEMORY_USAGE_AUTO,
+    .requiredFlags = 0,
+    .preferredFlags = 0,
+    .memoryTypeBits = 0,
+    .pool = VK_NULL_HANDLE,
+    .pUserData = nullptr,
+    .priority = 0.0f,
+  };
+
+  auto block = std::make_shared<PlacedBufferBlock>();
+  block->vma_allocator_ = vk_device.vma_allocator();
+
+  VmaAllocationInfo allocation_info {};
+  VkResult result = vmaCreateBuffer(
+    block->vma_allocator_, &create_info, &alloc_info,
+    &block->vk_buffer_, &block->vma_allocation_, &allocation_info
+  );
+  if (result != VK_SUCCESS) {
+    MBASE_LOG_ERROR("vmaCreateBuffer (placed block) failed: {}", string_VkResult(result));
+    return nullptr;
+  }
+  block->mapped_data_ = allocation_info.pMappedData;
+
+  VmaVirtualBlockCreateInfo const virtual_block_info {
+    .size = size,
+    .flags = 0,
+    .pAllocationCallbacks = nullptr,
+  };
+
+  mbase::LockGuard lock(block->mutex_);
+  result = vmaCreateVirtualBlock(&virtual_block_info, &block->virtual_block_);
+  if (result != VK_SUCCESS) {
+    MBASE_LOG_ERROR("vmaCreateVirtualBlock failed: {}", string_VkResult(result));
+    return nullptr; // The destructor releases the VkBuffer.
+  }
+
+  return block;
+}
+
+PlacedBufferBlock::~PlacedBufferBlock() {
+  {
+    mbase::LockGuard lock(mutex_);
+    if (virtual_block_ != VK_NULL_HANDLE) {
+      MBASE_ASSERT_MSG(vmaIsVirtualBlockEmpty(virtual_block_), "Placed buffer block destroyed with live allocations");
+      vmaDestroyVirtualBlock(virtual_block_);
+      virtual_block_ = VK_NULL_HANDLE;
+    }
+  }
+  if (vk_buffer_ != VK_NULL_HANDLE) {
+    vmaDestroyBuffer(vma_allocator_, vk_buffer_, vma_allocation_);
+  }
+}
+
+bool PlacedBufferBlock::TryAllocate(
+  VkDeviceSize size,
+  VkDeviceSize alignment,
+  VmaVirtualAllocation& out_allocation,
+  VkDeviceSize& out_offset
+) {
+  VmaVirtualAllocationCreateInfo const create_info {
+    .size = size,
+    .alignment = alignment,
+    .flags = 0,
+    .pUserData = nullptr,
+  };
+
+  mbase::LockGuard lock(mutex_);
+  return vmaVirtualAllocate(virtual_block_, &create_info, &out_allocation, &out_offset) == VK_SUCCESS;
+}
+
+void PlacedBufferBlock::Free(VmaVirtualAllocation allocation) {
+  mbase::LockGuard lock(mutex_);
+  vmaVirtualFree(virtual_block_, allocation);
+}
+
+// ----------------------------------------------------------------------------------------------------
+// PlacedBufferAllocator
+//
+
+PlacedBufferAllocator::PlacedBufferAllocator(IVulkanDevice const& vk_device) :
+  vk_device_(vk_device)
+{
+  // Every placed range may be bound as a uniform or storage buffer at its base offset, and copies to textures need
+  // a 4-byte aligned buffer offset; 16 also keeps vertex/index data naturally aligned.
+  VkPhysicalDeviceLimits const& limits = vk_device_.physical_device_desc().properties().limits;
+  alignment_ = std::max<VkDeviceSize>({
+    limits.minUniformBufferOffsetAlignment,
+    limits.minStorageBufferOffsetAlignment,
+    16,
+  });
+}
+
+bool PlacedBufferAllocator::ShouldPlace(mnexus::BufferDesc const& buffer_desc) const {
+  return buffer_desc.size_in_bytes != 0 && buffer_desc.size_in_bytes <= kMaxPlacedSize &&
+    !buffer_desc.usage.HasAnyOf(mnexus::BufferUsageFlagBits::kConcurrentQueueFamilies);
+}
+
+std::optional<PlacedBufferRange> PlacedBufferAllocator::Allocate(mnexus::BufferDesc const& buffer_desc) {
+  MBASE_ASSERT(this->ShouldPlace(buffer_desc));
+
+  bool const mappable = buffer_desc.usage.HasAnyOf(mnexus::BufferUsageFlagBits::kMappable);
+  BlockList& block_list = mappable ? mappable_blocks_ : device_local_blocks_;
+
+  PlacedBufferRange range;
+
+  mbase::LockGuard lock(block_list.mutex);
+
+  // Newest block first: older blocks are usually the most fragmented.
+  for (auto it = block_list.blocks.rbegin(); it != block_list.blocks.rend(); ++it) {
+    if ((*it)->TryAllocate(buffer_desc.size_in_bytes, alignment_, range.allocation, range.offset)) {
+      range.block = *it;
+      return range;
+    }
+  }
+
+  std::shared_ptr<PlacedBufferBlock> block = PlacedBufferBlock::Create(vk_device_, kBlockSize, mappable);
+  if (block == nullptr) {
+    return std::nullopt;
+  }
+  if (!block->TryAllocate(buffer_desc.size_in_bytes, alignment_, range.allocation, range.offset)) {
+    MBASE_LOG_ERROR("Placed buffer of {} bytes does not fit a fresh block", buffer_desc.size_in_bytes);
+    return std::nullopt;
+  }
+
+  range.block = block;
+  block_list.blocks.emplace_back(std::move(block));
+  return range;
+}
+
+} // namespace mnexus_backend::vulkan
@@ -0,0 +1,107 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/tsa.h"
+
+#include "mnexus/public/types.h"
+
+// project headers --------------------------------------
+#include "backend-vulkan/depend/vulkan_vma.h"
+
+namespace mnexus_backend::vulkan {
+
+class IVulkanDevice;
+
+// ----------------------------------------------------------------------------------------------------
+// PlacedBufferBlock
+//
+// One large VkBuffer (created with every buffer usage) whose range is handed out through a VMA virtual block.
+// Reference counted: each placed buffer holds a reference until its deferred destroy runs, so a block outlives the
+// allocator that created it if needed. Thread-safe.
+//
+
+class PlacedBufferBlock final {
+public:
+  static std::shared_ptr<PlacedBufferBlock> Create(IVulkanDevice const& vk_device, VkDeviceSize size, bool mappable);
+
+  PlacedBufferBlock() = default;
+  ~PlacedBufferBlock();
+  MBASE_DISALLOW_COPY_MOVE(PlacedBufferBlock);
+
+  /// Carve `size` bytes aligned to `alignment` out of the block. Returns `false` if the block has no room.
+  bool TryAllocate(
+    VkDeviceSize size,
+    VkDeviceSize alignment,
+    VmaVirtualAllocation& out_allocation,
+    VkDeviceSize& out_offset
+  );
+  void Free(VmaVirtualAllocation allocation);
+
+  [[nodiscard]] VkBuffer vk_buffer() const { return vk_buffer_; }
+  [[nodiscard]] VmaAllocation vma_allocation() const { return vma_allocation_; }
+  [[nodiscard]] void* mapped_data() const { return mapped_data_; }
+
+private:
+  VmaAllocator vma_allocator_ = VK_NULL_HANDLE;
+  VkBuffer vk_buffer_ = VK_NULL_HANDLE;
+  VmaAllocation vma_allocation_ = VK_NULL_HANDLE;
+  void* mapped_data_ = nullptr;                    // Non-null if the block is mappable.
+
+  mbase::Lockable<std::mutex> mutex_;
+  VmaVirtualBlock virtual_block_ MBASE_GUARDED_BY(mutex_) = VK_NULL_HANDLE;
+};
+
+struct PlacedBufferRange final {
+  std::shared_ptr<PlacedBufferBlock> block;
+  VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+  VkDeviceSize offset = 0;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// PlacedBufferAllocator
+//
+// Opt-in suballocator for small buffers. Instead of one VkBuffer + VMA allocation per resource, small buffers are
+// placed inside a few shared blocks; a buffer resolves to (block VkBuffer, base offset).
+// Blocks are never released before the allocator is destroyed, so steady-state churn does not re-create them.
+// Thread-safe.
+//
+
+class PlacedBufferAllocator final {
+public:
+  /// Size of each shared block.
+  static constexpr VkDeviceSize kBlockSize = 8ull * 1024 * 1024;
+  /// Buffers larger than this get a dedicated VkBuffer.
+  static constexpr VkDeviceSize kMaxPlacedSize = 256ull * 1024;
+
+  explicit PlacedBufferAllocator(IVulkanDevice const& vk_device);
+  ~PlacedBufferAllocator() = default;
+  MBASE_DISALLOW_COPY_MOVE(PlacedBufferAllocator);
+
+  /// Whether a buffer with this description is placed rather than created dedicated. Buffers with
+  /// `kConcurrentQueueFamilies` usage never are, as blocks are created with exclusive sharing.
+  [[nodiscard]] bool ShouldPlace(mnexus::BufferDesc const& buffer_desc) const;
+
+  /// Returns `std::nullopt` if a new block was required but could not be created.
+  std::optional<PlacedBufferRange> Allocate(mnexus::BufferDesc const& buffer_desc);
+
+private:
+  struct BlockList {
+    mbase::Lockable<std::mutex> mutex;
+    std::vector<std::shared_ptr<PlacedBufferBlock>> blocks MBASE_GUARDED_BY(mutex);
+  };
+
+  IVulkanDevice const& vk_device_;
+  VkDeviceSize alignment_ = 0;
+
+  BlockList device_local_blocks_;
+  BlockList mappable_blocks_;
+};
+
+} // namespace mnexus_backend::vulkan
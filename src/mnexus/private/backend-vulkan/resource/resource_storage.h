@@ -1,5 +1,8 @@
 #pragma once
 
+// c++ headers ------------------------------------------
+#include <memory>
+
 // public project headers -------------------------------
 #include "mbase/public/assert.h"
 
@@ -7,11 +10,13 @@
 
 // project headers --------------------------------------
 #include "resource_pool/resource_generational_pool.h"
+#include "resource_pool/sampler_cache.h"
 
 #include "backend-vulkan/backend-vulkan-buffer.h"
 #include "backend-vulkan/backend-vulkan-texture.h"
 #include "backend-vulkan/backend-vulkan-shader.h"
 #include "backend-vulkan/backend-vulkan-compute_pipeline.h"
+#include "backend-vulkan/resource/placed_buffer_allocator.h"
 
 namespace mnexus_backend::vulkan {
 
@@ -22,11 +27,45 @@ struct ResourceStorage final {
   ProgramResourcePool programs;
   ComputePipelineResourcePool compute_pipelines;
   SamplerResourcePool samplers;
+  resource_pool::SamplerCache sampler_cache;
 
   pipeline::TPipelineLayoutCache<VulkanPipelineLayoutPtr> pipeline_layout_cache;
 
+  std::unique_ptr<PlacedBufferAllocator> placed_buffer_allocator; // Null unless placed buffers are enabled; set only during initialization.
+
   resource_pool::ResourceHandle swapchain_texture_handle = resource_pool::ResourceHandle::Null(); // Not protected; set only during initialization.
 
+  /// Sum of the handle lookup counts of all resource pools.
+  uint64_t GetPoolLookupCount() const {
+    return buffers.GetLookupCount() + textures.GetLookupCount() + shader_modules.GetLookupCount() +
+      programs.GetLookupCount() + compute_pipelines.GetLookupCount() + samplers.GetLookupCount();
+  }
+  void ResetPoolLookupCounts() {
+    buffers.ResetLookupCount();
+    textures.ResetLookupCount();
+    shader_modules.ResetLookupCount();
+    programs.ResetLookupCount();
+    compute_pipelines.ResetLookupCount();
+    samplers.ResetLookupCount();
+  }
+
+  /// Records that an unsubmitted command list references a program, which keeps the program alive through
+  /// `DestroyProgram` until the list is submitted or discarded. Other resource types are not counted.
+  void AddListReference(resource_pool::ResourceHandle handle) {
+    if (handle.resource_type() == mnexus::kResourceTypeProgram) {
+      programs.LockSharedAndGetRefHot(handle).sync_stamp.AddListReference();
+      programs.UnlockShared();
+    }
+  }
+
+  /// Drops a reference added by `AddListReference`; after `StampResourceUse` if the list was submitted.
+  void ReleaseListReference(resource_pool::ResourceHandle handle) {
+    if (handle.resource_type() == mnexus::kResourceTypeProgram) {
+      programs.LockSharedAndGetRefHot(handle).sync_stamp.ReleaseListReference();
+      programs.UnlockShared();
+    }
+  }
+
   /// Stamp a resource's sync stamp to record that it was used in a GPU submission.
   void StampResourceUse(resource_pool::ResourceHandle handle, uint32_t queue_compact_index, uint64_t serial) {
     switch (handle.resource_type()) {
@@ -552,4 +552,16 @@ VkDescriptorType ToVkDescriptorType(mnexus::BindGroupLayoutEntryType value) {
   return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 }
 
+// ====================================================================================================
+// Shader stage flags
+//
+
+VkShaderStageFlags ToVkShaderStageFlags(mnexus::ShaderStageFlags stages) {
+  VkShaderStageFlags result = 0;
+  if (stages.HasAnyOf(mnexus::ShaderStageFlagBits::kVertex))   { result |= VK_SHADER_STAGE_VERTEX_BIT; }
+  if (stages.HasAnyOf(mnexus::ShaderStageFlagBits::kFragment)) { result |= VK_SHADER_STAGE_FRAGMENT_BIT; }
+  if (stages.HasAnyOf(mnexus::ShaderStageFlagBits::kCompute))  { result |= VK_SHADER_STAGE_COMPUTE_BIT; }
+  return result;
+}
+
 } // namespace mnexus_backend::vulkan
@@ -94,4 +94,10 @@ VkImageSubresourceLayers ToVkImageSubresourceLayers(mnexus::TextureSubresourceRa
 
 VkDescriptorType ToVkDescriptorType(mnexus::BindGroupLayoutEntryType value);
 
+// ----------------------------------------------------------------------------------------------------
+// Shader stage flags
+//
+
+VkShaderStageFlags ToVkShaderStageFlags(mnexus::ShaderStageFlags stages);
+
 } // namespace mnexus_backend::vulkan
@@ -226,6 +226,9 @@ WsiSwapchain WsiSwapchain::Create(VulkanInstance const* vk_instance, IVulkanDevi
 }
 
 bool WsiSwapchain::IsValid() const {
+  if (offscreen_ != nullptr) {
+    return true;
+  }
   MBASE_ASSERT_MSG(surface_.has_value() == (vk_swapchain_handle_ != VK_NULL_HANDLE), "Surface and swapchain handle state mismatch");
   return surface_.has_value();
 }
@@ -235,8 +238,13 @@ mnexus::TextureDesc const& WsiSwapchain::GetTextureDesc() const {
   return texture_desc_;
 }
 
+VkImageLayout WsiSwapchain::GetPresentVkImageLayout() const {
+  return offscreen_ != nullptr ? default_vk_image_layout_ : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+}
+
 bool WsiSwapchain::OnSourceCreated(mnexus::SurfaceSourceDesc const& source_desc) {
   MBASE_ASSERT_MSG(!surface_.has_value(), "Surface already created");
+  MBASE_ASSERT_MSG(offscreen_ == nullptr, "Offscreen swapchains have no surface");
 
   std::optional<WsiSurface> opt_surface = WsiSurface::Create(vk_instance_, source_desc);
   if (!opt_surface.has_value()) {
@@ -333,6 +341,20 @@ bool WsiSwapchain::OnSourceCreated(mnexus::SurfaceSourceDesc const& source_desc)
   return true;
 }
 
+void WsiSwapchain::OnOffscreenCreated(
+  std::vector<VulkanImage> images,
+  mnexus::TextureDesc const& texture_desc,
+  std::chrono::nanoseconds present_latency
+) {
+  MBASE_ASSERT_MSG(!surface_.has_value() && offscreen_ == nullptr, "Swapchain already created");
+  MBASE_ASSERT(!images.empty());
+
+  default_vk_image_layout_ = ImageLayoutTracker::GetDefaultLayout(images[0].vk_usage_flags(), images[0].vk_format());
+  texture_desc_ = texture_desc;
+  offscreen_ = std::make_unique<present::OffscreenSwapchain>(static_cast<uint32_t>(images.size()), present_latency);
+  vk_images_ = std::move(images);
+}
+
 void WsiSwapchain::OnSourceDestroyed() {
   MBASE_ASSERT_MSG(surface_.has_value(), "Surface not created");
 
@@ -387,6 +409,33 @@ void WsiSwapchain::ReturnImage(uint32_t image_index) {
   last_acquired_image_index_ = std::nullopt;
 }
 
+std::pair<uint32_t, VulkanImage const*> WsiSwapchain::AcquireNextOffscreenImage(
+  present::OffscreenSwapchain::WaitSerialFn const& wait_serial
+) {
+  MBASE_ASSERT_MSG(offscreen_ != nullptr, "Swapchain is not offscreen");
+
+  // May block on the present latency; not under `mutex_` so `GetLastAcquiredImage` callers are not held up.
+  uint32_t const image_index = offscreen_->AcquireNextImage(wait_serial);
+
+  mbase::LockGuard lock(mutex_);
+  last_acquired_image_index_ = image_index;
+  return std::make_pair(image_index, &vk_images_[image_index]);
+}
+
+void WsiSwapchain::PresentOffscreenImage(uint64_t serial) {
+  MBASE_ASSERT_MSG(offscreen_ != nullptr, "Swapchain is not offscreen");
+
+  offscreen_->Present(serial);
+
+  mbase::LockGuard lock(mutex_);
+  last_acquired_image_index_ = std::nullopt;
+}
+
+uint32_t WsiSwapchain::GetOffscreenQueueDepth(uint64_t completed_serial) const {
+  MBASE_ASSERT_MSG(offscreen_ != nullptr, "Swapchain is not offscreen");
+  return offscreen_->GetQueueDepth(completed_serial);
+}
+
 std::optional<std::pair<uint32_t, VulkanImage const*>> WsiSwapchain::GetLastAcquiredImage() const {
   mbase::LockGuard lock(mutex_);
   if (!last_acquired_image_index_.has_value()) {
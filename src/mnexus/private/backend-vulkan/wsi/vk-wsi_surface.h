@@ -1,6 +1,8 @@
 #pragma once
 
 // c++ headers ------------------------------------------
+#include <chrono>
+#include <memory>
 #include <optional>
 #include <vector>
 #include <mutex>
@@ -17,6 +19,8 @@
 #include "backend-vulkan/device/vk-device.h"
 #include "backend-vulkan/object/vk-object-image.h"
 
+#include "present/offscreen_swapchain.h"
+
 namespace mnexus_backend::vulkan {
 
 struct PhysicalDeviceSurfaceSupportInfo final {
@@ -70,6 +74,8 @@ struct VulkanSwapchainConfiguration final {
   );
 };
 
+// A surface swapchain, or, for a headless instance, an offscreen emulation of one (`OnOffscreenCreated`) whose images
+// are regular images cycled by a `present::OffscreenSwapchain`.
 class WsiSwapchain final {
 public:
   ~WsiSwapchain() = default;
@@ -81,10 +87,21 @@ public:
   VkSwapchainKHR GetVkSwapchainHandle() const { return vk_swapchain_handle_; }
   mnexus::TextureDesc const& GetTextureDesc() const;
   VkImageLayout GetDefaultVkImageLayout() const { return default_vk_image_layout_; }
+  /// The layout an image is handed to presentation in: `VK_IMAGE_LAYOUT_PRESENT_SRC_KHR`, or the default layout when
+  /// offscreen.
+  VkImageLayout GetPresentVkImageLayout() const;
 
   bool OnSourceCreated(mnexus::SurfaceSourceDesc const& source_desc);
   void OnSourceDestroyed();
 
+  /// Makes this an offscreen swapchain over `images`, which **MUST** all match `texture_desc`.
+  void OnOffscreenCreated(
+    std::vector<VulkanImage> images,
+    mnexus::TextureDesc const& texture_desc,
+    std::chrono::nanoseconds present_latency
+  );
+  bool IsOffscreen() const { return offscreen_ != nullptr; }
+
   std::optional<std::pair<uint32_t, VulkanImage const*>> AcquireNextImage(
     uint64_t timeout_ns,
     VkSemaphore nullable_signal_semaphore,
@@ -94,6 +111,14 @@ public:
   std::optional<std::pair<uint32_t, VulkanImage const*>> GetLastAcquiredImage() const;
   void ReturnImage(uint32_t image_index);
 
+  /// Offscreen counterpart of `AcquireNextImage`; blocks while the next image is still queued.
+  std::pair<uint32_t, VulkanImage const*> AcquireNextOffscreenImage(
+    present::OffscreenSwapchain::WaitSerialFn const& wait_serial
+  );
+  /// Offscreen counterpart of presenting and returning the acquired image.
+  void PresentOffscreenImage(uint64_t serial);
+  uint32_t GetOffscreenQueueDepth(uint64_t completed_serial) const;
+
 private:
   explicit WsiSwapchain(VulkanInstance const* vk_instance, IVulkanDevice const* vk_device)
     : vk_instance_(vk_instance), vk_device_(vk_device)
@@ -107,6 +132,7 @@ private:
   std::vector<VulkanImage> vk_images_;
   mnexus::TextureDesc texture_desc_;
   VkImageLayout default_vk_image_layout_ = VK_IMAGE_LAYOUT_UNDEFINED;
+  std::unique_ptr<present::OffscreenSwapchain> offscreen_;
 
   mbase::Lockable<std::mutex> mutable mutex_;
   std::optional<uint32_t> last_acquired_image_index_ MBASE_GUARDED_BY(mutex_);
@@ -19,11 +19,12 @@ namespace mnexus_backend::webgpu {
 
 /// Resolves dirty bind groups from the state tracker and sets them on the given pass encoder.
 /// Works with both `wgpu::ComputePassEncoder` and `wgpu::RenderPassEncoder`.
+/// Returns the number of bind groups created.
 ///
 /// - `TPassEncoder`: `wgpu::ComputePassEncoder` or `wgpu::RenderPassEncoder`
 /// - `TPipeline`: `wgpu::ComputePipeline` or `wgpu::RenderPipeline`
 template<typename TPassEncoder, typename TPipeline>
-void ResolveAndSetBindGroups(
+uint32_t ResolveAndSetBindGroups(
   wgpu::Device const& wgpu_device,
   TPassEncoder& pass,
   TPipeline const& pipeline,
@@ -32,6 +33,8 @@ void ResolveAndSetBindGroups(
   TextureResourcePool const& texture_pool,
   SamplerResourcePool const& sampler_pool
 ) {
+  uint32_t bind_group_count = 0;
+
   for (uint32_t group = 0; group < 4; ++group) {
     if (!state_tracker.IsGroupDirty(group)) {
       continue;
@@ -96,9 +99,12 @@ void ResolveAndSetBindGroups(
 
     wgpu::BindGroup bind_group = wgpu_device.CreateBindGroup(&bind_group_desc);
     pass.SetBindGroup(group, bind_group);
+    ++bind_group_count;
 
     state_tracker.MarkGroupClean(group);
   }
+
+  return bind_group_count;
 }
 
 } // namespace mnexus_backend::webgpu
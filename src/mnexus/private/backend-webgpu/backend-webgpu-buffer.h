@@ -1,6 +1,9 @@
 #pragma once
 
 // c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <memory>
 #include <mutex>
 
 // public project headers -------------------------------
@@ -14,6 +17,9 @@ namespace mnexus_backend::webgpu {
 
 struct BufferHot final {
   wgpu::Buffer wgpu_buffer;
+  /// CPU copy handed out by `MapBuffer`; allocated at creation for `kMappable` buffers and never replaced, so it can be
+  /// read under the shared pool lock. Null for other buffers.
+  std::unique_ptr<uint8_t[]> mapped_shadow;
 };
 struct BufferCold final {
   mnexus::BufferDesc desc;
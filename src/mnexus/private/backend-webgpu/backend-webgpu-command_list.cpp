@@ -1,13 +1,19 @@
 // TU header --------------------------------------------
 #include "backend-webgpu/backend-webgpu-command_list.h"
 
+// c++ headers ------------------------------------------
+#include <cstring>
+
 // public project headers -------------------------------
 #include "mbase/public/assert.h"
+#include "mbase/public/log.h"
 
 // project headers --------------------------------------
 #include "backend-webgpu/backend-webgpu-binding.h"
 #include "backend-webgpu/blit_texture.h"
 #include "backend-webgpu/buffer_row_repack.h"
+#include "backend-webgpu/generate_mipmaps.h"
+#include "backend-webgpu/push_constants.h"
 #include "backend-webgpu/types_bridge.h"
 
 namespace mnexus_backend::webgpu {
@@ -15,13 +21,35 @@ namespace mnexus_backend::webgpu {
 MnexusCommandListWebGpu::MnexusCommandListWebGpu(
   ResourceStorage* resource_storage,
   wgpu::Device wgpu_device,
-  wgpu::CommandEncoder wgpu_command_encoder
+  wgpu::CommandEncoder wgpu_command_encoder,
+  std::unique_ptr<profiling::GpuTimingRecorder> gpu_timing_recorder
 ) :
   resource_storage_(resource_storage),
   wgpu_device_(std::move(wgpu_device)),
-  wgpu_command_encoder_(std::move(wgpu_command_encoder))
+  wgpu_command_encoder_(std::move(wgpu_command_encoder)),
+  scratch_allocator_(&resource_storage->scratch_arena),
+  gpu_timing_recorder_(std::move(gpu_timing_recorder))
 {
   render_pipeline_state_tracker_.SetEventLog(&render_state_event_log_);
+
+  if (gpu_timing_recorder_ != nullptr) {
+    wgpu::QuerySetDescriptor query_set_desc {
+      .type = wgpu::QueryType::Timestamp,
+      .count = gpu_timing_recorder_->GetQueryCapacity(),
+    };
+    gpu_timing_query_set_ = wgpu_device_.CreateQuerySet(&query_set_desc);
+  }
+}
+
+std::optional<GpuTimingResolve> MnexusCommandListWebGpu::TakeGpuTimingResolve() {
+  if (gpu_timing_recorder_ == nullptr || !gpu_timing_readback_buffer_) {
+    return std::nullopt;
+  }
+
+  return GpuTimingResolve {
+    .recorder = std::move(gpu_timing_recorder_),
+    .readback_buffer = std::move(gpu_timing_readback_buffer_),
+  };
 }
 
 // --------------------------------------------------------------------------------------------------
@@ -32,6 +60,10 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::End() {
   MBASE_ASSERT_MSG(!current_render_pass_.has_value(),
     "Active render pass must be ended via EndRenderPass before calling End");
   this->EndCurrentComputePass();
+
+  if (gpu_timing_recorder_ != nullptr) {
+    this->ResolveGpuTimingQueries();
+  }
 }
 
 //
@@ -42,6 +74,10 @@ MNEXUS_NO_THROW mnexus::RenderStateEventLog& MNEXUS_CALL MnexusCommandListWebGpu
   return render_state_event_log_;
 }
 
+MNEXUS_NO_THROW mnexus::PerfCountersSnapshot MNEXUS_CALL MnexusCommandListWebGpu::GetPerfCountersSnapshot() {
+  return perf_counters_.Snapshot();
+}
+
 //
 // Debug Markers
 //
@@ -59,6 +95,11 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::PushDebugGroup(
   } else {
     wgpu_command_encoder_.PushDebugGroup(label.c_str());
   }
+
+  if (gpu_timing_recorder_ != nullptr) {
+    // Timestamps can only be written at pass boundaries; the group is timed by the passes it encloses.
+    gpu_timing_recorder_->PushScope(label, mnexus::GpuTimingScopeKind::kDebugGroup, /*timestamped=*/false);
+  }
 }
 
 MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::PopDebugGroup() {
@@ -69,6 +110,10 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::PopDebugGroup() {
   } else {
     wgpu_command_encoder_.PopDebugGroup();
   }
+
+  if (gpu_timing_recorder_ != nullptr) {
+    gpu_timing_recorder_->PopScope();
+  }
 }
 
 //
@@ -179,18 +224,24 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::CopyBufferToTexture(
     wgpu_command_encoder_.CopyBufferToTexture(&src, &dst, &wgpu_copy_size);
   } else if (bytes_per_row_unaligned % 4 == 0) {
     // Compute repack path: use internal compute shader to repack rows into an aligned temp buffer.
-    wgpu::Buffer temp_buffer = buffer_row_repack::RepackRows(
+    buffer_row_repack::RepackResult const repacked = buffer_row_repack::RepackRows(
       wgpu_device_,
       wgpu_command_encoder_,
+      scratch_allocator_,
       src_buffer_hot.wgpu_buffer,
       src_buffer_offset,
       bytes_per_row_unaligned,
       bytes_per_row_aligned,
       rows_per_image
     );
+    perf_counters_.Add(profiling::PerfCounter::kBindGroupCreations, repacked.bind_groups_created);
+    if (!repacked.rows) {
+      MBASE_LOG_ERROR("CopyBufferToTexture: failed to allocate scratch memory for row repacking");
+      return;
+    }
     wgpu::TexelCopyBufferInfo src {};
-    src.buffer = temp_buffer;
-    src.layout.offset = 0;
+    src.buffer = repacked.rows.page->buffer();
+    src.layout.offset = repacked.rows.offset;
     src.layout.bytesPerRow = bytes_per_row_aligned;
     src.layout.rowsPerImage = rows_per_image;
     wgpu_command_encoder_.CopyBufferToTexture(&src, &dst, &wgpu_copy_size);
@@ -295,9 +346,10 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::BlitTexture(
   wgpu::TextureFormat const src_format = ToWgpuTextureFormat(src_cold.desc.format);
   wgpu::TextureFormat const dst_format = ToWgpuTextureFormat(dst_cold.desc.format);
 
-  blit_texture::BlitTexture2D(
+  uint32_t const bind_groups_created = blit_texture::BlitTexture2D(
     wgpu_device_,
     wgpu_command_encoder_,
+    scratch_allocator_,
     src_hot.wgpu_texture, src_format, src_subresource_range,
     src_offset.x, src_offset.y,
     src_extent.width, src_extent.height,
@@ -306,6 +358,45 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::BlitTexture(
     dst_extent.width, dst_extent.height,
     filter
   );
+  perf_counters_.Add(profiling::PerfCounter::kBindGroupCreations, bind_groups_created);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::GenerateMipmaps(
+  mnexus::TextureHandle texture_handle,
+  mnexus::TextureSubresourceRange const& subresource_range
+) {
+  // Internal passes conflict with user's; end any active one.
+  this->EndCurrentRenderPass();
+  this->EndCurrentComputePass();
+
+  auto pool_handle = resource_pool::ResourceHandle::FromU64(texture_handle.Get());
+  auto [hot, cold, lock] = resource_storage_->textures.GetConstRefWithSharedLockGuard(pool_handle);
+
+  if (!hot.wgpu_texture) {
+    return;
+  }
+
+  MBASE_ASSERT(subresource_range.base_mip_level + subresource_range.mip_level_count <= cold.desc.mip_level_count);
+
+  uint32_t const bind_group_count = generate_mipmaps::GenerateMipmaps2D(
+    wgpu_device_,
+    wgpu_command_encoder_,
+    scratch_allocator_,
+    hot.wgpu_texture,
+    ToWgpuTextureFormat(cold.desc.format),
+    subresource_range
+  );
+  perf_counters_.Add(profiling::PerfCounter::kBindGroupCreations, bind_group_count);
+}
+
+//
+// Synchronization
+//
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::TransitionTextures(
+  mnexus::container::ArrayProxy<mnexus::TextureTransitionDesc const> /*transitions*/
+) {
+  // WebGPU synchronizes texture usage implicitly; there is nothing to prepare.
 }
 
 //
@@ -322,12 +413,19 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::BindExplicitComputePip
   auto [hot, lock] = resource_storage_->compute_pipelines.GetHotConstRefWithSharedLockGuard(pool_handle);
 
   if (!current_compute_pass_.has_value()) {
-    wgpu::ComputePassEncoder pass = wgpu_command_encoder_.BeginComputePass();
+    wgpu::PassTimestampWrites timestamp_writes;
+    wgpu::ComputePassDescriptor pass_desc {
+      .timestampWrites = this->BeginGpuTimingPassScope(mnexus::GpuTimingScopeKind::kComputePass, timestamp_writes),
+    };
+    wgpu::ComputePassEncoder pass = wgpu_command_encoder_.BeginComputePass(&pass_desc);
     current_compute_pass_ = std::move(pass);
   }
 
   current_compute_pipeline_ = hot.wgpu_compute_pipeline;
+  current_compute_pipeline_has_push_constants_ = hot.has_push_constants;
   current_compute_pass_->SetPipeline(current_compute_pipeline_);
+  perf_counters_.Add(profiling::PerfCounter::kPipelineSwitches);
+  this->OnPipelineBound(hot.has_push_constants);
 }
 
 MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::DispatchCompute(
@@ -337,7 +435,7 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::DispatchCompute(
 ) {
   MBASE_ASSERT(current_compute_pass_.has_value());
 
-  ResolveAndSetBindGroups(
+  uint32_t const bind_group_count = ResolveAndSetBindGroups(
     wgpu_device_,
     *current_compute_pass_,
     current_compute_pipeline_,
@@ -346,8 +444,11 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::DispatchCompute(
     resource_storage_->textures,
     resource_storage_->samplers
   );
+  perf_counters_.Add(profiling::PerfCounter::kBindGroupCreations, bind_group_count);
+  this->FlushPushConstants(*current_compute_pass_, current_compute_pipeline_has_push_constants_);
 
   current_compute_pass_->DispatchWorkgroups(workgroup_count_x, workgroup_count_y, workgroup_count_z);
+  perf_counters_.Add(profiling::PerfCounter::kDispatches);
 }
 
 //
@@ -402,6 +503,27 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::BindSampler(
   );
 }
 
+//
+// Push Constants
+//
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::SetPushConstants(
+  mnexus::ShaderStageFlags stages,
+  uint32_t offset,
+  void const* data,
+  uint32_t size_in_bytes
+) {
+  MBASE_ASSERT_MSG(bool(stages), "SetPushConstants requires at least one shader stage");
+  MBASE_ASSERT_MSG(offset % 4 == 0 && size_in_bytes % 4 == 0,
+    "Push constant offset and size must be multiples of 4");
+  MBASE_ASSERT_MSG(uint64_t { offset } + size_in_bytes <= mnexus::kMaxPushConstantSizeInBytes,
+    "Push constant range exceeds kMaxPushConstantSizeInBytes");
+
+  // A single uniform block backs every stage, so `stages` only matters for validation on this backend.
+  std::memcpy(push_constant_data_.data() + offset, data, size_in_bytes);
+  push_constants_dirty_ = true;
+}
+
 //
 // Explicit Pipeline Binding
 //
@@ -412,6 +534,7 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::BindExplicitRenderPipe
   auto pool_handle = resource_pool::ResourceHandle::FromU64(render_pipeline_handle.Get());
   auto [hot, lock] = resource_storage_->render_pipelines.GetHotConstRefWithSharedLockGuard(pool_handle);
   current_render_pipeline_ = hot.wgpu_render_pipeline;
+  current_render_pipeline_has_push_constants_ = hot.has_push_constants;
   explicit_render_pipeline_bound_ = true;
   render_pipeline_state_tracker_.MarkClean();
 }
@@ -505,14 +628,23 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::BeginRenderPass(
     }
   }
 
+  wgpu::PassTimestampWrites timestamp_writes;
+
   wgpu::RenderPassDescriptor pass_desc {
     .colorAttachmentCount = wgpu_color_attachments.size(),
     .colorAttachments = wgpu_color_attachments.data(),
     .depthStencilAttachment = has_depth_stencil ? &wgpu_depth_stencil : nullptr,
+    .timestampWrites = this->BeginGpuTimingPassScope(mnexus::GpuTimingScopeKind::kRenderPass, timestamp_writes),
   };
 
   current_render_pass_ = wgpu_command_encoder_.BeginRenderPass(&pass_desc);
 
+  current_render_target_signature_ = pipeline::RenderTargetSignature {
+    .color_formats = color_formats,
+    .depth_stencil_format = depth_stencil_format,
+    .sample_count = 1, // Always 1 for now.
+  };
+
   // Configure state tracker with render target info.
   render_pipeline_state_tracker_.SetRenderTargetConfig(
     std::move(color_formats),
@@ -691,6 +823,7 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::Draw(
   MBASE_ASSERT_MSG(current_render_pass_.has_value(), "Draw called outside of a render pass");
 
   this->ResolveRenderPipelineAndBindState();
+  perf_counters_.Add(profiling::PerfCounter::kDraws);
 
   if (render_state_event_log_.IsEnabled()) {
     render_state_event_log_.Record(
@@ -711,6 +844,7 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::DrawIndexed(
   MBASE_ASSERT_MSG(current_render_pass_.has_value(), "DrawIndexed called outside of a render pass");
 
   this->ResolveRenderPipelineAndBindState();
+  perf_counters_.Add(profiling::PerfCounter::kDraws);
 
   if (render_state_event_log_.IsEnabled()) {
     render_state_event_log_.Record(
@@ -745,6 +879,35 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::SetScissor(
   );
 }
 
+//
+// Render Bundle
+//
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusCommandListWebGpu::ExecuteBundles(
+  mnexus::container::ArrayProxy<mnexus::RenderBundleHandle const> render_bundles
+) {
+  MBASE_ASSERT_MSG(current_render_pass_.has_value(), "ExecuteBundles called outside of a render pass");
+
+  mbase::SmallVector<wgpu::RenderBundle, 8> wgpu_render_bundles;
+  wgpu_render_bundles.reserve(render_bundles.size());
+
+  for (uint32_t i = 0; i < render_bundles.size(); ++i) {
+    auto pool_handle = resource_pool::ResourceHandle::FromU64(render_bundles[i].Get());
+    auto [hot, cold, lock] = resource_storage_->render_bundles.GetConstRefWithSharedLockGuard(pool_handle);
+    MBASE_ASSERT_MSG(cold.signature.Matches(current_render_target_signature_),
+      "Render bundle signature does not match the current render pass attachments");
+    wgpu_render_bundles.emplace_back(hot.wgpu_render_bundle);
+  }
+
+  current_render_pass_->ExecuteBundles(wgpu_render_bundles.size(), wgpu_render_bundles.data());
+
+  // WebGPU resets the pass's pipeline, bind groups and vertex/index buffers after executing bundles.
+  // Force everything to be re-applied at the next draw.
+  render_pipeline_state_tracker_.MarkDirty();
+  bind_group_state_tracker_.MarkAllGroupsDirty();
+  push_constant_group_bound_ = false;
+}
+
 // --------------------------------------------------------------------------------------------------
 // Private helpers
 //
@@ -753,6 +916,11 @@ void MnexusCommandListWebGpu::EndCurrentComputePass() {
   if (current_compute_pass_.has_value()) {
     current_compute_pass_->End();
     current_compute_pass_ = std::nullopt;
+    push_constant_group_bound_ = false;
+
+    if (gpu_timing_recorder_ != nullptr) {
+      gpu_timing_recorder_->PopScope();
+    }
   }
 }
 
@@ -760,7 +928,63 @@ void MnexusCommandListWebGpu::EndCurrentRenderPass() {
   if (current_render_pass_.has_value()) {
     current_render_pass_->End();
     current_render_pass_ = std::nullopt;
+    push_constant_group_bound_ = false;
+
+    if (gpu_timing_recorder_ != nullptr) {
+      gpu_timing_recorder_->PopScope();
+    }
+  }
+}
+
+wgpu::PassTimestampWrites const* MnexusCommandListWebGpu::BeginGpuTimingPassScope(
+  mnexus::GpuTimingScopeKind kind,
+  wgpu::PassTimestampWrites& out_timestamp_writes
+) {
+  if (gpu_timing_recorder_ == nullptr) {
+    return nullptr;
+  }
+
+  std::string_view const name = kind == mnexus::GpuTimingScopeKind::kRenderPass ? "RenderPass" : "ComputePass";
+  uint32_t const scope_index = gpu_timing_recorder_->PushScope(name, kind, /*timestamped=*/true);
+
+  profiling::GpuTimingRecorder::Scope const& scope = gpu_timing_recorder_->GetScope(scope_index);
+  if (scope.begin_query == profiling::GpuTimingRecorder::kNoQuery) {
+    return nullptr;
+  }
+
+  out_timestamp_writes = wgpu::PassTimestampWrites {
+    .querySet = gpu_timing_query_set_,
+    .beginningOfPassWriteIndex = scope.begin_query,
+    .endOfPassWriteIndex = scope.end_query,
+  };
+  return &out_timestamp_writes;
+}
+
+void MnexusCommandListWebGpu::ResolveGpuTimingQueries() {
+  MBASE_ASSERT_MSG(gpu_timing_recorder_->GetOpenScopeCount() == 0,
+    "Every PushDebugGroup must be matched by a PopDebugGroup before calling End");
+
+  uint32_t const query_count = gpu_timing_recorder_->GetQueryCount();
+  if (query_count == 0) {
+    return;
   }
+
+  uint64_t const size_in_bytes = uint64_t { query_count } * sizeof(uint64_t);
+
+  wgpu::BufferDescriptor resolve_desc {
+    .usage = wgpu::BufferUsage::QueryResolve | wgpu::BufferUsage::CopySrc,
+    .size = size_in_bytes,
+  };
+  wgpu::Buffer resolve_buffer = wgpu_device_.CreateBuffer(&resolve_desc);
+
+  wgpu::BufferDescriptor readback_desc {
+    .usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst,
+    .size = size_in_bytes,
+  };
+  gpu_timing_readback_buffer_ = wgpu_device_.CreateBuffer(&readback_desc);
+
+  wgpu_command_encoder_.ResolveQuerySet(gpu_timing_query_set_, 0, query_count, resolve_buffer, 0);
+  wgpu_command_encoder_.CopyBufferToBuffer(resolve_buffer, 0, gpu_timing_readback_buffer_, 0, size_in_bytes);
 }
 
 void MnexusCommandListWebGpu::ResolveRenderPipelineAndBindState() {
@@ -769,6 +993,8 @@ void MnexusCommandListWebGpu::ResolveRenderPipelineAndBindState() {
   if (explicit_render_pipeline_bound_) {
     // Explicit pipeline: just set it on the pass (once).
     current_render_pass_->SetPipeline(current_render_pipeline_);
+    perf_counters_.Add(profiling::PerfCounter::kPipelineSwitches);
+    this->OnPipelineBound(current_render_pipeline_has_push_constants_);
   } else if (render_pipeline_state_tracker_.IsDirty()) {
     pipeline::RenderPipelineCacheKey key = render_pipeline_state_tracker_.BuildCacheKey();
     render_pipeline_state_tracker_.MarkClean();
@@ -786,6 +1012,7 @@ void MnexusCommandListWebGpu::ResolveRenderPipelineAndBindState() {
       },
       &cache_hit
     );
+    perf_counters_.Add(cache_hit ? profiling::PerfCounter::kPipelineCacheHits : profiling::PerfCounter::kPipelineCacheMisses);
 
     if (render_state_event_log_.IsEnabled()) {
       render_state_event_log_.RecordPso(
@@ -794,11 +1021,19 @@ void MnexusCommandListWebGpu::ResolveRenderPipelineAndBindState() {
         cache_hit);
     }
 
+    {
+      auto program_pool_handle = resource_pool::ResourceHandle::FromU64(key.program.Get());
+      auto [program_hot, program_lock] = resource_storage_->programs.GetHotConstRefWithSharedLockGuard(program_pool_handle);
+      current_render_pipeline_has_push_constants_ = program_hot.has_push_constants;
+    }
+
     current_render_pass_->SetPipeline(current_render_pipeline_);
+    perf_counters_.Add(profiling::PerfCounter::kPipelineSwitches);
+    this->OnPipelineBound(current_render_pipeline_has_push_constants_);
   }
 
   // Resolve and set bind groups.
-  ResolveAndSetBindGroups(
+  uint32_t const bind_group_count = ResolveAndSetBindGroups(
     wgpu_device_,
     *current_render_pass_,
     current_render_pipeline_,
@@ -807,6 +1042,8 @@ void MnexusCommandListWebGpu::ResolveRenderPipelineAndBindState() {
     resource_storage_->textures,
     resource_storage_->samplers
   );
+  perf_counters_.Add(profiling::PerfCounter::kBindGroupCreations, bind_group_count);
+  this->FlushPushConstants(*current_render_pass_, current_render_pipeline_has_push_constants_);
 
   // Set vertex buffers.
   for (size_t i = 0; i < bound_vertex_buffers_.size(); ++i) {
@@ -831,4 +1068,32 @@ void MnexusCommandListWebGpu::ResolveRenderPipelineAndBindState() {
   }
 }
 
+void MnexusCommandListWebGpu::OnPipelineBound(bool has_push_constants) {
+  if (!has_push_constants && push_constant_group_bound_) {
+    // The new program may use the group itself; re-apply whatever the user bound there.
+    bind_group_state_tracker_.MarkGroupDirty(push_constants::kBindGroup);
+    push_constant_group_bound_ = false;
+  }
+}
+
+template<typename TPassEncoder>
+void MnexusCommandListWebGpu::FlushPushConstants(TPassEncoder& pass, bool pipeline_has_push_constants) {
+  if (!pipeline_has_push_constants || (!push_constants_dirty_ && push_constant_group_bound_)) {
+    return;
+  }
+
+  push_constants::UploadResult const upload =
+    push_constants::Upload(wgpu_device_, scratch_allocator_, push_constant_data_.data());
+  if (!upload.bind_group) {
+    MBASE_LOG_ERROR("Failed to allocate scratch memory for push constants");
+    return;
+  }
+
+  pass.SetBindGroup(push_constants::kBindGroup, upload.bind_group, 1, &upload.dynamic_offset);
+  perf_counters_.Add(profiling::PerfCounter::kBindGroupCreations, upload.bind_groups_created);
+
+  push_constants_dirty_ = false;
+  push_constant_group_bound_ = true;
+}
+
 } // namespace mnexus_backend::webgpu
@@ -1,6 +1,10 @@
 #pragma once
 
 // c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <array>
+#include <memory>
 #include <mutex>
 #include <optional>
 
@@ -14,15 +18,18 @@
 // project headers --------------------------------------
 #include "backend-webgpu/backend-webgpu-buffer.h"
 #include "backend-webgpu/backend-webgpu-compute_pipeline.h"
+#include "backend-webgpu/backend-webgpu-render_bundle.h"
 #include "backend-webgpu/backend-webgpu-render_pipeline.h"
 #include "backend-webgpu/backend-webgpu-sampler.h"
 #include "backend-webgpu/backend-webgpu-shader.h"
 #include "backend-webgpu/backend-webgpu-texture.h"
 #include "backend-webgpu/include_dawn.h"
+#include "backend-webgpu/scratch_arena.h"
 
 #include "binding/state_tracker.h"
 
 #include "resource_pool/generational_pool.h"
+#include "resource_pool/sampler_cache.h"
 
 #include "pipeline/pipeline_layout_cache.h"
 #include "pipeline/render_pipeline_cache.h"
@@ -30,6 +37,9 @@
 
 #include "pipeline/render_pipeline_state_tracker.h"
 
+#include "profiling/gpu_timing.h"
+#include "profiling/perf_counters.h"
+
 namespace mnexus_backend::webgpu {
 
 struct ResourceStorage final {
@@ -37,24 +47,55 @@ struct ResourceStorage final {
   ProgramResourcePool programs;
   ComputePipelineResourcePool compute_pipelines;
   RenderPipelineResourcePool render_pipelines;
+  RenderBundleResourcePool render_bundles;
 
   BufferResourcePool buffers;
   TextureResourcePool textures;
   SamplerResourcePool samplers;
+  resource_pool::SamplerCache sampler_cache;
 
   pipeline::TPipelineLayoutCache<wgpu::PipelineLayout> pipeline_layout_cache;
   pipeline::TRenderPipelineCache<wgpu::RenderPipeline> render_pipeline_cache;
 
+  /// Scratch pages for internal passes; leased by command lists and retired by the device at submission.
+  ScratchArena scratch_arena;
+
   std::mutex swapchain_texture_mutex; // Protects `TextureHot` and `TextureCold`.
   resource_pool::ResourceHandle swapchain_texture_handle = resource_pool::ResourceHandle::Null(); // Not protected; set only during initialization.
+
+  /// Sum of the handle lookup counts of all resource pools.
+  uint64_t GetPoolLookupCount() const {
+    return shader_modules.GetLookupCount() + programs.GetLookupCount() + compute_pipelines.GetLookupCount() +
+      render_pipelines.GetLookupCount() + render_bundles.GetLookupCount() + buffers.GetLookupCount() +
+      textures.GetLookupCount() + samplers.GetLookupCount();
+  }
+  void ResetPoolLookupCounts() {
+    shader_modules.ResetLookupCount();
+    programs.ResetLookupCount();
+    compute_pipelines.ResetLookupCount();
+    render_pipelines.ResetLookupCount();
+    render_bundles.ResetLookupCount();
+    buffers.ResetLookupCount();
+    textures.ResetLookupCount();
+    samplers.ResetLookupCount();
+  }
+};
+
+/// GPU timing data of a finished command list, handed over to the device at submission.
+struct GpuTimingResolve final {
+  std::unique_ptr<profiling::GpuTimingRecorder> recorder;
+  /// `MapRead` buffer receiving one `uint64_t` per used query slot once the submission completes.
+  wgpu::Buffer readback_buffer;
 };
 
 class MnexusCommandListWebGpu : public mnexus::ICommandList {
 public:
+  /// `gpu_timing_recorder` is null unless GPU timing was enabled when the command list was created.
   explicit MnexusCommandListWebGpu(
     ResourceStorage* resource_storage,
     wgpu::Device wgpu_device,
-    wgpu::CommandEncoder wgpu_command_encoder
+    wgpu::CommandEncoder wgpu_command_encoder,
+    std::unique_ptr<profiling::GpuTimingRecorder> gpu_timing_recorder = nullptr
   );
   ~MnexusCommandListWebGpu() override = default;
   MBASE_DISALLOW_COPY_MOVE(MnexusCommandListWebGpu);
@@ -63,6 +104,14 @@ public:
     return wgpu_command_encoder_;
   }
 
+  /// Moves out the GPU timing data recorded by this command list. Returns `std::nullopt` if the command list was not
+  /// instrumented or wrote no timestamps.
+  std::optional<GpuTimingResolve> TakeGpuTimingResolve();
+
+  [[nodiscard]] profiling::CommandListPerfCounters const& perf_counters() const { return perf_counters_; }
+
+  [[nodiscard]] ScratchAllocator& scratch_allocator() { return scratch_allocator_; }
+
   // --------------------------------------------------------------------------------------------------
   // mnexus::ICommandList implementation
   //
@@ -74,6 +123,7 @@ public:
   //
 
   IMPL_VAPI(mnexus::RenderStateEventLog&, GetStateEventLog);
+  IMPL_VAPI(mnexus::PerfCountersSnapshot, GetPerfCountersSnapshot);
 
   //
   // Debug Markers
@@ -120,6 +170,19 @@ public:
     mnexus::Filter filter
   );
 
+  IMPL_VAPI(void, GenerateMipmaps,
+    mnexus::TextureHandle texture_handle,
+    mnexus::TextureSubresourceRange const& subresource_range
+  );
+
+  //
+  // Synchronization
+  //
+
+  IMPL_VAPI(void, TransitionTextures,
+    mnexus::container::ArrayProxy<mnexus::TextureTransitionDesc const> transitions
+  );
+
   //
   // Compute
   //
@@ -161,6 +224,17 @@ public:
     mnexus::SamplerHandle sampler_handle
   );
 
+  //
+  // Push Constants
+  //
+
+  IMPL_VAPI(void, SetPushConstants,
+    mnexus::ShaderStageFlags stages,
+    uint32_t offset,
+    void const* data,
+    uint32_t size_in_bytes
+  );
+
   //
   // Explicit Pipeline Binding
   //
@@ -264,6 +338,14 @@ public:
     int32_t x, int32_t y, uint32_t width, uint32_t height
   );
 
+  //
+  // Render Bundle
+  //
+
+  IMPL_VAPI(void, ExecuteBundles,
+    mnexus::container::ArrayProxy<mnexus::RenderBundleHandle const> render_bundles
+  );
+
 private:
   struct BoundVertexBuffer {
     mnexus::BufferHandle buffer_handle;
@@ -279,9 +361,26 @@ private:
   void EndCurrentComputePass();
   void EndCurrentRenderPass();
 
+  /// Opens a GPU timing scope for a pass about to begin. Returns the timestamp writes to chain into the pass
+  /// descriptor, or null if the command list is not instrumented or the query capacity is exhausted.
+  wgpu::PassTimestampWrites const* BeginGpuTimingPassScope(
+    mnexus::GpuTimingScopeKind kind,
+    wgpu::PassTimestampWrites& out_timestamp_writes
+  );
+  /// Encodes the resolution of all written timestamps into `gpu_timing_readback_buffer_`.
+  void ResolveGpuTimingQueries();
+
   /// Resolves the render pipeline from the state tracker, binds it and any dirty bind groups/vertex buffers.
   void ResolveRenderPipelineAndBindState();
 
+  /// Called whenever a pipeline is bound. Hands the push constant bind group slot back to the bind group state
+  /// tracker if the new pipeline does not declare push constants.
+  void OnPipelineBound(bool has_push_constants);
+  /// Uploads the push constant data and sets its bind group on `pass` if the bound pipeline declares push constants
+  /// and the data changed or is not bound in this pass yet.
+  template<typename TPassEncoder>
+  void FlushPushConstants(TPassEncoder& pass, bool pipeline_has_push_constants);
+
   ResourceStorage* resource_storage_ = nullptr;
   wgpu::Device wgpu_device_;
   wgpu::CommandEncoder wgpu_command_encoder_;
@@ -295,11 +394,28 @@ private:
   wgpu::RenderPipeline current_render_pipeline_;
   bool explicit_render_pipeline_bound_ = false;
   pipeline::RenderPipelineStateTracker render_pipeline_state_tracker_;
+  pipeline::RenderTargetSignature current_render_target_signature_;
   mnexus::RenderStateEventLog render_state_event_log_;
   mbase::SmallVector<BoundVertexBuffer, 4> bound_vertex_buffers_;
   BoundIndexBuffer bound_index_buffer_;
 
   binding::BindGroupStateTracker bind_group_state_tracker_;
+
+  // Push constant state. The data is uploaded lazily at the next dispatch/draw whose pipeline uses it.
+  std::array<uint8_t, mnexus::kMaxPushConstantSizeInBytes> push_constant_data_ {};
+  bool push_constants_dirty_ = false;
+  bool push_constant_group_bound_ = false; // Whether `push_constants::kBindGroup` of the current pass holds them.
+  bool current_compute_pipeline_has_push_constants_ = false;
+  bool current_render_pipeline_has_push_constants_ = false;
+
+  ScratchAllocator scratch_allocator_;
+
+  profiling::CommandListPerfCounters perf_counters_;
+
+  // GPU timing state. All null unless instrumented.
+  std::unique_ptr<profiling::GpuTimingRecorder> gpu_timing_recorder_;
+  wgpu::QuerySet gpu_timing_query_set_;
+  wgpu::Buffer gpu_timing_readback_buffer_;
 };
 
 } // namespace mnexus_backend::webgpu
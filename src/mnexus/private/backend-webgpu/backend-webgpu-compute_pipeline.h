@@ -11,6 +11,8 @@ namespace mnexus_backend::webgpu {
 
 struct ComputePipelineHot final {
   wgpu::ComputePipeline wgpu_compute_pipeline;
+  /// Copied from the program; see `ProgramHot::has_push_constants`.
+  bool has_push_constants = false;
 };
 struct ComputePipelineCold final {
   
@@ -0,0 +1,366 @@
+// TU header --------------------------------------------
+#include "backend-webgpu/backend-webgpu-render_bundle.h"
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+
+// project headers --------------------------------------
+#include "backend-webgpu/backend-webgpu-binding.h"
+#include "backend-webgpu/backend-webgpu-command_list.h"
+#include "backend-webgpu/types_bridge.h"
+
+namespace mnexus_backend::webgpu {
+
+// --------------------------------------------------------------------------------------------------
+// MnexusRenderBundleEncoderWebGpu
+//
+
+MnexusRenderBundleEncoderWebGpu::MnexusRenderBundleEncoderWebGpu(
+  ResourceStorage* resource_storage,
+  wgpu::Device wgpu_device,
+  mnexus::RenderBundleDesc const& desc
+) :
+  resource_storage_(resource_storage),
+  wgpu_device_(std::move(wgpu_device))
+{
+  mbase::SmallVector<wgpu::TextureFormat, 4> wgpu_color_formats;
+  wgpu_color_formats.reserve(desc.color_formats.size());
+  render_target_signature_.color_formats.reserve(desc.color_formats.size());
+
+  for (uint32_t i = 0; i < desc.color_formats.size(); ++i) {
+    wgpu_color_formats.emplace_back(ToWgpuTextureFormat(desc.color_formats[i]));
+    render_target_signature_.color_formats.emplace_back(desc.color_formats[i]);
+  }
+  render_target_signature_.depth_stencil_format = desc.depth_stencil_format;
+  render_target_signature_.sample_count = desc.sample_count;
+
+  wgpu::RenderBundleEncoderDescriptor encoder_desc {};
+  encoder_desc.colorFormatCount = wgpu_color_formats.size();
+  encoder_desc.colorFormats = wgpu_color_formats.data();
+  encoder_desc.depthStencilFormat = desc.depth_stencil_format == mnexus::Format::kUndefined
+    ? wgpu::TextureFormat::Undefined
+    : ToWgpuTextureFormat(desc.depth_stencil_format);
+  encoder_desc.sampleCount = desc.sample_count;
+  encoder_desc.depthReadOnly = desc.depth_read_only != MnBoolFalse;
+  encoder_desc.stencilReadOnly = desc.stencil_read_only != MnBoolFalse;
+
+  wgpu_render_bundle_encoder_ = wgpu_device_.CreateRenderBundleEncoder(&encoder_desc);
+
+  // The render target signature is fixed for the lifetime of the encoder.
+  render_pipeline_state_tracker_.SetRenderTargetConfig(
+    render_target_signature_.color_formats,
+    render_target_signature_.depth_stencil_format,
+    render_target_signature_.sample_count
+  );
+}
+
+wgpu::RenderBundle MnexusRenderBundleEncoderWebGpu::Finish() {
+  wgpu::RenderBundleDescriptor bundle_desc {};
+  return wgpu_render_bundle_encoder_.Finish(&bundle_desc);
+}
+
+//
+// Explicit Pipeline Binding
+//
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::BindExplicitRenderPipeline(
+  mnexus::RenderPipelineHandle render_pipeline_handle
+) {
+  auto pool_handle = resource_pool::ResourceHandle::FromU64(render_pipeline_handle.Get());
+  auto [hot, lock] = resource_storage_->render_pipelines.GetHotConstRefWithSharedLockGuard(pool_handle);
+  current_render_pipeline_ = hot.wgpu_render_pipeline;
+  explicit_render_pipeline_bound_ = true;
+  explicit_render_pipeline_dirty_ = true;
+  render_pipeline_state_tracker_.MarkClean();
+}
+
+//
+// Resource Binding
+//
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::BindUniformBuffer(
+  mnexus::BindingId const& id,
+  mnexus::BufferHandle buffer_handle,
+  uint64_t offset,
+  uint64_t size
+) {
+  bind_group_state_tracker_.SetBuffer(
+    id.group, id.binding, id.array_element,
+    mnexus::BindGroupLayoutEntryType::kUniformBuffer,
+    buffer_handle, offset, size
+  );
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::BindStorageBuffer(
+  mnexus::BindingId const& id,
+  mnexus::BufferHandle buffer_handle,
+  uint64_t offset,
+  uint64_t size
+) {
+  bind_group_state_tracker_.SetBuffer(
+    id.group, id.binding, id.array_element,
+    mnexus::BindGroupLayoutEntryType::kStorageBuffer,
+    buffer_handle, offset, size
+  );
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::BindSampledTexture(
+  mnexus::BindingId const& id,
+  mnexus::TextureHandle texture_handle,
+  mnexus::TextureSubresourceRange const& subresource_range
+) {
+  bind_group_state_tracker_.SetTexture(
+    id.group, id.binding, id.array_element,
+    mnexus::BindGroupLayoutEntryType::kSampledTexture,
+    texture_handle, subresource_range
+  );
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::BindSampler(
+  mnexus::BindingId const& id,
+  mnexus::SamplerHandle sampler_handle
+) {
+  bind_group_state_tracker_.SetSampler(
+    id.group, id.binding, id.array_element,
+    sampler_handle
+  );
+}
+
+//
+// Render State (auto-generation path)
+//
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::BindRenderProgram(
+  mnexus::ProgramHandle program_handle
+) {
+  explicit_render_pipeline_bound_ = false;
+  render_pipeline_state_tracker_.SetProgram(program_handle);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetVertexInputLayout(
+  mnexus::container::ArrayProxy<mnexus::VertexInputBindingDesc const> bindings,
+  mnexus::container::ArrayProxy<mnexus::VertexInputAttributeDesc const> attributes
+) {
+  mbase::SmallVector<mnexus::VertexInputBindingDesc, 4> bindings_vec;
+  bindings_vec.reserve(bindings.size());
+  for (uint32_t i = 0; i < bindings.size(); ++i) {
+    bindings_vec.emplace_back(bindings[i]);
+  }
+
+  mbase::SmallVector<mnexus::VertexInputAttributeDesc, 8> attributes_vec;
+  attributes_vec.reserve(attributes.size());
+  for (uint32_t i = 0; i < attributes.size(); ++i) {
+    attributes_vec.emplace_back(attributes[i]);
+  }
+
+  render_pipeline_state_tracker_.SetVertexInputLayout(
+    std::move(bindings_vec),
+    std::move(attributes_vec)
+  );
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::BindVertexBuffer(
+  uint32_t binding,
+  mnexus::BufferHandle buffer_handle,
+  uint64_t offset
+) {
+  if (binding >= bound_vertex_buffers_.size()) {
+    bound_vertex_buffers_.resize(binding + 1);
+  }
+  bound_vertex_buffers_[binding] = BoundVertexBuffer {
+    .buffer_handle = buffer_handle,
+    .offset = offset,
+  };
+  vertex_buffers_dirty_ = true;
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::BindIndexBuffer(
+  mnexus::BufferHandle buffer_handle,
+  uint64_t offset,
+  mnexus::IndexType index_type
+) {
+  bound_index_buffer_ = BoundIndexBuffer {
+    .buffer_handle = buffer_handle,
+    .offset = offset,
+    .index_type = index_type,
+  };
+  index_buffer_dirty_ = true;
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetPrimitiveTopology(
+  mnexus::PrimitiveTopology topology
+) {
+  render_pipeline_state_tracker_.SetPrimitiveTopology(topology);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetPolygonMode(
+  mnexus::PolygonMode mode
+) {
+  render_pipeline_state_tracker_.SetPolygonMode(mode);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetCullMode(
+  mnexus::CullMode cull_mode
+) {
+  render_pipeline_state_tracker_.SetCullMode(cull_mode);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetFrontFace(
+  mnexus::FrontFace front_face
+) {
+  render_pipeline_state_tracker_.SetFrontFace(front_face);
+}
+
+// Depth
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetDepthTestEnabled(bool enabled) {
+  render_pipeline_state_tracker_.SetDepthTestEnabled(enabled);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetDepthWriteEnabled(bool enabled) {
+  render_pipeline_state_tracker_.SetDepthWriteEnabled(enabled);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetDepthCompareOp(mnexus::CompareOp op) {
+  render_pipeline_state_tracker_.SetDepthCompareOp(op);
+}
+
+// Stencil
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetStencilTestEnabled(bool enabled) {
+  render_pipeline_state_tracker_.SetStencilTestEnabled(enabled);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetStencilFrontOps(
+  mnexus::StencilOp fail, mnexus::StencilOp pass,
+  mnexus::StencilOp depth_fail, mnexus::CompareOp compare
+) {
+  render_pipeline_state_tracker_.SetStencilFrontOps(fail, pass, depth_fail, compare);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetStencilBackOps(
+  mnexus::StencilOp fail, mnexus::StencilOp pass,
+  mnexus::StencilOp depth_fail, mnexus::CompareOp compare
+) {
+  render_pipeline_state_tracker_.SetStencilBackOps(fail, pass, depth_fail, compare);
+}
+
+// Per-attachment blend
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetBlendEnabled(
+  uint32_t attachment, bool enabled
+) {
+  render_pipeline_state_tracker_.SetBlendEnabled(attachment, enabled);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetBlendFactors(
+  uint32_t attachment,
+  mnexus::BlendFactor src_color, mnexus::BlendFactor dst_color, mnexus::BlendOp color_op,
+  mnexus::BlendFactor src_alpha, mnexus::BlendFactor dst_alpha, mnexus::BlendOp alpha_op
+) {
+  render_pipeline_state_tracker_.SetBlendFactors(
+    attachment, src_color, dst_color, color_op, src_alpha, dst_alpha, alpha_op
+  );
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::SetColorWriteMask(
+  uint32_t attachment, mnexus::ColorWriteMask mask
+) {
+  render_pipeline_state_tracker_.SetColorWriteMask(attachment, mask);
+}
+
+//
+// Draw
+//
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::Draw(
+  uint32_t vertex_count,
+  uint32_t instance_count,
+  uint32_t first_vertex,
+  uint32_t first_instance
+) {
+  this->ResolveRenderPipelineAndBindState();
+  wgpu_render_bundle_encoder_.Draw(vertex_count, instance_count, first_vertex, first_instance);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnexusRenderBundleEncoderWebGpu::DrawIndexed(
+  uint32_t index_count,
+  uint32_t instance_count,
+  uint32_t first_index,
+  int32_t vertex_offset,
+  uint32_t first_instance
+) {
+  this->ResolveRenderPipelineAndBindState();
+  wgpu_render_bundle_encoder_.DrawIndexed(index_count, instance_count, first_index, vertex_offset, first_instance);
+}
+
+// --------------------------------------------------------------------------------------------------
+// Private helpers
+//
+
+void MnexusRenderBundleEncoderWebGpu::ResolveRenderPipelineAndBindState() {
+  if (explicit_render_pipeline_bound_) {
+    if (explicit_render_pipeline_dirty_) {
+      wgpu_render_bundle_encoder_.SetPipeline(current_render_pipeline_);
+      explicit_render_pipeline_dirty_ = false;
+    }
+  } else if (render_pipeline_state_tracker_.IsDirty()) {
+    pipeline::RenderPipelineCacheKey key = render_pipeline_state_tracker_.BuildCacheKey();
+    render_pipeline_state_tracker_.MarkClean();
+
+    bool cache_hit = false;
+    wgpu::RenderPipeline resolved = resource_storage_->render_pipeline_cache.FindOrInsert(
+      key,
+      [&](pipeline::RenderPipelineCacheKey const& k) {
+        return CreateWgpuRenderPipelineFromCacheKey(
+          wgpu_device_,
+          k,
+          resource_storage_->programs,
+          resource_storage_->shader_modules
+        );
+      },
+      &cache_hit
+    );
+
+    if (resolved.Get() != current_render_pipeline_.Get()) {
+      current_render_pipeline_ = std::move(resolved);
+      wgpu_render_bundle_encoder_.SetPipeline(current_render_pipeline_);
+    }
+  }
+
+  ResolveAndSetBindGroups(
+    wgpu_device_,
+    wgpu_render_bundle_encoder_,
+    current_render_pipeline_,
+    bind_group_state_tracker_,
+    resource_storage_->buffers,
+    resource_storage_->textures,
+    resource_storage_->samplers
+  );
+
+  if (vertex_buffers_dirty_) {
+    for (size_t i = 0; i < bound_vertex_buffers_.size(); ++i) {
+      auto const& vb = bound_vertex_buffers_[i];
+      if (!vb.buffer_handle.IsValid()) {
+        continue;
+      }
+      auto pool_handle = resource_pool::ResourceHandle::FromU64(vb.buffer_handle.Get());
+      auto [hot, lock] = resource_storage_->buffers.GetHotConstRefWithSharedLockGuard(pool_handle);
+      wgpu_render_bundle_encoder_.SetVertexBuffer(static_cast<uint32_t>(i), hot.wgpu_buffer, vb.offset);
+    }
+    vertex_buffers_dirty_ = false;
+  }
+
+  if (index_buffer_dirty_ && bound_index_buffer_.buffer_handle.IsValid()) {
+    auto pool_handle = resource_pool::ResourceHandle::FromU64(bound_index_buffer_.buffer_handle.Get());
+    auto [hot, lock] = resource_storage_->buffers.GetHotConstRefWithSharedLockGuard(pool_handle);
+    wgpu_render_bundle_encoder_.SetIndexBuffer(
+      hot.wgpu_buffer,
+      ToWgpuIndexFormat(bound_index_buffer_.index_type),
+      bound_index_buffer_.offset
+    );
+    index_buffer_dirty_ = false;
+  }
+}
+
+} // namespace mnexus_backend::webgpu
@@ -0,0 +1,202 @@
+#pragma once
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/container.h"
+
+#include "mnexus/public/mnexus.h"
+#include "mnexus/public/types.h"
+
+// project headers --------------------------------------
+#include "resource_pool/resource_generational_pool.h"
+
+#include "backend-webgpu/include_dawn.h"
+
+#include "binding/state_tracker.h"
+
+#include "impl/impl_macros.h"
+
+#include "pipeline/render_pipeline_state_tracker.h"
+#include "pipeline/render_target_signature.h"
+
+namespace mnexus_backend::webgpu {
+
+// backend-webgpu-command_list.h
+struct ResourceStorage;
+
+struct RenderBundleHot final {
+  wgpu::RenderBundle wgpu_render_bundle;
+};
+struct RenderBundleCold final {
+  pipeline::RenderTargetSignature signature;
+};
+
+using RenderBundleResourcePool = resource_pool::TResourceGenerationalPool<RenderBundleHot, RenderBundleCold, mnexus::kResourceTypeRenderBundle>;
+
+class MnexusRenderBundleEncoderWebGpu final : public mnexus::IRenderBundleEncoder {
+public:
+  explicit MnexusRenderBundleEncoderWebGpu(
+    ResourceStorage* resource_storage,
+    wgpu::Device wgpu_device,
+    mnexus::RenderBundleDesc const& desc
+  );
+  ~MnexusRenderBundleEncoderWebGpu() override = default;
+  MBASE_DISALLOW_COPY_MOVE(MnexusRenderBundleEncoderWebGpu);
+
+  /// Finalizes recording. No further commands may be recorded afterwards.
+  wgpu::RenderBundle Finish();
+
+  pipeline::RenderTargetSignature const& GetRenderTargetSignature() const {
+    return render_target_signature_;
+  }
+
+  // --------------------------------------------------------------------------------------------------
+  // mnexus::IRenderBundleEncoder implementation
+  //
+
+  //
+  // Explicit Pipeline Binding
+  //
+
+  IMPL_VAPI(void, BindExplicitRenderPipeline, mnexus::RenderPipelineHandle render_pipeline_handle);
+
+  //
+  // Resource Binding
+  //
+
+  IMPL_VAPI(void, BindUniformBuffer,
+    mnexus::BindingId const& id,
+    mnexus::BufferHandle buffer_handle,
+    uint64_t offset,
+    uint64_t size
+  );
+
+  IMPL_VAPI(void, BindStorageBuffer,
+    mnexus::BindingId const& id,
+    mnexus::BufferHandle buffer_handle,
+    uint64_t offset,
+    uint64_t size
+  );
+
+  IMPL_VAPI(void, BindSampledTexture,
+    mnexus::BindingId const& id,
+    mnexus::TextureHandle texture_handle,
+    mnexus::TextureSubresourceRange const& subresource_range
+  );
+
+  IMPL_VAPI(void, BindSampler,
+    mnexus::BindingId const& id,
+    mnexus::SamplerHandle sampler_handle
+  );
+
+  //
+  // Render State (auto-generation path)
+  //
+
+  IMPL_VAPI(void, BindRenderProgram, mnexus::ProgramHandle program_handle);
+
+  IMPL_VAPI(void, SetVertexInputLayout,
+    mnexus::container::ArrayProxy<mnexus::VertexInputBindingDesc const> bindings,
+    mnexus::container::ArrayProxy<mnexus::VertexInputAttributeDesc const> attributes
+  );
+
+  IMPL_VAPI(void, BindVertexBuffer,
+    uint32_t binding,
+    mnexus::BufferHandle buffer_handle,
+    uint64_t offset
+  );
+
+  IMPL_VAPI(void, BindIndexBuffer,
+    mnexus::BufferHandle buffer_handle,
+    uint64_t offset,
+    mnexus::IndexType index_type
+  );
+
+  IMPL_VAPI(void, SetPrimitiveTopology, mnexus::PrimitiveTopology topology);
+  IMPL_VAPI(void, SetPolygonMode, mnexus::PolygonMode mode);
+  IMPL_VAPI(void, SetCullMode, mnexus::CullMode cull_mode);
+  IMPL_VAPI(void, SetFrontFace, mnexus::FrontFace front_face);
+
+  // Depth
+  IMPL_VAPI(void, SetDepthTestEnabled, bool enabled);
+  IMPL_VAPI(void, SetDepthWriteEnabled, bool enabled);
+  IMPL_VAPI(void, SetDepthCompareOp, mnexus::CompareOp op);
+
+  // Stencil
+  IMPL_VAPI(void, SetStencilTestEnabled, bool enabled);
+
+  IMPL_VAPI(void, SetStencilFrontOps,
+    mnexus::StencilOp fail, mnexus::StencilOp pass,
+    mnexus::StencilOp depth_fail, mnexus::CompareOp compare
+  );
+
+  IMPL_VAPI(void, SetStencilBackOps,
+    mnexus::StencilOp fail, mnexus::StencilOp pass,
+    mnexus::StencilOp depth_fail, mnexus::CompareOp compare
+  );
+
+  // Per-attachment blend
+  IMPL_VAPI(void, SetBlendEnabled, uint32_t attachment, bool enabled);
+
+  IMPL_VAPI(void, SetBlendFactors,
+    uint32_t attachment,
+    mnexus::BlendFactor src_color, mnexus::BlendFactor dst_color, mnexus::BlendOp color_op,
+    mnexus::BlendFactor src_alpha, mnexus::BlendFactor dst_alpha, mnexus::BlendOp alpha_op
+  );
+
+  IMPL_VAPI(void, SetColorWriteMask, uint32_t attachment, mnexus::ColorWriteMask mask);
+
+  //
+  // Draw
+  //
+
+  IMPL_VAPI(void, Draw,
+    uint32_t vertex_count,
+    uint32_t instance_count,
+    uint32_t first_vertex,
+    uint32_t first_instance
+  );
+
+  IMPL_VAPI(void, DrawIndexed,
+    uint32_t index_count,
+    uint32_t instance_count,
+    uint32_t first_index,
+    int32_t vertex_offset,
+    uint32_t first_instance
+  );
+
+private:
+  struct BoundVertexBuffer {
+    mnexus::BufferHandle buffer_handle;
+    uint64_t offset = 0;
+  };
+
+  struct BoundIndexBuffer {
+    mnexus::BufferHandle buffer_handle;
+    uint64_t offset = 0;
+    mnexus::IndexType index_type = mnexus::IndexType::kUint32;
+  };
+
+  /// Same as `MnexusCommandListWebGpu::ResolveRenderPipelineAndBindState`, except that only state that changed since
+  /// the previous draw is encoded, since everything encoded here is replayed on every execution of the bundle.
+  void ResolveRenderPipelineAndBindState();
+
+  ResourceStorage* resource_storage_ = nullptr;
+  wgpu::Device wgpu_device_;
+  wgpu::RenderBundleEncoder wgpu_render_bundle_encoder_;
+  pipeline::RenderTargetSignature render_target_signature_;
+
+  wgpu::RenderPipeline current_render_pipeline_;
+  bool explicit_render_pipeline_bound_ = false;
+  bool explicit_render_pipeline_dirty_ = false;
+  pipeline::RenderPipelineStateTracker render_pipeline_state_tracker_;
+
+  mbase::SmallVector<BoundVertexBuffer, 4> bound_vertex_buffers_;
+  bool vertex_buffers_dirty_ = false;
+  BoundIndexBuffer bound_index_buffer_;
+  bool index_buffer_dirty_ = false;
+
+  binding::BindGroupStateTracker bind_group_state_tracker_;
+};
+
+} // namespace mnexus_backend::webgpu
@@ -11,6 +11,8 @@ namespace mnexus_backend::webgpu {
 
 struct RenderPipelineHot final {
   wgpu::RenderPipeline wgpu_render_pipeline;
+  /// Copied from the program; see `ProgramHot::has_push_constants`.
+  bool has_push_constants = false;
 };
 struct RenderPipelineCold final {
 };
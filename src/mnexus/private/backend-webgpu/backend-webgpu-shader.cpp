@@ -10,6 +10,7 @@
 #include "mbase/public/assert.h"
 
 // project headers --------------------------------------
+#include "backend-webgpu/push_constants.h"
 #include "backend-webgpu/shader_module.h"
 #include "shader/wgsl.h"
 
@@ -103,9 +104,24 @@ resource_pool::ResourceHandle EmplaceProgramResourcePool(
   }
 
   mbase::ArrayProxy<shader::BindGroupLayout const> merged_layouts = merged_pipeline_layout.GetBindGroupLayouts();
+  shader::PushConstantRange const& merged_push_constant_range = merged_pipeline_layout.GetPushConstantRange();
+  bool const has_push_constants = !merged_push_constant_range.IsEmpty();
+
+  if (has_push_constants) {
+    if (merged_push_constant_range.end() > mnexus::kMaxPushConstantSizeInBytes) {
+      MBASE_LOG_ERROR("Push constant block ends at byte {}, exceeding the {} byte limit",
+        merged_push_constant_range.end(), mnexus::kMaxPushConstantSizeInBytes);
+      return resource_pool::ResourceHandle::Null();
+    }
+    if (!merged_layouts.empty() && merged_layouts[merged_layouts.size() - 1].set >= push_constants::kBindGroup) {
+      MBASE_LOG_ERROR("Programs with push constants cannot use bind group {}; it holds the emulated push constants",
+        push_constants::kBindGroup);
+      return resource_pool::ResourceHandle::Null();
+    }
+  }
 
   // Phase 2: Look up or create the pipeline layout via cache.
-  pipeline::PipelineLayoutCacheKey layout_key = pipeline::BuildPipelineLayoutCacheKey(merged_layouts);
+  pipeline::PipelineLayoutCacheKey layout_key = pipeline::BuildPipelineLayoutCacheKey(merged_layouts, merged_push_constant_range);
 
   wgpu::PipelineLayout pipeline_layout = pipeline_layout_cache.FindOrInsert(
     layout_key,
@@ -172,6 +188,15 @@ resource_pool::ResourceHandle EmplaceProgramResourcePool(
         wgpu_bind_group_layouts.push_back(wgpu_device.CreateBindGroupLayout(&wgpu_bgl_desc));
       }
 
+      // Push constants live in the last bind group; fill any gap before it with empty layouts.
+      if (has_push_constants) {
+        while (wgpu_bind_group_layouts.size() < push_constants::kBindGroup) {
+          wgpu::BindGroupLayoutDescriptor empty_bgl_desc {};
+          wgpu_bind_group_layouts.push_back(wgpu_device.CreateBindGroupLayout(&empty_bgl_desc));
+        }
+        wgpu_bind_group_layouts.push_back(push_constants::GetBindGroupLayout());
+      }
+
       // Create PipelineLayout from bind group layouts.
       wgpu::PipelineLayoutDescriptor pipeline_layout_desc {};
       pipeline_layout_desc.bindGroupLayoutCount = wgpu_bind_group_layouts.size();
@@ -181,7 +206,10 @@ resource_pool::ResourceHandle EmplaceProgramResourcePool(
   );
 
   // Phase 3: Emplace into pool and return handle.
-  ProgramHot hot { .wgpu_pipeline_layout = std::move(pipeline_layout) };
+  ProgramHot hot {
+    .wgpu_pipeline_layout = std::move(pipeline_layout),
+    .has_push_constants = has_push_constants,
+  };
 
   ProgramCold cold {};
   cold.shader_module_handles.reserve(program_desc.shader_modules.size());
@@ -46,6 +46,8 @@ resource_pool::ResourceHandle EmplaceShaderModuleResourcePool(
 
 struct ProgramHot final {
   wgpu::PipelineLayout wgpu_pipeline_layout;
+  /// Whether the layout carries the push constant bind group (`push_constants::kBindGroup`).
+  bool has_push_constants = false;
 };
 struct ProgramCold final {
   mbase::SmallVector<mnexus::ShaderModuleHandle, 2> shader_module_handles;
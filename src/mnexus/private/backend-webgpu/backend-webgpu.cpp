@@ -3,7 +3,11 @@
 
 // c++ headers ------------------------------------------
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -36,6 +40,7 @@
 #include "backend-webgpu/backend-webgpu-binding.h"
 #include "backend-webgpu/backend-webgpu-buffer.h"
 #include "backend-webgpu/backend-webgpu-layout.h"
+#include "backend-webgpu/backend-webgpu-render_bundle.h"
 #include "backend-webgpu/backend-webgpu-render_pipeline.h"
 #include "backend-webgpu/backend-webgpu-shader.h"
 #include "backend-webgpu/backend-webgpu-sampler.h"
@@ -45,14 +50,64 @@
 #include "backend-webgpu/builtin_shader.h"
 #include "backend-webgpu/blit_texture.h"
 #include "backend-webgpu/buffer_row_repack.h"
+#include "backend-webgpu/generate_mipmaps.h"
+#include "backend-webgpu/push_constants.h"
+#include "backend-webgpu/submission_thread.h"
+#include "backend-webgpu/texture_view_cache.h"
 
 #include "pipeline/pipeline_layout_cache.h"
 #include "pipeline/render_pipeline_cache.h"
 #include "pipeline/render_pipeline_state_tracker.h"
 
+#include "profiling/gpu_timing.h"
+#include "profiling/memory_tracker.h"
+#include "profiling/perf_counters.h"
+
+#include "present/offscreen_swapchain.h"
+
+#include "sync/queue_completion.h"
+
 namespace mnexus_backend::webgpu {
 
-class MnexusDeviceWebGpu : public mnexus::IDevice {
+namespace {
+
+/// Timestamp query slots per instrumented command list (two per timed pass).
+constexpr uint32_t kGpuTimingQueryCapacity = 256;
+
+/// Source data layout of a `TextureWriteRegion`, with the tightly packed defaults resolved.
+struct TextureWriteLayout final {
+  uint32_t row_pitch;
+  uint32_t rows_per_image;
+  uint64_t data_size;
+};
+
+TextureWriteLayout ComputeTextureWriteLayout(mnexus::Format format, mnexus::TextureWriteRegion const& region) {
+  uint32_t const format_size = MnGetFormatSizeInBytes(static_cast<MnFormat>(format));
+  MnExtent3d const block_extent = MnGetFormatTexelBlockExtent(static_cast<MnFormat>(format));
+
+  uint32_t const row_size = (region.extent.width + block_extent.width - 1) / block_extent.width * format_size;
+  uint32_t const block_rows = (region.extent.height + block_extent.height - 1) / block_extent.height;
+  uint32_t const image_count = region.extent.depth * region.subresource_range.array_layer_count;
+
+  TextureWriteLayout layout {
+    .row_pitch = region.row_pitch != 0 ? region.row_pitch : row_size,
+    .rows_per_image = region.rows_per_image != 0 ? region.rows_per_image : block_rows,
+    .data_size = 0,
+  };
+  MBASE_ASSERT_MSG(layout.row_pitch >= row_size, "row_pitch is smaller than a row of the region");
+  MBASE_ASSERT_MSG(layout.rows_per_image >= block_rows, "rows_per_image is smaller than the region's height");
+
+  if (row_size != 0 && block_rows != 0 && image_count != 0) {
+    // The last row of the last image is not padded.
+    layout.data_size =
+      (uint64_t { image_count - 1 } * layout.rows_per_image + (block_rows - 1)) * layout.row_pitch + row_size;
+  }
+  return layout;
+}
+
+} // namespace
+
+class MnexusDeviceWebGpu : public mnexus::IDevice, private IQueueCompletionSource {
 public:
   // ----------------------------------------------------------------------------------------------------
   // mnexus::IDevice implementation
@@ -91,17 +146,200 @@ public:
   ) {
     MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
 
+    if (submission_thread_.IsRunning()) {
+      uint64_t const value = this->ReserveTimelineValue();
+      submission_thread_.Enqueue(value, [this, command_list, value]() {
+        mbase::LockGuard queue_lock(queue_mutex_);
+        this->ExecuteSubmitCommandList(command_list, value);
+      });
+      return mnexus::IntraQueueSubmissionId { value };
+    }
+
+    mbase::LockGuard queue_lock(queue_mutex_);
+
+    uint64_t const value = this->ReserveTimelineValue();
+    this->ExecuteSubmitCommandList(command_list, value);
+    return mnexus::IntraQueueSubmissionId { value };
+  }
+
+  IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueWriteBuffer,
+    mnexus::QueueId const& queue_id,
+    mnexus::BufferHandle buffer_handle,
+    uint32_t buffer_offset,
+    void const* data,
+    uint32_t data_size_in_bytes
+  ) {
+    MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
+
+    if (submission_thread_.IsRunning()) {
+      // The caller's memory is only guaranteed for the duration of the call; the copy happens outside any lock.
+      auto const* bytes = static_cast<uint8_t const*>(data);
+      std::vector<uint8_t> payload(bytes, bytes + data_size_in_bytes);
+
+      uint64_t const value = this->ReserveTimelineValue();
+      submission_thread_.Enqueue(value, [this, buffer_handle, buffer_offset, payload = std::move(payload), value]() {
+        mbase::LockGuard queue_lock(queue_mutex_);
+        this->ExecuteWriteBuffer(buffer_handle, buffer_offset, payload.data(), static_cast<uint32_t>(payload.size()), value);
+      });
+      return mnexus::IntraQueueSubmissionId { value };
+    }
+
+    mbase::LockGuard queue_lock(queue_mutex_);
+
+    uint64_t const value = this->ReserveTimelineValue();
+    this->ExecuteWriteBuffer(buffer_handle, buffer_offset, data, data_size_in_bytes, value);
+    return mnexus::IntraQueueSubmissionId { value };
+  }
+
+  IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueReadBuffer,
+    mnexus::QueueId const& queue_id,
+    mnexus::BufferHandle buffer_handle,
+    uint32_t buffer_offset,
+    void* dst,
+    uint32_t size_in_bytes
+  ) {
+    MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
+    MBASE_ASSERT_MSG((buffer_offset % 4) == 0, "buffer_offset must be 4-byte aligned");
+    MBASE_ASSERT_MSG((size_in_bytes % 4) == 0, "size_in_bytes must be 4-byte aligned");
+
+    if (submission_thread_.IsRunning()) {
+      uint64_t const value = this->ReserveTimelineValue();
+      submission_thread_.Enqueue(value, [this, buffer_handle, buffer_offset, dst, size_in_bytes, value]() {
+        mbase::LockGuard queue_lock(queue_mutex_);
+        this->ExecuteReadBuffer(buffer_handle, buffer_offset, dst, size_in_bytes, value);
+      });
+      return mnexus::IntraQueueSubmissionId { value };
+    }
+
+    mbase::LockGuard queue_lock(queue_mutex_);
+
+    uint64_t const value = this->ReserveTimelineValue();
+    this->ExecuteReadBuffer(buffer_handle, buffer_offset, dst, size_in_bytes, value);
+    return mnexus::IntraQueueSubmissionId { value };
+  }
+
+  IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueReadTexture,
+    mnexus::QueueId const& queue_id,
+    mnexus::TextureHandle texture_handle,
+    mnexus::TextureSubresourceRange const& subresource_range,
+    mnexus::Extent3d const& copy_extent,
+    void* dst,
+    uint64_t dst_size_in_bytes
+  ) {
+    MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
+
+    if (submission_thread_.IsRunning()) {
+      {
+        auto pool_handle = resource_pool::ResourceHandle::FromU64(texture_handle.Get());
+        auto [hot, lock] = resource_storage_->textures.GetHotConstRefWithSharedLockGuard(pool_handle);
+        if (!hot.wgpu_texture) {
+          MBASE_LOG_ERROR("QueueReadTexture: texture has no backing texture");
+          return mnexus::IntraQueueSubmissionId { 0 };
+        }
+      }
+
+      uint64_t const value = this->ReserveTimelineValue();
+      submission_thread_.Enqueue(
+        value,
+        [this, texture_handle, subresource_range, copy_extent, dst, dst_size_in_bytes, value]() {
+          mbase::LockGuard queue_lock(queue_mutex_);
+          this->ExecuteReadTexture(texture_handle, subresource_range, copy_extent, dst, dst_size_in_bytes, value);
+        }
+      );
+      return mnexus::IntraQueueSubmissionId { value };
+    }
+
     mbase::LockGuard queue_lock(queue_mutex_);
 
+    uint64_t const value = this->ReserveTimelineValue();
+    if (!this->ExecuteReadTexture(texture_handle, subresource_range, copy_extent, dst, dst_size_in_bytes, value)) {
+      return mnexus::IntraQueueSubmissionId { 0 };
+    }
+    return mnexus::IntraQueueSubmissionId { value };
+  }
+
+  IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueWriteTexture,
+    mnexus::QueueId const& queue_id,
+    mnexus::TextureHandle texture_handle,
+    mnexus::container::ArrayProxy<mnexus::TextureWriteRegion const> regions
+  ) {
+    MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
+    MBASE_ASSERT_MSG(!regions.empty(), "QueueWriteTexture requires at least one region");
+
+    if (submission_thread_.IsRunning()) {
+      std::vector<mnexus::TextureWriteRegion> owned_regions(regions.begin(), regions.end());
+      std::vector<uint64_t> data_offsets;
+      std::vector<uint8_t> payload;
+      {
+        auto pool_handle = resource_pool::ResourceHandle::FromU64(texture_handle.Get());
+        auto [hot, cold, lock] = resource_storage_->textures.GetConstRefWithSharedLockGuard(pool_handle);
+        if (!hot.wgpu_texture) {
+          MBASE_LOG_ERROR("QueueWriteTexture: texture has no backing texture");
+          return mnexus::IntraQueueSubmissionId { 0 };
+        }
+
+        // All regions are copied into one allocation; the pointers are rebased on the submission thread.
+        data_offsets.reserve(owned_regions.size());
+        for (mnexus::TextureWriteRegion const& region : owned_regions) {
+          data_offsets.push_back(payload.size());
+          uint64_t const data_size = ComputeTextureWriteLayout(cold.desc.format, region).data_size;
+          auto const* bytes = static_cast<uint8_t const*>(region.data);
+          payload.insert(payload.end(), bytes, bytes + data_size);
+        }
+      }
+
+      uint64_t const value = this->ReserveTimelineValue();
+      submission_thread_.Enqueue(
+        value,
+        [this, texture_handle, owned_regions = std::move(owned_regions), data_offsets = std::move(data_offsets),
+         payload = std::move(payload), value]() mutable {
+          for (size_t i = 0; i < owned_regions.size(); ++i) {
+            owned_regions[i].data = payload.data() + data_offsets[i];
+          }
+
+          mbase::LockGuard queue_lock(queue_mutex_);
+          this->ExecuteWriteTexture(
+            texture_handle,
+            mnexus::container::ArrayProxy<mnexus::TextureWriteRegion const>(
+              owned_regions.data(), static_cast<uint32_t>(owned_regions.size())
+            ),
+            value
+          );
+        }
+      );
+      return mnexus::IntraQueueSubmissionId { value };
+    }
+
+    mbase::LockGuard queue_lock(queue_mutex_);
+
+    uint64_t const value = this->ReserveTimelineValue();
+    if (!this->ExecuteWriteTexture(texture_handle, regions, value)) {
+      return mnexus::IntraQueueSubmissionId { 0 };
+    }
+    return mnexus::IntraQueueSubmissionId { value };
+  }
+
+  // Queue operations. Run under `queue_mutex_`, either on the calling thread or on the submission thread, with the
+  // timeline value reserved by the caller.
+
+  void ExecuteSubmitCommandList(
+    mnexus::ICommandList* command_list,
+    uint64_t timeline_value
+  ) MBASE_REQUIRES(queue_mutex_) {
     this->PollPendingOps();
 
     // Downcast to our command list implementation.
     MnexusCommandListWebGpu* webgpu_command_list = dynamic_cast<MnexusCommandListWebGpu*>(command_list);
 
     wgpu::CommandBuffer wgpu_command_buffer = webgpu_command_list->GetWgpuCommandEncoder().Finish();
+    std::optional<GpuTimingResolve> gpu_timing_resolve = webgpu_command_list->TakeGpuTimingResolve();
 
     wgpu::Queue wgpu_queue = wgpu_device_.GetQueue();
+    // Queue writes are ordered before the submit, so the internal passes see their params.
+    webgpu_command_list->scratch_allocator().FlushUniforms(wgpu_queue);
+    std::vector<ScratchPage*> const scratch_pages = webgpu_command_list->scratch_allocator().TakePages();
     wgpu_queue.Submit(1, &wgpu_command_buffer);
+    perf_counters_.Add(profiling::PerfCounter::kSubmits);
 
     this->DiscardCommandList(command_list);
 
@@ -115,30 +353,51 @@ public:
       }
     );
 
-    mnexus::IntraQueueSubmissionId const id = this->AdvanceTimeline();
+    this->CommitTimelineValue(timeline_value);
 
     pending_ops_.emplace_back(
       PendingOp {
-        .timeline_value = id.Get(),
+        .timeline_value = timeline_value,
         .future = work_done_future,
+        .readback = std::nullopt,
       }
     );
 
+    if (!scratch_pages.empty()) {
+      resource_storage_->scratch_arena.RetirePages(scratch_pages, timeline_value);
+    }
+
+    if (gpu_timing_resolve.has_value()) {
+      // Tracked apart from `pending_ops_`: resolved by `PollPendingOps` once mapped, or on demand in `GetGpuTimingReport`.
+      wgpu::Future map_future = gpu_timing_resolve->readback_buffer.MapAsync(
+        wgpu::MapMode::Read, 0, gpu_timing_resolve->readback_buffer.GetSize(),
+        wgpu::CallbackMode::WaitAnyOnly,
+        [](wgpu::MapAsyncStatus status, wgpu::StringView message) {
+          if (status != wgpu::MapAsyncStatus::Success) {
+            MBASE_LOG_ERROR("MapAsync failed (GPU timing): {}", message);
+          }
+        }
+      );
+
+      pending_gpu_timings_.emplace_back(
+        PendingGpuTiming {
+          .timeline_value = timeline_value,
+          .resolve = std::move(*gpu_timing_resolve),
+          .map_future = map_future,
+        }
+      );
+    }
+
     this->UpdateCompletedValue();
-    return id;
   }
 
-  IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueWriteBuffer,
-    mnexus::QueueId const& queue_id,
+  void ExecuteWriteBuffer(
     mnexus::BufferHandle buffer_handle,
     uint32_t buffer_offset,
     void const* data,
-    uint32_t data_size_in_bytes
-  ) {
-    MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
-
-    mbase::LockGuard queue_lock(queue_mutex_);
-
+    uint32_t data_size_in_bytes,
+    uint64_t timeline_value
+  ) MBASE_REQUIRES(queue_mutex_) {
     auto pool_handle = resource_pool::ResourceHandle::FromU64(buffer_handle.Get());
 
     auto [hot, lock] = resource_storage_->buffers.GetHotConstRefWithSharedLockGuard(pool_handle);
@@ -151,25 +410,75 @@ public:
       data,
       data_size_in_bytes
     );
+    perf_counters_.Add(profiling::PerfCounter::kStagingBytesUploaded, data_size_in_bytes);
 
-    mnexus::IntraQueueSubmissionId const id = this->AdvanceTimeline();
+    this->CommitTimelineValue(timeline_value);
     this->UpdateCompletedValue();
-    return id;
   }
 
-  IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueReadBuffer,
-    mnexus::QueueId const& queue_id,
+  /// Returns false (leaving `timeline_value` without work) if the texture has no backing texture.
+  bool ExecuteWriteTexture(
+    mnexus::TextureHandle texture_handle,
+    mnexus::container::ArrayProxy<mnexus::TextureWriteRegion const> regions,
+    uint64_t timeline_value
+  ) MBASE_REQUIRES(queue_mutex_) {
+    auto pool_handle = resource_pool::ResourceHandle::FromU64(texture_handle.Get());
+    auto [hot, cold, lock] = resource_storage_->textures.GetConstRefWithSharedLockGuard(pool_handle);
+
+    if (!hot.wgpu_texture) {
+      MBASE_LOG_ERROR("QueueWriteTexture: texture has no backing texture");
+      this->CommitTimelineValue(timeline_value);
+      return false;
+    }
+
+    bool const is_3d = cold.desc.dimension == mnexus::TextureDimension::k3D;
+    wgpu::Queue wgpu_queue = wgpu_device_.GetQueue();
+
+    // `Queue::WriteTexture` has no row pitch alignment requirement; Dawn stages the data with a single copy.
+    uint64_t uploaded_bytes = 0;
+    for (mnexus::TextureWriteRegion const& region : regions) {
+      MBASE_ASSERT_MSG(region.subresource_range.mip_level_count == 1, "A TextureWriteRegion covers a single mip level");
+
+      TextureWriteLayout const layout = ComputeTextureWriteLayout(cold.desc.format, region);
+
+      wgpu::TexelCopyTextureInfo dst {};
+      dst.texture = hot.wgpu_texture;
+      dst.mipLevel = region.subresource_range.base_mip_level;
+      dst.origin = {
+        region.origin.x,
+        region.origin.y,
+        is_3d ? region.origin.z : region.subresource_range.base_array_layer,
+      };
+      dst.aspect = wgpu::TextureAspect::All;
+
+      wgpu::TexelCopyBufferLayout data_layout {};
+      data_layout.offset = 0;
+      data_layout.bytesPerRow = layout.row_pitch;
+      data_layout.rowsPerImage = layout.rows_per_image;
+
+      wgpu::Extent3D const write_size {
+        region.extent.width,
+        region.extent.height,
+        is_3d ? region.extent.depth : region.subresource_range.array_layer_count,
+      };
+
+      wgpu_queue.WriteTexture(&dst, region.data, layout.data_size, &data_layout, &write_size);
+      uploaded_bytes += layout.data_size;
+    }
+    perf_counters_.Add(profiling::PerfCounter::kStagingBytesUploaded, uploaded_bytes);
+
+    this->CommitTimelineValue(timeline_value);
+    this->UpdateCompletedValue();
+    return true;
+  }
+
+  void ExecuteReadBuffer(
     mnexus::BufferHandle buffer_handle,
     uint32_t buffer_offset,
     void* dst,
-    uint32_t size_in_bytes
-  ) {
-    MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
-    MBASE_ASSERT_MSG((buffer_offset % 4) == 0, "buffer_offset must be 4-byte aligned");
-    MBASE_ASSERT_MSG((size_in_bytes % 4) == 0, "size_in_bytes must be 4-byte aligned");
-
-    mbase::LockGuard queue_lock(queue_mutex_);
-
+    uint32_t size_in_bytes,
+    uint64_t timeline_value
+  ) MBASE_REQUIRES(queue_mutex_) {
     auto pool_handle = resource_pool::ResourceHandle::FromU64(buffer_handle.Get());
     auto [hot, lock] = resource_storage_->buffers.GetHotConstRefWithSharedLockGuard(pool_handle);
 
@@ -199,20 +508,123 @@ public:
       }
     );
 
-    mnexus::IntraQueueSubmissionId const id = this->AdvanceTimeline();
+    this->CommitTimelineValue(timeline_value);
 
-    pending_readbacks_.emplace_back(
-      PendingReadback {
-        .timeline_value = id.Get(),
-        .staging_buffer = std::move(staging_buffer),
-        .map_future = map_future,
-        .dst = dst,
-        .size_in_bytes = size_in_bytes,
+    pending_ops_.emplace_back(
+      PendingOp {
+        .timeline_value = timeline_value,
+        .future = map_future,
+        .readback = PendingReadback {
+          .staging_buffer = std::move(staging_buffer),
+          .dst = dst,
+          .row_size_in_bytes = size_in_bytes,
+          .staging_row_pitch = size_in_bytes,
+          .row_count = 1,
+        },
       }
     );
 
     this->UpdateCompletedValue();
-    return id;
+  }
+
+  /// Returns false (leaving `timeline_value` without work) if the texture has no backing texture.
+  bool ExecuteReadTexture(
+    mnexus::TextureHandle texture_handle,
+    mnexus::TextureSubresourceRange const& subresource_range,
+    mnexus::Extent3d const& copy_extent,
+    void* dst,
+    uint64_t dst_size_in_bytes,
+    uint64_t timeline_value
+  ) MBASE_REQUIRES(queue_mutex_) {
+    auto pool_handle = resource_pool::ResourceHandle::FromU64(texture_handle.Get());
+    auto [hot, cold, lock] = resource_storage_->textures.GetConstRefWithSharedLockGuard(pool_handle);
+
+    // Swapchain texture hot handle can be null if not acquired this frame.
+    if (!hot.wgpu_texture) {
+      MBASE_LOG_ERROR("QueueReadTexture: texture has no backing texture");
+      this->CommitTimelineValue(timeline_value);
+      return false;
+    }
+
+    uint32_t const format_size = MnGetFormatSizeInBytes(static_cast<MnFormat>(cold.desc.format));
+    MnExtent3d const block_extent = MnGetFormatTexelBlockExtent(static_cast<MnFormat>(cold.desc.format));
+
+    uint32_t const blocks_per_row = (copy_extent.width + block_extent.width - 1) / block_extent.width;
+    uint32_t const bytes_per_row_unaligned = blocks_per_row * format_size;
+    uint32_t const bytes_per_row_aligned = (bytes_per_row_unaligned + 255) & ~uint32_t(255);
+
+    uint32_t const rows_per_image = (copy_extent.height + block_extent.height - 1) / block_extent.height;
+    // Depth slices of a 3D texture or array layers; the other factor is 1.
+    uint32_t const image_count = copy_extent.depth * subresource_range.array_layer_count;
+    uint32_t const row_count = rows_per_image * image_count;
+
+    MBASE_ASSERT_MSG(
+      dst_size_in_bytes >= uint64_t { bytes_per_row_unaligned } * row_count,
+      "dst_size_in_bytes is too small for the tightly packed copy"
+    );
+
+    // A single staging buffer in the copy's native (256-byte aligned) row pitch; the padding is removed while
+    // copying out of the mapping.
+    uint64_t const staging_size = uint64_t { bytes_per_row_aligned } * row_count;
+    wgpu::BufferDescriptor staging_desc {
+      .usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst,
+      .size = staging_size,
+    };
+    wgpu::Buffer staging_buffer = wgpu_device_.CreateBuffer(&staging_desc);
+
+    wgpu::TexelCopyTextureInfo src {};
+    src.texture = hot.wgpu_texture;
+    src.mipLevel = subresource_range.base_mip_level;
+    src.origin = { 0, 0, subresource_range.base_array_layer };
+    src.aspect = wgpu::TextureAspect::All;
+
+    wgpu::TexelCopyBufferInfo staging {};
+    staging.buffer = staging_buffer;
+    staging.layout.offset = 0;
+    staging.layout.bytesPerRow = bytes_per_row_aligned;
+    staging.layout.rowsPerImage = rows_per_image;
+
+    wgpu::Extent3D wgpu_copy_size {
+      copy_extent.width,
+      copy_extent.height,
+      image_count,
+    };
+
+    wgpu::CommandEncoder encoder = wgpu_device_.CreateCommandEncoder();
+    encoder.CopyTextureToBuffer(&src, &staging, &wgpu_copy_size);
+    wgpu::CommandBuffer command_buffer = encoder.Finish();
+
+    wgpu::Queue wgpu_queue = wgpu_device_.GetQueue();
+    wgpu_queue.Submit(1, &command_buffer);
+
+    wgpu::Future map_future = staging_buffer.MapAsync(
+      wgpu::MapMode::Read, 0, staging_size,
+      wgpu::CallbackMode::WaitAnyOnly,
+      [](wgpu::MapAsyncStatus status, wgpu::StringView message) {
+        if (status != wgpu::MapAsyncStatus::Success) {
+          MBASE_LOG_ERROR("MapAsync failed (QueueReadTexture): {}", message);
+        }
+      }
+    );
+
+    this->CommitTimelineValue(timeline_value);
+
+    pending_ops_.emplace_back(
+      PendingOp {
+        .timeline_value = timeline_value,
+        .future = map_future,
+        .readback = PendingReadback {
+          .staging_buffer = std::move(staging_buffer),
+          .dst = dst,
+          .row_size_in_bytes = bytes_per_row_unaligned,
+          .staging_row_pitch = bytes_per_row_aligned,
+          .row_count = row_count,
+        },
+      }
+    );
+
+    this->UpdateCompletedValue();
+    return true;
   }
 
   IMPL_VAPI(mnexus::IntraQueueSubmissionId, QueueGetCompletedValue,
@@ -220,11 +632,27 @@ public:
   ) {
     MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
 
-    mbase::LockGuard queue_lock(queue_mutex_);
+    if (submission_thread_.IsRunning()) {
+      // The completion thread keeps the published value current (see `Initialize`), so polling callers do not
+      // contend with the submission thread for `queue_mutex_`.
+      return mnexus::IntraQueueSubmissionId { published_completed_value_.load(std::memory_order_acquire) };
+    }
 
-    this->PollPendingOps();
-    this->UpdateCompletedValue();
-    return mnexus::IntraQueueSubmissionId { completed_value_ };
+    uint64_t completed_value = 0;
+    {
+      mbase::LockGuard queue_lock(queue_mutex_);
+
+      this->PollPendingOps();
+      this->UpdateCompletedValue();
+      completed_value = completed_value_;
+    }
+
+#if MBASE_PLATFORM_WEB
+    // No completion thread on the Web; deliver `QueueOnCompleted` callbacks from here.
+    completion_notifier_.DispatchCompleted(0, completed_value);
+#endif
+
+    return mnexus::IntraQueueSubmissionId { completed_value };
   }
 
   IMPL_VAPI(void, QueueWaitIdle,
@@ -233,60 +661,50 @@ public:
   ) {
     MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
 
-    mbase::LockGuard queue_lock(queue_mutex_);
-
     uint64_t const target = value.Get();
 
-    while (completed_value_ < target) {
-      bool found_pending = false;
-
-      // Block on pending submit/write ops.
-      for (size_t i = 0; i < pending_ops_.size(); ) {
-        PendingOp& op = pending_ops_[i];
-        if (op.timeline_value <= target) {
-          found_pending = true;
-
-          wgpu::WaitStatus wait_status = wgpu_instance_.WaitAny(op.future, UINT64_MAX);
-          if (wait_status == wgpu::WaitStatus::Success) {
-            pending_ops_.erase(pending_ops_.begin() + static_cast<ptrdiff_t>(i));
-          } else {
-            MBASE_LOG_ERROR("WaitAny failed during QueueWaitIdle (pending op)");
-            ++i;
-          }
-        } else {
-          ++i;
-        }
-      }
+    if (submission_thread_.IsRunning()) {
+      // The operations up to `target` have to be issued before their completion can be waited on.
+      uint64_t const last_reserved = next_timeline_value_.load(std::memory_order_relaxed) - 1;
+      submission_thread_.WaitExecuted(std::min(target, last_reserved));
+    }
 
-      // Block on pending readbacks.
-      for (size_t i = 0; i < pending_readbacks_.size(); ) {
-        PendingReadback& rb = pending_readbacks_[i];
-        if (rb.timeline_value <= target) {
-          found_pending = true;
-
-          wgpu::WaitStatus wait_status = wgpu_instance_.WaitAny(rb.map_future, UINT64_MAX);
-          if (wait_status == wgpu::WaitStatus::Success) {
-            void const* mapped = rb.staging_buffer.GetConstMappedRange(0, rb.size_in_bytes);
-            MBASE_ASSERT(mapped != nullptr);
-            std::memcpy(rb.dst, mapped, rb.size_in_bytes);
-            rb.staging_buffer.Unmap();
-
-            pending_readbacks_.erase(pending_readbacks_.begin() + static_cast<ptrdiff_t>(i));
-          } else {
-            MBASE_LOG_ERROR("WaitAny failed during QueueWait (pending readback)");
-            ++i;
-          }
-        } else {
-          ++i;
-        }
-      }
+    mbase::LockGuard queue_lock(queue_mutex_);
 
-      this->UpdateCompletedValue();
+    // Entries complete in timeline order, so blocking on the head until it passes `target` is sufficient.
+    while (!pending_ops_.empty() && pending_ops_.front().timeline_value <= target) {
+      PendingOp& op = pending_ops_.front();
 
-      if (!found_pending) {
+      wgpu::WaitStatus wait_status = wgpu_instance_.WaitAny(op.future, UINT64_MAX);
+      if (wait_status != wgpu::WaitStatus::Success) {
+        MBASE_LOG_ERROR("WaitAny failed during QueueWaitIdle");
         break;
       }
+
+      this->RetirePendingOp(op);
+      pending_ops_.pop_front();
     }
+
+    this->UpdateCompletedValue();
+  }
+
+  IMPL_VAPI(void, QueueOnCompleted,
+    mnexus::QueueId const& queue_id,
+    mnexus::IntraQueueSubmissionId value,
+    MnQueueCompletedCallback callback,
+    void* user_data
+  ) {
+    MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
+
+    completion_notifier_.AddCallback(0, value.Get(), callback, user_data);
+  }
+
+  IMPL_VAPI(intptr_t, QueueGetCompletionEvent,
+    mnexus::QueueId const& queue_id
+  ) {
+    MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
+
+    return completion_notifier_.GetEvent(0);
   }
 
   // -----------------------------------------------------------------------------------------------
@@ -302,11 +720,22 @@ public:
 
     wgpu::CommandEncoder wgpu_command_encoder = wgpu_device_.CreateCommandEncoder();
 
-    return new MnexusCommandListWebGpu(resource_storage_, wgpu_device_, std::move(wgpu_command_encoder));
+    std::unique_ptr<profiling::GpuTimingRecorder> gpu_timing_recorder;
+    if (gpu_timing_enabled_.load(std::memory_order_relaxed)) {
+      gpu_timing_recorder = std::make_unique<profiling::GpuTimingRecorder>(kGpuTimingQueryCapacity);
+    }
+
+    return new MnexusCommandListWebGpu(
+      resource_storage_,
+      wgpu_device_,
+      std::move(wgpu_command_encoder),
+      std::move(gpu_timing_recorder)
+    );
   }
 
   MNEXUS_NO_THROW void MNEXUS_CALL DiscardCommandList(mnexus::ICommandList* command_list) override {
     MBASE_ASSERT(command_list != nullptr);
+    perf_counters_.Accumulate(static_cast<MnexusCommandListWebGpu*>(command_list)->perf_counters());
     delete command_list;
   }
 
@@ -319,10 +748,17 @@ public:
   ) {
     wgpu::Buffer wgpu_buffer = CreateWgpuBuffer(wgpu_device_, desc);
 
+    // WebGPU buffers cannot stay mapped while the GPU uses them; `MapBuffer` hands out a CPU shadow instead.
+    std::unique_ptr<uint8_t[]> mapped_shadow;
+    if (desc.usage.HasAnyOf(mnexus::BufferUsageFlagBits::kMappable)) {
+      mapped_shadow = std::make_unique<uint8_t[]>(desc.size_in_bytes);
+    }
+
     resource_pool::ResourceHandle pool_handle = resource_storage_->buffers.Emplace(
-      std::forward_as_tuple(BufferHot { std::move(wgpu_buffer) }),
+      std::forward_as_tuple(BufferHot { std::move(wgpu_buffer), std::move(mapped_shadow) }),
       std::forward_as_tuple(BufferCold { desc })
     );
+    memory_tracker_.OnCreated(profiling::MemoryResourceType::kBuffer, desc.size_in_bytes);
 
     return mnexus::BufferHandle { pool_handle.AsU64() };
   }
@@ -330,7 +766,16 @@ public:
     mnexus::BufferHandle buffer_handle
   ) {
     auto pool_handle = resource_pool::ResourceHandle::FromU64(buffer_handle.Get());
+
+    uint64_t size_in_bytes = 0;
+    {
+      auto [hot, cold, lock] = resource_storage_->buffers.GetConstRefWithSharedLockGuard(pool_handle);
+      size_in_bytes = cold.desc.size_in_bytes;
+      buffer_row_repack::ForgetSourceBuffer(hot.wgpu_buffer.Get());
+    }
+
     resource_storage_->buffers.Erase(pool_handle);
+    memory_tracker_.OnDestroyed(profiling::MemoryResourceType::kBuffer, size_in_bytes);
   }
 
   IMPL_VAPI(void, GetBufferDesc,
@@ -344,6 +789,48 @@ public:
     }
   }
 
+  IMPL_VAPI(void*, MapBuffer,
+    mnexus::BufferHandle buffer_handle
+  ) {
+    // The shadow is created with the buffer and never replaced, so the shared lock suffices even when several
+    // threads map the buffer at once.
+    uint8_t* mapped = this->GetMappedShadow(buffer_handle);
+    if (mapped == nullptr) {
+      MBASE_LOG_ERROR("MapBuffer: buffer was not created with kMappable usage");
+    }
+    return mapped;
+  }
+
+  IMPL_VAPI(void, UnmapBuffer,
+    mnexus::BufferHandle /*buffer_handle*/
+  ) {
+    // Nothing to do: the shadow lives as long as the buffer.
+  }
+
+  IMPL_VAPI(void, FlushMappedBufferRange,
+    mnexus::BufferHandle buffer_handle,
+    uint32_t offset,
+    uint32_t size_in_bytes
+  ) {
+    uint8_t const* mapped = this->GetMappedShadow(buffer_handle);
+    MBASE_ASSERT_MSG(mapped != nullptr, "FlushMappedBufferRange requires a kMappable buffer");
+
+    this->QueueWriteBuffer(mnexus::QueueId { 0, 0 }, buffer_handle, offset, mapped + offset, size_in_bytes);
+  }
+
+  IMPL_VAPI(void, InvalidateMappedBufferRange,
+    mnexus::BufferHandle buffer_handle,
+    uint32_t offset,
+    uint32_t size_in_bytes
+  ) {
+    uint8_t* mapped = this->GetMappedShadow(buffer_handle);
+    MBASE_ASSERT_MSG(mapped != nullptr, "InvalidateMappedBufferRange requires a kMappable buffer");
+
+    mnexus::IntraQueueSubmissionId const id =
+      this->QueueReadBuffer(mnexus::QueueId { 0, 0 }, buffer_handle, offset, mapped + offset, size_in_bytes);
+    this->QueueWaitIdle(mnexus::QueueId { 0, 0 }, id);
+  }
+
   //
   // Texture
   //
@@ -355,7 +842,11 @@ public:
   IMPL_VAPI(mnexus::TextureHandle, CreateTexture,
     mnexus::TextureDesc const& desc
   ) {
-    wgpu::TextureUsage const usage = ToWgpuTextureUsage(desc.usage) | wgpu::TextureUsage::CopyDst;
+    wgpu::TextureUsage usage = ToWgpuTextureUsage(desc.usage) | wgpu::TextureUsage::CopyDst;
+    if (desc.mip_level_count > 1) {
+      // Allow `GenerateMipmaps` without requiring the caller to know how the backend downsamples.
+      usage |= generate_mipmaps::GetRequiredTextureUsage(ToWgpuTextureFormat(desc.format));
+    }
 
     wgpu::TextureDescriptor wgpu_texture_desc {
       .usage = usage,
@@ -366,7 +857,7 @@ public:
         .depthOrArrayLayers = 1,
       },
       .format = ToWgpuTextureFormat(desc.format),
-      .mipLevelCount = 1,
+      .mipLevelCount = desc.mip_level_count,
       .sampleCount = 1,
       .viewFormatCount = 0,
       .viewFormats = nullptr,
@@ -378,10 +869,19 @@ public:
       std::forward_as_tuple(TextureHot { std::move(wgpu_texture) }),
       std::forward_as_tuple(TextureCold { desc })
     );
+    memory_tracker_.OnCreated(profiling::MemoryResourceType::kTexture, profiling::EstimateTextureSizeInBytes(desc));
 
     return mnexus::TextureHandle { pool_handle.AsU64() };
   }
 
+  // WebGPU does not expose texture memory; `AdapterCapability::texture_memory_aliasing` is always false.
+  IMPL_VAPI(MnBool32, CreateAliasedTextures,
+    mnexus::container::ArrayProxy<mnexus::TextureDesc const> /*descs*/,
+    mnexus::TextureHandle* /*out_textures*/
+  ) {
+    return MnBoolFalse;
+  }
+
   IMPL_VAPI(void, DestroyTexture,
     mnexus::TextureHandle texture_handle
   ) {
@@ -389,7 +889,15 @@ public:
 
     MBASE_ASSERT(pool_handle != resource_storage_->swapchain_texture_handle);
 
+    uint64_t size_in_bytes = 0;
+    {
+      auto [hot, cold, lock] = resource_storage_->textures.GetConstRefWithSharedLockGuard(pool_handle);
+      size_in_bytes = profiling::EstimateTextureSizeInBytes(cold.desc);
+      ForgetCachedTextureObjects(hot.wgpu_texture);
+    }
+
     resource_storage_->textures.Erase(pool_handle);
+    memory_tracker_.OnDestroyed(profiling::MemoryResourceType::kTexture, size_in_bytes);
   }
 
   IMPL_VAPI(void, GetTextureDesc,
@@ -412,20 +920,22 @@ public:
   IMPL_VAPI(mnexus::SamplerHandle, CreateSampler,
     mnexus::SamplerDesc const& desc
   ) {
-    wgpu::SamplerDescriptor wgpu_sampler_desc {};
-    wgpu_sampler_desc.minFilter    = ToWgpuFilterMode(desc.min_filter);
-    wgpu_sampler_desc.magFilter    = ToWgpuFilterMode(desc.mag_filter);
-    wgpu_sampler_desc.mipmapFilter = ToWgpuMipmapFilterMode(desc.mipmap_filter);
-    wgpu_sampler_desc.addressModeU = ToWgpuAddressMode(desc.address_mode_u);
-    wgpu_sampler_desc.addressModeV = ToWgpuAddressMode(desc.address_mode_v);
-    wgpu_sampler_desc.addressModeW = ToWgpuAddressMode(desc.address_mode_w);
-
-    wgpu::Sampler wgpu_sampler = wgpu_device_.CreateSampler(&wgpu_sampler_desc);
-
-    resource_pool::ResourceHandle pool_handle = resource_storage_->samplers.Emplace(
-      std::forward_as_tuple(SamplerHot { std::move(wgpu_sampler) }),
-      std::forward_as_tuple(SamplerCold { desc })
-    );
+    resource_pool::ResourceHandle pool_handle = resource_storage_->sampler_cache.Acquire(desc, [&] {
+      wgpu::SamplerDescriptor wgpu_sampler_desc {};
+      wgpu_sampler_desc.minFilter    = ToWgpuFilterMode(desc.min_filter);
+      wgpu_sampler_desc.magFilter    = ToWgpuFilterMode(desc.mag_filter);
+      wgpu_sampler_desc.mipmapFilter = ToWgpuMipmapFilterMode(desc.mipmap_filter);
+      wgpu_sampler_desc.addressModeU = ToWgpuAddressMode(desc.address_mode_u);
+      wgpu_sampler_desc.addressModeV = ToWgpuAddressMode(desc.address_mode_v);
+      wgpu_sampler_desc.addressModeW = ToWgpuAddressMode(desc.address_mode_w);
+
+      wgpu::Sampler wgpu_sampler = wgpu_device_.CreateSampler(&wgpu_sampler_desc);
+
+      return resource_storage_->samplers.Emplace(
+        std::forward_as_tuple(SamplerHot { std::move(wgpu_sampler) }),
+        std::forward_as_tuple(SamplerCold { desc })
+      );
+    });
 
     return mnexus::SamplerHandle { pool_handle.AsU64() };
   }
@@ -434,9 +944,53 @@ public:
     mnexus::SamplerHandle sampler_handle
   ) {
     auto pool_handle = resource_pool::ResourceHandle::FromU64(sampler_handle.Get());
-    resource_storage_->samplers.Erase(pool_handle);
+
+    mnexus::SamplerDesc desc;
+    {
+      auto [cold, lock] = resource_storage_->samplers.GetColdConstRefWithSharedLockGuard(pool_handle);
+      desc = cold.desc;
+    }
+
+    // Identical descriptors share one sampler; only the last reference destroys it.
+    if (resource_storage_->sampler_cache.Release(desc)) {
+      resource_storage_->samplers.Erase(pool_handle);
+    }
+  }
+
+  //
+  // Bindless Resources
+  //
+  // WebGPU has no descriptor indexing; `AdapterCapability::bindless_resources` is always false.
+  //
+
+  IMPL_VAPI(uint32_t, RegisterBindlessSampledTexture,
+    mnexus::TextureHandle /*texture_handle*/,
+    mnexus::TextureSubresourceRange const& /*subresource_range*/
+  ) {
+    MBASE_LOG_ERROR("Bindless resources are not supported by the WebGPU backend");
+    return mnexus::kInvalidBindlessIndex;
+  }
+
+  IMPL_VAPI(uint32_t, RegisterBindlessStorageBuffer,
+    mnexus::BufferHandle /*buffer_handle*/,
+    uint64_t /*offset*/,
+    uint64_t /*size*/
+  ) {
+    MBASE_LOG_ERROR("Bindless resources are not supported by the WebGPU backend");
+    return mnexus::kInvalidBindlessIndex;
+  }
+
+  IMPL_VAPI(uint32_t, RegisterBindlessSampler,
+    mnexus::SamplerHandle /*sampler_handle*/
+  ) {
+    MBASE_LOG_ERROR("Bindless resources are not supported by the WebGPU backend");
+    return mnexus::kInvalidBindlessIndex;
   }
 
+  IMPL_VAPI(void, UnregisterBindlessSampledTexture, uint32_t /*index*/) {}
+  IMPL_VAPI(void, UnregisterBindlessStorageBuffer, uint32_t /*index*/) {}
+  IMPL_VAPI(void, UnregisterBindlessSampler, uint32_t /*index*/) {}
+
   //
   // ShaderModule
   //
@@ -491,6 +1045,12 @@ public:
   ) {
     auto pool_handle = resource_pool::ResourceHandle::FromU64(program_handle.Get());
     resource_storage_->programs.Erase(pool_handle);
+
+    // Dawn keeps pipelines alive for work already submitted, so the cached pipelines can be dropped right away;
+    // otherwise they would pile up as programs are recreated.
+    resource_storage_->render_pipeline_cache.EraseIf(
+      [program_handle](pipeline::RenderPipelineCacheKey const& key) { return key.program.Get() == program_handle.Get(); }
+    );
   }
 
   //
@@ -529,7 +1089,12 @@ public:
     }
 
     resource_pool::ResourceHandle pool_handle = resource_storage_->compute_pipelines.Emplace(
-      std::forward_as_tuple(ComputePipelineHot { std::move(wgpu_compute_pipeline) }),
+      std::forward_as_tuple(
+        ComputePipelineHot {
+          .wgpu_compute_pipeline = std::move(wgpu_compute_pipeline),
+          .has_push_constants = program_hot.has_push_constants,
+        }
+      ),
       std::forward_as_tuple(ComputePipelineCold { })
     );
 
@@ -589,14 +1154,75 @@ public:
       return mnexus::RenderPipelineHandle::Invalid();
     }
 
+    bool has_push_constants = false;
+    {
+      auto [program_hot, program_lock] = resource_storage_->programs.GetHotConstRefWithSharedLockGuard(
+        resource_pool::ResourceHandle::FromU64(desc.program.Get())
+      );
+      has_push_constants = program_hot.has_push_constants;
+    }
+
     resource_pool::ResourceHandle pool_handle = resource_storage_->render_pipelines.Emplace(
-      std::forward_as_tuple(RenderPipelineHot { std::move(wgpu_pipeline) }),
+      std::forward_as_tuple(
+        RenderPipelineHot {
+          .wgpu_render_pipeline = std::move(wgpu_pipeline),
+          .has_push_constants = has_push_constants,
+        }
+      ),
       std::forward_as_tuple(RenderPipelineCold { })
     );
 
     return mnexus::RenderPipelineHandle { pool_handle.AsU64() };
   }
 
+  //
+  // RenderBundle
+  //
+
+  IMPL_VAPI(mnexus::IRenderBundleEncoder*, CreateRenderBundleEncoder,
+    mnexus::RenderBundleDesc const& desc
+  ) {
+    return new MnexusRenderBundleEncoderWebGpu(resource_storage_, wgpu_device_, desc);
+  }
+
+  IMPL_VAPI(mnexus::RenderBundleHandle, FinishRenderBundleEncoder,
+    mnexus::IRenderBundleEncoder* encoder
+  ) {
+    MBASE_ASSERT(encoder != nullptr);
+
+    MnexusRenderBundleEncoderWebGpu* webgpu_encoder = dynamic_cast<MnexusRenderBundleEncoderWebGpu*>(encoder);
+
+    wgpu::RenderBundle wgpu_render_bundle = webgpu_encoder->Finish();
+    pipeline::RenderTargetSignature signature = webgpu_encoder->GetRenderTargetSignature();
+
+    this->DiscardRenderBundleEncoder(encoder);
+
+    if (!wgpu_render_bundle) {
+      return mnexus::RenderBundleHandle::Invalid();
+    }
+
+    resource_pool::ResourceHandle pool_handle = resource_storage_->render_bundles.Emplace(
+      std::forward_as_tuple(RenderBundleHot { std::move(wgpu_render_bundle) }),
+      std::forward_as_tuple(RenderBundleCold { std::move(signature) })
+    );
+
+    return mnexus::RenderBundleHandle { pool_handle.AsU64() };
+  }
+
+  IMPL_VAPI(void, DiscardRenderBundleEncoder,
+    mnexus::IRenderBundleEncoder* encoder
+  ) {
+    MBASE_ASSERT(encoder != nullptr);
+    delete encoder;
+  }
+
+  IMPL_VAPI(void, DestroyRenderBundle,
+    mnexus::RenderBundleHandle render_bundle_handle
+  ) {
+    auto pool_handle = resource_pool::ResourceHandle::FromU64(render_bundle_handle.Get());
+    resource_storage_->render_bundles.Erase(pool_handle);
+  }
+
   //
   // Device Capability
   //
@@ -641,6 +1267,78 @@ public:
     return snapshot;
   }
 
+  IMPL_VAPI(mnexus::SamplerCacheSnapshot, GetSamplerCacheSnapshot) {
+    return resource_storage_->sampler_cache.GetSnapshot();
+  }
+
+  IMPL_VAPI(mnexus::PerfCountersSnapshot, GetPerfCountersSnapshot) {
+    profiling::PerfCounterValues values = perf_counters_.Load();
+    values[static_cast<uint32_t>(profiling::PerfCounter::kResourcePoolLookups)] += resource_storage_->GetPoolLookupCount();
+    return profiling::MakePerfCountersSnapshot(values);
+  }
+
+  IMPL_VAPI(void, ResetPerfCounters) {
+    perf_counters_.Reset();
+    resource_storage_->ResetPoolLookupCounts();
+  }
+
+  IMPL_VAPI(mnexus::MemoryStats, GetMemoryStats) {
+    // WebGPU exposes no heaps; only the CPU-side totals are known.
+    mnexus::MemoryStats stats;
+    memory_tracker_.FillResourceStats(stats);
+    return stats;
+  }
+
+  IMPL_VAPI(void, SetMemoryThresholdCallback,
+    uint64_t threshold_in_bytes,
+    MnMemoryThresholdCallback callback,
+    void* user_data
+  ) {
+    memory_tracker_.SetThresholdCallback(threshold_in_bytes, callback, user_data);
+  }
+
+  IMPL_VAPI(void, SetGpuTimingEnabled, bool enabled) {
+    gpu_timing_enabled_.store(enabled && adapter_capability_.timestamp_query, std::memory_order_relaxed);
+  }
+
+  IMPL_VAPI(MnBool32, GetGpuTimingReport,
+    mnexus::QueueId const& queue_id,
+    mnexus::IntraQueueSubmissionId submission_id,
+    mnexus::GpuTimingReport& out_report
+  ) {
+    MBASE_ASSERT_MSG(queue_id.queue_family_index == 0 && queue_id.queue_index == 0, "WebGPU backend only supports a single queue");
+
+    {
+      mbase::LockGuard queue_lock(queue_mutex_);
+
+      this->PollPendingOps();
+      this->UpdateCompletedValue();
+
+      if (submission_id.Get() > completed_value_) {
+        return MnBoolFalse;
+      }
+
+      // The submission has completed, so its readback map resolves promptly.
+      for (size_t i = 0; i < pending_gpu_timings_.size(); ++i) {
+        PendingGpuTiming& pending = pending_gpu_timings_[i];
+        if (pending.timeline_value != submission_id.Get()) {
+          continue;
+        }
+
+        wgpu::WaitStatus wait_status = wgpu_instance_.WaitAny(pending.map_future, UINT64_MAX);
+        if (wait_status == wgpu::WaitStatus::Success) {
+          this->ResolvePendingGpuTiming(pending);
+        } else {
+          MBASE_LOG_ERROR("WaitAny failed during GetGpuTimingReport");
+        }
+        pending_gpu_timings_.erase(pending_gpu_timings_.begin() + static_cast<ptrdiff_t>(i));
+        break;
+      }
+    }
+
+    return gpu_timing_report_cache_.Find(queue_id, submission_id, out_report) ? MnBoolTrue : MnBoolFalse;
+  }
+
   //
   // Module local
   //
@@ -649,7 +1347,8 @@ public:
     wgpu::Instance wgpu_instance,
     wgpu::Adapter wgpu_adapter,
     wgpu::Device wgpu_device,
-    ResourceStorage* resource_storage
+    ResourceStorage* resource_storage,
+    bool use_submission_thread
   ) {
     MBASE_ASSERT(!wgpu_device_);
 
@@ -657,6 +1356,8 @@ public:
     wgpu_device_ = std::move(wgpu_device);
     resource_storage_ = resource_storage;
 
+    adapter_capability_.timestamp_query = wgpu_device_.HasFeature(wgpu::FeatureName::TimestampQuery) ? MnBoolTrue : MnBoolFalse;
+
     // Populate adapter info.
     {
       wgpu::AdapterInfo info {};
@@ -686,35 +1387,75 @@ public:
     );
 
     InitializeShaderSubsystem();
+    resource_storage_->scratch_arena.Initialize(wgpu_device_);
+    completion_notifier_.Initialize(this, 1);
     builtin_shader::Initialize(wgpu_device_);
     buffer_row_repack::Initialize(wgpu_device_);
     blit_texture::Initialize(wgpu_device_);
+    generate_mipmaps::Initialize(wgpu_device_);
+    push_constants::Initialize(wgpu_device_);
+
+    if (use_submission_thread) {
+#if MBASE_PLATFORM_WEB
+      MBASE_LOG_WARN("The submission thread is not supported on the Web; queue operations run on the calling thread");
+#else
+      submission_thread_.Start(next_timeline_value_.load(std::memory_order_relaxed));
+      completion_notifier_.TrackAllSubmissions();
+#endif
+    }
   }
 
   void Shutdown() {
+    // Issues the operations that are still queued, so that they are accounted for below.
+    submission_thread_.Stop();
+
+    // Before the pending ops are dropped: delivers the callbacks of completed work and stops the completion thread.
+    completion_notifier_.Shutdown();
+
     {
       mbase::LockGuard queue_lock(queue_mutex_);
 
-      if (!pending_ops_.empty() || !pending_readbacks_.empty()) {
+      if (!pending_ops_.empty()) {
+        size_t const readback_count = static_cast<size_t>(std::count_if(
+          pending_ops_.begin(), pending_ops_.end(),
+          [](PendingOp const& op) { return op.readback.has_value(); }
+        ));
         MBASE_LOG_WARN(
           "Shutting down with {} pending op(s) and {} pending readback(s)",
-          pending_ops_.size(), pending_readbacks_.size()
+          pending_ops_.size() - readback_count, readback_count
         );
       }
 
       pending_ops_.clear();
-      pending_readbacks_.clear();
+      pending_gpu_timings_.clear();
     }
+    gpu_timing_report_cache_.Clear();
 
+    push_constants::Shutdown();
+    generate_mipmaps::Shutdown();
     blit_texture::Shutdown();
+    texture_view_cache::Shutdown();
     buffer_row_repack::Shutdown();
     builtin_shader::Shutdown();
+    resource_storage_->scratch_arena.Shutdown();
     ShutdownShaderSubsystem();
     resource_storage_ = nullptr;
     wgpu_device_ = nullptr;
     wgpu_instance_ = nullptr;
   }
 
+  /// Blocks until the submission thread has issued every operation reserved so far. No-op without the thread.
+  void FlushSubmissionThread() {
+    if (submission_thread_.IsRunning()) {
+      submission_thread_.WaitExecuted(next_timeline_value_.load(std::memory_order_relaxed) - 1);
+    }
+  }
+
+  /// The timeline value of the most recently reserved queue operation.
+  uint64_t GetLastReservedTimelineValue() const {
+    return next_timeline_value_.load(std::memory_order_relaxed) - 1;
+  }
+
   void OnWgpuSurfaceConfigured(wgpu::SurfaceConfiguration const& surface_config) {
     mbase::LockGuard sw_lock(resource_storage_->swapchain_texture_mutex);
 
@@ -722,6 +1463,7 @@ public:
       resource_storage_->swapchain_texture_handle
     );
 
+    ForgetCachedTextureObjects(hot.wgpu_texture);
     hot = TextureHot {}; // No actual `wgpu::Texture` until acquired from the swapchain.
 
     mnexus::TextureDesc desc {
@@ -744,6 +1486,7 @@ public:
       resource_storage_->swapchain_texture_handle
     );
 
+    ForgetCachedTextureObjects(hot.wgpu_texture);
     hot = TextureHot {};
     cold = TextureCold {};
   }
@@ -761,75 +1504,182 @@ public:
       resource_storage_->swapchain_texture_handle
     );
 
+    // Every acquire hands out a new texture object, so views and bind groups of this one are never hit again.
+    ForgetCachedTextureObjects(hot.wgpu_texture);
     hot.wgpu_texture = wgpu::Texture {};
   }
 
 private:
-  // Tracks GPU-side completion of queue submissions (via OnSubmittedWorkDone).
+  /// Drops the views and bind groups that internal passes cached for `wgpu_texture`. No-op for a null texture.
+  static void ForgetCachedTextureObjects(wgpu::Texture const& wgpu_texture) {
+    if (!wgpu_texture) {
+      return;
+    }
+    blit_texture::ForgetTexture(wgpu_texture.Get());
+    texture_view_cache::ForgetTexture(wgpu_texture.Get());
+  }
+
+  // ----------------------------------------------------------------------------------------------
+  // IQueueCompletionSource (called from the completion thread)
+
+  uint64_t PollQueueCompletedValue(uint32_t /*queue_index*/) override {
+    mbase::LockGuard queue_lock(queue_mutex_);
+
+    this->PollPendingOps();
+    this->UpdateCompletedValue();
+    return completed_value_;
+  }
+
+  void WaitAnyQueueValue(uint64_t const (&target_values)[kMaxQueues], uint64_t timeout_ns) override {
+    // Completion is gated by the head of the timeline, so waiting on it is enough to make progress.
+    // The future is waited on outside `queue_mutex_` so that submissions are not blocked meanwhile.
+    wgpu::Future oldest_future {};
+    {
+      mbase::LockGuard queue_lock(queue_mutex_);
+
+      if (pending_ops_.empty() || pending_ops_.front().timeline_value > target_values[0]) {
+        return; // Already reached.
+      }
+      oldest_future = pending_ops_.front().future;
+    }
+
+    wgpu::WaitStatus const status = wgpu_instance_.WaitAny(oldest_future, timeout_ns);
+    if (status != wgpu::WaitStatus::Success && status != wgpu::WaitStatus::TimedOut) {
+      MBASE_LOG_ERROR("WaitAny failed on the completion thread");
+    }
+  }
+
+  // Tracks a GPU->CPU readback (staging buffer map + memcpy).
+  struct PendingReadback {
+    wgpu::Buffer staging_buffer;
+    void* dst;
+    // The staging buffer holds `row_count` rows of `row_size_in_bytes` every `staging_row_pitch` bytes; they are
+    // written to `dst` tightly packed. Buffer readbacks are a single row.
+    uint32_t row_size_in_bytes;
+    uint32_t staging_row_pitch;
+    uint32_t row_count;
+  };
+
+  // One entry of the queue timeline. `future` is the OnSubmittedWorkDone future of a submission, or the map future
+  // of a readback. Entries are appended in timeline order and complete in that order, so only the head is polled.
   struct PendingOp {
     uint64_t timeline_value;
     wgpu::Future future;
+    std::optional<PendingReadback> readback;
   };
 
-  // Tracks a GPU->CPU readback (staging buffer map + memcpy).
-  struct PendingReadback {
+  // Tracks the timestamp readback of an instrumented command list.
+  struct PendingGpuTiming {
     uint64_t timeline_value;
-    wgpu::Buffer staging_buffer;
+    GpuTimingResolve resolve;
     wgpu::Future map_future;
-    void* dst;
-    uint32_t size_in_bytes;
   };
 
-  mnexus::IntraQueueSubmissionId AdvanceTimeline() MBASE_REQUIRES(queue_mutex_) {
-    return mnexus::IntraQueueSubmissionId { next_timeline_value_++ };
+  /// Returns the CPU shadow of a `kMappable` buffer, or null for other buffers. The shadow outlives the lookup lock;
+  /// it is only released by `DestroyBuffer`.
+  uint8_t* GetMappedShadow(mnexus::BufferHandle buffer_handle) {
+    auto pool_handle = resource_pool::ResourceHandle::FromU64(buffer_handle.Get());
+    auto [hot, lock] = resource_storage_->buffers.GetHotRefWithSharedLockGuard(pool_handle);
+    return hot.mapped_shadow.get();
   }
 
-  void UpdateCompletedValue() MBASE_REQUIRES(queue_mutex_) {
-    uint64_t min_pending = next_timeline_value_;
+  /// Copies a mapped readback out to its destination and unmaps the staging buffer.
+  static void CompleteReadback(PendingReadback& rb) {
+    uint64_t const staging_size = uint64_t { rb.staging_row_pitch } * rb.row_count;
+    void const* mapped = rb.staging_buffer.GetConstMappedRange(0, staging_size);
+    MBASE_ASSERT(mapped != nullptr);
 
-    for (auto const& op : pending_ops_) {
-      if (op.timeline_value < min_pending) {
-        min_pending = op.timeline_value;
+    if (rb.row_size_in_bytes == rb.staging_row_pitch) {
+      std::memcpy(rb.dst, mapped, staging_size);
+    } else {
+      // Strip the row padding.
+      auto const* src_row = static_cast<uint8_t const*>(mapped);
+      auto* dst_row = static_cast<uint8_t*>(rb.dst);
+      for (uint32_t row = 0; row < rb.row_count; ++row) {
+        std::memcpy(dst_row, src_row, rb.row_size_in_bytes);
+        src_row += rb.staging_row_pitch;
+        dst_row += rb.row_size_in_bytes;
       }
     }
-    for (auto const& rb : pending_readbacks_) {
-      if (rb.timeline_value < min_pending) {
-        min_pending = rb.timeline_value;
-      }
+
+    rb.staging_buffer.Unmap();
+  }
+
+  /// Runs the CPU-side completion of a timeline entry whose future has resolved.
+  static void RetirePendingOp(PendingOp& op) {
+    if (op.readback.has_value()) {
+      CompleteReadback(*op.readback);
     }
+  }
 
-    completed_value_ = min_pending - 1;
+  /// Hands out the next timeline value. Without the submission thread this **MUST** be called under `queue_mutex_`
+  /// together with the operation, so that values are executed in the order they are reserved.
+  uint64_t ReserveTimelineValue() {
+    return next_timeline_value_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Marks the operation of `value` as issued to the WebGPU queue. Values are committed in ascending order.
+  void CommitTimelineValue(uint64_t value) MBASE_REQUIRES(queue_mutex_) {
+    MBASE_ASSERT(value > committed_timeline_value_);
+    committed_timeline_value_ = value;
+    completion_notifier_.NotifySubmitted(0, value);
+  }
+
+  void UpdateCompletedValue() MBASE_REQUIRES(queue_mutex_) {
+    // Values without a timeline entry (e.g. queue writes) complete with the entry that precedes them. Reserved values
+    // that the submission thread has not issued yet are not complete.
+    completed_value_ = pending_ops_.empty() ? committed_timeline_value_ : pending_ops_.front().timeline_value - 1;
+    // Release: the readbacks retired before this are visible to lock-free readers of the value.
+    published_completed_value_.store(completed_value_, std::memory_order_release);
+
+    resource_storage_->scratch_arena.Reclaim(completed_value_);
   }
 
   void PollPendingOps() MBASE_REQUIRES(queue_mutex_) {
-    for (size_t i = 0; i < pending_ops_.size(); ) {
-      PendingOp& op = pending_ops_[i];
+    // Readbacks are copied out in timeline order as the head advances.
+    while (!pending_ops_.empty()) {
+      PendingOp& op = pending_ops_.front();
 
       wgpu::WaitStatus status = wgpu_instance_.WaitAny(op.future, 0);
-      if (status == wgpu::WaitStatus::Success) {
-        pending_ops_.erase(pending_ops_.begin() + static_cast<ptrdiff_t>(i));
-      } else {
-        ++i;
+      if (status != wgpu::WaitStatus::Success) {
+        break;
       }
-    }
 
-    for (size_t i = 0; i < pending_readbacks_.size(); ) {
-      PendingReadback& rb = pending_readbacks_[i];
+      this->RetirePendingOp(op);
+      pending_ops_.pop_front();
+    }
 
-      wgpu::WaitStatus status = wgpu_instance_.WaitAny(rb.map_future, 0);
-      if (status == wgpu::WaitStatus::Success) {
-        void const* mapped = rb.staging_buffer.GetConstMappedRange(0, rb.size_in_bytes);
-        MBASE_ASSERT(mapped != nullptr);
-        std::memcpy(rb.dst, mapped, rb.size_in_bytes);
-        rb.staging_buffer.Unmap();
+    while (!pending_gpu_timings_.empty()) {
+      PendingGpuTiming& pending = pending_gpu_timings_.front();
 
-        pending_readbacks_.erase(pending_readbacks_.begin() + static_cast<ptrdiff_t>(i));
-      } else {
-        ++i;
+      wgpu::WaitStatus status = wgpu_instance_.WaitAny(pending.map_future, 0);
+      if (status != wgpu::WaitStatus::Success) {
+        break;
       }
+
+      this->ResolvePendingGpuTiming(pending);
+      pending_gpu_timings_.pop_front();
     }
   }
 
+  void ResolvePendingGpuTiming(PendingGpuTiming& pending) MBASE_REQUIRES(queue_mutex_) {
+    profiling::GpuTimingRecorder const& recorder = *pending.resolve.recorder;
+    uint32_t const query_count = recorder.GetQueryCount();
+
+    void const* mapped = pending.resolve.readback_buffer.GetConstMappedRange(0, uint64_t { query_count } * sizeof(uint64_t));
+    MBASE_ASSERT(mapped != nullptr);
+
+    // WebGPU timestamps are already in nanoseconds.
+    mnexus::GpuTimingReport report = recorder.BuildReport(
+      mnexus::IntraQueueSubmissionId { pending.timeline_value },
+      mbase::ArrayProxy<uint64_t const>(static_cast<uint64_t const*>(mapped), query_count),
+      1.0
+    );
+    pending.resolve.readback_buffer.Unmap();
+
+    gpu_timing_report_cache_.Insert(mnexus::QueueId { 0, 0 }, std::move(report));
+  }
+
   wgpu::Instance wgpu_instance_;
   wgpu::Device wgpu_device_;
   ResourceStorage* resource_storage_ = nullptr;
@@ -837,10 +1687,22 @@ private:
   mnexus::AdapterInfo adapter_info_;
 
   mbase::Lockable<std::mutex> queue_mutex_;
-  uint64_t next_timeline_value_ MBASE_GUARDED_BY(queue_mutex_) = 1;
+  std::atomic<uint64_t> next_timeline_value_ = 1;
+  uint64_t committed_timeline_value_ MBASE_GUARDED_BY(queue_mutex_) = 0;
   uint64_t completed_value_ MBASE_GUARDED_BY(queue_mutex_) = 0;
-  std::vector<PendingOp> pending_ops_ MBASE_GUARDED_BY(queue_mutex_);
-  std::vector<PendingReadback> pending_readbacks_ MBASE_GUARDED_BY(queue_mutex_);
+  /// Mirror of `completed_value_` for `QueueGetCompletedValue` with the submission thread enabled.
+  std::atomic<uint64_t> published_completed_value_ = 0;
+  std::deque<PendingOp> pending_ops_ MBASE_GUARDED_BY(queue_mutex_);
+  std::deque<PendingGpuTiming> pending_gpu_timings_ MBASE_GUARDED_BY(queue_mutex_);
+
+  QueueCompletionNotifier completion_notifier_;
+  SubmissionThread submission_thread_;
+
+  std::atomic<bool> gpu_timing_enabled_ = false;
+  profiling::GpuTimingReportCache gpu_timing_report_cache_;
+
+  profiling::DevicePerfCounters perf_counters_;
+  profiling::MemoryTracker memory_tracker_;
 };
 
 
@@ -849,15 +1711,17 @@ public:
   explicit BackendWebGpu(
     wgpu::Instance instance,
     wgpu::Adapter adapter,
-    wgpu::Device device
+    wgpu::Device device,
+    bool submission_thread
   ) :
     instance_(std::move(instance)),
     adapter_(std::move(adapter)),
     device_(std::move(device))
   {
-    mnexus_device_.Initialize(instance_, adapter_, device_, &resource_storage_);
+    mnexus_device_.Initialize(instance_, adapter_, device_, &resource_storage_, submission_thread);
   }
   ~BackendWebGpu() override {
+    offscreen_textures_.clear();
     mnexus_device_.Shutdown();
   }
 
@@ -1010,6 +1874,14 @@ public:
   // Presentation.
 
   void OnPresentPrologue() override {
+    if (offscreen_swapchain_ != nullptr) {
+      uint32_t const image_index = offscreen_swapchain_->AcquireNextImage(
+        [this](uint64_t serial) { mnexus_device_.QueueWaitIdle({}, mnexus::IntraQueueSubmissionId { serial }); }
+      );
+      mnexus_device_.OnWgpuSurfaceTextureAcquired(offscreen_textures_[image_index]);
+      return;
+    }
+
     MBASE_ASSERT(bool(surface_));
 
     wgpu::SurfaceTexture surface_texture;
@@ -1049,6 +1921,16 @@ public:
   }
 
   void OnPresentEpilogue() override {
+    // The frame's submissions have to reach the WebGPU queue before the surface texture is presented.
+    mnexus_device_.FlushSubmissionThread();
+
+    if (offscreen_swapchain_ != nullptr) {
+      // Nothing to display; the texture stays queued until the frame's work completes and the present latency elapses.
+      offscreen_swapchain_->Present(mnexus_device_.GetLastReservedTimelineValue());
+      mnexus_device_.OnWgpuSurfaceTextureReleased();
+      return;
+    }
+
 #if !MBASE_PLATFORM_WEB
     // On Emscripten, presentation happens automatically via requestAnimationFrame.
     // wgpuSurfacePresent is not supported.
@@ -1058,6 +1940,13 @@ public:
     mnexus_device_.OnWgpuSurfaceTextureReleased();
   }
 
+  uint32_t GetPresentQueueDepth() override {
+    if (offscreen_swapchain_ == nullptr) {
+      return 0;
+    }
+    return offscreen_swapchain_->GetQueueDepth(mnexus_device_.QueueGetCompletedValue({}).Get());
+  }
+
   // ----------------------------------------------------------------------------------------------
   // Resource creation.
 
@@ -1065,6 +1954,55 @@ public:
     return &mnexus_device_;
   }
 
+  // ----------------------------------------------------------------------------------------------
+  // Local.
+
+  /// Emulates a swapchain with regular textures; only for a headless instance, which has no surface.
+  void ConfigureOffscreenSwapchain(mnexus::OffscreenSwapchainDesc const& desc) {
+    MBASE_ASSERT(!surface_ && desc.image_count != 0);
+
+    constexpr wgpu::TextureUsage kTextureUsage =
+      wgpu::TextureUsage::RenderAttachment | wgpu::TextureUsage::CopySrc | wgpu::TextureUsage::CopyDst;
+    wgpu::TextureFormat const format = ToWgpuTextureFormat(desc.format);
+    // Clamp to 1x1 minimum, as for a surface.
+    uint32_t const width = std::max(desc.width, 1u);
+    uint32_t const height = std::max(desc.height, 1u);
+
+    wgpu::TextureDescriptor texture_desc {
+      .usage = kTextureUsage,
+      .dimension = wgpu::TextureDimension::e2D,
+      .size = {
+        .width = width,
+        .height = height,
+        .depthOrArrayLayers = 1,
+      },
+      .format = format,
+      .mipLevelCount = 1,
+      .sampleCount = 1,
+      .viewFormatCount = 0,
+      .viewFormats = nullptr,
+    };
+
+    offscreen_textures_.reserve(desc.image_count);
+    for (uint32_t i = 0; i < desc.image_count; ++i) {
+      offscreen_textures_.emplace_back(device_.CreateTexture(&texture_desc));
+    }
+    offscreen_swapchain_ = std::make_unique<present::OffscreenSwapchain>(
+      desc.image_count,
+      std::chrono::nanoseconds(desc.present_latency_ns)
+    );
+
+    // Describes the swapchain texture as a surface configuration would.
+    wgpu::SurfaceConfiguration const surface_config {
+      .device = device_,
+      .format = format,
+      .usage = kTextureUsage,
+      .width = width,
+      .height = height,
+    };
+    mnexus_device_.OnWgpuSurfaceConfigured(surface_config);
+  }
+
 private:
   wgpu::Instance instance_;
   wgpu::Adapter adapter_;
@@ -1075,9 +2013,12 @@ private:
 
   wgpu::Surface surface_;
   uint64_t last_surface_window_handle_ = 0;
+
+  std::unique_ptr<present::OffscreenSwapchain> offscreen_swapchain_;
+  std::vector<wgpu::Texture> offscreen_textures_;
 };
 
-std::unique_ptr<IBackendWebGpu> IBackendWebGpu::Create() {
+std::unique_ptr<IBackendWebGpu> IBackendWebGpu::Create(BackendWebGpuCreateDesc const& create_desc) {
   std::vector<wgpu::InstanceFeatureName> required_features = {
     wgpu::InstanceFeatureName::TimedWaitAny
   };
@@ -1125,7 +2066,14 @@ std::unique_ptr<IBackendWebGpu> IBackendWebGpu::Create() {
 
   wgpu::Device device;
   {
+    std::vector<wgpu::FeatureName> required_device_features;
+    if (adapter.HasFeature(wgpu::FeatureName::TimestampQuery)) {
+      required_device_features.emplace_back(wgpu::FeatureName::TimestampQuery);
+    }
+
     wgpu::DeviceDescriptor desc {};
+    desc.requiredFeatureCount = required_device_features.size();
+    desc.requiredFeatures = required_device_features.data();
     desc.SetUncapturedErrorCallback(
       [](const wgpu::Device&, wgpu::ErrorType errorType, wgpu::StringView message) {
         MBASE_LOG_ERROR("Uncaptured error ({}): {}", errorType, message);
@@ -1153,8 +2101,12 @@ std::unique_ptr<IBackendWebGpu> IBackendWebGpu::Create() {
   auto backend = std::make_unique<BackendWebGpu>(
     std::move(instance),
     std::move(adapter),
-    std::move(device)
+    std::move(device),
+    create_desc.submission_thread
   );
+  if (create_desc.offscreen_swapchain.image_count != 0) {
+    backend->ConfigureOffscreenSwapchain(create_desc.offscreen_swapchain);
+  }
   return backend;
 }
 
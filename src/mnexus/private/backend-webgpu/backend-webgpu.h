@@ -8,9 +8,14 @@
 
 namespace mnexus_backend::webgpu {
 
+struct BackendWebGpuCreateDesc {
+  bool submission_thread = false;
+  mnexus::OffscreenSwapchainDesc offscreen_swapchain;
+};
+
 class IBackendWebGpu : public IBackend {
 public:
-  static std::unique_ptr<IBackendWebGpu> Create();
+  static std::unique_ptr<IBackendWebGpu> Create(BackendWebGpuCreateDesc const& desc);
 
   ~IBackendWebGpu() override = default;
 
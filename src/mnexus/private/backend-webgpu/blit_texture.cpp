@@ -2,29 +2,47 @@
 #include "backend-webgpu/blit_texture.h"
 
 // c++ headers ------------------------------------------
-#include <cstring>
-
 #include <algorithm>
 #include <mutex>
 #include <sstream>
 #include <unordered_map>
+#include <vector>
 
 // public project headers -------------------------------
 #include "mbase/public/assert.h"
 #include "mbase/public/tsa.h"
 
 // project headers --------------------------------------
-#include "backend-webgpu/backend-webgpu-texture.h"
 #include "backend-webgpu/builtin_shader.h"
+#include "backend-webgpu/texture_view_cache.h"
 
 namespace mnexus_backend::webgpu::blit_texture {
 
 namespace {
 
+/// Bind groups retained per source texture; the oldest entry is evicted beyond this.
+constexpr uint32_t kMaxCachedBindGroupsPerSource = 64;
+
 wgpu::Sampler s_sampler_nearest;
 wgpu::Sampler s_sampler_linear;
 wgpu::Device s_device; // Cached for lazy pipeline creation.
 
+// Explicit layout so that the params can be bound with a dynamic offset into scratch pages; shared by all pipelines.
+wgpu::BindGroupLayout s_bind_group_layout;
+wgpu::PipelineLayout s_pipeline_layout;
+
+struct CachedBindGroup {
+  WGPUTextureView src_view;
+  mnexus::Filter filter;
+  /// The scratch page buffer holding the params; it lives as long as the arena.
+  WGPUBuffer params_buffer;
+  wgpu::BindGroup bind_group;
+};
+
+// Bind groups per source texture, keyed on the source view, the sampler and the params page.
+mbase::Lockable<std::mutex> s_bind_groups_mutex;
+std::unordered_map<WGPUTexture, std::vector<CachedBindGroup>> s_bind_groups MBASE_GUARDED_BY(s_bind_groups_mutex);
+
 // Per-format render pipelines (lazy init).
 // The shader is format-agnostic; only the ColorTargetState format differs.
 mbase::Lockable<std::mutex> s_pipelines_mutex;
@@ -51,6 +69,7 @@ wgpu::RenderPipeline GetPipeline(wgpu::TextureFormat dst_format) MBASE_REQUIRES(
 
   wgpu::RenderPipelineDescriptor pipeline_desc {};
   pipeline_desc.label = label.c_str();
+  pipeline_desc.layout = s_pipeline_layout;
   pipeline_desc.vertex.module = builtin_shader::GetFullScreenQuadVs();
   pipeline_desc.fragment = &fragment_state;
   pipeline_desc.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
@@ -63,6 +82,58 @@ wgpu::RenderPipeline GetPipeline(wgpu::TextureFormat dst_format) MBASE_REQUIRES(
   return pipeline;
 }
 
+/// Returns the bind group sampling `src_view` with `filter` and reading the params at a dynamic offset into
+/// `params_buffer`, creating it on a miss. Returns 1 if a bind group was created.
+uint32_t FindOrCreateBindGroup(
+  wgpu::Device const& wgpu_device,
+  wgpu::Texture const& src_texture,
+  wgpu::TextureView const& src_view,
+  mnexus::Filter filter,
+  wgpu::Buffer const& params_buffer,
+  wgpu::BindGroup& out_bind_group
+) {
+  mbase::LockGuard lock(s_bind_groups_mutex);
+
+  std::vector<CachedBindGroup>& cached = s_bind_groups[src_texture.Get()];
+  for (CachedBindGroup const& entry : cached) {
+    if (entry.src_view == src_view.Get() && entry.filter == filter && entry.params_buffer == params_buffer.Get()) {
+      out_bind_group = entry.bind_group;
+      return 0;
+    }
+  }
+
+  wgpu::BindGroupEntry entries[3] {};
+  entries[0].binding = 0;
+  entries[0].buffer = params_buffer;
+  entries[0].offset = 0;
+  entries[0].size = sizeof(float) * 4;
+
+  entries[1].binding = 1;
+  entries[1].textureView = src_view;
+
+  entries[2].binding = 2;
+  entries[2].sampler = (filter == mnexus::Filter::kLinear) ? s_sampler_linear : s_sampler_nearest;
+
+  wgpu::BindGroupDescriptor bg_desc {};
+  bg_desc.layout = s_bind_group_layout;
+  bg_desc.entryCount = 3;
+  bg_desc.entries = entries;
+  out_bind_group = wgpu_device.CreateBindGroup(&bg_desc);
+
+  if (cached.size() >= kMaxCachedBindGroupsPerSource) {
+    cached.erase(cached.begin());
+  }
+  cached.emplace_back(
+    CachedBindGroup {
+      .src_view = src_view.Get(),
+      .filter = filter,
+      .params_buffer = params_buffer.Get(),
+      .bind_group = out_bind_group,
+    }
+  );
+  return 1;
+}
+
 } // namespace
 
 void Initialize(wgpu::Device const& wgpu_device) {
@@ -88,6 +159,35 @@ void Initialize(wgpu::Device const& wgpu_device) {
     s_sampler_linear = wgpu_device.CreateSampler(&desc);
   }
 
+  // Create the bind group layout (params, src_view, sampler) and the pipeline layout shared by all formats.
+  {
+    wgpu::BindGroupLayoutEntry layout_entries[3] {};
+    layout_entries[0].binding = 0;
+    layout_entries[0].visibility = wgpu::ShaderStage::Fragment;
+    layout_entries[0].buffer.type = wgpu::BufferBindingType::Uniform;
+    layout_entries[0].buffer.hasDynamicOffset = true;
+    layout_entries[0].buffer.minBindingSize = sizeof(float) * 4;
+
+    layout_entries[1].binding = 1;
+    layout_entries[1].visibility = wgpu::ShaderStage::Fragment;
+    layout_entries[1].texture.sampleType = wgpu::TextureSampleType::Float;
+    layout_entries[1].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+
+    layout_entries[2].binding = 2;
+    layout_entries[2].visibility = wgpu::ShaderStage::Fragment;
+    layout_entries[2].sampler.type = wgpu::SamplerBindingType::Filtering;
+
+    wgpu::BindGroupLayoutDescriptor bgl_desc {};
+    bgl_desc.entryCount = 3;
+    bgl_desc.entries = layout_entries;
+    s_bind_group_layout = wgpu_device.CreateBindGroupLayout(&bgl_desc);
+
+    wgpu::PipelineLayoutDescriptor pipeline_layout_desc {};
+    pipeline_layout_desc.bindGroupLayoutCount = 1;
+    pipeline_layout_desc.bindGroupLayouts = &s_bind_group_layout;
+    s_pipeline_layout = wgpu_device.CreatePipelineLayout(&pipeline_layout_desc);
+  }
+
   // Cache device for lazy pipeline creation.
   s_device = wgpu_device;
 }
@@ -95,16 +195,28 @@ void Initialize(wgpu::Device const& wgpu_device) {
 void Shutdown() {
   s_sampler_nearest = nullptr;
   s_sampler_linear = nullptr;
+  {
+    mbase::LockGuard lock(s_bind_groups_mutex);
+    s_bind_groups.clear();
+  }
   {
     mbase::LockGuard lock(s_pipelines_mutex);
     s_pipelines.clear();
   }
+  s_pipeline_layout = nullptr;
+  s_bind_group_layout = nullptr;
   s_device = nullptr;
 }
 
-void BlitTexture2D(
+void ForgetTexture(WGPUTexture texture) {
+  mbase::LockGuard lock(s_bind_groups_mutex);
+  s_bind_groups.erase(texture);
+}
+
+uint32_t BlitTexture2D(
   wgpu::Device const& wgpu_device,
   wgpu::CommandEncoder& command_encoder,
+  ScratchAllocator& scratch,
   wgpu::Texture const& src_texture,
   wgpu::TextureFormat src_format,
   mnexus::TextureSubresourceRange const& src_subresource,
@@ -134,56 +246,24 @@ void BlitTexture2D(
     pipeline = GetPipeline(dst_format);
   }
 
-  wgpu::Sampler const& sampler = (filter == mnexus::Filter::kLinear)
-    ? s_sampler_linear
-    : s_sampler_nearest;
-
-  // Create params uniform buffer (16 bytes, mapped at creation).
-  wgpu::BufferDescriptor params_buf_desc {};
-  params_buf_desc.size = sizeof(params_data);
-  params_buf_desc.usage = wgpu::BufferUsage::Uniform;
-  params_buf_desc.mappedAtCreation = true;
-  wgpu::Buffer params_buffer = wgpu_device.CreateBuffer(&params_buf_desc);
-  std::memcpy(params_buffer.GetMappedRange(), params_data, sizeof(params_data));
-  params_buffer.Unmap();
-
-  // Create texture views.
-  wgpu::TextureViewDescriptor src_view_desc = MakeWgpuTextureViewDesc(
-    src_format,
-    wgpu::TextureViewDimension::e2D,
-    src_subresource,
-    wgpu::TextureAspect::All
-  );
-  wgpu::TextureView src_view = src_texture.CreateView(&src_view_desc);
+  // Params live in a scratch uniform slice uploaded at submission.
+  ScratchSlice const params_slice = scratch.AllocateUniform(params_data, sizeof(params_data));
+  if (!params_slice) {
+    return 0;
+  }
 
-  wgpu::TextureViewDescriptor dst_view_desc = MakeWgpuTextureViewDesc(
-    dst_format,
-    wgpu::TextureViewDimension::e2D,
-    dst_subresource,
-    wgpu::TextureAspect::All
+  wgpu::TextureView const src_view = texture_view_cache::GetSubresourceView(
+    src_texture, src_format, src_subresource.base_mip_level, src_subresource.base_array_layer
+  );
+  wgpu::TextureView const dst_view = texture_view_cache::GetSubresourceView(
+    dst_texture, dst_format, dst_subresource.base_mip_level, dst_subresource.base_array_layer
   );
-  wgpu::TextureView dst_view = dst_texture.CreateView(&dst_view_desc);
-
-  // Create bind group (3 entries: params, src_view, sampler).
-  wgpu::BindGroupLayout layout = pipeline.GetBindGroupLayout(0);
-
-  wgpu::BindGroupEntry entries[3] {};
-  entries[0].binding = 0;
-  entries[0].buffer = params_buffer;
-  entries[0].offset = 0;
-  entries[0].size = sizeof(params_data);
-
-  entries[1].binding = 1;
-  entries[1].textureView = src_view;
-
-  entries[2].binding = 2;
-  entries[2].sampler = sampler;
 
-  wgpu::BindGroupDescriptor bg_desc {};
-  bg_desc.layout = layout;
-  bg_desc.entryCount = 3;
-  bg_desc.entries = entries;
-  wgpu::BindGroup bind_group = wgpu_device.CreateBindGroup(&bg_desc);
+  wgpu::BindGroup bind_group;
+  uint32_t const bind_groups_created = FindOrCreateBindGroup(
+    wgpu_device, src_texture, src_view, filter, params_slice.page->buffer(), bind_group
+  );
+  uint32_t const dynamic_offset = static_cast<uint32_t>(params_slice.offset);
 
   // Record render pass with dst texture as color attachment.
   wgpu::RenderPassColorAttachment color_attachment {};
@@ -197,7 +277,7 @@ void BlitTexture2D(
 
   wgpu::RenderPassEncoder pass = command_encoder.BeginRenderPass(&rp_desc);
   pass.SetPipeline(pipeline);
-  pass.SetBindGroup(0, bind_group);
+  pass.SetBindGroup(0, bind_group, 1, &dynamic_offset);
   pass.SetViewport(
     static_cast<float>(dst_offset_x),
     static_cast<float>(dst_offset_y),
@@ -207,6 +287,75 @@ void BlitTexture2D(
   );
   pass.Draw(3);
   pass.End();
+
+  return bind_groups_created;
+}
+
+uint32_t BlitMipChain2D(
+  wgpu::Device const& wgpu_device,
+  wgpu::CommandEncoder& command_encoder,
+  ScratchAllocator& scratch,
+  wgpu::Texture const& texture,
+  wgpu::TextureFormat format,
+  uint32_t base_mip_level,
+  std::span<wgpu::TextureView const> level_views
+) {
+  if (level_views.size() < 2) {
+    return 0;
+  }
+
+  wgpu::RenderPipeline pipeline;
+  {
+    mbase::LockGuard lock(s_pipelines_mutex);
+    pipeline = GetPipeline(format);
+  }
+
+  uint32_t bind_group_count = 0;
+
+  for (uint32_t level = 1; level < level_views.size(); ++level) {
+    // Sample the even-sized prefix of the source level: the scale is then exactly 2:1 and every linear sample
+    // averages a 2x2 footprint. A trailing odd row or column is left out; a 1-texel axis is sampled at its center.
+    uint32_t const src_width = std::max(1u, texture.GetWidth() >> (base_mip_level + level - 1));
+    uint32_t const src_height = std::max(1u, texture.GetHeight() >> (base_mip_level + level - 1));
+    uint32_t const dst_width = std::max(1u, texture.GetWidth() >> (base_mip_level + level));
+    uint32_t const dst_height = std::max(1u, texture.GetHeight() >> (base_mip_level + level));
+    float const params_data[4] = {
+      0.0f,
+      0.0f,
+      std::min(src_width, dst_width * 2) / float(src_width),
+      std::min(src_height, dst_height * 2) / float(src_height),
+    };
+
+    ScratchSlice const params_slice = scratch.AllocateUniform(params_data, sizeof(params_data));
+    if (!params_slice) {
+      break;
+    }
+
+    wgpu::BindGroup bind_group;
+    bind_group_count += FindOrCreateBindGroup(
+      wgpu_device, texture, level_views[level - 1], mnexus::Filter::kLinear, params_slice.page->buffer(), bind_group
+    );
+    uint32_t const dynamic_offset = static_cast<uint32_t>(params_slice.offset);
+
+    // The whole level is overwritten, so its previous contents need not be loaded.
+    wgpu::RenderPassColorAttachment color_attachment {};
+    color_attachment.view = level_views[level];
+    color_attachment.loadOp = wgpu::LoadOp::Clear;
+    color_attachment.storeOp = wgpu::StoreOp::Store;
+    color_attachment.clearValue = { 0.0, 0.0, 0.0, 0.0 };
+
+    wgpu::RenderPassDescriptor rp_desc {};
+    rp_desc.colorAttachmentCount = 1;
+    rp_desc.colorAttachments = &color_attachment;
+
+    wgpu::RenderPassEncoder pass = command_encoder.BeginRenderPass(&rp_desc);
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bind_group, 1, &dynamic_offset);
+    pass.Draw(3);
+    pass.End();
+  }
+
+  return bind_group_count;
 }
 
 } // namespace mnexus_backend::webgpu::blit_texture
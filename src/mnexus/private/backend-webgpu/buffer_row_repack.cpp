@@ -2,10 +2,15 @@
 #include "backend-webgpu/buffer_row_repack.h"
 
 // c++ headers ------------------------------------------
-#include <cstring>
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 // public project headers -------------------------------
 #include "mbase/public/assert.h"
+#include "mbase/public/tsa.h"
 
 // project headers --------------------------------------
 #include "backend-webgpu/builtin_shader.h"
@@ -14,14 +19,69 @@ namespace mnexus_backend::webgpu::buffer_row_repack {
 
 namespace {
 
+/// Default `maxStorageBufferBindingSize`; caps the whole-buffer binding of the source.
+constexpr uint64_t kMaxStorageBufferBindingSize = 128ull * 1024 * 1024;
+
+struct Params {
+  uint32_t src_offset;
+  uint32_t src_bytes_per_row;
+  uint32_t dst_bytes_per_row;
+  uint32_t row_count;
+};
+
+/// Bind groups retained per source buffer; the oldest entry is evicted beyond this.
+constexpr uint32_t kMaxCachedBindGroupsPerSource = 16;
+
+wgpu::BindGroupLayout s_bind_group_layout;
 wgpu::ComputePipeline s_pipeline;
 
+struct CachedBindGroup {
+  /// The scratch page buffers holding the params and the destination; they live as long as the arena.
+  WGPUBuffer params_buffer;
+  WGPUBuffer dst_buffer;
+  uint64_t dst_binding_size;
+  wgpu::BindGroup bind_group;
+};
+
+// Bind groups per source buffer. Only the scratch pages and the destination binding size vary between the repacks
+// of one source, so a source that is uploaded from repeatedly hits after its first few uses.
+mbase::Lockable<std::mutex> s_bind_groups_mutex;
+std::unordered_map<WGPUBuffer, std::vector<CachedBindGroup>> s_bind_groups MBASE_GUARDED_BY(s_bind_groups_mutex);
+
 } // namespace
 
 void Initialize(wgpu::Device const& wgpu_device) {
+  // Explicit layout so that the params and the destination can be bound with dynamic offsets into scratch pages.
+  wgpu::BindGroupLayoutEntry layout_entries[3] {};
+  layout_entries[0].binding = 0;
+  layout_entries[0].visibility = wgpu::ShaderStage::Compute;
+  layout_entries[0].buffer.type = wgpu::BufferBindingType::Uniform;
+  layout_entries[0].buffer.hasDynamicOffset = true;
+  layout_entries[0].buffer.minBindingSize = sizeof(Params);
+
+  layout_entries[1].binding = 1;
+  layout_entries[1].visibility = wgpu::ShaderStage::Compute;
+  layout_entries[1].buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+
+  layout_entries[2].binding = 2;
+  layout_entries[2].visibility = wgpu::ShaderStage::Compute;
+  layout_entries[2].buffer.type = wgpu::BufferBindingType::Storage;
+  layout_entries[2].buffer.hasDynamicOffset = true;
+
+  wgpu::BindGroupLayoutDescriptor bgl_desc {};
+  bgl_desc.entryCount = 3;
+  bgl_desc.entries = layout_entries;
+  s_bind_group_layout = wgpu_device.CreateBindGroupLayout(&bgl_desc);
+
+  wgpu::PipelineLayoutDescriptor pipeline_layout_desc {};
+  pipeline_layout_desc.bindGroupLayoutCount = 1;
+  pipeline_layout_desc.bindGroupLayouts = &s_bind_group_layout;
+  wgpu::PipelineLayout pipeline_layout = wgpu_device.CreatePipelineLayout(&pipeline_layout_desc);
+
   wgpu::ShaderModule shader_module = builtin_shader::GetBufferRepackRowsCs();
 
   wgpu::ComputePipelineDescriptor desc {};
+  desc.layout = pipeline_layout;
   desc.compute.module = shader_module;
   desc.compute.entryPoint = "main";
   s_pipeline = wgpu_device.CreateComputePipeline(&desc);
@@ -29,12 +89,18 @@ void Initialize(wgpu::Device const& wgpu_device) {
 }
 
 void Shutdown() {
+  {
+    mbase::LockGuard lock(s_bind_groups_mutex);
+    s_bind_groups.clear();
+  }
   s_pipeline = nullptr;
+  s_bind_group_layout = nullptr;
 }
 
-wgpu::Buffer RepackRows(
+RepackResult RepackRows(
   wgpu::Device const& wgpu_device,
   wgpu::CommandEncoder& command_encoder,
+  ScratchAllocator& scratch,
   wgpu::Buffer const& src_buffer,
   uint32_t src_offset,
   uint32_t src_bytes_per_row,
@@ -45,67 +111,111 @@ wgpu::Buffer RepackRows(
   MBASE_ASSERT(dst_bytes_per_row % 4 == 0);
   MBASE_ASSERT(row_count > 0);
 
-  // Create params uniform buffer (16 bytes, mapped at creation).
-  uint32_t const params_data[4] = {
-    src_offset,
-    src_bytes_per_row,
-    dst_bytes_per_row,
-    row_count,
+  Params const params {
+    .src_offset = src_offset,
+    .src_bytes_per_row = src_bytes_per_row,
+    .dst_bytes_per_row = dst_bytes_per_row,
+    .row_count = row_count,
+  };
+  ScratchSlice const params_slice = scratch.AllocateUniform(&params, sizeof(params));
+
+  // The destination binding size is part of the bind group, so round it to a power of two to keep the number of
+  // distinct bind groups per source small.
+  uint64_t const dst_size = static_cast<uint64_t>(dst_bytes_per_row) * row_count;
+  uint64_t const dst_binding_size = std::max(std::bit_ceil(dst_size), ScratchArena::kAlignment);
+  ScratchSlice const dst_slice = scratch.AllocateStorage(dst_binding_size);
+
+  if (!params_slice || !dst_slice) {
+    return RepackResult {};
+  }
+
+  // Bind the whole source so that the bind group does not depend on the copy region.
+  uint64_t const src_binding_size = std::min(src_buffer.GetSize() & ~uint64_t(3), kMaxStorageBufferBindingSize);
+  MBASE_ASSERT_MSG(
+    static_cast<uint64_t>(src_offset) + static_cast<uint64_t>(src_bytes_per_row) * row_count <= src_binding_size,
+    "Repacked rows exceed the source binding"
+  );
+
+  wgpu::Buffer const& params_buffer = params_slice.page->buffer();
+  wgpu::Buffer const& dst_buffer = dst_slice.page->buffer();
+
+  uint32_t bind_groups_created = 0;
+  wgpu::BindGroup bind_group;
+  {
+    mbase::LockGuard lock(s_bind_groups_mutex);
+
+    std::vector<CachedBindGroup>& cached = s_bind_groups[src_buffer.Get()];
+    for (CachedBindGroup const& entry : cached) {
+      if (entry.params_buffer == params_buffer.Get() && entry.dst_buffer == dst_buffer.Get() &&
+          entry.dst_binding_size == dst_binding_size) {
+        bind_group = entry.bind_group;
+        break;
+      }
+    }
+
+    if (!bind_group) {
+      wgpu::BindGroupEntry entries[3] {};
+      entries[0].binding = 0;
+      entries[0].buffer = params_buffer;
+      entries[0].offset = 0;
+      entries[0].size = sizeof(Params);
+
+      entries[1].binding = 1;
+      entries[1].buffer = src_buffer;
+      entries[1].offset = 0;
+      entries[1].size = src_binding_size;
+
+      entries[2].binding = 2;
+      entries[2].buffer = dst_buffer;
+      entries[2].offset = 0;
+      entries[2].size = dst_binding_size;
+
+      wgpu::BindGroupDescriptor bg_desc {};
+      bg_desc.layout = s_bind_group_layout;
+      bg_desc.entryCount = 3;
+      bg_desc.entries = entries;
+      bind_group = wgpu_device.CreateBindGroup(&bg_desc);
+      bind_groups_created = 1;
+
+      if (cached.size() >= kMaxCachedBindGroupsPerSource) {
+        cached.erase(cached.begin());
+      }
+      cached.emplace_back(
+        CachedBindGroup {
+          .params_buffer = params_buffer.Get(),
+          .dst_buffer = dst_buffer.Get(),
+          .dst_binding_size = dst_binding_size,
+          .bind_group = bind_group,
+        }
+      );
+    }
+  }
+
+  // Dynamic offsets in binding order: params, dst.
+  uint32_t const dynamic_offsets[2] = {
+    static_cast<uint32_t>(params_slice.offset),
+    static_cast<uint32_t>(dst_slice.offset),
   };
-
-  wgpu::BufferDescriptor params_buf_desc {};
-  params_buf_desc.size = sizeof(params_data);
-  params_buf_desc.usage = wgpu::BufferUsage::Uniform;
-  params_buf_desc.mappedAtCreation = true;
-  wgpu::Buffer params_buffer = wgpu_device.CreateBuffer(&params_buf_desc);
-  std::memcpy(params_buffer.GetMappedRange(), params_data, sizeof(params_data));
-  params_buffer.Unmap();
-
-  // Create aligned temp buffer.
-  uint64_t const temp_size = static_cast<uint64_t>(dst_bytes_per_row) * row_count;
-  wgpu::BufferDescriptor temp_buf_desc {};
-  temp_buf_desc.size = temp_size;
-  temp_buf_desc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc;
-  wgpu::Buffer temp_buffer = wgpu_device.CreateBuffer(&temp_buf_desc);
-
-  // Create bind group.
-  wgpu::BindGroupLayout layout = s_pipeline.GetBindGroupLayout(0);
-
-  uint64_t const src_bind_size = static_cast<uint64_t>(src_offset) + static_cast<uint64_t>(src_bytes_per_row) * row_count;
-
-  wgpu::BindGroupEntry entries[3] {};
-  entries[0].binding = 0;
-  entries[0].buffer = params_buffer;
-  entries[0].offset = 0;
-  entries[0].size = sizeof(params_data);
-
-  entries[1].binding = 1;
-  entries[1].buffer = src_buffer;
-  entries[1].offset = 0;
-  entries[1].size = src_bind_size;
-
-  entries[2].binding = 2;
-  entries[2].buffer = temp_buffer;
-  entries[2].offset = 0;
-  entries[2].size = temp_size;
-
-  wgpu::BindGroupDescriptor bg_desc {};
-  bg_desc.layout = layout;
-  bg_desc.entryCount = 3;
-  bg_desc.entries = entries;
-  wgpu::BindGroup bind_group = wgpu_device.CreateBindGroup(&bg_desc);
 
   // Record compute pass.
   wgpu::ComputePassEncoder pass = command_encoder.BeginComputePass();
   pass.SetPipeline(s_pipeline);
-  pass.SetBindGroup(0, bind_group);
+  pass.SetBindGroup(0, bind_group, 2, dynamic_offsets);
 
   uint32_t const words_per_row = src_bytes_per_row / 4;
   uint32_t const workgroup_x = (words_per_row + 63) / 64;
   pass.DispatchWorkgroups(workgroup_x, row_count, 1);
   pass.End();
 
-  return temp_buffer;
+  return RepackResult {
+    .rows = ScratchSlice { .page = dst_slice.page, .offset = dst_slice.offset, .size = dst_size },
+    .bind_groups_created = bind_groups_created,
+  };
+}
+
+void ForgetSourceBuffer(WGPUBuffer src_buffer) {
+  mbase::LockGuard lock(s_bind_groups_mutex);
+  s_bind_groups.erase(src_buffer);
 }
 
 } // namespace mnexus_backend::webgpu::buffer_row_repack
@@ -2,6 +2,7 @@
 
 // project headers --------------------------------------
 #include "backend-webgpu/include_dawn.h"
+#include "backend-webgpu/scratch_arena.h"
 
 #include <cstdint>
 
@@ -10,13 +11,22 @@ namespace mnexus_backend::webgpu::buffer_row_repack {
 void Initialize(wgpu::Device const& wgpu_device);
 void Shutdown();
 
+struct RepackResult final {
+  /// Storage slice holding the aligned rows; usable as a `CopyBufferToTexture` source. Null on failure.
+  ScratchSlice rows;
+  /// 1 if a bind group had to be created, 0 if a cached one was reused.
+  uint32_t bind_groups_created = 0;
+};
+
 /// Repacks buffer rows from tight packing to 256-byte-aligned row pitch
 /// using an internal compute pass recorded on the given command encoder.
-/// Returns a temporary buffer with aligned rows and CopySrc usage.
+/// The params and the aligned rows are carved out of `scratch` and bound with dynamic offsets, and the bind group is
+/// cached per `src_buffer`, so the steady state creates neither buffers nor bind groups.
 /// Requires: src_bytes_per_row % 4 == 0.
-wgpu::Buffer RepackRows(
+RepackResult RepackRows(
   wgpu::Device const& wgpu_device,
   wgpu::CommandEncoder& command_encoder,
+  ScratchAllocator& scratch,
   wgpu::Buffer const& src_buffer,
   uint32_t src_offset,
   uint32_t src_bytes_per_row,
@@ -24,4 +34,8 @@ wgpu::Buffer RepackRows(
   uint32_t row_count
 );
 
+/// Drops the bind groups cached for `src_buffer`. **MUST** be called before the buffer is released, so that the cache
+/// neither keeps it alive nor hands its bind groups to a later buffer reusing the same object address.
+void ForgetSourceBuffer(WGPUBuffer src_buffer);
+
 } // namespace mnexus_backend::webgpu::buffer_row_repack
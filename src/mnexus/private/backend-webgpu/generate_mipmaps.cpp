@@ -0,0 +1,298 @@
+// TU header --------------------------------------------
+#include "backend-webgpu/generate_mipmaps.h"
+
+// c++ headers ------------------------------------------
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+#include "mbase/public/log.h"
+#include "mbase/public/tsa.h"
+
+// project headers --------------------------------------
+#include "backend-webgpu/blit_texture.h"
+#include "backend-webgpu/texture_view_cache.h"
+#include "backend-webgpu/webgpu_format.h"
+
+namespace mnexus_backend::webgpu::generate_mipmaps {
+
+namespace {
+
+/// Mip levels written per compute dispatch; bounded by the default `maxStorageTexturesPerShaderStage` (4).
+constexpr uint32_t kMaxLevelsPerDispatch = 4;
+/// Workgroup edge length; also the edge of the first level's tile kept in workgroup memory.
+constexpr uint32_t kWorkgroupSize = 8;
+
+wgpu::Device s_device; // Cached for lazy pipeline creation.
+
+// Per-(format, level count) compute pipelines (lazy init).
+// The storage texture format is part of the WGSL declaration, so unlike the blit pipelines the shader itself is
+// specialized; it is generated as WGSL text rather than shipped as a builtin SPIR-V module.
+mbase::Lockable<std::mutex> s_pipelines_mutex;
+std::unordered_map<uint64_t, wgpu::ComputePipeline> s_pipelines MBASE_GUARDED_BY(s_pipelines_mutex);
+
+/// WGSL storage texel format name if `format` can be downsampled in compute, empty otherwise.
+/// Restricted to filterable formats that are storage-capable in core WebGPU.
+std::string_view GetStorageFormatName(wgpu::TextureFormat format) {
+  switch (format) {
+  case wgpu::TextureFormat::RGBA8Unorm:  return "rgba8unorm";
+  case wgpu::TextureFormat::RGBA8Snorm:  return "rgba8snorm";
+  case wgpu::TextureFormat::RGBA16Float: return "rgba16float";
+  default:                               return {};
+  }
+}
+
+/// Whether `format` can be downsampled by the blit fallback (renderable and filterable as float).
+bool IsBlitFormat(wgpu::TextureFormat format) {
+  switch (format) {
+  case wgpu::TextureFormat::R8Unorm:
+  case wgpu::TextureFormat::RG8Unorm:
+  case wgpu::TextureFormat::RGBA8Unorm:
+  case wgpu::TextureFormat::RGBA8UnormSrgb:
+  case wgpu::TextureFormat::BGRA8Unorm:
+  case wgpu::TextureFormat::BGRA8UnormSrgb:
+  case wgpu::TextureFormat::R16Float:
+  case wgpu::TextureFormat::RG16Float:
+  case wgpu::TextureFormat::RGBA16Float:
+  case wgpu::TextureFormat::RGB10A2Unorm:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/// Generates the downsampling kernel for `level_count` levels.
+///
+/// Each invocation box-filters a 2x2 footprint of the source level into the first level; the workgroup's 8x8 tile
+/// of that level stays in workgroup memory and every further level is reduced from the tile of the previous one, so
+/// the source is read once per dispatch. Footprints are clamped to the edge of the previous level, which keeps odd
+/// sizes well-defined and tile-local.
+std::string GenerateDownsampleWgsl(std::string_view storage_format_name, uint32_t level_count) {
+  std::string code;
+  code.reserve(4096);
+
+  code += "@group(0) @binding(0) var src_level : texture_2d<f32>;\n";
+  for (uint32_t level = 0; level < level_count; ++level) {
+    code += "@group(0) @binding(" + std::to_string(level + 1) + ") var dst_level_" + std::to_string(level);
+    code += " : texture_storage_2d<" + std::string(storage_format_name) + ", write>;\n";
+  }
+
+  code += R"(
+var<workgroup> tile : array<array<vec4<f32>, 8>, 8>;
+
+fn LoadSrc(p : vec2<i32>, size : vec2<i32>) -> vec4<f32> {
+  return textureLoad(src_level, min(p, size - vec2<i32>(1)), 0);
+}
+
+fn LoadTile(tile_origin : vec2<i32>, p : vec2<i32>, size : vec2<i32>) -> vec4<f32> {
+  let q = clamp(min(p, size - vec2<i32>(1)) - tile_origin, vec2<i32>(0), vec2<i32>(7));
+  return tile[q.y][q.x];
+}
+
+@compute @workgroup_size(8, 8)
+fn main(@builtin(workgroup_id) wg : vec3<u32>, @builtin(local_invocation_id) lid : vec3<u32>) {
+  let local_id = vec2<i32>(lid.xy);
+  var src_size = vec2<i32>(textureDimensions(src_level));
+  var dst_size = max(src_size / 2, vec2<i32>(1));
+  var dst_origin = vec2<i32>(wg.xy) * 8;
+  var src_origin = dst_origin;
+  var p = dst_origin + local_id;
+  var color = 0.25 * (
+    LoadSrc(p * 2, src_size) + LoadSrc(p * 2 + vec2<i32>(1, 0), src_size) +
+    LoadSrc(p * 2 + vec2<i32>(0, 1), src_size) + LoadSrc(p * 2 + vec2<i32>(1, 1), src_size));
+  if (all(p < dst_size)) {
+    textureStore(dst_level_0, p, color);
+  }
+  tile[local_id.y][local_id.x] = color;
+)";
+
+  for (uint32_t level = 1; level < level_count; ++level) {
+    std::string const extent = std::to_string(kWorkgroupSize >> level);
+    std::string const dst = "dst_level_" + std::to_string(level);
+
+    code += R"(
+  workgroupBarrier();
+  src_size = dst_size;
+  dst_size = max(dst_size / 2, vec2<i32>(1));
+  src_origin = dst_origin;
+  dst_origin = dst_origin / 2;
+  p = dst_origin + local_id;
+  if (all(local_id < vec2<i32>()" + extent + R"())) {
+    color = 0.25 * (
+      LoadTile(src_origin, p * 2, src_size) + LoadTile(src_origin, p * 2 + vec2<i32>(1, 0), src_size) +
+      LoadTile(src_origin, p * 2 + vec2<i32>(0, 1), src_size) + LoadTile(src_origin, p * 2 + vec2<i32>(1, 1), src_size));
+  }
+  workgroupBarrier();
+  if (all(local_id < vec2<i32>()" + extent + R"())) {
+    tile[local_id.y][local_id.x] = color;
+    if (all(p < dst_size)) {
+      textureStore()" + dst + R"(, p, color);
+    }
+  }
+)";
+  }
+
+  code += "}\n";
+  return code;
+}
+
+wgpu::ComputePipeline GetPipeline(wgpu::TextureFormat format, uint32_t level_count) MBASE_REQUIRES(s_pipelines_mutex) {
+  uint64_t const key = (static_cast<uint64_t>(format) << 8) | level_count;
+
+  auto it = s_pipelines.find(key);
+  if (it != s_pipelines.end()) {
+    return it->second;
+  }
+
+  std::string const code = GenerateDownsampleWgsl(GetStorageFormatName(format), level_count);
+
+  wgpu::ShaderSourceWGSL wgsl_source {};
+  wgsl_source.code = wgpu::StringView { code.data(), code.size() };
+
+  wgpu::ShaderModuleDescriptor module_desc {};
+  module_desc.nextInChain = &wgsl_source;
+  wgpu::ShaderModule shader_module = s_device.CreateShaderModule(&module_desc);
+
+  std::string const label = "GenerateMipmaps [" + std::string(GetStorageFormatName(format)) + " x" + std::to_string(level_count) + "]";
+
+  wgpu::ComputePipelineDescriptor pipeline_desc {};
+  pipeline_desc.label = label.c_str();
+  pipeline_desc.compute.module = shader_module;
+  pipeline_desc.compute.entryPoint = "main";
+
+  wgpu::ComputePipeline pipeline = s_device.CreateComputePipeline(&pipeline_desc);
+  MBASE_ASSERT_MSG(bool(pipeline), "Failed to create mipmap downsample compute pipeline");
+
+  s_pipelines[key] = pipeline;
+  return pipeline;
+}
+
+uint32_t DownsampleCompute(
+  wgpu::Device const& wgpu_device,
+  wgpu::CommandEncoder& command_encoder,
+  wgpu::TextureFormat format,
+  std::vector<wgpu::TextureView> const& level_views,
+  uint32_t base_width,
+  uint32_t base_height
+) {
+  uint32_t bind_group_count = 0;
+
+  wgpu::ComputePassDescriptor pass_desc {};
+  wgpu::ComputePassEncoder pass = command_encoder.BeginComputePass(&pass_desc);
+
+  for (uint32_t src = 0; src + 1 < level_views.size(); src += kMaxLevelsPerDispatch) {
+    uint32_t const level_count = std::min<uint32_t>(kMaxLevelsPerDispatch, static_cast<uint32_t>(level_views.size()) - src - 1);
+
+    wgpu::ComputePipeline pipeline;
+    {
+      mbase::LockGuard lock(s_pipelines_mutex);
+      pipeline = GetPipeline(format, level_count);
+    }
+
+    wgpu::BindGroupEntry entries[1 + kMaxLevelsPerDispatch] {};
+    for (uint32_t i = 0; i <= level_count; ++i) {
+      entries[i].binding = i;
+      entries[i].textureView = level_views[src + i];
+    }
+
+    wgpu::BindGroupDescriptor bg_desc {};
+    bg_desc.layout = pipeline.GetBindGroupLayout(0);
+    bg_desc.entryCount = 1 + level_count;
+    bg_desc.entries = entries;
+    wgpu::BindGroup bind_group = wgpu_device.CreateBindGroup(&bg_desc);
+    ++bind_group_count;
+
+    // One invocation per texel of the first level written by this dispatch.
+    uint32_t const dst_width = std::max(1u, base_width >> (src + 1));
+    uint32_t const dst_height = std::max(1u, base_height >> (src + 1));
+
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bind_group);
+    pass.DispatchWorkgroups(
+      (dst_width + kWorkgroupSize - 1) / kWorkgroupSize,
+      (dst_height + kWorkgroupSize - 1) / kWorkgroupSize,
+      1
+    );
+  }
+
+  pass.End();
+  return bind_group_count;
+}
+
+} // namespace
+
+void Initialize(wgpu::Device const& wgpu_device) {
+  // Cache device for lazy pipeline creation.
+  s_device = wgpu_device;
+}
+
+void Shutdown() {
+  {
+    mbase::LockGuard lock(s_pipelines_mutex);
+    s_pipelines.clear();
+  }
+  s_device = nullptr;
+}
+
+wgpu::TextureUsage GetRequiredTextureUsage(wgpu::TextureFormat format) {
+  if (!GetStorageFormatName(format).empty()) {
+    return wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::StorageBinding;
+  }
+  if (IsBlitFormat(format)) {
+    return wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::RenderAttachment;
+  }
+  return wgpu::TextureUsage::None;
+}
+
+uint32_t GenerateMipmaps2D(
+  wgpu::Device const& wgpu_device,
+  wgpu::CommandEncoder& command_encoder,
+  ScratchAllocator& scratch,
+  wgpu::Texture const& texture,
+  wgpu::TextureFormat format,
+  mnexus::TextureSubresourceRange const& subresource_range
+) {
+  if (subresource_range.mip_level_count < 2) {
+    return 0;
+  }
+
+  bool const use_compute = !GetStorageFormatName(format).empty();
+  if (!use_compute && !IsBlitFormat(format)) {
+    MBASE_LOG_ERROR("GenerateMipmaps: unsupported format {}", format);
+    return 0;
+  }
+
+  uint32_t const base_width = std::max(1u, texture.GetWidth() >> subresource_range.base_mip_level);
+  uint32_t const base_height = std::max(1u, texture.GetHeight() >> subresource_range.base_mip_level);
+
+  uint32_t bind_group_count = 0;
+
+  // One single-level view per mip, each used once as a destination and once as the next source. The views are
+  // cached per texture, so regenerating the chain of the same texture creates none.
+  std::vector<wgpu::TextureView> level_views(subresource_range.mip_level_count);
+
+  for (uint32_t layer = subresource_range.base_array_layer;
+       layer < subresource_range.base_array_layer + subresource_range.array_layer_count;
+       ++layer) {
+    for (uint32_t i = 0; i < subresource_range.mip_level_count; ++i) {
+      level_views[i] = texture_view_cache::GetSubresourceView(
+        texture, format, subresource_range.base_mip_level + i, layer
+      );
+    }
+
+    bind_group_count += use_compute
+      ? DownsampleCompute(wgpu_device, command_encoder, format, level_views, base_width, base_height)
+      : blit_texture::BlitMipChain2D(
+        wgpu_device, command_encoder, scratch, texture, format, subresource_range.base_mip_level, level_views
+      );
+  }
+
+  return bind_group_count;
+}
+
+} // namespace mnexus_backend::webgpu::generate_mipmaps
@@ -0,0 +1,36 @@
+#pragma once
+
+// project headers --------------------------------------
+#include "backend-webgpu/include_dawn.h"
+#include "backend-webgpu/scratch_arena.h"
+#include "mnexus/public/types.h"
+
+#include <cstdint>
+
+namespace mnexus_backend::webgpu::generate_mipmaps {
+
+void Initialize(wgpu::Device const& wgpu_device);
+void Shutdown();
+
+/// Extra texture usages a texture of `format` needs so its mip chain can be generated on the GPU:
+/// `TextureBinding | StorageBinding` for formats downsampled in compute, `TextureBinding | RenderAttachment` for
+/// formats downsampled by blitting, `None` if mip generation is unsupported for the format.
+wgpu::TextureUsage GetRequiredTextureUsage(wgpu::TextureFormat format);
+
+/// Generates mip levels `base_mip_level + 1 .. base_mip_level + mip_level_count - 1` of every array layer in
+/// `subresource_range`, each as a 2x2 box filter of the previous level.
+///
+/// Formats with storage texture support are downsampled in compute, up to four levels per dispatch with the
+/// intermediate levels kept in workgroup memory. Other renderable formats fall back to a chained blit over the
+/// even-sized part of each level, which is the same box filter; its per-level params come from `scratch`.
+/// Returns the number of bind groups created.
+uint32_t GenerateMipmaps2D(
+  wgpu::Device const& wgpu_device,
+  wgpu::CommandEncoder& command_encoder,
+  ScratchAllocator& scratch,
+  wgpu::Texture const& texture,
+  wgpu::TextureFormat format,
+  mnexus::TextureSubresourceRange const& subresource_range
+);
+
+} // namespace mnexus_backend::webgpu::generate_mipmaps
@@ -0,0 +1,76 @@
+// TU header --------------------------------------------
+#include "backend-webgpu/push_constants.h"
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+
+#include "mnexus/public/types.h"
+
+namespace mnexus_backend::webgpu::push_constants {
+
+namespace {
+
+wgpu::BindGroupLayout s_bind_group_layout;
+
+} // namespace
+
+void Initialize(wgpu::Device const& wgpu_device) {
+  wgpu::BindGroupLayoutEntry layout_entry {};
+  layout_entry.binding = kBinding;
+  layout_entry.visibility = wgpu::ShaderStage::Vertex | wgpu::ShaderStage::Fragment | wgpu::ShaderStage::Compute;
+  layout_entry.buffer.type = wgpu::BufferBindingType::Uniform;
+  layout_entry.buffer.hasDynamicOffset = true;
+
+  wgpu::BindGroupLayoutDescriptor bgl_desc {};
+  bgl_desc.entryCount = 1;
+  bgl_desc.entries = &layout_entry;
+  s_bind_group_layout = wgpu_device.CreateBindGroupLayout(&bgl_desc);
+  MBASE_ASSERT_MSG(bool(s_bind_group_layout), "Failed to create the push constant bind group layout");
+}
+
+void Shutdown() {
+  s_bind_group_layout = nullptr;
+}
+
+wgpu::BindGroupLayout const& GetBindGroupLayout() {
+  return s_bind_group_layout;
+}
+
+UploadResult Upload(wgpu::Device const& wgpu_device, ScratchAllocator& scratch, void const* data) {
+  ScratchSlice const slice = scratch.AllocateUniform(data, mnexus::kMaxPushConstantSizeInBytes);
+  if (!slice) {
+    return UploadResult {};
+  }
+
+  // The bind group only depends on the page, so it is created once per page and reused with dynamic offsets.
+  wgpu::Buffer const& page_buffer = slice.page->buffer();
+  bool bind_group_created = false;
+  wgpu::BindGroup const& bind_group = slice.page->FindOrCreateBindGroup(
+    ScratchBindGroupKey {
+      .buffers = {},
+      .binding_size = mnexus::kMaxPushConstantSizeInBytes,
+    },
+    [&]() {
+      wgpu::BindGroupEntry entry {};
+      entry.binding = kBinding;
+      entry.buffer = page_buffer;
+      entry.offset = 0;
+      entry.size = mnexus::kMaxPushConstantSizeInBytes;
+
+      wgpu::BindGroupDescriptor bg_desc {};
+      bg_desc.layout = s_bind_group_layout;
+      bg_desc.entryCount = 1;
+      bg_desc.entries = &entry;
+      return wgpu_device.CreateBindGroup(&bg_desc);
+    },
+    bind_group_created
+  );
+
+  return UploadResult {
+    .bind_group = bind_group,
+    .dynamic_offset = static_cast<uint32_t>(slice.offset),
+    .bind_groups_created = bind_group_created ? 1u : 0u,
+  };
+}
+
+} // namespace mnexus_backend::webgpu::push_constants
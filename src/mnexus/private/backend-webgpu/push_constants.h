@@ -0,0 +1,37 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+// project headers --------------------------------------
+#include "backend-webgpu/include_dawn.h"
+#include "backend-webgpu/scratch_arena.h"
+
+namespace mnexus_backend::webgpu::push_constants {
+
+// WebGPU has no push constants. Shader modules get their push constant block rewritten into a uniform buffer at
+// (`kBindGroup`, `kBinding`) (see `shader::LowerPushConstantsToUniform`), and command lists feed that binding from
+// uniform scratch pages with a dynamic offset, one slice per update.
+
+inline constexpr uint32_t kBindGroup = 3;
+inline constexpr uint32_t kBinding = 0;
+
+void Initialize(wgpu::Device const& wgpu_device);
+void Shutdown();
+
+/// Layout of the push constant bind group; shared by every program declaring push constants.
+wgpu::BindGroupLayout const& GetBindGroupLayout();
+
+struct UploadResult final {
+  /// Null on failure.
+  wgpu::BindGroup bind_group;
+  uint32_t dynamic_offset = 0;
+  /// 1 if a bind group had to be created, 0 if one cached on the scratch page was reused.
+  uint32_t bind_groups_created = 0;
+};
+
+/// Copies the `kMaxPushConstantSizeInBytes` bytes at `data` into a uniform slice of `scratch` and returns the bind
+/// group to set at `kBindGroup` with `dynamic_offset`.
+UploadResult Upload(wgpu::Device const& wgpu_device, ScratchAllocator& scratch, void const* data);
+
+} // namespace mnexus_backend::webgpu::push_constants
@@ -0,0 +1,174 @@
+// TU header --------------------------------------------
+#include "backend-webgpu/scratch_arena.h"
+
+// c++ headers ------------------------------------------
+#include <cstring>
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+#include "mbase/public/log.h"
+
+namespace mnexus_backend::webgpu {
+
+namespace {
+
+constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------------------------------
+// ScratchArena
+//
+
+void ScratchArena::Initialize(wgpu::Device wgpu_device) {
+  mbase::LockGuard lock(mutex_);
+  MBASE_ASSERT(!wgpu_device_);
+  wgpu_device_ = std::move(wgpu_device);
+}
+
+void ScratchArena::Shutdown() {
+  mbase::LockGuard lock(mutex_);
+  retired_pages_.clear();
+  free_pages_.clear();
+  pages_.clear();
+  wgpu_device_ = nullptr;
+}
+
+ScratchPage* ScratchArena::AcquirePage(ScratchPageKind kind, uint64_t min_size) {
+  mbase::LockGuard lock(mutex_);
+
+  // Best fit among the free pages of the requested kind.
+  auto best_it = free_pages_.end();
+  for (auto it = free_pages_.begin(); it != free_pages_.end(); ++it) {
+    ScratchPage* page = *it;
+    if (page->kind() != kind || page->size() < min_size) {
+      continue;
+    }
+    if (best_it == free_pages_.end() || page->size() < (*best_it)->size()) {
+      best_it = it;
+    }
+  }
+
+  if (best_it != free_pages_.end()) {
+    ScratchPage* page = *best_it;
+    *best_it = free_pages_.back();
+    free_pages_.pop_back();
+    return page;
+  }
+
+  uint64_t const base_size = (kind == ScratchPageKind::kUniform) ? kUniformPageSize : kStoragePageSize;
+  uint64_t const page_size = std::max(base_size, std::bit_ceil(min_size));
+
+  wgpu::BufferDescriptor desc {};
+  desc.label = (kind == ScratchPageKind::kUniform) ? "ScratchPage [uniform]" : "ScratchPage [storage]";
+  desc.size = page_size;
+  desc.usage = (kind == ScratchPageKind::kUniform)
+    ? wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst
+    : wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc;
+  wgpu::Buffer buffer = wgpu_device_.CreateBuffer(&desc);
+  if (!buffer) {
+    MBASE_LOG_ERROR("Failed to create a {} byte scratch page", page_size);
+    return nullptr;
+  }
+
+  return pages_.emplace_back(std::make_unique<ScratchPage>(kind, std::move(buffer), page_size)).get();
+}
+
+void ScratchArena::ReleasePages(std::vector<ScratchPage*> const& pages) {
+  mbase::LockGuard lock(mutex_);
+  for (ScratchPage* page : pages) {
+    this->FreePage(page);
+  }
+}
+
+void ScratchArena::RetirePages(std::vector<ScratchPage*> const& pages, uint64_t timeline_value) {
+  mbase::LockGuard lock(mutex_);
+  MBASE_ASSERT(retired_pages_.empty() || retired_pages_.back().timeline_value <= timeline_value);
+  for (ScratchPage* page : pages) {
+    retired_pages_.push_back(RetiredPage { .page = page, .timeline_value = timeline_value });
+  }
+}
+
+void ScratchArena::Reclaim(uint64_t completed_value) {
+  mbase::LockGuard lock(mutex_);
+  while (!retired_pages_.empty() && retired_pages_.front().timeline_value <= completed_value) {
+    this->FreePage(retired_pages_.front().page);
+    retired_pages_.pop_front();
+  }
+}
+
+uint32_t ScratchArena::GetPageCount() const {
+  mbase::LockGuard lock(mutex_);
+  return static_cast<uint32_t>(pages_.size());
+}
+
+void ScratchArena::FreePage(ScratchPage* page) {
+  page->Reset();
+  free_pages_.push_back(page);
+}
+
+// ----------------------------------------------------------------------------------------------------
+// ScratchAllocator
+//
+
+ScratchAllocator::~ScratchAllocator() {
+  if (!pages_.empty()) {
+    arena_->ReleasePages(pages_);
+  }
+}
+
+ScratchSlice ScratchAllocator::AllocateUniform(void const* data, uint32_t size_in_bytes) {
+  ScratchSlice const slice = this->Allocate(ScratchPageKind::kUniform, current_uniform_page_, size_in_bytes);
+  if (slice) {
+    std::vector<uint8_t>& shadow = slice.page->uniform_shadow_;
+    shadow.resize(slice.page->used());
+    std::memcpy(shadow.data() + slice.offset, data, size_in_bytes);
+  }
+  return slice;
+}
+
+ScratchSlice ScratchAllocator::AllocateStorage(uint64_t size_in_bytes) {
+  return this->Allocate(ScratchPageKind::kStorage, current_storage_page_, size_in_bytes);
+}
+
+void ScratchAllocator::FlushUniforms(wgpu::Queue const& wgpu_queue) {
+  for (ScratchPage* page : pages_) {
+    if (page->kind() == ScratchPageKind::kUniform && !page->uniform_shadow_.empty()) {
+      wgpu_queue.WriteBuffer(page->buffer(), 0, page->uniform_shadow_.data(), page->uniform_shadow_.size());
+    }
+  }
+}
+
+std::vector<ScratchPage*> ScratchAllocator::TakePages() {
+  current_uniform_page_ = nullptr;
+  current_storage_page_ = nullptr;
+  return std::exchange(pages_, {});
+}
+
+ScratchSlice ScratchAllocator::Allocate(ScratchPageKind kind, ScratchPage*& current_page, uint64_t size_in_bytes) {
+  uint64_t const aligned_size = AlignUp(std::max<uint64_t>(size_in_bytes, 1), ScratchArena::kAlignment);
+
+  if (current_page == nullptr || current_page->used() + aligned_size > current_page->size()) {
+    current_page = arena_->AcquirePage(kind, aligned_size);
+    if (current_page == nullptr) {
+      return ScratchSlice {};
+    }
+    pages_.push_back(current_page);
+  }
+
+  ScratchSlice const slice {
+    .page = current_page,
+    .offset = current_page->used_,
+    .size = size_in_bytes,
+  };
+  current_page->used_ += aligned_size;
+  return slice;
+}
+
+} // namespace mnexus_backend::webgpu
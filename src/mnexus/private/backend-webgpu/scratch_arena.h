@@ -0,0 +1,230 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/tsa.h"
+
+// project headers --------------------------------------
+#include "backend-webgpu/include_dawn.h"
+
+namespace mnexus_backend::webgpu {
+
+// ----------------------------------------------------------------------------------------------------
+// Scratch memory for internal passes
+//
+// Internal passes (row repack, blits) need small uniform blocks and transient storage every time they are recorded.
+// Instead of creating a buffer per pass, they carve (buffer, offset) slices out of device-owned pages:
+//
+// - A command list leases whole pages from the `ScratchArena` through its `ScratchAllocator` and bump-allocates from
+//   them without locking.
+// - When the command list is submitted, the pages are retired with the submission's timeline value and go back to
+//   the free list once the queue has completed that value. Pages of a discarded command list are released at once.
+// - Uniform contents are staged on the CPU and uploaded with one `Queue::WriteBuffer` per page right before the
+//   command buffer is submitted.
+//
+// Uniform and storage slices live in separate pages: WebGPU tracks usage per buffer, so a buffer cannot be bound as
+// uniform and as writable storage within the same dispatch.
+//
+
+enum class ScratchPageKind : uint8_t {
+  /// `Uniform | CopyDst`; written from the CPU at submission.
+  kUniform,
+  /// `Storage | CopySrc`; written by the GPU only.
+  kStorage,
+};
+
+/// Identifies a bind group cached on a scratch page by the other buffers it references.
+///
+/// `buffers` **MUST** only name scratch page buffers. They live as long as the arena, so a key can never match a
+/// different buffer that happens to reuse a released handle.
+struct ScratchBindGroupKey final {
+  std::array<WGPUBuffer, 2> buffers {};
+  uint64_t binding_size = 0;
+
+  bool operator==(ScratchBindGroupKey const&) const = default;
+};
+
+class ScratchPage final {
+public:
+  /// Bind groups retained per page; the oldest entry is evicted beyond this.
+  static constexpr uint32_t kMaxCachedBindGroups = 16;
+
+  ScratchPage(ScratchPageKind kind, wgpu::Buffer buffer, uint64_t size) :
+    kind_(kind),
+    buffer_(std::move(buffer)),
+    size_(size)
+  {
+  }
+  ~ScratchPage() = default;
+  MBASE_DISALLOW_COPY_MOVE(ScratchPage);
+
+  [[nodiscard]] ScratchPageKind kind() const { return kind_; }
+  [[nodiscard]] wgpu::Buffer const& buffer() const { return buffer_; }
+  [[nodiscard]] uint64_t size() const { return size_; }
+  [[nodiscard]] uint64_t used() const { return used_; }
+
+  /// Returns the bind group cached under `key`, creating it with `create` on a miss.
+  ///
+  /// Bind groups survive the page being recycled, so internal passes that bind a page with dynamic offsets create
+  /// each (page, buffers, binding size) combination once. The bind group **MUST** only reference scratch pages:
+  /// a cached group would keep a caller's buffer alive indefinitely, and a streaming caller never hits anyway.
+  ///
+  /// > **Note:** Not thread-safe; a page is only accessed by the command list currently leasing it.
+  template<typename CreateFunc>
+  wgpu::BindGroup const& FindOrCreateBindGroup(
+    ScratchBindGroupKey const& key,
+    CreateFunc&& create,
+    bool& out_created
+  ) {
+    for (CachedBindGroup const& entry : bind_groups_) {
+      if (entry.key == key) {
+        out_created = false;
+        return entry.bind_group;
+      }
+    }
+
+    if (bind_groups_.size() >= kMaxCachedBindGroups) {
+      bind_groups_.erase(bind_groups_.begin());
+    }
+
+    out_created = true;
+    return bind_groups_.emplace_back(
+      CachedBindGroup {
+        .key = key,
+        .bind_group = create(),
+      }
+    ).bind_group;
+  }
+
+private:
+  friend class ScratchAllocator;
+  friend class ScratchArena;
+
+  struct CachedBindGroup {
+    ScratchBindGroupKey key;
+    wgpu::BindGroup bind_group;
+  };
+
+  void Reset() {
+    used_ = 0;
+    uniform_shadow_.clear();
+  }
+
+  ScratchPageKind kind_;
+  wgpu::Buffer buffer_;
+  uint64_t size_ = 0;
+  uint64_t used_ = 0;
+
+  /// CPU copy of `[0, used_)` of a uniform page, uploaded at submission.
+  std::vector<uint8_t> uniform_shadow_;
+
+  std::vector<CachedBindGroup> bind_groups_;
+};
+
+/// A slice of a scratch page. `page` is null if the allocation failed.
+struct ScratchSlice final {
+  ScratchPage* page = nullptr;
+  uint64_t offset = 0;
+  uint64_t size = 0;
+
+  [[nodiscard]] explicit operator bool() const { return page != nullptr; }
+};
+
+// ----------------------------------------------------------------------------------------------------
+// ScratchArena
+//
+// Device-owned page pool. Thread-safe.
+//
+
+class ScratchArena final {
+public:
+  /// Slice offset alignment; satisfies the default `minUniformBufferOffsetAlignment` and
+  /// `minStorageBufferOffsetAlignment` limits, and `CopyBufferToTexture`'s offset requirement.
+  static constexpr uint64_t kAlignment = 256;
+  static constexpr uint64_t kUniformPageSize = 64 * 1024;
+  /// Minimum size of storage pages; larger requests get a page rounded up to the next power of two.
+  static constexpr uint64_t kStoragePageSize = 4 * 1024 * 1024;
+
+  ScratchArena() = default;
+  ~ScratchArena() = default;
+  MBASE_DISALLOW_COPY_MOVE(ScratchArena);
+
+  void Initialize(wgpu::Device wgpu_device);
+  void Shutdown();
+
+  /// Returns a free page of `kind` with at least `min_size` bytes, creating one only if none is free.
+  ScratchPage* AcquirePage(ScratchPageKind kind, uint64_t min_size);
+
+  /// Returns pages that were never submitted to the free list.
+  void ReleasePages(std::vector<ScratchPage*> const& pages);
+
+  /// Retires pages used by the submission with `timeline_value`. Values **MUST** be passed in submission order.
+  void RetirePages(std::vector<ScratchPage*> const& pages, uint64_t timeline_value);
+
+  /// Recycles the retired pages whose submission has completed.
+  void Reclaim(uint64_t completed_value);
+
+  /// Number of pages created so far (in use, retired or free).
+  [[nodiscard]] uint32_t GetPageCount() const;
+
+private:
+  struct RetiredPage {
+    ScratchPage* page;
+    uint64_t timeline_value;
+  };
+
+  void FreePage(ScratchPage* page) MBASE_REQUIRES(mutex_);
+
+  mutable mbase::Lockable<std::mutex> mutex_;
+  wgpu::Device wgpu_device_ MBASE_GUARDED_BY(mutex_);
+  std::vector<std::unique_ptr<ScratchPage>> pages_ MBASE_GUARDED_BY(mutex_);
+  std::vector<ScratchPage*> free_pages_ MBASE_GUARDED_BY(mutex_);
+  std::deque<RetiredPage> retired_pages_ MBASE_GUARDED_BY(mutex_);
+};
+
+// ----------------------------------------------------------------------------------------------------
+// ScratchAllocator
+//
+// Per-command-list view of the arena. Thread-affine like the command list itself.
+//
+
+class ScratchAllocator final {
+public:
+  explicit ScratchAllocator(ScratchArena* arena) : arena_(arena) {}
+  /// Releases any pages that were not handed over with `TakePages`, i.e. of a command list that was discarded
+  /// without being submitted.
+  ~ScratchAllocator();
+  MBASE_DISALLOW_COPY_MOVE(ScratchAllocator);
+
+  /// Copies `size_in_bytes` of `data` into a uniform slice. The contents reach the GPU in `FlushUniforms`.
+  ScratchSlice AllocateUniform(void const* data, uint32_t size_in_bytes);
+
+  /// Reserves a storage slice of `size_in_bytes` for data produced and consumed on the GPU.
+  ScratchSlice AllocateStorage(uint64_t size_in_bytes);
+
+  /// Uploads the staged uniform contents of all leased pages. **MUST** be called before the command buffer
+  /// referencing them is submitted.
+  void FlushUniforms(wgpu::Queue const& wgpu_queue);
+
+  /// Hands the leased pages over for retirement.
+  [[nodiscard]] std::vector<ScratchPage*> TakePages();
+
+private:
+  ScratchSlice Allocate(ScratchPageKind kind, ScratchPage*& current_page, uint64_t size_in_bytes);
+
+  ScratchArena* arena_ = nullptr;
+  ScratchPage* current_uniform_page_ = nullptr;
+  ScratchPage* current_storage_page_ = nullptr;
+  std::vector<ScratchPage*> pages_;
+};
+
+} // namespace mnexus_backend::webgpu
@@ -2,9 +2,14 @@
 #include "backend-webgpu/shader_module.h"
 
 // c++ headers ------------------------------------------
+#include <optional>
 #include <string>
+#include <vector>
 
 // project headers --------------------------------------
+#include "backend-webgpu/push_constants.h"
+
+#include "shader/spirv_push_constants.h"
 #include "shader/wgsl.h"
 
 // public project headers -------------------------------
@@ -25,13 +30,25 @@ wgpu::ShaderModule CreateWgpuShaderModule(
 
   wgpu::ShaderModuleDescriptor wgpu_shader_module_desc {};
 
+  // WebGPU has no push constants; turn the block into the uniform buffer `push_constants` binds.
+  uint32_t const* spirv = reinterpret_cast<uint32_t const*>(shader_module_desc.code_ptr);
+  uint32_t spirv_word_count = shader_module_desc.code_size_in_bytes / sizeof(uint32_t);
+
+  std::optional<std::vector<uint32_t>> lowered_spirv = shader::LowerPushConstantsToUniform(
+    spirv, spirv_word_count, push_constants::kBindGroup, push_constants::kBinding
+  );
+  if (lowered_spirv.has_value()) {
+    spirv = lowered_spirv->data();
+    spirv_word_count = static_cast<uint32_t>(lowered_spirv->size());
+  }
+
 #if MNEXUS_INTERNAL_USE_DAWN
   // Native with Dawn: Can pass SPIR-V directly to Dawn
   wgpu::ShaderSourceSPIRV shader_source_spirv {};
 
   if (shader_module_desc.source_language == mnexus::ShaderSourceLanguage::kSpirV) {
-    shader_source_spirv.code = reinterpret_cast<uint32_t const*>(shader_module_desc.code_ptr);
-    shader_source_spirv.codeSize = shader_module_desc.code_size_in_bytes / sizeof(uint32_t);
+    shader_source_spirv.code = spirv;
+    shader_source_spirv.codeSize = spirv_word_count;
 
     wgpu_shader_module_desc.nextInChain = &shader_source_spirv;
   }
@@ -46,8 +63,6 @@ wgpu::ShaderModule CreateWgpuShaderModule(
 
 # if MNEXUS_INTERNAL_USE_TINT
   // Convert SPIR-V to WGSL using Tint
-  auto const* spirv = reinterpret_cast<uint32_t const*>(shader_module_desc.code_ptr);
-  auto spirv_word_count = shader_module_desc.code_size_in_bytes / sizeof(uint32_t);
   auto wgsl = shader::ConvertSpirvToWgsl(spirv, spirv_word_count);
   MBASE_ASSERT_MSG(wgsl.has_value(), "Failed to convert SPIR-V to WGSL");
   wgsl_storage = std::move(*wgsl);
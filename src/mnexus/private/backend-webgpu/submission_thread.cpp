@@ -0,0 +1,102 @@
+// TU header --------------------------------------------
+#include "backend-webgpu/submission_thread.h"
+
+// c++ headers ------------------------------------------
+#include <algorithm>
+#include <utility>
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+#include "mbase/public/log.h"
+
+namespace mnexus_backend::webgpu {
+
+namespace {
+
+template<typename T>
+bool LaterThan(T const& lhs, T const& rhs) {
+  return lhs.value > rhs.value;
+}
+
+} // namespace
+
+SubmissionThread::~SubmissionThread() {
+  this->Stop();
+}
+
+void SubmissionThread::Start(uint64_t first_value) {
+  MBASE_ASSERT(!thread_.joinable());
+
+  next_value_ = first_value;
+  executed_value_.store(first_value - 1, std::memory_order_relaxed);
+  stop_requested_.store(false, std::memory_order_relaxed);
+  thread_ = std::thread([this]() { this->ThreadMain(); });
+}
+
+void SubmissionThread::Stop() {
+  if (!thread_.joinable()) {
+    return;
+  }
+
+  stop_requested_.store(true, std::memory_order_release);
+  signal_.fetch_add(1, std::memory_order_release);
+  signal_.notify_one();
+
+  thread_.join();
+}
+
+void SubmissionThread::Enqueue(uint64_t value, Work work) {
+  queue_.Push(Item { .value = value, .work = std::move(work) });
+
+  signal_.fetch_add(1, std::memory_order_release);
+  signal_.notify_one();
+}
+
+void SubmissionThread::WaitExecuted(uint64_t value) {
+  uint64_t executed = executed_value_.load(std::memory_order_acquire);
+  while (executed < value) {
+    executed_value_.wait(executed, std::memory_order_acquire);
+    executed = executed_value_.load(std::memory_order_acquire);
+  }
+}
+
+void SubmissionThread::ThreadMain() {
+  for (;;) {
+    // Observed before draining: a push that lands afterwards changes `signal_` and cancels the wait below.
+    uint64_t const observed_signal = signal_.load(std::memory_order_acquire);
+    bool const stopping = stop_requested_.load(std::memory_order_acquire);
+
+    while (std::optional<Item> item = queue_.TryPop()) {
+      reorder_.push_back(std::move(*item));
+      std::push_heap(reorder_.begin(), reorder_.end(), LaterThan<Item>);
+    }
+
+    while (!reorder_.empty() && reorder_.front().value == next_value_) {
+      std::pop_heap(reorder_.begin(), reorder_.end(), LaterThan<Item>);
+      Item item = std::move(reorder_.back());
+      reorder_.pop_back();
+
+      item.work();
+
+      executed_value_.store(next_value_, std::memory_order_release);
+      executed_value_.notify_all();
+      ++next_value_;
+    }
+
+    if (stopping) {
+      // Producers are gone, so everything they pushed was drained above.
+      if (!reorder_.empty()) {
+        MBASE_LOG_ERROR(
+          "Submission thread stopping with {} operation(s) waiting for timeline value {}",
+          reorder_.size(), next_value_
+        );
+        reorder_.clear();
+      }
+      break;
+    }
+
+    signal_.wait(observed_signal, std::memory_order_acquire);
+  }
+}
+
+} // namespace mnexus_backend::webgpu
@@ -0,0 +1,79 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+
+// project headers --------------------------------------
+#include "sync/mpsc_queue.h"
+
+namespace mnexus_backend::webgpu {
+
+// ----------------------------------------------------------------------------------------------------
+// SubmissionThread
+//
+// Opt-in (`NexusDesc::submission_thread`) executor for queue operations. Producers reserve a timeline value with a
+// single atomic increment and push the operation into a lock-free `MpscQueue`; one thread drains it and runs the
+// operations in timeline order, so recording threads no longer serialize on the device's queue lock.
+//
+// Reservation and push are not atomic together, so operations may arrive out of order. They are parked in a small
+// min-heap until every preceding value has run. Every reserved value **MUST** therefore be enqueued exactly once.
+//
+
+class SubmissionThread final {
+public:
+  using Work = std::function<void()>;
+
+  SubmissionThread() = default;
+  ~SubmissionThread();
+  MBASE_DISALLOW_COPY_MOVE(SubmissionThread);
+
+  /// Starts the thread. `first_value` is the next timeline value that will be enqueued.
+  void Start(uint64_t first_value);
+
+  /// Runs all enqueued work and joins the thread. Producers **MUST** have returned from `Enqueue`. Idempotent.
+  void Stop();
+
+  /// Whether `Start` has been called and `Stop` has not. Only changes while no producer is active.
+  [[nodiscard]] bool IsRunning() const { return thread_.joinable(); }
+
+  /// Lock-free. `work` runs on the submission thread once all values below `value` have run.
+  void Enqueue(uint64_t value, Work work);
+
+  /// Blocks until the operations up to `value` have run (not completed on the GPU).
+  void WaitExecuted(uint64_t value);
+
+  /// Returns the highest value whose operation has run.
+  [[nodiscard]] uint64_t GetExecutedValue() const { return executed_value_.load(std::memory_order_acquire); }
+
+private:
+  struct Item {
+    uint64_t value;
+    Work work;
+  };
+
+  void ThreadMain();
+
+  MpscQueue<Item> queue_;
+
+  /// Bumped after every push; the thread sleeps on it with `std::atomic::wait`.
+  std::atomic<uint64_t> signal_ = 0;
+  std::atomic<uint64_t> executed_value_ = 0;
+  std::atomic<bool> stop_requested_ = false;
+
+  // Submission thread only.
+  uint64_t next_value_ = 0;
+  /// Min-heap on `value` of the items that arrived ahead of `next_value_`.
+  std::vector<Item> reorder_;
+
+  std::thread thread_;
+};
+
+} // namespace mnexus_backend::webgpu
@@ -0,0 +1,72 @@
+// TU header --------------------------------------------
+#include "backend-webgpu/texture_view_cache.h"
+
+// c++ headers ------------------------------------------
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mbase/public/tsa.h"
+
+// project headers --------------------------------------
+#include "backend-webgpu/backend-webgpu-texture.h"
+
+namespace mnexus_backend::webgpu::texture_view_cache {
+
+namespace {
+
+struct CachedView {
+  wgpu::TextureFormat format;
+  uint32_t mip_level;
+  uint32_t array_layer;
+  wgpu::TextureView view;
+};
+
+mbase::Lockable<std::mutex> s_views_mutex;
+std::unordered_map<WGPUTexture, std::vector<CachedView>> s_views MBASE_GUARDED_BY(s_views_mutex);
+
+} // namespace
+
+void Shutdown() {
+  mbase::LockGuard lock(s_views_mutex);
+  s_views.clear();
+}
+
+wgpu::TextureView GetSubresourceView(
+  wgpu::Texture const& texture,
+  wgpu::TextureFormat format,
+  uint32_t mip_level,
+  uint32_t array_layer
+) {
+  mbase::LockGuard lock(s_views_mutex);
+
+  std::vector<CachedView>& views = s_views[texture.Get()];
+  for (CachedView const& entry : views) {
+    if (entry.format == format && entry.mip_level == mip_level && entry.array_layer == array_layer) {
+      return entry.view;
+    }
+  }
+
+  wgpu::TextureViewDescriptor view_desc = MakeWgpuTextureViewDesc(
+    format,
+    wgpu::TextureViewDimension::e2D,
+    mnexus::TextureSubresourceRange::SingleSubresourceColor(mip_level, array_layer),
+    wgpu::TextureAspect::All
+  );
+  return views.emplace_back(
+    CachedView {
+      .format = format,
+      .mip_level = mip_level,
+      .array_layer = array_layer,
+      .view = texture.CreateView(&view_desc),
+    }
+  ).view;
+}
+
+void ForgetTexture(WGPUTexture texture) {
+  mbase::LockGuard lock(s_views_mutex);
+  s_views.erase(texture);
+}
+
+} // namespace mnexus_backend::webgpu::texture_view_cache
@@ -0,0 +1,28 @@
+#pragma once
+
+// project headers --------------------------------------
+#include "backend-webgpu/include_dawn.h"
+
+#include <cstdint>
+
+namespace mnexus_backend::webgpu::texture_view_cache {
+
+// Internal passes (blits, mip generation) bind single subresources of caller textures. The views are created once
+// per (texture, format, mip level, array layer) and kept until the texture is forgotten, so recording such a pass
+// in the steady state creates no views. Thread-safe.
+
+void Shutdown();
+
+/// Returns the cached single-level, single-layer 2D view of `texture`, creating it on a miss.
+wgpu::TextureView GetSubresourceView(
+  wgpu::Texture const& texture,
+  wgpu::TextureFormat format,
+  uint32_t mip_level,
+  uint32_t array_layer
+);
+
+/// Drops the views of `texture`. **MUST** be called before the texture is released, so that a later texture
+/// reusing the same object address never hits a stale entry.
+void ForgetTexture(WGPUTexture texture);
+
+} // namespace mnexus_backend::webgpu::texture_view_cache
@@ -109,6 +109,17 @@ void BindGroupStateTracker::MarkGroupClean(uint32_t group) {
   groups_[group].dirty = false;
 }
 
+void BindGroupStateTracker::MarkGroupDirty(uint32_t group) {
+  MBASE_ASSERT(group < kMaxGroups);
+  groups_[group].dirty = !groups_[group].entries.empty();
+}
+
+void BindGroupStateTracker::MarkAllGroupsDirty() {
+  for (uint32_t i = 0; i < kMaxGroups; ++i) {
+    groups_[i].dirty = !groups_[i].entries.empty();
+  }
+}
+
 void BindGroupStateTracker::Reset() {
   for (uint32_t i = 0; i < kMaxGroups; ++i) {
     groups_[i].entries.clear();
@@ -61,6 +61,10 @@ public:
   [[nodiscard]] bool IsGroupDirty(uint32_t group) const;
   [[nodiscard]] mbase::ArrayProxy<BoundEntry const> GetGroupEntries(uint32_t group) const;
   void MarkGroupClean(uint32_t group);
+  /// Marks `group` dirty if it has entries, so that it is re-applied at the next resolve.
+  void MarkGroupDirty(uint32_t group);
+  /// Marks every group that has entries dirty, so that it is re-applied at the next resolve.
+  void MarkAllGroupsDirty();
   void Reset();
 
 private:
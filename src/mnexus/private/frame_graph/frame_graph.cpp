@@ -0,0 +1,364 @@
+// TU header --------------------------------------------
+#include "mnexus/public/frame_graph.h"
+
+// c++ headers ------------------------------------------
+#include <cstring>
+
+#include <algorithm>
+#include <optional>
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+#include "mbase/public/log.h"
+
+// project headers --------------------------------------
+#include "profiling/memory_tracker.h"
+
+namespace mnexus {
+
+namespace {
+
+bool IsSameTextureDesc(TextureDesc const& lhs, TextureDesc const& rhs) {
+  // `TextureDesc` is ABI-equivalent to `MnTextureDesc`, which is all 32-bit fields and has no padding.
+  return std::memcmp(&lhs, &rhs, sizeof(TextureDesc)) == 0;
+}
+
+bool IsSameTextureDescs(std::vector<TextureDesc> const& lhs, std::vector<TextureDesc> const& rhs) {
+  return std::ranges::equal(lhs, rhs, IsSameTextureDesc);
+}
+
+bool IsReadAccess(TextureAccess access) {
+  return access == TextureAccess::kSampled || access == TextureAccess::kTransferSrc;
+}
+
+TextureAspectFlags GetAspectMask(Format format) {
+  switch (format) {
+  case Format::kD16_UNORM:
+  case Format::kD32_SFLOAT:
+    return TextureAspectFlagBits::kDepth;
+  case Format::kD16_UNORM_S8_UINT:
+  case Format::kD24_UNORM_S8_UINT:
+  case Format::kD32_SFLOAT_S8_UINT:
+    return TextureAspectFlagBits::kDepth | TextureAspectFlagBits::kStencil;
+  default:
+    return TextureAspectFlagBits::kColor;
+  }
+}
+
+TextureSubresourceRange MakeWholeRange(TextureDesc const& desc) {
+  return TextureSubresourceRange {
+    .aspect_mask = GetAspectMask(desc.format),
+    .base_mip_level = 0,
+    .mip_level_count = desc.mip_level_count,
+    .base_array_layer = 0,
+    .array_layer_count = desc.array_layer_count,
+  };
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------------------------------
+// FrameGraph
+//
+
+FrameGraph::FrameGraph(IDevice& device) :
+  device_(device),
+  memory_aliasing_(device.GetAdapterCapability().texture_memory_aliasing != MnBoolFalse)
+{
+}
+
+FrameGraph::~FrameGraph() {
+  for (PhysicalGroup const& group : physical_groups_) {
+    this->DestroyPhysicalGroup(group);
+  }
+}
+
+FrameGraphTextureId FrameGraph::CreateTexture(std::string_view name, TextureDesc const& desc) {
+  textures_.push_back(Texture {
+    .name = std::string(name),
+    .desc = desc,
+    .transient = true,
+    .size_in_bytes = mnexus_backend::profiling::EstimateTextureSizeInBytes(desc),
+  });
+  return FrameGraphTextureId { .index = static_cast<uint32_t>(textures_.size() - 1) };
+}
+
+FrameGraphTextureId FrameGraph::ImportTexture(std::string_view name, TextureHandle texture_handle) {
+  TextureDesc desc;
+  device_.GetTextureDesc(texture_handle, desc);
+
+  textures_.push_back(Texture {
+    .name = std::string(name),
+    .desc = desc,
+    .transient = false,
+    .handle = texture_handle,
+  });
+  return FrameGraphTextureId { .index = static_cast<uint32_t>(textures_.size() - 1) };
+}
+
+void FrameGraph::AddPass(
+  std::string_view name,
+  container::ArrayProxy<FrameGraphTextureUse const> uses,
+  PassCallback callback
+) {
+  for (uint32_t i = 0; i < uses.size(); ++i) {
+    MBASE_ASSERT_MSG(uses[i].texture.IsValid() && uses[i].texture.index < textures_.size(),
+      "FrameGraph::AddPass: unknown texture");
+    MBASE_ASSERT_MSG(uses[i].access != TextureAccess::kDiscarded, "FrameGraph::AddPass: kDiscarded is not an access");
+    for (uint32_t j = 0; j < i; ++j) {
+      MBASE_ASSERT_MSG(uses[i].texture.index != uses[j].texture.index, "FrameGraph::AddPass: texture used twice");
+    }
+  }
+
+  passes_.push_back(Pass {
+    .name = std::string(name),
+    .uses = std::vector<FrameGraphTextureUse>(uses.begin(), uses.end()),
+    .callback = std::move(callback),
+  });
+  compiled_ = false;
+}
+
+void FrameGraph::Compile() {
+  // Lifetimes: from the first to the last pass that uses the texture.
+  for (Texture& texture : textures_) {
+    texture.first_pass = kNoPass;
+    texture.last_pass = kNoPass;
+  }
+  for (uint32_t pass_index = 0; pass_index < passes_.size(); ++pass_index) {
+    for (FrameGraphTextureUse const& use : passes_[pass_index].uses) {
+      Texture& texture = textures_[use.texture.index];
+      if (texture.first_pass == kNoPass) {
+        texture.first_pass = pass_index;
+        if (texture.transient && IsReadAccess(use.access)) {
+          MBASE_LOG_WARN("FrameGraph: pass '{}' reads transient texture '{}' before any pass writes it",
+            passes_[pass_index].name, texture.name);
+        }
+      }
+      texture.last_pass = pass_index;
+    }
+  }
+
+  std::vector<uint32_t> transient_order;
+  uint32_t transient_texture_count = 0;
+  for (uint32_t i = 0; i < textures_.size(); ++i) {
+    if (!textures_[i].transient) {
+      continue;
+    }
+    ++transient_texture_count;
+    if (textures_[i].first_pass == kNoPass) {
+      MBASE_LOG_WARN("FrameGraph: transient texture '{}' is not used by any pass", textures_[i].name);
+      continue;
+    }
+    transient_order.push_back(i);
+  }
+  std::ranges::stable_sort(transient_order, {}, [this](uint32_t i) { return textures_[i].first_pass; });
+
+  // Greedy interval assignment: a transient joins a slot whose current occupant is dead by its first pass.
+  struct Slot final {
+    std::vector<uint32_t> members;
+    uint32_t last_pass = 0;
+    uint64_t size_in_bytes = 0;
+  };
+  std::vector<Slot> slots;
+
+  for (uint32_t texture_index : transient_order) {
+    Texture const& texture = textures_[texture_index];
+
+    Slot* best = nullptr;
+    for (Slot& slot : slots) {
+      if (slot.last_pass >= texture.first_pass) {
+        continue;
+      }
+      if (!memory_aliasing_) {
+        // Without memory aliasing, only a texture of the same description can be shared.
+        if (IsSameTextureDesc(textures_[slot.members.front()].desc, texture.desc)) {
+          best = &slot;
+          break;
+        }
+        continue;
+      }
+      // Prefer the smallest slot that fits, otherwise the largest one, so that slots grow as little as possible.
+      if (best == nullptr) {
+        best = &slot;
+        continue;
+      }
+      bool const fits = slot.size_in_bytes >= texture.size_in_bytes;
+      bool const best_fits = best->size_in_bytes >= texture.size_in_bytes;
+      if (fits ? (!best_fits || slot.size_in_bytes < best->size_in_bytes)
+               : (!best_fits && slot.size_in_bytes > best->size_in_bytes)) {
+        best = &slot;
+      }
+    }
+
+    if (best == nullptr) {
+      best = &slots.emplace_back();
+    }
+    best->members.push_back(texture_index);
+    best->last_pass = texture.last_pass;
+    best->size_in_bytes = std::max(best->size_in_bytes, texture.size_in_bytes);
+  }
+
+  // Back each slot with backend textures, reusing those of the previous compile where the slot needs the same ones.
+  std::vector<PhysicalGroup> previous_groups = std::move(physical_groups_);
+  physical_groups_.clear();
+
+  for (Slot const& slot : slots) {
+    PhysicalGroup group;
+    group.aliased = memory_aliasing_ && slot.members.size() > 1;
+    if (group.aliased) {
+      for (uint32_t texture_index : slot.members) {
+        group.descs.push_back(textures_[texture_index].desc);
+      }
+    } else {
+      group.descs.push_back(textures_[slot.members.front()].desc);
+    }
+
+    auto it = std::ranges::find_if(previous_groups, [&group](PhysicalGroup const& previous) {
+      return previous.aliased == group.aliased && IsSameTextureDescs(previous.descs, group.descs);
+    });
+    if (it != previous_groups.end()) {
+      group = std::move(*it);
+      previous_groups.erase(it);
+    } else {
+      this->CreatePhysicalGroup(group);
+    }
+
+    for (uint32_t i = 0; i < slot.members.size(); ++i) {
+      textures_[slot.members[i]].handle = group.textures.size() == 1 ? group.textures.front() : group.textures[i];
+    }
+    physical_groups_.push_back(std::move(group));
+  }
+
+  for (PhysicalGroup const& group : previous_groups) {
+    this->DestroyPhysicalGroup(group);
+  }
+
+  stats_ = FrameGraphStats {
+    .pass_count = static_cast<uint32_t>(passes_.size()),
+    .transient_texture_count = transient_texture_count,
+  };
+  for (uint32_t texture_index : transient_order) {
+    stats_.unaliased_size_in_bytes += textures_[texture_index].size_in_bytes;
+  }
+  for (PhysicalGroup const& group : physical_groups_) {
+    stats_.physical_texture_count += static_cast<uint32_t>(group.textures.size());
+    stats_.aliased_size_in_bytes += group.size_in_bytes;
+  }
+
+  compiled_ = true;
+}
+
+void FrameGraph::Execute(ICommandList& command_list) {
+  MBASE_ASSERT_MSG(compiled_, "FrameGraph::Execute requires Compile after the last AddPass");
+
+  stats_.transition_batch_count = 0;
+  stats_.transition_count = 0;
+
+  std::vector<std::optional<TextureAccess>> current_access(textures_.size());
+  std::vector<TextureTransitionDesc> transitions;
+
+  auto flush_transitions = [&] {
+    if (transitions.empty()) {
+      return;
+    }
+    command_list.TransitionTextures(transitions);
+    stats_.transition_batch_count += 1;
+    stats_.transition_count += static_cast<uint32_t>(transitions.size());
+    transitions.clear();
+  };
+
+  // Transients whose lifetime ended with the previous pass; their memory may now be reused.
+  auto release_transients_ending_at = [&](uint32_t pass_index) {
+    for (Texture const& texture : textures_) {
+      if (texture.transient && texture.last_pass == pass_index) {
+        transitions.push_back(TextureTransitionDesc {
+          .texture = texture.handle,
+          .subresource_range = MakeWholeRange(texture.desc),
+          .access = TextureAccess::kDiscarded,
+        });
+      }
+    }
+  };
+
+  for (uint32_t pass_index = 0; pass_index < passes_.size(); ++pass_index) {
+    Pass const& pass = passes_[pass_index];
+
+    if (pass_index > 0) {
+      release_transients_ending_at(pass_index - 1);
+    }
+
+    for (FrameGraphTextureUse const& use : pass.uses) {
+      Texture const& texture = textures_[use.texture.index];
+      bool const first_use = texture.transient && texture.first_pass == pass_index;
+
+      // Consecutive reads in the same state need no barrier.
+      if (!first_use && current_access[use.texture.index] == use.access && IsReadAccess(use.access)) {
+        continue;
+      }
+
+      // A backend texture handed over to the next transient within this batch needs no release.
+      std::erase_if(transitions, [&texture](TextureTransitionDesc const& transition) {
+        return transition.access == TextureAccess::kDiscarded && transition.texture.Get() == texture.handle.Get();
+      });
+
+      transitions.push_back(TextureTransitionDesc {
+        .texture = texture.handle,
+        .subresource_range = MakeWholeRange(texture.desc),
+        .access = use.access,
+        .discard_contents = first_use,
+      });
+      current_access[use.texture.index] = use.access;
+    }
+    flush_transitions();
+
+    command_list.PushDebugGroup({ pass.name.data(), static_cast<uint32_t>(pass.name.size()) }, nullptr);
+    pass.callback(command_list, *this);
+    command_list.PopDebugGroup();
+  }
+
+  if (!passes_.empty()) {
+    release_transients_ending_at(static_cast<uint32_t>(passes_.size() - 1));
+    flush_transitions();
+  }
+}
+
+void FrameGraph::Reset() {
+  textures_.clear();
+  passes_.clear();
+  compiled_ = false;
+}
+
+TextureHandle FrameGraph::GetTexture(FrameGraphTextureId id) const {
+  MBASE_ASSERT_MSG(id.IsValid() && id.index < textures_.size(), "FrameGraph::GetTexture: unknown texture");
+  return textures_[id.index].handle;
+}
+
+void FrameGraph::CreatePhysicalGroup(PhysicalGroup& group) {
+  group.textures.clear();
+  group.size_in_bytes = 0;
+
+  if (group.aliased) {
+    group.textures.resize(group.descs.size());
+    if (device_.CreateAliasedTextures(group.descs, group.textures.data()) != MnBoolFalse) {
+      for (TextureDesc const& desc : group.descs) {
+        group.size_in_bytes = std::max(group.size_in_bytes, mnexus_backend::profiling::EstimateTextureSizeInBytes(desc));
+      }
+      return;
+    }
+    MBASE_LOG_WARN("FrameGraph: cannot alias {} textures, allocating them separately", group.descs.size());
+    group.textures.clear();
+  }
+
+  for (TextureDesc const& desc : group.descs) {
+    group.textures.push_back(device_.CreateTexture(desc));
+    group.size_in_bytes += mnexus_backend::profiling::EstimateTextureSizeInBytes(desc);
+  }
+}
+
+void FrameGraph::DestroyPhysicalGroup(PhysicalGroup const& group) {
+  for (TextureHandle texture : group.textures) {
+    device_.DestroyTexture(texture);
+  }
+}
+
+} // namespace mnexus
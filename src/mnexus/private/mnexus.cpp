@@ -12,6 +12,8 @@
 #include "mbase/public/access.h"
 
 // project headers --------------------------------------
+#include "profiling/present_tracker.h"
+
 #if MNEXUS_ENABLE_BACKEND_VULKAN
 # include "backend-vulkan/backend-vulkan.h"
 #endif
@@ -23,9 +25,10 @@ namespace mnexus {
 
 class Nexus final : public INexus {
 public:
-  explicit Nexus(std::unique_ptr<mnexus_backend::IBackend> backend, bool headless) :
+  explicit Nexus(std::unique_ptr<mnexus_backend::IBackend> backend, bool headless, bool offscreen_swapchain) :
     backend_(std::move(backend)),
-    headless_(headless)
+    headless_(headless),
+    offscreen_swapchain_(offscreen_swapchain)
   {
   }
   ~Nexus() override = default;
@@ -56,13 +59,26 @@ public:
   // Presentation.
 
   MNEXUS_NO_THROW void MNEXUS_CALL OnPresentPrologue() override {
-    MBASE_ASSERT_MSG(!headless_, "OnPresentPrologue() must not be called on a headless INexus instance");
+    MBASE_ASSERT_MSG(!headless_ || offscreen_swapchain_,
+      "OnPresentPrologue() must not be called on a headless INexus instance without an offscreen swapchain");
+    present_tracker_.OnPrologueBegin();
     backend_->OnPresentPrologue();
+    present_tracker_.OnPrologueEnd();
   }
 
   MNEXUS_NO_THROW void MNEXUS_CALL OnPresentEpilogue() override {
-    MBASE_ASSERT_MSG(!headless_, "OnPresentEpilogue() must not be called on a headless INexus instance");
+    MBASE_ASSERT_MSG(!headless_ || offscreen_swapchain_,
+      "OnPresentEpilogue() must not be called on a headless INexus instance without an offscreen swapchain");
     backend_->OnPresentEpilogue();
+    present_tracker_.OnPresented(backend_->GetPresentQueueDepth());
+  }
+
+  MNEXUS_NO_THROW PresentStats MNEXUS_CALL GetPresentStats() override {
+    return present_tracker_.GetStats();
+  }
+
+  MNEXUS_NO_THROW void MNEXUS_CALL ResetPresentStats() override {
+    present_tracker_.Reset();
   }
 
   // ----------------------------------------------------------------------------------------------
@@ -75,6 +91,8 @@ public:
 private:
   std::unique_ptr<mnexus_backend::IBackend> backend_;
   bool headless_ = false;
+  bool offscreen_swapchain_ = false;
+  mnexus_backend::profiling::PresentTracker present_tracker_;
 };
 
 std::span<BackendType const> INexus::EnumerateBackends() {
@@ -92,17 +110,33 @@ std::span<BackendType const> INexus::EnumerateBackends() {
 INexus* INexus::Create(NexusDesc const& desc) {
   std::unique_ptr<mnexus_backend::IBackend> backend;
 
+  // Only a headless instance emulates its swapchain.
+  OffscreenSwapchainDesc offscreen_swapchain_desc;
+  if (desc.headless) {
+    offscreen_swapchain_desc = desc.offscreen_swapchain;
+  }
+
   switch (desc.backend_type) {
 #if MNEXUS_ENABLE_BACKEND_WGPU
   case BackendType::kWebGpu:
-    backend = mnexus_backend::webgpu::IBackendWebGpu::Create();
+    {
+      mnexus_backend::webgpu::BackendWebGpuCreateDesc webgpu_desc {};
+      webgpu_desc.submission_thread = desc.submission_thread;
+      webgpu_desc.offscreen_swapchain = offscreen_swapchain_desc;
+      backend = mnexus_backend::webgpu::IBackendWebGpu::Create(webgpu_desc);
+    }
     break;
 #endif
 #if MNEXUS_ENABLE_BACKEND_VULKAN
   case BackendType::kVulkan:
     {
       mnexus_backend::vulkan::BackendVulkanCreateDesc vulkan_desc {};
+      vulkan_desc.headless = desc.headless;
       vulkan_desc.app_name = desc.app_name ? desc.app_name : "mnexus_app";
+      vulkan_desc.placed_buffers = desc.placed_buffers;
+      vulkan_desc.bindless_resources = desc.bindless_resources;
+      vulkan_desc.adapter_override = desc.adapter_override;
+      vulkan_desc.offscreen_swapchain = offscreen_swapchain_desc;
       backend = mnexus_backend::vulkan::IBackendVulkan::Create(vulkan_desc);
     }
     break;
@@ -115,7 +149,7 @@ INexus* INexus::Create(NexusDesc const& desc) {
   }
 
   if (!backend) return nullptr;
-  return new Nexus(std::move(backend), desc.headless);
+  return new Nexus(std::move(backend), desc.headless, offscreen_swapchain_desc.image_count != 0);
 }
 
 } // namespace mnexus
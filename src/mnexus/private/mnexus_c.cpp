@@ -95,6 +95,24 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceDestroyBuffer(MnDevice device, MnResour
   ToDevice(device)->DestroyBuffer(mnexus::BufferHandle(handle));
 }
 
+MNEXUS_NO_THROW void* MNEXUS_CALL MnDeviceMapBuffer(MnDevice device, MnResourceHandle handle) {
+  return ToDevice(device)->MapBuffer(mnexus::BufferHandle(handle));
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceUnmapBuffer(MnDevice device, MnResourceHandle handle) {
+  ToDevice(device)->UnmapBuffer(mnexus::BufferHandle(handle));
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceFlushMappedBufferRange(
+    MnDevice device, MnResourceHandle handle, uint32_t offset, uint32_t size) {
+  ToDevice(device)->FlushMappedBufferRange(mnexus::BufferHandle(handle), offset, size);
+}
+
+MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceInvalidateMappedBufferRange(
+    MnDevice device, MnResourceHandle handle, uint32_t offset, uint32_t size) {
+  ToDevice(device)->InvalidateMappedBufferRange(mnexus::BufferHandle(handle), offset, size);
+}
+
 MNEXUS_NO_THROW MnResourceHandle MNEXUS_CALL MnDeviceCreateShaderModule(MnDevice device, MnShaderModuleDesc const* desc) {
   return ToDevice(device)->CreateShaderModule(
     *reinterpret_cast<mnexus::ShaderModuleDesc const*>(desc)).Get();
@@ -132,6 +150,18 @@ MNEXUS_NO_THROW MnIntraQueueSubmissionId MNEXUS_CALL MnDeviceQueueWriteBuffer(
     mnexus::BufferHandle(buffer), offset, data, size).Get();
 }
 
+MNEXUS_NO_THROW MnIntraQueueSubmissionId MNEXUS_CALL MnDeviceQueueWriteTexture(
+    MnDevice device, MnQueueId const* queue_id,
+    MnResourceHandle texture,
+    MnTextureWriteRegion const* regions, uint32_t region_count) {
+  return ToDevice(device)->QueueWriteTexture(
+    *reinterpret_cast<mnexus::QueueId const*>(queue_id),
+    mnexus::TextureHandle(texture),
+    mnexus::container::ArrayProxy<mnexus::TextureWriteRegion const>(
+      reinterpret_cast<mnexus::TextureWriteRegion const*>(regions),
+      region_count)).Get();
+}
+
 MNEXUS_NO_THROW MnIntraQueueSubmissionId MNEXUS_CALL MnDeviceQueueSubmitCommandList(
     MnDevice device, MnQueueId const* queue_id, MnCommandList command_list) {
   return ToDevice(device)->QueueSubmitCommandList(
@@ -148,6 +178,19 @@ MNEXUS_NO_THROW MnIntraQueueSubmissionId MNEXUS_CALL MnDeviceQueueReadBuffer(
     mnexus::BufferHandle(buffer), offset, dst, size).Get();
 }
 
+MNEXUS_NO_THROW MnIntraQueueSubmissionId MNEXUS_CALL MnDeviceQueueReadTexture(
+    MnDevice device, MnQueueId const* queue_id,
+    MnResourceHandle texture, MnTextureSubresourceRange const* range,
+    MnExtent3d const* extent,
+    void* dst, uint64_t dst_size) {
+  return ToDevice(device)->QueueReadTexture(
+    *reinterpret_cast<mnexus::QueueId const*>(queue_id),
+    mnexus::TextureHandle(texture),
+    *reinterpret_cast<mnexus::TextureSubresourceRange const*>(range),
+    *reinterpret_cast<mnexus::Extent3d const*>(extent),
+    dst, dst_size).Get();
+}
+
 MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceQueueWaitIdle(
     MnDevice device, MnQueueId const* queue_id,
     MnIntraQueueSubmissionId value) {
@@ -156,6 +199,22 @@ MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceQueueWaitIdle(
     mnexus::IntraQueueSubmissionId(value));
 }
 
+MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceQueueOnCompleted(
+    MnDevice device, MnQueueId const* queue_id,
+    MnIntraQueueSubmissionId value,
+    MnQueueCompletedCallback callback, void* user_data) {
+  ToDevice(device)->QueueOnCompleted(
+    *reinterpret_cast<mnexus::QueueId const*>(queue_id),
+    mnexus::IntraQueueSubmissionId(value),
+    callback, user_data);
+}
+
+MNEXUS_NO_THROW intptr_t MNEXUS_CALL MnDeviceQueueGetCompletionEvent(
+    MnDevice device, MnQueueId const* queue_id) {
+  return ToDevice(device)->QueueGetCompletionEvent(
+    *reinterpret_cast<mnexus::QueueId const*>(queue_id));
+}
+
 // ----------------------------------------------------------------------------------------------------
 // ICommandList
 //
@@ -6,6 +6,18 @@
 
 namespace pipeline {
 
+namespace {
+
+uint32_t PackShaderStages(mnexus::ShaderStageFlags stages) {
+  uint32_t result = 0;
+  if (stages.HasAnyOf(mnexus::ShaderStageFlagBits::kVertex))   { result |= MnShaderStageFlagBitVertex; }
+  if (stages.HasAnyOf(mnexus::ShaderStageFlagBits::kFragment)) { result |= MnShaderStageFlagBitFragment; }
+  if (stages.HasAnyOf(mnexus::ShaderStageFlagBits::kCompute))  { result |= MnShaderStageFlagBitCompute; }
+  return result;
+}
+
+} // namespace
+
 size_t PipelineLayoutCacheKey::ComputeHash() const {
   mbase::Hasher hasher;
 
@@ -21,11 +33,18 @@ size_t PipelineLayoutCacheKey::ComputeHash() const {
     }
   }
 
+  hasher.Do(push_constant_stages);
+  hasher.Do(push_constant_offset);
+  hasher.Do(push_constant_size);
+
   return static_cast<size_t>(hasher.Finish());
 }
 
 bool PipelineLayoutCacheKey::operator==(PipelineLayoutCacheKey const& other) const {
   if (groups.size() != other.groups.size()) return false;
+  if (push_constant_stages != other.push_constant_stages) return false;
+  if (push_constant_offset != other.push_constant_offset) return false;
+  if (push_constant_size != other.push_constant_size) return false;
 
   for (size_t g = 0; g < groups.size(); ++g) {
     auto const& a = groups[g];
@@ -48,11 +67,18 @@ bool PipelineLayoutCacheKey::operator==(PipelineLayoutCacheKey const& other) con
 }
 
 PipelineLayoutCacheKey BuildPipelineLayoutCacheKey(
-  mbase::ArrayProxy<shader::BindGroupLayout const> bind_group_layouts
+  mbase::ArrayProxy<shader::BindGroupLayout const> bind_group_layouts,
+  shader::PushConstantRange const& push_constant_range
 ) {
   PipelineLayoutCacheKey key;
   key.groups.reserve(bind_group_layouts.size());
 
+  if (!push_constant_range.IsEmpty()) {
+    key.push_constant_stages = PackShaderStages(push_constant_range.stages);
+    key.push_constant_offset = push_constant_range.offset;
+    key.push_constant_size = push_constant_range.size;
+  }
+
   for (uint32_t i = 0; i < bind_group_layouts.size(); ++i) {
     shader::BindGroupLayout const& src = bind_group_layouts[i];
 
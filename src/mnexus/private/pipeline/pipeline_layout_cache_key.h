@@ -11,7 +11,7 @@
 #include "mnexus/public/types.h"
 
 // forward declarations ---------------------------------
-namespace shader { struct BindGroupLayout; }
+namespace shader { struct BindGroupLayout; struct PushConstantRange; }
 
 namespace pipeline {
 
@@ -32,6 +32,11 @@ struct PipelineLayoutCacheKey final {
 
   mbase::SmallVector<Group, 4> groups;  // sorted by set
 
+  /// Merged push constant range; `push_constant_size == 0` if the layout has none.
+  uint32_t push_constant_stages = 0;
+  uint32_t push_constant_offset = 0;
+  uint32_t push_constant_size = 0;
+
   [[nodiscard]] size_t ComputeHash() const;
   [[nodiscard]] bool operator==(PipelineLayoutCacheKey const& other) const;
 
@@ -42,9 +47,10 @@ struct PipelineLayoutCacheKey final {
   };
 };
 
-/// Build a `PipelineLayoutCacheKey` from merged bind group layouts (shader reflection output).
+/// Build a `PipelineLayoutCacheKey` from merged bind group layouts and push constant range (shader reflection output).
 PipelineLayoutCacheKey BuildPipelineLayoutCacheKey(
-  mbase::ArrayProxy<shader::BindGroupLayout const> bind_group_layouts
+  mbase::ArrayProxy<shader::BindGroupLayout const> bind_group_layouts,
+  shader::PushConstantRange const& push_constant_range
 );
 
 } // namespace pipeline
@@ -74,6 +74,14 @@ public:
     cache_misses_.store(0, std::memory_order_relaxed);
   }
 
+  /// Erases every entry for which `predicate(RenderPipelineCacheKey const& key)` returns true.
+  /// Returns the number of erased entries.
+  template<typename TPredicate>
+  size_t EraseIf(TPredicate&& predicate) MBASE_EXCLUDES(mutex_) {
+    mbase::LockGuard lock(mutex_);
+    return std::erase_if(cache_, [&predicate](auto const& entry) { return predicate(entry.first); });
+  }
+
   [[nodiscard]] size_t size() const MBASE_EXCLUDES(mutex_) {
     mbase::SharedLockGuard lock(mutex_);
     return cache_.size();
@@ -79,6 +79,9 @@ public:
 
   void MarkClean() { dirty_ = false; }
 
+  /// Forces re-resolution at the next draw, e.g. after the backend's pass-level pipeline binding was reset.
+  void MarkDirty() { dirty_ = true; }
+
   // -----------------------------------------------------------------------
   // Cache key assembly
 
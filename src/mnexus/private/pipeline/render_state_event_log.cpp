@@ -1,11 +1,177 @@
 // TU header --------------------------------------------
 #include "mnexus/public/render_state_event_log.h"
 
+// c++ headers ------------------------------------------
+#include <algorithm>
+#include <iterator>
+
 // public project headers -------------------------------
 #include "mbase/public/assert.h"
 
 namespace mnexus {
 
+namespace {
+
+// ----------------------------------------------------------------------------------------------------
+// Field encoding
+//
+// Every scalar of `RenderPipelineStateSnapshot` that can be delta-encoded. Per-attachment fields additionally carry
+// the attachment index. The vector-shaped parts (attachment count, vertex input, render target formats) are never
+// delta-encoded; a change to any of them forces a keyframe.
+//
+
+enum class Field : uint8_t {
+  kProgram,
+  kPrimitiveTopology,
+  kPolygonMode,
+  kCullMode,
+  kFrontFace,
+  kDepthTestEnabled,
+  kDepthWriteEnabled,
+  kDepthCompareOp,
+  kStencilTestEnabled,
+  kStencilFrontFailOp,
+  kStencilFrontPassOp,
+  kStencilFrontDepthFailOp,
+  kStencilFrontCompareOp,
+  kStencilBackFailOp,
+  kStencilBackPassOp,
+  kStencilBackDepthFailOp,
+  kStencilBackCompareOp,
+
+  kFirstScalar = kProgram,
+  kLastScalar = kStencilBackCompareOp,
+
+  kBlendEnabled,
+  kSrcColor,
+  kDstColor,
+  kColorOp,
+  kSrcAlpha,
+  kDstAlpha,
+  kAlphaOp,
+  kWriteMask,
+
+  kFirstAttachment = kBlendEnabled,
+  kLastAttachment = kWriteMask,
+};
+
+uint64_t GetScalarField(RenderPipelineStateSnapshot const& s, Field field) {
+  switch (field) {
+  case Field::kProgram:                 return s.program.Get();
+  case Field::kPrimitiveTopology:       return static_cast<uint64_t>(s.primitive_topology);
+  case Field::kPolygonMode:             return static_cast<uint64_t>(s.polygon_mode);
+  case Field::kCullMode:                return static_cast<uint64_t>(s.cull_mode);
+  case Field::kFrontFace:               return static_cast<uint64_t>(s.front_face);
+  case Field::kDepthTestEnabled:        return s.depth_test_enabled ? 1 : 0;
+  case Field::kDepthWriteEnabled:       return s.depth_write_enabled ? 1 : 0;
+  case Field::kDepthCompareOp:          return static_cast<uint64_t>(s.depth_compare_op);
+  case Field::kStencilTestEnabled:      return s.stencil_test_enabled ? 1 : 0;
+  case Field::kStencilFrontFailOp:      return static_cast<uint64_t>(s.stencil_front_fail_op);
+  case Field::kStencilFrontPassOp:      return static_cast<uint64_t>(s.stencil_front_pass_op);
+  case Field::kStencilFrontDepthFailOp: return static_cast<uint64_t>(s.stencil_front_depth_fail_op);
+  case Field::kStencilFrontCompareOp:   return static_cast<uint64_t>(s.stencil_front_compare_op);
+  case Field::kStencilBackFailOp:       return static_cast<uint64_t>(s.stencil_back_fail_op);
+  case Field::kStencilBackPassOp:       return static_cast<uint64_t>(s.stencil_back_pass_op);
+  case Field::kStencilBackDepthFailOp:  return static_cast<uint64_t>(s.stencil_back_depth_fail_op);
+  case Field::kStencilBackCompareOp:    return static_cast<uint64_t>(s.stencil_back_compare_op);
+  default:
+    MBASE_ASSERT_MSG(false, "Not a scalar render state field");
+    return 0;
+  }
+}
+
+void SetScalarField(RenderPipelineStateSnapshot& s, Field field, uint64_t value) {
+  switch (field) {
+  case Field::kProgram:                 s.program = ProgramHandle { value }; break;
+  case Field::kPrimitiveTopology:       s.primitive_topology = static_cast<PrimitiveTopology>(value); break;
+  case Field::kPolygonMode:             s.polygon_mode = static_cast<PolygonMode>(value); break;
+  case Field::kCullMode:                s.cull_mode = static_cast<CullMode>(value); break;
+  case Field::kFrontFace:               s.front_face = static_cast<FrontFace>(value); break;
+  case Field::kDepthTestEnabled:        s.depth_test_enabled = value != 0; break;
+  case Field::kDepthWriteEnabled:       s.depth_write_enabled = value != 0; break;
+  case Field::kDepthCompareOp:          s.depth_compare_op = static_cast<CompareOp>(value); break;
+  case Field::kStencilTestEnabled:      s.stencil_test_enabled = value != 0; break;
+  case Field::kStencilFrontFailOp:      s.stencil_front_fail_op = static_cast<StencilOp>(value); break;
+  case Field::kStencilFrontPassOp:      s.stencil_front_pass_op = static_cast<StencilOp>(value); break;
+  case Field::kStencilFrontDepthFailOp: s.stencil_front_depth_fail_op = static_cast<StencilOp>(value); break;
+  case Field::kStencilFrontCompareOp:   s.stencil_front_compare_op = static_cast<CompareOp>(value); break;
+  case Field::kStencilBackFailOp:       s.stencil_back_fail_op = static_cast<StencilOp>(value); break;
+  case Field::kStencilBackPassOp:       s.stencil_back_pass_op = static_cast<StencilOp>(value); break;
+  case Field::kStencilBackDepthFailOp:  s.stencil_back_depth_fail_op = static_cast<StencilOp>(value); break;
+  case Field::kStencilBackCompareOp:    s.stencil_back_compare_op = static_cast<CompareOp>(value); break;
+  default:
+    MBASE_ASSERT_MSG(false, "Not a scalar render state field");
+    break;
+  }
+}
+
+using AttachmentState = RenderPipelineStateSnapshot::AttachmentState;
+
+uint64_t GetAttachmentField(AttachmentState const& a, Field field) {
+  switch (field) {
+  case Field::kBlendEnabled: return a.blend_enabled ? 1 : 0;
+  case Field::kSrcColor:     return static_cast<uint64_t>(a.src_color);
+  case Field::kDstColor:     return static_cast<uint64_t>(a.dst_color);
+  case Field::kColorOp:      return static_cast<uint64_t>(a.color_op);
+  case Field::kSrcAlpha:     return static_cast<uint64_t>(a.src_alpha);
+  case Field::kDstAlpha:     return static_cast<uint64_t>(a.dst_alpha);
+  case Field::kAlphaOp:      return static_cast<uint64_t>(a.alpha_op);
+  case Field::kWriteMask:    return static_cast<uint64_t>(a.write_mask);
+  default:
+    MBASE_ASSERT_MSG(false, "Not a per-attachment render state field");
+    return 0;
+  }
+}
+
+void SetAttachmentField(AttachmentState& a, Field field, uint64_t value) {
+  switch (field) {
+  case Field::kBlendEnabled: a.blend_enabled = value != 0; break;
+  case Field::kSrcColor:     a.src_color = static_cast<BlendFactor>(value); break;
+  case Field::kDstColor:     a.dst_color = static_cast<BlendFactor>(value); break;
+  case Field::kColorOp:      a.color_op = static_cast<BlendOp>(value); break;
+  case Field::kSrcAlpha:     a.src_alpha = static_cast<BlendFactor>(value); break;
+  case Field::kDstAlpha:     a.dst_alpha = static_cast<BlendFactor>(value); break;
+  case Field::kAlphaOp:      a.alpha_op = static_cast<BlendOp>(value); break;
+  case Field::kWriteMask:    a.write_mask = static_cast<ColorWriteMask>(value); break;
+  default:
+    MBASE_ASSERT_MSG(false, "Not a per-attachment render state field");
+    break;
+  }
+}
+
+bool IsAttachmentField(Field field) {
+  return field >= Field::kFirstAttachment && field <= Field::kLastAttachment;
+}
+
+/// True if the parts of the state that are not delta-encoded differ.
+bool StructureDiffers(RenderPipelineStateSnapshot const& a, RenderPipelineStateSnapshot const& b) {
+  if (a.attachments.size() != b.attachments.size() ||
+      a.depth_stencil_format != b.depth_stencil_format ||
+      a.sample_count != b.sample_count ||
+      !std::equal(a.color_formats.begin(), a.color_formats.end(), b.color_formats.begin(), b.color_formats.end())) {
+    return true;
+  }
+
+  auto const binding_equal = [](VertexInputBindingDesc const& x, VertexInputBindingDesc const& y) {
+    return x.binding == y.binding && x.stride == y.stride && x.step_mode == y.step_mode;
+  };
+  auto const attribute_equal = [](VertexInputAttributeDesc const& x, VertexInputAttributeDesc const& y) {
+    return x.location == y.location && x.binding == y.binding && x.format == y.format && x.offset == y.offset;
+  };
+
+  return
+    !std::equal(a.vertex_bindings.begin(), a.vertex_bindings.end(),
+                b.vertex_bindings.begin(), b.vertex_bindings.end(), binding_equal) ||
+    !std::equal(a.vertex_attributes.begin(), a.vertex_attributes.end(),
+                b.vertex_attributes.begin(), b.vertex_attributes.end(), attribute_equal);
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------------------------------
+// RenderStateEventLog
+//
+
 void RenderStateEventLog::SetEnabled(bool enabled) {
   enabled_ = enabled;
 }
@@ -14,34 +180,191 @@ bool RenderStateEventLog::IsEnabled() const {
   return enabled_;
 }
 
+void RenderStateEventLog::SetRingCapacity(uint32_t capacity) {
+  ring_capacity_ = capacity;
+  this->Clear();
+}
+
+uint32_t RenderStateEventLog::GetRingCapacity() const {
+  return ring_capacity_;
+}
+
+void RenderStateEventLog::SetKeyframeInterval(uint32_t interval) {
+  MBASE_ASSERT(interval > 0);
+  keyframe_interval_ = interval;
+  this->Clear();
+}
+
+uint32_t RenderStateEventLog::GetKeyframeInterval() const {
+  return keyframe_interval_;
+}
+
 void RenderStateEventLog::Record(RenderStateEventTag tag,
                                  RenderPipelineStateSnapshot const& state) {
   if (!enabled_) return;
-  events_.push_back(RenderStateEvent { .tag = tag, .state = state });
+  this->Append(tag, state, 0, false);
 }
 
 void RenderStateEventLog::RecordPso(RenderPipelineStateSnapshot const& state,
                                     size_t hash, bool cache_hit) {
   if (!enabled_) return;
-  events_.push_back(RenderStateEvent {
-    .tag = RenderStateEventTag::kPsoResolved,
-    .state = state,
-    .pso_hash = hash,
-    .cache_hit = cache_hit,
-  });
+  this->Append(RenderStateEventTag::kPsoResolved, state, hash, cache_hit);
 }
 
 uint32_t RenderStateEventLog::GetCount() const {
-  return static_cast<uint32_t>(events_.size());
+  return static_cast<uint32_t>(next_sequence_ - first_sequence_);
 }
 
-RenderStateEvent const& RenderStateEventLog::GetEvent(uint32_t index) const {
-  MBASE_ASSERT(index < events_.size());
-  return events_[index];
+uint64_t RenderStateEventLog::GetTotalRecordedCount() const {
+  return next_sequence_;
+}
+
+RenderStateEvent RenderStateEventLog::GetEvent(uint32_t index) const {
+  MBASE_ASSERT(index < this->GetCount());
+  uint64_t const sequence = first_sequence_ + index;
+
+  // Latest keyframe at or before `sequence`.
+  auto it = std::upper_bound(
+    keyframes_.begin(), keyframes_.end(), sequence,
+    [](uint64_t seq, Keyframe const& keyframe) { return seq < keyframe.sequence; }
+  );
+  MBASE_ASSERT(it != keyframes_.begin());
+  Keyframe const& keyframe = *std::prev(it);
+
+  RenderStateEvent event {
+    .tag = RenderStateEventTag::kBeginRenderPass,
+    .state = keyframe.state,
+  };
+
+  for (uint64_t seq = keyframe.sequence + 1; seq <= sequence; ++seq) {
+    EncodedEvent const& encoded = this->EventAt(seq);
+    MBASE_ASSERT(!encoded.keyframe);
+    for (uint32_t i = 0; i < encoded.delta_count; ++i) {
+      ApplyDelta(event.state, encoded.deltas[i]);
+    }
+  }
+
+  EncodedEvent const& encoded = this->EventAt(sequence);
+  event.tag = encoded.tag;
+  event.pso_hash = encoded.pso_hash;
+  event.cache_hit = encoded.cache_hit;
+  return event;
 }
 
 void RenderStateEventLog::Clear() {
+  first_sequence_ = 0;
+  next_sequence_ = 0;
   events_.clear();
+  keyframes_.clear();
+  current_ = {};
+}
+
+void RenderStateEventLog::Append(RenderStateEventTag tag,
+                                 RenderPipelineStateSnapshot const& state,
+                                 size_t hash, bool cache_hit) {
+  uint64_t const sequence = next_sequence_++;
+
+  EncodedEvent encoded {
+    .tag = tag,
+    .cache_hit = cache_hit,
+    .pso_hash = hash,
+  };
+
+  bool keyframe =
+    keyframes_.empty() ||
+    sequence - keyframes_.back().sequence >= keyframe_interval_ ||
+    StructureDiffers(current_, state);
+
+  if (!keyframe) {
+    auto push_delta = [&encoded, &keyframe](Field field, uint32_t attachment, uint64_t value) {
+      if (encoded.delta_count == kMaxInlineDeltas) {
+        keyframe = true;
+        return;
+      }
+      encoded.deltas[encoded.delta_count++] = FieldDelta {
+        .value = value,
+        .field = static_cast<uint8_t>(field),
+        .attachment = static_cast<uint8_t>(attachment),
+      };
+    };
+
+    for (uint8_t f = static_cast<uint8_t>(Field::kFirstScalar);
+         f <= static_cast<uint8_t>(Field::kLastScalar) && !keyframe;
+         ++f) {
+      Field const field = static_cast<Field>(f);
+      uint64_t const value = GetScalarField(state, field);
+      if (value != GetScalarField(current_, field)) {
+        push_delta(field, 0, value);
+      }
+    }
+
+    for (uint32_t a = 0; a < state.attachments.size() && !keyframe; ++a) {
+      for (uint8_t f = static_cast<uint8_t>(Field::kFirstAttachment);
+           f <= static_cast<uint8_t>(Field::kLastAttachment) && !keyframe;
+           ++f) {
+        Field const field = static_cast<Field>(f);
+        uint64_t const value = GetAttachmentField(state.attachments[a], field);
+        if (value != GetAttachmentField(current_.attachments[a], field)) {
+          push_delta(field, a, value);
+        }
+      }
+    }
+  }
+
+  if (keyframe) {
+    encoded.keyframe = true;
+    encoded.delta_count = 0;
+    current_ = state;
+    keyframes_.emplace_back(Keyframe { .sequence = sequence, .state = state });
+  } else {
+    for (uint32_t i = 0; i < encoded.delta_count; ++i) {
+      ApplyDelta(current_, encoded.deltas[i]);
+    }
+  }
+
+  if (ring_capacity_ == 0) {
+    events_.emplace_back(encoded);
+    return;
+  }
+
+  if (events_.size() < ring_capacity_) {
+    events_.emplace_back(encoded);
+  } else {
+    events_[sequence % ring_capacity_] = encoded;
+  }
+
+  if (next_sequence_ - first_sequence_ > ring_capacity_) {
+    ++first_sequence_;
+
+    // Keep the front keyframe at the oldest retained event: either the next keyframe takes over, or the front one is
+    // rolled forward by the deltas of the new oldest event.
+    if (keyframes_.size() >= 2 && keyframes_[1].sequence == first_sequence_) {
+      keyframes_.pop_front();
+    } else {
+      Keyframe& front = keyframes_.front();
+      EncodedEvent const& oldest = this->EventAt(first_sequence_);
+      for (uint32_t i = 0; i < oldest.delta_count; ++i) {
+        ApplyDelta(front.state, oldest.deltas[i]);
+      }
+      front.sequence = first_sequence_;
+    }
+  }
+}
+
+void RenderStateEventLog::ApplyDelta(RenderPipelineStateSnapshot& state, FieldDelta const& delta) {
+  Field const field = static_cast<Field>(delta.field);
+  if (IsAttachmentField(field)) {
+    SetAttachmentField(state.attachments[delta.attachment], field, delta.value);
+  } else {
+    SetScalarField(state, field, delta.value);
+  }
+}
+
+RenderStateEventLog::EncodedEvent const& RenderStateEventLog::EventAt(uint64_t sequence) const {
+  MBASE_ASSERT(sequence >= first_sequence_ && sequence < next_sequence_);
+  return ring_capacity_ == 0
+    ? events_[static_cast<size_t>(sequence - first_sequence_)]
+    : events_[static_cast<size_t>(sequence % ring_capacity_)];
 }
 
 } // namespace mnexus
@@ -0,0 +1,18 @@
+// TU header --------------------------------------------
+#include "pipeline/render_target_signature.h"
+
+// c++ headers ------------------------------------------
+#include <algorithm>
+
+namespace pipeline {
+
+bool RenderTargetSignature::Matches(RenderTargetSignature const& other) const {
+  return depth_stencil_format == other.depth_stencil_format &&
+         sample_count == other.sample_count &&
+         std::equal(
+           color_formats.begin(), color_formats.end(),
+           other.color_formats.begin(), other.color_formats.end()
+         );
+}
+
+} // namespace pipeline
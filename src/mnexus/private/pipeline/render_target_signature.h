@@ -0,0 +1,23 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+// public project headers -------------------------------
+#include "mbase/public/container.h"
+
+#include "mnexus/public/types.h"
+
+namespace pipeline {
+
+/// Attachment formats of a render pass or render bundle. A bundle can only be executed in a pass with an identical
+/// signature.
+struct RenderTargetSignature final {
+  mbase::SmallVector<mnexus::Format, 4> color_formats;
+  mnexus::Format depth_stencil_format = mnexus::Format::kUndefined;
+  uint32_t sample_count = 1;
+
+  [[nodiscard]] bool Matches(RenderTargetSignature const& other) const;
+};
+
+} // namespace pipeline
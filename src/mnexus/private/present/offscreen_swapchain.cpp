@@ -0,0 +1,72 @@
+// TU header --------------------------------------------
+#include "present/offscreen_swapchain.h"
+
+// c++ headers ------------------------------------------
+#include <thread>
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+
+namespace mnexus_backend::present {
+
+OffscreenSwapchain::OffscreenSwapchain(uint32_t image_count, std::chrono::nanoseconds present_latency) :
+  present_latency_(present_latency),
+  images_(image_count)
+{
+  MBASE_ASSERT_MSG(image_count != 0, "An offscreen swapchain needs at least one image");
+}
+
+uint32_t OffscreenSwapchain::AcquireNextImage(WaitSerialFn const& wait_serial) {
+  uint32_t image_index = 0;
+  Image image;
+  {
+    mbase::LockGuard lock(mutex_);
+    MBASE_ASSERT_MSG(!acquired_image_index_.has_value(), "An offscreen swapchain image is already acquired");
+
+    image_index = next_image_index_;
+    image = images_[image_index];
+  }
+
+  // Outside the lock, so that `GetQueueDepth` does not wait on the stall.
+  if (image.queued) {
+    wait_serial(image.serial);
+    std::this_thread::sleep_until(image.release_time);
+  }
+
+  mbase::LockGuard lock(mutex_);
+  images_[image_index].queued = false;
+  next_image_index_ = (image_index + 1) % static_cast<uint32_t>(images_.size());
+  acquired_image_index_ = image_index;
+  return image_index;
+}
+
+void OffscreenSwapchain::Present(uint64_t serial) {
+  mbase::LockGuard lock(mutex_);
+  MBASE_ASSERT_MSG(acquired_image_index_.has_value(), "No offscreen swapchain image is acquired");
+
+  Image& image = images_[*acquired_image_index_];
+  image.queued = true;
+  image.serial = serial;
+  image.release_time = Clock::now() + present_latency_;
+  acquired_image_index_ = std::nullopt;
+}
+
+std::optional<uint32_t> OffscreenSwapchain::GetAcquiredImageIndex() const {
+  mbase::LockGuard lock(mutex_);
+  return acquired_image_index_;
+}
+
+uint32_t OffscreenSwapchain::GetQueueDepth(uint64_t completed_serial) const {
+  Clock::time_point const now = Clock::now();
+
+  mbase::LockGuard lock(mutex_);
+  uint32_t depth = 0;
+  for (Image const& image : images_) {
+    if (image.queued && (image.serial > completed_serial || image.release_time > now)) {
+      ++depth;
+    }
+  }
+  return depth;
+}
+
+} // namespace mnexus_backend::present
@@ -0,0 +1,66 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/tsa.h"
+
+namespace mnexus_backend::present {
+
+// ----------------------------------------------------------------------------------------------------
+// OffscreenSwapchain
+//
+// Backend-neutral image rotation of the swapchain a headless instance emulates (`NexusDesc::offscreen_swapchain`).
+// Images are handed out in presentation order. A presented image stays queued until the present queue has completed
+// the frame's work and the present latency has elapsed since its present; acquiring it blocks until then. Backends
+// own the images and map the indices handed out here to them.
+//
+
+class OffscreenSwapchain final {
+public:
+  using Clock = std::chrono::steady_clock;
+  /// Blocks until the present queue has completed `serial`.
+  using WaitSerialFn = std::function<void(uint64_t serial)>;
+
+  OffscreenSwapchain(uint32_t image_count, std::chrono::nanoseconds present_latency);
+  ~OffscreenSwapchain() = default;
+  MBASE_DISALLOW_COPY_MOVE(OffscreenSwapchain);
+
+  [[nodiscard]] uint32_t GetImageCount() const { return static_cast<uint32_t>(images_.size()); }
+
+  /// Acquires the next image in presentation order, blocking while it is still queued.
+  /// **MUST NOT** be called while an image is acquired.
+  uint32_t AcquireNextImage(WaitSerialFn const& wait_serial);
+
+  /// Queues the acquired image. `serial` is the present queue's timeline value that covers the frame's work.
+  void Present(uint64_t serial);
+
+  [[nodiscard]] std::optional<uint32_t> GetAcquiredImageIndex() const;
+
+  /// Presented images still queued, given the present queue's completed timeline value.
+  [[nodiscard]] uint32_t GetQueueDepth(uint64_t completed_serial) const;
+
+private:
+  struct Image final {
+    bool queued = false;
+    uint64_t serial = 0;
+    Clock::time_point release_time;
+  };
+
+  std::chrono::nanoseconds const present_latency_;
+
+  mbase::Lockable<std::mutex> mutable mutex_;
+  std::vector<Image> images_ MBASE_GUARDED_BY(mutex_);
+  uint32_t next_image_index_ MBASE_GUARDED_BY(mutex_) = 0;
+  std::optional<uint32_t> acquired_image_index_ MBASE_GUARDED_BY(mutex_);
+};
+
+} // namespace mnexus_backend::present
@@ -0,0 +1,151 @@
+// TU header --------------------------------------------
+#include "profiling/gpu_timing.h"
+
+// c++ headers ------------------------------------------
+#include <algorithm>
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+#include "mbase/public/log.h"
+
+namespace mnexus_backend::profiling {
+
+// ----------------------------------------------------------------------------------------------------
+// GpuTimingRecorder
+//
+
+GpuTimingRecorder::GpuTimingRecorder(uint32_t query_capacity) :
+  query_capacity_(query_capacity)
+{
+}
+
+uint32_t GpuTimingRecorder::PushScope(std::string_view name, mnexus::GpuTimingScopeKind kind, bool timestamped) {
+  uint32_t const scope_index = static_cast<uint32_t>(scopes_.size());
+
+  Scope scope {
+    .name = std::string(name),
+    .kind = kind,
+    .parent_index = open_scopes_.empty() ? mnexus::kGpuTimingNoParent : open_scopes_.back(),
+    .depth = static_cast<uint32_t>(open_scopes_.size()),
+  };
+
+  if (timestamped) {
+    if (query_count_ + 2 <= query_capacity_) {
+      scope.begin_query = query_count_++;
+      scope.end_query = query_count_++;
+    } else if (!capacity_exhausted_logged_) {
+      MBASE_LOG_WARN("GPU timing query capacity ({}) exhausted; further scopes are not timestamped", query_capacity_);
+      capacity_exhausted_logged_ = true;
+    }
+  }
+
+  scopes_.emplace_back(std::move(scope));
+  open_scopes_.push_back(scope_index);
+  return scope_index;
+}
+
+uint32_t GpuTimingRecorder::PopScope() {
+  MBASE_ASSERT_MSG(!open_scopes_.empty(), "GPU timing scope stack underflow (unbalanced PopDebugGroup?)");
+
+  uint32_t const scope_index = open_scopes_.back();
+  open_scopes_.pop_back();
+  return scope_index;
+}
+
+mnexus::GpuTimingReport GpuTimingRecorder::BuildReport(
+  mnexus::IntraQueueSubmissionId submission_id,
+  mbase::ArrayProxy<uint64_t const> timestamps,
+  double nanoseconds_per_tick
+) const {
+  MBASE_ASSERT(timestamps.size() >= query_count_);
+
+  auto to_ns = [nanoseconds_per_tick](uint64_t ticks) {
+    return static_cast<uint64_t>(static_cast<double>(ticks) * nanoseconds_per_tick);
+  };
+
+  mnexus::GpuTimingReport report;
+  report.submission_id = submission_id;
+  report.scopes.resize(scopes_.size());
+
+  for (uint32_t i = 0; i < scopes_.size(); ++i) {
+    Scope const& scope = scopes_[i];
+    mnexus::GpuTimingScope& out = report.scopes[i];
+
+    out.name = scope.name;
+    out.kind = scope.kind;
+    out.parent_index = scope.parent_index;
+    out.depth = scope.depth;
+
+    if (scope.begin_query != kNoQuery) {
+      uint64_t const begin_ticks = timestamps[scope.begin_query];
+      uint64_t const end_ticks = timestamps[scope.end_query];
+      if (end_ticks >= begin_ticks && end_ticks != 0) {
+        out.begin_ns = to_ns(begin_ticks);
+        out.end_ns = to_ns(end_ticks);
+        out.valid = true;
+      }
+    }
+  }
+
+  // Children always follow their parent, so a reverse walk sees every child before its parent.
+  for (uint32_t i = static_cast<uint32_t>(scopes_.size()); i-- > 0; ) {
+    mnexus::GpuTimingScope const& child = report.scopes[i];
+    if (!child.valid || child.parent_index == mnexus::kGpuTimingNoParent) {
+      continue;
+    }
+    if (scopes_[child.parent_index].begin_query != kNoQuery) {
+      continue;
+    }
+
+    mnexus::GpuTimingScope& parent = report.scopes[child.parent_index];
+    if (!parent.valid) {
+      parent.begin_ns = child.begin_ns;
+      parent.end_ns = child.end_ns;
+      parent.valid = true;
+    } else {
+      parent.begin_ns = std::min(parent.begin_ns, child.begin_ns);
+      parent.end_ns = std::max(parent.end_ns, child.end_ns);
+    }
+  }
+
+  return report;
+}
+
+// ----------------------------------------------------------------------------------------------------
+// GpuTimingReportCache
+//
+
+void GpuTimingReportCache::Insert(mnexus::QueueId const& queue_id, mnexus::GpuTimingReport report) {
+  mbase::LockGuard lock(mutex_);
+
+  if (capacity_ == 0) {
+    return;
+  }
+  while (entries_.size() >= capacity_) {
+    entries_.pop_front();
+  }
+  entries_.emplace_back(Entry { .queue_id = queue_id, .report = std::move(report) });
+}
+
+bool GpuTimingReportCache::Find(
+  mnexus::QueueId const& queue_id,
+  mnexus::IntraQueueSubmissionId submission_id,
+  mnexus::GpuTimingReport& out_report
+) const {
+  mbase::LockGuard lock(mutex_);
+
+  for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+    if (it->queue_id == queue_id && it->report.submission_id.Get() == submission_id.Get()) {
+      out_report = it->report;
+      return true;
+    }
+  }
+  return false;
+}
+
+void GpuTimingReportCache::Clear() {
+  mbase::LockGuard lock(mutex_);
+  entries_.clear();
+}
+
+} // namespace mnexus_backend::profiling
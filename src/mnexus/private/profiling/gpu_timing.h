@@ -0,0 +1,120 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/array_proxy.h"
+#include "mbase/public/tsa.h"
+
+#include "mnexus/public/gpu_timing.h"
+#include "mnexus/public/types.h"
+
+namespace mnexus_backend::profiling {
+
+// ----------------------------------------------------------------------------------------------------
+// GpuTimingRecorder
+//
+// Records the scope tree of a single command list, and the timestamp query slots bracketing each scope.
+// Owned by a command list only while GPU timing is enabled; a command list without a recorder carries no timing
+// state at all.
+//
+
+class GpuTimingRecorder final {
+public:
+  static constexpr uint32_t kNoQuery = UINT32_MAX;
+
+  struct Scope final {
+    std::string name;
+    mnexus::GpuTimingScopeKind kind = mnexus::GpuTimingScopeKind::kDebugGroup;
+    uint32_t parent_index = mnexus::kGpuTimingNoParent;
+    uint32_t depth = 0;
+    uint32_t begin_query = kNoQuery;
+    uint32_t end_query = kNoQuery;
+  };
+
+  explicit GpuTimingRecorder(uint32_t query_capacity);
+  ~GpuTimingRecorder() = default;
+  MBASE_DISALLOW_COPY_MOVE(GpuTimingRecorder);
+
+  /// Opens a scope nested in the innermost open scope and returns its index.
+  /// When `timestamped` is true, a begin/end query pair is reserved for the scope unless the query capacity is
+  /// exhausted, in which case the scope is recorded without queries.
+  uint32_t PushScope(std::string_view name, mnexus::GpuTimingScopeKind kind, bool timestamped);
+
+  /// Closes the innermost open scope and returns its index.
+  uint32_t PopScope();
+
+  [[nodiscard]] Scope const& GetScope(uint32_t scope_index) const { return scopes_[scope_index]; }
+  [[nodiscard]] uint32_t GetScopeCount() const { return static_cast<uint32_t>(scopes_.size()); }
+  [[nodiscard]] uint32_t GetOpenScopeCount() const { return static_cast<uint32_t>(open_scopes_.size()); }
+
+  /// Number of query slots used so far. Query indices are always in `[0, GetQueryCount())`.
+  [[nodiscard]] uint32_t GetQueryCount() const { return query_count_; }
+  [[nodiscard]] uint32_t GetQueryCapacity() const { return query_capacity_; }
+
+  /// Builds the timing tree from the resolved query values.
+  ///
+  /// - `timestamps`: One raw tick value per query slot, `GetQueryCount()` entries.
+  /// - `nanoseconds_per_tick`: Tick period of the timestamps.
+  ///
+  /// Scopes without queries of their own are given the extent of their valid children.
+  [[nodiscard]] mnexus::GpuTimingReport BuildReport(
+    mnexus::IntraQueueSubmissionId submission_id,
+    mbase::ArrayProxy<uint64_t const> timestamps,
+    double nanoseconds_per_tick
+  ) const;
+
+private:
+  uint32_t query_capacity_ = 0;
+  uint32_t query_count_ = 0;
+  bool capacity_exhausted_logged_ = false;
+  std::vector<Scope> scopes_;
+  std::vector<uint32_t> open_scopes_;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// GpuTimingReportCache
+//
+// Retains the reports of the most recently resolved submissions of all queues, up to a fixed capacity. Thread-safe.
+//
+
+class GpuTimingReportCache final {
+public:
+  static constexpr uint32_t kDefaultCapacity = 64;
+
+  explicit GpuTimingReportCache(uint32_t capacity = kDefaultCapacity) : capacity_(capacity) {}
+  ~GpuTimingReportCache() = default;
+  MBASE_DISALLOW_COPY_MOVE(GpuTimingReportCache);
+
+  /// Inserts a report, evicting the oldest one when the capacity is reached.
+  void Insert(mnexus::QueueId const& queue_id, mnexus::GpuTimingReport report) MBASE_EXCLUDES(mutex_);
+
+  /// Copies the report of the given submission into `out_report`. Returns false if it is not retained.
+  [[nodiscard]] bool Find(
+    mnexus::QueueId const& queue_id,
+    mnexus::IntraQueueSubmissionId submission_id,
+    mnexus::GpuTimingReport& out_report
+  ) const MBASE_EXCLUDES(mutex_);
+
+  void Clear() MBASE_EXCLUDES(mutex_);
+
+private:
+  struct Entry final {
+    mnexus::QueueId queue_id;
+    mnexus::GpuTimingReport report;
+  };
+
+  uint32_t capacity_ = 0;
+  mutable mbase::Lockable<std::mutex> mutex_;
+  std::deque<Entry> entries_ MBASE_GUARDED_BY(mutex_);
+};
+
+} // namespace mnexus_backend::profiling
@@ -0,0 +1,83 @@
+// TU header --------------------------------------------
+#include "profiling/memory_tracker.h"
+
+// c++ headers ------------------------------------------
+#include <algorithm>
+
+namespace mnexus_backend::profiling {
+
+uint64_t EstimateTextureSizeInBytes(mnexus::TextureDesc const& desc) {
+  uint64_t const block_size = MnGetFormatSizeInBytes(static_cast<MnFormat>(desc.format));
+  MnExtent3d const block_extent = MnGetFormatTexelBlockExtent(static_cast<MnFormat>(desc.format));
+
+  uint64_t size_in_bytes = 0;
+  for (uint32_t mip_level = 0; mip_level < desc.mip_level_count; ++mip_level) {
+    uint64_t const width = std::max(desc.width >> mip_level, 1u);
+    uint64_t const height = std::max(desc.height >> mip_level, 1u);
+    uint64_t const depth = desc.dimension == mnexus::TextureDimension::k3D ? std::max(desc.depth >> mip_level, 1u) : 1;
+
+    uint64_t const blocks_x = (width + block_extent.width - 1) / block_extent.width;
+    uint64_t const blocks_y = (height + block_extent.height - 1) / block_extent.height;
+    size_in_bytes += blocks_x * blocks_y * depth * block_size;
+  }
+  return size_in_bytes * desc.array_layer_count;
+}
+
+// ----------------------------------------------------------------------------------------------------
+// MemoryTracker
+//
+
+void MemoryTracker::OnCreated(MemoryResourceType type, uint64_t size_in_bytes) {
+  Counter& counter = counters_[static_cast<uint32_t>(type)];
+  counter.count.fetch_add(1, std::memory_order_relaxed);
+  counter.size_in_bytes.fetch_add(size_in_bytes, std::memory_order_relaxed);
+
+  uint64_t const old_total = total_size_in_bytes_.fetch_add(size_in_bytes, std::memory_order_relaxed);
+  uint64_t const new_total = old_total + size_in_bytes;
+
+  MnMemoryThresholdCallback callback = nullptr;
+  void* user_data = nullptr;
+  {
+    mbase::LockGuard lock(threshold_mutex_);
+    if (threshold_callback_ == nullptr || threshold_in_bytes_ == 0) {
+      return;
+    }
+    if (old_total >= threshold_in_bytes_ || new_total < threshold_in_bytes_) {
+      return;
+    }
+    callback = threshold_callback_;
+    user_data = threshold_user_data_;
+  }
+
+  // Outside the lock, so the callback may query stats or release resources.
+  callback(new_total, user_data);
+}
+
+void MemoryTracker::OnDestroyed(MemoryResourceType type, uint64_t size_in_bytes) {
+  Counter& counter = counters_[static_cast<uint32_t>(type)];
+  counter.count.fetch_sub(1, std::memory_order_relaxed);
+  counter.size_in_bytes.fetch_sub(size_in_bytes, std::memory_order_relaxed);
+  total_size_in_bytes_.fetch_sub(size_in_bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::SetThresholdCallback(uint64_t threshold_in_bytes, MnMemoryThresholdCallback callback, void* user_data) {
+  mbase::LockGuard lock(threshold_mutex_);
+  threshold_in_bytes_ = threshold_in_bytes;
+  threshold_callback_ = callback;
+  threshold_user_data_ = user_data;
+}
+
+void MemoryTracker::FillResourceStats(mnexus::MemoryStats& out_stats) const {
+  auto load = [this](MemoryResourceType type) {
+    Counter const& counter = counters_[static_cast<uint32_t>(type)];
+    return mnexus::ResourceMemoryStats {
+      .count = counter.count.load(std::memory_order_relaxed),
+      .size_in_bytes = counter.size_in_bytes.load(std::memory_order_relaxed),
+    };
+  };
+
+  out_stats.buffers = load(MemoryResourceType::kBuffer);
+  out_stats.textures = load(MemoryResourceType::kTexture);
+}
+
+} // namespace mnexus_backend::profiling
@@ -0,0 +1,67 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/tsa.h"
+
+#include "mnexus/public/memory_stats.h"
+#include "mnexus/public/mnexus.h"
+
+namespace mnexus_backend::profiling {
+
+enum class MemoryResourceType : uint32_t {
+  kBuffer,
+  kTexture,
+
+  kCount,
+};
+
+/// Requested size of a texture with all its mips and layers, before native alignment and padding.
+[[nodiscard]] uint64_t EstimateTextureSizeInBytes(mnexus::TextureDesc const& desc);
+
+// ----------------------------------------------------------------------------------------------------
+// MemoryTracker
+//
+// CPU-side accounting of live resources, per type, for `IDevice::GetMemoryStats`. Devices report each resource
+// they create and destroy; the sum is checked against the threshold of `IDevice::SetMemoryThresholdCallback`.
+//
+
+class MemoryTracker final {
+public:
+  MemoryTracker() = default;
+  ~MemoryTracker() = default;
+  MBASE_DISALLOW_COPY_MOVE(MemoryTracker);
+
+  /// Invokes the threshold callback, on the calling thread, if the total crosses the threshold upwards.
+  void OnCreated(MemoryResourceType type, uint64_t size_in_bytes);
+  void OnDestroyed(MemoryResourceType type, uint64_t size_in_bytes);
+
+  /// `callback` null or `threshold_in_bytes` 0 disables the callback.
+  void SetThresholdCallback(uint64_t threshold_in_bytes, MnMemoryThresholdCallback callback, void* user_data);
+
+  /// Fills the per-type totals of `out_stats`; heaps are left to the backend.
+  void FillResourceStats(mnexus::MemoryStats& out_stats) const;
+
+private:
+  struct Counter final {
+    std::atomic<uint64_t> count = 0;
+    std::atomic<uint64_t> size_in_bytes = 0;
+  };
+
+  std::array<Counter, static_cast<uint32_t>(MemoryResourceType::kCount)> counters_ {};
+  std::atomic<uint64_t> total_size_in_bytes_ = 0;
+
+  mbase::Lockable<std::mutex> threshold_mutex_;
+  uint64_t threshold_in_bytes_ MBASE_GUARDED_BY(threshold_mutex_) = 0;
+  MnMemoryThresholdCallback threshold_callback_ MBASE_GUARDED_BY(threshold_mutex_) = nullptr;
+  void* threshold_user_data_ MBASE_GUARDED_BY(threshold_mutex_) = nullptr;
+};
+
+} // namespace mnexus_backend::profiling
@@ -0,0 +1,121 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+
+#include "mnexus/public/perf_counters.h"
+
+namespace mnexus_backend::profiling {
+
+enum class PerfCounter : uint32_t {
+  kDraws,
+  kDispatches,
+  kPipelineSwitches,
+  kPipelineCacheHits,
+  kPipelineCacheMisses,
+  kBindGroupCreations,
+  kDescriptorSetAllocations,
+  kBarriersEmitted,
+  kResourcePoolLookups,
+  kStagingBytesUploaded,
+  kSubmits,
+
+  kCount,
+};
+
+constexpr uint32_t kPerfCounterCount = static_cast<uint32_t>(PerfCounter::kCount);
+
+using PerfCounterValues = std::array<uint64_t, kPerfCounterCount>;
+
+[[nodiscard]] inline mnexus::PerfCountersSnapshot MakePerfCountersSnapshot(PerfCounterValues const& values) {
+  auto v = [&values](PerfCounter counter) { return values[static_cast<uint32_t>(counter)]; };
+
+  return mnexus::PerfCountersSnapshot {
+    .draw_count                 = v(PerfCounter::kDraws),
+    .dispatch_count             = v(PerfCounter::kDispatches),
+    .pipeline_switch_count      = v(PerfCounter::kPipelineSwitches),
+    .pipeline_cache_hits        = v(PerfCounter::kPipelineCacheHits),
+    .pipeline_cache_misses      = v(PerfCounter::kPipelineCacheMisses),
+    .bind_group_creations       = v(PerfCounter::kBindGroupCreations),
+    .descriptor_set_allocations = v(PerfCounter::kDescriptorSetAllocations),
+    .barriers_emitted           = v(PerfCounter::kBarriersEmitted),
+    .resource_pool_lookups      = v(PerfCounter::kResourcePoolLookups),
+    .staging_bytes_uploaded     = v(PerfCounter::kStagingBytesUploaded),
+    .submit_count               = v(PerfCounter::kSubmits),
+  };
+}
+
+// ----------------------------------------------------------------------------------------------------
+// CommandListPerfCounters
+//
+// Counters of a single command list. Command lists are thread-affine, so plain integers suffice; the values are
+// folded into the device's `DevicePerfCounters` when the command list is submitted or discarded.
+//
+
+class CommandListPerfCounters final {
+public:
+  CommandListPerfCounters() = default;
+
+  void Add(PerfCounter counter, uint64_t value = 1) {
+    values_[static_cast<uint32_t>(counter)] += value;
+  }
+
+  [[nodiscard]] PerfCounterValues const& values() const { return values_; }
+
+  [[nodiscard]] mnexus::PerfCountersSnapshot Snapshot() const { return MakePerfCountersSnapshot(values_); }
+
+private:
+  PerfCounterValues values_ {};
+};
+
+// ----------------------------------------------------------------------------------------------------
+// DevicePerfCounters
+//
+// Device-wide aggregate. Updated concurrently from any thread with relaxed atomics; a snapshot is therefore not a
+// consistent cut across counters, which is acceptable for diagnostics.
+//
+
+class DevicePerfCounters final {
+public:
+  DevicePerfCounters() = default;
+  ~DevicePerfCounters() = default;
+  MBASE_DISALLOW_COPY_MOVE(DevicePerfCounters);
+
+  void Add(PerfCounter counter, uint64_t value = 1) {
+    values_[static_cast<uint32_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  void Accumulate(CommandListPerfCounters const& command_list_counters) {
+    PerfCounterValues const& values = command_list_counters.values();
+    for (uint32_t i = 0; i < kPerfCounterCount; ++i) {
+      if (values[i] != 0) {
+        values_[i].fetch_add(values[i], std::memory_order_relaxed);
+      }
+    }
+  }
+
+  [[nodiscard]] PerfCounterValues Load() const {
+    PerfCounterValues values {};
+    for (uint32_t i = 0; i < kPerfCounterCount; ++i) {
+      values[i] = values_[i].load(std::memory_order_relaxed);
+    }
+    return values;
+  }
+
+  void Reset() {
+    for (auto& value : values_) {
+      value.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  std::array<std::atomic<uint64_t>, kPerfCounterCount> values_ {};
+};
+
+} // namespace mnexus_backend::profiling
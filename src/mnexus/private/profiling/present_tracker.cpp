@@ -0,0 +1,65 @@
+// TU header --------------------------------------------
+#include "profiling/present_tracker.h"
+
+// c++ headers ------------------------------------------
+#include <algorithm>
+
+namespace mnexus_backend::profiling {
+
+namespace {
+
+uint64_t ToNanoseconds(PresentTracker::Clock::duration duration) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+} // namespace
+
+void PresentTracker::OnPrologueBegin() {
+  Clock::time_point const now = Clock::now();
+
+  mbase::LockGuard lock(mutex_);
+  prologue_begin_ = now;
+  if (!frame_begin_.has_value()) {
+    frame_begin_ = now;
+  }
+}
+
+void PresentTracker::OnPrologueEnd() {
+  Clock::time_point const now = Clock::now();
+
+  mbase::LockGuard lock(mutex_);
+  uint64_t const stall_time_ns = ToNanoseconds(now - prologue_begin_);
+  stats_.last_stall_time_ns = stall_time_ns;
+  stats_.max_stall_time_ns = std::max(stats_.max_stall_time_ns, stall_time_ns);
+  stats_.total_stall_time_ns += stall_time_ns;
+}
+
+void PresentTracker::OnPresented(uint32_t queue_depth) {
+  Clock::time_point const now = Clock::now();
+
+  mbase::LockGuard lock(mutex_);
+  // Without a previous frame (reset since the prologue), the frame is measured from its prologue.
+  uint64_t const frame_time_ns = ToNanoseconds(now - frame_begin_.value_or(prologue_begin_));
+  frame_begin_ = now;
+
+  ++stats_.frame_count;
+  stats_.last_cpu_frame_time_ns = frame_time_ns;
+  stats_.max_cpu_frame_time_ns = std::max(stats_.max_cpu_frame_time_ns, frame_time_ns);
+  stats_.total_cpu_frame_time_ns += frame_time_ns;
+
+  stats_.last_queue_depth = queue_depth;
+  stats_.max_queue_depth = std::max(stats_.max_queue_depth, queue_depth);
+}
+
+mnexus::PresentStats PresentTracker::GetStats() const {
+  mbase::LockGuard lock(mutex_);
+  return stats_;
+}
+
+void PresentTracker::Reset() {
+  mbase::LockGuard lock(mutex_);
+  stats_ = mnexus::PresentStats {};
+  frame_begin_ = std::nullopt;
+}
+
+} // namespace mnexus_backend::profiling
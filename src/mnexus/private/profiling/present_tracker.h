@@ -0,0 +1,49 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/tsa.h"
+
+#include "mnexus/public/present_stats.h"
+
+namespace mnexus_backend::profiling {
+
+// ----------------------------------------------------------------------------------------------------
+// PresentTracker
+//
+// Frame pacing measured around `INexus::OnPresentPrologue` and `INexus::OnPresentEpilogue`, for
+// `INexus::GetPresentStats`. Independent of the backend and of whether the swapchain is real or offscreen.
+//
+
+class PresentTracker final {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  PresentTracker() = default;
+  ~PresentTracker() = default;
+  MBASE_DISALLOW_COPY_MOVE(PresentTracker);
+
+  void OnPrologueBegin();
+  void OnPrologueEnd();
+  /// `queue_depth`: presented images still queued, as reported by the backend.
+  void OnPresented(uint32_t queue_depth);
+
+  [[nodiscard]] mnexus::PresentStats GetStats() const;
+  void Reset();
+
+private:
+  mbase::Lockable<std::mutex> mutable mutex_;
+  mnexus::PresentStats stats_ MBASE_GUARDED_BY(mutex_);
+  Clock::time_point prologue_begin_ MBASE_GUARDED_BY(mutex_);
+  /// End of the previous frame; unset until the first prologue after creation or a reset.
+  std::optional<Clock::time_point> frame_begin_ MBASE_GUARDED_BY(mutex_);
+};
+
+} // namespace mnexus_backend::profiling
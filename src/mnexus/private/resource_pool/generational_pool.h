@@ -2,9 +2,14 @@
 
 // c++ headers ------------------------------------------
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 
-#include <optional>
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <new>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -34,6 +39,11 @@ struct GenerationalHandle {
     };
   }
 
+  /// Generation that follows `generation`; wraps from `kMaxGeneration` back to 1, so 0 is never issued.
+  static constexpr uint32_t NextGeneration(uint32_t generation) {
+    return generation >= kMaxGeneration ? 1u : generation + 1u;
+  }
+
   constexpr static GenerationalHandle FromU64(uint64_t v) { return GenerationalHandle { v }; }
   constexpr bool IsNull() const { return index() == 0xFFFFFFFFu; }
   constexpr uint64_t AsU64() const { return value_; }
@@ -45,6 +55,19 @@ struct GenerationalHandle {
 static_assert(sizeof(GenerationalHandle) == sizeof(uint64_t));
 static_assert(GenerationalHandle::Null().AsU64() == 0x00000000FFFFFFFFull);
 
+// Memory held by a pool. Diagnostics only.
+struct PoolMemoryUsage {
+  uint32_t slot_count = 0;
+  uint32_t live_count = 0;
+  /// Slot storage, generations, occupancy bitmap and freelist, at their allocated capacity.
+  size_t allocated_bytes = 0;
+};
+
+// Hot and Cold live in raw, separately allocated slot arrays; only live slots hold constructed objects.
+//
+// `gen_` is the single source of truth for handle validation: a dead slot carries `kDeadBit` on top of its next
+// generation, so `IsAlive` is one bounds check and one compare. `occupancy_` mirrors liveness one bit per slot, so
+// `ForEachAlive` and `Clear` skip 64 dead slots at a time.
 template <class HotT, class ColdT, uint8_t ResourceType = 0>
 class GenerationalPool {
 public:
@@ -54,12 +77,13 @@ public:
   using Cold = ColdT;
 
   GenerationalPool() = default;
-  MBASE_DISALLOW_COPY_DEFAULT_MOVE(GenerationalPool);
+  ~GenerationalPool() { this->DestroyLive(); }
+  MBASE_DISALLOW_COPY_MOVE(GenerationalPool);
 
   void Reserve(uint32_t slot_capacity) {
-    hot_.reserve(slot_capacity);
-    cold_.reserve(slot_capacity);
-    gen_.reserve(slot_capacity);
+    if (slot_capacity > capacity_) {
+      this->Reallocate(slot_capacity);
+    }
     freelist_.reserve(slot_capacity);
   }
 
@@ -67,6 +91,17 @@ public:
 
   uint32_t GetLiveCount() const { return live_count_; }
 
+  PoolMemoryUsage GetMemoryUsage() const {
+    return PoolMemoryUsage {
+      .slot_count = this->GetSlotCount(),
+      .live_count = live_count_,
+      .allocated_bytes = size_t(capacity_) * (sizeof(HotStorage) + sizeof(ColdStorage))
+        + gen_.capacity() * sizeof(uint32_t)
+        + occupancy_.capacity() * sizeof(uint64_t)
+        + freelist_.capacity() * sizeof(uint32_t),
+    };
+  }
+
   // In-place construct Hot and Cold.
   template <class... HotArgs, class... ColdArgs>
   Handle Emplace(std::piecewise_construct_t,
@@ -74,109 +109,164 @@ public:
                  std::tuple<ColdArgs...> cold_args) {
     uint32_t idx = this->AllocateSlot();
 
-    hot_[idx].emplace(std::make_from_tuple<Hot>(std::move(hot_args)));
-    cold_[idx].emplace(std::make_from_tuple<Cold>(std::move(cold_args)));
+    ::new (static_cast<void*>(hot_[idx].bytes)) Hot(std::make_from_tuple<Hot>(std::move(hot_args)));
+    ::new (static_cast<void*>(cold_[idx].bytes)) Cold(std::make_from_tuple<Cold>(std::move(cold_args)));
 
-    ++live_count_;
-    return Handle::Make(idx, gen_[idx], ResourceType);
+    return this->MarkAlive(idx);
   }
 
   Handle Insert(Hot hot, Cold cold) {
     uint32_t idx = this->AllocateSlot();
-    hot_[idx]  = std::move(hot);
-    cold_[idx] = std::move(cold);
-    ++live_count_;
-    return Handle::Make(idx, gen_[idx], ResourceType);
+
+    ::new (static_cast<void*>(hot_[idx].bytes)) Hot(std::move(hot));
+    ::new (static_cast<void*>(cold_[idx].bytes)) Cold(std::move(cold));
+
+    return this->MarkAlive(idx);
   }
 
   bool Erase(Handle h) {
     if (!this->IsAlive(h)) return false;
 
     uint32_t idx = h.index();
-
-    // Destroy Hot/Cold entries.
-    hot_[idx].reset();
-    cold_[idx].reset();
-
-    // Advance generation to invalidate stale handles.
-    uint32_t g = gen_[idx] + 1u;
-    if (g == 0u || g > Handle::kMaxGeneration) g = 1u;
-    gen_[idx] = g;
-
+    this->DestroySlot(idx);
     freelist_.emplace_back(idx);
     --live_count_;
     return true;
   }
 
   bool IsAlive(Handle h) const {
-    if (h.IsNull()) return false;
-    if (h.index() >= gen_.size()) return false;
-    if (gen_[h.index()] != h.generation()) return false;
-    // Treat as dead if either Hot or Cold is missing.
-    return hot_[h.index()].has_value() && cold_[h.index()].has_value();
+    // The null handle's index is never in range. Dead slots never match: `kDeadBit` is outside the generation bits.
+    return h.index() < gen_.size() && gen_[h.index()] == h.generation();
   }
 
   Hot* HotPtr(Handle h) {
     if (!this->IsAlive(h)) return nullptr;
-    return &*hot_[h.index()];
+    return this->HotAt(h.index());
   }
   Cold* ColdPtr(Handle h) {
     if (!this->IsAlive(h)) return nullptr;
-    return &*cold_[h.index()];
+    return this->ColdAt(h.index());
   }
   Hot const* HotPtr(Handle h) const {
     if (!this->IsAlive(h)) return nullptr;
-    return &*hot_[h.index()];
+    return this->HotAt(h.index());
   }
   Cold const* ColdPtr(Handle h) const {
     if (!this->IsAlive(h)) return nullptr;
-    return &*cold_[h.index()];
+    return this->ColdAt(h.index());
   }
 
   Hot& HotRef(Handle h) {
     MBASE_ASSERT(this->IsAlive(h));
-    return *hot_[h.index()];
+    return *this->HotAt(h.index());
   }
   Cold& ColdRef(Handle h) {
     MBASE_ASSERT(this->IsAlive(h));
-    return *cold_[h.index()];
+    return *this->ColdAt(h.index());
   }
   Hot const& HotRef(Handle h) const {
     MBASE_ASSERT(this->IsAlive(h));
-    return *hot_[h.index()];
+    return *this->HotAt(h.index());
   }
   Cold const& ColdRef(Handle h) const {
     MBASE_ASSERT(this->IsAlive(h));
-    return *cold_[h.index()];
+    return *this->ColdAt(h.index());
   }
 
   // Destroy live entries.
   void Clear() {
-    for (uint32_t i = 0; i < gen_.size(); ++i) {
-      if (hot_[i].has_value()) {
-        hot_[i].reset();
-        cold_[i].reset();
-        uint32_t g = gen_[i] + 1u;
-        if (g == 0u || g > Handle::kMaxGeneration) g = 1u;
-        gen_[i] = g;
-        freelist_.emplace_back(i);
-      }
-    }
+    this->ForEachLiveIndex([this](uint32_t i) {
+      this->DestroySlot(i);
+      freelist_.emplace_back(i);
+    });
     live_count_ = 0;
   }
 
-  // O(slot_count)
+  // O(slot_count / 64 + live_count). `f` **MUST NOT** emplace into the pool.
   template <class F>
   void ForEachAlive(F&& f) {
-    for (uint32_t i = 0; i < gen_.size(); ++i) {
-      if (!hot_[i].has_value()) continue;
+    this->ForEachLiveIndex([this, &f](uint32_t i) {
       // Generate `Handle` on-the-fly.
       Handle h = Handle::Make(i, gen_[i], ResourceType);
-      f(h, *hot_[i], *cold_[i]);
-    }
+      f(h, *this->HotAt(i), *this->ColdAt(i));
+    });
   }
 
 private:
+  static constexpr uint32_t kDeadBit = 0x80000000u;
+  static_assert((Handle::kMaxGeneration & kDeadBit) == 0);
+
+  static constexpr uint32_t kMinCapacity = 16;
+
+  template <class T>
+  struct alignas(T) Storage {
+    std::byte bytes[sizeof(T)];
+  };
+  using HotStorage  = Storage<Hot>;
+  using ColdStorage = Storage<Cold>;
+
+  Hot* HotAt(uint32_t i) { return std::launder(reinterpret_cast<Hot*>(hot_[i].bytes)); }
+  Cold* ColdAt(uint32_t i) { return std::launder(reinterpret_cast<Cold*>(cold_[i].bytes)); }
+  Hot const* HotAt(uint32_t i) const { return std::launder(reinterpret_cast<Hot const*>(hot_[i].bytes)); }
+  Cold const* ColdAt(uint32_t i) const { return std::launder(reinterpret_cast<Cold const*>(cold_[i].bytes)); }
+
+  // Visits set bits of `occupancy_` in ascending order. The current word is copied, so `f` may clear its own bit.
+  template <class F>
+  void ForEachLiveIndex(F&& f) {
+    for (size_t word_index = 0; word_index < occupancy_.size(); ++word_index) {
+      uint64_t bits = occupancy_[word_index];
+      while (bits != 0) {
+        uint32_t const i = static_cast<uint32_t>(word_index * 64 + std::countr_zero(bits));
+        bits &= bits - 1;
+        f(i);
+      }
+    }
+  }
+
+  Handle MarkAlive(uint32_t idx) {
+    gen_[idx] &= ~kDeadBit;
+    occupancy_[idx / 64] |= uint64_t(1) << (idx % 64);
+    ++live_count_;
+    return Handle::Make(idx, gen_[idx], ResourceType);
+  }
+
+  // Destroys Hot/Cold and advances the generation to invalidate stale handles. Does not touch the freelist.
+  void DestroySlot(uint32_t idx) {
+    std::destroy_at(this->HotAt(idx));
+    std::destroy_at(this->ColdAt(idx));
+
+    gen_[idx] = Handle::NextGeneration(gen_[idx]) | kDeadBit;
+
+    occupancy_[idx / 64] &= ~(uint64_t(1) << (idx % 64));
+  }
+
+  void DestroyLive() {
+    this->ForEachLiveIndex([this](uint32_t i) {
+      std::destroy_at(this->HotAt(i));
+      std::destroy_at(this->ColdAt(i));
+    });
+  }
+
+  // Moves the live entries into storage for `new_capacity` slots.
+  void Reallocate(uint32_t new_capacity) {
+    std::unique_ptr<HotStorage[]> new_hot = std::make_unique_for_overwrite<HotStorage[]>(new_capacity);
+    std::unique_ptr<ColdStorage[]> new_cold = std::make_unique_for_overwrite<ColdStorage[]>(new_capacity);
+
+    this->ForEachLiveIndex([&](uint32_t i) {
+      ::new (static_cast<void*>(new_hot[i].bytes)) Hot(std::move(*this->HotAt(i)));
+      ::new (static_cast<void*>(new_cold[i].bytes)) Cold(std::move(*this->ColdAt(i)));
+      std::destroy_at(this->HotAt(i));
+      std::destroy_at(this->ColdAt(i));
+    });
+
+    hot_ = std::move(new_hot);
+    cold_ = std::move(new_cold);
+    capacity_ = new_capacity;
+
+    gen_.reserve(new_capacity);
+    occupancy_.reserve((new_capacity + 63) / 64);
+  }
+
   uint32_t AllocateSlot() {
     if (!freelist_.empty()) {
       uint32_t idx = freelist_.back();
@@ -186,15 +276,21 @@ private:
 
     // Add a new slot
     uint32_t idx = static_cast<uint32_t>(gen_.size());
-    gen_.emplace_back(1u);               // generation starts from 1
-    hot_.emplace_back(std::nullopt);
-    cold_.emplace_back(std::nullopt);
+    if (idx == capacity_) {
+      this->Reallocate(std::max(kMinCapacity, capacity_ * 2));
+    }
+    gen_.emplace_back(1u | kDeadBit);    // generation starts from 1
+    if (idx % 64 == 0) {
+      occupancy_.emplace_back(0);
+    }
     return idx;
   }
 
-  std::vector<std::optional<Hot>>  hot_;
-  std::vector<std::optional<Cold>> cold_;
+  std::unique_ptr<HotStorage[]>  hot_;
+  std::unique_ptr<ColdStorage[]> cold_;
+  uint32_t capacity_ = 0;
   std::vector<uint32_t> gen_;
+  std::vector<uint64_t> occupancy_;
   std::vector<uint32_t> freelist_;
   uint32_t live_count_ = 0;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 // c++ headers ------------------------------------------
+#include <atomic>
 #include <tuple>
 #include <shared_mutex>
 
@@ -46,6 +47,7 @@ public:
   std::pair<THot const&, SharedLockGuardType> GetHotConstRefWithSharedLockGuard(
     GenerationalHandle handle
   ) const MBASE_EXCLUDES(mutex_) MBASE_NO_THREAD_SAFETY_ANALYSIS {
+    this->CountLookup();
     mbase::SharedLockGuard lock(mutex_);
     THot const& hot_ref = inner_.HotRef(handle);
     return { hot_ref, std::move(lock) };
@@ -53,6 +55,7 @@ public:
   std::pair<THot&, SharedLockGuardType> GetHotRefWithSharedLockGuard(
     GenerationalHandle handle
   ) MBASE_EXCLUDES(mutex_) MBASE_NO_THREAD_SAFETY_ANALYSIS {
+    this->CountLookup();
     mbase::SharedLockGuard lock(mutex_);
     THot& hot_ref = inner_.HotRef(handle);
     return { hot_ref, std::move(lock) };
@@ -61,6 +64,7 @@ public:
   std::tuple<THot const&, TCold const&, SharedLockGuardType> GetConstRefWithSharedLockGuard(
     GenerationalHandle handle
   ) const MBASE_EXCLUDES(mutex_) MBASE_NO_THREAD_SAFETY_ANALYSIS {
+    this->CountLookup();
     mbase::SharedLockGuard lock(mutex_);
     THot const&  hot_ref  = inner_.HotRef(handle);
     TCold const& cold_ref = inner_.ColdRef(handle);
@@ -69,6 +73,7 @@ public:
   std::tuple<THot&, TCold&, SharedLockGuardType> GetRefWithSharedLockGuard(
     GenerationalHandle handle
   ) MBASE_EXCLUDES(mutex_) MBASE_NO_THREAD_SAFETY_ANALYSIS {
+    this->CountLookup();
     mbase::SharedLockGuard lock(mutex_);
     THot&  hot_ref  = inner_.HotRef(handle);
     TCold& cold_ref = inner_.ColdRef(handle);
@@ -76,6 +81,7 @@ public:
   }
 
   std::pair<THot const&, TCold const&> LockSharedAndGetConstRef(GenerationalHandle handle) const MBASE_ACQUIRE_SHARED(mutex_) {
+    this->CountLookup();
     mutex_.lock_shared();
     THot const&  hot_ref  = inner_.HotRef(handle);
     TCold const& cold_ref = inner_.ColdRef(handle);
@@ -83,6 +89,7 @@ public:
   }
 
   std::pair<THot&, TCold&> LockSharedAndGetRef(GenerationalHandle handle) MBASE_ACQUIRE_SHARED(mutex_) {
+    this->CountLookup();
     mutex_.lock_shared();
     THot&  hot_ref  = inner_.HotRef(handle);
     TCold& cold_ref = inner_.ColdRef(handle);
@@ -92,18 +99,21 @@ public:
   std::pair<TCold const&, SharedLockGuardType> GetColdConstRefWithSharedLockGuard(
     GenerationalHandle handle
   ) const MBASE_EXCLUDES(mutex_) MBASE_NO_THREAD_SAFETY_ANALYSIS {
+    this->CountLookup();
     mbase::SharedLockGuard lock(mutex_);
     TCold const& cold_ref = inner_.ColdRef(handle);
     return { cold_ref, std::move(lock) };
   }
 
   THot& LockSharedAndGetRefHot(GenerationalHandle handle) MBASE_ACQUIRE_SHARED(mutex_) {
+    this->CountLookup();
     mutex_.lock_shared();
     THot& hot_ref = inner_.HotRef(handle);
     return hot_ref;
   }
 
   TCold const& LockSharedAndGetConstRefCold(GenerationalHandle handle) const MBASE_ACQUIRE_SHARED(mutex_) {
+    this->CountLookup();
     mutex_.lock_shared();
     TCold const& cold_ref = inner_.ColdRef(handle);
     return cold_ref;
@@ -113,9 +123,22 @@ public:
     mutex_.unlock_shared();
   }
 
+  /// Number of handle lookups performed through this pool. Diagnostics only.
+  uint64_t GetLookupCount() const { return lookup_count_.load(std::memory_order_relaxed); }
+  void ResetLookupCount() { lookup_count_.store(0, std::memory_order_relaxed); }
+
+  /// Slot and byte counts of the underlying storage. Diagnostics only.
+  PoolMemoryUsage GetMemoryUsage() const MBASE_EXCLUDES(mutex_) {
+    mbase::SharedLockGuard lock(mutex_);
+    return inner_.GetMemoryUsage();
+  }
+
 private:
+  void CountLookup() const { lookup_count_.fetch_add(1, std::memory_order_relaxed); }
+
   mbase::SharedLockable<std::shared_mutex> mutable mutex_;
   resource_pool::GenerationalPool<THot, TCold, ResourceType> inner_;
+  std::atomic<uint64_t> mutable lookup_count_ = 0;
 };
 
 } // namespace resource_pool
@@ -0,0 +1,146 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <atomic>
+#include <shared_mutex>
+#include <unordered_map>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/assert.h"
+#include "mbase/public/tsa.h"
+
+#include "mnexus/public/sampler_cache_snapshot.h"
+#include "mnexus/public/types.h"
+
+// project headers --------------------------------------
+#include "resource_pool/resource_generational_pool.h"
+
+namespace resource_pool {
+
+// ----------------------------------------------------------------------------------------------------
+// SamplerCache
+//
+// Deduplicates samplers by `SamplerDesc`. Identical descriptors resolve to the same pool handle, and therefore the
+// same backend sampler; each `Acquire` adds a reference and each `Release` drops one. The backend destroys the
+// sampler when `Release` reports that the last reference is gone.
+//
+
+class SamplerCache final {
+public:
+  SamplerCache() = default;
+  ~SamplerCache() = default;
+  MBASE_DISALLOW_COPY_MOVE(SamplerCache);
+
+  /// Returns the handle cached for `desc`, adding a reference. On miss, calls `factory()` to create the sampler.
+  /// A null handle from the factory is returned as is and not cached.
+  template<typename TFactory>
+  ResourceHandle Acquire(mnexus::SamplerDesc const& desc, TFactory&& factory) MBASE_EXCLUDES(mutex_) {
+    uint64_t const key = PackKey(desc);
+
+    // Fast path: shared lock; `Release` erases under the exclusive lock, so the entry can't go away here.
+    {
+      mbase::SharedLockGuard shared_lock(mutex_);
+      total_lookups_.fetch_add(1, std::memory_order_relaxed);
+      auto it = cache_.find(key);
+      if (it != cache_.end()) {
+        it->second.reference_count.fetch_add(1, std::memory_order_relaxed);
+        cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second.handle;
+      }
+    }
+
+    // Slow path: exclusive lock, double-check, then create.
+    mbase::LockGuard exclusive_lock(mutex_);
+    auto [it, inserted] = cache_.try_emplace(key);
+    if (!inserted) {
+      it->second.reference_count.fetch_add(1, std::memory_order_relaxed);
+      cache_hits_.fetch_add(1, std::memory_order_relaxed);
+      return it->second.handle;
+    }
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
+
+    ResourceHandle const handle = factory();
+    if (handle.IsNull()) {
+      cache_.erase(it);
+      return handle;
+    }
+    it->second.desc = desc;
+    it->second.handle = handle;
+    it->second.reference_count.store(1, std::memory_order_relaxed);
+    return handle;
+  }
+
+  /// Drops one reference to the sampler cached for `desc`. Returns true if it was the last one; the caller
+  /// **MUST** then destroy the sampler.
+  [[nodiscard]] bool Release(mnexus::SamplerDesc const& desc) MBASE_EXCLUDES(mutex_) {
+    mbase::LockGuard lock(mutex_);
+    auto it = cache_.find(PackKey(desc));
+    MBASE_ASSERT_MSG(it != cache_.end(), "Releasing a sampler that is not cached");
+
+    if (it->second.reference_count.fetch_sub(1, std::memory_order_relaxed) != 1) {
+      return false;
+    }
+    cache_.erase(it);
+    return true;
+  }
+
+  [[nodiscard]] mnexus::SamplerCacheSnapshot GetSnapshot() const MBASE_EXCLUDES(mutex_) {
+    mbase::SharedLockGuard lock(mutex_);
+
+    mnexus::SamplerCacheSnapshot snapshot;
+    snapshot.diagnostics = mnexus::SamplerCacheDiagnosticsSnapshot {
+      .total_lookups = total_lookups_.load(std::memory_order_relaxed),
+      .cache_hits = cache_hits_.load(std::memory_order_relaxed),
+      .cache_misses = cache_misses_.load(std::memory_order_relaxed),
+      .cached_sampler_count = static_cast<uint64_t>(cache_.size()),
+    };
+    snapshot.entries.reserve(cache_.size());
+    for (auto const& [key, entry] : cache_) {
+      snapshot.entries.push_back(
+        mnexus::SamplerCacheEntry {
+          .desc = entry.desc,
+          .handle = mnexus::SamplerHandle { entry.handle.AsU64() },
+          .reference_count = entry.reference_count.load(std::memory_order_relaxed),
+        }
+      );
+    }
+    return snapshot;
+  }
+
+private:
+  struct Entry final {
+    mnexus::SamplerDesc desc;
+    ResourceHandle handle = ResourceHandle::Null();
+    std::atomic<uint32_t> reference_count = 0;
+  };
+
+  /// Every `SamplerDesc` field is a small enum; one byte each makes the key exact.
+  static uint64_t PackKey(mnexus::SamplerDesc const& desc) {
+    static_assert(sizeof(mnexus::SamplerDesc) == 6 * sizeof(uint32_t), "Update PackKey() for new SamplerDesc fields");
+    auto const byte = [](auto value) {
+      uint32_t const v = static_cast<uint32_t>(value);
+      MBASE_ASSERT(v <= 0xFF);
+      return static_cast<uint64_t>(v);
+    };
+    return
+      (byte(desc.min_filter) << 0) |
+      (byte(desc.mag_filter) << 8) |
+      (byte(desc.mipmap_filter) << 16) |
+      (byte(desc.address_mode_u) << 24) |
+      (byte(desc.address_mode_v) << 32) |
+      (byte(desc.address_mode_w) << 40);
+  }
+
+  mutable mbase::SharedLockable<std::shared_mutex> mutex_;
+  std::unordered_map<uint64_t, Entry> cache_ MBASE_GUARDED_BY(mutex_);
+
+  // Diagnostics counters (atomic, lock-free update).
+  std::atomic<uint64_t> total_lookups_ = 0;
+  std::atomic<uint64_t> cache_hits_ = 0;
+  std::atomic<uint64_t> cache_misses_ = 0;
+};
+
+} // namespace resource_pool
@@ -37,6 +37,14 @@ static mnexus::BindGroupLayoutEntryType ConvertDescriptorType(SpvReflectDescript
   }
 }
 
+static mnexus::ShaderStageFlags ConvertShaderStage(SpvReflectShaderStageFlagBits stage) {
+  mnexus::ShaderStageFlags result = mnexus::ShaderStageFlagBits::kNone;
+  if (stage & SPV_REFLECT_SHADER_STAGE_VERTEX_BIT)   { result |= mnexus::ShaderStageFlagBits::kVertex; }
+  if (stage & SPV_REFLECT_SHADER_STAGE_FRAGMENT_BIT) { result |= mnexus::ShaderStageFlagBits::kFragment; }
+  if (stage & SPV_REFLECT_SHADER_STAGE_COMPUTE_BIT)  { result |= mnexus::ShaderStageFlagBits::kCompute; }
+  return result;
+}
+
 } // namespace
 
 ShaderModuleReflection::ShaderModuleReflection(SpvReflectShaderModule* copy_src) {
@@ -79,10 +87,39 @@ ShaderModuleReflection::ShaderModuleReflection(SpvReflectShaderModule* copy_src)
       return a.set < b.set;
     }
   );
+
+  // Populate push_constant_range_ from the members actually declared; a block may start past offset 0 when
+  // another module owns the bytes before it.
+  if (reflect_shader_module_->push_constant_block_count > 0) {
+    uint32_t begin = UINT32_MAX;
+    uint32_t end = 0;
+    for (uint32_t i = 0; i < reflect_shader_module_->push_constant_block_count; ++i) {
+      SpvReflectBlockVariable const& block = reflect_shader_module_->push_constant_blocks[i];
+      for (uint32_t j = 0; j < block.member_count; ++j) {
+        SpvReflectBlockVariable const& member = block.members[j];
+        begin = std::min(begin, member.offset);
+        end = std::max(end, member.offset + member.size);
+      }
+    }
+
+    mnexus::ShaderStageFlags stages = mnexus::ShaderStageFlagBits::kNone;
+    for (uint32_t i = 0; i < reflect_shader_module_->entry_point_count; ++i) {
+      stages |= ConvertShaderStage(reflect_shader_module_->entry_points[i].shader_stage);
+    }
+
+    if (begin < end) {
+      push_constant_range_ = PushConstantRange {
+        .stages = stages,
+        .offset = begin,
+        .size = end - begin,
+      };
+    }
+  }
 }
 
 ShaderModuleReflection::ShaderModuleReflection(ShaderModuleReflection&& other) noexcept
-    : bind_group_layouts_(std::move(other.bind_group_layouts_)) {
+    : bind_group_layouts_(std::move(other.bind_group_layouts_)),
+      push_constant_range_(other.push_constant_range_) {
   std::memcpy(reflect_shader_module_storage_, other.reflect_shader_module_storage_, sizeof(reflect_shader_module_storage_));
   reflect_shader_module_ = reinterpret_cast<SpvReflectShaderModule*>(reflect_shader_module_storage_);
   other.reflect_shader_module_ = nullptr;
@@ -94,6 +131,7 @@ ShaderModuleReflection& ShaderModuleReflection::operator=(ShaderModuleReflection
     reflect_shader_module_ = reinterpret_cast<SpvReflectShaderModule*>(reflect_shader_module_storage_);
     other.reflect_shader_module_ = nullptr;
     bind_group_layouts_ = std::move(other.bind_group_layouts_);
+    push_constant_range_ = other.push_constant_range_;
   }
   return *this;
 }
@@ -158,6 +196,22 @@ bool MergedPipelineLayout::Merge(ShaderModuleReflection const& reflection) {
     }
   }
 
+  // Merge the push constant range: one range spanning every module, visible to every declaring stage.
+  PushConstantRange const& src_range = reflection.GetPushConstantRange();
+  if (!src_range.IsEmpty()) {
+    if (push_constant_range_.IsEmpty()) {
+      push_constant_range_ = src_range;
+    } else {
+      uint32_t const begin = std::min(push_constant_range_.offset, src_range.offset);
+      uint32_t const end = std::max(push_constant_range_.end(), src_range.end());
+      push_constant_range_ = PushConstantRange {
+        .stages = push_constant_range_.stages | src_range.stages,
+        .offset = begin,
+        .size = end - begin,
+      };
+    }
+  }
+
   return true;
 }
 
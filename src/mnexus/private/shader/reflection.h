@@ -36,6 +36,26 @@ struct BindGroupLayout final {
   mbase::SmallVector<BindGroupLayoutEntry, 2> entries;
 };
 
+/// The byte range of a push constant block and the stages that declare it. `size == 0` means no push constants.
+struct PushConstantRange final {
+  mnexus::ShaderStageFlags stages = mnexus::ShaderStageFlagBits::kNone;
+  uint32_t offset = 0;
+  uint32_t size = 0;
+
+  [[nodiscard]] bool IsEmpty() const { return size == 0; }
+  [[nodiscard]] uint32_t end() const { return offset + size; }
+
+  /// Whether every stage in `other_stages` declares the block.
+  [[nodiscard]] bool CoversStages(mnexus::ShaderStageFlags other_stages) const {
+    for (mnexus::ShaderStageFlagBits bit : { mnexus::ShaderStageFlagBits::kVertex, mnexus::ShaderStageFlagBits::kFragment, mnexus::ShaderStageFlagBits::kCompute }) {
+      if (other_stages.HasAnyOf(bit) && !stages.HasAnyOf(bit)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
 class ShaderModuleReflection final {
 public:
   using SpvReflectShaderModuleStorage = std::byte[1216];
@@ -55,6 +75,11 @@ public:
     return bind_group_layouts_;
   }
 
+  /// The push constant block of the module, spanning all of its entry points.
+  PushConstantRange const& GetPushConstantRange() const {
+    return push_constant_range_;
+  }
+
 private:
   explicit ShaderModuleReflection(SpvReflectShaderModule* MBASE_NOT_NULL copy_src);
 
@@ -62,9 +87,13 @@ private:
   SpvReflectShaderModule* MBASE_NOT_NULL reflect_shader_module_ = nullptr;
 
   mbase::SmallVector<BindGroupLayout, 2> bind_group_layouts_;
+  PushConstantRange push_constant_range_;
 };
 
-/// Incrementally merges bind group layouts from multiple shader modules.
+/// Incrementally merges bind group layouts and push constant ranges from multiple shader modules.
+///
+/// Push constant ranges are merged into a single range covering all modules, visible to every stage that
+/// declares one.
 ///
 /// Usage:
 ///   MergedPipelineLayout merged;
@@ -81,9 +110,14 @@ public:
     return bind_group_layouts_;
   }
 
+  PushConstantRange const& GetPushConstantRange() const {
+    return push_constant_range_;
+  }
+
 private:
   /// `BindGroupLayout`s, sorted by `set`.
   mbase::SmallVector<BindGroupLayout, 4> bind_group_layouts_;
+  PushConstantRange push_constant_range_;
 };
 
 } // namespace shader
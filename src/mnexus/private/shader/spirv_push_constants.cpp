@@ -0,0 +1,140 @@
+// TU header --------------------------------------------
+#include "shader/spirv_push_constants.h"
+
+// public project headers -------------------------------
+#include "mbase/public/log.h"
+
+namespace shader {
+
+namespace {
+
+constexpr uint32_t kSpirvMagicNumber = 0x07230203;
+constexpr uint32_t kSpirvHeaderWordCount = 5;
+
+// Opcodes.
+constexpr uint32_t kOpTypePointer = 32;
+constexpr uint32_t kOpTypeForwardPointer = 39;
+constexpr uint32_t kOpVariable = 59;
+constexpr uint32_t kOpDecorate = 71;
+constexpr uint32_t kOpMemberDecorate = 72;
+constexpr uint32_t kOpDecorationGroup = 73;
+constexpr uint32_t kOpGroupDecorate = 74;
+constexpr uint32_t kOpGroupMemberDecorate = 75;
+constexpr uint32_t kOpDecorateId = 332;
+constexpr uint32_t kOpDecorateString = 5632;
+constexpr uint32_t kOpMemberDecorateString = 5633;
+
+// Storage classes.
+constexpr uint32_t kStorageClassUniform = 2;
+constexpr uint32_t kStorageClassPushConstant = 9;
+
+// Decorations.
+constexpr uint32_t kDecorationBinding = 33;
+constexpr uint32_t kDecorationDescriptorSet = 34;
+
+bool IsAnnotation(uint32_t opcode) {
+  switch (opcode) {
+  case kOpDecorate:
+  case kOpMemberDecorate:
+  case kOpDecorationGroup:
+  case kOpGroupDecorate:
+  case kOpGroupMemberDecorate:
+  case kOpDecorateId:
+  case kOpDecorateString:
+  case kOpMemberDecorateString:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/// Index of the storage class operand of a declaration, or 0 if the instruction has none.
+uint32_t GetStorageClassWordIndex(uint32_t opcode) {
+  switch (opcode) {
+  case kOpTypePointer:        return 2;
+  case kOpTypeForwardPointer: return 2;
+  case kOpVariable:           return 3;
+  default:                    return 0;
+  }
+}
+
+} // namespace
+
+std::optional<std::vector<uint32_t>> LowerPushConstantsToUniform(
+  uint32_t const* spirv,
+  uint32_t spirv_word_count,
+  uint32_t set,
+  uint32_t binding
+) {
+  if (spirv_word_count < kSpirvHeaderWordCount || spirv[0] != kSpirvMagicNumber) {
+    return std::nullopt;
+  }
+
+  // Pass 1: find the push constant variable and where the annotations start.
+  uint32_t push_constant_variable_id = 0;
+  uint32_t push_constant_variable_count = 0;
+  uint32_t first_annotation_word = 0;
+
+  for (uint32_t word = kSpirvHeaderWordCount; word < spirv_word_count;) {
+    uint32_t const opcode = spirv[word] & 0xFFFF;
+    uint32_t const instruction_word_count = spirv[word] >> 16;
+    if (instruction_word_count == 0 || word + instruction_word_count > spirv_word_count) {
+      MBASE_LOG_ERROR("Malformed SPIR-V instruction at word {}", word);
+      return std::nullopt;
+    }
+
+    if (IsAnnotation(opcode) && first_annotation_word == 0) {
+      first_annotation_word = word;
+    }
+    if (opcode == kOpVariable && instruction_word_count >= 4 && spirv[word + 3] == kStorageClassPushConstant) {
+      push_constant_variable_id = spirv[word + 2];
+      ++push_constant_variable_count;
+    }
+
+    word += instruction_word_count;
+  }
+
+  if (push_constant_variable_count == 0) {
+    return std::nullopt;
+  }
+  if (push_constant_variable_count > 1) {
+    MBASE_LOG_ERROR("SPIR-V module declares {} push constant variables; only one is supported", push_constant_variable_count);
+    return std::nullopt;
+  }
+  if (first_annotation_word == 0) {
+    // A push constant block always carries `Block` and `Offset` decorations.
+    MBASE_LOG_ERROR("SPIR-V push constant block has no decorations");
+    return std::nullopt;
+  }
+
+  // Pass 2: copy, switching the storage class and decorating the variable at the start of the annotations.
+  std::vector<uint32_t> result;
+  result.reserve(spirv_word_count + 8);
+  result.insert(result.end(), spirv, spirv + kSpirvHeaderWordCount);
+
+  for (uint32_t word = kSpirvHeaderWordCount; word < spirv_word_count;) {
+    uint32_t const opcode = spirv[word] & 0xFFFF;
+    uint32_t const instruction_word_count = spirv[word] >> 16;
+
+    if (word == first_annotation_word) {
+      uint32_t const decorate_header = (4u << 16) | kOpDecorate;
+      result.insert(result.end(), { decorate_header, push_constant_variable_id, kDecorationDescriptorSet, set });
+      result.insert(result.end(), { decorate_header, push_constant_variable_id, kDecorationBinding, binding });
+    }
+
+    size_t const instruction_begin = result.size();
+    result.insert(result.end(), spirv + word, spirv + word + instruction_word_count);
+
+    uint32_t const storage_class_index = GetStorageClassWordIndex(opcode);
+    if (storage_class_index != 0 && storage_class_index < instruction_word_count &&
+        result[instruction_begin + storage_class_index] == kStorageClassPushConstant) {
+      result[instruction_begin + storage_class_index] = kStorageClassUniform;
+    }
+
+    word += instruction_word_count;
+  }
+
+  return result;
+}
+
+} // namespace shader
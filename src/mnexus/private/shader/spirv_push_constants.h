@@ -0,0 +1,27 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <optional>
+#include <vector>
+
+namespace shader {
+
+/// Rewrites the push constant block of a SPIR-V module into a uniform buffer at (`set`, `binding`), for targets
+/// without native push constants.
+///
+/// Every `PushConstant` storage class on pointer types and variables becomes `Uniform`, and `DescriptorSet`/`Binding`
+/// decorations are added to the block variable. Member offsets are kept, so the uniform buffer holds the same bytes
+/// the push constant block would.
+///
+/// Returns `std::nullopt` if the module declares no push constants (the caller uses the module as is), or if it
+/// declares more than one push constant variable, which cannot share a single binding.
+std::optional<std::vector<uint32_t>> LowerPushConstantsToUniform(
+  uint32_t const* spirv,
+  uint32_t spirv_word_count,
+  uint32_t set,
+  uint32_t binding
+);
+
+} // namespace shader
@@ -0,0 +1,131 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <atomic>
+#include <cstdint>
+
+#include <memory>
+#include <mutex>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/assert.h"
+#include "mbase/public/tsa.h"
+
+namespace mnexus_backend {
+
+/// Intrusive hook of an object managed by a `ConcurrentSlab`; `T` **MUST** expose it as `slab_hook`.
+struct ConcurrentSlabHook final {
+  /// Slot index of the next free object while this one is free. Read by racing `Acquire` calls, hence atomic.
+  std::atomic<uint32_t> next_free {0};
+  /// Slot index of this object; fixed once its chunk is created.
+  uint32_t index = 0;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// ConcurrentSlab
+//
+// Hands out `T` objects from chunks that are only freed with the slab, recycling them through a lock-free free list
+// (Treiber stack). `Acquire` and `Release` are lock-free; only growing by a chunk takes a mutex.
+//
+// The stack head packs the top slot index with a tag that changes on every update, so a pop that raced with a pop
+// and re-push of the same slot fails its compare-exchange instead of corrupting the list. Slots are addressed by
+// index through a fixed table of chunk pointers, so a racing pop may read the hook of an object in use, but never
+// freed memory.
+//
+// Released objects are not reset; callers reset them before `Release`.
+//
+
+template<typename T, uint32_t kChunkSize = 256, uint32_t kMaxChunks = 16384>
+class ConcurrentSlab final {
+public:
+  ConcurrentSlab() = default;
+  ~ConcurrentSlab() {
+    uint32_t const chunk_count = chunk_count_.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < chunk_count; ++i) {
+      delete[] chunks_[i].load(std::memory_order_relaxed);
+    }
+  }
+  MBASE_DISALLOW_COPY_MOVE(ConcurrentSlab);
+
+  [[nodiscard]] T* Acquire() {
+    // acquire: pairs with the release in `PushList`, making the chunk and the popped slot's hook visible.
+    uint64_t head = head_.load(std::memory_order_acquire);
+    for (;;) {
+      uint32_t const index = IndexOf(head);
+      if (index == kNullIndex) {
+        this->Grow();
+        head = head_.load(std::memory_order_acquire);
+        continue;
+      }
+
+      T& object = this->ObjectAt(index);
+      uint32_t const next = object.slab_hook.next_free.load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, Pack(next, TagOf(head) + 1),
+                                      std::memory_order_acquire, std::memory_order_acquire)) {
+        return &object;
+      }
+    }
+  }
+
+  /// `object` **MUST** have been returned by `Acquire` of this slab and not released since.
+  void Release(T* object) {
+    this->PushList(object->slab_hook.index, *object);
+  }
+
+  /// Number of objects allocated so far, free or in use.
+  [[nodiscard]] uint32_t GetCapacity() const {
+    return chunk_count_.load(std::memory_order_relaxed) * kChunkSize;
+  }
+
+private:
+  static constexpr uint32_t kNullIndex = UINT32_MAX;
+  static_assert(uint64_t(kChunkSize) * kMaxChunks < kNullIndex);
+
+  static constexpr uint64_t Pack(uint32_t index, uint32_t tag) { return (uint64_t(tag) << 32) | index; }
+  static constexpr uint32_t IndexOf(uint64_t head) { return static_cast<uint32_t>(head); }
+  static constexpr uint32_t TagOf(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+
+  T& ObjectAt(uint32_t index) {
+    return chunks_[index / kChunkSize].load(std::memory_order_relaxed)[index % kChunkSize];
+  }
+
+  /// Pushes the already linked run of free objects `first_index` .. `last`.
+  void PushList(uint32_t first_index, T& last) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    do {
+      last.slab_hook.next_free.store(IndexOf(head), std::memory_order_relaxed);
+    } while (!head_.compare_exchange_weak(head, Pack(first_index, TagOf(head) + 1),
+                                          std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  void Grow() {
+    mbase::LockGuard lock(grow_mutex_);
+    if (IndexOf(head_.load(std::memory_order_acquire)) != kNullIndex) {
+      return; // Another thread grew the slab, or objects were released meanwhile.
+    }
+
+    uint32_t const chunk_index = chunk_count_.load(std::memory_order_relaxed);
+    MBASE_ASSERT_MSG(chunk_index < kMaxChunks, "ConcurrentSlab exhausted ({} objects)", kChunkSize * kMaxChunks);
+
+    T* chunk = new T[kChunkSize];
+    uint32_t const base = chunk_index * kChunkSize;
+    for (uint32_t i = 0; i < kChunkSize; ++i) {
+      chunk[i].slab_hook.index = base + i;
+      chunk[i].slab_hook.next_free.store(base + i + 1, std::memory_order_relaxed);
+    }
+    chunks_[chunk_index].store(chunk, std::memory_order_relaxed);
+    chunk_count_.store(chunk_index + 1, std::memory_order_relaxed);
+
+    // Published by the release in `PushList`.
+    this->PushList(base, chunk[kChunkSize - 1]);
+  }
+
+  alignas(64) std::atomic<uint64_t> head_ {Pack(kNullIndex, 0)};
+
+  std::unique_ptr<std::atomic<T*>[]> chunks_ = std::make_unique<std::atomic<T*>[]>(kMaxChunks);
+  std::atomic<uint32_t> chunk_count_ {0};
+  mbase::Lockable<std::mutex> grow_mutex_;
+};
+
+} // namespace mnexus_backend
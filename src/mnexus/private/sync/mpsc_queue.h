@@ -0,0 +1,72 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <atomic>
+#include <optional>
+#include <utility>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+
+namespace mnexus_backend {
+
+// ----------------------------------------------------------------------------------------------------
+// MpscQueue
+//
+// Unbounded multi-producer single-consumer FIFO (Vyukov). `Push` is wait-free for producers: a single atomic
+// exchange plus a store. `TryPop` **MUST** only be called from one consumer thread at a time.
+//
+// A push that has exchanged the head but not yet linked its node is not visible to the consumer; `TryPop` reports
+// empty until the link lands. Callers pair the queue with their own wakeup signal, raised after `Push` returns.
+//
+
+template<typename T>
+class MpscQueue final {
+public:
+  MpscQueue() {
+    Node* stub = new Node();
+    head_.store(stub, std::memory_order_relaxed);
+    tail_ = stub;
+  }
+  ~MpscQueue() {
+    while (this->TryPop().has_value()) {
+    }
+    delete tail_;
+  }
+  MBASE_DISALLOW_COPY_MOVE(MpscQueue);
+
+  void Push(T value) {
+    Node* node = new Node();
+    node->value.emplace(std::move(value));
+
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  /// Consumer only. Returns the oldest linked element, or `std::nullopt`.
+  [[nodiscard]] std::optional<T> TryPop() {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return std::nullopt;
+    }
+
+    // `next` becomes the new stub.
+    std::optional<T> value = std::move(next->value);
+    next->value.reset();
+    tail_ = next;
+    delete tail;
+    return value;
+  }
+
+private:
+  struct Node {
+    std::atomic<Node*> next = nullptr;
+    std::optional<T> value;
+  };
+
+  alignas(64) std::atomic<Node*> head_;
+  alignas(64) Node* tail_;
+};
+
+} // namespace mnexus_backend
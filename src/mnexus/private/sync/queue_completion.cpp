@@ -0,0 +1,358 @@
+// TU header --------------------------------------------
+#include "sync/queue_completion.h"
+
+// c++ headers ------------------------------------------
+#include <algorithm>
+#include <utility>
+
+// platform detection header ----------------------------
+#include "mbase/public/platform.h"
+
+// conditional platform headers -------------------------
+#if MBASE_PLATFORM_WINDOWS
+# if !defined(NOMINMAX)
+#   define NOMINMAX
+# endif
+# if !defined(WIN32_LEAN_AND_MEAN)
+#   define WIN32_LEAN_AND_MEAN
+# endif
+# include <windows.h>
+#elif MBASE_PLATFORM_LINUX || MBASE_PLATFORM_ANDROID
+# include <sys/eventfd.h>
+# include <unistd.h>
+#elif !MBASE_PLATFORM_WEB
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+// public project headers -------------------------------
+#include "mbase/public/assert.h"
+#include "mbase/public/log.h"
+
+namespace mnexus_backend {
+
+namespace {
+
+#if MBASE_PLATFORM_WEB
+constexpr bool kCompletionThreadSupported = false;
+#else
+constexpr bool kCompletionThreadSupported = true;
+#endif
+
+/// Heap order for `std::push_heap`/`std::pop_heap`: the front is the smallest (value, sequence).
+template<typename T>
+bool LaterThan(T const& lhs, T const& rhs) {
+  return lhs.value != rhs.value ? lhs.value > rhs.value : lhs.sequence > rhs.sequence;
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------------------------------
+// QueueCompletionNotifier
+//
+
+QueueCompletionNotifier::~QueueCompletionNotifier() {
+  this->Shutdown();
+}
+
+void QueueCompletionNotifier::Initialize(IQueueCompletionSource* source, uint32_t queue_count) {
+  MBASE_ASSERT(source != nullptr);
+  MBASE_ASSERT(queue_count > 0 && queue_count <= kMaxQueues);
+
+  mbase::LockGuard lock(mutex_);
+  source_ = source;
+  queue_count_ = queue_count;
+  stop_requested_ = false;
+}
+
+void QueueCompletionNotifier::Shutdown() {
+  {
+    mbase::LockGuard lock(mutex_);
+    stop_requested_ = true;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  if (source_ == nullptr) {
+    return;
+  }
+
+  // Deliver what has completed by now; the rest can no longer be waited on.
+  uint32_t dropped_count = 0;
+  for (uint32_t i = 0; i < queue_count_; ++i) {
+    bool has_callbacks = false;
+    {
+      mbase::LockGuard lock(mutex_);
+      has_callbacks = !queues_[i].callbacks.empty();
+    }
+    if (has_callbacks) {
+      this->DispatchCompleted(i, source_->PollQueueCompletedValue(i));
+    }
+
+    mbase::LockGuard lock(mutex_);
+    QueueState& queue = queues_[i];
+    dropped_count += static_cast<uint32_t>(queue.callbacks.size());
+    queue.callbacks.clear();
+
+#if MBASE_PLATFORM_WINDOWS
+    if (queue.event.handle != kInvalidEvent) {
+      ::CloseHandle(reinterpret_cast<HANDLE>(queue.event.handle));
+    }
+#elif !MBASE_PLATFORM_WEB
+    if (queue.event.handle != kInvalidEvent) {
+      ::close(static_cast<int>(queue.event.handle));
+    }
+    if (queue.event.signal_handle != kInvalidEvent && queue.event.signal_handle != queue.event.handle) {
+      ::close(static_cast<int>(queue.event.signal_handle));
+    }
+#endif
+    queue.event = NativeEvent {};
+  }
+
+  if (dropped_count > 0) {
+    MBASE_LOG_WARN("Dropping {} completion callback(s) whose value did not complete before shutdown", dropped_count);
+  }
+
+  source_ = nullptr;
+}
+
+void QueueCompletionNotifier::NotifySubmitted(uint32_t queue_index, uint64_t value) {
+  MBASE_ASSERT(queue_index < kMaxQueues);
+
+  // Submissions from different threads may report their values out of order; keep the maximum.
+  std::atomic<uint64_t>& last_submitted = last_submitted_[queue_index];
+  uint64_t current = last_submitted.load(std::memory_order_relaxed);
+  while (current < value && !last_submitted.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+
+  if (in_use_.load(std::memory_order_acquire)) {
+    // Taking the lock orders the update against the thread's predicate check, so the wakeup cannot be lost.
+    { mbase::LockGuard lock(mutex_); }
+    cv_.notify_one();
+  }
+}
+
+void QueueCompletionNotifier::AddCallback(
+  uint32_t queue_index,
+  uint64_t value,
+  MnQueueCompletedCallback callback,
+  void* user_data
+) {
+  MBASE_ASSERT(queue_index < queue_count_);
+  MBASE_ASSERT(callback != nullptr);
+
+  {
+    mbase::LockGuard lock(mutex_);
+    std::vector<PendingCallback>& callbacks = queues_[queue_index].callbacks;
+    callbacks.push_back(
+      PendingCallback {
+        .value = value,
+        .sequence = next_sequence_++,
+        .callback = callback,
+        .user_data = user_data,
+      }
+    );
+    std::push_heap(callbacks.begin(), callbacks.end(), LaterThan<PendingCallback>);
+
+    in_use_.store(true, std::memory_order_release);
+    this->EnsureThreadStarted();
+  }
+  cv_.notify_one();
+}
+
+intptr_t QueueCompletionNotifier::GetEvent(uint32_t queue_index) {
+  MBASE_ASSERT(queue_index < queue_count_);
+
+  mbase::LockGuard lock(mutex_);
+  NativeEvent& event = queues_[queue_index].event;
+  if (event.handle != kInvalidEvent) {
+    return event.handle;
+  }
+
+#if MBASE_PLATFORM_WINDOWS
+  HANDLE const handle = ::CreateEventW(nullptr, FALSE, FALSE, nullptr);
+  if (handle == nullptr) {
+    MBASE_LOG_ERROR("CreateEventW failed: {}", ::GetLastError());
+    return kInvalidEvent;
+  }
+  event.handle = reinterpret_cast<intptr_t>(handle);
+  event.signal_handle = event.handle;
+#elif MBASE_PLATFORM_LINUX || MBASE_PLATFORM_ANDROID
+  int const fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (fd < 0) {
+    MBASE_LOG_ERROR("eventfd failed");
+    return kInvalidEvent;
+  }
+  event.handle = fd;
+  event.signal_handle = fd;
+#elif !MBASE_PLATFORM_WEB
+  int fds[2] {};
+  if (::pipe(fds) != 0) {
+    MBASE_LOG_ERROR("pipe failed");
+    return kInvalidEvent;
+  }
+  for (int fd : fds) {
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+  event.handle = fds[0];
+  event.signal_handle = fds[1];
+#else
+  return kInvalidEvent;
+#endif
+
+  in_use_.store(true, std::memory_order_release);
+  this->EnsureThreadStarted();
+  return event.handle;
+}
+
+void QueueCompletionNotifier::TrackAllSubmissions() {
+  {
+    mbase::LockGuard lock(mutex_);
+    track_all_submissions_ = true;
+
+    in_use_.store(true, std::memory_order_release);
+    this->EnsureThreadStarted();
+  }
+  cv_.notify_one();
+}
+
+void QueueCompletionNotifier::DispatchCompleted(uint32_t queue_index, uint64_t completed_value) {
+  MBASE_ASSERT(queue_index < queue_count_);
+
+  std::vector<PendingCallback> ready;
+  {
+    mbase::LockGuard lock(mutex_);
+    this->CollectCompleted(queue_index, completed_value, ready);
+  }
+
+  for (PendingCallback const& pending : ready) {
+    pending.callback(pending.value, pending.user_data);
+  }
+}
+
+void QueueCompletionNotifier::EnsureThreadStarted() {
+  if (kCompletionThreadSupported && !thread_.joinable() && !stop_requested_) {
+    thread_ = std::thread([this]() { this->ThreadMain(); });
+  }
+}
+
+void QueueCompletionNotifier::ThreadMain() {
+  std::vector<PendingCallback> ready;
+
+  auto deliver_ready = [&ready]() {
+    for (PendingCallback const& pending : ready) {
+      pending.callback(pending.value, pending.user_data);
+    }
+    ready.clear();
+  };
+
+  for (;;) {
+    uint64_t target_values[kMaxQueues] {};
+    {
+      mbase::LockGuard lock(mutex_);
+      if (stop_requested_) {
+        return;
+      }
+
+      bool has_target = false;
+      for (uint32_t i = 0; i < queue_count_; ++i) {
+        // Callbacks registered for values that were already observed need no wait.
+        this->CollectCompleted(i, queues_[i].observed_completed, ready);
+
+        target_values[i] = this->ComputeWaitTarget(i);
+        has_target = has_target || target_values[i] != 0;
+      }
+
+      if (ready.empty() && !has_target) {
+        // `condition_variable_any` releases and reacquires `mutex_` itself; the guard still owns it afterwards.
+        cv_.wait(mutex_);
+        continue;
+      }
+    }
+
+    if (!ready.empty()) {
+      deliver_ready();
+      continue;
+    }
+
+    source_->WaitAnyQueueValue(target_values, kWaitTimeoutNs);
+
+    uint64_t completed_values[kMaxQueues] {};
+    for (uint32_t i = 0; i < queue_count_; ++i) {
+      if (target_values[i] != 0) {
+        completed_values[i] = source_->PollQueueCompletedValue(i);
+      }
+    }
+
+    {
+      mbase::LockGuard lock(mutex_);
+      for (uint32_t i = 0; i < queue_count_; ++i) {
+        if (target_values[i] != 0) {
+          this->CollectCompleted(i, completed_values[i], ready);
+        }
+      }
+    }
+
+    deliver_ready();
+  }
+}
+
+uint64_t QueueCompletionNotifier::ComputeWaitTarget(uint32_t queue_index) const {
+  QueueState const& queue = queues_[queue_index];
+  uint64_t const last_submitted = last_submitted_[queue_index].load(std::memory_order_relaxed);
+
+  uint64_t target = 0;
+  if (!queue.callbacks.empty()) {
+    // Callbacks for values that are not submitted yet wait for `NotifySubmitted`.
+    uint64_t const value = queue.callbacks.front().value;
+    if (value > queue.observed_completed && value <= last_submitted) {
+      target = value;
+    }
+  }
+  bool const track_each_value = track_all_submissions_ || queue.event.handle != kInvalidEvent;
+  if (track_each_value && queue.observed_completed < last_submitted) {
+    uint64_t const value = queue.observed_completed + 1;
+    target = (target == 0) ? value : std::min(target, value);
+  }
+  return target;
+}
+
+void QueueCompletionNotifier::CollectCompleted(
+  uint32_t queue_index,
+  uint64_t completed_value,
+  std::vector<PendingCallback>& out_ready
+) {
+  QueueState& queue = queues_[queue_index];
+  if (completed_value > queue.observed_completed) {
+    queue.observed_completed = completed_value;
+
+#if MBASE_PLATFORM_WINDOWS
+    if (queue.event.signal_handle != kInvalidEvent) {
+      ::SetEvent(reinterpret_cast<HANDLE>(queue.event.signal_handle));
+    }
+#elif MBASE_PLATFORM_LINUX || MBASE_PLATFORM_ANDROID
+    if (queue.event.signal_handle != kInvalidEvent) {
+      uint64_t const one = 1;
+      [[maybe_unused]] ssize_t const written = ::write(static_cast<int>(queue.event.signal_handle), &one, sizeof(one));
+    }
+#elif !MBASE_PLATFORM_WEB
+    if (queue.event.signal_handle != kInvalidEvent) {
+      // A full pipe already reads as signaled.
+      uint8_t const byte = 1;
+      [[maybe_unused]] ssize_t const written = ::write(static_cast<int>(queue.event.signal_handle), &byte, 1);
+    }
+#endif
+  }
+
+  std::vector<PendingCallback>& callbacks = queue.callbacks;
+  while (!callbacks.empty() && callbacks.front().value <= queue.observed_completed) {
+    std::pop_heap(callbacks.begin(), callbacks.end(), LaterThan<PendingCallback>);
+    out_ready.push_back(callbacks.back());
+    callbacks.pop_back();
+  }
+}
+
+} // namespace mnexus_backend
@@ -0,0 +1,136 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mbase/public/access.h"
+#include "mbase/public/tsa.h"
+
+#include "mnexus/public/mnexus.h"
+
+// project headers --------------------------------------
+#include "sync/resource_sync.h"
+
+namespace mnexus_backend {
+
+// ----------------------------------------------------------------------------------------------------
+// IQueueCompletionSource
+//
+// Backend hooks used by `QueueCompletionNotifier`. Queues are identified by their compact index (see
+// `QueueIndexMap`). Called from the completion thread without any notifier lock held.
+//
+
+class IQueueCompletionSource {
+public:
+  virtual ~IQueueCompletionSource() = default;
+
+  /// Returns the highest completed value of the queue. Side-effects of the completed operations (e.g. readback
+  /// destinations) **MUST** be visible when this returns.
+  [[nodiscard]] virtual uint64_t PollQueueCompletedValue(uint32_t queue_index) = 0;
+
+  /// Blocks until any queue reaches its target value or `timeout_ns` elapses. A target of 0 skips the queue.
+  virtual void WaitAnyQueueValue(uint64_t const (&target_values)[kMaxQueues], uint64_t timeout_ns) = 0;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// QueueCompletionNotifier
+//
+// Delivers `QueueOnCompleted` callbacks and signals the per-queue native completion events from a single internal
+// thread, so that callers can park on GPU completion instead of polling `QueueGetCompletedValue`.
+//
+// The thread is started on first use. It sleeps on a condition variable while there is nothing to wait for, and
+// otherwise blocks in the backend's wait primitive with a bounded timeout so that `Shutdown` is observed promptly.
+// Only submitted values are waited on; `NotifySubmitted` wakes the thread for new work.
+//
+
+class QueueCompletionNotifier final {
+public:
+  static constexpr intptr_t kInvalidEvent = -1;
+
+  QueueCompletionNotifier() = default;
+  ~QueueCompletionNotifier();
+  MBASE_DISALLOW_COPY_MOVE(QueueCompletionNotifier);
+
+  void Initialize(IQueueCompletionSource* source, uint32_t queue_count);
+
+  /// Joins the completion thread, delivers the callbacks whose value has completed, drops the others and closes the
+  /// events. Idempotent.
+  void Shutdown();
+
+  /// Records that `value` has been submitted to the queue. Lock-free while the notifier is unused.
+  void NotifySubmitted(uint32_t queue_index, uint64_t value);
+
+  /// Registers a callback, delivered on the completion thread once `value` has completed.
+  void AddCallback(uint32_t queue_index, uint64_t value, MnQueueCompletedCallback callback, void* user_data);
+
+  /// Returns the queue's native completion event, creating it on first use, or `kInvalidEvent`.
+  [[nodiscard]] intptr_t GetEvent(uint32_t queue_index);
+
+  /// Makes the completion thread wait on every submitted value, even without callbacks or events, so that the
+  /// source's completed value advances without anyone polling it. No-op where no completion thread can run.
+  void TrackAllSubmissions();
+
+  /// Delivers the callbacks of the queue up to `completed_value` on the calling thread. Used where no completion
+  /// thread can run.
+  void DispatchCompleted(uint32_t queue_index, uint64_t completed_value);
+
+private:
+  /// Upper bound of a single backend wait; bounds the latency of `Shutdown`.
+  static constexpr uint64_t kWaitTimeoutNs = 100'000'000;
+
+  struct PendingCallback {
+    uint64_t value;
+    uint64_t sequence;
+    MnQueueCompletedCallback callback;
+    void* user_data;
+  };
+
+  struct NativeEvent {
+    intptr_t handle = kInvalidEvent;
+    intptr_t signal_handle = kInvalidEvent;
+  };
+
+  struct QueueState {
+    /// Min-heap on (value, sequence).
+    std::vector<PendingCallback> callbacks;
+    uint64_t observed_completed = 0;
+    NativeEvent event;
+  };
+
+  void EnsureThreadStarted() MBASE_REQUIRES(mutex_);
+  void ThreadMain() MBASE_EXCLUDES(mutex_);
+
+  /// Returns the next value worth waiting for on the queue, or 0.
+  [[nodiscard]] uint64_t ComputeWaitTarget(uint32_t queue_index) const MBASE_REQUIRES(mutex_);
+
+  /// Advances the observed value, signals the event and moves the callbacks that became ready to `out_ready`.
+  void CollectCompleted(uint32_t queue_index, uint64_t completed_value, std::vector<PendingCallback>& out_ready)
+    MBASE_REQUIRES(mutex_);
+
+  IQueueCompletionSource* source_ = nullptr;
+  uint32_t queue_count_ = 0;
+
+  /// Set once a callback or event has been requested; until then submissions do not wake the thread.
+  std::atomic<bool> in_use_ = false;
+
+  /// Highest submitted value per queue. Kept out of `queues_` so that `NotifySubmitted` can update it without the
+  /// lock.
+  std::atomic<uint64_t> last_submitted_[kMaxQueues] {};
+
+  mbase::Lockable<std::mutex> mutex_;
+  std::condition_variable_any cv_;
+  bool stop_requested_ MBASE_GUARDED_BY(mutex_) = false;
+  bool track_all_submissions_ MBASE_GUARDED_BY(mutex_) = false;
+  uint64_t next_sequence_ MBASE_GUARDED_BY(mutex_) = 0;
+  QueueState queues_[kMaxQueues] MBASE_GUARDED_BY(mutex_);
+  std::thread thread_;
+};
+
+} // namespace mnexus_backend
@@ -12,6 +12,7 @@ ResourceSyncStamp::ResourceSyncStamp(ResourceSyncStamp const& other) {
     last_used[i].store(other.last_used[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
   }
   used_mask.store(other.used_mask.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  open_list_references.store(other.open_list_references.load(std::memory_order_relaxed), std::memory_order_relaxed);
 }
 
 ResourceSyncStamp& ResourceSyncStamp::operator=(ResourceSyncStamp const& other) {
@@ -19,6 +20,7 @@ ResourceSyncStamp& ResourceSyncStamp::operator=(ResourceSyncStamp const& other)
     last_used[i].store(other.last_used[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
   }
   used_mask.store(other.used_mask.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  open_list_references.store(other.open_list_references.load(std::memory_order_relaxed), std::memory_order_relaxed);
   return *this;
 }
 
@@ -27,6 +29,7 @@ ResourceSyncStamp::ResourceSyncStamp(ResourceSyncStamp&& other) {
     last_used[i].store(other.last_used[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
   }
   used_mask.store(other.used_mask.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  open_list_references.store(other.open_list_references.load(std::memory_order_relaxed), std::memory_order_relaxed);
 }
 
 ResourceSyncStamp& ResourceSyncStamp::operator=(ResourceSyncStamp&& other) {
@@ -34,6 +37,7 @@ ResourceSyncStamp& ResourceSyncStamp::operator=(ResourceSyncStamp&& other) {
     last_used[i].store(other.last_used[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
   }
   used_mask.store(other.used_mask.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  open_list_references.store(other.open_list_references.load(std::memory_order_relaxed), std::memory_order_relaxed);
   return *this;
 }
 
@@ -51,6 +55,7 @@ void ResourceSyncStamp::Reset() {
     last_used[i].store(0, std::memory_order_relaxed);
   }
   used_mask.store(0, std::memory_order_relaxed);
+  open_list_references.store(0, std::memory_order_relaxed);
 }
 
 ResourceSyncStamp::Snapshot ResourceSyncStamp::TakeSnapshot() const {
@@ -26,6 +26,10 @@ static constexpr uint32_t kMaxQueues = 5;
 struct ResourceSyncStamp final {
   std::atomic<uint64_t> last_used[kMaxQueues] {};
   std::atomic<uint32_t> used_mask {0};
+  /// Command lists that reference the resource and have been neither submitted nor discarded. They stamp the
+  /// resource only at submit, so a destroyed resource **MUST** be kept while this is non-zero. Only tracked for
+  /// resources whose destruction checks it.
+  std::atomic<uint32_t> open_list_references {0};
 
   ResourceSyncStamp() = default;
   ~ResourceSyncStamp() = default;
@@ -39,6 +43,18 @@ struct ResourceSyncStamp final {
   /// Record that this resource was used in a submission on the given queue.
   void Stamp(uint32_t queue_compact_index, uint64_t submit_serial);
 
+  void AddListReference() { open_list_references.fetch_add(1, std::memory_order_relaxed); }
+  /// Called after the list has stamped the resource, if it was submitted.
+  void ReleaseListReference() {
+    // release: pairs with the acquire in `HasOpenListReferences`, making the submit's stamp visible to a reader that
+    // sees the reference gone.
+    [[maybe_unused]] uint32_t const previous = open_list_references.fetch_sub(1, std::memory_order_release);
+    MBASE_ASSERT(previous != 0);
+  }
+  [[nodiscard]] bool HasOpenListReferences() const {
+    return open_list_references.load(std::memory_order_acquire) != 0;
+  }
+
   /// Reset to the initial state (no usage on any queue).
   void Reset();
 
@@ -69,6 +85,12 @@ public:
   /// Returns the compact index for the given QueueId, or nullopt if not mapped.
   [[nodiscard]] std::optional<uint32_t> Find(mnexus::QueueId const& queue_id) const;
 
+  /// Returns the QueueId mapped to the given compact index. `compact_index` **MUST** be less than `Count()`.
+  [[nodiscard]] mnexus::QueueId GetQueueId(uint32_t compact_index) const {
+    MBASE_ASSERT(compact_index < count_);
+    return entries_[compact_index].queue_id;
+  }
+
   /// Returns the number of mapped queues.
   [[nodiscard]] uint32_t Count() const { return count_; }
 
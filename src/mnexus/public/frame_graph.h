@@ -0,0 +1,155 @@
+#pragma once
+
+#if defined(__cplusplus)
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+namespace mnexus {
+
+// ----------------------------------------------------------------------------------------------------
+// Frame graph types
+//
+
+/// Identifies a texture declared on a `FrameGraph`. Valid until the next `FrameGraph::Reset`.
+struct FrameGraphTextureId final {
+  static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+  uint32_t index = kInvalidIndex;
+
+  [[nodiscard]] bool IsValid() const { return index != kInvalidIndex; }
+};
+
+/// One texture access of a pass. `kSampled` and `kTransferSrc` read the texture; the other accesses write it.
+struct FrameGraphTextureUse final {
+  FrameGraphTextureId texture;
+  /// **MUST NOT** be `TextureAccess::kDiscarded`.
+  TextureAccess access = TextureAccess::kSampled;
+};
+
+/// Figures of the last `FrameGraph::Compile` and `FrameGraph::Execute`.
+struct FrameGraphStats final {
+  uint32_t pass_count = 0;
+  uint32_t transient_texture_count = 0;
+  /// Backend textures created for the transient textures.
+  uint32_t physical_texture_count = 0;
+  /// Memory the transient textures would take with an allocation each.
+  uint64_t unaliased_size_in_bytes = 0;
+  /// Memory the transient textures take after aliasing.
+  uint64_t aliased_size_in_bytes = 0;
+  /// `ICommandList::TransitionTextures` calls made by the last `Execute`.
+  uint32_t transition_batch_count = 0;
+  /// Texture transitions across those calls.
+  uint32_t transition_count = 0;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// FrameGraph
+//
+
+/// Optional layer that records a frame as a list of passes with declared texture accesses.
+///
+/// Usage, once per frame:
+///   1. Declare textures with `CreateTexture` (transient, owned by the graph) or `ImportTexture` (owned by the caller).
+///   2. Add passes in execution order with `AddPass`.
+///   3. `Compile`, then `Execute` into a command list, then `Reset`.
+///
+/// `Compile` computes the lifetime of every transient texture, from its first to its last pass, and lets transient
+/// textures whose lifetimes do not overlap share memory: through `IDevice::CreateAliasedTextures` when the adapter
+/// supports it, and otherwise by sharing one backend texture between transients with identical descriptions. Backend
+/// textures are kept across `Reset` and reused while the next frame needs the same ones.
+///
+/// `Execute` prepares the textures of each pass in one `ICommandList::TransitionTextures` call, skipping accesses the
+/// texture is already prepared for when both are reads, then runs the pass callback inside a debug group.
+///
+/// > **Note:** The contents of a transient texture are undefined before its first pass, which **SHOULD** write it,
+/// > and after its last pass. Not thread-safe.
+class FrameGraph final {
+public:
+  using PassCallback = std::function<void(ICommandList& command_list, FrameGraph const& frame_graph)>;
+
+  explicit FrameGraph(IDevice& device);
+  /// Destroys the backend textures of the transient textures.
+  ~FrameGraph();
+  FrameGraph(FrameGraph const&) = delete;
+  FrameGraph& operator=(FrameGraph const&) = delete;
+
+  /// Declares a transient texture. `desc.usage` **MUST** cover every access the passes declare for it.
+  FrameGraphTextureId CreateTexture(std::string_view name, TextureDesc const& desc);
+
+  /// Declares a texture the caller owns. It is never aliased and its contents are preserved.
+  FrameGraphTextureId ImportTexture(std::string_view name, TextureHandle texture_handle);
+
+  /// Adds a pass. Passes run in the order they are added.
+  ///
+  /// - `uses`: **MUST NOT** name a texture twice.
+  void AddPass(std::string_view name, container::ArrayProxy<FrameGraphTextureUse const> uses, PassCallback callback);
+
+  /// Computes lifetimes and assigns backend textures to the transient textures.
+  void Compile();
+
+  /// Records every pass into `command_list`. **MUST** follow `Compile`.
+  void Execute(ICommandList& command_list);
+
+  /// Forgets the declared passes and textures. Backend textures are kept for the next `Compile`.
+  void Reset();
+
+  /// The backend texture of `id`. Valid from `Compile` until the next `Compile` or `Reset`.
+  [[nodiscard]] TextureHandle GetTexture(FrameGraphTextureId id) const;
+
+  [[nodiscard]] FrameGraphStats const& GetStats() const { return stats_; }
+
+private:
+  static constexpr uint32_t kNoPass = UINT32_MAX;
+
+  struct Texture final {
+    std::string name;
+    TextureDesc desc;
+    bool transient = false;
+    uint64_t size_in_bytes = 0;
+    uint32_t first_pass = kNoPass;
+    uint32_t last_pass = kNoPass;
+    /// The imported texture, or the backend texture assigned by `Compile`.
+    TextureHandle handle = TextureHandle::Invalid();
+  };
+
+  struct Pass final {
+    std::string name;
+    std::vector<FrameGraphTextureUse> uses;
+    PassCallback callback;
+  };
+
+  /// Backend textures sharing memory. Either one texture shared by transients with identical descriptions, or, when
+  /// `aliased`, one texture per description from a single `IDevice::CreateAliasedTextures` call.
+  struct PhysicalGroup final {
+    bool aliased = false;
+    std::vector<TextureDesc> descs;
+    std::vector<TextureHandle> textures;
+    uint64_t size_in_bytes = 0;
+  };
+
+  void CreatePhysicalGroup(PhysicalGroup& group);
+  void DestroyPhysicalGroup(PhysicalGroup const& group);
+
+  IDevice& device_;
+  bool memory_aliasing_ = false;
+
+  std::vector<Texture> textures_;
+  std::vector<Pass> passes_;
+  std::vector<PhysicalGroup> physical_groups_;
+  bool compiled_ = false;
+
+  FrameGraphStats stats_;
+};
+
+} // namespace mnexus
+
+#endif // defined(__cplusplus)
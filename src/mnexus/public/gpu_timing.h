@@ -0,0 +1,59 @@
+#pragma once
+
+#if defined(__cplusplus)
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/types.h"
+
+namespace mnexus {
+
+// ----------------------------------------------------------------------------------------------------
+// GPU timing
+//
+
+enum class GpuTimingScopeKind : uint8_t {
+  kDebugGroup,
+  kRenderPass,
+  kComputePass,
+};
+
+/// Sentinel `GpuTimingScope::parent_index` value for root scopes.
+constexpr uint32_t kGpuTimingNoParent = UINT32_MAX;
+
+/// A single node of a per-submission GPU timing tree.
+///
+/// Timestamps are in nanoseconds in the GPU's timestamp domain. Only differences between timestamps of the same
+/// report are meaningful.
+struct GpuTimingScope final {
+  std::string name;
+  GpuTimingScopeKind kind = GpuTimingScopeKind::kDebugGroup;
+  uint32_t parent_index = kGpuTimingNoParent;
+  uint32_t depth = 0;
+
+  uint64_t begin_ns = 0;
+  uint64_t end_ns = 0;
+  /// `false` if no timestamp could be attributed to this scope (e.g. the query capacity was exhausted, or the scope
+  /// is a debug group that encloses no timed pass on a backend that cannot write timestamps outside of passes).
+  bool valid = false;
+
+  [[nodiscard]] uint64_t DurationNs() const {
+    return (valid && end_ns > begin_ns) ? end_ns - begin_ns : 0;
+  }
+};
+
+/// GPU timing tree of a single submitted command list.
+/// `scopes` are in pre-order: a parent always precedes its children.
+struct GpuTimingReport final {
+  IntraQueueSubmissionId submission_id;
+  std::vector<GpuTimingScope> scopes;
+};
+
+} // namespace mnexus
+
+#endif // defined(__cplusplus)
@@ -0,0 +1,51 @@
+#pragma once
+
+#if defined(__cplusplus)
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <vector>
+
+namespace mnexus {
+
+// ----------------------------------------------------------------------------------------------------
+// Memory statistics
+//
+
+/// Usage and budget of one native memory heap.
+struct MemoryHeapStats final {
+  /// Whether the heap is local to the device (video memory on discrete GPUs).
+  bool device_local = false;
+  /// Size of the heap.
+  uint64_t size_in_bytes = 0;
+  /// Bytes of memory blocks this device has allocated from the heap.
+  uint64_t allocated_in_bytes = 0;
+  /// Bytes the whole process uses from the heap, as estimated by the driver.
+  uint64_t usage_in_bytes = 0;
+  /// Bytes the process can use from the heap before allocations start failing or degrading performance.
+  uint64_t budget_in_bytes = 0;
+};
+
+/// Live resources of one type, at their requested sizes.
+struct ResourceMemoryStats final {
+  uint64_t count = 0;
+  uint64_t size_in_bytes = 0;
+};
+
+/// Snapshot returned by `IDevice::GetMemoryStats`.
+struct MemoryStats final {
+  /// One entry per native memory heap. Empty if the backend cannot query heaps.
+  std::vector<MemoryHeapStats> heaps;
+  ResourceMemoryStats buffers;
+  ResourceMemoryStats textures;
+
+  /// The value `IDevice::SetMemoryThresholdCallback` compares against.
+  [[nodiscard]] uint64_t GetResourceSizeInBytes() const {
+    return buffers.size_in_bytes + textures.size_in_bytes;
+  }
+};
+
+} // namespace mnexus
+
+#endif // defined(__cplusplus)
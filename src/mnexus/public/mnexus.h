@@ -3,19 +3,31 @@
 // c++ headers ------------------------------------------
 #if defined(__cplusplus)
 # include <memory>
+# include <type_traits>
 #endif
 
 // public project headers -------------------------------
 #include "mbase/public/call.h"
 
 #if defined(__cplusplus)
+# include "mnexus/public/gpu_timing.h"
+# include "mnexus/public/memory_stats.h"
+# include "mnexus/public/perf_counters.h"
+# include "mnexus/public/present_stats.h"
 # include "mnexus/public/render_state_event_log.h"
+# include "mnexus/public/sampler_cache_snapshot.h"
 #endif
 #include "mnexus/public/types.h"
 
 #define MNEXUS_NO_THROW MBASE_NO_THROW
 #define MNEXUS_CALL     MBASE_STDCALL
 
+/// Invoked once a timeline value registered with `QueueOnCompleted` has completed.
+typedef void (MNEXUS_CALL* MnQueueCompletedCallback)(MnIntraQueueSubmissionId value, void* user_data);
+
+/// Invoked when resource memory crosses the threshold set with `SetMemoryThresholdCallback`.
+typedef void (MNEXUS_CALL* MnMemoryThresholdCallback)(uint64_t resource_size_in_bytes, void* user_data);
+
 #if defined(__cplusplus)
 
 namespace mnexus {
@@ -75,14 +87,90 @@ namespace mnexus {
 
 class IDevice;
 class ICommandList;
+class IRenderBundleEncoder;
 
 #define _MNEXUS_VAPI(ret, name, ...) \
   virtual MNEXUS_NO_THROW ret MNEXUS_CALL name(__VA_ARGS__) = 0
 
+/// Explicit adapter choice for `NexusDesc::adapter_override`.
+///
+/// Fields left at their defaults match any adapter. If no usable adapter
+/// matches, a warning is logged and the scored selection is used instead.
+struct AdapterOverride final {
+  static constexpr uint32_t kAnyIndex = UINT32_MAX;
+
+  /// Position in the backend's adapter enumeration order. When set, the IDs
+  /// are ignored.
+  uint32_t index = kAnyIndex;
+  /// PCI vendor ID, or 0 for any vendor.
+  uint32_t vendor_id = 0;
+  /// PCI device ID, or 0 for any device.
+  uint32_t device_id = 0;
+};
+
+/// Swapchain emulated by a headless instance, so that the present path
+/// (`OnPresentPrologue`, `IDevice::GetSwapchainTexture`,
+/// `OnPresentEpilogue`) runs without a display.
+///
+/// Images are acquired in presentation order, like a FIFO swapchain. A
+/// presented image becomes available again once the queue has completed the
+/// frame's work and `present_latency_ns` has elapsed since its present;
+/// `OnPresentPrologue` blocks until then. The images are never displayed.
+struct OffscreenSwapchainDesc final {
+  /// Number of images. 0 disables the offscreen swapchain.
+  uint32_t image_count = 0;
+  /// Image size, clamped to a minimum of 1x1.
+  uint32_t width = 0;
+  uint32_t height = 0;
+  /// The images are created with `TextureUsageFlagBits::kAttachment`,
+  /// `kTransferSrc` and `kTransferDst`. **MUST** be a color format usable as
+  /// an attachment.
+  Format format = Format::kR8G8B8A8_UNORM;
+  /// Time a presented image stays queued for display.
+  uint64_t present_latency_ns = 0;
+};
+
 struct NexusDesc final {
   bool headless = false;
   BackendType backend_type = BackendType::kWebGpu;
   char const* app_name = nullptr;
+  /// Opt-in: place small buffers inside a few large shared native buffers
+  /// instead of giving each its own buffer and memory allocation. Reduces
+  /// allocation count and creation cost for many small buffers.
+  ///
+  /// > **Note:** Honored by the Vulkan backend only; ignored elsewhere.
+  bool placed_buffers = false;
+  /// Opt-in: create the device-wide bindless resource table (see
+  /// `IDevice::RegisterBindlessSampledTexture`). Requires descriptor
+  /// indexing; check `AdapterCapability::bindless_resources` after creation.
+  ///
+  /// > **Note:** Honored by the Vulkan backend only; ignored elsewhere.
+  bool bindless_resources = false;
+  /// Opt-in: hand queue operations (`QueueSubmitCommandList`,
+  /// `QueueWriteBuffer`, `QueueWriteTexture`, `QueueReadBuffer`,
+  /// `QueueReadTexture`) to a dedicated submission thread through a
+  /// lock-free queue instead of issuing them under a device-wide lock on the
+  /// calling thread. Threads that submit or upload concurrently then no
+  /// longer serialize on each other. Timeline values are still assigned at
+  /// the call, so the ordering guarantees of `IntraQueueSubmissionId` are
+  /// unchanged.
+  ///
+  /// `QueueWriteBuffer` and `QueueWriteTexture` copy the source data before
+  /// returning. `QueueGetCompletedValue` reads a value that an internal
+  /// thread keeps current, without taking the device-wide lock.
+  ///
+  /// > **Note:** Honored by the WebGPU backend only, except on the Web;
+  /// > ignored elsewhere.
+  bool submission_thread = false;
+  /// Picks the adapter instead of leaving it to the backend, which otherwise
+  /// scores the adapters by type (discrete first), optional feature coverage,
+  /// queue family layout and device-local memory size.
+  ///
+  /// > **Note:** Honored by the Vulkan backend only; ignored elsewhere.
+  AdapterOverride adapter_override;
+  /// Opt-in: give a headless instance an emulated swapchain. Ignored unless
+  /// `headless` is `true`.
+  OffscreenSwapchainDesc offscreen_swapchain;
 };
 
 class INexus {
@@ -99,7 +187,8 @@ public:
   /// or if the requested `desc.backend_type` is not available.
   ///
   /// - `desc`: Instance configuration. If `desc.headless` is `true`, no
-  ///   surface or swapchain is created; the device is available immediately.
+  ///   surface or swapchain is created, except the offscreen swapchain of
+  ///   `desc.offscreen_swapchain`; the device is available immediately.
   /// - Returns: A valid `INexus` pointer, or `nullptr` on failure. If
   ///   non-null, the caller **MUST** eventually call `Destroy` to release it.
   static INexus* Create(NexusDesc const& desc = {});
@@ -165,8 +254,10 @@ public:
   /// Acquires the swapchain's current backbuffer for rendering.
   ///
   /// ## Pre-conditions
-  /// - The instance **MUST NOT** be headless.
-  /// - A surface **MUST** have been configured via `OnSurfaceRecreated`.
+  /// - The instance **MUST NOT** be headless, unless it was created with an
+  ///   offscreen swapchain.
+  /// - A surface **MUST** have been configured via `OnSurfaceRecreated`,
+  ///   unless the instance is headless.
   ///
   /// ## Post-conditions
   /// - The swapchain's current backbuffer is acquired and ready for
@@ -187,6 +278,13 @@ public:
   /// - The swapchain texture handle is no longer valid for rendering.
   _MNEXUS_VAPI(void, OnPresentEpilogue);
 
+  /// Returns the frame pacing measured by `OnPresentPrologue` and
+  /// `OnPresentEpilogue`: CPU frame time, stall time and queue depth.
+  _MNEXUS_VAPI(PresentStats, GetPresentStats);
+
+  /// Resets the statistics returned by `GetPresentStats`.
+  _MNEXUS_VAPI(void, ResetPresentStats);
+
   // ----------------------------------------------------------------------------------------------
   // Device
 
@@ -211,10 +309,11 @@ public:
   // monotonically increasing timeline counter (`IntraQueueSubmissionId`).
   //
   // **Submission ordering**: Operations submitted to the same queue via
-  // `QueueSubmitCommandList`, `QueueWriteBuffer`, and `QueueReadBuffer`
-  // execute and complete in submission order (FIFO). An operation with a
-  // higher `IntraQueueSubmissionId` completes no earlier than one with a
-  // lower value on the same queue.
+  // `QueueSubmitCommandList`, `QueueWriteBuffer`, `QueueWriteTexture`,
+  // `QueueReadBuffer`, and `QueueReadTexture` execute and complete in
+  // submission order (FIFO). An
+  // operation with a higher `IntraQueueSubmissionId` completes no earlier
+  // than one with a lower value on the same queue.
   //
   // **Timeline values**: Every queue operation returns an
   // `IntraQueueSubmissionId` representing the point on the queue's timeline
@@ -227,6 +326,12 @@ public:
   //
   // **Blocking**: `QueueWaitIdle(queue_id, V)` blocks the calling thread until
   // `QueueGetCompletedValue(queue_id) >= V`.
+  //
+  // **Notification**: `QueueOnCompleted(queue_id, V, ...)` invokes a callback
+  // once `QueueGetCompletedValue(queue_id) >= V`, and the native event
+  // returned by `QueueGetCompletionEvent(queue_id)` is signaled whenever the
+  // completed value advances. Both are driven by one internal completion
+  // thread per device, so callers need not poll.
   // ==============================================================================================
 
   // ----------------------------------------------------------------------------------------------
@@ -240,6 +345,17 @@ public:
 
   /// Retrieves the description of a queue family.
   ///
+  /// `out_desc.queue_count` is the number of queues the device created in
+  /// the family, which may be zero: `QueueId::queue_index` **MUST** be less
+  /// than it.
+  ///
+  /// Buffers and textures are owned by one queue family at a time. A
+  /// resource used by queues of more than one family **MUST** be created
+  /// with `kConcurrentQueueFamilies` usage, which lets every family access
+  /// it without ownership transfers. Backends **MAY** then disable
+  /// optimizations such as render target compression for it, so the flag
+  /// is best kept to resources that are actually shared.
+  ///
   /// - `queue_family_index`: **MUST** be less than `QueueGetFamilyCount()`.
   /// - `out_desc`: Populated with the queue family's properties on success.
   /// - Returns: `MnBoolTrue` on success, `MnBoolFalse` if the index is
@@ -291,6 +407,51 @@ public:
     uint32_t data_size_in_bytes
   );
 
+  /// Writes data from CPU memory into one or more regions of a texture.
+  ///
+  /// Replaces the staging buffer + `CopyBufferToTexture` + submit sequence.
+  /// The source data is copied once on the CPU before this returns; row
+  /// alignment required by the backend is handled internally. All regions
+  /// (e.g. every mip level of a texture) are uploaded as one queue
+  /// operation.
+  ///
+  /// - `queue_id`: **MUST** identify a valid queue.
+  /// - `texture_handle`: **MUST** have been created with `kTransferDst`
+  ///   usage. **MUST** have sample count 1.
+  /// - `regions`: **MUST** be non-empty. Each region **MUST** fit within its
+  ///   mip level, and `data` **MUST** point to at least the bytes described
+  ///   by its pitches (see `TextureWriteRegion`). Regions **MUST NOT**
+  ///   overlap.
+  /// - Returns: An `IntraQueueSubmissionId`. The write is visible to
+  ///   subsequent GPU operations on the same queue. Returns 0 if the write
+  ///   could not be issued.
+  _MNEXUS_VAPI(IntraQueueSubmissionId, QueueWriteTexture,
+    QueueId const& queue_id,
+    TextureHandle texture_handle,
+    container::ArrayProxy<TextureWriteRegion const> regions
+  );
+
+  /// Single-region convenience overload of `QueueWriteTexture`.
+  IntraQueueSubmissionId QueueWriteTexture(
+    QueueId const& queue_id,
+    TextureHandle texture_handle,
+    TextureSubresourceRange const& subresource_range,
+    Offset3d const& origin,
+    Extent3d const& extent,
+    void const* data,
+    uint32_t row_pitch = 0
+  ) {
+    TextureWriteRegion const region {
+      .subresource_range = subresource_range,
+      .origin = origin,
+      .extent = extent,
+      .data = data,
+      .row_pitch = row_pitch,
+      .rows_per_image = 0,
+    };
+    return this->QueueWriteTexture(queue_id, texture_handle, container::ArrayProxy<TextureWriteRegion const>(&region, 1));
+  }
+
   /// Reads data from a GPU buffer into a CPU-accessible destination.
   ///
   /// The read is asynchronous. Data at `dst` is not valid until the
@@ -314,6 +475,50 @@ public:
     uint32_t size_in_bytes
   );
 
+  /// Reads pixel data from a texture into CPU memory with tightly packed
+  /// rows.
+  ///
+  /// Like `CopyTextureToBuffer`, the read always starts from texture origin
+  /// (0, 0, base_array_layer). Unlike it, rows are written to `dst` without
+  /// padding: the row stride is `width_in_blocks * texel_block_bytes` and
+  /// consecutive images follow each other directly. The images are the
+  /// `copy_extent.depth` slices of a 3D texture, or the
+  /// `subresource_range.array_layer_count` layers of an array texture, in
+  /// ascending order. The read is asynchronous. Data at `dst` is not valid
+  /// until the returned timeline value completes.
+  ///
+  /// - `queue_id`: **MUST** identify a valid queue.
+  /// - `texture_handle`: **MUST** have been created with `kTransferSrc`
+  ///   usage. **MUST** have sample count 1.
+  /// - `subresource_range`: `base_mip_level` **MUST** be less than the
+  ///   texture's mip level count. `array_layer_count` **MUST** be at least
+  ///   1, and 1 for 3D textures.
+  /// - `copy_extent`: **MUST** fit within the texture's mip level
+  ///   dimensions. For compressed formats, width and height **MUST** be
+  ///   multiples of the texel block dimensions. `depth` **MUST** be 1 for
+  ///   non-3D textures.
+  /// - `dst`: **MUST** remain valid until
+  ///   `QueueGetCompletedValue(queue_id) >= returned value`.
+  /// - `dst_size_in_bytes`: **MUST** be at least
+  ///   `width_in_blocks * texel_block_bytes * height_in_blocks *
+  ///   copy_extent.depth * subresource_range.array_layer_count`.
+  /// - Returns: An `IntraQueueSubmissionId`. Data at `dst` is valid once
+  ///   `QueueGetCompletedValue(queue_id) >= returned value`, or 0 if the
+  ///   read could not be issued.
+  ///
+  /// > **Note:** A single staging allocation is used per call. Backends
+  /// > whose copies require aligned row pitches (WebGPU) remove the padding
+  /// > while copying out of the staging memory; when the row size is already
+  /// > 256-byte aligned (e.g. 3840-wide RGBA8) this is a single `memcpy`.
+  _MNEXUS_VAPI(IntraQueueSubmissionId, QueueReadTexture,
+    QueueId const& queue_id,
+    TextureHandle texture_handle,
+    TextureSubresourceRange const& subresource_range,
+    Extent3d const& copy_extent,
+    void* dst,
+    uint64_t dst_size_in_bytes
+  );
+
   /// Returns the highest completed timeline value on the given queue.
   ///
   /// All operations that returned an `IntraQueueSubmissionId` <= this value
@@ -340,6 +545,55 @@ public:
     IntraQueueSubmissionId value
   );
 
+  /// Registers `callback` to be invoked once the given timeline value has
+  /// completed.
+  ///
+  /// When the callback runs, all operations with `IntraQueueSubmissionId` <=
+  /// `value` are complete, as if `QueueWaitIdle(queue_id, value)` had
+  /// returned.
+  ///
+  /// - `queue_id`: **MUST** identify a valid queue.
+  /// - `value`: **MUST** be 0 or a value returned by an operation on
+  ///   `queue_id`. Callbacks for 0 or an already-completed value are
+  ///   delivered promptly.
+  /// - `callback`: **MUST NOT** be null. Invoked exactly once, with `value`
+  ///   and `user_data`, unless the device is destroyed first.
+  /// - `user_data`: Passed through to `callback` unchanged.
+  ///
+  /// > **Note:** Callbacks are invoked on the device's completion thread, in
+  /// > ascending `value` order and in registration order for equal values.
+  /// > They may call back into the device but **SHOULD** return quickly, as
+  /// > they delay other notifications. Callbacks still pending when the
+  /// > device is destroyed are dropped. On the Web, where no completion
+  /// > thread can run, callbacks are invoked from `QueueGetCompletedValue`
+  /// > instead.
+  _MNEXUS_VAPI(void, QueueOnCompleted,
+    QueueId const& queue_id,
+    IntraQueueSubmissionId value,
+    MnQueueCompletedCallback callback,
+    void* user_data
+  );
+
+  /// Returns a native event that is signaled whenever the completed value
+  /// of the given queue advances.
+  ///
+  /// The event lets a job system park on GPU completion together with its
+  /// other OS waitables. After it fires, call `QueueGetCompletedValue` to
+  /// find out how far the queue has progressed.
+  ///
+  /// - `queue_id`: **MUST** identify a valid queue.
+  /// - Returns: The event, owned by the device and valid until the device is
+  ///   destroyed; the caller **MUST NOT** close it. -1 if not available.
+  ///
+  /// > **Note:** On Linux and Android the event is a non-blocking eventfd;
+  /// > read 8 bytes from it to reset it. On other POSIX platforms it is the
+  /// > read end of a non-blocking pipe; drain it to reset it. On Windows it
+  /// > is an auto-reset event `HANDLE`, reset by the wait that observes it.
+  /// > Not available on the Web.
+  _MNEXUS_VAPI(intptr_t, QueueGetCompletionEvent,
+    QueueId const& queue_id
+  );
+
   // ----------------------------------------------------------------------------------------------
   // Resource creation/acquisition.
   //
@@ -355,8 +609,14 @@ public:
   /// - Submit it via `QueueSubmitCommandList` (transfers ownership), or
   /// - Discard it via `DiscardCommandList`.
   ///
+  /// The command list **MUST** only be submitted to a queue of
+  /// `desc.queue_family_index`, and **MUST** only record commands that
+  /// family's capabilities support. Queues do not wait on each other: order
+  /// dependent work on different queues with `QueueWaitIdle`.
+  ///
   /// - `desc`: `queue_family_index` **MUST** be less than
-  ///   `QueueGetFamilyCount()`.
+  ///   `QueueGetFamilyCount()` and name a family whose
+  ///   `QueueFamilyDesc::queue_count` is non-zero.
   /// - Returns: A non-null `ICommandList` pointer.
   _MNEXUS_VAPI(ICommandList*, CreateCommandList, CommandListDesc const& desc);
 
@@ -395,6 +655,67 @@ public:
     BufferDesc& out_desc
   );
 
+  /// Returns a CPU pointer to the contents of a `kMappable` buffer.
+  ///
+  /// The mapping is not synchronized with the GPU. CPU writes reach the GPU
+  /// only through `FlushMappedBufferRange`, and GPU writes become readable
+  /// only through `InvalidateMappedBufferRange`. The caller **MUST NOT**
+  /// write a range that submitted-but-incomplete work reads, and **MUST**
+  /// wait on the queue timeline before invalidating a range that such work
+  /// writes.
+  ///
+  /// - `buffer_handle`: **MUST** have been created with `kMappable` usage.
+  ///   **MUST NOT** be mapped or unmapped concurrently from several threads.
+  /// - Returns: A pointer to byte 0 of the buffer, valid until
+  ///   `UnmapBuffer` or `DestroyBuffer`, or null if the buffer is not
+  ///   mappable. Mapping an already mapped buffer returns the same pointer.
+  ///
+  /// > **Note:** On Vulkan the pointer is the buffer's persistently mapped
+  /// > memory, so writing and flushing involves no intermediate copy.
+  /// > WebGPU cannot keep a buffer mapped while the GPU uses it. There, the
+  /// > pointer refers to a CPU shadow of the buffer, which
+  /// > `FlushMappedBufferRange` uploads with a queue write and
+  /// > `InvalidateMappedBufferRange` refreshes with a blocking readback.
+  _MNEXUS_VAPI(void*, MapBuffer,
+    BufferHandle buffer_handle
+  );
+
+  /// Ends a mapping established by `MapBuffer`.
+  ///
+  /// - `buffer_handle`: **MUST** be mapped. Writes that were not flushed
+  ///   before this call have undefined effect.
+  _MNEXUS_VAPI(void, UnmapBuffer,
+    BufferHandle buffer_handle
+  );
+
+  /// Makes CPU writes to a range of a mapped buffer visible to GPU
+  /// operations submitted after this call.
+  ///
+  /// - `buffer_handle`: **MUST** be mapped.
+  /// - `offset`, `size_in_bytes`: **MUST** be multiples of 4.
+  ///   `offset + size_in_bytes` **MUST NOT** exceed the buffer's size.
+  _MNEXUS_VAPI(void, FlushMappedBufferRange,
+    BufferHandle buffer_handle,
+    uint32_t offset,
+    uint32_t size_in_bytes
+  );
+
+  /// Makes GPU writes to a range of a mapped buffer visible through the
+  /// mapped pointer.
+  ///
+  /// - `buffer_handle`: **MUST** be mapped.
+  /// - `offset`, `size_in_bytes`: **MUST** be multiples of 4.
+  ///   `offset + size_in_bytes` **MUST NOT** exceed the buffer's size.
+  ///
+  /// > **Note:** Only writes of completed work are made visible. The WebGPU
+  /// > backend waits for the queue to drain the readback, so this call
+  /// > blocks there.
+  _MNEXUS_VAPI(void, InvalidateMappedBufferRange,
+    BufferHandle buffer_handle,
+    uint32_t offset,
+    uint32_t size_in_bytes
+  );
+
   //
   // Texture
   //
@@ -406,7 +727,7 @@ public:
   ///
   /// - Returns: A valid `TextureHandle` for the current backbuffer, or an
   ///   invalid handle if no surface is configured or the instance is
-  ///   headless.
+  ///   headless without an offscreen swapchain.
   _MNEXUS_VAPI(TextureHandle, GetSwapchainTexture);
 
   /// Creates a GPU texture.
@@ -420,6 +741,30 @@ public:
     TextureDesc const& desc
   );
 
+  /// Creates textures that share a single memory allocation, for transient
+  /// textures whose lifetimes do not overlap.
+  ///
+  /// - `descs`: Each entry **MUST** satisfy the requirements of
+  ///   `CreateTexture`.
+  /// - `out_textures`: **MUST** point to `descs.size()` handles. Receives
+  ///   one handle per entry, each destroyed with `DestroyTexture`.
+  /// - Returns: `MnBoolFalse` and writes nothing if the backend cannot place
+  ///   the textures in one allocation.
+  ///
+  /// Writing one texture of the group makes the contents of the others
+  /// undefined. The first use of a texture after another texture of its
+  /// group was written **MUST** be a `ICommandList::TransitionTextures`
+  /// with `discard_contents`, and the previous texture **MUST** have been
+  /// transitioned to `TextureAccess::kDiscarded`. The memory is released
+  /// once the last texture of the group is destroyed.
+  ///
+  /// > **Note:** Requires `GetAdapterCapability().texture_memory_aliasing`.
+  /// > The Vulkan backend binds the images to one VMA allocation.
+  _MNEXUS_VAPI(MnBool32, CreateAliasedTextures,
+    container::ArrayProxy<TextureDesc const> descs,
+    TextureHandle* out_textures
+  );
+
   /// Destroys a texture.
   ///
   /// - `texture_handle`: **MUST** be a valid handle returned by
@@ -445,19 +790,81 @@ public:
 
   /// Creates a texture sampler.
   ///
+  /// Samplers are deduplicated: calls with an identical `desc` return the
+  /// same handle and share one backend sampler. Each call adds a reference
+  /// that a matching `DestroySampler` call releases.
+  ///
   /// - Returns: A valid `SamplerHandle`.
   _MNEXUS_VAPI(SamplerHandle, CreateSampler,
     SamplerDesc const& desc
   );
 
-  /// Destroys a sampler.
+  /// Releases a reference to a sampler, destroying it with the last one.
   ///
   /// - `sampler_handle`: **MUST** be a valid handle. After this call, the
-  ///   handle is invalid and **MUST NOT** be used for any further API calls.
+  ///   caller's reference is gone and it **MUST NOT** use the handle for any
+  ///   further API calls, even if other references keep the sampler alive.
   _MNEXUS_VAPI(void, DestroySampler,
     SamplerHandle sampler_handle
   );
 
+  //
+  // Bindless Resources
+  //
+  // Opt-in alternative to per-draw binding: resources are registered once into device-wide tables bound at
+  // `kBindlessBindGroup`, and shaders index the tables with the returned indices (e.g. from push constants or a
+  // storage buffer). Programs that declare `kBindlessBindGroup` get the tables bound automatically; no `Bind*` call is
+  // needed or allowed for that group.
+  //
+  // An unregistered index is retired against the work submitted so far: it is only handed out again once every
+  // queue has completed the submissions made before the `Unregister*` call, so in-flight work never reads a slot
+  // that has been overwritten. The table does not keep the resource itself alive; the caller **MUST** unregister it
+  // before destroying it, and **MUST NOT** destroy it while submissions that read it through the table are pending.
+  //
+  // > **Note:** Requires `GetAdapterCapability().bindless_resources`. The functions return `kInvalidBindlessIndex`
+  // > (registration) or do nothing (unregistration) otherwise. The WebGPU backend has no descriptor indexing and never
+  // > reports the capability.
+  //
+
+  /// Registers a 2D view (2D array for more than one layer) of `subresource_range` of a texture in the sampled texture table
+  /// (`kBindlessSampledTextureBinding`).
+  ///
+  /// - `texture_handle`: **MUST** be a valid handle of a texture created with `TextureUsageFlagBits::kSampled`.
+  /// - Returns: The table index, or `kInvalidBindlessIndex` if the table is full or the capability is missing.
+  _MNEXUS_VAPI(uint32_t, RegisterBindlessSampledTexture,
+    TextureHandle texture_handle,
+    TextureSubresourceRange const& subresource_range
+  );
+
+  /// Registers a range of a buffer in the storage buffer table (`kBindlessStorageBufferBinding`).
+  ///
+  /// - `buffer_handle`: **MUST** be a valid handle of a buffer created with `BufferUsageFlagBits::kStorage`.
+  /// - Returns: The table index, or `kInvalidBindlessIndex` if the table is full or the capability is missing.
+  _MNEXUS_VAPI(uint32_t, RegisterBindlessStorageBuffer,
+    BufferHandle buffer_handle,
+    uint64_t offset,
+    uint64_t size
+  );
+
+  /// Registers a sampler in the sampler table (`kBindlessSamplerBinding`).
+  ///
+  /// - Returns: The table index, or `kInvalidBindlessIndex` if the table is full or the capability is missing.
+  _MNEXUS_VAPI(uint32_t, RegisterBindlessSampler,
+    SamplerHandle sampler_handle
+  );
+
+  /// Releases an index returned by `RegisterBindlessSampledTexture`. The index is reused once the work submitted
+  /// before this call has completed.
+  _MNEXUS_VAPI(void, UnregisterBindlessSampledTexture, uint32_t index);
+
+  /// Releases an index returned by `RegisterBindlessStorageBuffer`. The index is reused once the work submitted
+  /// before this call has completed.
+  _MNEXUS_VAPI(void, UnregisterBindlessStorageBuffer, uint32_t index);
+
+  /// Releases an index returned by `RegisterBindlessSampler`. The index is reused once the work submitted before
+  /// this call has completed.
+  _MNEXUS_VAPI(void, UnregisterBindlessSampler, uint32_t index);
+
   //
   // ShaderModule
   //
@@ -505,6 +912,10 @@ public:
 
   /// Destroys a program.
   ///
+  /// Submitted work that uses the program **MAY** still be in flight; the
+  /// backend releases it once that work has completed, together with any
+  /// render pipelines it cached for the program.
+  ///
   /// - `program_handle`: **MUST** be a valid handle. After this call, the
   ///   handle is invalid and **MUST NOT** be used for any further API calls.
   _MNEXUS_VAPI(void, DestroyProgram,
@@ -548,6 +959,58 @@ public:
     RenderPipelineDesc const& desc
   );
 
+  //
+  // RenderBundle
+  //
+
+  /// Creates a new render bundle encoder in the recording state.
+  ///
+  /// A render bundle captures draws once so that they can be replayed in any
+  /// number of render passes via `ICommandList::ExecuteBundles`, without
+  /// repeating pipeline resolution, bind group resolution and vertex/index
+  /// buffer binding per draw.
+  ///
+  /// The caller **MUST** eventually either:
+  /// - Finalize it via `FinishRenderBundleEncoder` (transfers ownership), or
+  /// - Discard it via `DiscardRenderBundleEncoder`.
+  ///
+  /// - `desc`: Render target signature. `desc.color_formats`,
+  ///   `desc.depth_stencil_format` and `desc.sample_count` **MUST** match the
+  ///   attachments of every render pass the bundle is executed in.
+  /// - Returns: A non-null `IRenderBundleEncoder` pointer.
+  _MNEXUS_VAPI(IRenderBundleEncoder*, CreateRenderBundleEncoder,
+    RenderBundleDesc const& desc
+  );
+
+  /// Finalizes a render bundle encoder and returns the recorded bundle.
+  ///
+  /// Ownership of `encoder` transfers to the device. The caller **MUST NOT**
+  /// use or reference `encoder` after this call.
+  ///
+  /// - `encoder`: **MUST** be non-null and **MUST** have been created by
+  ///   `CreateRenderBundleEncoder` on this device.
+  /// - Returns: A valid `RenderBundleHandle`.
+  _MNEXUS_VAPI(RenderBundleHandle, FinishRenderBundleEncoder,
+    IRenderBundleEncoder* encoder
+  );
+
+  /// Discards a render bundle encoder that was created but not finished.
+  _MNEXUS_VAPI(void, DiscardRenderBundleEncoder,
+    IRenderBundleEncoder* encoder
+  );
+
+  /// Destroys a render bundle.
+  ///
+  /// - `render_bundle_handle`: **MUST** be a valid handle. After this call,
+  ///   the handle is invalid and **MUST NOT** be used for any further API
+  ///   calls.
+  ///
+  /// > **Note:** Command lists that have already recorded the bundle via
+  /// > `ICommandList::ExecuteBundles` keep it alive until they complete.
+  _MNEXUS_VAPI(void, DestroyRenderBundle,
+    RenderBundleHandle render_bundle_handle
+  );
+
   //
   // Device Capability
   //
@@ -581,6 +1044,96 @@ public:
   /// synchronized with in-flight GPU work.
   _MNEXUS_VAPI(RenderPipelineCacheSnapshot, GetRenderPipelineCacheSnapshot);
 
+  /// Returns a point-in-time snapshot of the device's sampler cache.
+  ///
+  /// The snapshot includes hit/miss counts of `CreateSampler` and every
+  /// live sampler with its reference count.
+  _MNEXUS_VAPI(SamplerCacheSnapshot, GetSamplerCacheSnapshot);
+
+  /// Returns the device-wide CPU performance counters.
+  ///
+  /// The counters of a command list are added to the device totals when it
+  /// is submitted or discarded; command lists still being recorded are not
+  /// included. Device-level work (queue writes, submissions, resource pool
+  /// lookups) is counted as it happens.
+  ///
+  /// > **Note:** Counters are updated with relaxed atomics. The snapshot is
+  /// > not a consistent cut across counters while other threads are active.
+  _MNEXUS_VAPI(PerfCountersSnapshot, GetPerfCountersSnapshot);
+
+  /// Resets all device-wide CPU performance counters to zero.
+  _MNEXUS_VAPI(void, ResetPerfCounters);
+
+  /// Returns the device's memory usage: per-heap usage and budget, and the
+  /// live buffers and textures with their requested sizes.
+  ///
+  /// > **Note:** Heap budgets come from the driver where it reports them and
+  /// > are estimated from the heap size otherwise. The WebGPU backend cannot
+  /// > query heaps; `heaps` is empty and only the resource totals, counted
+  /// > on the CPU, are available.
+  _MNEXUS_VAPI(MemoryStats, GetMemoryStats);
+
+  /// Sets a callback invoked when the total size of live buffers and
+  /// textures (`MemoryStats::GetResourceSizeInBytes`) rises to or above
+  /// `threshold_in_bytes`.
+  ///
+  /// The callback fires once per crossing: it is not invoked again until the
+  /// total has dropped below the threshold and risen to it again.
+  ///
+  /// - `threshold_in_bytes`: 0 disables the callback.
+  /// - `callback`: Invoked with the new total and `user_data`. Null disables
+  ///   the callback. Replaces any previous callback.
+  ///
+  /// > **Note:** The callback runs on the thread whose `CreateBuffer` or
+  /// > `CreateTexture` crossed the threshold, after the resource has been
+  /// > created. It **MAY** call back into the device.
+  _MNEXUS_VAPI(void, SetMemoryThresholdCallback,
+    uint64_t threshold_in_bytes,
+    MnMemoryThresholdCallback callback,
+    void* user_data
+  );
+
+  /// Enables or disables GPU timestamp instrumentation.
+  ///
+  /// While enabled, command lists created afterwards write GPU timestamps at
+  /// debug group boundaries (`ICommandList::PushDebugGroup` /
+  /// `ICommandList::PopDebugGroup`) and at pass boundaries. The timestamps are
+  /// resolved asynchronously into a timing tree per submission, retrievable
+  /// via `GetGpuTimingReport`.
+  ///
+  /// Command lists already created are unaffected. Instrumentation is
+  /// disabled by default, and is silently ignored when
+  /// `GetAdapterCapability().timestamp_query` is `MnBoolFalse`.
+  ///
+  /// > **Note:** Command lists created while instrumentation is disabled
+  /// > carry no timing state and record no timestamp commands.
+  ///
+  /// > **Note:** The WebGPU backend can only write timestamps at pass
+  /// > boundaries. Debug groups are timed by the passes they enclose.
+  _MNEXUS_VAPI(void, SetGpuTimingEnabled, bool enabled);
+
+  /// Retrieves the GPU timing tree of a submitted command list.
+  ///
+  /// - `queue_id`: **MUST** identify a valid queue.
+  /// - `submission_id`: Value returned by `QueueSubmitCommandList`.
+  /// - `out_report`: Populated on success.
+  /// - Returns: `MnBoolTrue` on success. `MnBoolFalse` if the submission has
+  ///   not completed yet, was recorded without instrumentation, or its report
+  ///   has been evicted.
+  ///
+  /// ## Post-conditions
+  /// - Once `QueueGetCompletedValue(queue_id) >= submission_id`, the report
+  ///   of an instrumented submission is available until evicted.
+  ///
+  /// > **Note:** Reports are resolved as submissions complete, whether or
+  /// > not they are ever retrieved. Only the 64 most recently resolved
+  /// > reports, across all queues, are retained.
+  _MNEXUS_VAPI(MnBool32, GetGpuTimingReport,
+    QueueId const& queue_id,
+    IntraQueueSubmissionId submission_id,
+    GpuTimingReport& out_report
+  );
+
 protected:
   IDevice() = default;
 };
@@ -593,7 +1146,8 @@ protected:
 /// different thread is undefined behavior.
 ///
 /// Different `ICommandList` instances **MAY** be recorded concurrently on
-/// different threads.
+/// different threads. A command list **MAY** be submitted or discarded on
+/// any thread once `End()` has returned.
 class ICommandList {
 public:
   virtual ~ICommandList() = default;
@@ -668,6 +1222,44 @@ public:
     SamplerHandle sampler_handle
   );
 
+  //
+  // Push Constants
+  //
+
+  /// Updates `[offset, offset + size_in_bytes)` of the push constant block
+  /// of the bound program. The data is copied at the call and reaches the
+  /// shaders at the next `DispatchCompute`/`Draw`/`DrawIndexed`; bytes not
+  /// written keep their previous value, also across pipeline changes.
+  ///
+  /// Meant for small per-dispatch/per-draw data that would otherwise need a
+  /// uniform buffer write and a fresh descriptor set or bind group.
+  ///
+  /// - `stages`: The stages reading the updated range. **MUST** be a subset
+  ///   of the stages that declare the push constant block in the bound
+  ///   program.
+  /// - `offset`, `size_in_bytes`: **MUST** be multiples of 4.
+  ///   `offset + size_in_bytes` **MUST NOT** exceed
+  ///   `kMaxPushConstantSizeInBytes`.
+  ///
+  /// > **Note:** The Vulkan backend records `vkCmdPushConstants`. The WebGPU
+  /// > backend emulates push constants with a uniform buffer at bind group
+  /// > 3, binding 0, bound with a dynamic offset into per-command-list
+  /// > scratch memory. Programs declaring a push constant block therefore
+  /// > **MUST NOT** use bind group 3, and the block **MUST** satisfy uniform
+  /// > buffer (std140) layout rules.
+  _MNEXUS_VAPI(void, SetPushConstants,
+    ShaderStageFlags stages,
+    uint32_t offset,
+    void const* data,
+    uint32_t size_in_bytes
+  );
+
+  template<typename T>
+  void SetPushConstants(ShaderStageFlags stages, uint32_t offset, T const& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    this->SetPushConstants(stages, offset, &value, static_cast<uint32_t>(sizeof(T)));
+  }
+
   //
   // Render Pass
   //
@@ -782,6 +1374,29 @@ public:
     int32_t x, int32_t y, uint32_t width, uint32_t height
   );
 
+  //
+  // Render Bundle
+  //
+
+  /// Replays previously recorded render bundles in the current render pass.
+  ///
+  /// - `render_bundles`: Each handle **MUST** be a valid `RenderBundleHandle`
+  ///   whose `RenderBundleDesc` matches the attachments of the current render
+  ///   pass.
+  ///
+  /// ## Pre-conditions
+  /// - The command list **MUST** be inside a render pass scope.
+  ///
+  /// ## Post-conditions
+  /// - Render state accumulated on this command list (program, fixed-function
+  ///   state, resource bindings, vertex/index buffers) is unaffected by the
+  ///   bundles and is re-applied at the next `Draw`/`DrawIndexed`.
+  /// - Viewport and scissor are inherited by the bundles from the render
+  ///   pass, and are unchanged after this call.
+  _MNEXUS_VAPI(void, ExecuteBundles,
+    container::ArrayProxy<RenderBundleHandle const> render_bundles
+  );
+
   //
   // Transfer
   //
@@ -847,7 +1462,8 @@ public:
   /// > stride of `Align(width_in_blocks * texel_block_bytes, 256)`. Rows
   /// > may be padded to a 256-byte boundary. Callers that read the buffer
   /// > back (e.g. via `QueueReadBuffer`) must account for this padding
-  /// > when the image width is not 256-byte aligned.
+  /// > when the image width is not 256-byte aligned. `QueueReadTexture`
+  /// > reads a texture into CPU memory with tightly packed rows instead.
   _MNEXUS_VAPI(void, CopyTextureToBuffer,
     TextureHandle src_texture_handle,
     TextureSubresourceRange const& src_subresource_range,
@@ -868,6 +1484,53 @@ public:
     Filter filter
   );
 
+  /// Generates mip levels on the GPU, each as a 2x2 box filter of the level
+  /// above it.
+  ///
+  /// `subresource_range.base_mip_level` is the source and is not written;
+  /// levels `base_mip_level + 1` through
+  /// `base_mip_level + mip_level_count - 1` are generated for every array
+  /// layer in the range. Odd dimensions clamp the filter footprint to the
+  /// edge of the source level.
+  ///
+  /// - `texture_handle`: **MUST** be a 2D color texture created with
+  ///   `kTransferSrc | kTransferDst` usage and a filterable, renderable
+  ///   format. On Vulkan, a format without linear-filtered blit support
+  ///   logs an error and leaves the levels untouched.
+  /// - `subresource_range`: **MUST** lie within the texture's mip levels and
+  ///   array layers. A `mip_level_count` below 2 is a no-op.
+  ///
+  /// > **Note:** The WebGPU backend downsamples formats with storage texture
+  /// > support in compute, up to four levels per dispatch, and falls back
+  /// > to a chained blit otherwise. The blit fallback and the Vulkan
+  /// > backend's chain of linear `vkCmdBlitImage` calls both read the
+  /// > even-sized part of each source level, which is the same box filter.
+  _MNEXUS_VAPI(void, GenerateMipmaps,
+    TextureHandle texture_handle,
+    TextureSubresourceRange const& subresource_range
+  );
+
+  //
+  // Synchronization
+  //
+
+  /// Prepares textures for the accesses that follow, in a single barrier.
+  ///
+  /// Commands recorded afterwards that access a texture the way it was
+  /// prepared for skip their own barrier for it. Backends with implicit
+  /// synchronization **MAY** ignore this call.
+  ///
+  /// - `transitions`: Each texture **MUST** have been created with the usage
+  ///   its `access` requires. A texture **MUST NOT** appear twice.
+  ///
+  /// > **Note:** The Vulkan backend records one `vkCmdPipelineBarrier2`;
+  /// > `discard_contents` transitions from `VK_IMAGE_LAYOUT_UNDEFINED` and
+  /// > waits for all prior memory writes, since the memory may be aliased.
+  /// > The WebGPU backend ignores the call.
+  _MNEXUS_VAPI(void, TransitionTextures,
+    container::ArrayProxy<TextureTransitionDesc const> transitions
+  );
+
   //
   // Diagnostics
   //
@@ -877,10 +1540,134 @@ public:
   /// returned log to start capturing structured events.
   _MNEXUS_VAPI(RenderStateEventLog&, GetStateEventLog);
 
+  /// Returns the CPU performance counters accumulated by this command list
+  /// so far. See `IDevice::GetPerfCountersSnapshot`.
+  _MNEXUS_VAPI(PerfCountersSnapshot, GetPerfCountersSnapshot);
+
 protected:
   ICommandList() = default;
 };
 
+/// Records draws into a reusable render bundle. See
+/// `IDevice::CreateRenderBundleEncoder`.
+///
+/// The recording surface is the draw-related subset of `ICommandList`. All
+/// methods follow the same semantics as their `ICommandList` counterparts,
+/// except that no render pass scope is involved: the render target signature
+/// is fixed by the `RenderBundleDesc` the encoder was created with.
+///
+/// ## Thread Safety
+///
+/// A render bundle encoder is **thread-affine** in the same way as
+/// `ICommandList`. A finished bundle **MAY** be executed from any command
+/// list on any thread.
+class IRenderBundleEncoder {
+public:
+  virtual ~IRenderBundleEncoder() = default;
+
+  //
+  // Explicit Pipeline Binding
+  //
+
+  _MNEXUS_VAPI(void, BindExplicitRenderPipeline, RenderPipelineHandle render_pipeline_handle);
+
+  //
+  // Resource Binding
+  //
+
+  _MNEXUS_VAPI(void, BindUniformBuffer,
+    BindingId const& id,
+    BufferHandle buffer_handle,
+    uint64_t offset,
+    uint64_t size
+  );
+
+  _MNEXUS_VAPI(void, BindStorageBuffer,
+    BindingId const& id,
+    BufferHandle buffer_handle,
+    uint64_t offset,
+    uint64_t size
+  );
+
+  _MNEXUS_VAPI(void, BindSampledTexture,
+    BindingId const& id,
+    TextureHandle texture_handle,
+    TextureSubresourceRange const& subresource_range
+  );
+
+  _MNEXUS_VAPI(void, BindSampler,
+    BindingId const& id,
+    SamplerHandle sampler_handle
+  );
+
+  //
+  // Render State (auto-generation path)
+  //
+
+  _MNEXUS_VAPI(void, BindRenderProgram, ProgramHandle program_handle);
+
+  _MNEXUS_VAPI(void, SetVertexInputLayout,
+    container::ArrayProxy<VertexInputBindingDesc const> bindings,
+    container::ArrayProxy<VertexInputAttributeDesc const> attributes
+  );
+
+  _MNEXUS_VAPI(void, BindVertexBuffer,
+    uint32_t binding,
+    BufferHandle buffer_handle,
+    uint64_t offset
+  );
+
+  _MNEXUS_VAPI(void, BindIndexBuffer,
+    BufferHandle buffer_handle,
+    uint64_t offset,
+    IndexType index_type
+  );
+
+  _MNEXUS_VAPI(void, SetPrimitiveTopology, PrimitiveTopology topology);
+  _MNEXUS_VAPI(void, SetPolygonMode, PolygonMode mode);
+  _MNEXUS_VAPI(void, SetCullMode, CullMode cull_mode);
+  _MNEXUS_VAPI(void, SetFrontFace, FrontFace front_face);
+
+  _MNEXUS_VAPI(void, SetDepthTestEnabled, bool enabled);
+  _MNEXUS_VAPI(void, SetDepthWriteEnabled, bool enabled);
+  _MNEXUS_VAPI(void, SetDepthCompareOp, CompareOp op);
+
+  _MNEXUS_VAPI(void, SetStencilTestEnabled, bool enabled);
+  _MNEXUS_VAPI(void, SetStencilFrontOps,
+    StencilOp fail, StencilOp pass, StencilOp depth_fail, CompareOp compare);
+  _MNEXUS_VAPI(void, SetStencilBackOps,
+    StencilOp fail, StencilOp pass, StencilOp depth_fail, CompareOp compare);
+
+  _MNEXUS_VAPI(void, SetBlendEnabled, uint32_t attachment, bool enabled);
+  _MNEXUS_VAPI(void, SetBlendFactors,
+    uint32_t attachment,
+    BlendFactor src_color, BlendFactor dst_color, BlendOp color_op,
+    BlendFactor src_alpha, BlendFactor dst_alpha, BlendOp alpha_op);
+  _MNEXUS_VAPI(void, SetColorWriteMask, uint32_t attachment, ColorWriteMask mask);
+
+  //
+  // Draw
+  //
+
+  _MNEXUS_VAPI(void, Draw,
+    uint32_t vertex_count,
+    uint32_t instance_count,
+    uint32_t first_vertex,
+    uint32_t first_instance
+  );
+
+  _MNEXUS_VAPI(void, DrawIndexed,
+    uint32_t index_count,
+    uint32_t instance_count,
+    uint32_t first_index,
+    int32_t vertex_offset,
+    uint32_t first_instance
+  );
+
+protected:
+  IRenderBundleEncoder() = default;
+};
+
 //
 // Wrappers around handles to provide easy access to resource descriptions etc.
 //
@@ -959,6 +1746,14 @@ MNEXUS_NO_THROW MnResourceHandle MNEXUS_CALL MnDeviceCreateBuffer(
   MnDevice device, MnBufferDesc const* desc);
 MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceDestroyBuffer(
   MnDevice device, MnResourceHandle handle);
+MNEXUS_NO_THROW void* MNEXUS_CALL MnDeviceMapBuffer(
+  MnDevice device, MnResourceHandle handle);
+MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceUnmapBuffer(
+  MnDevice device, MnResourceHandle handle);
+MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceFlushMappedBufferRange(
+  MnDevice device, MnResourceHandle handle, uint32_t offset, uint32_t size);
+MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceInvalidateMappedBufferRange(
+  MnDevice device, MnResourceHandle handle, uint32_t offset, uint32_t size);
 
 MNEXUS_NO_THROW MnResourceHandle MNEXUS_CALL MnDeviceCreateShaderModule(
   MnDevice device, MnShaderModuleDesc const* desc);
@@ -982,6 +1777,11 @@ MNEXUS_NO_THROW MnIntraQueueSubmissionId MNEXUS_CALL MnDeviceQueueWriteBuffer(
   MnResourceHandle buffer, uint32_t offset,
   void const* data, uint32_t size);
 
+MNEXUS_NO_THROW MnIntraQueueSubmissionId MNEXUS_CALL MnDeviceQueueWriteTexture(
+  MnDevice device, MnQueueId const* queue_id,
+  MnResourceHandle texture,
+  MnTextureWriteRegion const* regions, uint32_t region_count);
+
 MNEXUS_NO_THROW MnIntraQueueSubmissionId MNEXUS_CALL MnDeviceQueueSubmitCommandList(
   MnDevice device, MnQueueId const* queue_id, MnCommandList command_list);
 
@@ -990,8 +1790,19 @@ MNEXUS_NO_THROW MnIntraQueueSubmissionId MNEXUS_CALL MnDeviceQueueReadBuffer(
   MnResourceHandle buffer, uint32_t offset,
   void* dst, uint32_t size);
 
+MNEXUS_NO_THROW MnIntraQueueSubmissionId MNEXUS_CALL MnDeviceQueueReadTexture(
+  MnDevice device, MnQueueId const* queue_id,
+  MnResourceHandle texture, MnTextureSubresourceRange const* range,
+  MnExtent3d const* extent,
+  void* dst, uint64_t dst_size);
+
 MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceQueueWaitIdle(
   MnDevice device, MnQueueId const* queue_id, MnIntraQueueSubmissionId value);
+MNEXUS_NO_THROW void MNEXUS_CALL MnDeviceQueueOnCompleted(
+  MnDevice device, MnQueueId const* queue_id, MnIntraQueueSubmissionId value,
+  MnQueueCompletedCallback callback, void* user_data);
+MNEXUS_NO_THROW intptr_t MNEXUS_CALL MnDeviceQueueGetCompletionEvent(
+  MnDevice device, MnQueueId const* queue_id);
 
 // ----------------------------------------------------------------------------------------------------
 // ICommandList
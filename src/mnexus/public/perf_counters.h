@@ -0,0 +1,48 @@
+#pragma once
+
+#if defined(__cplusplus)
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+namespace mnexus {
+
+// ----------------------------------------------------------------------------------------------------
+// CPU performance counters
+//
+
+/// Point-in-time values of the CPU-side performance counters, either of a
+/// single command list or aggregated over a device.
+///
+/// Counters that a backend has no equivalent for stay zero (e.g. WebGPU
+/// emits no explicit barriers, Vulkan creates no bind groups).
+struct PerfCountersSnapshot final {
+  /// `Draw` and `DrawIndexed` calls.
+  uint64_t draw_count = 0;
+  /// `DispatchCompute` calls.
+  uint64_t dispatch_count = 0;
+  /// Native pipeline objects bound on the underlying command encoder.
+  uint64_t pipeline_switch_count = 0;
+  /// Render pipeline cache lookups that found an existing pipeline.
+  uint64_t pipeline_cache_hits = 0;
+  /// Render pipeline cache lookups that created a new pipeline.
+  uint64_t pipeline_cache_misses = 0;
+  /// Native bind groups created for resource binding (WebGPU).
+  uint64_t bind_group_creations = 0;
+  /// Descriptor sets resolved through the descriptor set allocator for
+  /// resource binding (Vulkan). Includes sets served from its cache.
+  uint64_t descriptor_set_allocations = 0;
+  /// Individual memory/image barriers emitted.
+  uint64_t barriers_emitted = 0;
+  /// Resource pool handle lookups. Device-wide only; always zero in
+  /// per-command-list snapshots.
+  uint64_t resource_pool_lookups = 0;
+  /// Bytes uploaded through the device's queue write paths.
+  uint64_t staging_bytes_uploaded = 0;
+  /// Command lists submitted.
+  uint64_t submit_count = 0;
+};
+
+} // namespace mnexus
+
+#endif // defined(__cplusplus)
@@ -0,0 +1,43 @@
+#pragma once
+
+#if defined(__cplusplus)
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+namespace mnexus {
+
+// ----------------------------------------------------------------------------------------------------
+// Present statistics
+//
+
+/// Snapshot returned by `INexus::GetPresentStats`. Times are CPU wall-clock times in nanoseconds.
+struct PresentStats final {
+  /// `INexus::OnPresentEpilogue` calls since creation or the last `INexus::ResetPresentStats`.
+  uint64_t frame_count = 0;
+
+  /// Time from the previous `OnPresentEpilogue` to this frame's. The first frame after creation or a reset is
+  /// measured from its `OnPresentPrologue`.
+  uint64_t last_cpu_frame_time_ns = 0;
+  uint64_t max_cpu_frame_time_ns = 0;
+  uint64_t total_cpu_frame_time_ns = 0;
+
+  /// Time spent in `OnPresentPrologue`, which blocks while the next swapchain image is still queued for display.
+  uint64_t last_stall_time_ns = 0;
+  uint64_t max_stall_time_ns = 0;
+  uint64_t total_stall_time_ns = 0;
+
+  /// Presented images still queued for display right after a present.
+  ///
+  /// > **Note:** Only tracked for the offscreen swapchain (`NexusDesc::offscreen_swapchain`); 0 otherwise.
+  uint32_t last_queue_depth = 0;
+  uint32_t max_queue_depth = 0;
+
+  [[nodiscard]] uint64_t GetAverageCpuFrameTimeNs() const {
+    return frame_count != 0 ? total_cpu_frame_time_ns / frame_count : 0;
+  }
+};
+
+} // namespace mnexus
+
+#endif // defined(__cplusplus)
@@ -5,6 +5,8 @@
 // c++ headers ------------------------------------------
 #include <cstdint>
 
+#include <array>
+#include <deque>
 #include <vector>
 
 // public project headers -------------------------------
@@ -43,9 +45,10 @@ enum class RenderStateEventTag : uint8_t {
 // Event
 //
 
-/// A single recorded render-state event.
-/// Carries a full pipeline state snapshot so that the complete state is
-/// directly available at any event index without replay.
+/// A single recorded render-state event, as returned by
+/// `RenderStateEventLog::GetEvent`. The log stores events delta-encoded;
+/// `state` is the full pipeline state snapshot reconstructed from the
+/// nearest keyframe.
 struct RenderStateEvent final {
   RenderStateEventTag tag;
   RenderPipelineStateSnapshot state;
@@ -61,23 +64,94 @@ struct RenderStateEvent final {
 
 /// Per-command-list structured event log for render pipeline state changes.
 /// Recording is opt-in: when disabled, `Record` / `RecordPso` are no-ops.
+///
+/// Events are stored delta-encoded: each event keeps only the state fields
+/// that changed since the previous event, and a full keyframe is taken every
+/// `GetKeyframeInterval()` events (and whenever the render target or vertex
+/// input configuration changes). `GetEvent` reconstructs the full snapshot
+/// on demand.
+///
+/// By default the log grows without bound. `SetRingCapacity` switches it to
+/// a fixed-capacity ring that retains only the most recent events, which is
+/// cheap enough to leave enabled for crash diagnostics.
 class RenderStateEventLog final {
 public:
+  static constexpr uint32_t kDefaultKeyframeInterval = 64;
+
   void SetEnabled(bool enabled);
   [[nodiscard]] bool IsEnabled() const;
 
+  /// Sets the maximum number of retained events. `0` (the default) means
+  /// unbounded. Clears the log.
+  void SetRingCapacity(uint32_t capacity);
+  [[nodiscard]] uint32_t GetRingCapacity() const;
+
+  /// Sets the number of events between periodic keyframes. Larger values
+  /// use less memory but make `GetEvent` slower. Clears the log.
+  void SetKeyframeInterval(uint32_t interval);
+  [[nodiscard]] uint32_t GetKeyframeInterval() const;
+
   void Record(RenderStateEventTag tag,
               RenderPipelineStateSnapshot const& state);
   void RecordPso(RenderPipelineStateSnapshot const& state,
                  size_t hash, bool cache_hit);
 
+  /// Number of retained events. Index `0` is the oldest retained event.
   [[nodiscard]] uint32_t GetCount() const;
-  [[nodiscard]] RenderStateEvent const& GetEvent(uint32_t index) const;
+  /// Number of events recorded since the last `Clear`, including those
+  /// evicted from the ring.
+  [[nodiscard]] uint64_t GetTotalRecordedCount() const;
+  /// Reconstructs the retained event at `index`.
+  [[nodiscard]] RenderStateEvent GetEvent(uint32_t index) const;
   void Clear();
 
 private:
+  /// Upper bound of field deltas stored inline in an event. Changes touching
+  /// more fields are stored as keyframes.
+  static constexpr uint32_t kMaxInlineDeltas = 6;
+
+  struct FieldDelta final {
+    uint64_t value = 0;
+    uint8_t  field = 0;
+    uint8_t  attachment = 0;
+  };
+
+  struct EncodedEvent final {
+    RenderStateEventTag tag = RenderStateEventTag::kBeginRenderPass;
+    bool    cache_hit = false;
+    bool    keyframe = false;
+    uint8_t delta_count = 0;
+    size_t  pso_hash = 0;
+    std::array<FieldDelta, kMaxInlineDeltas> deltas = {};
+  };
+
+  struct Keyframe final {
+    uint64_t sequence = 0;
+    RenderPipelineStateSnapshot state;
+  };
+
+  void Append(RenderStateEventTag tag,
+              RenderPipelineStateSnapshot const& state,
+              size_t hash, bool cache_hit);
+  [[nodiscard]] EncodedEvent const& EventAt(uint64_t sequence) const;
+  static void ApplyDelta(RenderPipelineStateSnapshot& state, FieldDelta const& delta);
+
   bool enabled_ = false;
-  std::vector<RenderStateEvent> events_;
+  uint32_t ring_capacity_ = 0;
+  uint32_t keyframe_interval_ = kDefaultKeyframeInterval;
+
+  // Sequence numbers of the oldest retained event and of the next event.
+  uint64_t first_sequence_ = 0;
+  uint64_t next_sequence_ = 0;
+
+  // Unbounded: indexed by `sequence - first_sequence_`. Ring: indexed by
+  // `sequence % ring_capacity_`.
+  std::vector<EncodedEvent> events_;
+  // Ordered by sequence. In ring mode the front keyframe is kept at the
+  // oldest retained event.
+  std::deque<Keyframe> keyframes_;
+  // State after the most recent event; deltas are computed against it.
+  RenderPipelineStateSnapshot current_;
 };
 
 } // namespace mnexus
@@ -0,0 +1,49 @@
+#pragma once
+
+#if defined(__cplusplus)
+
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/types.h"
+
+namespace mnexus {
+
+/// Aggregate counters of the sampler cache.
+struct SamplerCacheDiagnosticsSnapshot final {
+  /// `CreateSampler` calls.
+  uint64_t total_lookups = 0;
+  /// Calls that returned an existing sampler.
+  uint64_t cache_hits = 0;
+  /// Calls that created a new backend sampler.
+  uint64_t cache_misses = 0;
+  /// Distinct samplers currently alive.
+  uint64_t cached_sampler_count = 0;
+
+  [[nodiscard]] double HitRate() const {
+    return total_lookups > 0
+      ? static_cast<double>(cache_hits) / static_cast<double>(total_lookups)
+      : 0.0;
+  }
+};
+
+/// A single entry in the sampler cache snapshot.
+struct SamplerCacheEntry final {
+  SamplerDesc desc;
+  SamplerHandle handle;
+  /// Outstanding `CreateSampler` calls not yet matched by `DestroySampler`.
+  uint32_t reference_count = 0;
+};
+
+/// Complete snapshot of the sampler cache contents and diagnostics.
+struct SamplerCacheSnapshot final {
+  SamplerCacheDiagnosticsSnapshot diagnostics;
+  std::vector<SamplerCacheEntry> entries;
+};
+
+} // namespace mnexus
+
+#endif // defined(__cplusplus)
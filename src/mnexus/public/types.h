@@ -121,6 +121,9 @@ typedef struct MnAdapterCapability _MN_FINAL {
   MnBool32 polygon_mode_line _MN_INIT(MnBoolFalse);
   MnBool32 polygon_mode_point _MN_INIT(MnBoolFalse);
   MnBool32 buffer_mappable _MN_INIT(MnBoolFalse);
+  MnBool32 timestamp_query _MN_INIT(MnBoolFalse);
+  MnBool32 bindless_resources _MN_INIT(MnBoolFalse);
+  MnBool32 texture_memory_aliasing _MN_INIT(MnBoolFalse);
   // N.B.: See `mnexus::AdapterCapability`.
 } MnAdapterCapability;
 
@@ -189,6 +192,7 @@ typedef enum MnBufferUsageFlagBits {
   MnBufferUsageFlagBitTransferDst     = 1 << 5,
   MnBufferUsageFlagBitIndirect        = 1 << 6,
   MnBufferUsageFlagBitMappable        = 1 << 7,
+  MnBufferUsageFlagBitConcurrentQueueFamilies = 1 << 8,
   MnBufferUsageFlagForce32            = 0x7FFFFFFF,
 } MnBufferUsageFlagBits;
 typedef uint32_t MnBufferUsageFlags;
@@ -211,6 +215,7 @@ typedef enum MnTextureUsageFlagBits {
   MnTextureUsageFlagBitUnorderedAccess = 1 << 3,
   MnTextureUsageFlagBitTransferSrc     = 1 << 4,
   MnTextureUsageFlagBitTransferDst     = 1 << 5,
+  MnTextureUsageFlagBitConcurrentQueueFamilies = 1 << 6,
   MnTextureUsageFlagForce32            = 0x7FFFFFFF,
 } MnTextureUsageFlagBits;
 typedef uint32_t MnTextureUsageFlags;
@@ -266,6 +271,16 @@ typedef struct MnTextureSubresourceRange _MN_FINAL {
   // N.B.: See `mnexus::TextureSubresourceRange`.
 } MnTextureSubresourceRange;
 
+typedef struct MnTextureWriteRegion _MN_FINAL {
+  MnTextureSubresourceRange subresource_range;
+  MnOffset3d origin;
+  MnExtent3d extent;
+  void const* data _MN_INIT(_MN_NULL);
+  uint32_t row_pitch _MN_INIT(0);
+  uint32_t rows_per_image _MN_INIT(0);
+  // N.B.: See `mnexus::TextureWriteRegion`.
+} MnTextureWriteRegion;
+
 // ----------------------------------------------------------------------------------------------------
 // Format
 //
@@ -414,6 +429,15 @@ typedef enum MnShaderSourceLanguage {
   MnShaderSourceLanguageForce32 = 0x7FFFFFFF,
 } MnShaderSourceLanguage;
 
+typedef enum MnShaderStageFlagBits {
+  MnShaderStageFlagBitNone     = 0,
+  MnShaderStageFlagBitVertex   = 1 << 0,
+  MnShaderStageFlagBitFragment = 1 << 1,
+  MnShaderStageFlagBitCompute  = 1 << 2,
+  MnShaderStageFlagForce32     = 0x7FFFFFFF,
+} MnShaderStageFlagBits;
+typedef uint32_t MnShaderStageFlags;
+
 typedef struct MnShaderModuleDesc _MN_FINAL {
   MnShaderSourceLanguage source_language _MN_INIT(MnShaderSourceLanguageSpirV);
   uint64_t code_ptr _MN_INIT(0);
@@ -760,6 +784,11 @@ struct AdapterCapability final {
   MnBool32 polygon_mode_line = MnBoolFalse;
   MnBool32 polygon_mode_point = MnBoolFalse;
   MnBool32 buffer_mappable = MnBoolFalse;
+  MnBool32 timestamp_query = MnBoolFalse;
+  /// Whether `IDevice::RegisterBindlessSampledTexture` and friends are available.
+  MnBool32 bindless_resources = MnBoolFalse;
+  /// Whether `IDevice::CreateAliasedTextures` is available.
+  MnBool32 texture_memory_aliasing = MnBoolFalse;
   // N.B.: See `MnAdapterCapability`.
 };
 _MNEXUS_STATIC_ASSERT_ABI_EQUIVALENCE(AdapterCapability, MnAdapterCapability);
@@ -789,6 +818,7 @@ _MNEXUS_DEFINE_TYPESAFE_HANDLE(ProgramHandle);
 _MNEXUS_DEFINE_TYPESAFE_HANDLE(ComputePipelineHandle);
 _MNEXUS_DEFINE_TYPESAFE_HANDLE(RenderPipelineHandle);
 _MNEXUS_DEFINE_TYPESAFE_HANDLE(SamplerHandle);
+_MNEXUS_DEFINE_TYPESAFE_HANDLE(RenderBundleHandle);
 
 // Resource type tags embedded in bits 59-63 of the handle's u64 representation.
 // Type 0 is reserved for null/invalid handles.
@@ -800,6 +830,7 @@ inline constexpr uint8_t kResourceTypeProgram         = 4;
 inline constexpr uint8_t kResourceTypeComputePipeline = 5;
 inline constexpr uint8_t kResourceTypeRenderPipeline  = 6;
 inline constexpr uint8_t kResourceTypeSampler         = 7;
+inline constexpr uint8_t kResourceTypeRenderBundle    = 8;
 
 // ----------------------------------------------------------------------------------------------------
 // Queue
@@ -887,6 +918,8 @@ enum class BufferUsageFlagBits : uint32_t {
   kTransferDst   = MnBufferUsageFlagBitTransferDst,
   kIndirect      = MnBufferUsageFlagBitIndirect,
   kMappable      = MnBufferUsageFlagBitMappable,
+  /// Usable by queues of several families without ownership transfers; see `IDevice::QueueGetFamilyDesc`.
+  kConcurrentQueueFamilies = MnBufferUsageFlagBitConcurrentQueueFamilies,
 };
 MBASE_DEFINE_ENUM_CLASS_BITFLAGS_OPERATORS(BufferUsageFlagBits);
 using BufferUsageFlags = mbase::BitFlags<BufferUsageFlagBits>;
@@ -908,6 +941,8 @@ enum class TextureUsageFlagBits : uint32_t {
   kUnorderedAccess  = MnTextureUsageFlagBitUnorderedAccess,
   kTransferSrc      = MnTextureUsageFlagBitTransferSrc,
   kTransferDst      = MnTextureUsageFlagBitTransferDst,
+  /// Usable by queues of several families without ownership transfers; see `IDevice::QueueGetFamilyDesc`.
+  kConcurrentQueueFamilies = MnTextureUsageFlagBitConcurrentQueueFamilies,
 };
 MBASE_DEFINE_ENUM_CLASS_BITFLAGS_OPERATORS(TextureUsageFlagBits);
 using TextureUsageFlags = mbase::BitFlags<TextureUsageFlagBits>;
@@ -965,6 +1000,26 @@ struct TextureSubresourceRange final {
 };
 _MNEXUS_STATIC_ASSERT_ABI_EQUIVALENCE(TextureSubresourceRange, MnTextureSubresourceRange);
 
+/// One region of a `IDevice::QueueWriteTexture` call.
+///
+/// `data` holds, for each array layer in `subresource_range`, `extent.depth`
+/// images of `rows_per_image` rows (in texel blocks) every `row_pitch`
+/// bytes. Neither pitch has an alignment requirement.
+struct TextureWriteRegion final {
+  /// `mip_level_count` **MUST** be 1.
+  TextureSubresourceRange subresource_range;
+  /// Texel offset within the mip level. For compressed formats, **MUST** be
+  /// a multiple of the texel block dimensions.
+  Offset3d origin;
+  Extent3d extent;
+  void const* data = nullptr;
+  /// Bytes between rows of texel blocks. 0 means tightly packed.
+  uint32_t row_pitch = 0;
+  /// Rows of texel blocks between images. 0 means tightly packed.
+  uint32_t rows_per_image = 0;
+};
+_MNEXUS_STATIC_ASSERT_ABI_EQUIVALENCE(TextureWriteRegion, MnTextureWriteRegion);
+
 // ----------------------------------------------------------------------------------------------------
 // Format (C++ enum class referencing the C MnFormat values)
 //
@@ -1081,6 +1136,26 @@ struct TextureDesc final {
 };
 _MNEXUS_STATIC_ASSERT_ABI_EQUIVALENCE(TextureDesc, MnTextureDesc);
 
+/// What `ICommandList::TransitionTextures` prepares a texture for.
+enum class TextureAccess : uint32_t {
+  kSampled,
+  kUnorderedAccess,
+  kAttachment,
+  kTransferSrc,
+  kTransferDst,
+  /// The contents are no longer needed. The texture is not restored to its resting state at `ICommandList::End`,
+  /// and its next transition **MUST** set `discard_contents`.
+  kDiscarded,
+};
+
+struct TextureTransitionDesc final {
+  TextureHandle texture;
+  TextureSubresourceRange subresource_range;
+  TextureAccess access = TextureAccess::kSampled;
+  /// The previous contents **MAY** be thrown away, which lets the backend skip preserving them.
+  bool discard_contents = false;
+};
+
 // ----------------------------------------------------------------------------------------------------
 // Shader
 //
@@ -1089,6 +1164,33 @@ enum class ShaderSourceLanguage : uint32_t {
   kSpirV = MnShaderSourceLanguageSpirV,
 };
 
+enum class ShaderStageFlagBits : uint32_t {
+  kNone     = MnShaderStageFlagBitNone,
+  kVertex   = MnShaderStageFlagBitVertex,
+  kFragment = MnShaderStageFlagBitFragment,
+  kCompute  = MnShaderStageFlagBitCompute,
+};
+MBASE_DEFINE_ENUM_CLASS_BITFLAGS_OPERATORS(ShaderStageFlagBits);
+using ShaderStageFlags = mbase::BitFlags<ShaderStageFlagBits>;
+
+/// Largest push constant block a program may declare, in bytes; see `ICommandList::SetPushConstants`.
+/// Matches the minimum `maxPushConstantsSize` Vulkan guarantees.
+inline constexpr uint32_t kMaxPushConstantSizeInBytes = 128;
+
+/// Bind group of the bindless resource tables; see `IDevice::RegisterBindlessSampledTexture`.
+inline constexpr uint32_t kBindlessBindGroup = 3;
+/// Bindings of the tables within `kBindlessBindGroup`. Shaders declare the ones they use as unsized arrays, e.g.
+/// `[[vk::binding(0, 3)]] Texture2D g_textures[];` in Slang, and index them with registered indices.
+inline constexpr uint32_t kBindlessSampledTextureBinding = 0;
+inline constexpr uint32_t kBindlessStorageBufferBinding = 1;
+inline constexpr uint32_t kBindlessSamplerBinding = 2;
+/// Capacity of each table.
+inline constexpr uint32_t kMaxBindlessSampledTextures = 65536;
+inline constexpr uint32_t kMaxBindlessStorageBuffers = 65536;
+inline constexpr uint32_t kMaxBindlessSamplers = 2048;
+/// Returned by the `IDevice::RegisterBindless*` functions on failure.
+inline constexpr uint32_t kInvalidBindlessIndex = UINT32_MAX;
+
 struct ShaderModuleDesc final {
   ShaderSourceLanguage source_language = ShaderSourceLanguage::kSpirV;
   uint64_t code_ptr = 0;
@@ -1384,6 +1486,20 @@ struct RenderPassDesc final {
 };
 _MNEXUS_STATIC_ASSERT_ABI_EQUIVALENCE(RenderPassDesc, MnRenderPassDesc);
 
+// ----------------------------------------------------------------------------------------------------
+// Render Bundle
+//
+
+/// Render target signature a render bundle is recorded against. A bundle can
+/// only be executed in a render pass whose attachments match this signature.
+struct RenderBundleDesc final {
+  container::ArrayProxy<Format const> color_formats;
+  Format depth_stencil_format = Format::kUndefined;
+  uint32_t sample_count = 1;
+  MnBool32 depth_read_only = MnBoolFalse;
+  MnBool32 stencil_read_only = MnBoolFalse;
+};
+
 // ----------------------------------------------------------------------------------------------------
 // Utilities
 //
@@ -0,0 +1,128 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+#include "mnexus/public/present_stats.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_test_harness.h"
+
+// Runs a frame loop on the headless offscreen swapchain and reports the present statistics: CPU frame time, time
+// stalled in `OnPresentPrologue` and queue depth. Every frame clears an offscreen texture a few times and then the
+// swapchain image. Double and triple buffering are measured without present latency, where the queue completion
+// paces the loop, and with the latency of a 120 Hz display, where the swapchain does.
+
+namespace {
+
+constexpr uint32_t kImageSize = 1280;
+constexpr uint32_t kOffscreenSize = 1024;
+constexpr uint32_t kClearsPerFrame = 8;
+constexpr uint32_t kWarmUpFrames = 8;
+
+struct Config {
+  char const* name;
+  uint32_t image_count;
+  uint64_t present_latency_ns;
+};
+
+constexpr Config kConfigs[] = {
+  { "2 images, no latency", 2, 0 },
+  { "3 images, no latency", 3, 0 },
+  { "2 images, 120 Hz", 2, 8'333'333 },
+  { "3 images, 120 Hz", 3, 8'333'333 },
+};
+
+mnexus::IntraQueueSubmissionId RunFrame(
+  mnexus::INexus* nexus,
+  mnexus::IDevice* device,
+  mnexus::TextureHandle offscreen,
+  uint32_t frame
+) {
+  nexus->OnPresentPrologue();
+
+  mnexus::TextureHandle const swapchain_texture = device->GetSwapchainTexture();
+  mnexus::ICommandList* command_list = device->CreateCommandList({});
+  mnexus::ClearValue clear_value {};
+  for (uint32_t i = 0; i < kClearsPerFrame; ++i) {
+    clear_value.color = { static_cast<float>(i) / kClearsPerFrame, 0.0f, 0.0f, 1.0f };
+    command_list->ClearTexture(offscreen, mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0), clear_value);
+  }
+  clear_value.color = { 0.0f, static_cast<float>(frame % 2), 0.0f, 1.0f };
+  command_list->ClearTexture(
+    swapchain_texture, mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0), clear_value
+  );
+  command_list->End();
+  mnexus::IntraQueueSubmissionId const submission_id = device->QueueSubmitCommandList({}, command_list);
+
+  nexus->OnPresentEpilogue();
+  return submission_id;
+}
+
+void Run(Config const& config, uint32_t frame_count) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+      .offscreen_swapchain = {
+        .image_count = config.image_count,
+        .width = kImageSize,
+        .height = kImageSize,
+        .present_latency_ns = config.present_latency_ns,
+      },
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::TextureHandle const offscreen = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kAttachment | mnexus::TextureUsageFlagBits::kTransferDst,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = kOffscreenSize,
+      .height = kOffscreenSize,
+      .depth = 1,
+      .mip_level_count = 1,
+      .array_layer_count = 1,
+    }
+  );
+
+  mnexus::IntraQueueSubmissionId submission_id {};
+  for (uint32_t frame = 0; frame < kWarmUpFrames; ++frame) {
+    submission_id = RunFrame(nexus, device, offscreen, frame);
+  }
+  nexus->ResetPresentStats();
+  for (uint32_t frame = 0; frame < frame_count; ++frame) {
+    submission_id = RunFrame(nexus, device, offscreen, frame);
+  }
+  mnexus::PresentStats const stats = nexus->GetPresentStats();
+
+  char name[96];
+  std::snprintf(name, sizeof(name), "%s, cpu frame time avg", config.name);
+  mn_bench::Report(name, static_cast<double>(stats.GetAverageCpuFrameTimeNs()) / 1.0e6, "ms");
+  std::snprintf(name, sizeof(name), "%s, cpu frame time max", config.name);
+  mn_bench::Report(name, static_cast<double>(stats.max_cpu_frame_time_ns) / 1.0e6, "ms");
+  std::snprintf(name, sizeof(name), "%s, stall avg", config.name);
+  mn_bench::Report(name, static_cast<double>(stats.total_stall_time_ns) / 1.0e6 / stats.frame_count, "ms");
+  std::snprintf(name, sizeof(name), "%s, queue depth max", config.name);
+  mn_bench::Report(name, static_cast<double>(stats.max_queue_depth), "images");
+
+  device->QueueWaitIdle({}, submission_id);
+  device->DestroyTexture(offscreen);
+  nexus->Destroy();
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const frame_count = mn_bench::ParseIterations(argc, argv, 240);
+
+  std::printf("%u frames of %u clears of %ux%u plus the %ux%u swapchain image\n",
+    frame_count, kClearsPerFrame, kOffscreenSize, kOffscreenSize, kImageSize, kImageSize);
+
+  for (Config const& config : kConfigs) {
+    Run(config, frame_count);
+  }
+
+  return 0;
+}
@@ -0,0 +1,81 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_test_harness.h"
+
+// Measures the time to regenerate the full mip chain of a 4K RGBA8 texture, from submission to completion.
+
+namespace {
+
+constexpr uint32_t kSize = 4096;
+constexpr uint32_t kMipLevelCount = 13; // 4096x4096 down to 1x1.
+constexpr uint32_t kBytesPerPixel = 4;
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const iterations = mn_bench::ParseIterations(argc, argv, 20);
+
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::TextureHandle texture = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kSampled |
+        mnexus::TextureUsageFlagBits::kTransferSrc |
+        mnexus::TextureUsageFlagBits::kTransferDst,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = kSize,
+      .height = kSize,
+      .depth = 1,
+      .mip_level_count = kMipLevelCount,
+      .array_layer_count = 1,
+    }
+  );
+
+  std::vector<uint8_t> level0_pixels(size_t(kSize) * kSize * kBytesPerPixel);
+  for (size_t i = 0; i < level0_pixels.size(); ++i) {
+    level0_pixels[i] = static_cast<uint8_t>(i * 31);
+  }
+  mnexus::TextureWriteRegion const region {
+    .subresource_range = mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+    .origin = {},
+    .extent = mnexus::Extent3d { kSize, kSize, 1 },
+    .data = level0_pixels.data(),
+  };
+  device->QueueWaitIdle({}, device->QueueWriteTexture({}, texture, region));
+
+  mnexus::TextureSubresourceRange const mip_range {
+    .aspect_mask = mnexus::TextureAspectFlagBits::kColor,
+    .base_mip_level = 0,
+    .mip_level_count = kMipLevelCount,
+    .base_array_layer = 0,
+    .array_layer_count = 1,
+  };
+
+  double const generate_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+    mnexus::ICommandList* command_list = device->CreateCommandList({});
+    command_list->GenerateMipmaps(texture, mip_range);
+    command_list->End();
+    device->QueueWaitIdle({}, device->QueueSubmitCommandList({}, command_list));
+  });
+
+  std::printf("%ux%u RGBA8, %u levels, %u iterations\n", kSize, kSize, kMipLevelCount, iterations);
+  mn_bench::Report("generate mipmaps", generate_us / 1000.0, "ms/chain");
+
+  device->DestroyTexture(texture);
+  nexus->Destroy();
+
+  return 0;
+}
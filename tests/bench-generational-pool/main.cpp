@@ -0,0 +1,166 @@
+// c++ headers ------------------------------------------
+#include <cstdint>
+#include <cstdio>
+
+#include <optional>
+#include <vector>
+
+// project headers --------------------------------------
+#include "resource_pool/generational_pool.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_test_harness.h"
+
+// Compares `GenerationalPool` with the layout it replaced, one `std::optional` per slot for Hot and Cold, on handle
+// validation, iteration of a sparse pool, insert/erase churn and memory footprint.
+
+namespace {
+
+using resource_pool::GenerationalHandle;
+
+struct Hot {
+  uint64_t native_handle;
+  uint32_t flags;
+};
+
+struct Cold {
+  uint64_t desc[6];
+};
+
+constexpr uint32_t kSlotCount = 64 * 1024;
+/// One slot in ten stays alive after thinning, as after a burst of transient resources.
+constexpr uint32_t kLiveStride = 10;
+
+/// The previous layout, reduced to the operations measured here.
+class OptionalSlotPool final {
+public:
+  GenerationalHandle Insert(Hot hot, Cold cold) {
+    uint32_t idx;
+    if (!freelist_.empty()) {
+      idx = freelist_.back();
+      freelist_.pop_back();
+    } else {
+      idx = static_cast<uint32_t>(gen_.size());
+      gen_.emplace_back(1u);
+      hot_.emplace_back(std::nullopt);
+      cold_.emplace_back(std::nullopt);
+    }
+    hot_[idx] = hot;
+    cold_[idx] = cold;
+    return GenerationalHandle::Make(idx, gen_[idx], 0);
+  }
+
+  bool Erase(GenerationalHandle h) {
+    if (!this->IsAlive(h)) return false;
+    hot_[h.index()].reset();
+    cold_[h.index()].reset();
+    gen_[h.index()] = GenerationalHandle::NextGeneration(gen_[h.index()]);
+    freelist_.emplace_back(h.index());
+    return true;
+  }
+
+  bool IsAlive(GenerationalHandle h) const {
+    if (h.IsNull() || h.index() >= gen_.size() || gen_[h.index()] != h.generation()) return false;
+    return hot_[h.index()].has_value() && cold_[h.index()].has_value();
+  }
+
+  template <class F>
+  void ForEachAlive(F&& f) {
+    for (uint32_t i = 0; i < gen_.size(); ++i) {
+      if (!hot_[i].has_value()) continue;
+      f(GenerationalHandle::Make(i, gen_[i], 0), *hot_[i], *cold_[i]);
+    }
+  }
+
+  size_t GetAllocatedBytes() const {
+    return hot_.capacity() * sizeof(std::optional<Hot>)
+      + cold_.capacity() * sizeof(std::optional<Cold>)
+      + gen_.capacity() * sizeof(uint32_t)
+      + freelist_.capacity() * sizeof(uint32_t);
+  }
+
+private:
+  std::vector<std::optional<Hot>> hot_;
+  std::vector<std::optional<Cold>> cold_;
+  std::vector<uint32_t> gen_;
+  std::vector<uint32_t> freelist_;
+};
+
+template <class Pool>
+void Run(char const* pool_name, Pool& pool, uint32_t iterations, size_t (*allocated_bytes)(Pool const&)) {
+  std::vector<GenerationalHandle> handles(kSlotCount);
+  for (uint32_t i = 0; i < kSlotCount; ++i) {
+    handles[i] = pool.Insert(Hot { i, i }, Cold {});
+  }
+  for (uint32_t i = 0; i < kSlotCount; ++i) {
+    if (i % kLiveStride != 0) {
+      pool.Erase(handles[i]);
+    }
+  }
+
+  // Every handle, live or stale, is validated once per iteration.
+  uint64_t alive_count = 0;
+  double const is_alive_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+    for (GenerationalHandle const handle : handles) {
+      alive_count += pool.IsAlive(handle) ? 1 : 0;
+    }
+  });
+
+  uint64_t flags_sum = 0;
+  double const for_each_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+    pool.ForEachAlive([&](GenerationalHandle, Hot& hot, Cold&) { flags_sum += hot.flags; });
+  });
+
+  // Refill the thinned slots and thin them again.
+  double const churn_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+    for (uint32_t i = 0; i < kSlotCount; ++i) {
+      if (i % kLiveStride != 0) {
+        handles[i] = pool.Insert(Hot { i, i }, Cold {});
+      }
+    }
+    for (uint32_t i = 0; i < kSlotCount; ++i) {
+      if (i % kLiveStride != 0) {
+        pool.Erase(handles[i]);
+      }
+    }
+  });
+
+  char name[96];
+  std::snprintf(name, sizeof(name), "%s IsAlive", pool_name);
+  mn_bench::Report(name, is_alive_us * 1000.0 / kSlotCount, "ns/handle");
+  std::snprintf(name, sizeof(name), "%s ForEachAlive (1 in %u live)", pool_name, kLiveStride);
+  mn_bench::Report(name, for_each_us, "us/pass");
+  std::snprintf(name, sizeof(name), "%s insert + erase", pool_name);
+  mn_bench::Report(name, churn_us * 1000.0 / (2.0 * (kSlotCount - kSlotCount / kLiveStride)), "ns/op");
+  std::snprintf(name, sizeof(name), "%s memory", pool_name);
+  mn_bench::Report(name, static_cast<double>(allocated_bytes(pool)) / 1024.0, "KiB");
+
+  // Keep the results observable.
+  if (alive_count == 0 || flags_sum == 0) {
+    std::printf("(no live entries)\n");
+  }
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const iterations = mn_bench::ParseIterations(argc, argv, 100);
+
+  std::printf(
+    "%u slots, Hot %zu bytes, Cold %zu bytes, %u iterations\n", kSlotCount, sizeof(Hot), sizeof(Cold), iterations
+  );
+
+  {
+    resource_pool::GenerationalPool<Hot, Cold> pool;
+    Run<resource_pool::GenerationalPool<Hot, Cold>>("GenerationalPool", pool, iterations,
+      [](resource_pool::GenerationalPool<Hot, Cold> const& p) { return p.GetMemoryUsage().allocated_bytes; });
+  }
+  {
+    OptionalSlotPool pool;
+    Run<OptionalSlotPool>("optional slots", pool, iterations,
+      [](OptionalSlotPool const& p) { return p.GetAllocatedBytes(); });
+  }
+
+  return 0;
+}
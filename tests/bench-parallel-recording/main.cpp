@@ -0,0 +1,93 @@
+// c++ headers ------------------------------------------
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_test_harness.h"
+
+// Measures command list recording throughput as the number of recording threads grows. Every thread records into
+// its own texture and discards its lists, so only recording and command buffer allocation are measured.
+
+namespace {
+
+constexpr uint32_t kTextureSize = 64;
+constexpr uint32_t kCommandsPerList = 16;
+constexpr uint32_t kThreadCounts[] = { 1, 2, 4, 8 };
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const lists_per_thread = mn_bench::ParseIterations(argc, argv, 2000);
+
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  std::vector<mnexus::TextureHandle> textures(kThreadCounts[std::size(kThreadCounts) - 1]);
+  for (mnexus::TextureHandle& texture : textures) {
+    texture = device->CreateTexture(
+      mnexus::TextureDesc {
+        .usage = mnexus::TextureUsageFlagBits::kAttachment | mnexus::TextureUsageFlagBits::kTransferDst,
+        .format = mnexus::Format::kR8G8B8A8_UNORM,
+        .dimension = mnexus::TextureDimension::k2D,
+        .width = kTextureSize,
+        .height = kTextureSize,
+        .depth = 1,
+        .mip_level_count = 1,
+        .array_layer_count = 1,
+      }
+    );
+  }
+
+  std::printf("%u lists of %u clears per thread\n", lists_per_thread, kCommandsPerList);
+
+  for (uint32_t const thread_count : kThreadCounts) {
+    auto const begin = std::chrono::steady_clock::now();
+    {
+      std::vector<std::jthread> workers;
+      workers.reserve(thread_count);
+      for (uint32_t thread = 0; thread < thread_count; ++thread) {
+        workers.emplace_back([&, thread] {
+          mnexus::ClearValue clear_value {};
+          for (uint32_t list = 0; list < lists_per_thread; ++list) {
+            mnexus::ICommandList* command_list = device->CreateCommandList({});
+            for (uint32_t command = 0; command < kCommandsPerList; ++command) {
+              clear_value.color.r = static_cast<float>(command) / kCommandsPerList;
+              command_list->ClearTexture(
+                textures[thread],
+                mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+                clear_value
+              );
+            }
+            command_list->End();
+            device->DiscardCommandList(command_list);
+          }
+        });
+      }
+    }
+    auto const end = std::chrono::steady_clock::now();
+
+    double const total_lists = static_cast<double>(thread_count) * lists_per_thread;
+    double const seconds = std::chrono::duration<double>(end - begin).count();
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "%u thread(s)", thread_count);
+    mn_bench::Report(name, total_lists / seconds / 1000.0, "k lists/s");
+  }
+
+  for (mnexus::TextureHandle const texture : textures) {
+    device->DestroyTexture(texture);
+  }
+  nexus->Destroy();
+
+  return 0;
+}
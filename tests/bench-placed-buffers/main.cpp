@@ -0,0 +1,94 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/memory_stats.h"
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_test_harness.h"
+
+// Measures creation and destruction cost, and the native memory allocated, for many small buffers with and without
+// `NexusDesc::placed_buffers`.
+
+namespace {
+
+constexpr uint32_t kBufferSize = 256;
+
+uint64_t AllocatedBytes(mnexus::IDevice* device) {
+  uint64_t total = 0;
+  for (mnexus::MemoryHeapStats const& heap : device->GetMemoryStats().heaps) {
+    total += heap.allocated_in_bytes;
+  }
+  return total;
+}
+
+void Run(MnBackendType backend_type, bool placed_buffers, uint32_t buffer_count, uint32_t iterations) {
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(backend_type),
+      .placed_buffers = placed_buffers,
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  std::vector<mnexus::BufferHandle> buffers(buffer_count);
+  uint64_t const allocated_before = AllocatedBytes(device);
+  uint64_t allocated_peak = allocated_before;
+
+  double create_us = 0.0;
+  double destroy_us = 0.0;
+  for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+    auto const create_begin = std::chrono::steady_clock::now();
+    for (mnexus::BufferHandle& buffer : buffers) {
+      buffer = device->CreateBuffer(
+        mnexus::BufferDesc {
+          .usage = mnexus::BufferUsageFlagBits::kStorage | mnexus::BufferUsageFlagBits::kTransferDst,
+          .size_in_bytes = kBufferSize,
+        }
+      );
+    }
+    auto const create_end = std::chrono::steady_clock::now();
+    allocated_peak = std::max(allocated_peak, AllocatedBytes(device));
+
+    for (mnexus::BufferHandle const buffer : buffers) {
+      device->DestroyBuffer(buffer);
+    }
+    auto const destroy_end = std::chrono::steady_clock::now();
+
+    create_us += std::chrono::duration<double, std::micro>(create_end - create_begin).count();
+    destroy_us += std::chrono::duration<double, std::micro>(destroy_end - create_end).count();
+  }
+
+  char name[64];
+  std::snprintf(name, sizeof(name), "%s create", placed_buffers ? "placed" : "dedicated");
+  mn_bench::Report(name, create_us / iterations / buffer_count, "us/buffer");
+  std::snprintf(name, sizeof(name), "%s destroy", placed_buffers ? "placed" : "dedicated");
+  mn_bench::Report(name, destroy_us / iterations / buffer_count, "us/buffer");
+  std::snprintf(name, sizeof(name), "%s native memory", placed_buffers ? "placed" : "dedicated");
+  mn_bench::Report(name, static_cast<double>(allocated_peak - allocated_before) / (1024.0 * 1024.0), "MiB");
+
+  nexus->Destroy();
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const iterations = mn_bench::ParseIterations(argc, argv, 10);
+  constexpr uint32_t kBufferCount = 4096;
+
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  if (c_desc.backend_type != MnBackendTypeVulkan) {
+    std::printf("placed_buffers is only honored by the Vulkan backend; both runs use dedicated buffers\n");
+  }
+
+  std::printf("%u buffers of %u bytes, %u iterations\n", kBufferCount, kBufferSize, iterations);
+  Run(c_desc.backend_type, /*placed_buffers=*/false, kBufferCount, iterations);
+  Run(c_desc.backend_type, /*placed_buffers=*/true, kBufferCount, iterations);
+
+  return 0;
+}
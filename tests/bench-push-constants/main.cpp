@@ -0,0 +1,183 @@
+// c++ headers ------------------------------------------
+#include <chrono>
+#include <cstdio>
+
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_repack_shader.h"
+#include "mnexus_test_harness.h"
+
+// Measures the per-dispatch cost of small per-dispatch parameters, passed either with `SetPushConstants` or with
+// `QueueWriteBuffer` plus `BindUniformBuffer` into a slot of a uniform buffer, which needs a fresh descriptor set or
+// bind group per dispatch. Both paths run buffer_repack_rows over one 256-byte row per dispatch, so the GPU work is
+// the same and negligible; recording time is reported separately from the time through submission and completion.
+
+namespace {
+
+constexpr uint32_t kDispatchesPerList = 1024;
+constexpr uint32_t kRowBytes = 256; // One workgroup of buffer_repack_rows.
+constexpr uint32_t kParamsStride = 256; // Satisfies every backend's uniform buffer offset alignment.
+
+struct Timings {
+  double record_us = 0.0;
+  double total_us = 0.0;
+};
+
+template<typename RecordFn>
+Timings Measure(mnexus::IDevice* device, uint32_t iterations, RecordFn&& record) {
+  Timings timings;
+  // Warm-up: creates the pipeline layouts and scratch pages both paths reuse.
+  for (uint32_t i = 0; i <= iterations; ++i) {
+    auto const begin = std::chrono::steady_clock::now();
+    mnexus::ICommandList* command_list = device->CreateCommandList({});
+    record(command_list);
+    command_list->End();
+    auto const recorded = std::chrono::steady_clock::now();
+    mnexus::IntraQueueSubmissionId const submit_id = device->QueueSubmitCommandList({}, command_list);
+    device->QueueWaitIdle({}, submit_id);
+    auto const end = std::chrono::steady_clock::now();
+
+    if (i != 0) {
+      timings.record_us += std::chrono::duration<double, std::micro>(recorded - begin).count();
+      timings.total_us += std::chrono::duration<double, std::micro>(end - begin).count();
+    }
+  }
+  timings.record_us /= iterations;
+  timings.total_us /= iterations;
+  return timings;
+}
+
+void Report(char const* path_name, Timings const& timings) {
+  char name[96];
+  std::snprintf(name, sizeof(name), "%s, recording", path_name);
+  mn_bench::Report(name, timings.record_us * 1000.0 / kDispatchesPerList, "ns/dispatch");
+  std::snprintf(name, sizeof(name), "%s, through completion", path_name);
+  mn_bench::Report(name, timings.total_us * 1000.0 / kDispatchesPerList, "ns/dispatch");
+}
+
+mnexus::ComputePipelineHandle CreateRepackPipeline(
+  mnexus::IDevice* device,
+  void const* code, uint32_t code_size_in_bytes,
+  mnexus::ShaderModuleHandle& out_shader_module, mnexus::ProgramHandle& out_program
+) {
+  out_shader_module = device->CreateShaderModule(
+    mnexus::ShaderModuleDesc {
+      .source_language = mnexus::ShaderSourceLanguage::kSpirV,
+      .code_ptr = reinterpret_cast<uint64_t>(code),
+      .code_size_in_bytes = code_size_in_bytes,
+    }
+  );
+  out_program = device->CreateProgram(
+    mnexus::ProgramDesc {
+      .shader_modules = out_shader_module,
+    }
+  );
+  return device->CreateComputePipeline(
+    mnexus::ComputePipelineDesc {
+      .program = out_program,
+    }
+  );
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const iterations = mn_bench::ParseIterations(argc, argv, 20);
+
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::BufferHandle const src_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kStorage,
+      .size_in_bytes = kRowBytes,
+    }
+  );
+  mnexus::BufferHandle const dst_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kStorage,
+      .size_in_bytes = kRowBytes,
+    }
+  );
+  mnexus::BufferHandle const params_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kUniform | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = kParamsStride * kDispatchesPerList,
+    }
+  );
+
+  mnexus::ShaderModuleHandle uniform_shader_module;
+  mnexus::ProgramHandle uniform_program;
+  mnexus::ComputePipelineHandle const uniform_pipeline = CreateRepackPipeline(
+    device,
+    builtin_shader::kBufferRepackRowsSpv, builtin_shader::kBufferRepackRowsSpvSize,
+    uniform_shader_module, uniform_program
+  );
+
+  std::vector<uint32_t> const push_constant_spirv = mn_repack::MakePushConstantRepackSpirv();
+  mnexus::ShaderModuleHandle push_constant_shader_module;
+  mnexus::ProgramHandle push_constant_program;
+  mnexus::ComputePipelineHandle const push_constant_pipeline = CreateRepackPipeline(
+    device,
+    push_constant_spirv.data(), static_cast<uint32_t>(push_constant_spirv.size() * sizeof(uint32_t)),
+    push_constant_shader_module, push_constant_program
+  );
+
+  auto const make_params = [](uint32_t dispatch) {
+    return mn_repack::RepackParams {
+      .src_offset = 0,
+      .src_bytes_per_row = kRowBytes,
+      .dst_bytes_per_row = kRowBytes,
+      .row_count = 1 + dispatch % 2, // Differs per dispatch, as per-draw data would.
+    };
+  };
+
+  std::printf("%u dispatches per command list, %u iterations\n", kDispatchesPerList, iterations);
+
+  Timings const uniform_timings = Measure(device, iterations, [&](mnexus::ICommandList* command_list) {
+    command_list->BindExplicitComputePipeline(uniform_pipeline);
+    command_list->BindStorageBuffer({ .group = 0, .binding = 1 }, src_buffer, 0, kRowBytes);
+    command_list->BindStorageBuffer({ .group = 0, .binding = 2 }, dst_buffer, 0, kRowBytes);
+    for (uint32_t dispatch = 0; dispatch < kDispatchesPerList; ++dispatch) {
+      mn_repack::RepackParams const params = make_params(dispatch);
+      uint32_t const offset = dispatch * kParamsStride;
+      device->QueueWriteBuffer({}, params_buffer, offset, &params, sizeof(params));
+      command_list->BindUniformBuffer({ .group = 0, .binding = 0 }, params_buffer, offset, sizeof(params));
+      command_list->DispatchCompute(1, 1, 1);
+    }
+  });
+  Report("QueueWriteBuffer + BindUniformBuffer", uniform_timings);
+
+  Timings const push_constant_timings = Measure(device, iterations, [&](mnexus::ICommandList* command_list) {
+    command_list->BindExplicitComputePipeline(push_constant_pipeline);
+    command_list->BindStorageBuffer({ .group = 0, .binding = 1 }, src_buffer, 0, kRowBytes);
+    command_list->BindStorageBuffer({ .group = 0, .binding = 2 }, dst_buffer, 0, kRowBytes);
+    for (uint32_t dispatch = 0; dispatch < kDispatchesPerList; ++dispatch) {
+      command_list->SetPushConstants(mnexus::ShaderStageFlagBits::kCompute, 0, make_params(dispatch));
+      command_list->DispatchCompute(1, 1, 1);
+    }
+  });
+  Report("SetPushConstants", push_constant_timings);
+
+  device->DestroyComputePipeline(push_constant_pipeline);
+  device->DestroyProgram(push_constant_program);
+  device->DestroyShaderModule(push_constant_shader_module);
+  device->DestroyComputePipeline(uniform_pipeline);
+  device->DestroyProgram(uniform_program);
+  device->DestroyShaderModule(uniform_shader_module);
+  device->DestroyBuffer(params_buffer);
+  device->DestroyBuffer(dst_buffer);
+  device->DestroyBuffer(src_buffer);
+  nexus->Destroy();
+
+  return 0;
+}
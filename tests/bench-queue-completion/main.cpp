@@ -0,0 +1,82 @@
+// c++ headers ------------------------------------------
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_test_harness.h"
+
+// Measures queue timeline bookkeeping with many operations in flight: the cost of issuing 10k submissions and
+// readbacks, of `QueueGetCompletedValue` while they are pending, and of draining them.
+
+namespace {
+
+constexpr uint32_t kInFlightCount = 10'000;
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const iterations = mn_bench::ParseIterations(argc, argv, 1000);
+
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::BufferHandle buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kTransferSrc | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = 4,
+    }
+  );
+  std::vector<uint32_t> readback_values(kInFlightCount);
+
+  // Alternate empty submissions and 4-byte readbacks, the two kinds of timeline entries.
+  auto const issue_begin = std::chrono::steady_clock::now();
+  mnexus::IntraQueueSubmissionId first_id {};
+  mnexus::IntraQueueSubmissionId last_id {};
+  for (uint32_t i = 0; i < kInFlightCount; ++i) {
+    if (i % 2 == 0) {
+      mnexus::ICommandList* command_list = device->CreateCommandList({});
+      command_list->End();
+      last_id = device->QueueSubmitCommandList({}, command_list);
+    } else {
+      last_id = device->QueueReadBuffer({}, buffer, 0, &readback_values[i], sizeof(uint32_t));
+    }
+    if (i == 0) {
+      first_id = last_id;
+    }
+  }
+  auto const issue_end = std::chrono::steady_clock::now();
+
+  double const completed_value_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+    (void)device->QueueGetCompletedValue({});
+  });
+  uint64_t const completed_value = device->QueueGetCompletedValue({}).Get();
+  uint64_t const completed_count = completed_value >= first_id.Get() ? completed_value - first_id.Get() + 1 : 0;
+
+  auto const drain_begin = std::chrono::steady_clock::now();
+  device->QueueWaitIdle({}, last_id);
+  auto const drain_end = std::chrono::steady_clock::now();
+
+  std::printf(
+    "%u operations issued, %llu of them completed after polling\n",
+    kInFlightCount, static_cast<unsigned long long>(completed_count)
+  );
+  mn_bench::Report(
+    "issue", std::chrono::duration<double, std::micro>(issue_end - issue_begin).count() / kInFlightCount, "us/op"
+  );
+  mn_bench::Report("QueueGetCompletedValue", completed_value_us, "us/call");
+  mn_bench::Report("drain", std::chrono::duration<double, std::milli>(drain_end - drain_begin).count(), "ms");
+
+  device->DestroyBuffer(buffer);
+  nexus->Destroy();
+
+  return 0;
+}
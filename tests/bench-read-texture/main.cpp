@@ -0,0 +1,134 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_test_harness.h"
+
+// Measures texture readback throughput with `QueueReadTexture`, and, where `CopyTextureToBuffer` is implemented,
+// with the padded copy + `QueueReadBuffer` + CPU de-pad sequence it replaces.
+
+namespace {
+
+constexpr uint32_t kBytesPerPixel = 4;
+
+double ToMegabytesPerSecond(uint64_t bytes, double microseconds) {
+  return static_cast<double>(bytes) / microseconds; // 1 byte/us == 1 MB/s.
+}
+
+void Run(mnexus::IDevice* device, bool has_copy_texture_to_buffer, uint32_t width, uint32_t height, uint32_t iterations) {
+  uint32_t const tight_bytes_per_row = width * kBytesPerPixel;
+  uint32_t const padded_bytes_per_row = (tight_bytes_per_row + 255) & ~uint32_t(255);
+  uint64_t const tight_size = uint64_t(tight_bytes_per_row) * height;
+  uint64_t const padded_size = uint64_t(padded_bytes_per_row) * height;
+
+  mnexus::TextureHandle texture = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kTransferSrc | mnexus::TextureUsageFlagBits::kTransferDst,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = width,
+      .height = height,
+      .depth = 1,
+      .mip_level_count = 1,
+      .array_layer_count = 1,
+    }
+  );
+
+  std::vector<uint8_t> pixels(tight_size);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<uint8_t>(i * 13);
+  }
+  mnexus::TextureWriteRegion const region {
+    .subresource_range = mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+    .origin = {},
+    .extent = mnexus::Extent3d { width, height, 1 },
+    .data = pixels.data(),
+  };
+  device->QueueWaitIdle({}, device->QueueWriteTexture({}, texture, region));
+
+  std::printf("%ux%u RGBA8 (%u-byte rows), %u iterations\n", width, height, tight_bytes_per_row, iterations);
+
+  double const read_texture_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+    mnexus::IntraQueueSubmissionId const id = device->QueueReadTexture(
+      {},
+      texture,
+      mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+      mnexus::Extent3d { width, height, 1 },
+      pixels.data(),
+      tight_size
+    );
+    device->QueueWaitIdle({}, id);
+  });
+  mn_bench::Report("QueueReadTexture", ToMegabytesPerSecond(tight_size, read_texture_us), "MB/s");
+
+  if (has_copy_texture_to_buffer) {
+    mnexus::BufferHandle readback_buffer = device->CreateBuffer(
+      mnexus::BufferDesc {
+        .usage = mnexus::BufferUsageFlagBits::kTransferSrc | mnexus::BufferUsageFlagBits::kTransferDst,
+        .size_in_bytes = static_cast<uint32_t>(padded_size),
+      }
+    );
+    std::vector<uint8_t> padded(padded_size);
+
+    double const copy_and_depad_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+      mnexus::ICommandList* command_list = device->CreateCommandList({});
+      command_list->CopyTextureToBuffer(
+        texture,
+        mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+        readback_buffer,
+        0,
+        mnexus::Extent3d { width, height, 1 }
+      );
+      command_list->End();
+      device->QueueSubmitCommandList({}, command_list);
+
+      mnexus::IntraQueueSubmissionId const id = device->QueueReadBuffer(
+        {}, readback_buffer, 0, padded.data(), padded_size
+      );
+      device->QueueWaitIdle({}, id);
+
+      for (uint32_t y = 0; y < height; ++y) {
+        std::memcpy(
+          pixels.data() + size_t(y) * tight_bytes_per_row,
+          padded.data() + size_t(y) * padded_bytes_per_row,
+          tight_bytes_per_row
+        );
+      }
+    });
+    mn_bench::Report("CopyTextureToBuffer + QueueReadBuffer + de-pad", ToMegabytesPerSecond(tight_size, copy_and_depad_us), "MB/s");
+
+    device->DestroyBuffer(readback_buffer);
+  }
+
+  device->DestroyTexture(texture);
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const iterations = mn_bench::ParseIterations(argc, argv, 20);
+
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  // CopyTextureToBuffer is not implemented on Vulkan, so the baseline is only measured elsewhere.
+  bool const has_copy_texture_to_buffer = c_desc.backend_type != MnBackendTypeVulkan;
+
+  // 4K rows are already 256-byte aligned; 1000-wide rows are not and need de-padding.
+  Run(device, has_copy_texture_to_buffer, 3840, 2160, iterations);
+  Run(device, has_copy_texture_to_buffer, 1000, 1000, iterations);
+
+  nexus->Destroy();
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+// c++ headers ------------------------------------------
+#include <array>
+#include <cstdio>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// project headers --------------------------------------
+#include "triangle_test_vs_spv.h"
+#include "triangle_test_fs_spv.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_test_harness.h"
+
+// Measures the CPU cost of recording a render pass of many small draws directly on the command list versus replaying
+// the same draws from a pre-recorded render bundle.
+
+namespace {
+
+constexpr uint32_t kDrawCount = 1024;
+
+struct Vertex {
+  float x, y;
+  float r, g, b;
+};
+
+constexpr Vertex kTriangleVertices[] = {
+  {  0.0f,  0.5f,   1.0f, 0.0f, 0.0f },
+  { -0.5f, -0.5f,   0.0f, 1.0f, 0.0f },
+  {  0.5f, -0.5f,   0.0f, 0.0f, 1.0f },
+};
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const iterations = mn_bench::ParseIterations(argc, argv, 100);
+
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  if (c_desc.backend_type == MnBackendTypeVulkan) {
+    std::printf("Render bundles are not implemented on Vulkan; nothing to measure\n");
+    return 0;
+  }
+
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::TextureHandle render_target = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kAttachment,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = 64,
+      .height = 64,
+      .depth = 1,
+      .mip_level_count = 1,
+      .array_layer_count = 1,
+    }
+  );
+
+  // Two vertex buffers, alternated per draw so that every draw re-binds one.
+  std::array<mnexus::BufferHandle, 2> vertex_buffers;
+  for (mnexus::BufferHandle& vertex_buffer : vertex_buffers) {
+    vertex_buffer = device->CreateBuffer(
+      mnexus::BufferDesc {
+        .usage = mnexus::BufferUsageFlagBits::kVertex,
+        .size_in_bytes = sizeof(kTriangleVertices),
+      }
+    );
+    device->QueueWriteBuffer({}, vertex_buffer, 0, kTriangleVertices, sizeof(kTriangleVertices));
+  }
+
+  mnexus::ShaderModuleHandle vs_handle = device->CreateShaderModule(
+    mnexus::ShaderModuleDesc {
+      .source_language = mnexus::ShaderSourceLanguage::kSpirV,
+      .code_ptr = reinterpret_cast<uint64_t>(test_shader::kTriangleTestVsSpv),
+      .code_size_in_bytes = static_cast<uint32_t>(sizeof(test_shader::kTriangleTestVsSpv)),
+    }
+  );
+
+  mnexus::ShaderModuleHandle fs_handle = device->CreateShaderModule(
+    mnexus::ShaderModuleDesc {
+      .source_language = mnexus::ShaderSourceLanguage::kSpirV,
+      .code_ptr = reinterpret_cast<uint64_t>(test_shader::kTriangleTestFsSpv),
+      .code_size_in_bytes = static_cast<uint32_t>(sizeof(test_shader::kTriangleTestFsSpv)),
+    }
+  );
+
+  std::array<mnexus::ShaderModuleHandle, 2> shader_modules = { vs_handle, fs_handle };
+  mnexus::ProgramHandle program = device->CreateProgram(
+    mnexus::ProgramDesc {
+      .shader_modules = shader_modules,
+    }
+  );
+
+  mnexus::VertexInputBindingDesc binding {
+    .binding = 0,
+    .stride = sizeof(Vertex),
+    .step_mode = mnexus::VertexStepMode::kVertex,
+  };
+  std::array<mnexus::VertexInputAttributeDesc, 2> attributes = {{
+    { .location = 0, .binding = 0, .format = mnexus::Format::kR32G32_SFLOAT,    .offset = 0 },
+    { .location = 1, .binding = 0, .format = mnexus::Format::kR32G32B32_SFLOAT, .offset = sizeof(float) * 2 },
+  }};
+
+  mnexus::ColorAttachmentDesc color_attachment {
+    .texture = render_target,
+    .subresource_range = mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+    .load_op = mnexus::LoadOp::kClear,
+    .store_op = mnexus::StoreOp::kStore,
+  };
+
+  // Record the bundle once.
+  mnexus::Format const color_format = mnexus::Format::kR8G8B8A8_UNORM;
+  mnexus::IRenderBundleEncoder* encoder = device->CreateRenderBundleEncoder(
+    mnexus::RenderBundleDesc {
+      .color_formats = color_format,
+    }
+  );
+  encoder->BindRenderProgram(program);
+  encoder->SetVertexInputLayout(binding, attributes);
+  for (uint32_t i = 0; i < kDrawCount; ++i) {
+    encoder->BindVertexBuffer(0, vertex_buffers[i & 1], 0);
+    encoder->Draw(3, 1, 0, 0);
+  }
+  mnexus::RenderBundleHandle bundle = device->FinishRenderBundleEncoder(encoder);
+
+  double const direct_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+    mnexus::ICommandList* command_list = device->CreateCommandList({});
+    command_list->BeginRenderPass(mnexus::RenderPassDesc { .color_attachments = color_attachment });
+    command_list->BindRenderProgram(program);
+    command_list->SetVertexInputLayout(binding, attributes);
+    for (uint32_t i = 0; i < kDrawCount; ++i) {
+      command_list->BindVertexBuffer(0, vertex_buffers[i & 1], 0);
+      command_list->Draw(3, 1, 0, 0);
+    }
+    command_list->EndRenderPass();
+    command_list->End();
+    device->DiscardCommandList(command_list);
+  });
+
+  double const bundle_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+    mnexus::ICommandList* command_list = device->CreateCommandList({});
+    command_list->BeginRenderPass(mnexus::RenderPassDesc { .color_attachments = color_attachment });
+    command_list->ExecuteBundles(bundle);
+    command_list->EndRenderPass();
+    command_list->End();
+    device->DiscardCommandList(command_list);
+  });
+
+  std::printf("%u draws per pass, %u iterations\n", kDrawCount, iterations);
+  mn_bench::Report("record direct", direct_us, "us/pass");
+  mn_bench::Report("record via bundle", bundle_us, "us/pass");
+
+  device->DestroyRenderBundle(bundle);
+  for (mnexus::BufferHandle vertex_buffer : vertex_buffers) {
+    device->DestroyBuffer(vertex_buffer);
+  }
+  device->DestroyTexture(render_target);
+  device->DestroyProgram(program);
+  device->DestroyShaderModule(vs_handle);
+  device->DestroyShaderModule(fs_handle);
+
+  nexus->Destroy();
+
+  return 0;
+}
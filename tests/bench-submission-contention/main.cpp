@@ -0,0 +1,97 @@
+// c++ headers ------------------------------------------
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_test_harness.h"
+
+// Measures queue throughput with 8 producer threads that each upload to their own buffer and poll the timeline,
+// with and without `NexusDesc::submission_thread`.
+
+namespace {
+
+constexpr uint32_t kProducerCount = 8;
+constexpr uint32_t kUploadSize = 4 * 1024;
+
+void Run(MnBackendType backend_type, bool submission_thread, uint32_t uploads_per_producer) {
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(backend_type),
+      .submission_thread = submission_thread,
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  std::array<mnexus::BufferHandle, kProducerCount> buffers;
+  for (mnexus::BufferHandle& buffer : buffers) {
+    buffer = device->CreateBuffer(
+      mnexus::BufferDesc {
+        .usage = mnexus::BufferUsageFlagBits::kStorage | mnexus::BufferUsageFlagBits::kTransferDst,
+        .size_in_bytes = kUploadSize,
+      }
+    );
+  }
+
+  std::array<mnexus::IntraQueueSubmissionId, kProducerCount> last_ids {};
+
+  auto const begin = std::chrono::steady_clock::now();
+  {
+    std::vector<std::jthread> producers;
+    producers.reserve(kProducerCount);
+    for (uint32_t p = 0; p < kProducerCount; ++p) {
+      producers.emplace_back([&, p] {
+        std::vector<uint8_t> data(kUploadSize, static_cast<uint8_t>(p));
+        for (uint32_t i = 0; i < uploads_per_producer; ++i) {
+          last_ids[p] = device->QueueWriteBuffer({}, buffers[p], 0, data.data(), kUploadSize);
+          (void)device->QueueGetCompletedValue({});
+        }
+      });
+    }
+  }
+  auto const issued = std::chrono::steady_clock::now();
+
+  mnexus::IntraQueueSubmissionId last_id {};
+  for (mnexus::IntraQueueSubmissionId const id : last_ids) {
+    last_id = id.Get() > last_id.Get() ? id : last_id;
+  }
+  device->QueueWaitIdle({}, last_id);
+  auto const end = std::chrono::steady_clock::now();
+
+  double const total_uploads = static_cast<double>(kProducerCount) * uploads_per_producer;
+  double const issue_s = std::chrono::duration<double>(issued - begin).count();
+  double const total_s = std::chrono::duration<double>(end - begin).count();
+
+  char name[64];
+  std::snprintf(name, sizeof(name), "%s: issue", submission_thread ? "submission thread" : "queue mutex");
+  mn_bench::Report(name, total_uploads / issue_s / 1000.0, "k uploads/s");
+  std::snprintf(name, sizeof(name), "%s: issue + complete", submission_thread ? "submission thread" : "queue mutex");
+  mn_bench::Report(name, total_uploads / total_s / 1000.0, "k uploads/s");
+
+  for (mnexus::BufferHandle const buffer : buffers) {
+    device->DestroyBuffer(buffer);
+  }
+  nexus->Destroy();
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const uploads_per_producer = mn_bench::ParseIterations(argc, argv, 10'000);
+
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  if (c_desc.backend_type == MnBackendTypeVulkan) {
+    std::printf("submission_thread is only honored by the WebGPU backend; both runs use the same path\n");
+  }
+
+  std::printf("%u producers x %u uploads of %u bytes\n", kProducerCount, uploads_per_producer, kUploadSize);
+  Run(c_desc.backend_type, /*submission_thread=*/false, uploads_per_producer);
+  Run(c_desc.backend_type, /*submission_thread=*/true, uploads_per_producer);
+
+  return 0;
+}
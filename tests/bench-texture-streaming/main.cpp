@@ -0,0 +1,103 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_bench.h"
+#include "mnexus_test_harness.h"
+
+// Measures streaming a frame's worth of texture layers, either with one batched `QueueWriteTexture` call or with a
+// staging buffer, `QueueWriteBuffer`, one `CopyBufferToTexture` per layer and a submission.
+
+namespace {
+
+// 200-texel RGBA8 rows are 800 bytes, which is not 256-byte aligned.
+constexpr uint32_t kTileSize = 200;
+constexpr uint32_t kLayerCount = 64;
+constexpr uint32_t kBytesPerPixel = 4;
+constexpr uint32_t kTileBytes = kTileSize * kTileSize * kBytesPerPixel;
+constexpr uint32_t kFrameBytes = kTileBytes * kLayerCount;
+
+double ToMegabytesPerSecond(uint64_t bytes, double microseconds) {
+  return static_cast<double>(bytes) / microseconds; // 1 byte/us == 1 MB/s.
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int argc, char** argv) {
+  uint32_t const iterations = mn_bench::ParseIterations(argc, argv, 50);
+
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::TextureHandle texture = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kSampled | mnexus::TextureUsageFlagBits::kTransferDst,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = kTileSize,
+      .height = kTileSize,
+      .depth = 1,
+      .mip_level_count = 1,
+      .array_layer_count = kLayerCount,
+    }
+  );
+
+  std::vector<uint8_t> pixels(kFrameBytes);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  std::vector<mnexus::TextureWriteRegion> regions(kLayerCount);
+  for (uint32_t layer = 0; layer < kLayerCount; ++layer) {
+    regions[layer] = mnexus::TextureWriteRegion {
+      .subresource_range = mnexus::TextureSubresourceRange::SingleSubresourceColor(0, layer),
+      .origin = {},
+      .extent = mnexus::Extent3d { kTileSize, kTileSize, 1 },
+      .data = pixels.data() + size_t(layer) * kTileBytes,
+    };
+  }
+
+  double const write_texture_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+    device->QueueWaitIdle({}, device->QueueWriteTexture({}, texture, regions));
+  });
+
+  mnexus::BufferHandle staging_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kTransferSrc | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = kFrameBytes,
+    }
+  );
+
+  double const staging_us = mn_bench::MeasureMicroseconds(iterations, [&] {
+    device->QueueWriteBuffer({}, staging_buffer, 0, pixels.data(), kFrameBytes);
+
+    mnexus::ICommandList* command_list = device->CreateCommandList({});
+    for (uint32_t layer = 0; layer < kLayerCount; ++layer) {
+      command_list->CopyBufferToTexture(
+        staging_buffer, layer * kTileBytes,
+        texture, mnexus::TextureSubresourceRange::SingleSubresourceColor(0, layer),
+        mnexus::Extent3d { kTileSize, kTileSize, 1 }
+      );
+    }
+    command_list->End();
+    device->QueueWaitIdle({}, device->QueueSubmitCommandList({}, command_list));
+  });
+
+  std::printf("%u layers of %ux%u RGBA8 per frame, %u iterations\n", kLayerCount, kTileSize, kTileSize, iterations);
+  mn_bench::Report("QueueWriteTexture", ToMegabytesPerSecond(kFrameBytes, write_texture_us), "MB/s");
+  mn_bench::Report("staging buffer + CopyBufferToTexture", ToMegabytesPerSecond(kFrameBytes, staging_us), "MB/s");
+
+  device->DestroyBuffer(staging_buffer);
+  device->DestroyTexture(texture);
+  nexus->Destroy();
+
+  return 0;
+}
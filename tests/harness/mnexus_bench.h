@@ -0,0 +1,45 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Shared helpers for the bench-* executables. Benchmarks print one line per measurement and always exit 0; they are
+// built alongside the tests but are not pass/fail checks.
+namespace mn_bench {
+
+/// Returns `--iterations=N` from the command line, or `default_iterations` if absent.
+inline uint32_t ParseIterations(int argc, char** argv, uint32_t default_iterations) {
+  constexpr char kPrefix[] = "--iterations=";
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], kPrefix, sizeof(kPrefix) - 1) == 0) {
+      long const value = std::strtol(argv[i] + sizeof(kPrefix) - 1, nullptr, 10);
+      if (value > 0) {
+        return static_cast<uint32_t>(value);
+      }
+    }
+  }
+  return default_iterations;
+}
+
+/// Calls `fn` once to warm up, then `iterations` times, and returns the mean wall time per call in microseconds.
+template<typename Fn>
+double MeasureMicroseconds(uint32_t iterations, Fn&& fn) {
+  fn();
+  auto const begin = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; ++i) {
+    fn();
+  }
+  auto const end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - begin).count() / static_cast<double>(iterations);
+}
+
+/// Prints `<name>: <value> <unit>`.
+inline void Report(char const* name, double value, char const* unit) {
+  std::printf("%s: %.3f %s\n", name, value, unit);
+}
+
+} // namespace mn_bench
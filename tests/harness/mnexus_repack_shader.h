@@ -0,0 +1,87 @@
+#pragma once
+
+// c++ headers ------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <vector>
+
+// project headers --------------------------------------
+#include "mnexus/private/builtin_shader/buffer_repack_rows_spv.h"
+
+// Shared by the tests and benchmarks of push constants: the builtin buffer_repack_rows compute shader, reading its
+// parameters either from a uniform buffer (as built) or from a push constant block (patched).
+namespace mn_repack {
+
+// Matches `Params` in buffer_repack_rows.slang.
+struct RepackParams {
+  uint32_t src_offset;
+  uint32_t src_bytes_per_row;
+  uint32_t dst_bytes_per_row;
+  uint32_t row_count;
+};
+
+constexpr uint32_t kOpTypePointer = 32;
+constexpr uint32_t kOpVariable = 59;
+constexpr uint32_t kOpAccessChain = 65;
+constexpr uint32_t kOpDecorate = 71;
+constexpr uint32_t kStorageClassPushConstant = 9;
+constexpr uint32_t kDecorationBinding = 33;
+constexpr uint32_t kDecorationDescriptorSet = 34;
+
+/// Turns buffer_repack_rows into a push constant shader: the `params` uniform block (set 0, binding 0) becomes the
+/// push constant block. Member access chains get a pointer type of their own, since the `Uniform` pointer to `uint`
+/// is shared with the storage buffers.
+inline std::vector<uint32_t> MakePushConstantRepackSpirv() {
+  std::vector<uint32_t> in(builtin_shader::kBufferRepackRowsSpvSize / 4);
+  std::memcpy(in.data(), builtin_shader::kBufferRepackRowsSpv, in.size() * 4);
+
+  // Find the variable decorated with binding 0, its pointer type, and the member pointer type of its access chains.
+  uint32_t params_var = 0;
+  for (size_t w = 5; w < in.size(); w += in[w] >> 16) {
+    if ((in[w] & 0xFFFF) == kOpDecorate && in[w + 2] == kDecorationBinding && in[w + 3] == 0) {
+      params_var = in[w + 1];
+    }
+  }
+  uint32_t params_ptr_type = 0;
+  uint32_t member_ptr_type = 0;
+  for (size_t w = 5; w < in.size(); w += in[w] >> 16) {
+    uint32_t const opcode = in[w] & 0xFFFF;
+    if (opcode == kOpVariable && in[w + 2] == params_var) {
+      params_ptr_type = in[w + 1];
+    } else if (opcode == kOpAccessChain && in[w + 3] == params_var) {
+      member_ptr_type = in[w + 1];
+    }
+  }
+
+  uint32_t const new_member_ptr_type = in[3]++; // Take the id bound.
+
+  std::vector<uint32_t> out(in.begin(), in.begin() + 5);
+  for (size_t w = 5; w < in.size();) {
+    uint32_t const opcode = in[w] & 0xFFFF;
+    uint32_t const word_count = in[w] >> 16;
+    size_t const begin = out.size();
+
+    bool const is_params_decoration = opcode == kOpDecorate && in[w + 1] == params_var &&
+      (in[w + 2] == kDecorationBinding || in[w + 2] == kDecorationDescriptorSet);
+    if (!is_params_decoration) {
+      out.insert(out.end(), in.begin() + w, in.begin() + w + word_count);
+    }
+
+    if (opcode == kOpTypePointer && in[w + 1] == params_ptr_type) {
+      out[begin + 2] = kStorageClassPushConstant;
+    } else if (opcode == kOpTypePointer && in[w + 1] == member_ptr_type) {
+      out.insert(out.end(), { (4u << 16) | kOpTypePointer, new_member_ptr_type, kStorageClassPushConstant, in[w + 3] });
+    } else if (opcode == kOpVariable && in[w + 2] == params_var) {
+      out[begin + 3] = kStorageClassPushConstant;
+    } else if (opcode == kOpAccessChain && in[w + 3] == params_var) {
+      out[begin + 1] = new_member_ptr_type;
+    }
+    w += word_count;
+  }
+
+  return out;
+}
+
+} // namespace mn_repack
@@ -1,4 +1,5 @@
 // c headers --------------------------------------------
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -25,6 +26,23 @@ MnNexusDesc MnTestGetDefaultNexusDesc(void) {
   return desc;
 }
 
+// ----------------------------------------------------------------------------------------------------
+// Checks
+//
+
+static int g_mn_test_passed = 1;
+
+void MnTestCheck(int condition, char const* what) {
+  printf("%s: %s\n", what, condition ? "OK" : "FAILED");
+  if (!condition) {
+    g_mn_test_passed = 0;
+  }
+}
+
+int MnTestPassed(void) {
+  return g_mn_test_passed;
+}
+
 // external headers -------------------------------------
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb/stb_image_write.h"
@@ -14,6 +14,12 @@ MnBackendType MnTestGetBackendType(void);
 // Returns a pre-filled MnNexusDesc with headless=true and the selected backend.
 MnNexusDesc MnTestGetDefaultNexusDesc(void);
 
+// Prints "<what>: OK" or "<what>: FAILED" and records failures.
+void MnTestCheck(int condition, char const* what);
+
+// Returns non-zero if no MnTestCheck() has failed.
+int MnTestPassed(void);
+
 // Each test implements this function.
 // Called by the harness after Logger initialization.
 // Return 0 on success, non-zero on failure.
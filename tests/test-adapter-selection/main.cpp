@@ -0,0 +1,123 @@
+// c++ headers ------------------------------------------
+#include <array>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+#include "mnexus/private/adapter/adapter_selection.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+using mnexus_backend::adapter::AdapterCandidate;
+using mnexus_backend::adapter::AdapterKind;
+
+constexpr uint64_t kGiB = uint64_t(1) << 30;
+
+AdapterCandidate MakeCandidate(char const* name, AdapterKind kind, uint64_t heap_size_in_bytes) {
+  return AdapterCandidate {
+    .name = name,
+    .vendor_id = 0x1000,
+    .device_id = 0x0001,
+    .kind = kind,
+    .required_features_supported = true,
+    .has_universal_queue = true,
+    .device_local_heap_size_in_bytes = heap_size_in_bytes,
+  };
+}
+
+bool Selects(std::span<AdapterCandidate const> candidates, mnexus::AdapterOverride const& adapter_override, uint32_t expected) {
+  std::optional<uint32_t> const selected = mnexus_backend::adapter::SelectAdapter(candidates, adapter_override);
+  return selected.has_value() && selected.value() == expected;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  using mnexus_backend::adapter::ScoreAdapter;
+  using mnexus_backend::adapter::SelectAdapter;
+
+  // Usability gates.
+  {
+    AdapterCandidate candidate = MakeCandidate("gpu", AdapterKind::kDiscreteGpu, 8 * kGiB);
+    MnTestCheck(ScoreAdapter(candidate) > 0, "usable candidate scores above 0");
+
+    candidate.required_features_supported = false;
+    MnTestCheck(ScoreAdapter(candidate) == 0, "missing required features is unusable");
+
+    candidate = MakeCandidate("gpu", AdapterKind::kDiscreteGpu, 8 * kGiB);
+    candidate.has_universal_queue = false;
+    MnTestCheck(ScoreAdapter(candidate) == 0, "missing graphics+compute queue is unusable");
+
+    MnTestCheck(!SelectAdapter(std::span(&candidate, 1), {}).has_value(), "no usable candidate selects nothing");
+    MnTestCheck(!SelectAdapter({}, {}).has_value(), "no candidate selects nothing");
+  }
+
+  // Kind outranks everything else: a software rasterizer enumerated first with a larger heap still loses.
+  {
+    AdapterCandidate cpu = MakeCandidate("lavapipe", AdapterKind::kCpu, 64 * kGiB);
+    cpu.optional_feature_count = 8;
+    cpu.has_dedicated_compute_queue = true;
+    cpu.has_dedicated_transfer_queue = true;
+    std::array<AdapterCandidate, 3> const candidates {
+      cpu,
+      MakeCandidate("integrated", AdapterKind::kIntegratedGpu, 2 * kGiB),
+      MakeCandidate("discrete", AdapterKind::kDiscreteGpu, 4 * kGiB),
+    };
+    MnTestCheck(Selects(candidates, {}, 2), "discrete beats integrated beats cpu");
+    MnTestCheck(ScoreAdapter(candidates[1]) > ScoreAdapter(candidates[0]), "integrated beats cpu");
+  }
+
+  // Within a kind: optional features, then queue layout, then heap size.
+  {
+    AdapterCandidate features = MakeCandidate("features", AdapterKind::kDiscreteGpu, 4 * kGiB);
+    features.optional_feature_count = 1;
+    AdapterCandidate queues = MakeCandidate("queues", AdapterKind::kDiscreteGpu, 16 * kGiB);
+    queues.has_dedicated_compute_queue = true;
+    queues.has_dedicated_transfer_queue = true;
+    AdapterCandidate heap = MakeCandidate("heap", AdapterKind::kDiscreteGpu, 24 * kGiB);
+
+    MnTestCheck(ScoreAdapter(features) > ScoreAdapter(queues), "optional features beat queue layout");
+    MnTestCheck(ScoreAdapter(queues) > ScoreAdapter(heap), "queue layout beats heap size");
+
+    AdapterCandidate compute_only = heap;
+    compute_only.has_dedicated_compute_queue = true;
+    AdapterCandidate transfer_only = heap;
+    transfer_only.has_dedicated_transfer_queue = true;
+    MnTestCheck(ScoreAdapter(compute_only) > ScoreAdapter(transfer_only), "dedicated compute beats dedicated transfer");
+    MnTestCheck(ScoreAdapter(transfer_only) > ScoreAdapter(heap), "dedicated transfer beats none");
+
+    AdapterCandidate small_heap = MakeCandidate("small", AdapterKind::kDiscreteGpu, 8 * kGiB);
+    MnTestCheck(ScoreAdapter(heap) > ScoreAdapter(small_heap), "larger heap wins");
+
+    std::array<AdapterCandidate, 2> const ties { small_heap, small_heap };
+    MnTestCheck(Selects(ties, {}, 0), "ties keep enumeration order");
+  }
+
+  // Overrides.
+  {
+    AdapterCandidate nvidia = MakeCandidate("nvidia", AdapterKind::kDiscreteGpu, 8 * kGiB);
+    nvidia.vendor_id = 0x10DE;
+    nvidia.device_id = 0x2684;
+    AdapterCandidate intel = MakeCandidate("intel", AdapterKind::kIntegratedGpu, 2 * kGiB);
+    intel.vendor_id = 0x8086;
+    intel.device_id = 0x46A6;
+    AdapterCandidate broken = MakeCandidate("broken", AdapterKind::kDiscreteGpu, 32 * kGiB);
+    broken.required_features_supported = false;
+    std::array<AdapterCandidate, 3> const candidates { nvidia, intel, broken };
+
+    MnTestCheck(Selects(candidates, {}, 0), "no override selects by score");
+    MnTestCheck(Selects(candidates, { .index = 1 }, 1), "index override");
+    MnTestCheck(Selects(candidates, { .vendor_id = 0x8086 }, 1), "vendor override");
+    MnTestCheck(Selects(candidates, { .vendor_id = 0x8086, .device_id = 0x46A6 }, 1), "vendor and device override");
+    MnTestCheck(Selects(candidates, { .index = 1, .vendor_id = 0x10DE }, 1), "index takes precedence over IDs");
+
+    MnTestCheck(Selects(candidates, { .index = 2 }, 0), "unusable index falls back to score");
+    MnTestCheck(Selects(candidates, { .index = 7 }, 0), "out of range index falls back to score");
+    MnTestCheck(Selects(candidates, { .vendor_id = 0x1002 }, 0), "unmatched vendor falls back to score");
+  }
+
+  return MnTestPassed() ? 0 : 1;
+}
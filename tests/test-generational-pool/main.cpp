@@ -0,0 +1,227 @@
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// project headers --------------------------------------
+#include "resource_pool/generational_pool.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+using resource_pool::GenerationalHandle;
+
+constexpr uint8_t kResourceType = 3;
+
+/// Counts constructed instances, so that leaks and double destruction show up as a non-zero balance.
+struct Tracked final {
+  static inline int32_t s_instance_count = 0;
+
+  std::unique_ptr<uint32_t> value;
+
+  explicit Tracked(uint32_t v) : value(std::make_unique<uint32_t>(v)) { ++s_instance_count; }
+  Tracked(Tracked&& other) noexcept : value(std::move(other.value)) { ++s_instance_count; }
+  Tracked& operator=(Tracked&&) = delete;
+  ~Tracked() { --s_instance_count; }
+};
+
+/// Non-trivial hot and cold types; the string is long enough to live on the heap.
+using Pool = resource_pool::GenerationalPool<std::string, Tracked, kResourceType>;
+
+std::string MakeName(uint32_t i) {
+  return "resource with a heap-allocated name #" + std::to_string(i);
+}
+
+GenerationalHandle InsertNumbered(Pool& pool, uint32_t i) {
+  return pool.Emplace(std::piecewise_construct, std::forward_as_tuple(MakeName(i)), std::forward_as_tuple(i));
+}
+
+bool HoldsNumber(Pool& pool, GenerationalHandle handle, uint32_t i) {
+  std::string const* hot = pool.HotPtr(handle);
+  Tracked const* cold = pool.ColdPtr(handle);
+  return hot != nullptr && cold != nullptr && *hot == MakeName(i) && cold->value != nullptr && *cold->value == i;
+}
+
+void CheckStaleAfterErase() {
+  Pool pool;
+  GenerationalHandle const first = InsertNumbered(pool, 1);
+  MnTestCheck(first.resource_type() == kResourceType, "handle carries the resource type");
+  MnTestCheck(first.generation() == 1, "generations start at 1");
+  MnTestCheck(HoldsNumber(pool, first, 1), "inserted entry is reachable");
+
+  MnTestCheck(pool.Erase(first), "erase of a live handle succeeds");
+  MnTestCheck(!pool.IsAlive(first), "erased handle is stale");
+  MnTestCheck(pool.HotPtr(first) == nullptr && pool.ColdPtr(first) == nullptr, "stale handle resolves to null");
+  MnTestCheck(!pool.Erase(first), "second erase is rejected");
+  MnTestCheck(pool.GetLiveCount() == 0, "live count after erase");
+
+  GenerationalHandle const second = InsertNumbered(pool, 2);
+  MnTestCheck(second.index() == first.index(), "freed slot is reused");
+  MnTestCheck(second.generation() == first.generation() + 1, "reused slot advances its generation");
+  MnTestCheck(!pool.IsAlive(first), "old handle stays stale after the slot is reused");
+  MnTestCheck(HoldsNumber(pool, second, 2), "new entry is reachable");
+
+  MnTestCheck(!pool.IsAlive(GenerationalHandle::Null()), "null handle is never alive");
+}
+
+void CheckStaleAfterClear() {
+  Pool pool;
+  std::vector<GenerationalHandle> handles;
+  for (uint32_t i = 0; i < 100; ++i) {
+    handles.push_back(InsertNumbered(pool, i));
+  }
+  pool.Clear();
+
+  MnTestCheck(pool.GetLiveCount() == 0, "live count after clear");
+  MnTestCheck(Tracked::s_instance_count == 0, "clear destroys every entry");
+  bool any_alive = false;
+  for (GenerationalHandle const handle : handles) {
+    any_alive = any_alive || pool.IsAlive(handle);
+  }
+  MnTestCheck(!any_alive, "every handle is stale after clear");
+
+  uint32_t visited = 0;
+  pool.ForEachAlive([&](GenerationalHandle, std::string&, Tracked&) { ++visited; });
+  MnTestCheck(visited == 0, "cleared pool has nothing to visit");
+
+  // Cleared slots are recycled rather than appended.
+  GenerationalHandle const reinserted = InsertNumbered(pool, 7);
+  MnTestCheck(pool.GetSlotCount() == 100, "cleared slots are reused");
+  MnTestCheck(HoldsNumber(pool, reinserted, 7), "entry inserted after clear is reachable");
+}
+
+void CheckGenerationWrap() {
+  MnTestCheck(GenerationalHandle::NextGeneration(1) == 2, "generation advances by one");
+  MnTestCheck(GenerationalHandle::NextGeneration(GenerationalHandle::kMaxGeneration) == 1, "generation wraps back to 1");
+
+#if defined(NDEBUG)
+  // Cycle one slot of a real pool through every generation. That is ~134M erase/insert pairs, which only optimized
+  // builds get through quickly.
+  resource_pool::GenerationalPool<uint32_t, uint32_t, kResourceType> pool;
+  GenerationalHandle handle = pool.Insert(0, 0);
+  GenerationalHandle const original = handle;
+
+  bool saw_zero = false;
+  for (uint32_t cycle = 1; cycle < GenerationalHandle::kMaxGeneration; ++cycle) {
+    pool.Erase(handle);
+    handle = pool.Insert(cycle, cycle);
+    saw_zero = saw_zero || handle.generation() == 0;
+  }
+  MnTestCheck(!saw_zero, "generation 0 is never issued");
+  MnTestCheck(handle.generation() == GenerationalHandle::kMaxGeneration, "generation reaches the maximum");
+  MnTestCheck(!pool.IsAlive(original), "the first handle is stale before the wrap");
+
+  pool.Erase(handle);
+  handle = pool.Insert(0, 0);
+  MnTestCheck(handle.index() == original.index(), "wrap stays on the same slot");
+  MnTestCheck(handle.generation() == 1, "pool slot wraps back to generation 1");
+  MnTestCheck(pool.GetSlotCount() == 1, "cycling one entry needs one slot");
+#endif
+}
+
+void CheckReallocateMovesLiveEntries() {
+  // Grow well past the initial capacity with holes in every generation of storage.
+  Pool pool;
+  std::vector<GenerationalHandle> handles;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    handles.push_back(InsertNumbered(pool, i));
+    if (i % 3 == 2) {
+      pool.Erase(handles[i - 1]);
+    }
+  }
+  // Grow explicitly as well.
+  pool.Reserve(4096);
+
+  bool intact = true;
+  bool erased_stale = true;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    if (i % 3 == 1) {
+      erased_stale = erased_stale && !pool.IsAlive(handles[i]);
+    } else {
+      intact = intact && HoldsNumber(pool, handles[i], i);
+    }
+  }
+  MnTestCheck(intact, "live entries survive reallocation with their contents");
+  MnTestCheck(erased_stale, "erased entries stay stale across reallocation");
+  MnTestCheck(static_cast<uint32_t>(Tracked::s_instance_count) == pool.GetLiveCount(),
+    "moved-from entries are destroyed");
+}
+
+void CheckForEachAliveAcrossWords() {
+  // 300 slots span five 64-bit occupancy words. Keep a pattern that leaves whole words empty and keeps both ends
+  // of others.
+  Pool pool;
+  std::vector<GenerationalHandle> handles;
+  for (uint32_t i = 0; i < 300; ++i) {
+    handles.push_back(InsertNumbered(pool, i));
+  }
+  auto const keep = [](uint32_t i) {
+    bool const empty_word = i >= 128 && i < 192;
+    bool const word_edge = i % 64 == 0 || i % 64 == 63;
+    return !empty_word && (word_edge || i % 5 == 0);
+  };
+  std::vector<uint32_t> expected;
+  for (uint32_t i = 0; i < 300; ++i) {
+    if (keep(i)) {
+      expected.push_back(i);
+    } else {
+      pool.Erase(handles[i]);
+    }
+  }
+
+  std::vector<uint32_t> visited;
+  bool handles_match = true;
+  pool.ForEachAlive([&](GenerationalHandle handle, std::string& hot, Tracked& cold) {
+    uint32_t const i = *cold.value;
+    visited.push_back(i);
+    handles_match = handles_match && handle == handles[i] && hot == MakeName(i);
+  });
+  MnTestCheck(visited == expected, "ForEachAlive visits exactly the live slots, in index order");
+  MnTestCheck(handles_match, "ForEachAlive reports the handles returned by insertion");
+}
+
+void CheckMemoryUsage() {
+  Pool pool;
+  resource_pool::PoolMemoryUsage const empty = pool.GetMemoryUsage();
+  MnTestCheck(empty.slot_count == 0 && empty.live_count == 0 && empty.allocated_bytes == 0, "empty pool owns nothing");
+
+  std::vector<GenerationalHandle> handles;
+  for (uint32_t i = 0; i < 17; ++i) {
+    handles.push_back(InsertNumbered(pool, i));
+  }
+  pool.Erase(handles[4]);
+
+  // 17 slots outgrow the 16-slot minimum, so storage for 32 slots is allocated.
+  resource_pool::PoolMemoryUsage const used = pool.GetMemoryUsage();
+  size_t const slot_storage_bytes = 32 * (sizeof(std::string) + sizeof(Tracked));
+  size_t const side_table_bytes = 17 * sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+  MnTestCheck(used.slot_count == 17, "slot count");
+  MnTestCheck(used.live_count == 16, "live count");
+  MnTestCheck(used.allocated_bytes >= slot_storage_bytes + side_table_bytes, "allocated bytes cover every array");
+
+  pool.Reserve(1024);
+  resource_pool::PoolMemoryUsage const reserved = pool.GetMemoryUsage();
+  MnTestCheck(reserved.slot_count == 17 && reserved.live_count == 16, "reserving does not add slots");
+  MnTestCheck(reserved.allocated_bytes >= 1024 * (sizeof(std::string) + sizeof(Tracked)), "reserved storage is counted");
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  CheckStaleAfterErase();
+  CheckStaleAfterClear();
+  CheckGenerationWrap();
+  CheckReallocateMovesLiveEntries();
+  CheckForEachAliveAcrossWords();
+  CheckMemoryUsage();
+
+  MnTestCheck(Tracked::s_instance_count == 0, "pools destroy their entries");
+
+  return MnTestPassed() ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kBufferSize = 256;
+constexpr uint32_t kTextureSize = 16;
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+      .bindless_resources = true,
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  if (device->GetAdapterCapability().bindless_resources == MnBoolFalse) {
+    std::printf("No bindless resources; skipping\n");
+    nexus->Destroy();
+    return 0;
+  }
+
+  mnexus::BufferHandle const buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kStorage | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = kBufferSize,
+    }
+  );
+  mnexus::TextureHandle const texture = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kSampled | mnexus::TextureUsageFlagBits::kTransferDst,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = kTextureSize,
+      .height = kTextureSize,
+      .depth = 1,
+      .mip_level_count = 1,
+      .array_layer_count = 1,
+    }
+  );
+  mnexus::TextureSubresourceRange const subresource_range =
+    mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0);
+
+  // Unregister with work in flight. The indices retire against it and are only handed out again once it completes.
+  uint32_t const buffer_index = device->RegisterBindlessStorageBuffer(buffer, 0, kBufferSize);
+  uint32_t const texture_index = device->RegisterBindlessSampledTexture(texture, subresource_range);
+  MnTestCheck(
+    buffer_index != mnexus::kInvalidBindlessIndex && texture_index != mnexus::kInvalidBindlessIndex,
+    "registration"
+  );
+
+  std::vector<uint8_t> const data(kBufferSize, 0xAB);
+  device->QueueWriteBuffer({}, buffer, 0, data.data(), kBufferSize);
+  device->UnregisterBindlessStorageBuffer(buffer_index);
+  device->UnregisterBindlessSampledTexture(texture_index);
+
+  mnexus::IntraQueueSubmissionId const write_id = device->QueueWriteBuffer({}, buffer, 0, data.data(), kBufferSize);
+  device->QueueWaitIdle({}, write_id);
+
+  uint32_t const reused_buffer_index = device->RegisterBindlessStorageBuffer(buffer, 0, kBufferSize);
+  uint32_t const reused_texture_index = device->RegisterBindlessSampledTexture(texture, subresource_range);
+  std::printf("storage buffer index %u -> %u, sampled texture index %u -> %u\n",
+    buffer_index, reused_buffer_index, texture_index, reused_texture_index);
+  MnTestCheck(reused_buffer_index == buffer_index, "retired storage buffer index reused after completion");
+  MnTestCheck(reused_texture_index == texture_index, "retired sampled texture index reused after completion");
+
+  device->UnregisterBindlessSampledTexture(reused_texture_index);
+  device->UnregisterBindlessStorageBuffer(reused_buffer_index);
+  device->DestroyTexture(texture);
+  device->DestroyBuffer(buffer);
+  nexus->Destroy();
+
+  return MnTestPassed() ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+
+#include <array>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// project headers --------------------------------------
+#include "mnexus/private/builtin_shader/buffer_repack_rows_spv.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+// Each iteration copies one row with its own program, then destroys the program and its pipeline without waiting,
+// the way hot-reload tools recreate programs every frame. Every other iteration destroys the program between
+// recording and submitting, while only the unsubmitted command list references it.
+constexpr uint32_t kIterationCount = 16;
+constexpr uint32_t kRowBytes = 256; // 64 words: one workgroup of buffer_repack_rows.
+constexpr uint32_t kWorkgroupSize = 64;
+
+// Matches `Params` in buffer_repack_rows.slang.
+struct RepackParams {
+  uint32_t src_offset;
+  uint32_t src_bytes_per_row;
+  uint32_t dst_bytes_per_row;
+  uint32_t row_count;
+};
+
+uint8_t SourceByte(uint32_t row, uint32_t column) {
+  return static_cast<uint8_t>(row * 31 + column * 7 + 1);
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  std::vector<uint8_t> source(size_t(kRowBytes) * kIterationCount);
+  for (uint32_t row = 0; row < kIterationCount; ++row) {
+    for (uint32_t column = 0; column < kRowBytes; ++column) {
+      source[size_t(row) * kRowBytes + column] = SourceByte(row, column);
+    }
+  }
+
+  mnexus::BufferHandle const src_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kStorage | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = static_cast<uint32_t>(source.size()),
+    }
+  );
+  device->QueueWriteBuffer({}, src_buffer, 0, source.data(), static_cast<uint32_t>(source.size()));
+
+  std::array<mnexus::BufferHandle, kIterationCount> params_buffers;
+  std::array<mnexus::BufferHandle, kIterationCount> dst_buffers;
+  for (uint32_t i = 0; i < kIterationCount; ++i) {
+    RepackParams const params {
+      .src_offset = i * kRowBytes,
+      .src_bytes_per_row = kRowBytes,
+      .dst_bytes_per_row = kRowBytes,
+      .row_count = 1,
+    };
+    params_buffers[i] = device->CreateBuffer(
+      mnexus::BufferDesc {
+        .usage = mnexus::BufferUsageFlagBits::kUniform | mnexus::BufferUsageFlagBits::kTransferDst,
+        .size_in_bytes = sizeof(RepackParams),
+      }
+    );
+    device->QueueWriteBuffer({}, params_buffers[i], 0, &params, sizeof(RepackParams));
+
+    dst_buffers[i] = device->CreateBuffer(
+      mnexus::BufferDesc {
+        .usage = mnexus::BufferUsageFlagBits::kStorage | mnexus::BufferUsageFlagBits::kTransferSrc,
+        .size_in_bytes = kRowBytes,
+      }
+    );
+  }
+
+  mnexus::ShaderModuleHandle const shader_module = device->CreateShaderModule(
+    mnexus::ShaderModuleDesc {
+      .source_language = mnexus::ShaderSourceLanguage::kSpirV,
+      .code_ptr = reinterpret_cast<uint64_t>(builtin_shader::kBufferRepackRowsSpv),
+      .code_size_in_bytes = builtin_shader::kBufferRepackRowsSpvSize,
+    }
+  );
+
+  mnexus::IntraQueueSubmissionId last_id {};
+  for (uint32_t i = 0; i < kIterationCount; ++i) {
+    mnexus::ProgramHandle const program = device->CreateProgram(
+      mnexus::ProgramDesc {
+        .shader_modules = shader_module,
+      }
+    );
+    mnexus::ComputePipelineHandle const compute_pipeline = device->CreateComputePipeline(
+      mnexus::ComputePipelineDesc {
+        .program = program,
+      }
+    );
+
+    mnexus::ICommandList* command_list = device->CreateCommandList({});
+    command_list->BindExplicitComputePipeline(compute_pipeline);
+    command_list->BindUniformBuffer({ .group = 0, .binding = 0 }, params_buffers[i], 0, sizeof(RepackParams));
+    command_list->BindStorageBuffer({ .group = 0, .binding = 1 }, src_buffer, 0, source.size());
+    command_list->BindStorageBuffer({ .group = 0, .binding = 2 }, dst_buffers[i], 0, kRowBytes);
+    command_list->DispatchCompute(kRowBytes / 4 / kWorkgroupSize, 1, 1);
+    command_list->End();
+
+    bool const destroy_before_submit = i % 2 == 0;
+    if (destroy_before_submit) {
+      device->DestroyProgram(program);
+    }
+    last_id = device->QueueSubmitCommandList({}, command_list);
+
+    // The dispatch is still in flight.
+    device->DestroyComputePipeline(compute_pipeline);
+    if (!destroy_before_submit) {
+      device->DestroyProgram(program);
+    }
+  }
+
+  device->QueueWaitIdle({}, last_id);
+
+  bool passed = last_id.Get() != 0;
+  for (uint32_t i = 0; i < kIterationCount; ++i) {
+    std::vector<uint8_t> readback(kRowBytes, 0);
+    mnexus::IntraQueueSubmissionId const read_id = device->QueueReadBuffer({}, dst_buffers[i], 0, readback.data(), kRowBytes);
+    device->QueueWaitIdle({}, read_id);
+
+    bool match = true;
+    for (uint32_t column = 0; column < kRowBytes; ++column) {
+      match = match && readback[column] == SourceByte(i, column);
+    }
+    std::printf("iteration %u: %s\n", i, match ? "OK" : "FAILED");
+    passed = match && passed;
+  }
+
+  // A program destroyed while only a discarded command list references it.
+  {
+    mnexus::ProgramHandle const program = device->CreateProgram(
+      mnexus::ProgramDesc {
+        .shader_modules = shader_module,
+      }
+    );
+    mnexus::ComputePipelineHandle const compute_pipeline = device->CreateComputePipeline(
+      mnexus::ComputePipelineDesc {
+        .program = program,
+      }
+    );
+    mnexus::ICommandList* command_list = device->CreateCommandList({});
+    command_list->BindExplicitComputePipeline(compute_pipeline);
+    command_list->End();
+    device->DestroyProgram(program);
+    device->DiscardCommandList(command_list);
+    device->DestroyComputePipeline(compute_pipeline);
+  }
+
+  // Program slots are recycled once retired; creating more programs must keep working.
+  mnexus::ProgramHandle const program = device->CreateProgram(
+    mnexus::ProgramDesc {
+      .shader_modules = shader_module,
+    }
+  );
+  passed = program.Get() != mnexus::ProgramHandle::Invalid().Get() && passed;
+  device->DestroyProgram(program);
+
+  device->DestroyShaderModule(shader_module);
+  for (uint32_t i = 0; i < kIterationCount; ++i) {
+    device->DestroyBuffer(params_buffers[i]);
+    device->DestroyBuffer(dst_buffers[i]);
+  }
+  device->DestroyBuffer(src_buffer);
+  nexus->Destroy();
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+
+#include <array>
+
+// public project headers -------------------------------
+#include "mnexus/public/frame_graph.h"
+#include "mnexus/public/memory_stats.h"
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kSceneSize = 256;
+
+mnexus::TextureDesc MakeColorTargetDesc(uint32_t size) {
+  return mnexus::TextureDesc {
+    .usage = mnexus::TextureUsageFlagBits::kAttachment |
+      mnexus::TextureUsageFlagBits::kSampled |
+      mnexus::TextureUsageFlagBits::kTransferDst,
+    .format = mnexus::Format::kR8G8B8A8_UNORM,
+    .dimension = mnexus::TextureDimension::k2D,
+    .width = size,
+    .height = size,
+    .depth = 1,
+    .mip_level_count = 1,
+    .array_layer_count = 1,
+  };
+}
+
+// A pass that writes `dst`, standing in for a draw that samples `src`.
+void AddClearPass(
+  mnexus::FrameGraph& frame_graph,
+  char const* name,
+  mnexus::FrameGraphTextureId src,
+  mnexus::FrameGraphTextureId dst,
+  float value
+) {
+  std::array<mnexus::FrameGraphTextureUse, 2> const uses {
+    mnexus::FrameGraphTextureUse { .texture = dst, .access = mnexus::TextureAccess::kTransferDst },
+    mnexus::FrameGraphTextureUse { .texture = src, .access = mnexus::TextureAccess::kSampled },
+  };
+  uint32_t const use_count = src.IsValid() ? 2 : 1;
+
+  frame_graph.AddPass(
+    name,
+    { uses.data(), use_count },
+    [dst, value](mnexus::ICommandList& command_list, mnexus::FrameGraph const& graph) {
+      mnexus::ClearValue clear_value;
+      clear_value.color = { value, value, value, 1.0f };
+      command_list.ClearTexture(
+        graph.GetTexture(dst),
+        mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+        clear_value
+      );
+    }
+  );
+}
+
+// Scene, a bloom downsample/upsample chain, and a composite into `output`.
+void BuildFrame(mnexus::FrameGraph& frame_graph, mnexus::TextureHandle output) {
+  mnexus::FrameGraphTextureId const scene = frame_graph.CreateTexture("scene", MakeColorTargetDesc(kSceneSize));
+  mnexus::FrameGraphTextureId const down1 = frame_graph.CreateTexture("bloom_down1", MakeColorTargetDesc(kSceneSize / 2));
+  mnexus::FrameGraphTextureId const down2 = frame_graph.CreateTexture("bloom_down2", MakeColorTargetDesc(kSceneSize / 4));
+  mnexus::FrameGraphTextureId const down3 = frame_graph.CreateTexture("bloom_down3", MakeColorTargetDesc(kSceneSize / 8));
+  mnexus::FrameGraphTextureId const up2 = frame_graph.CreateTexture("bloom_up2", MakeColorTargetDesc(kSceneSize / 4));
+  mnexus::FrameGraphTextureId const up1 = frame_graph.CreateTexture("bloom_up1", MakeColorTargetDesc(kSceneSize / 2));
+  mnexus::FrameGraphTextureId const composite = frame_graph.ImportTexture("output", output);
+
+  AddClearPass(frame_graph, "scene", mnexus::FrameGraphTextureId {}, scene, 0.5f);
+  AddClearPass(frame_graph, "bloom_down1", scene, down1, 0.25f);
+  AddClearPass(frame_graph, "bloom_down2", down1, down2, 0.125f);
+  AddClearPass(frame_graph, "bloom_down3", down2, down3, 0.0625f);
+  AddClearPass(frame_graph, "bloom_up2", down3, up2, 0.125f);
+  AddClearPass(frame_graph, "bloom_up1", up2, up1, 0.25f);
+  AddClearPass(frame_graph, "composite", up1, composite, 1.0f);
+}
+
+void RunFrame(mnexus::IDevice* device, mnexus::FrameGraph& frame_graph, mnexus::TextureHandle output) {
+  BuildFrame(frame_graph, output);
+  frame_graph.Compile();
+
+  mnexus::ICommandList* command_list = device->CreateCommandList({});
+  frame_graph.Execute(*command_list);
+  command_list->End();
+  mnexus::IntraQueueSubmissionId const submission_id = device->QueueSubmitCommandList({}, command_list);
+  device->QueueWaitIdle({}, submission_id);
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  bool const memory_aliasing = device->GetAdapterCapability().texture_memory_aliasing != MnBoolFalse;
+  std::printf("texture memory aliasing: %s\n", memory_aliasing ? "yes" : "no");
+
+  mnexus::TextureHandle const output = device->CreateTexture(MakeColorTargetDesc(kSceneSize));
+  mnexus::MemoryStats const baseline = device->GetMemoryStats();
+
+  {
+    mnexus::FrameGraph frame_graph(*device);
+
+    // First frame: creates the backend textures.
+    RunFrame(device, frame_graph, output);
+    mnexus::FrameGraphStats const stats = frame_graph.GetStats();
+    std::printf(
+      "passes %u, transients %u, physical %u, unaliased %llu bytes, aliased %llu bytes, %u transitions in %u batches\n",
+      stats.pass_count, stats.transient_texture_count, stats.physical_texture_count,
+      static_cast<unsigned long long>(stats.unaliased_size_in_bytes),
+      static_cast<unsigned long long>(stats.aliased_size_in_bytes),
+      stats.transition_count, stats.transition_batch_count
+    );
+
+    MnTestCheck(stats.pass_count == 7 && stats.transient_texture_count == 6, "declared passes and transients");
+    MnTestCheck(stats.aliased_size_in_bytes < stats.unaliased_size_in_bytes, "aliasing saves memory");
+    if (!memory_aliasing) {
+      MnTestCheck(stats.physical_texture_count < stats.transient_texture_count, "identical transients share textures");
+    }
+    MnTestCheck(stats.transition_batch_count <= stats.pass_count + 1, "at most one transition batch per pass");
+
+    mnexus::MemoryStats const first = device->GetMemoryStats();
+    MnTestCheck(first.textures.count == baseline.textures.count + stats.physical_texture_count, "physical texture count");
+    MnTestCheck(first.textures.size_in_bytes == baseline.textures.size_in_bytes + stats.aliased_size_in_bytes,
+      "device memory matches the aliased size");
+
+    // Second frame: the same graph reuses the backend textures.
+    frame_graph.Reset();
+    RunFrame(device, frame_graph, output);
+
+    mnexus::MemoryStats const second = device->GetMemoryStats();
+    MnTestCheck(second.textures.count == first.textures.count &&
+      second.textures.size_in_bytes == first.textures.size_in_bytes, "second frame reuses the backend textures");
+    MnTestCheck(frame_graph.GetStats().transition_count == stats.transition_count, "second frame transitions are stable");
+  }
+
+  mnexus::MemoryStats const after = device->GetMemoryStats();
+  MnTestCheck(after.textures.count == baseline.textures.count &&
+    after.textures.size_in_bytes == baseline.textures.size_in_bytes, "frame graph destroys its textures");
+
+  device->DestroyTexture(output);
+  nexus->Destroy();
+
+  return MnTestPassed() ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+// c++ headers ------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kBytesPerPixel = 4;
+
+struct MipLevel {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<float> texels; // Tightly packed RGBA, unquantized.
+};
+
+// 2x2 box filter with the footprint clamped to the source edge, matching `ICommandList::GenerateMipmaps`.
+MipLevel Downsample(MipLevel const& src) {
+  MipLevel dst;
+  dst.width = std::max(1u, src.width / 2);
+  dst.height = std::max(1u, src.height / 2);
+  dst.texels.resize(size_t(dst.width) * dst.height * kBytesPerPixel);
+
+  for (uint32_t y = 0; y < dst.height; ++y) {
+    for (uint32_t x = 0; x < dst.width; ++x) {
+      uint32_t const x0 = std::min(2 * x, src.width - 1);
+      uint32_t const x1 = std::min(2 * x + 1, src.width - 1);
+      uint32_t const y0 = std::min(2 * y, src.height - 1);
+      uint32_t const y1 = std::min(2 * y + 1, src.height - 1);
+
+      for (uint32_t c = 0; c < kBytesPerPixel; ++c) {
+        auto texel = [&](uint32_t sx, uint32_t sy) {
+          return src.texels[(size_t(sy) * src.width + sx) * kBytesPerPixel + c];
+        };
+        dst.texels[(size_t(y) * dst.width + x) * kBytesPerPixel + c] =
+          0.25f * (texel(x0, y0) + texel(x1, y0) + texel(x0, y1) + texel(x1, y1));
+      }
+    }
+  }
+  return dst;
+}
+
+// Per-channel tolerance in 8-bit steps. Backends may re-quantize every level, each adding up to half a step on top
+// of the unquantized reference.
+int GetTolerance(uint32_t level) {
+  return static_cast<int>(level / 2 + 1);
+}
+
+uint32_t AlignedBytesPerRow(uint32_t width) {
+  return (width * kBytesPerPixel + 255) & ~uint32_t(255);
+}
+
+uint32_t GetFullMipLevelCount(uint32_t width, uint32_t height) {
+  uint32_t count = 1;
+  for (uint32_t size = std::max(width, height); size > 1; size /= 2) {
+    ++count;
+  }
+  return count;
+}
+
+/// Generates the full mip chain of a `width` x `height` texture of a 4-byte unorm `format` and compares every level
+/// against the CPU reference. The reference filters bytes, so it holds for any channel order.
+bool RunCase(mnexus::IDevice* device, mnexus::Format format, uint32_t width, uint32_t height) {
+  uint32_t const mip_level_count = GetFullMipLevelCount(width, height);
+  std::printf("format %u, %ux%u, %u levels\n", static_cast<uint32_t>(format), width, height, mip_level_count);
+
+  // Build level 0 and the CPU reference chain.
+  std::vector<MipLevel> reference(mip_level_count);
+  reference[0].width = width;
+  reference[0].height = height;
+  std::vector<uint8_t> level0_pixels(size_t(width) * height * kBytesPerPixel);
+  for (uint32_t y = 0; y < height; ++y) {
+    for (uint32_t x = 0; x < width; ++x) {
+      uint8_t* p = &level0_pixels[(size_t(y) * width + x) * kBytesPerPixel];
+      p[0] = static_cast<uint8_t>(x);
+      p[1] = static_cast<uint8_t>(y);
+      p[2] = static_cast<uint8_t>(((x / 8) ^ (y / 8)) & 1 ? 255 : 0); // Checkerboard exercises the filter.
+      p[3] = static_cast<uint8_t>((x * 7 + y * 13) & 0xFF);
+    }
+  }
+  reference[0].texels.assign(level0_pixels.begin(), level0_pixels.end());
+  for (uint32_t level = 1; level < mip_level_count; ++level) {
+    reference[level] = Downsample(reference[level - 1]);
+  }
+
+  mnexus::TextureHandle texture = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kSampled |
+        mnexus::TextureUsageFlagBits::kTransferSrc |
+        mnexus::TextureUsageFlagBits::kTransferDst,
+      .format = format,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = width,
+      .height = height,
+      .depth = 1,
+      .mip_level_count = mip_level_count,
+      .array_layer_count = 1,
+    }
+  );
+
+  uint32_t const upload_size = static_cast<uint32_t>(level0_pixels.size());
+  mnexus::BufferHandle upload_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kTransferSrc | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = upload_size,
+    }
+  );
+  device->QueueWriteBuffer({}, upload_buffer, 0, level0_pixels.data(), upload_size);
+
+  // Readback layout: every level at its own offset with 256-byte aligned rows.
+  std::vector<uint32_t> readback_offsets(mip_level_count);
+  uint32_t readback_size = 0;
+  for (uint32_t level = 0; level < mip_level_count; ++level) {
+    readback_offsets[level] = readback_size;
+    readback_size += AlignedBytesPerRow(reference[level].width) * reference[level].height;
+  }
+
+  mnexus::BufferHandle readback_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kTransferSrc | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = readback_size,
+    }
+  );
+
+  // Upload level 0, generate the rest, read every level back.
+  mnexus::ICommandList* command_list = device->CreateCommandList({});
+
+  command_list->CopyBufferToTexture(
+    upload_buffer, 0,
+    texture, mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+    mnexus::Extent3d { width, height, 1 }
+  );
+
+  command_list->GenerateMipmaps(
+    texture,
+    mnexus::TextureSubresourceRange {
+      .aspect_mask = mnexus::TextureAspectFlagBits::kColor,
+      .base_mip_level = 0,
+      .mip_level_count = mip_level_count,
+      .base_array_layer = 0,
+      .array_layer_count = 1,
+    }
+  );
+
+  for (uint32_t level = 0; level < mip_level_count; ++level) {
+    command_list->CopyTextureToBuffer(
+      texture,
+      mnexus::TextureSubresourceRange::SingleSubresourceColor(level, 0),
+      readback_buffer,
+      readback_offsets[level],
+      mnexus::Extent3d { reference[level].width, reference[level].height, 1 }
+    );
+  }
+
+  command_list->End();
+  device->QueueSubmitCommandList({}, command_list);
+
+  std::vector<uint8_t> readback(readback_size);
+  mnexus::IntraQueueSubmissionId read_id = device->QueueReadBuffer(
+    {}, readback_buffer, 0, readback.data(), readback_size
+  );
+  device->QueueWaitIdle({}, read_id);
+
+  // Compare every level against the CPU reference.
+  bool passed = true;
+  for (uint32_t level = 0; level < mip_level_count; ++level) {
+    MipLevel const& expected = reference[level];
+    uint32_t const bytes_per_row = AlignedBytesPerRow(expected.width);
+
+    int max_diff = 0;
+    for (uint32_t y = 0; y < expected.height; ++y) {
+      uint8_t const* row = &readback[readback_offsets[level] + size_t(y) * bytes_per_row];
+      for (uint32_t i = 0; i < expected.width * kBytesPerPixel; ++i) {
+        int const expected_value = static_cast<int>(std::lround(expected.texels[size_t(y) * expected.width * kBytesPerPixel + i]));
+        max_diff = std::max(max_diff, std::abs(int(row[i]) - expected_value));
+      }
+    }
+
+    bool const level_passed = max_diff <= GetTolerance(level);
+    std::printf(
+      "mip %u (%ux%u): max diff %d %s\n",
+      level, expected.width, expected.height, max_diff, level_passed ? "OK" : "FAILED"
+    );
+    passed = passed && level_passed;
+  }
+
+  // Cleanup.
+  device->DestroyBuffer(readback_buffer);
+  device->DestroyBuffer(upload_buffer);
+  device->DestroyTexture(texture);
+
+  return passed;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  // Create headless nexus and device.
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  // RGBA8 is downsampled in compute on WebGPU; BGRA8 has no storage support there and goes through the blit
+  // fallback. Vulkan blits both.
+  bool passed = true;
+  for (mnexus::Format const format : { mnexus::Format::kR8G8B8A8_UNORM, mnexus::Format::kB8G8R8A8_UNORM }) {
+    passed = RunCase(device, format, 256, 256) && passed;
+    // Non-power-of-two: odd levels have a trailing row or column that the clamped box footprint never reads.
+    passed = RunCase(device, format, 37, 19) && passed;
+  }
+
+  nexus->Destroy();
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+// c++ headers ------------------------------------------
+#include <array>
+#include <cstdio>
+
+// public project headers -------------------------------
+#include "mnexus/public/gpu_timing.h"
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+// Number of reports `GetGpuTimingReport` retains; see its documentation.
+constexpr uint32_t kRetainedReportCount = 64;
+
+mnexus::IntraQueueSubmissionId SubmitTimedClear(mnexus::IDevice* device, mnexus::TextureHandle render_target) {
+  mnexus::ICommandList* command_list = device->CreateCommandList({});
+
+  command_list->PushDebugGroup("frame");
+
+  mnexus::ColorAttachmentDesc color_attachment {
+    .texture = render_target,
+    .subresource_range = mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+    .load_op = mnexus::LoadOp::kClear,
+    .store_op = mnexus::StoreOp::kStore,
+  };
+  command_list->BeginRenderPass(
+    mnexus::RenderPassDesc {
+      .color_attachments = color_attachment,
+    }
+  );
+  command_list->EndRenderPass();
+
+  command_list->PopDebugGroup();
+  command_list->End();
+
+  return device->QueueSubmitCommandList({}, command_list);
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::TextureHandle render_target = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kAttachment,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = 64,
+      .height = 64,
+      .depth = 1,
+      .mip_level_count = 1,
+      .array_layer_count = 1,
+    }
+  );
+
+  mnexus::GpuTimingReport report;
+
+  // Without instrumentation there is nothing to report.
+  mnexus::IntraQueueSubmissionId const untimed_id = SubmitTimedClear(device, render_target);
+  device->QueueWaitIdle({}, untimed_id);
+  MnTestCheck(device->GetGpuTimingReport({}, untimed_id, report) == MnBoolFalse, "no report while disabled");
+
+  if (device->GetAdapterCapability().timestamp_query == MnBoolFalse) {
+    std::printf("Adapter has no timestamp queries; skipping the timed part\n");
+    device->DestroyTexture(render_target);
+    nexus->Destroy();
+    return MnTestPassed() ? 0 : 1;
+  }
+
+  device->SetGpuTimingEnabled(true);
+
+  // Tree shape: the debug group encloses the render pass.
+  mnexus::IntraQueueSubmissionId const first_id = SubmitTimedClear(device, render_target);
+  device->QueueWaitIdle({}, first_id);
+
+  bool const found = device->GetGpuTimingReport({}, first_id, report) != MnBoolFalse;
+  MnTestCheck(found, "report available after completion");
+  if (found) {
+    MnTestCheck(report.submission_id.Get() == first_id.Get(), "report submission id");
+    MnTestCheck(report.scopes.size() == 2, "scope count");
+  }
+  if (found && report.scopes.size() == 2) {
+    mnexus::GpuTimingScope const& group = report.scopes[0];
+    mnexus::GpuTimingScope const& pass = report.scopes[1];
+    MnTestCheck(group.name == "frame", "debug group name");
+    MnTestCheck(group.kind == mnexus::GpuTimingScopeKind::kDebugGroup, "debug group kind");
+    MnTestCheck(group.parent_index == mnexus::kGpuTimingNoParent && group.depth == 0, "debug group is a root");
+    MnTestCheck(pass.kind == mnexus::GpuTimingScopeKind::kRenderPass, "render pass kind");
+    MnTestCheck(pass.parent_index == 0 && pass.depth == 1, "render pass nested in the debug group");
+    MnTestCheck(pass.valid && pass.end_ns >= pass.begin_ns, "render pass timed");
+    MnTestCheck(group.valid && group.begin_ns <= pass.begin_ns && group.end_ns >= pass.end_ns,
+      "debug group encloses the render pass");
+  }
+
+  // Retention: once the cache is full, the oldest report is evicted.
+  std::array<mnexus::IntraQueueSubmissionId, kRetainedReportCount> later_ids;
+  for (mnexus::IntraQueueSubmissionId& id : later_ids) {
+    id = SubmitTimedClear(device, render_target);
+  }
+  device->QueueWaitIdle({}, later_ids.back());
+
+  uint32_t later_found_count = 0;
+  for (mnexus::IntraQueueSubmissionId const id : later_ids) {
+    if (device->GetGpuTimingReport({}, id, report) != MnBoolFalse) {
+      ++later_found_count;
+    }
+  }
+  MnTestCheck(later_found_count == kRetainedReportCount, "latest reports retained");
+  MnTestCheck(device->GetGpuTimingReport({}, first_id, report) == MnBoolFalse, "oldest report evicted");
+
+  device->SetGpuTimingEnabled(false);
+
+  device->DestroyTexture(render_target);
+  nexus->Destroy();
+
+  return MnTestPassed() ? 0 : 1;
+}
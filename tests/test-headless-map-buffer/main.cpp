@@ -0,0 +1,87 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kBufferSize = 64 * 1024;
+constexpr uint32_t kWordCount = kBufferSize / sizeof(uint32_t);
+
+bool Check(char const* what, bool condition) {
+  std::printf("%s: %s\n", what, condition ? "OK" : "FAILED");
+  return condition;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::BufferHandle buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kStorage |
+        mnexus::BufferUsageFlagBits::kTransferSrc |
+        mnexus::BufferUsageFlagBits::kTransferDst |
+        mnexus::BufferUsageFlagBits::kMappable,
+      .size_in_bytes = kBufferSize,
+    }
+  );
+
+  bool passed = true;
+
+  auto* mapped = static_cast<uint32_t*>(device->MapBuffer(buffer));
+  passed = Check("map", mapped != nullptr) && passed;
+  if (mapped == nullptr) {
+    nexus->Destroy();
+    return 1;
+  }
+  passed = Check("map again returns the same pointer", device->MapBuffer(buffer) == mapped) && passed;
+
+  // CPU -> GPU: write in place, flush, then read the buffer back through the queue.
+  std::vector<uint32_t> cpu_words(kWordCount);
+  for (uint32_t i = 0; i < kWordCount; ++i) {
+    cpu_words[i] = i * 2654435761u;
+  }
+  std::memcpy(mapped, cpu_words.data(), kBufferSize);
+  device->FlushMappedBufferRange(buffer, 0, kBufferSize);
+
+  std::vector<uint32_t> gpu_words(kWordCount);
+  mnexus::IntraQueueSubmissionId read_id = device->QueueReadBuffer({}, buffer, 0, gpu_words.data(), kBufferSize);
+  device->QueueWaitIdle({}, read_id);
+  passed = Check("flushed writes are visible to the GPU", gpu_words == cpu_words) && passed;
+
+  // GPU -> CPU: overwrite a range through the queue, wait, invalidate and read it through the mapping.
+  constexpr uint32_t kRangeOffset = 4096;
+  constexpr uint32_t kRangeSize = 8192;
+  std::vector<uint32_t> queue_words(kRangeSize / sizeof(uint32_t));
+  for (uint32_t i = 0; i < queue_words.size(); ++i) {
+    queue_words[i] = 0xA5A50000u + i;
+  }
+  mnexus::IntraQueueSubmissionId write_id =
+    device->QueueWriteBuffer({}, buffer, kRangeOffset, queue_words.data(), kRangeSize);
+  device->QueueWaitIdle({}, write_id);
+  device->InvalidateMappedBufferRange(buffer, kRangeOffset, kRangeSize);
+  passed = Check(
+    "invalidated range shows GPU writes",
+    std::memcmp(reinterpret_cast<uint8_t const*>(mapped) + kRangeOffset, queue_words.data(), kRangeSize) == 0
+  ) && passed;
+
+  device->UnmapBuffer(buffer);
+  device->DestroyBuffer(buffer);
+
+  nexus->Destroy();
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+struct ThresholdRecord final {
+  uint32_t call_count = 0;
+  uint64_t last_size_in_bytes = 0;
+};
+
+void MNEXUS_CALL OnThresholdCrossed(uint64_t resource_size_in_bytes, void* user_data) {
+  auto* record = static_cast<ThresholdRecord*>(user_data);
+  ++record->call_count;
+  record->last_size_in_bytes = resource_size_in_bytes;
+}
+
+constexpr uint32_t kBufferSize = 64 * 1024;
+
+mnexus::BufferHandle CreateStorageBuffer(mnexus::IDevice* device) {
+  return device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kStorage,
+      .size_in_bytes = kBufferSize,
+    }
+  );
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::MemoryStats const baseline = device->GetMemoryStats();
+  for (mnexus::MemoryHeapStats const& heap : baseline.heaps) {
+    MnTestCheck(heap.size_in_bytes > 0 && heap.budget_in_bytes > 0, "heap reports a size and budget");
+  }
+
+  ThresholdRecord record;
+  uint64_t const threshold = baseline.GetResourceSizeInBytes() + kBufferSize * 2;
+  device->SetMemoryThresholdCallback(threshold, &OnThresholdCrossed, &record);
+
+  // Per-type totals.
+  mnexus::BufferHandle const buffer_a = CreateStorageBuffer(device);
+  mnexus::TextureHandle const texture = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kSampled | mnexus::TextureUsageFlagBits::kTransferDst,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .width = 64,
+      .height = 32,
+      .mip_level_count = 2,
+    }
+  );
+
+  mnexus::MemoryStats stats = device->GetMemoryStats();
+  MnTestCheck(stats.buffers.count == baseline.buffers.count + 1, "buffer count");
+  MnTestCheck(stats.buffers.size_in_bytes == baseline.buffers.size_in_bytes + kBufferSize, "buffer bytes");
+  MnTestCheck(stats.textures.count == baseline.textures.count + 1, "texture count");
+  MnTestCheck(stats.textures.size_in_bytes == baseline.textures.size_in_bytes + (64 * 32 + 32 * 16) * 4, "texture bytes include mips");
+  MnTestCheck(record.call_count == 0, "no callback below threshold");
+
+  // Crossing: fires once, then stays quiet until usage drops below the threshold again.
+  mnexus::BufferHandle const buffer_b = CreateStorageBuffer(device);
+  MnTestCheck(record.call_count == 1 && record.last_size_in_bytes >= threshold, "callback on crossing");
+
+  mnexus::BufferHandle const buffer_c = CreateStorageBuffer(device);
+  MnTestCheck(record.call_count == 1, "no callback while above threshold");
+
+  device->DestroyBuffer(buffer_c);
+  device->DestroyBuffer(buffer_b);
+  mnexus::BufferHandle const buffer_d = CreateStorageBuffer(device);
+  MnTestCheck(record.call_count == 2, "callback on crossing again");
+
+  device->SetMemoryThresholdCallback(0, nullptr, nullptr);
+  device->DestroyBuffer(buffer_d);
+  device->DestroyBuffer(buffer_a);
+  device->DestroyTexture(texture);
+
+  stats = device->GetMemoryStats();
+  MnTestCheck(stats.buffers.count == baseline.buffers.count && stats.buffers.size_in_bytes == baseline.buffers.size_in_bytes,
+    "buffer totals back to baseline");
+  MnTestCheck(stats.textures.count == baseline.textures.count && stats.textures.size_in_bytes == baseline.textures.size_in_bytes,
+    "texture totals back to baseline");
+  MnTestCheck(stats.heaps.size() == baseline.heaps.size(), "heap count is stable");
+
+  nexus->Destroy();
+
+  return MnTestPassed() ? 0 : 1;
+}
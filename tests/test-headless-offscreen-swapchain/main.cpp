@@ -0,0 +1,111 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+#include "mnexus/public/present_stats.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kImageCount = 3;
+constexpr uint32_t kImageSize = 64;
+constexpr uint64_t kPresentLatencyNs = 4'000'000;
+constexpr uint32_t kFrameCount = 16;
+
+void PrintStats(mnexus::PresentStats const& stats) {
+  std::printf(
+    "frames %llu, cpu frame time avg %llu ns max %llu ns, stall total %llu ns max %llu ns, queue depth last %u max %u\n",
+    static_cast<unsigned long long>(stats.frame_count),
+    static_cast<unsigned long long>(stats.GetAverageCpuFrameTimeNs()),
+    static_cast<unsigned long long>(stats.max_cpu_frame_time_ns),
+    static_cast<unsigned long long>(stats.total_stall_time_ns),
+    static_cast<unsigned long long>(stats.max_stall_time_ns),
+    stats.last_queue_depth, stats.max_queue_depth
+  );
+}
+
+// Clears the swapchain texture, as a frame's rendering would write it.
+bool RunFrame(
+  mnexus::INexus* nexus,
+  mnexus::IDevice* device,
+  float value,
+  mnexus::IntraQueueSubmissionId& out_submission_id
+) {
+  nexus->OnPresentPrologue();
+
+  mnexus::TextureHandle const swapchain_texture = device->GetSwapchainTexture();
+  if (!swapchain_texture.IsValid()) {
+    nexus->OnPresentEpilogue();
+    return false;
+  }
+
+  mnexus::ICommandList* command_list = device->CreateCommandList({});
+  mnexus::ClearValue clear_value;
+  clear_value.color = { value, value, value, 1.0f };
+  command_list->ClearTexture(
+    swapchain_texture,
+    mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+    clear_value
+  );
+  command_list->End();
+  out_submission_id = device->QueueSubmitCommandList({}, command_list);
+
+  nexus->OnPresentEpilogue();
+  return true;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+      .offscreen_swapchain = {
+        .image_count = kImageCount,
+        .width = kImageSize,
+        .height = kImageSize,
+        .present_latency_ns = kPresentLatencyNs,
+      },
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::TextureDesc swapchain_desc;
+  device->GetTextureDesc(device->GetSwapchainTexture(), swapchain_desc);
+  MnTestCheck(swapchain_desc.width == kImageSize && swapchain_desc.height == kImageSize, "swapchain texture size");
+
+  mnexus::IntraQueueSubmissionId submission_id {};
+  bool all_acquired = true;
+  for (uint32_t i = 0; i < kFrameCount; ++i) {
+    all_acquired = RunFrame(nexus, device, static_cast<float>(i) / kFrameCount, submission_id) && all_acquired;
+  }
+  MnTestCheck(all_acquired, "every frame acquires a swapchain texture");
+
+  mnexus::PresentStats const stats = nexus->GetPresentStats();
+  PrintStats(stats);
+
+  MnTestCheck(stats.frame_count == kFrameCount, "frame count");
+  MnTestCheck(stats.max_queue_depth >= 1 && stats.max_queue_depth <= kImageCount, "queue depth is bounded by the image count");
+  MnTestCheck(stats.total_stall_time_ns <= stats.total_cpu_frame_time_ns, "stall time is part of the frame time");
+  // An image is reacquired no sooner than the present latency after its present, so every `kImageCount` frames
+  // take at least the latency.
+  MnTestCheck(
+    stats.total_cpu_frame_time_ns >= (kFrameCount - 1) / kImageCount * kPresentLatencyNs,
+    "frames are paced by the present latency"
+  );
+
+  nexus->ResetPresentStats();
+  mnexus::PresentStats const reset = nexus->GetPresentStats();
+  MnTestCheck(reset.frame_count == 0 && reset.total_cpu_frame_time_ns == 0 && reset.max_queue_depth == 0, "reset clears the stats");
+
+  RunFrame(nexus, device, 1.0f, submission_id);
+  MnTestCheck(nexus->GetPresentStats().frame_count == 1, "frames are counted after a reset");
+
+  device->QueueWaitIdle({}, submission_id);
+  nexus->Destroy();
+
+  return MnTestPassed() ? 0 : 1;
+}
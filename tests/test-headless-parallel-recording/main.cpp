@@ -0,0 +1,151 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+
+#include <array>
+#include <barrier>
+#include <thread>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kThreadCount = 4;
+constexpr uint32_t kFrameCount = 48;
+constexpr uint32_t kListsPerThread = 3;
+// Bounds the frames in flight, like a swapchain would.
+constexpr uint32_t kFramesPerWait = 4;
+constexpr uint32_t kTextureSize = 4;
+constexpr uint32_t kBytesPerPixel = 4;
+
+uint8_t ClearByte(uint32_t frame, uint32_t thread, uint32_t list, uint32_t channel) {
+  return static_cast<uint8_t>(frame * 7 + thread * 31 + list * 13 + channel * 61);
+}
+
+mnexus::ClearValue MakeClearValue(uint32_t frame, uint32_t thread, uint32_t list) {
+  mnexus::ClearValue value {};
+  value.color.r = ClearByte(frame, thread, list, 0) / 255.0f;
+  value.color.g = ClearByte(frame, thread, list, 1) / 255.0f;
+  value.color.b = ClearByte(frame, thread, list, 2) / 255.0f;
+  value.color.a = ClearByte(frame, thread, list, 3) / 255.0f;
+  return value;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  std::array<mnexus::TextureHandle, kThreadCount> textures;
+  for (mnexus::TextureHandle& texture : textures) {
+    texture = device->CreateTexture(
+      mnexus::TextureDesc {
+        .usage = mnexus::TextureUsageFlagBits::kAttachment |
+          mnexus::TextureUsageFlagBits::kTransferSrc |
+          mnexus::TextureUsageFlagBits::kTransferDst,
+        .format = mnexus::Format::kR8G8B8A8_UNORM,
+        .dimension = mnexus::TextureDimension::k2D,
+        .width = kTextureSize,
+        .height = kTextureSize,
+        .depth = 1,
+        .mip_level_count = 1,
+        .array_layer_count = 1,
+      }
+    );
+  }
+
+  // Workers record every frame; the main thread submits their lists (and discards one extra list per worker), so
+  // command buffers are always returned from a thread other than the one that recorded them.
+  std::array<std::array<mnexus::ICommandList*, kListsPerThread + 1>, kThreadCount> recorded {};
+  std::barrier recorded_barrier(kThreadCount + 1);
+  std::barrier submitted_barrier(kThreadCount + 1);
+
+  std::vector<std::thread> workers;
+  for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+    workers.emplace_back([&, thread]() {
+      for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+        for (uint32_t list = 0; list < kListsPerThread; ++list) {
+          mnexus::ICommandList* command_list = device->CreateCommandList({});
+          command_list->ClearTexture(
+            textures[thread],
+            mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+            MakeClearValue(frame, thread, list)
+          );
+          command_list->End();
+          recorded[thread][list] = command_list;
+        }
+        // Never submitted: its clear must not show up in the result.
+        mnexus::ICommandList* discarded = device->CreateCommandList({});
+        discarded->ClearTexture(
+          textures[thread],
+          mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+          MakeClearValue(frame + 1, thread, 0)
+        );
+        discarded->End();
+        recorded[thread][kListsPerThread] = discarded;
+
+        recorded_barrier.arrive_and_wait();
+        submitted_barrier.arrive_and_wait();
+      }
+    });
+  }
+
+  mnexus::IntraQueueSubmissionId last_id {};
+  for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+    recorded_barrier.arrive_and_wait();
+
+    for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+      for (uint32_t list = 0; list < kListsPerThread; ++list) {
+        last_id = device->QueueSubmitCommandList({}, recorded[thread][list]);
+      }
+      device->DiscardCommandList(recorded[thread][kListsPerThread]);
+    }
+    if ((frame + 1) % kFramesPerWait == 0) {
+      device->QueueWaitIdle({}, last_id);
+    }
+
+    submitted_barrier.arrive_and_wait();
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // Each texture holds its worker's last submitted clear.
+  bool passed = last_id.Get() != 0;
+  for (uint32_t thread = 0; thread < kThreadCount; ++thread) {
+    std::vector<uint8_t> readback(size_t(kTextureSize) * kTextureSize * kBytesPerPixel, 0);
+    mnexus::IntraQueueSubmissionId const read_id = device->QueueReadTexture(
+      {},
+      textures[thread],
+      mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+      mnexus::Extent3d { kTextureSize, kTextureSize, 1 },
+      readback.data(),
+      readback.size()
+    );
+    device->QueueWaitIdle({}, read_id);
+
+    bool match = true;
+    for (size_t i = 0; i < readback.size(); ++i) {
+      uint32_t const channel = static_cast<uint32_t>(i % kBytesPerPixel);
+      match = match && readback[i] == ClearByte(kFrameCount - 1, thread, kListsPerThread - 1, channel);
+    }
+    std::printf("thread %u texture: %s\n", thread, match ? "OK" : "FAILED");
+    passed = match && passed;
+  }
+
+  for (mnexus::TextureHandle texture : textures) {
+    device->DestroyTexture(texture);
+  }
+  nexus->Destroy();
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,343 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+#include <cstring>
+
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/memory_stats.h"
+#include "mnexus/public/mnexus.h"
+
+// project headers --------------------------------------
+#include "mnexus/private/builtin_shader/buffer_repack_rows_spv.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+// Small buffers share native buffers when `NexusDesc::placed_buffers` is set, so every operation that addresses a
+// buffer must add the buffer's offset within its native buffer. Each check below fails if one path ignores it: the
+// operation then touches a neighbouring buffer, or the start of the shared native buffer, instead.
+
+namespace {
+
+constexpr uint32_t kBufferCount = 256;
+constexpr uint32_t kMappableBufferCount = 32;
+constexpr uint32_t kRowBytes = 256; // One workgroup of buffer_repack_rows.
+constexpr uint32_t kWorkgroupSize = 64;
+constexpr uint32_t kTextureSize = 16;
+
+// Matches `Params` in buffer_repack_rows.slang.
+struct RepackParams {
+  uint32_t src_offset;
+  uint32_t src_bytes_per_row;
+  uint32_t dst_bytes_per_row;
+  uint32_t row_count;
+};
+
+/// Sizes vary so that buffers land at irregular offsets within the shared native buffers.
+uint32_t BufferSize(uint32_t index) {
+  return 4 * (1 + (index * 37) % 64);
+}
+
+uint8_t PatternByte(uint32_t buffer, uint32_t byte, uint32_t generation) {
+  return static_cast<uint8_t>(buffer * 13 + byte * 7 + generation * 101 + 1);
+}
+
+std::vector<uint8_t> MakePattern(uint32_t buffer, uint32_t size, uint32_t generation) {
+  std::vector<uint8_t> pattern(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    pattern[i] = PatternByte(buffer, i, generation);
+  }
+  return pattern;
+}
+
+/// Creates `kBufferCount` small buffers, writes a distinct pattern into each (whole buffer, then a sub-range at a
+/// non-zero offset), reads every buffer back and returns whether all contents match.
+bool RoundTripSmallBuffers(mnexus::IDevice* device, std::vector<mnexus::BufferHandle>& out_buffers) {
+  out_buffers.resize(kBufferCount);
+  for (uint32_t i = 0; i < kBufferCount; ++i) {
+    out_buffers[i] = device->CreateBuffer(
+      mnexus::BufferDesc {
+        .usage = mnexus::BufferUsageFlagBits::kStorage |
+                 mnexus::BufferUsageFlagBits::kTransferSrc |
+                 mnexus::BufferUsageFlagBits::kTransferDst,
+        .size_in_bytes = BufferSize(i),
+      }
+    );
+    std::vector<uint8_t> const pattern = MakePattern(i, BufferSize(i), 0);
+    device->QueueWriteBuffer({}, out_buffers[i], 0, pattern.data(), BufferSize(i));
+  }
+
+  // Overwrite the second half of each buffer with a second generation.
+  for (uint32_t i = 0; i < kBufferCount; ++i) {
+    uint32_t const half = BufferSize(i) / 8 * 4;
+    std::vector<uint8_t> const pattern = MakePattern(i, BufferSize(i), 1);
+    device->QueueWriteBuffer({}, out_buffers[i], half, pattern.data() + half, BufferSize(i) - half);
+  }
+
+  std::vector<std::vector<uint8_t>> readbacks(kBufferCount);
+  mnexus::IntraQueueSubmissionId last_read_id {};
+  for (uint32_t i = 0; i < kBufferCount; ++i) {
+    readbacks[i].resize(BufferSize(i));
+    last_read_id = device->QueueReadBuffer({}, out_buffers[i], 0, readbacks[i].data(), BufferSize(i));
+  }
+  device->QueueWaitIdle({}, last_read_id);
+
+  for (uint32_t i = 0; i < kBufferCount; ++i) {
+    uint32_t const half = BufferSize(i) / 8 * 4;
+    for (uint32_t byte = 0; byte < BufferSize(i); ++byte) {
+      if (readbacks[i][byte] != PatternByte(i, byte, byte < half ? 0 : 1)) {
+        std::printf("  buffer %u byte %u mismatch\n", i, byte);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CheckMappedBuffers(mnexus::IDevice* device) {
+  std::vector<mnexus::BufferHandle> buffers(kMappableBufferCount);
+  std::vector<uint8_t*> mapped(kMappableBufferCount);
+  for (uint32_t i = 0; i < kMappableBufferCount; ++i) {
+    buffers[i] = device->CreateBuffer(
+      mnexus::BufferDesc {
+        .usage = mnexus::BufferUsageFlagBits::kMappable |
+                 mnexus::BufferUsageFlagBits::kTransferSrc |
+                 mnexus::BufferUsageFlagBits::kTransferDst,
+        .size_in_bytes = BufferSize(i),
+      }
+    );
+    mapped[i] = static_cast<uint8_t*>(device->MapBuffer(buffers[i]));
+    if (mapped[i] == nullptr) {
+      std::printf("  MapBuffer returned null for buffer %u\n", i);
+      return false;
+    }
+  }
+
+  // CPU writes through the mapping + flush, read back through the queue.
+  for (uint32_t i = 0; i < kMappableBufferCount; ++i) {
+    std::vector<uint8_t> const pattern = MakePattern(i, BufferSize(i), 2);
+    std::memcpy(mapped[i], pattern.data(), BufferSize(i));
+    device->FlushMappedBufferRange(buffers[i], 0, BufferSize(i));
+  }
+  std::vector<std::vector<uint8_t>> readbacks(kMappableBufferCount);
+  mnexus::IntraQueueSubmissionId last_id {};
+  for (uint32_t i = 0; i < kMappableBufferCount; ++i) {
+    readbacks[i].resize(BufferSize(i));
+    last_id = device->QueueReadBuffer({}, buffers[i], 0, readbacks[i].data(), BufferSize(i));
+  }
+  device->QueueWaitIdle({}, last_id);
+
+  bool passed = true;
+  for (uint32_t i = 0; i < kMappableBufferCount && passed; ++i) {
+    passed = readbacks[i] == MakePattern(i, BufferSize(i), 2);
+  }
+  MnTestCheck(passed, "mapped writes + flush are read back by the queue");
+
+  // Queue writes, invalidate, read through the mapping.
+  for (uint32_t i = 0; i < kMappableBufferCount; ++i) {
+    std::vector<uint8_t> const pattern = MakePattern(i, BufferSize(i), 3);
+    last_id = device->QueueWriteBuffer({}, buffers[i], 0, pattern.data(), BufferSize(i));
+  }
+  device->QueueWaitIdle({}, last_id);
+
+  bool invalidate_passed = true;
+  for (uint32_t i = 0; i < kMappableBufferCount; ++i) {
+    device->InvalidateMappedBufferRange(buffers[i], 0, BufferSize(i));
+    std::vector<uint8_t> const expected = MakePattern(i, BufferSize(i), 3);
+    invalidate_passed = invalidate_passed && std::memcmp(mapped[i], expected.data(), BufferSize(i)) == 0;
+  }
+  MnTestCheck(invalidate_passed, "queue writes are visible through the mapping after invalidate");
+
+  for (mnexus::BufferHandle const buffer : buffers) {
+    device->UnmapBuffer(buffer);
+    device->DestroyBuffer(buffer);
+  }
+  return passed && invalidate_passed;
+}
+
+bool CheckCopyBufferToTexture(mnexus::IDevice* device) {
+  constexpr uint32_t kImageBytes = kTextureSize * kTextureSize * 4;
+
+  // A small leading buffer makes sure the source does not start at offset 0 of its native buffer.
+  mnexus::BufferHandle const leading_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kTransferSrc,
+      .size_in_bytes = 64,
+    }
+  );
+  mnexus::BufferHandle const src_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kTransferSrc | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = kImageBytes,
+    }
+  );
+  std::vector<uint8_t> const pixels = MakePattern(1000, kImageBytes, 0);
+  device->QueueWriteBuffer({}, src_buffer, 0, pixels.data(), kImageBytes);
+
+  mnexus::TextureHandle const texture = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kTransferDst | mnexus::TextureUsageFlagBits::kTransferSrc,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = kTextureSize,
+      .height = kTextureSize,
+      .depth = 1,
+      .mip_level_count = 1,
+      .array_layer_count = 1,
+    }
+  );
+
+  mnexus::ICommandList* command_list = device->CreateCommandList({});
+  command_list->CopyBufferToTexture(
+    src_buffer, 0,
+    texture, mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+    mnexus::Extent3d { kTextureSize, kTextureSize, 1 }
+  );
+  command_list->End();
+  device->QueueSubmitCommandList({}, command_list);
+
+  std::vector<uint8_t> readback(kImageBytes);
+  mnexus::IntraQueueSubmissionId const read_id = device->QueueReadTexture(
+    {},
+    texture,
+    mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+    mnexus::Extent3d { kTextureSize, kTextureSize, 1 },
+    readback.data(),
+    kImageBytes
+  );
+  device->QueueWaitIdle({}, read_id);
+
+  device->DestroyTexture(texture);
+  device->DestroyBuffer(src_buffer);
+  device->DestroyBuffer(leading_buffer);
+  return readback == pixels;
+}
+
+/// Repacks one row from a placed storage buffer into another through a compute dispatch whose parameters come from a
+/// placed uniform buffer, which exercises `BindUniformBuffer` and `BindStorageBuffer`.
+bool CheckComputeBindings(mnexus::IDevice* device) {
+  RepackParams const params {
+    .src_offset = 0,
+    .src_bytes_per_row = kRowBytes,
+    .dst_bytes_per_row = kRowBytes,
+    .row_count = 1,
+  };
+  mnexus::BufferHandle const params_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kUniform | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = sizeof(RepackParams),
+    }
+  );
+  device->QueueWriteBuffer({}, params_buffer, 0, &params, sizeof(RepackParams));
+
+  mnexus::BufferHandle const src_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kStorage | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = kRowBytes,
+    }
+  );
+  std::vector<uint8_t> const source = MakePattern(2000, kRowBytes, 0);
+  device->QueueWriteBuffer({}, src_buffer, 0, source.data(), kRowBytes);
+
+  mnexus::BufferHandle const dst_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kStorage | mnexus::BufferUsageFlagBits::kTransferSrc,
+      .size_in_bytes = kRowBytes,
+    }
+  );
+
+  mnexus::ShaderModuleHandle const shader_module = device->CreateShaderModule(
+    mnexus::ShaderModuleDesc {
+      .source_language = mnexus::ShaderSourceLanguage::kSpirV,
+      .code_ptr = reinterpret_cast<uint64_t>(builtin_shader::kBufferRepackRowsSpv),
+      .code_size_in_bytes = builtin_shader::kBufferRepackRowsSpvSize,
+    }
+  );
+  mnexus::ProgramHandle const program = device->CreateProgram(
+    mnexus::ProgramDesc {
+      .shader_modules = shader_module,
+    }
+  );
+  mnexus::ComputePipelineHandle const compute_pipeline = device->CreateComputePipeline(
+    mnexus::ComputePipelineDesc {
+      .program = program,
+    }
+  );
+
+  mnexus::ICommandList* command_list = device->CreateCommandList({});
+  command_list->BindExplicitComputePipeline(compute_pipeline);
+  command_list->BindUniformBuffer({ .group = 0, .binding = 0 }, params_buffer, 0, sizeof(RepackParams));
+  command_list->BindStorageBuffer({ .group = 0, .binding = 1 }, src_buffer, 0, kRowBytes);
+  command_list->BindStorageBuffer({ .group = 0, .binding = 2 }, dst_buffer, 0, kRowBytes);
+  command_list->DispatchCompute(kRowBytes / 4 / kWorkgroupSize, 1, 1);
+  command_list->End();
+  device->QueueSubmitCommandList({}, command_list);
+
+  std::vector<uint8_t> readback(kRowBytes);
+  mnexus::IntraQueueSubmissionId const read_id = device->QueueReadBuffer({}, dst_buffer, 0, readback.data(), kRowBytes);
+  device->QueueWaitIdle({}, read_id);
+
+  device->DestroyComputePipeline(compute_pipeline);
+  device->DestroyProgram(program);
+  device->DestroyShaderModule(shader_module);
+  device->DestroyBuffer(dst_buffer);
+  device->DestroyBuffer(src_buffer);
+  device->DestroyBuffer(params_buffer);
+  return readback == source;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+      .placed_buffers = true,
+      .bindless_resources = true,
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  uint64_t const baseline_buffer_count = device->GetMemoryStats().buffers.count;
+
+  std::vector<mnexus::BufferHandle> buffers;
+  MnTestCheck(RoundTripSmallBuffers(device, buffers), "queue write/read round trip of small buffers");
+
+  if (device->GetAdapterCapability().bindless_resources != MnBoolFalse) {
+    bool registered = true;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < 8; ++i) {
+      uint32_t const index = device->RegisterBindlessStorageBuffer(buffers[i], 0, BufferSize(i));
+      registered = registered && index != mnexus::kInvalidBindlessIndex;
+      indices.emplace_back(index);
+    }
+    MnTestCheck(registered, "bindless registration of placed buffers");
+    for (uint32_t const index : indices) {
+      if (index != mnexus::kInvalidBindlessIndex) {
+        device->UnregisterBindlessStorageBuffer(index);
+      }
+    }
+  } else {
+    std::printf("No bindless resources; skipping bindless registration\n");
+  }
+
+  MnTestCheck(CheckMappedBuffers(device), "mapped placed buffers");
+  MnTestCheck(CheckCopyBufferToTexture(device), "copy from a placed buffer into a texture");
+  MnTestCheck(CheckComputeBindings(device), "uniform and storage bindings of placed buffers");
+
+  // Destroying returns the ranges once the GPU is done with them; new buffers may then reuse them.
+  for (mnexus::BufferHandle const buffer : buffers) {
+    device->DestroyBuffer(buffer);
+  }
+  MnTestCheck(device->GetMemoryStats().buffers.count == baseline_buffer_count, "destroyed buffers are released");
+
+  MnTestCheck(RoundTripSmallBuffers(device, buffers), "round trip after destruction");
+  for (mnexus::BufferHandle const buffer : buffers) {
+    device->DestroyBuffer(buffer);
+  }
+
+  nexus->Destroy();
+
+  return MnTestPassed() ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+// c++ headers ------------------------------------------
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_repack_shader.h"
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kRowCount = 8;
+constexpr uint32_t kRowBytes = 256; // 64 words: one workgroup of buffer_repack_rows. Also a valid binding offset.
+constexpr uint32_t kWorkgroupSize = 64;
+
+uint8_t SourceByte(uint32_t row, uint32_t column) {
+  return static_cast<uint8_t>(row * 31 + column * 7 + 1);
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  std::vector<uint8_t> source(size_t(kRowBytes) * kRowCount);
+  for (uint32_t row = 0; row < kRowCount; ++row) {
+    for (uint32_t column = 0; column < kRowBytes; ++column) {
+      source[size_t(row) * kRowBytes + column] = SourceByte(row, column);
+    }
+  }
+
+  mnexus::BufferHandle const src_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kStorage | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = static_cast<uint32_t>(source.size()),
+    }
+  );
+  device->QueueWriteBuffer({}, src_buffer, 0, source.data(), static_cast<uint32_t>(source.size()));
+
+  mnexus::BufferHandle const dst_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kStorage | mnexus::BufferUsageFlagBits::kTransferSrc,
+      .size_in_bytes = static_cast<uint32_t>(source.size()),
+    }
+  );
+
+  std::vector<uint32_t> const spirv = mn_repack::MakePushConstantRepackSpirv();
+  mnexus::ShaderModuleHandle const shader_module = device->CreateShaderModule(
+    mnexus::ShaderModuleDesc {
+      .source_language = mnexus::ShaderSourceLanguage::kSpirV,
+      .code_ptr = reinterpret_cast<uint64_t>(spirv.data()),
+      .code_size_in_bytes = static_cast<uint32_t>(spirv.size() * sizeof(uint32_t)),
+    }
+  );
+  mnexus::ProgramHandle const program = device->CreateProgram(
+    mnexus::ProgramDesc {
+      .shader_modules = shader_module,
+    }
+  );
+  mnexus::ComputePipelineHandle const compute_pipeline = device->CreateComputePipeline(
+    mnexus::ComputePipelineDesc {
+      .program = program,
+    }
+  );
+
+  // Every row is one dispatch. The full block is pushed once; each dispatch then only rewrites `src_offset`.
+  mnexus::ICommandList* command_list = device->CreateCommandList({});
+  command_list->BindExplicitComputePipeline(compute_pipeline);
+  command_list->BindStorageBuffer({ .group = 0, .binding = 1 }, src_buffer, 0, source.size());
+  command_list->SetPushConstants(
+    mnexus::ShaderStageFlagBits::kCompute, 0,
+    mn_repack::RepackParams {
+      .src_offset = 0,
+      .src_bytes_per_row = kRowBytes,
+      .dst_bytes_per_row = kRowBytes,
+      .row_count = 1,
+    }
+  );
+  for (uint32_t row = 0; row < kRowCount; ++row) {
+    uint32_t const src_offset = row * kRowBytes;
+    command_list->SetPushConstants(
+      mnexus::ShaderStageFlagBits::kCompute, offsetof(mn_repack::RepackParams, src_offset), src_offset
+    );
+    command_list->BindStorageBuffer({ .group = 0, .binding = 2 }, dst_buffer, src_offset, kRowBytes);
+    command_list->DispatchCompute(kRowBytes / 4 / kWorkgroupSize, 1, 1);
+  }
+  command_list->End();
+  mnexus::IntraQueueSubmissionId const submit_id = device->QueueSubmitCommandList({}, command_list);
+  device->QueueWaitIdle({}, submit_id);
+
+  std::vector<uint8_t> readback(source.size(), 0);
+  mnexus::IntraQueueSubmissionId const read_id =
+    device->QueueReadBuffer({}, dst_buffer, 0, readback.data(), static_cast<uint32_t>(readback.size()));
+  device->QueueWaitIdle({}, read_id);
+
+  bool passed = submit_id.Get() != 0;
+  for (uint32_t row = 0; row < kRowCount; ++row) {
+    bool match = true;
+    for (uint32_t column = 0; column < kRowBytes; ++column) {
+      match = match && readback[size_t(row) * kRowBytes + column] == SourceByte(row, column);
+    }
+    std::printf("row %u: %s\n", row, match ? "OK" : "FAILED");
+    passed = match && passed;
+  }
+
+  device->DestroyComputePipeline(compute_pipeline);
+  device->DestroyProgram(program);
+  device->DestroyShaderModule(shader_module);
+  device->DestroyBuffer(dst_buffer);
+  device->DestroyBuffer(src_buffer);
+  nexus->Destroy();
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kSubmissionsPerQueue = 4;
+
+struct QueueTimeline final {
+  mnexus::QueueId queue_id;
+  std::vector<mnexus::IntraQueueSubmissionId> submission_ids;
+};
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  // Enumeration.
+  uint32_t const family_count = device->QueueGetFamilyCount();
+  MnTestCheck(family_count >= 1, "at least one queue family");
+
+  std::vector<QueueTimeline> timelines;
+  bool has_graphics = false;
+  bool capabilities_reported = true;
+  for (uint32_t family = 0; family < family_count; ++family) {
+    mnexus::QueueFamilyDesc desc;
+    if (device->QueueGetFamilyDesc(family, desc) == MnBoolFalse) {
+      MnTestCheck(false, "QueueGetFamilyDesc succeeds in range");
+      continue;
+    }
+    bool const graphics = desc.capabilities.HasAnyOf(mnexus::QueueFamilyCapabilityFlagBits::kGraphics);
+    bool const compute = desc.capabilities.HasAnyOf(mnexus::QueueFamilyCapabilityFlagBits::kCompute);
+    bool const transfer = desc.capabilities.HasAnyOf(mnexus::QueueFamilyCapabilityFlagBits::kTransfer);
+    bool const video = desc.capabilities.HasAnyOf(
+      mnexus::QueueFamilyCapabilityFlagBits::kVideoDecode | mnexus::QueueFamilyCapabilityFlagBits::kVideoEncode
+    );
+    std::printf("family %u: %u queue(s),%s%s%s%s\n", family, desc.queue_count,
+      graphics ? " graphics" : "", compute ? " compute" : "", transfer ? " transfer" : "", video ? " video" : "");
+
+    capabilities_reported = capabilities_reported && (graphics || compute || transfer || video);
+    if (graphics || compute) {
+      capabilities_reported = capabilities_reported && transfer;
+    }
+    if (desc.queue_count != 0 && graphics) {
+      has_graphics = true;
+    }
+    for (uint32_t index = 0; index < desc.queue_count; ++index) {
+      timelines.emplace_back(QueueTimeline { .queue_id = mnexus::QueueId(family, index), .submission_ids = {} });
+    }
+  }
+  mnexus::QueueFamilyDesc out_of_range_desc;
+  MnTestCheck(device->QueueGetFamilyDesc(family_count, out_of_range_desc) == MnBoolFalse, "out-of-range family is rejected");
+  MnTestCheck(capabilities_reported, "every family reports capabilities");
+  MnTestCheck(has_graphics, "a created queue supports graphics");
+  MnTestCheck(!timelines.empty(), "at least one queue");
+
+  // Interleave submissions across every queue; each queue keeps its own timeline.
+  for (uint32_t round = 0; round < kSubmissionsPerQueue; ++round) {
+    for (QueueTimeline& timeline : timelines) {
+      mnexus::ICommandList* command_list = device->CreateCommandList({
+        .queue_family_index = timeline.queue_id.queue_family_index,
+      });
+      command_list->End();
+      timeline.submission_ids.push_back(device->QueueSubmitCommandList(timeline.queue_id, command_list));
+    }
+  }
+
+  bool strictly_increasing = true;
+  for (QueueTimeline const& timeline : timelines) {
+    for (uint32_t i = 0; i < kSubmissionsPerQueue; ++i) {
+      uint64_t const previous = i == 0 ? 0 : timeline.submission_ids[i - 1].Get();
+      strictly_increasing = strictly_increasing && timeline.submission_ids[i].Get() > previous;
+    }
+  }
+  MnTestCheck(strictly_increasing, "submission ids strictly increase per queue");
+
+  // Nothing else is submitted meanwhile, so each queue's ids are consecutive. A timeline shared between queues would
+  // also have advanced by the interleaved submissions of the others.
+  bool independent = true;
+  for (QueueTimeline const& timeline : timelines) {
+    uint64_t const span = timeline.submission_ids.back().Get() - timeline.submission_ids.front().Get();
+    independent = independent && span == kSubmissionsPerQueue - 1;
+  }
+  MnTestCheck(independent, "each queue's timeline advances only with its own submissions");
+  if (timelines.size() == 1) {
+    std::printf("single queue: interleaving across queues not exercised\n");
+  }
+
+  bool completed = true;
+  for (QueueTimeline const& timeline : timelines) {
+    device->QueueWaitIdle(timeline.queue_id, timeline.submission_ids.back());
+    completed = completed && device->QueueGetCompletedValue(timeline.queue_id).Get() >= timeline.submission_ids.back().Get();
+  }
+  MnTestCheck(completed, "every queue completes its submissions");
+
+  nexus->Destroy();
+
+  return MnTestPassed() ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+#include <cstring>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+// conditional platform headers -------------------------
+#if defined(__linux__)
+# include <poll.h>
+# include <unistd.h>
+#endif
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kBufferSize = 4096;
+
+bool Check(char const* what, bool condition) {
+  std::printf("%s: %s\n", what, condition ? "OK" : "FAILED");
+  return condition;
+}
+
+struct CallbackLog {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<uint64_t> values;
+
+  // Checked from inside the readback callback: the destination must already be populated.
+  std::vector<uint8_t> const* readback = nullptr;
+  std::vector<uint8_t> const* expected = nullptr;
+  bool readback_ready_in_callback = false;
+};
+
+void MNEXUS_CALL OnCompleted(MnIntraQueueSubmissionId value, void* user_data) {
+  auto* log = static_cast<CallbackLog*>(user_data);
+  std::lock_guard lock(log->mutex);
+  log->values.push_back(value);
+  log->cv.notify_all();
+}
+
+void MNEXUS_CALL OnReadbackCompleted(MnIntraQueueSubmissionId value, void* user_data) {
+  auto* log = static_cast<CallbackLog*>(user_data);
+  bool const ready = std::memcmp(log->readback->data(), log->expected->data(), log->expected->size()) == 0;
+  {
+    std::lock_guard lock(log->mutex);
+    log->readback_ready_in_callback = ready;
+  }
+  OnCompleted(value, user_data);
+}
+
+bool WaitForCallbacks(CallbackLog& log, size_t count) {
+  std::unique_lock lock(log.mutex);
+  return log.cv.wait_for(lock, std::chrono::seconds(5), [&]() { return log.values.size() >= count; });
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::BufferHandle buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kTransferSrc | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = kBufferSize,
+    }
+  );
+
+  std::vector<uint8_t> pattern(kBufferSize);
+  for (uint32_t i = 0; i < kBufferSize; ++i) {
+    pattern[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  std::vector<uint8_t> readback(kBufferSize, 0);
+
+  CallbackLog log;
+  log.readback = &readback;
+  log.expected = &pattern;
+
+  bool passed = true;
+
+  // Callbacks are delivered in ascending value order regardless of registration order.
+  mnexus::IntraQueueSubmissionId const write_id = device->QueueWriteBuffer({}, buffer, 0, pattern.data(), kBufferSize);
+  mnexus::IntraQueueSubmissionId const read_id = device->QueueReadBuffer({}, buffer, 0, readback.data(), kBufferSize);
+
+  device->QueueOnCompleted({}, read_id, OnReadbackCompleted, &log);
+  device->QueueOnCompleted({}, write_id, OnCompleted, &log);
+  device->QueueOnCompleted({}, mnexus::IntraQueueSubmissionId { 0 }, OnCompleted, &log);
+
+  // Without a completion thread (Web) callbacks are delivered by polling.
+  device->QueueWaitIdle({}, read_id);
+  (void)device->QueueGetCompletedValue({});
+
+  passed = Check("all callbacks delivered", WaitForCallbacks(log, 3)) && passed;
+  {
+    std::lock_guard lock(log.mutex);
+    passed = Check(
+      "ascending value order",
+      log.values.size() == 3 &&
+      log.values[0] == 0 && log.values[1] == write_id.Get() && log.values[2] == read_id.Get()
+    ) && passed;
+    passed = Check("readback visible inside callback", log.readback_ready_in_callback) && passed;
+  }
+
+  // Already-completed values are delivered promptly, too.
+  device->QueueOnCompleted({}, write_id, OnCompleted, &log);
+  (void)device->QueueGetCompletedValue({});
+  passed = Check("already-completed value delivered", WaitForCallbacks(log, 4)) && passed;
+
+#if defined(__linux__)
+  // The completion event becomes readable once the queue advances.
+  intptr_t const event = device->QueueGetCompletionEvent({});
+  passed = Check("completion event available", event != -1) && passed;
+  if (event != -1) {
+    int const fd = static_cast<int>(event);
+
+    uint64_t drained = 0;
+    (void)::read(fd, &drained, sizeof(drained));
+
+    mnexus::IntraQueueSubmissionId const next_read_id =
+      device->QueueReadBuffer({}, buffer, 0, readback.data(), kBufferSize);
+
+    pollfd poll_fd { .fd = fd, .events = POLLIN, .revents = 0 };
+    bool const signaled = ::poll(&poll_fd, 1, 5000) == 1;
+    passed = Check("completion event signaled", signaled) && passed;
+    if (signaled) {
+      passed = Check("completed value advanced", device->QueueGetCompletedValue({}).Get() >= next_read_id.Get()) && passed;
+    }
+
+    device->QueueWaitIdle({}, next_read_id);
+  }
+#endif
+
+  device->DestroyBuffer(buffer);
+  nexus->Destroy();
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kBytesPerPixel = 4;
+
+// Uploads a generated RGBA8 image per layer, reads all layers back with one `QueueReadTexture` and checks that the
+// rows arrive tightly packed and byte-exact, layer after layer.
+bool RunCase(mnexus::IDevice* device, uint32_t width, uint32_t height, uint32_t layer_count) {
+  uint32_t const row_size = width * kBytesPerPixel;
+  uint32_t const image_size = row_size * height;
+  uint32_t const total_size = image_size * layer_count;
+
+  std::vector<uint8_t> pixels(total_size);
+  for (uint32_t layer = 0; layer < layer_count; ++layer) {
+    for (uint32_t y = 0; y < height; ++y) {
+      for (uint32_t x = 0; x < width; ++x) {
+        uint8_t* p = &pixels[size_t(layer) * image_size + size_t(y) * row_size + size_t(x) * kBytesPerPixel];
+        p[0] = static_cast<uint8_t>(x);
+        p[1] = static_cast<uint8_t>(y);
+        p[2] = static_cast<uint8_t>(x ^ y);
+        p[3] = static_cast<uint8_t>((x * 7 + y * 13 + layer * 59) & 0xFF);
+      }
+    }
+  }
+
+  mnexus::TextureHandle texture = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kTransferSrc | mnexus::TextureUsageFlagBits::kTransferDst,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = width,
+      .height = height,
+      .depth = 1,
+      .mip_level_count = 1,
+      .array_layer_count = layer_count,
+    }
+  );
+
+  mnexus::BufferHandle upload_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kTransferSrc | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = total_size,
+    }
+  );
+  device->QueueWriteBuffer({}, upload_buffer, 0, pixels.data(), total_size);
+
+  mnexus::ICommandList* command_list = device->CreateCommandList({});
+  for (uint32_t layer = 0; layer < layer_count; ++layer) {
+    command_list->CopyBufferToTexture(
+      upload_buffer, layer * image_size,
+      texture, mnexus::TextureSubresourceRange::SingleSubresourceColor(0, layer),
+      mnexus::Extent3d { width, height, 1 }
+    );
+  }
+  command_list->End();
+  device->QueueSubmitCommandList({}, command_list);
+
+  // One guard row past the image catches writes beyond the tightly packed size.
+  std::vector<uint8_t> readback(size_t(total_size) + row_size, 0xCD);
+  mnexus::TextureSubresourceRange subresource_range = mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0);
+  subresource_range.array_layer_count = layer_count;
+  mnexus::IntraQueueSubmissionId read_id = device->QueueReadTexture(
+    {},
+    texture,
+    subresource_range,
+    mnexus::Extent3d { width, height, 1 },
+    readback.data(),
+    total_size
+  );
+  device->QueueWaitIdle({}, read_id);
+
+  bool const pixels_match = read_id.Get() != 0 && std::memcmp(readback.data(), pixels.data(), total_size) == 0;
+  bool guard_intact = true;
+  for (uint32_t i = total_size; i < readback.size(); ++i) {
+    guard_intact = guard_intact && readback[i] == 0xCD;
+  }
+
+  bool const passed = pixels_match && guard_intact;
+  std::printf(
+    "%ux%u x %u layer(s) (row %u bytes): %s%s\n",
+    width, height, layer_count, row_size,
+    passed ? "OK" : "FAILED",
+    guard_intact ? "" : " (wrote past the end)"
+  );
+
+  device->DestroyBuffer(upload_buffer);
+  device->DestroyTexture(texture);
+
+  return passed;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  bool passed = true;
+  passed = RunCase(device, 64, 32, 1) && passed;  // Rows already 256-byte aligned.
+  passed = RunCase(device, 100, 37, 1) && passed; // Padded rows.
+  passed = RunCase(device, 1, 5, 1) && passed;    // Single-texel rows.
+  passed = RunCase(device, 100, 37, 4) && passed; // 2D array: padded rows, layers packed back to back.
+
+  nexus->Destroy();
+
+  return passed ? 0 : 1;
+}
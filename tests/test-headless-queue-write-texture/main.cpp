@@ -0,0 +1,145 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kBytesPerPixel = 4;
+constexpr uint32_t kWidth = 37;
+constexpr uint32_t kHeight = 19;
+constexpr uint32_t kMipLevelCount = 3;
+
+// Deliberately not 4-byte aligned.
+constexpr uint32_t kRowPadding = 7;
+
+uint8_t PixelByte(uint32_t mip, uint32_t x, uint32_t y, uint32_t c) {
+  return static_cast<uint8_t>(x * 3 + y * 11 + mip * 50 + c * 17);
+}
+
+// Tightly packed reference image of a mip level.
+std::vector<uint8_t> MakeMipImage(uint32_t mip, uint32_t width, uint32_t height) {
+  std::vector<uint8_t> pixels(size_t(width) * height * kBytesPerPixel);
+  for (uint32_t y = 0; y < height; ++y) {
+    for (uint32_t x = 0; x < width; ++x) {
+      for (uint32_t c = 0; c < kBytesPerPixel; ++c) {
+        pixels[(size_t(y) * width + x) * kBytesPerPixel + c] = PixelByte(mip, x, y, c);
+      }
+    }
+  }
+  return pixels;
+}
+
+// Copies `rows` rows starting at `first_row` into a buffer with `row_pitch` bytes per row.
+std::vector<uint8_t> Repitch(std::vector<uint8_t> const& image, uint32_t width, uint32_t first_row, uint32_t rows, uint32_t row_pitch) {
+  uint32_t const row_size = width * kBytesPerPixel;
+  std::vector<uint8_t> padded(size_t(row_pitch) * rows, 0xEE);
+  for (uint32_t y = 0; y < rows; ++y) {
+    std::memcpy(&padded[size_t(y) * row_pitch], &image[size_t(first_row + y) * row_size], row_size);
+  }
+  return padded;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::TextureHandle texture = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kTransferSrc | mnexus::TextureUsageFlagBits::kTransferDst,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = kWidth,
+      .height = kHeight,
+      .depth = 1,
+      .mip_level_count = kMipLevelCount,
+      .array_layer_count = 1,
+    }
+  );
+
+  std::vector<std::vector<uint8_t>> images;
+  for (uint32_t mip = 0; mip < kMipLevelCount; ++mip) {
+    images.push_back(MakeMipImage(mip, kWidth >> mip, kHeight >> mip));
+  }
+
+  // Mip 0 is written in two halves: the top with padded rows, the bottom tightly packed at an origin offset.
+  uint32_t const top_rows = kHeight / 2;
+  uint32_t const padded_pitch = kWidth * kBytesPerPixel + kRowPadding;
+  std::vector<uint8_t> const top_half = Repitch(images[0], kWidth, 0, top_rows, padded_pitch);
+  uint8_t const* bottom_half = &images[0][size_t(top_rows) * kWidth * kBytesPerPixel];
+
+  std::vector<mnexus::TextureWriteRegion> regions;
+  regions.push_back(
+    mnexus::TextureWriteRegion {
+      .subresource_range = mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+      .origin = { 0, 0, 0 },
+      .extent = { kWidth, top_rows, 1 },
+      .data = top_half.data(),
+      .row_pitch = padded_pitch,
+    }
+  );
+  regions.push_back(
+    mnexus::TextureWriteRegion {
+      .subresource_range = mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+      .origin = { 0, top_rows, 0 },
+      .extent = { kWidth, kHeight - top_rows, 1 },
+      .data = bottom_half,
+    }
+  );
+  for (uint32_t mip = 1; mip < kMipLevelCount; ++mip) {
+    regions.push_back(
+      mnexus::TextureWriteRegion {
+        .subresource_range = mnexus::TextureSubresourceRange::SingleSubresourceColor(mip, 0),
+        .origin = { 0, 0, 0 },
+        .extent = { kWidth >> mip, kHeight >> mip, 1 },
+        .data = images[mip].data(),
+      }
+    );
+  }
+
+  mnexus::IntraQueueSubmissionId const write_id = device->QueueWriteTexture(
+    {},
+    texture,
+    mnexus::container::ArrayProxy<mnexus::TextureWriteRegion const>(regions.data(), static_cast<uint32_t>(regions.size()))
+  );
+
+  bool passed = write_id.Get() != 0;
+  std::printf("batched write issued: %s\n", passed ? "OK" : "FAILED");
+
+  for (uint32_t mip = 0; mip < kMipLevelCount; ++mip) {
+    uint32_t const width = kWidth >> mip;
+    uint32_t const height = kHeight >> mip;
+
+    std::vector<uint8_t> readback(images[mip].size(), 0);
+    mnexus::IntraQueueSubmissionId const read_id = device->QueueReadTexture(
+      {},
+      texture,
+      mnexus::TextureSubresourceRange::SingleSubresourceColor(mip, 0),
+      mnexus::Extent3d { width, height, 1 },
+      readback.data(),
+      readback.size()
+    );
+    device->QueueWaitIdle({}, read_id);
+
+    bool const match = read_id.Get() > write_id.Get() && readback == images[mip];
+    std::printf("mip %u (%ux%u): %s\n", mip, width, height, match ? "OK" : "FAILED");
+    passed = match && passed;
+  }
+
+  device->DestroyTexture(texture);
+  nexus->Destroy();
+
+  return passed ? 0 : 1;
+}
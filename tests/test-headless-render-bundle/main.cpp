@@ -0,0 +1,239 @@
+// c++ headers ------------------------------------------
+#include <array>
+#include <cstdio>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// project headers --------------------------------------
+#include "pipeline/render_target_signature.h"
+
+#include "triangle_test_vs_spv.h"
+#include "triangle_test_fs_spv.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kWidth = 256;
+constexpr uint32_t kHeight = 256;
+constexpr uint32_t kBytesPerPixel = 4;
+constexpr uint32_t kBytesPerRow = kWidth * kBytesPerPixel;
+constexpr uint32_t kBufferSize = kBytesPerRow * kHeight;
+
+struct Vertex {
+  float x, y;
+  float r, g, b;
+};
+
+// Left half: red triangle, recorded into the bundle.
+constexpr Vertex kBundleVertices[] = {
+  { -0.5f,  0.5f,   1.0f, 0.0f, 0.0f },
+  { -0.9f, -0.5f,   1.0f, 0.0f, 0.0f },
+  { -0.1f, -0.5f,   1.0f, 0.0f, 0.0f },
+};
+
+// Right half: green triangle, drawn directly on the command list after the bundle.
+constexpr Vertex kDirectVertices[] = {
+  {  0.5f,  0.5f,   0.0f, 1.0f, 0.0f },
+  {  0.1f, -0.5f,   0.0f, 1.0f, 0.0f },
+  {  0.9f, -0.5f,   0.0f, 1.0f, 0.0f },
+};
+
+bool PixelIs(std::vector<uint8_t> const& pixels, uint32_t x, uint32_t y, uint8_t r, uint8_t g, uint8_t b) {
+  uint8_t const* p = pixels.data() + y * kBytesPerRow + x * kBytesPerPixel;
+  return p[0] == r && p[1] == g && p[2] == b;
+}
+
+void CheckSignatureMatching() {
+  pipeline::RenderTargetSignature rgba;
+  rgba.color_formats.emplace_back(mnexus::Format::kR8G8B8A8_UNORM);
+
+  pipeline::RenderTargetSignature other = rgba;
+  MnTestCheck(rgba.Matches(other), "identical signatures match");
+
+  other.color_formats[0] = mnexus::Format::kB8G8R8A8_UNORM;
+  MnTestCheck(!rgba.Matches(other), "color format mismatch is rejected");
+
+  other = rgba;
+  other.color_formats.emplace_back(mnexus::Format::kR8G8B8A8_UNORM);
+  MnTestCheck(!rgba.Matches(other), "color attachment count mismatch is rejected");
+
+  other = rgba;
+  other.depth_stencil_format = mnexus::Format::kD32_SFLOAT;
+  MnTestCheck(!rgba.Matches(other), "depth-stencil format mismatch is rejected");
+
+  other = rgba;
+  other.sample_count = 4;
+  MnTestCheck(!rgba.Matches(other), "sample count mismatch is rejected");
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  CheckSignatureMatching();
+
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  if (c_desc.backend_type == MnBackendTypeVulkan) {
+    std::printf("Render bundles are not implemented on Vulkan; skipping the GPU part\n");
+    return MnTestPassed() ? 0 : 1;
+  }
+
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::TextureHandle render_target = device->CreateTexture(
+    mnexus::TextureDesc {
+      .usage = mnexus::TextureUsageFlagBits::kAttachment | mnexus::TextureUsageFlagBits::kTransferSrc,
+      .format = mnexus::Format::kR8G8B8A8_UNORM,
+      .dimension = mnexus::TextureDimension::k2D,
+      .width = kWidth,
+      .height = kHeight,
+      .depth = 1,
+      .mip_level_count = 1,
+      .array_layer_count = 1,
+    }
+  );
+
+  mnexus::BufferHandle readback_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kTransferSrc | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = kBufferSize,
+    }
+  );
+
+  mnexus::BufferHandle bundle_vertex_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kVertex,
+      .size_in_bytes = sizeof(kBundleVertices),
+    }
+  );
+  device->QueueWriteBuffer({}, bundle_vertex_buffer, 0, kBundleVertices, sizeof(kBundleVertices));
+
+  mnexus::BufferHandle direct_vertex_buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kVertex,
+      .size_in_bytes = sizeof(kDirectVertices),
+    }
+  );
+  device->QueueWriteBuffer({}, direct_vertex_buffer, 0, kDirectVertices, sizeof(kDirectVertices));
+
+  mnexus::ShaderModuleHandle vs_handle = device->CreateShaderModule(
+    mnexus::ShaderModuleDesc {
+      .source_language = mnexus::ShaderSourceLanguage::kSpirV,
+      .code_ptr = reinterpret_cast<uint64_t>(test_shader::kTriangleTestVsSpv),
+      .code_size_in_bytes = static_cast<uint32_t>(sizeof(test_shader::kTriangleTestVsSpv)),
+    }
+  );
+
+  mnexus::ShaderModuleHandle fs_handle = device->CreateShaderModule(
+    mnexus::ShaderModuleDesc {
+      .source_language = mnexus::ShaderSourceLanguage::kSpirV,
+      .code_ptr = reinterpret_cast<uint64_t>(test_shader::kTriangleTestFsSpv),
+      .code_size_in_bytes = static_cast<uint32_t>(sizeof(test_shader::kTriangleTestFsSpv)),
+    }
+  );
+
+  std::array<mnexus::ShaderModuleHandle, 2> shader_modules = { vs_handle, fs_handle };
+  mnexus::ProgramHandle program = device->CreateProgram(
+    mnexus::ProgramDesc {
+      .shader_modules = shader_modules,
+    }
+  );
+
+  mnexus::VertexInputBindingDesc binding {
+    .binding = 0,
+    .stride = sizeof(Vertex),
+    .step_mode = mnexus::VertexStepMode::kVertex,
+  };
+  std::array<mnexus::VertexInputAttributeDesc, 2> attributes = {{
+    { .location = 0, .binding = 0, .format = mnexus::Format::kR32G32_SFLOAT,    .offset = 0 },
+    { .location = 1, .binding = 0, .format = mnexus::Format::kR32G32B32_SFLOAT, .offset = sizeof(float) * 2 },
+  }};
+
+  // Record the bundle.
+  mnexus::Format const color_format = mnexus::Format::kR8G8B8A8_UNORM;
+  mnexus::IRenderBundleEncoder* encoder = device->CreateRenderBundleEncoder(
+    mnexus::RenderBundleDesc {
+      .color_formats = color_format,
+    }
+  );
+  encoder->BindRenderProgram(program);
+  encoder->SetVertexInputLayout(binding, attributes);
+  encoder->BindVertexBuffer(0, bundle_vertex_buffer, 0);
+  encoder->Draw(3, 1, 0, 0);
+  mnexus::RenderBundleHandle bundle = device->FinishRenderBundleEncoder(encoder);
+  MnTestCheck(bundle.IsValid(), "bundle finished");
+
+  // Bind the direct draw's state before executing the bundle. The backend must re-apply it after the bundle resets
+  // the pass state, without the caller re-binding anything.
+  mnexus::ICommandList* command_list = device->CreateCommandList({});
+
+  mnexus::ClearValue clear_value {};
+  clear_value.color.a = 1.0f;
+
+  mnexus::ColorAttachmentDesc color_attachment {
+    .texture = render_target,
+    .subresource_range = mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+    .load_op = mnexus::LoadOp::kClear,
+    .store_op = mnexus::StoreOp::kStore,
+    .clear_value = clear_value,
+  };
+
+  command_list->BeginRenderPass(
+    mnexus::RenderPassDesc {
+      .color_attachments = color_attachment,
+    }
+  );
+
+  command_list->BindRenderProgram(program);
+  command_list->SetVertexInputLayout(binding, attributes);
+  command_list->BindVertexBuffer(0, direct_vertex_buffer, 0);
+
+  command_list->ExecuteBundles(bundle);
+
+  command_list->Draw(3, 1, 0, 0);
+
+  command_list->EndRenderPass();
+
+  command_list->CopyTextureToBuffer(
+    render_target,
+    mnexus::TextureSubresourceRange::SingleSubresourceColor(0, 0),
+    readback_buffer,
+    0,
+    mnexus::Extent3d { kWidth, kHeight, 1 }
+  );
+
+  command_list->End();
+
+  device->QueueSubmitCommandList({}, command_list);
+
+  std::vector<uint8_t> pixels(kBufferSize);
+  mnexus::IntraQueueSubmissionId read_id = device->QueueReadBuffer(
+    {}, readback_buffer, 0, pixels.data(), kBufferSize
+  );
+  device->QueueWaitIdle({}, read_id);
+
+  // Sample on the vertical center line, which both triangles cover regardless of the clip-space Y convention.
+  MnTestCheck(PixelIs(pixels, kWidth / 4, kHeight / 2, 255, 0, 0), "bundle draw rendered");
+  MnTestCheck(PixelIs(pixels, kWidth * 3 / 4, kHeight / 2, 0, 255, 0), "draw after bundle re-applied state");
+  MnTestCheck(PixelIs(pixels, kWidth / 2, 4, 0, 0, 0), "background untouched");
+
+  device->DestroyRenderBundle(bundle);
+  device->DestroyBuffer(direct_vertex_buffer);
+  device->DestroyBuffer(bundle_vertex_buffer);
+  device->DestroyBuffer(readback_buffer);
+  device->DestroyTexture(render_target);
+  device->DestroyProgram(program);
+  device->DestroyShaderModule(vs_handle);
+  device->DestroyShaderModule(fs_handle);
+
+  nexus->Destroy();
+
+  return MnTestPassed() ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+uint32_t FindReferenceCount(mnexus::SamplerCacheSnapshot const& snapshot, mnexus::SamplerHandle handle) {
+  for (mnexus::SamplerCacheEntry const& entry : snapshot.entries) {
+    if (entry.handle.Get() == handle.Get()) {
+      return entry.reference_count;
+    }
+  }
+  return 0;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::SamplerDesc const linear_desc {
+    .min_filter = mnexus::Filter::kLinear,
+    .mag_filter = mnexus::Filter::kLinear,
+    .mipmap_filter = mnexus::Filter::kLinear,
+    .address_mode_u = mnexus::AddressMode::kRepeat,
+    .address_mode_v = mnexus::AddressMode::kRepeat,
+    .address_mode_w = mnexus::AddressMode::kRepeat,
+  };
+  mnexus::SamplerDesc const nearest_desc {};
+
+  // Sharing: identical descriptors resolve to one sampler.
+  mnexus::SamplerHandle const linear_a = device->CreateSampler(linear_desc);
+  mnexus::SamplerHandle const linear_b = device->CreateSampler(linear_desc);
+  mnexus::SamplerHandle const nearest = device->CreateSampler(nearest_desc);
+
+  MnTestCheck(linear_a.Get() == linear_b.Get(), "identical descs share a handle");
+  MnTestCheck(linear_a.Get() != nearest.Get(), "different descs get distinct handles");
+
+  mnexus::SamplerCacheSnapshot snapshot = device->GetSamplerCacheSnapshot();
+  MnTestCheck(snapshot.diagnostics.total_lookups == 3, "lookup count");
+  MnTestCheck(snapshot.diagnostics.cache_hits == 1, "hit count");
+  MnTestCheck(snapshot.diagnostics.cache_misses == 2, "miss count");
+  MnTestCheck(snapshot.diagnostics.cached_sampler_count == 2, "cached sampler count");
+  MnTestCheck(FindReferenceCount(snapshot, linear_a) == 2, "shared sampler holds two references");
+
+  // Lifetime: the shared sampler outlives its first release.
+  device->DestroySampler(linear_a);
+  snapshot = device->GetSamplerCacheSnapshot();
+  MnTestCheck(snapshot.diagnostics.cached_sampler_count == 2, "sampler kept alive by remaining reference");
+  MnTestCheck(FindReferenceCount(snapshot, linear_b) == 1, "one reference left after first release");
+
+  device->DestroySampler(linear_b);
+  snapshot = device->GetSamplerCacheSnapshot();
+  MnTestCheck(snapshot.diagnostics.cached_sampler_count == 1, "sampler destroyed with last reference");
+
+  // A released descriptor is created anew.
+  mnexus::SamplerHandle const linear_c = device->CreateSampler(linear_desc);
+  snapshot = device->GetSamplerCacheSnapshot();
+  MnTestCheck(snapshot.diagnostics.cache_misses == 3, "recreated sampler is a miss");
+  MnTestCheck(FindReferenceCount(snapshot, linear_c) == 1, "recreated sampler holds one reference");
+
+  device->DestroySampler(linear_c);
+  device->DestroySampler(nearest);
+  snapshot = device->GetSamplerCacheSnapshot();
+  MnTestCheck(snapshot.diagnostics.cached_sampler_count == 0 && snapshot.entries.empty(), "cache empty after all releases");
+
+  nexus->Destroy();
+
+  return MnTestPassed() ? 0 : 1;
+}
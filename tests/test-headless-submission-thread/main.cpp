@@ -0,0 +1,123 @@
+// c++ headers ------------------------------------------
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+constexpr uint32_t kProducerCount = 8;
+constexpr uint32_t kWritesPerProducer = 64;
+constexpr uint32_t kSliceSize = 1024;
+
+bool Check(char const* what, bool condition) {
+  std::printf("%s: %s\n", what, condition ? "OK" : "FAILED");
+  return condition;
+}
+
+std::vector<uint8_t> MakePattern(uint32_t producer, uint32_t iteration) {
+  std::vector<uint8_t> pattern(kSliceSize);
+  for (uint32_t i = 0; i < kSliceSize; ++i) {
+    pattern[i] = static_cast<uint8_t>(i * 13 + producer * 29 + iteration * 7);
+  }
+  return pattern;
+}
+
+struct ProducerResult {
+  std::vector<uint64_t> ids;
+  bool read_after_write_ok = false;
+};
+
+// Overwrites its own slice repeatedly, then reads it back: the read is ordered after the producer's last write.
+void RunProducer(mnexus::IDevice* device, mnexus::BufferHandle buffer, uint32_t producer, ProducerResult& result) {
+  uint32_t const offset = producer * kSliceSize;
+
+  for (uint32_t iteration = 0; iteration < kWritesPerProducer; ++iteration) {
+    std::vector<uint8_t> const pattern = MakePattern(producer, iteration);
+    result.ids.push_back(device->QueueWriteBuffer({}, buffer, offset, pattern.data(), kSliceSize).Get());
+  }
+
+  std::vector<uint8_t> readback(kSliceSize, 0);
+  mnexus::IntraQueueSubmissionId const read_id = device->QueueReadBuffer({}, buffer, offset, readback.data(), kSliceSize);
+  result.ids.push_back(read_id.Get());
+  device->QueueWaitIdle({}, read_id);
+
+  std::vector<uint8_t> const expected = MakePattern(producer, kWritesPerProducer - 1);
+  result.read_after_write_ok = std::memcmp(readback.data(), expected.data(), kSliceSize) == 0;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  MnNexusDesc c_desc = MnTestGetDefaultNexusDesc();
+  mnexus::INexus* nexus = mnexus::INexus::Create({
+      .headless = true,
+      .backend_type = static_cast<mnexus::BackendType>(c_desc.backend_type),
+      .submission_thread = true,
+  });
+  mnexus::IDevice* device = nexus->GetDevice();
+
+  mnexus::BufferHandle buffer = device->CreateBuffer(
+    mnexus::BufferDesc {
+      .usage = mnexus::BufferUsageFlagBits::kTransferSrc | mnexus::BufferUsageFlagBits::kTransferDst,
+      .size_in_bytes = kProducerCount * kSliceSize,
+    }
+  );
+
+  std::vector<ProducerResult> results(kProducerCount);
+  {
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < kProducerCount; ++producer) {
+      producers.emplace_back(RunProducer, device, buffer, producer, std::ref(results[producer]));
+    }
+    for (std::thread& thread : producers) {
+      thread.join();
+    }
+  }
+
+  bool passed = true;
+
+  bool per_thread_ascending = true;
+  bool read_after_write_ok = true;
+  std::vector<uint64_t> all_ids;
+  for (ProducerResult const& result : results) {
+    per_thread_ascending = per_thread_ascending && std::is_sorted(result.ids.begin(), result.ids.end()) &&
+      std::adjacent_find(result.ids.begin(), result.ids.end()) == result.ids.end();
+    read_after_write_ok = read_after_write_ok && result.read_after_write_ok;
+    all_ids.insert(all_ids.end(), result.ids.begin(), result.ids.end());
+  }
+  std::sort(all_ids.begin(), all_ids.end());
+
+  passed = Check("ids ascending per thread", per_thread_ascending) && passed;
+  passed = Check("ids unique across threads", std::adjacent_find(all_ids.begin(), all_ids.end()) == all_ids.end()) && passed;
+  passed = Check("read after write per thread", read_after_write_ok) && passed;
+
+  // Every slice holds its producer's last write once the whole timeline has completed.
+  std::vector<uint8_t> readback(kProducerCount * kSliceSize, 0);
+  mnexus::IntraQueueSubmissionId const read_id =
+    device->QueueReadBuffer({}, buffer, 0, readback.data(), kProducerCount * kSliceSize);
+  device->QueueWaitIdle({}, read_id);
+
+  passed = Check("completed value reached", device->QueueGetCompletedValue({}).Get() >= read_id.Get()) && passed;
+
+  bool slices_ok = true;
+  for (uint32_t producer = 0; producer < kProducerCount; ++producer) {
+    std::vector<uint8_t> const expected = MakePattern(producer, kWritesPerProducer - 1);
+    slices_ok = slices_ok && std::memcmp(&readback[producer * kSliceSize], expected.data(), kSliceSize) == 0;
+  }
+  passed = Check("final buffer contents", slices_ok) && passed;
+
+  device->DestroyBuffer(buffer);
+  nexus->Destroy();
+
+  return passed ? 0 : 1;
+}
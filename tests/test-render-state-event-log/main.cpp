@@ -0,0 +1,358 @@
+// c++ headers ------------------------------------------
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+// public project headers -------------------------------
+#include "mnexus/public/render_state_event_log.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+using mnexus::RenderPipelineStateSnapshot;
+using mnexus::RenderStateEventLog;
+using mnexus::RenderStateEventTag;
+
+// ----------------------------------------------------------------------------------------------------
+// Snapshot comparison
+//
+
+bool AttachmentsEqual(RenderPipelineStateSnapshot::AttachmentState const& a,
+                      RenderPipelineStateSnapshot::AttachmentState const& b) {
+  return a.blend_enabled == b.blend_enabled &&
+         a.src_color == b.src_color && a.dst_color == b.dst_color && a.color_op == b.color_op &&
+         a.src_alpha == b.src_alpha && a.dst_alpha == b.dst_alpha && a.alpha_op == b.alpha_op &&
+         a.write_mask == b.write_mask;
+}
+
+bool SnapshotsEqual(RenderPipelineStateSnapshot const& a, RenderPipelineStateSnapshot const& b) {
+  auto const binding_equal = [](mnexus::VertexInputBindingDesc const& x, mnexus::VertexInputBindingDesc const& y) {
+    return x.binding == y.binding && x.stride == y.stride && x.step_mode == y.step_mode;
+  };
+  auto const attribute_equal = [](mnexus::VertexInputAttributeDesc const& x, mnexus::VertexInputAttributeDesc const& y) {
+    return x.location == y.location && x.binding == y.binding && x.format == y.format && x.offset == y.offset;
+  };
+
+  return a.program.Get() == b.program.Get() &&
+         a.primitive_topology == b.primitive_topology &&
+         a.polygon_mode == b.polygon_mode &&
+         a.cull_mode == b.cull_mode &&
+         a.front_face == b.front_face &&
+         a.depth_test_enabled == b.depth_test_enabled &&
+         a.depth_write_enabled == b.depth_write_enabled &&
+         a.depth_compare_op == b.depth_compare_op &&
+         a.stencil_test_enabled == b.stencil_test_enabled &&
+         a.stencil_front_fail_op == b.stencil_front_fail_op &&
+         a.stencil_front_pass_op == b.stencil_front_pass_op &&
+         a.stencil_front_depth_fail_op == b.stencil_front_depth_fail_op &&
+         a.stencil_front_compare_op == b.stencil_front_compare_op &&
+         a.stencil_back_fail_op == b.stencil_back_fail_op &&
+         a.stencil_back_pass_op == b.stencil_back_pass_op &&
+         a.stencil_back_depth_fail_op == b.stencil_back_depth_fail_op &&
+         a.stencil_back_compare_op == b.stencil_back_compare_op &&
+         std::equal(a.attachments.begin(), a.attachments.end(),
+                    b.attachments.begin(), b.attachments.end(), AttachmentsEqual) &&
+         std::equal(a.vertex_bindings.begin(), a.vertex_bindings.end(),
+                    b.vertex_bindings.begin(), b.vertex_bindings.end(), binding_equal) &&
+         std::equal(a.vertex_attributes.begin(), a.vertex_attributes.end(),
+                    b.vertex_attributes.begin(), b.vertex_attributes.end(), attribute_equal) &&
+         std::equal(a.color_formats.begin(), a.color_formats.end(),
+                    b.color_formats.begin(), b.color_formats.end()) &&
+         a.depth_stencil_format == b.depth_stencil_format &&
+         a.sample_count == b.sample_count;
+}
+
+// ----------------------------------------------------------------------------------------------------
+// State generator
+//
+// Produces a deterministic sequence of snapshots that exercises every field: single-field changes (deltas), changes
+// to more fields than an event stores inline, per-attachment changes, and changes to the vector-shaped parts.
+//
+
+class StateGenerator final {
+public:
+  RenderPipelineStateSnapshot const& Next() {
+    uint32_t const kind = this->Random(10);
+    if (kind < 5) {
+      this->MutateScalar();
+    } else if (kind < 7) {
+      this->MutateAttachment();
+    } else if (kind < 8) {
+      for (uint32_t i = 0; i < 8; ++i) {
+        this->MutateScalar();
+      }
+    } else {
+      this->MutateStructure();
+    }
+    return state_;
+  }
+
+private:
+  uint32_t Random(uint32_t bound) {
+    seed_ = seed_ * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<uint32_t>((seed_ >> 33) % bound);
+  }
+
+  mnexus::CompareOp RandomCompareOp() { return kCompareOps[this->Random(std::size(kCompareOps))]; }
+  mnexus::StencilOp RandomStencilOp() { return kStencilOps[this->Random(std::size(kStencilOps))]; }
+  mnexus::BlendFactor RandomBlendFactor() { return kBlendFactors[this->Random(std::size(kBlendFactors))]; }
+  mnexus::BlendOp RandomBlendOp() { return kBlendOps[this->Random(std::size(kBlendOps))]; }
+
+  void MutateScalar() {
+    RenderPipelineStateSnapshot& s = state_;
+    switch (this->Random(17)) {
+    case 0:  s.program = mnexus::ProgramHandle { 1 + this->Random(1000) }; break;
+    case 1:  s.primitive_topology = kTopologies[this->Random(std::size(kTopologies))]; break;
+    case 2:  s.polygon_mode = kPolygonModes[this->Random(std::size(kPolygonModes))]; break;
+    case 3:  s.cull_mode = kCullModes[this->Random(std::size(kCullModes))]; break;
+    case 4:  s.front_face = kFrontFaces[this->Random(std::size(kFrontFaces))]; break;
+    case 5:  s.depth_test_enabled = !s.depth_test_enabled; break;
+    case 6:  s.depth_write_enabled = !s.depth_write_enabled; break;
+    case 7:  s.depth_compare_op = this->RandomCompareOp(); break;
+    case 8:  s.stencil_test_enabled = !s.stencil_test_enabled; break;
+    case 9:  s.stencil_front_fail_op = this->RandomStencilOp(); break;
+    case 10: s.stencil_front_pass_op = this->RandomStencilOp(); break;
+    case 11: s.stencil_front_depth_fail_op = this->RandomStencilOp(); break;
+    case 12: s.stencil_front_compare_op = this->RandomCompareOp(); break;
+    case 13: s.stencil_back_fail_op = this->RandomStencilOp(); break;
+    case 14: s.stencil_back_pass_op = this->RandomStencilOp(); break;
+    case 15: s.stencil_back_depth_fail_op = this->RandomStencilOp(); break;
+    default: s.stencil_back_compare_op = this->RandomCompareOp(); break;
+    }
+  }
+
+  void MutateAttachment() {
+    if (state_.attachments.empty()) {
+      this->MutateStructure();
+      return;
+    }
+    RenderPipelineStateSnapshot::AttachmentState& a =
+      state_.attachments[this->Random(static_cast<uint32_t>(state_.attachments.size()))];
+    switch (this->Random(8)) {
+    case 0:  a.blend_enabled = !a.blend_enabled; break;
+    case 1:  a.src_color = this->RandomBlendFactor(); break;
+    case 2:  a.dst_color = this->RandomBlendFactor(); break;
+    case 3:  a.color_op = this->RandomBlendOp(); break;
+    case 4:  a.src_alpha = this->RandomBlendFactor(); break;
+    case 5:  a.dst_alpha = this->RandomBlendFactor(); break;
+    case 6:  a.alpha_op = this->RandomBlendOp(); break;
+    default: a.write_mask = kWriteMasks[this->Random(std::size(kWriteMasks))]; break;
+    }
+  }
+
+  void MutateStructure() {
+    RenderPipelineStateSnapshot& s = state_;
+    switch (this->Random(4)) {
+    case 0:
+      // Render target: attachment count, formats and sample count change together, as at BeginRenderPass.
+      if (s.color_formats.size() < 3 && this->Random(2) == 0) {
+        s.color_formats.emplace_back(mnexus::Format::kR8G8B8A8_UNORM);
+        s.attachments.emplace_back();
+      } else if (!s.color_formats.empty()) {
+        s.color_formats.pop_back();
+        s.attachments.pop_back();
+      }
+      break;
+    case 1:
+      s.depth_stencil_format = s.depth_stencil_format == mnexus::Format::kUndefined
+        ? mnexus::Format::kD32_SFLOAT
+        : mnexus::Format::kUndefined;
+      s.sample_count = this->Random(2) == 0 ? 1 : 4;
+      break;
+    case 2:
+      if (s.vertex_bindings.size() < 2) {
+        s.vertex_bindings.emplace_back(mnexus::VertexInputBindingDesc {
+          .binding = static_cast<uint32_t>(s.vertex_bindings.size()),
+          .stride = 4 * (1 + this->Random(8)),
+          .step_mode = this->Random(2) == 0 ? mnexus::VertexStepMode::kVertex : mnexus::VertexStepMode::kInstance,
+        });
+      } else {
+        s.vertex_bindings.clear();
+        s.vertex_attributes.clear();
+      }
+      break;
+    default:
+      if (!s.vertex_bindings.empty() && s.vertex_attributes.size() < 5) {
+        s.vertex_attributes.emplace_back(mnexus::VertexInputAttributeDesc {
+          .location = static_cast<uint32_t>(s.vertex_attributes.size()),
+          .binding = this->Random(static_cast<uint32_t>(s.vertex_bindings.size())),
+          .format = this->Random(2) == 0 ? mnexus::Format::kR32G32_SFLOAT : mnexus::Format::kR32G32B32_SFLOAT,
+          .offset = 4 * this->Random(4),
+        });
+      } else if (!s.vertex_attributes.empty()) {
+        s.vertex_attributes.pop_back();
+      }
+      break;
+    }
+  }
+
+  static constexpr mnexus::PrimitiveTopology kTopologies[] = {
+    mnexus::PrimitiveTopology::kPointList, mnexus::PrimitiveTopology::kLineList, mnexus::PrimitiveTopology::kLineStrip,
+    mnexus::PrimitiveTopology::kTriangleList, mnexus::PrimitiveTopology::kTriangleStrip,
+  };
+  static constexpr mnexus::PolygonMode kPolygonModes[] = {
+    mnexus::PolygonMode::kFill, mnexus::PolygonMode::kLine, mnexus::PolygonMode::kPoint,
+  };
+  static constexpr mnexus::CullMode kCullModes[] = {
+    mnexus::CullMode::kNone, mnexus::CullMode::kFront, mnexus::CullMode::kBack,
+  };
+  static constexpr mnexus::FrontFace kFrontFaces[] = {
+    mnexus::FrontFace::kCounterClockwise, mnexus::FrontFace::kClockwise,
+  };
+  static constexpr mnexus::CompareOp kCompareOps[] = {
+    mnexus::CompareOp::kNever, mnexus::CompareOp::kLess, mnexus::CompareOp::kEqual, mnexus::CompareOp::kLessEqual,
+    mnexus::CompareOp::kGreater, mnexus::CompareOp::kNotEqual, mnexus::CompareOp::kGreaterEqual,
+    mnexus::CompareOp::kAlways,
+  };
+  static constexpr mnexus::StencilOp kStencilOps[] = {
+    mnexus::StencilOp::kKeep, mnexus::StencilOp::kZero, mnexus::StencilOp::kReplace,
+    mnexus::StencilOp::kIncrementClamp, mnexus::StencilOp::kDecrementClamp, mnexus::StencilOp::kInvert,
+    mnexus::StencilOp::kIncrementWrap, mnexus::StencilOp::kDecrementWrap,
+  };
+  static constexpr mnexus::BlendFactor kBlendFactors[] = {
+    mnexus::BlendFactor::kZero, mnexus::BlendFactor::kOne, mnexus::BlendFactor::kSrcAlpha,
+    mnexus::BlendFactor::kOneMinusSrcAlpha, mnexus::BlendFactor::kDstColor, mnexus::BlendFactor::kConstant,
+  };
+  static constexpr mnexus::BlendOp kBlendOps[] = {
+    mnexus::BlendOp::kAdd, mnexus::BlendOp::kSubtract, mnexus::BlendOp::kReverseSubtract,
+    mnexus::BlendOp::kMin, mnexus::BlendOp::kMax,
+  };
+  static constexpr mnexus::ColorWriteMask kWriteMasks[] = {
+    mnexus::ColorWriteMask::kNone, mnexus::ColorWriteMask::kRed, mnexus::ColorWriteMask::kAlpha,
+    mnexus::ColorWriteMask::kAll,
+  };
+
+  uint64_t seed_ = 0x2545f4914f6cdd1dull;
+  RenderPipelineStateSnapshot state_;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// Helpers
+//
+
+struct RecordedEvent final {
+  RenderStateEventTag tag;
+  RenderPipelineStateSnapshot state;
+  size_t pso_hash = 0;
+  bool cache_hit = false;
+};
+
+/// Records `count` generated events into `log` and returns them in order. Every fourth event is a PSO resolution.
+std::vector<RecordedEvent> RecordGenerated(RenderStateEventLog& log, uint32_t count) {
+  StateGenerator generator;
+  std::vector<RecordedEvent> recorded;
+  recorded.reserve(count);
+
+  for (uint32_t i = 0; i < count; ++i) {
+    RenderPipelineStateSnapshot const& state = generator.Next();
+    if (i % 4 == 3) {
+      size_t const hash = 0x1000 + i;
+      bool const cache_hit = (i % 8) == 7;
+      log.RecordPso(state, hash, cache_hit);
+      recorded.emplace_back(RecordedEvent {
+        .tag = RenderStateEventTag::kPsoResolved, .state = state, .pso_hash = hash, .cache_hit = cache_hit,
+      });
+    } else {
+      RenderStateEventTag const tag = static_cast<RenderStateEventTag>(i % 17);
+      log.Record(tag, state);
+      recorded.emplace_back(RecordedEvent { .tag = tag, .state = state });
+    }
+  }
+  return recorded;
+}
+
+/// True if the retained events of `log` are exactly the last `log.GetCount()` entries of `recorded`.
+bool RetainedEventsMatch(RenderStateEventLog const& log, std::vector<RecordedEvent> const& recorded) {
+  uint32_t const count = log.GetCount();
+  if (count > recorded.size()) {
+    return false;
+  }
+  size_t const first = recorded.size() - count;
+  for (uint32_t i = 0; i < count; ++i) {
+    mnexus::RenderStateEvent const event = log.GetEvent(i);
+    RecordedEvent const& expected = recorded[first + i];
+    if (event.tag != expected.tag ||
+        event.pso_hash != expected.pso_hash ||
+        event.cache_hit != expected.cache_hit ||
+        !SnapshotsEqual(event.state, expected.state)) {
+      std::printf("  mismatch at retained index %u (recorded index %zu)\n", i, first + i);
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  // Disabled: recording is a no-op.
+  {
+    RenderStateEventLog log;
+    log.Record(RenderStateEventTag::kDraw, RenderPipelineStateSnapshot {});
+    MnTestCheck(log.GetCount() == 0 && log.GetTotalRecordedCount() == 0, "disabled log records nothing");
+  }
+
+  // Unbounded, default keyframe interval.
+  {
+    RenderStateEventLog log;
+    log.SetEnabled(true);
+    std::vector<RecordedEvent> const recorded = RecordGenerated(log, 500);
+    MnTestCheck(log.GetCount() == 500, "unbounded log retains every event");
+    MnTestCheck(RetainedEventsMatch(log, recorded), "unbounded log reconstructs every snapshot");
+  }
+
+  // Unbounded, short keyframe interval: reconstruction crosses many periodic keyframes.
+  {
+    RenderStateEventLog log;
+    log.SetEnabled(true);
+    log.SetKeyframeInterval(3);
+    std::vector<RecordedEvent> const recorded = RecordGenerated(log, 500);
+    MnTestCheck(RetainedEventsMatch(log, recorded), "short keyframe interval reconstructs every snapshot");
+  }
+
+  // Ring: wraps around the capacity many times, with the front keyframe rolled forward or replaced on each eviction.
+  for (uint32_t const capacity : { 1u, 7u, 64u, 100u }) {
+    for (uint32_t const interval : { 1u, 5u, RenderStateEventLog::kDefaultKeyframeInterval }) {
+      RenderStateEventLog log;
+      log.SetEnabled(true);
+      log.SetRingCapacity(capacity);
+      log.SetKeyframeInterval(interval);
+      std::vector<RecordedEvent> const recorded = RecordGenerated(log, 1000);
+
+      char what[96];
+      std::snprintf(what, sizeof(what), "ring capacity %u, keyframe interval %u", capacity, interval);
+      std::printf("%s\n", what);
+      MnTestCheck(log.GetCount() == capacity, "  retains the capacity");
+      MnTestCheck(log.GetTotalRecordedCount() == 1000, "  counts evicted events");
+      MnTestCheck(RetainedEventsMatch(log, recorded), "  reconstructs the most recent snapshots");
+    }
+  }
+
+  // Ring not yet full behaves like the unbounded log.
+  {
+    RenderStateEventLog log;
+    log.SetEnabled(true);
+    log.SetRingCapacity(256);
+    std::vector<RecordedEvent> const recorded = RecordGenerated(log, 100);
+    MnTestCheck(log.GetCount() == 100, "partially filled ring retains every event");
+    MnTestCheck(RetainedEventsMatch(log, recorded), "partially filled ring reconstructs every snapshot");
+  }
+
+  // Clear resets the counters; the log keeps working afterwards.
+  {
+    RenderStateEventLog log;
+    log.SetEnabled(true);
+    log.SetRingCapacity(16);
+    (void)RecordGenerated(log, 50);
+    log.Clear();
+    MnTestCheck(log.GetCount() == 0 && log.GetTotalRecordedCount() == 0, "clear empties the log");
+    std::vector<RecordedEvent> const recorded = RecordGenerated(log, 40);
+    MnTestCheck(RetainedEventsMatch(log, recorded), "log reconstructs after clear");
+  }
+
+  return MnTestPassed() ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+// c++ headers ------------------------------------------
+#include <cstdint>
+
+// public project headers -------------------------------
+#include "mnexus/public/mnexus.h"
+
+// project headers --------------------------------------
+#include "resource_pool/sampler_cache.h"
+
+// test harness -----------------------------------------
+#include "mnexus_test_harness.h"
+
+namespace {
+
+using resource_pool::ResourceHandle;
+using resource_pool::SamplerCache;
+
+// Hands out distinct sampler handles and counts how often the cache asks for one.
+struct CountingFactory final {
+  uint32_t call_count = 0;
+  uint32_t next_index = 0;
+
+  ResourceHandle operator()() {
+    ++call_count;
+    return ResourceHandle::Make(next_index++, 1, mnexus::kResourceTypeSampler);
+  }
+};
+
+uint32_t FindReferenceCount(SamplerCache const& cache, ResourceHandle handle) {
+  mnexus::SamplerCacheSnapshot const snapshot = cache.GetSnapshot();
+  for (mnexus::SamplerCacheEntry const& entry : snapshot.entries) {
+    if (entry.handle.Get() == handle.AsU64()) {
+      return entry.reference_count;
+    }
+  }
+  return 0;
+}
+
+} // namespace
+
+extern "C" int MnTestMain(int, char**) {
+  mnexus::SamplerDesc const linear {
+    .min_filter = mnexus::Filter::kLinear,
+    .mag_filter = mnexus::Filter::kLinear,
+  };
+  mnexus::SamplerDesc const repeat {
+    .address_mode_u = mnexus::AddressMode::kRepeat,
+    .address_mode_v = mnexus::AddressMode::kRepeat,
+  };
+
+  SamplerCache cache;
+  CountingFactory factory;
+
+  // Acquire: one creation per distinct desc, later lookups share the handle.
+  ResourceHandle const linear_a = cache.Acquire(linear, factory);
+  ResourceHandle const linear_b = cache.Acquire(linear, factory);
+  ResourceHandle const repeat_a = cache.Acquire(repeat, factory);
+  MnTestCheck(linear_a == linear_b, "identical descs share a handle");
+  MnTestCheck(linear_a != repeat_a, "different descs get distinct handles");
+  MnTestCheck(factory.call_count == 2, "the factory runs once per distinct desc");
+  MnTestCheck(FindReferenceCount(cache, linear_a) == 2, "each acquire adds a reference");
+  MnTestCheck(FindReferenceCount(cache, repeat_a) == 1, "a single acquire holds one reference");
+
+  mnexus::SamplerCacheDiagnosticsSnapshot const diagnostics = cache.GetSnapshot().diagnostics;
+  MnTestCheck(
+    diagnostics.total_lookups == 3 && diagnostics.cache_hits == 1 && diagnostics.cache_misses == 2,
+    "diagnostics count lookups, hits and misses"
+  );
+  MnTestCheck(diagnostics.cached_sampler_count == 2, "diagnostics count cached samplers");
+
+  // Release: only the last reference reports that the sampler must be destroyed.
+  MnTestCheck(!cache.Release(linear), "releasing a shared sampler keeps it");
+  MnTestCheck(FindReferenceCount(cache, linear_a) == 1, "release drops one reference");
+  MnTestCheck(cache.Release(linear), "releasing the last reference reports destruction");
+  MnTestCheck(cache.GetSnapshot().diagnostics.cached_sampler_count == 1, "the released sampler leaves the cache");
+
+  // A released desc is created anew.
+  ResourceHandle const linear_c = cache.Acquire(linear, factory);
+  MnTestCheck(factory.call_count == 3 && linear_c != linear_a, "a released desc is created again");
+
+  // Factory failure: the null handle is returned and not cached.
+  mnexus::SamplerDesc const mirror {
+    .address_mode_u = mnexus::AddressMode::kMirrorRepeat,
+  };
+  uint32_t failing_call_count = 0;
+  auto const failing_factory = [&failing_call_count]() {
+    ++failing_call_count;
+    return ResourceHandle::Null();
+  };
+  MnTestCheck(cache.Acquire(mirror, failing_factory).IsNull(), "a null factory result is returned");
+  MnTestCheck(cache.GetSnapshot().diagnostics.cached_sampler_count == 2, "a null factory result is not cached");
+  MnTestCheck(cache.Acquire(mirror, failing_factory).IsNull() && failing_call_count == 2,
+    "a failed desc calls the factory again");
+
+  ResourceHandle const mirror_a = cache.Acquire(mirror, factory);
+  MnTestCheck(!mirror_a.IsNull() && FindReferenceCount(cache, mirror_a) == 1, "a failed desc can be created later");
+
+  MnTestCheck(cache.Release(linear) && cache.Release(repeat) && cache.Release(mirror), "final releases destroy");
+  MnTestCheck(cache.GetSnapshot().diagnostics.cached_sampler_count == 0, "the cache is empty");
+
+  return MnTestPassed() ? 0 : 1;
+}